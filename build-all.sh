@@ -34,7 +34,7 @@
 #
 # git clone https://github.com/google/wuffs.git
 # cd wuffs
-# gcc ./example/zcat/zcat.c
+# gcc ./example/zcat/zcat.c -lpthread
 # ./a.out < ./test/data/romeo.txt.gz
 
 if [ ! -e release/c/wuffs-unsupported-snapshot.c ]; then
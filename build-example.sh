@@ -39,7 +39,11 @@ for f in $sources; do
     continue
   fi
 
-  if [ $f = imageviewer ]; then
+  if [ $f = bgzf ] || [ $f = zcat ]; then
+    # example/bgzf and example/zcat are unusual in that they use threads.
+    echo "Building gen/bin/example-$f"
+    $CC -O3 example/$f/*.c -lpthread -o gen/bin/example-$f
+  elif [ $f = imageviewer ]; then
     # example/imageviewer is unusual in that needs additional libraries.
     echo "Building gen/bin/example-$f"
     $CC -O3 example/$f/*.c -lxcb -lxcb-image -o gen/bin/example-$f
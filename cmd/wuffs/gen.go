@@ -282,11 +282,12 @@ func (h *genHelper) genWuffs(dirname string, qualifiedFilenames []string) error
 				if !n.Public() {
 					continue
 				}
+				// TODO: look at n.Asserts().
 				if n.Receiver().IsZero() {
-					return fmt.Errorf("TODO: genWuffs for a free-standing function")
+					fmt.Fprintf(out, "pub func %s%v(", n.FuncName().Str(&h.tm), n.Effect())
+				} else {
+					fmt.Fprintf(out, "pub func %s.%s%v(", n.Receiver().Str(&h.tm), n.FuncName().Str(&h.tm), n.Effect())
 				}
-				// TODO: look at n.Asserts().
-				fmt.Fprintf(out, "pub func %s.%s%v(", n.Receiver().Str(&h.tm), n.FuncName().Str(&h.tm), n.Effect())
 				for i, field := range n.In().Fields() {
 					field := field.AsField()
 					if i > 0 {
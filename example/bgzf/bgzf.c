@@ -0,0 +1,590 @@
+// Copyright 2020 The Wuffs Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// ----------------
+
+/*
+bgzf decodes BGZF (Blocked GNU Zip Format) data to stdout. BGZF is used by
+genomics file formats such as BAM and VCF.gz. A BGZF file is a valid gzip file,
+made of concatenated gzip members. Each member is at most 64 KiB (compressed
+and decompressed) and its header's FEXTRA field holds a BSIZE subfield: the
+member's compressed size. Knowing where the next member starts, without
+decoding this one, lets this program decode the members concurrently, on a
+pool of -j=N threads (default 4), while still writing the output in order.
+
+A position in the decoded data is given as a BGZF virtual offset: the
+compressed offset of a member's start, shifted left by 16, plus an offset
+within that member's decoded data. The -voffset=V flag starts decoding there
+and the -length=N flag limits the output. To run:
+
+$CC bgzf.c -lpthread -o bgzf
+./bgzf -j=8 foo.bam | md5sum
+./bgzf -voffset=123456789 -length=100 foo.bam
+rm -f bgzf
+
+for a C compiler $CC, such as clang or gcc.
+
+The "BGZF reader" section below is a small, library-like API (open, read,
+tell, seek and close) that could be copied into other programs.
+*/
+
+#include <errno.h>
+#include <limits.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Wuffs ships as a "single file C library" or "header file library" as per
+// https://github.com/nothings/stb/blob/master/docs/stb_howto.txt
+//
+// To use that single file as a "foo.c"-like implementation, instead of a
+// "foo.h"-like header, #define WUFFS_IMPLEMENTATION before #include'ing or
+// compiling it.
+#define WUFFS_IMPLEMENTATION
+
+// Defining the WUFFS_CONFIG__MODULE* macros are optional, but it lets users of
+// release/c/etc.c whitelist which parts of Wuffs to build. That file contains
+// the entire Wuffs standard library, implementing a variety of codecs and file
+// formats. Without this macro definition, an optimizing compiler or linker may
+// very well discard Wuffs code for unused codecs, but listing the Wuffs
+// modules we use makes that process explicit. Preprocessing means that such
+// code simply isn't compiled.
+#define WUFFS_CONFIG__MODULES
+#define WUFFS_CONFIG__MODULE__BASE
+#define WUFFS_CONFIG__MODULE__CRC32
+#define WUFFS_CONFIG__MODULE__DEFLATE
+#define WUFFS_CONFIG__MODULE__GZIP
+
+// If building this program in an environment that doesn't easily accommodate
+// relative includes, you can use the script/inline-c-relative-includes.go
+// program to generate a stand-alone C file.
+#include "../../release/c/wuffs-unsupported-snapshot.c"
+
+// BGZF_MEMBER_LEN_MAX is the maximum length of a BGZF member, both compressed
+// (BSIZE + 1) and decompressed.
+#define BGZF_MEMBER_LEN_MAX 65536
+
+// BGZF_HEADER_LEN is the length of a gzip member's fixed-size header fields,
+// up to and including FEXTRA's XLEN.
+#define BGZF_HEADER_LEN 12
+
+// MAX_J is the maximum value of the -j=N flag.
+#define MAX_J 64
+
+// SLOTS_PER_THREAD is how many members, per thread, can be read ahead.
+#define SLOTS_PER_THREAD 4
+
+#define WORK_BUFFER_ARRAY_SIZE \
+  WUFFS_GZIP__DECODER_WORKBUF_LEN_MAX_INCL_WORST_CASE
+
+// ---- BGZF reader
+
+// A bgzf_slot holds one member: its compressed and decompressed bytes.
+//
+// The main thread reads the compressed bytes, then queues the slot. A worker
+// thread decodes it and sets done (protected by the bgzf_reader's mutex).
+// The main thread then owns the slot again.
+typedef struct {
+  uint64_t coffset;
+  size_t src_len;
+  size_t dst_len;
+  const char* status_msg;
+  bool done;
+  uint8_t src[BGZF_MEMBER_LEN_MAX];
+  uint8_t dst[BGZF_MEMBER_LEN_MAX];
+} bgzf_slot;
+
+// A bgzf_reader's slots are a ring buffer. The members numbered from head
+// (inclusive) to tail (exclusive) occupy slots[member % n_slots]. Worker
+// threads decode them in order, and next_decode is the next one to decode.
+// If holding is true, the main thread has handed out a view of the head
+// member's decoded bytes, starting at ri.
+typedef struct {
+  FILE* f;
+  uint64_t next_coffset;
+  bool eof;
+
+  bgzf_slot* slots;
+  uint32_t n_slots;
+  uint64_t head;
+  uint64_t tail;
+  uint64_t next_decode;
+  size_t ri;
+  bool holding;
+
+  uint32_t n_threads;
+  pthread_t threads[MAX_J];
+  pthread_mutex_t mutex;
+  pthread_cond_t work_cond;
+  pthread_cond_t done_cond;
+  bool quit;
+} bgzf_reader;
+
+static const char*  //
+bgzf_decode_member(wuffs_gzip__decoder* dec,
+                   wuffs_base__slice_u8 work_slice,
+                   bgzf_slot* slot) {
+  // Resetting (instead of re-initializing) the decoder keeps its settings and
+  // is cheaper, as BGZF members are short.
+  wuffs_gzip__decoder__reset(dec);
+
+  wuffs_base__io_buffer src = wuffs_base__make_io_buffer(
+      wuffs_base__make_slice_u8(slot->src, slot->src_len),
+      wuffs_base__make_io_buffer_meta(slot->src_len, 0, 0, true));
+  wuffs_base__io_buffer dst = wuffs_base__make_io_buffer(
+      wuffs_base__make_slice_u8(slot->dst, BGZF_MEMBER_LEN_MAX),
+      wuffs_base__empty_io_buffer_meta());
+  wuffs_base__status status =
+      wuffs_gzip__decoder__transform_io(dec, &dst, &src, work_slice);
+  slot->dst_len = dst.meta.wi;
+  if (status.repr == wuffs_base__suspension__short_write) {
+    return "bgzf: member decodes to more than 64 KiB";
+  } else if (status.repr == wuffs_base__suspension__short_read) {
+    return "bgzf: truncated member";
+  } else if (!wuffs_base__status__is_ok(&status)) {
+    return wuffs_base__status__message(&status);
+  } else if ((src.meta.ri != slot->src_len) ||
+             (wuffs_gzip__decoder__bgzf_block_size(dec) != slot->src_len)) {
+    return "bgzf: inconsistent BSIZE";
+  }
+  return NULL;
+}
+
+static void*  //
+bgzf_worker(void* arg) {
+  bgzf_reader* r = (bgzf_reader*)arg;
+  wuffs_gzip__decoder* dec = malloc(sizeof *dec);
+  uint8_t* work = malloc(WORK_BUFFER_ARRAY_SIZE);
+  wuffs_base__slice_u8 work_slice =
+      wuffs_base__make_slice_u8(work, WORK_BUFFER_ARRAY_SIZE);
+  const char* init_msg = (dec && work) ? NULL : "bgzf: out of memory";
+  if (!init_msg) {
+    wuffs_base__status status = wuffs_gzip__decoder__initialize(
+        dec, sizeof *dec, WUFFS_VERSION,
+        WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED);
+    init_msg = wuffs_base__status__message(&status);
+    // Each member's output fits in slot->dst, so that the DEFLATE decoder
+    // does not have to keep its own copy of the history.
+    wuffs_gzip__decoder__set_whole_output_in_dst(dec, true);
+  }
+
+  pthread_mutex_lock(&r->mutex);
+  while (true) {
+    while (!r->quit && (r->next_decode == r->tail)) {
+      pthread_cond_wait(&r->work_cond, &r->mutex);
+    }
+    if (r->quit) {
+      break;
+    }
+    bgzf_slot* slot = &r->slots[r->next_decode % r->n_slots];
+    r->next_decode++;
+    pthread_mutex_unlock(&r->mutex);
+
+    slot->status_msg =
+        init_msg ? init_msg : bgzf_decode_member(dec, work_slice, slot);
+
+    pthread_mutex_lock(&r->mutex);
+    slot->done = true;
+    pthread_cond_broadcast(&r->done_cond);
+  }
+  pthread_mutex_unlock(&r->mutex);
+
+  free(work);
+  free(dec);
+  return NULL;
+}
+
+// bgzf_read_member reads the next member's compressed bytes into slot, or
+// sets r->eof.
+static const char*  //
+bgzf_read_member(bgzf_reader* r, bgzf_slot* slot) {
+  uint8_t* p = slot->src;
+  size_t n = fread(p, sizeof(uint8_t), BGZF_HEADER_LEN, r->f);
+  if (n < BGZF_HEADER_LEN) {
+    if (ferror(r->f)) {
+      return "bgzf: error reading file";
+    } else if (n > 0) {
+      return "bgzf: truncated input";
+    }
+    r->eof = true;
+    return NULL;
+  } else if ((p[0] != 0x1F) || (p[1] != 0x8B) || (p[2] != 0x08) ||
+             ((p[3] & 0x04) == 0)) {
+    return "bgzf: not a BGZF file";
+  }
+
+  // Look for the "BC" subfield in FEXTRA.
+  size_t xlen = wuffs_base__load_u16le__no_bounds_check(p + 10);
+  if (fread(p + BGZF_HEADER_LEN, sizeof(uint8_t), xlen, r->f) != xlen) {
+    return "bgzf: truncated input";
+  }
+  size_t member_len = 0;
+  uint8_t* x = p + BGZF_HEADER_LEN;
+  uint8_t* x_end = x + xlen;
+  while ((x_end - x) >= 4) {
+    size_t slen = wuffs_base__load_u16le__no_bounds_check(x + 2);
+    if ((size_t)(x_end - x - 4) < slen) {
+      break;
+    } else if ((x[0] == 'B') && (x[1] == 'C') && (slen == 2)) {
+      member_len = 1 + (size_t)wuffs_base__load_u16le__no_bounds_check(x + 4);
+      break;
+    }
+    x += 4 + slen;
+  }
+  // A member is at least a header and an 8 byte trailer.
+  if (member_len < (BGZF_HEADER_LEN + xlen + 8)) {
+    return "bgzf: not a BGZF file";
+  }
+
+  size_t remaining = member_len - BGZF_HEADER_LEN - xlen;
+  if (fread(p + BGZF_HEADER_LEN + xlen, sizeof(uint8_t), remaining, r->f) !=
+      remaining) {
+    return ferror(r->f) ? "bgzf: error reading file" : "bgzf: truncated input";
+  }
+  slot->coffset = r->next_coffset;
+  slot->src_len = member_len;
+  r->next_coffset += member_len;
+  return NULL;
+}
+
+// bgzf_refill reads and queues members until the ring buffer is full or the
+// input is exhausted.
+static const char*  //
+bgzf_refill(bgzf_reader* r) {
+  while (!r->eof && ((r->tail - r->head) < r->n_slots)) {
+    bgzf_slot* slot = &r->slots[r->tail % r->n_slots];
+    const char* z = bgzf_read_member(r, slot);
+    if (z || r->eof) {
+      return z;
+    }
+    slot->status_msg = NULL;
+    slot->done = false;
+    pthread_mutex_lock(&r->mutex);
+    r->tail++;
+    pthread_cond_signal(&r->work_cond);
+    pthread_mutex_unlock(&r->mutex);
+  }
+  return NULL;
+}
+
+// bgzf_wait_until_idle waits for the worker threads to finish decoding every
+// queued member.
+static void  //
+bgzf_wait_until_idle(bgzf_reader* r) {
+  pthread_mutex_lock(&r->mutex);
+  uint64_t i;
+  for (i = r->head; i < r->tail; i++) {
+    while (!r->slots[i % r->n_slots].done) {
+      pthread_cond_wait(&r->done_cond, &r->mutex);
+    }
+  }
+  pthread_mutex_unlock(&r->mutex);
+}
+
+const char*  //
+bgzf_reader__open(bgzf_reader* r, FILE* f, uint32_t n_threads) {
+  if ((n_threads < 1) || (n_threads > MAX_J)) {
+    return "bgzf: bad number of threads";
+  }
+  memset(r, 0, sizeof(*r));
+  r->f = f;
+  r->n_slots = n_threads * SLOTS_PER_THREAD;
+  r->slots = calloc(r->n_slots, sizeof(bgzf_slot));
+  if (!r->slots) {
+    return "bgzf: out of memory";
+  }
+  pthread_mutex_init(&r->mutex, NULL);
+  pthread_cond_init(&r->work_cond, NULL);
+  pthread_cond_init(&r->done_cond, NULL);
+  for (; r->n_threads < n_threads; r->n_threads++) {
+    if (pthread_create(&r->threads[r->n_threads], NULL, bgzf_worker, r)) {
+      return "bgzf: could not create thread";
+    }
+  }
+  return NULL;
+}
+
+void  //
+bgzf_reader__close(bgzf_reader* r) {
+  pthread_mutex_lock(&r->mutex);
+  r->quit = true;
+  pthread_cond_broadcast(&r->work_cond);
+  pthread_mutex_unlock(&r->mutex);
+  uint32_t i;
+  for (i = 0; i < r->n_threads; i++) {
+    pthread_join(r->threads[i], NULL);
+  }
+  pthread_cond_destroy(&r->done_cond);
+  pthread_cond_destroy(&r->work_cond);
+  pthread_mutex_destroy(&r->mutex);
+  free(r->slots);
+  r->slots = NULL;
+}
+
+// bgzf_reader__read sets *dst to the next chunk of decoded bytes, in order. It
+// remains valid until the next bgzf_reader__etc call. An empty *dst means
+// that there is no more data.
+const char*  //
+bgzf_reader__read(bgzf_reader* r, wuffs_base__slice_u8* dst) {
+  *dst = wuffs_base__make_slice_u8(NULL, 0);
+  while (true) {
+    if (r->holding) {
+      r->holding = false;
+      r->ri = 0;
+      pthread_mutex_lock(&r->mutex);
+      r->head++;
+      pthread_mutex_unlock(&r->mutex);
+    }
+    const char* z = bgzf_refill(r);
+    if (z) {
+      return z;
+    } else if (r->head == r->tail) {
+      return NULL;
+    }
+
+    bgzf_slot* slot = &r->slots[r->head % r->n_slots];
+    pthread_mutex_lock(&r->mutex);
+    while (!slot->done) {
+      pthread_cond_wait(&r->done_cond, &r->mutex);
+    }
+    pthread_mutex_unlock(&r->mutex);
+    if (slot->status_msg) {
+      return slot->status_msg;
+    }
+
+    r->holding = true;
+    // Skip over empty members, such as BGZF's end-of-file marker.
+    if (r->ri < slot->dst_len) {
+      *dst =
+          wuffs_base__make_slice_u8(slot->dst + r->ri, slot->dst_len - r->ri);
+      return NULL;
+    }
+  }
+}
+
+// bgzf_reader__tell returns the virtual offset of the next decoded byte that
+// bgzf_reader__read will return.
+uint64_t  //
+bgzf_reader__tell(bgzf_reader* r) {
+  if (!r->holding) {
+    uint64_t coffset = (r->head < r->tail)
+                           ? r->slots[r->head % r->n_slots].coffset
+                           : r->next_coffset;
+    return (coffset << 16) | r->ri;
+  } else if ((r->head + 1) < r->tail) {
+    return r->slots[(r->head + 1) % r->n_slots].coffset << 16;
+  }
+  return r->next_coffset << 16;
+}
+
+// bgzf_reader__seek moves to the given virtual offset, such as one returned by
+// bgzf_reader__tell or one from an index file (e.g. a BAM file's .bai index).
+const char*  //
+bgzf_reader__seek(bgzf_reader* r, uint64_t voffset) {
+  bgzf_wait_until_idle(r);
+  pthread_mutex_lock(&r->mutex);
+  r->head = 0;
+  r->tail = 0;
+  r->next_decode = 0;
+  pthread_mutex_unlock(&r->mutex);
+  r->ri = 0;
+  r->holding = false;
+  r->eof = false;
+
+  uint64_t coffset = voffset >> 16;
+  if ((coffset > LONG_MAX) || fseek(r->f, (long)(coffset), SEEK_SET)) {
+    return "bgzf: could not seek";
+  }
+  r->next_coffset = coffset;
+
+  // Decode the member at coffset, to check the offset within it.
+  size_t uoffset = voffset & 0xFFFF;
+  const char* z = bgzf_refill(r);
+  if (z) {
+    return z;
+  } else if (r->head == r->tail) {
+    return uoffset ? "bgzf: bad virtual offset" : NULL;
+  }
+  bgzf_slot* slot = &r->slots[r->head % r->n_slots];
+  pthread_mutex_lock(&r->mutex);
+  while (!slot->done) {
+    pthread_cond_wait(&r->done_cond, &r->mutex);
+  }
+  pthread_mutex_unlock(&r->mutex);
+  if (slot->status_msg) {
+    return slot->status_msg;
+  } else if (uoffset > slot->dst_len) {
+    return "bgzf: bad virtual offset";
+  }
+  r->ri = uoffset;
+  return NULL;
+}
+
+// ---- Main program
+
+struct {
+  int remaining_argc;
+  char** remaining_argv;
+
+  uint32_t j;
+  uint64_t length;
+  uint64_t voffset;
+} flags = {0};
+
+static const char*  //
+parse_u64_flag_value(const char* arg, uint64_t* value) {
+  while (*arg++ != '=') {
+  }
+  wuffs_base__result_u64 u = wuffs_base__parse_number_u64(
+      wuffs_base__make_slice_u8((uint8_t*)arg, strlen(arg)));
+  if (!wuffs_base__status__is_ok(&u.status)) {
+    return u.status.repr;
+  }
+  *value = u.value;
+  return NULL;
+}
+
+const char*  //
+parse_flags(int argc, char** argv) {
+  flags.j = 4;
+  flags.length = UINT64_MAX;
+
+  int c = (argc > 0) ? 1 : 0;  // Skip argv[0], the program name.
+  for (; c < argc; c++) {
+    char* arg = argv[c];
+    if (*arg++ != '-') {
+      break;
+    }
+
+    // A double-dash "--foo" is equivalent to a single-dash "-foo". As special
+    // cases, a bare "-" is not a flag (some programs may interpret it as
+    // stdin) and a bare "--" means to stop parsing flags.
+    if (*arg == '\x00') {
+      break;
+    } else if (*arg == '-') {
+      arg++;
+      if (*arg == '\x00') {
+        c++;
+        break;
+      }
+    }
+
+    if (!strncmp(arg, "j=", 2)) {
+      uint64_t j = 0;
+      if (parse_u64_flag_value(arg, &j) || (j < 1) || (j > MAX_J)) {
+        return "main: bad -j=N flag value";
+      }
+      flags.j = (uint32_t)(j);
+      continue;
+    }
+    if (!strncmp(arg, "length=", 7)) {
+      if (parse_u64_flag_value(arg, &flags.length)) {
+        return "main: bad -length=N flag value";
+      }
+      continue;
+    }
+    if (!strncmp(arg, "voffset=", 8)) {
+      if (parse_u64_flag_value(arg, &flags.voffset)) {
+        return "main: bad -voffset=V flag value";
+      }
+      continue;
+    }
+
+    return "main: unrecognized flag argument";
+  }
+
+  flags.remaining_argc = argc - c;
+  flags.remaining_argv = argv + c;
+  return NULL;
+}
+
+const char*  //
+main2(bgzf_reader* r) {
+  if (flags.voffset) {
+    const char* z = bgzf_reader__seek(r, flags.voffset);
+    if (z) {
+      return z;
+    }
+  }
+  uint64_t remaining = flags.length;
+  while (remaining > 0) {
+    wuffs_base__slice_u8 s;
+    const char* z = bgzf_reader__read(r, &s);
+    if (z) {
+      return z;
+    } else if (s.len == 0) {
+      break;
+    }
+    size_t n = (s.len < remaining) ? s.len : (size_t)(remaining);
+    if (fwrite(s.ptr, sizeof(uint8_t), n, stdout) != n) {
+      return "main: error writing output";
+    }
+    remaining -= n;
+  }
+  return NULL;
+}
+
+const char*  //
+main1(int argc, char** argv) {
+  const char* z = parse_flags(argc, argv);
+  if (z) {
+    return z;
+  } else if (flags.remaining_argc > 1) {
+    return "main: usage: bgzf [flags] [data.bgzf]";
+  }
+
+  FILE* f = stdin;
+  if (flags.remaining_argc > 0) {
+    f = fopen(flags.remaining_argv[0], "rb");
+    if (!f) {
+      return strerror(errno);
+    }
+  }
+  bgzf_reader r;
+  z = bgzf_reader__open(&r, f, flags.j);
+  if (!z) {
+    z = main2(&r);
+  }
+  bgzf_reader__close(&r);
+  if (f != stdin) {
+    fclose(f);
+  }
+  return z;
+}
+
+int  //
+compute_exit_code(const char* status_msg) {
+  if (!status_msg) {
+    return 0;
+  }
+  fprintf(stderr, "%s\n", status_msg);
+  // Return an exit code of 1 for regular (forseen) errors, e.g. badly
+  // formatted or unsupported input.
+  //
+  // Return an exit code of 2 for internal (exceptional) errors, e.g. defensive
+  // run-time checks found that an internal invariant did not hold.
+  //
+  // Automated testing, including badly formatted inputs, can therefore
+  // discriminate between expected failure (exit code 1) and unexpected failure
+  // (other non-zero exit codes). Specifically, exit code 2 for internal
+  // invariant violation, exit code 139 (which is 128 + SIGSEGV on x86_64
+  // linux) for a segmentation fault (e.g. null pointer dereference).
+  return strstr(status_msg, "internal error:") ? 2 : 1;
+}
+
+int  //
+main(int argc, char** argv) {
+  return compute_exit_code(main1(argc, argv));
+}
@@ -25,6 +25,11 @@ for a C compiler $CC, such as clang or gcc.
 Add the -color flag to a.out to get 24 bit color ("true color") terminal output
 (in the UTF-8 format) instead of plain ASCII output. Not all terminal emulators
 support true color: https://gist.github.com/XVilka/8346728
+
+Add the -seek=N flag to start the first play at the N'th frame (counting from
+0). The frames before it are decoded but not shown. Decoding starts at the
+nearest frame, at or before frame N, that does not depend on earlier frames,
+found via the GIF decoder's frame index.
 */
 
 #include <errno.h>
@@ -32,6 +37,7 @@ support true color: https://gist.github.com/XVilka/8346728
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 // ----------------
 
@@ -126,6 +132,10 @@ wuffs_base__pixel_buffer pb = {0};
 
 wuffs_base__flicks cumulative_delay_micros = 0;
 
+// frame_index holds one WUFFS_GIF__FRAME_INDEX_ENTRY_LENGTH byte entry per
+// frame. It is only built for the -seek flag.
+wuffs_base__io_buffer frame_index = {0};
+
 const char*  //
 read_stdin() {
   while (src_len < SRC_BUFFER_ARRAY_SIZE) {
@@ -149,8 +159,22 @@ struct {
 
   bool color;
   bool quirk_honor_background_color;
+  uint64_t seek;
 } flags = {0};
 
+static const char*  //
+parse_u64_flag_value(const char* arg, uint64_t* value) {
+  while (*arg++ != '=') {
+  }
+  wuffs_base__result_u64 u = wuffs_base__parse_number_u64(
+      wuffs_base__make_slice_u8((uint8_t*)arg, strlen(arg)));
+  if (!wuffs_base__status__is_ok(&u.status)) {
+    return u.status.repr;
+  }
+  *value = u.value;
+  return NULL;
+}
+
 const char*  //
 parse_flags(int argc, char** argv) {
   int c = (argc > 0) ? 1 : 0;  // Skip argv[0], the program name.
@@ -181,6 +205,12 @@ parse_flags(int argc, char** argv) {
       flags.quirk_honor_background_color = true;
       continue;
     }
+    if (!strncmp(arg, "seek=", 5)) {
+      if (parse_u64_flag_value(arg, &flags.seek)) {
+        return "main: bad -seek=N flag value";
+      }
+      continue;
+    }
 
     return "main: unrecognized flag argument";
   }
@@ -337,6 +367,68 @@ allocate(wuffs_gif__decoder* dec) {
   return status_msg;
 }
 
+// ----
+
+const char*  //
+build_frame_index(wuffs_gif__decoder* dec, wuffs_base__io_buffer* src) {
+  while (true) {
+    wuffs_base__status status =
+        wuffs_gif__decoder__decode_frame_index(dec, &frame_index, src);
+    if (status.repr != wuffs_base__suspension__short_write) {
+      return wuffs_base__status__message(&status);
+    }
+
+    // Grow the index, doubling its capacity.
+    size_t len = frame_index.data.len
+                     ? (2 * frame_index.data.len)
+                     : (64 * WUFFS_GIF__FRAME_INDEX_ENTRY_LENGTH);
+    uint8_t* ptr = (uint8_t*)realloc(frame_index.data.ptr, len);
+    if (!ptr) {
+      return "could not allocate frame index";
+    }
+    frame_index.data.ptr = ptr;
+    frame_index.data.len = len;
+  }
+}
+
+// seek restarts dec at the latest frame, at or before frame flags.seek, that
+// does not depend on the frames before it: frame 0, or an opaque frame that
+// covers the whole image.
+const char*  //
+seek(wuffs_gif__decoder* dec, wuffs_base__io_buffer* src) {
+  TRY(build_frame_index(dec, src));
+  uint64_t num_frames =
+      frame_index.meta.wi / WUFFS_GIF__FRAME_INDEX_ENTRY_LENGTH;
+  if (flags.seek >= num_frames) {
+    return "main: bad -seek=N flag value: not enough frames";
+  }
+
+  uint32_t width = wuffs_base__pixel_config__width(&ic.pixcfg);
+  uint32_t height = wuffs_base__pixel_config__height(&ic.pixcfg);
+  uint64_t i;
+  for (i = flags.seek; i > 0; i--) {
+    uint8_t* p =
+        frame_index.data.ptr + (i * WUFFS_GIF__FRAME_INDEX_ENTRY_LENGTH);
+    if ((wuffs_base__load_u16le__no_bounds_check(p + 8) == 0) &&
+        (wuffs_base__load_u16le__no_bounds_check(p + 10) == 0) &&
+        (wuffs_base__load_u16le__no_bounds_check(p + 12) == width) &&
+        (wuffs_base__load_u16le__no_bounds_check(p + 14) == height) &&
+        (p[19] & WUFFS_GIF__FRAME_INDEX_FLAG_OPAQUE_WITHIN_BOUNDS)) {
+      break;
+    }
+  }
+
+  uint64_t io_position = wuffs_base__load_u64le__no_bounds_check(
+      frame_index.data.ptr + (i * WUFFS_GIF__FRAME_INDEX_ENTRY_LENGTH));
+  if (io_position > src->meta.wi) {
+    return "main: inconsistent frame index";
+  }
+  src->meta.ri = io_position;
+  wuffs_base__status status =
+      wuffs_gif__decoder__restart_frame(dec, i, io_position);
+  return wuffs_base__status__message(&status);
+}
+
 const char*  //
 play() {
   wuffs_gif__decoder dec;
@@ -387,6 +479,9 @@ play() {
     if (!wuffs_base__status__is_ok(&status)) {
       return wuffs_base__status__message(&status);
     }
+    if (flags.seek > 0) {
+      TRY(seek(&dec, &src));
+    }
   }
 
   while (1) {
@@ -425,7 +520,14 @@ play() {
       break;
     }
 
-    size_t n = flags.color ? print_color_art(&pb) : print_ascii_art(&pb);
+    // Frames before the -seek frame are decoded, as later frames may depend
+    // on them, but not shown.
+    bool show =
+        !first_play || (wuffs_base__frame_config__index(&fc) >= flags.seek);
+    size_t n = 0;
+    if (show) {
+      n = flags.color ? print_color_art(&pb) : print_ascii_art(&pb);
+    }
 
     switch (wuffs_base__frame_config__disposal(&fc)) {
       case WUFFS_BASE__ANIMATION_DISPOSAL__RESTORE_BACKGROUND: {
@@ -448,6 +550,13 @@ play() {
       }
     }
 
+    if (!show) {
+      if (!wuffs_base__status__is_ok(&decode_frame_status)) {
+        return wuffs_base__status__message(&decode_frame_status);
+      }
+      continue;
+    }
+
 #if defined(WUFFS_EXAMPLE_USE_TIMERS)
     if (started) {
       struct timespec now;
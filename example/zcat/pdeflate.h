@@ -0,0 +1,520 @@
+// Copyright 2020 The Wuffs Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// ----------------
+
+/*
+pdeflate.h splits a single DEFLATE stream into chunks that can be decoded
+concurrently, similar to the "pugz" approach. It is a small layer over the
+public wuffs_deflate__decoder API. It does no I/O, allocates no memory and
+starts no threads, so that each program (such as zcat's -j=N mode) can run the
+chunks on whatever threads or processes it likes. #include it after Wuffs'
+BASE, CRC32 and DEFLATE modules.
+
+The compressed input, src, is held in memory and positions within it are bit
+offsets, as DEFLATE blocks start at arbitrary bit (not byte) offsets. Decoding
+has three steps:
+
+ 1. pdeflate__chunk__find_block_start looks for the first block boundary at or
+    after a chunk's nominal start. Blocks have no marker, so this tries every
+    bit offset: a cheap filter on what would be a dynamic Huffman block's
+    header (or a stored block's length fields), then a trial decoding that has
+    to get through PDEFLATE__TRIAL_SRC_LEN bytes without error. pdeflate__split
+    turns those boundaries into a list of chunks.
+
+ 2. pdeflate__chunk__decode decodes a chunk, from its boundary to the next one.
+    If the chunk's history (the output just before it) is known, see
+    pdeflate__chunk__set_history. If not, the chunk is speculative and is
+    decoded twice, with two different fake histories. An output byte that is
+    the same in both decodings does not depend on the history. One that
+    differs was copied (perhaps indirectly) from the history, and the pair of
+    bytes identifies the history position it was copied from. The second
+    decoding stops early once the two agree on PDEFLATE__HISTORY_LEN
+    consecutive bytes, as nothing after that can depend on the history.
+
+ 3. Once the previous chunk's output is known, pdeflate__chunk__resolve
+    replaces a speculative chunk's differing bytes with the real history's
+    bytes. pdeflate__chunk__crc32 then gives the chunk's CRC-32 checksum, which
+    wuffs_crc32__ieee_combine can append to the previous chunks' checksum.
+
+A chunk's input is terminated by a sentinel (an empty final stored block)
+placed at the next chunk's boundary. Decoding the chunk only consumes the whole
+sentinel if that boundary is a genuine block boundary, which also confirms
+where the next chunk starts. If anything goes wrong, such as a wrongly guessed
+boundary or a chunk decoding to more than dst_cap bytes, the chunk's ok field
+is false and the caller should decode the rest of the stream sequentially.
+*/
+
+#ifndef WUFFS_EXAMPLE_ZCAT_PDEFLATE_H
+#define WUFFS_EXAMPLE_ZCAT_PDEFLATE_H
+
+#include <string.h>
+
+// PDEFLATE__HISTORY_LEN is the maximum distance in a DEFLATE length-distance
+// back-reference.
+#define PDEFLATE__HISTORY_LEN (32 * 1024)
+
+// PDEFLATE__TRIAL_SRC_LEN and PDEFLATE__TRIAL_DST_LEN bound a trial decoding's
+// input and output.
+#define PDEFLATE__TRIAL_SRC_LEN (32 * 1024)
+#define PDEFLATE__TRIAL_DST_LEN (1024 * 1024)
+
+// PDEFLATE__STEP_LEN is how much output the two speculative decodings produce
+// between comparisons.
+#define PDEFLATE__STEP_LEN (256 * 1024)
+
+// PDEFLATE__NONE is a bit offset meaning "not found" or "no end".
+#define PDEFLATE__NONE UINT64_MAX
+
+typedef struct {
+  // Buffers, set once by the caller. dst[0] and dst[1] each point to
+  // (PDEFLATE__HISTORY_LEN + dst_cap) bytes, and dst_cap is at least
+  // PDEFLATE__TRIAL_DST_LEN. shifted points to at least (src_len + 16) bytes,
+  // for the longest src passed to this chunk's functions.
+  uint8_t* dst[2];
+  size_t dst_cap;
+  uint8_t* shifted;
+
+  // Inputs to pdeflate__chunk__decode, typically set by pdeflate__split.
+  // begin and end are bit offsets into src, and end is PDEFLATE__NONE if the
+  // chunk runs to the end of the stream. Unless speculative is true, the
+  // history_len bytes just before dst[0] + PDEFLATE__HISTORY_LEN are the
+  // chunk's history.
+  uint64_t begin;
+  uint64_t end;
+  size_t history_len;
+  bool speculative;
+
+  // Outputs of pdeflate__chunk__decode. If ok, dst[0] + PDEFLATE__HISTORY_LEN
+  // holds dst_len bytes of output. Only the first diff_len of those can
+  // depend on the history. suffix_crc is the CRC-32 of the rest. src_len is
+  // how many (shifted) input bytes were consumed and final is whether the
+  // chunk ended with the stream's final block.
+  bool ok;
+  bool final;
+  size_t dst_len;
+  size_t diff_len;
+  size_t src_len;
+  uint32_t suffix_crc;
+
+  // Private state.
+  wuffs_deflate__decoder decoders[2];
+  uint8_t
+      work_buffers[2][WUFFS_DEFLATE__DECODER_WORKBUF_LEN_MAX_INCL_WORST_CASE];
+} pdeflate__chunk;
+
+// pdeflate__fake_history returns the i'th byte (for i < PDEFLATE__HISTORY_LEN)
+// of one of two fake histories. The two histories differ at every position,
+// and each position i has a unique pair of bytes, so that
+// pdeflate__chunk__resolve can recover i.
+static inline uint8_t  //
+pdeflate__fake_history(int which, uint32_t i) {
+  return (uint8_t)(which ? ((i & 0xFF) + (i >> 8) + 1) : i);
+}
+
+// pdeflate__shift_bits copies the bits [lo, hi) of src to dst, so that bit lo
+// becomes the lowest bit of dst[0]. It returns the number of bytes written.
+// Any unused high bits of the final byte are zeroed.
+static WUFFS_BASE__POTENTIALLY_UNUSED size_t  //
+pdeflate__shift_bits(uint8_t* dst, uint8_t* src, uint64_t lo, uint64_t hi) {
+  size_t n = (size_t)((hi - lo + 7) / 8);
+  uint8_t* p = src + (lo / 8);
+  uint32_t s = lo % 8;
+  if (s == 0) {
+    memcpy(dst, p, n);
+  } else {
+    // m is the number of src bytes, starting at p, that hold bits below hi.
+    size_t m = (size_t)(((hi + 7) / 8) - (lo / 8));
+    size_t i = 0;
+    for (; (i + 8) < m; i += 8) {
+      uint64_t x = wuffs_base__load_u64le__no_bounds_check(p + i);
+      wuffs_base__store_u64le__no_bounds_check(
+          dst + i, (x >> s) | (((uint64_t)(p[i + 8])) << (64 - s)));
+    }
+    for (; i < n; i++) {
+      uint32_t x = ((i + 1) < m) ? (((uint32_t)(p[i + 1])) << 8) : 0;
+      dst[i] = (uint8_t)((x | p[i]) >> s);
+    }
+  }
+  if ((hi - lo) % 8) {
+    dst[n - 1] &= (uint8_t)((1u << ((hi - lo) % 8)) - 1);
+  }
+  return n;
+}
+
+// pdeflate__append_sentinel appends an empty final stored block to the first
+// n_bits bits of dst, whose other bits (in that last partial byte) must be
+// zero. It returns the resultant length in bytes.
+static inline size_t  //
+pdeflate__append_sentinel(uint8_t* dst, uint64_t n_bits) {
+  size_t i = (size_t)(n_bits / 8);
+  if ((n_bits % 8) == 0) {
+    dst[i] = 0;
+  }
+  // BFINAL is 1 and BTYPE is 0, spilling into the next byte if necessary.
+  dst[i] |= (uint8_t)(1u << (n_bits % 8));
+  dst[i + 1] = 0;
+  // After the 3 header bits, skip to a byte boundary. LEN is 0x0000 and NLEN
+  // is 0xFFFF.
+  i = (size_t)((n_bits + 3 + 7) / 8);
+  dst[i + 0] = 0x00;
+  dst[i + 1] = 0x00;
+  dst[i + 2] = 0xFF;
+  dst[i + 3] = 0xFF;
+  return i + 4;
+}
+
+static WUFFS_BASE__POTENTIALLY_UNUSED uint32_t  //
+pdeflate__crc32(const uint8_t* ptr, size_t len) {
+  wuffs_crc32__ieee_hasher h;
+  wuffs_base__status status =
+      wuffs_crc32__ieee_hasher__initialize(&h, sizeof h, WUFFS_VERSION, 0);
+  if (!wuffs_base__status__is_ok(&status)) {
+    return 0;
+  }
+  return wuffs_crc32__ieee_hasher__update_u32(
+      &h, wuffs_base__make_slice_u8((uint8_t*)ptr, len));
+}
+
+// pdeflate__start_decoder initializes dec for whole-output-in-dst decoding,
+// preceded by history_len bytes of history. Those bytes are passed via
+// add_history. Bytes in dst before the stream's first output byte are not the
+// decoder's own output, so it does not resolve back-references against them.
+static inline bool  //
+pdeflate__start_decoder(wuffs_deflate__decoder* dec,
+                        uint32_t options,
+                        uint8_t* history,
+                        size_t history_len,
+                        wuffs_base__slice_u8 workbuf) {
+  wuffs_base__status status = wuffs_deflate__decoder__initialize(
+      dec, sizeof *dec, WUFFS_VERSION, options);
+  if (!wuffs_base__status__is_ok(&status)) {
+    return false;
+  }
+  wuffs_deflate__decoder__set_whole_output_in_dst(dec, true);
+  if (history_len > 0) {
+    status = wuffs_deflate__decoder__add_history(
+        dec, wuffs_base__make_slice_u8(history, history_len), workbuf);
+    if (!wuffs_base__status__is_ok(&status)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static inline wuffs_base__io_buffer  //
+pdeflate__make_io_buffer(uint8_t* ptr, size_t len, size_t wi, bool closed) {
+  wuffs_base__io_buffer b;
+  b.data = wuffs_base__make_slice_u8(ptr, len);
+  b.meta.wi = wi;
+  b.meta.ri = 0;
+  b.meta.pos = 0;
+  b.meta.closed = closed;
+  return b;
+}
+
+// pdeflate__chunk__trial_decode returns whether decoding from src's bit offset
+// begin gets through PDEFLATE__TRIAL_SRC_LEN bytes of input (or
+// PDEFLATE__TRIAL_DST_LEN bytes of output, or to the end of the stream)
+// without error.
+static bool  //
+pdeflate__chunk__trial_decode(pdeflate__chunk* c,
+                              uint8_t* src,
+                              size_t src_len,
+                              bool src_closed,
+                              uint64_t begin) {
+  wuffs_deflate__decoder* dec = &c->decoders[0];
+  wuffs_base__slice_u8 workbuf = wuffs_base__make_slice_u8(
+      c->work_buffers[0], sizeof c->work_buffers[0]);
+  uint64_t src_bits = 8 * (uint64_t)(src_len);
+
+  // Most implausible block boundaries fail within the first few bytes, so
+  // start with a short prefix. That first pass skips the cost of copying in
+  // the fake history (whose contents don't matter, only its length), so its
+  // "#bad distance" errors are inconclusive. The second pass starts over with
+  // that history.
+  uint64_t lens[2] = {64, PDEFLATE__TRIAL_SRC_LEN};
+  int i;
+  for (i = 0; i < 2; i++) {
+    if (!pdeflate__start_decoder(
+            dec, WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED,
+            c->dst[0], (i == 0) ? 0 : PDEFLATE__HISTORY_LEN, workbuf)) {
+      return false;
+    }
+    wuffs_base__io_buffer dst = pdeflate__make_io_buffer(
+        c->dst[0], PDEFLATE__HISTORY_LEN + PDEFLATE__TRIAL_DST_LEN,
+        PDEFLATE__HISTORY_LEN, false);
+    dst.meta.ri = PDEFLATE__HISTORY_LEN;
+    uint64_t hi = wuffs_base__u64__min(begin + (8 * lens[i]), src_bits);
+    size_t n = pdeflate__shift_bits(c->shifted, src, begin, hi);
+    wuffs_base__io_buffer s = pdeflate__make_io_buffer(
+        c->shifted, n, n, src_closed && (hi == src_bits));
+    wuffs_base__status status =
+        wuffs_deflate__decoder__transform_io(dec, &dst, &s, workbuf);
+    if (status.repr == wuffs_base__suspension__short_read) {
+      if (s.meta.closed) {
+        return false;
+      }
+    } else if ((i > 0) || (status.repr != wuffs_deflate__error__bad_distance)) {
+      return !wuffs_base__status__is_error(&status);
+    }
+  }
+  return true;
+}
+
+// pdeflate__chunk__find_block_start returns the first plausible block
+// boundary, a bit offset into src, at or after lo. It looks for the start of a
+// non-final dynamic Huffman block in the range [lo, hi) or for the end of a
+// stored block (whose LEN and NLEN fields are in that range). It returns
+// PDEFLATE__NONE if there is no such boundary. Unless src_closed, hi should
+// leave PDEFLATE__TRIAL_SRC_LEN bytes of src for a trial decoding.
+//
+// It uses c's buffers and decoders as scratch space.
+static WUFFS_BASE__POTENTIALLY_UNUSED uint64_t  //
+pdeflate__chunk__find_block_start(pdeflate__chunk* c,
+                                  uint8_t* src,
+                                  size_t src_len,
+                                  bool src_closed,
+                                  uint64_t lo,
+                                  uint64_t hi) {
+  for (; lo < hi; lo++) {
+    size_t i = (size_t)(lo / 8);
+    if ((i + 4) > src_len) {
+      break;
+    }
+
+    // Incompressible input is typically encoded as stored blocks, which are
+    // byte aligned and have a 32-bit (LEN, NLEN) check.
+    if ((lo % 8) == 0) {
+      uint32_t len = wuffs_base__load_u16le__no_bounds_check(src + i + 0);
+      uint32_t nlen = wuffs_base__load_u16le__no_bounds_check(src + i + 2);
+      uint64_t end = 8 * (uint64_t)(i + 4 + len);
+      if (((len ^ nlen) == 0xFFFF) && (end < (8 * (uint64_t)(src_len))) &&
+          pdeflate__chunk__trial_decode(c, src, src_len, src_closed, end)) {
+        return end;
+      }
+    }
+
+    uint32_t x = ((uint32_t)(src[i + 0]) << 0) |
+                 ((uint32_t)(src[i + 1]) << 8) |
+                 ((uint32_t)(src[i + 2]) << 16);
+    x >>= lo % 8;
+    // The low 3 bits are BFINAL (0) and BTYPE (2). The next two 5-bit fields,
+    // HLIT and HDIST, are at most 29.
+    if (((x & 7) != 4) || (((x >> 3) & 31) > 29) || (((x >> 8) & 31) > 29)) {
+      continue;
+    }
+    if (pdeflate__chunk__trial_decode(c, src, src_len, src_closed, lo)) {
+      return lo;
+    }
+  }
+  return PDEFLATE__NONE;
+}
+
+// pdeflate__split sets chunks' begin, end and speculative fields, for chunks
+// that start at the bit offset begin and at each of the n_found block
+// boundaries in found. Boundaries that are PDEFLATE__NONE, or that are not
+// after the previous one, are skipped. If src_closed, the last chunk runs to
+// the end of the stream, unless there are already n_found chunks. It returns
+// the number of chunks, at most n_found.
+//
+// Only the first chunk is not speculative. Its history_len is set to zero:
+// call pdeflate__chunk__set_history if the stream has earlier output.
+static WUFFS_BASE__POTENTIALLY_UNUSED uint32_t  //
+pdeflate__split(pdeflate__chunk* chunks,
+                uint64_t begin,
+                const uint64_t* found,
+                uint32_t n_found,
+                bool src_closed) {
+  uint32_t n = 0;
+  uint32_t i;
+  for (i = 0; i < n_found; i++) {
+    if ((found[i] != PDEFLATE__NONE) && (found[i] > begin)) {
+      chunks[n].begin = begin;
+      chunks[n].end = found[i];
+      n++;
+      begin = found[i];
+    }
+  }
+  if (src_closed && (n < n_found)) {
+    chunks[n].begin = begin;
+    chunks[n].end = PDEFLATE__NONE;
+    n++;
+  }
+  for (i = 0; i < n; i++) {
+    chunks[i].history_len = 0;
+    chunks[i].speculative = i > 0;
+  }
+  return n;
+}
+
+// pdeflate__chunk__set_history sets a non-speculative chunk's history: the
+// last history_len bytes of history, which points to PDEFLATE__HISTORY_LEN
+// bytes.
+static WUFFS_BASE__POTENTIALLY_UNUSED void  //
+pdeflate__chunk__set_history(pdeflate__chunk* c,
+                             const uint8_t* history,
+                             size_t history_len) {
+  c->history_len = history_len;
+  c->speculative = false;
+  memcpy(c->dst[0] + PDEFLATE__HISTORY_LEN - history_len,
+         history + PDEFLATE__HISTORY_LEN - history_len, history_len);
+}
+
+// pdeflate__chunk__decode decodes src's bits from c->begin to c->end, or to
+// the end of the stream if c->end is PDEFLATE__NONE. It sets c->ok and, if
+// ok, c's other output fields.
+static WUFFS_BASE__POTENTIALLY_UNUSED void  //
+pdeflate__chunk__decode(pdeflate__chunk* c,
+                        uint8_t* src,
+                        size_t src_len,
+                        bool src_closed) {
+  c->ok = false;
+
+  uint64_t hi = c->end;
+  if (hi == PDEFLATE__NONE) {
+    hi = 8 * (uint64_t)(src_len);
+  }
+  size_t n = pdeflate__shift_bits(c->shifted, src, c->begin, hi);
+  if (c->end != PDEFLATE__NONE) {
+    n = pdeflate__append_sentinel(c->shifted, hi - c->begin);
+  }
+
+  size_t h = c->speculative ? PDEFLATE__HISTORY_LEN : c->history_len;
+  int n_decs = c->speculative ? 2 : 1;
+  wuffs_base__io_buffer dst[2];
+  wuffs_base__io_buffer s[2];
+  int d;
+  for (d = 0; d < n_decs; d++) {
+    if (c->speculative) {
+      uint32_t i;
+      for (i = 0; i < PDEFLATE__HISTORY_LEN; i++) {
+        c->dst[d][i] = pdeflate__fake_history(d, i);
+      }
+    }
+    if (!pdeflate__start_decoder(
+            &c->decoders[d], 0, c->dst[d] + PDEFLATE__HISTORY_LEN - h, h,
+            wuffs_base__make_slice_u8(c->work_buffers[d],
+                                      sizeof c->work_buffers[d]))) {
+      return;
+    }
+    dst[d] = pdeflate__make_io_buffer(c->dst[d] + PDEFLATE__HISTORY_LEN - h,
+                                      h + c->dst_cap, h, false);
+    dst[d].meta.ri = h;
+    s[d] = pdeflate__make_io_buffer(c->shifted, n, n,
+                                    (c->end != PDEFLATE__NONE) || src_closed);
+  }
+
+  // diff_end is just past the last output byte (so far) where the two
+  // speculative decodings differ.
+  size_t diff_end = h;
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+  while (true) {
+    size_t wi = dst[0].meta.wi;
+    for (d = 0; d < n_decs; d++) {
+      if (n_decs > 1) {
+        dst[d].data.len =
+            wuffs_base__u64__min(wi + PDEFLATE__STEP_LEN, h + c->dst_cap);
+      } else {
+        dst[d].data.len = h + c->dst_cap;
+      }
+      wuffs_base__status z = wuffs_deflate__decoder__transform_io(
+          &c->decoders[d], &dst[d], &s[d],
+          wuffs_base__make_slice_u8(c->work_buffers[d],
+                                    sizeof c->work_buffers[d]));
+      if (d == 0) {
+        status = z;
+      } else if ((z.repr != status.repr) ||
+                 (dst[1].meta.wi != dst[0].meta.wi)) {
+        return;
+      }
+    }
+
+    if (n_decs > 1) {
+      size_t i;
+      for (i = dst[0].meta.wi; i > wi; i--) {
+        if (dst[0].data.ptr[i - 1] != dst[1].data.ptr[i - 1]) {
+          diff_end = i;
+          break;
+        }
+      }
+      if ((dst[0].meta.wi - diff_end) >= PDEFLATE__HISTORY_LEN) {
+        n_decs = 1;
+      }
+    }
+
+    if (status.repr != wuffs_base__suspension__short_write) {
+      break;
+    } else if (dst[0].meta.wi == (h + c->dst_cap)) {
+      return;
+    }
+  }
+  if (!wuffs_base__status__is_ok(&status)) {
+    return;
+  }
+
+  c->ok = true;
+  c->final = (c->end == PDEFLATE__NONE) || (s[0].meta.ri < n);
+  c->dst_len = dst[0].meta.wi - h;
+  c->diff_len = diff_end - h;
+  c->src_len = s[0].meta.ri;
+  c->suffix_crc =
+      pdeflate__crc32(dst[0].data.ptr + diff_end, dst[0].meta.wi - diff_end);
+}
+
+// pdeflate__chunk__resolve replaces a decoded chunk's output bytes that were
+// copied from the fake history with the real history's bytes: the last
+// history_len bytes of history, which points to PDEFLATE__HISTORY_LEN bytes.
+// It does nothing for a chunk that is not speculative.
+static WUFFS_BASE__POTENTIALLY_UNUSED const char*  //
+pdeflate__chunk__resolve(pdeflate__chunk* c,
+                         const uint8_t* history,
+                         size_t history_len) {
+  if (!c->speculative) {
+    return NULL;
+  }
+  uint8_t* p0 = c->dst[0] + PDEFLATE__HISTORY_LEN;
+  uint8_t* p1 = c->dst[1] + PDEFLATE__HISTORY_LEN;
+  size_t n = c->diff_len;
+  size_t i = 0;
+  while (i < n) {
+    if (((i + 8) <= n) && (wuffs_base__load_u64le__no_bounds_check(p0 + i) ==
+                           wuffs_base__load_u64le__no_bounds_check(p1 + i))) {
+      i += 8;
+      continue;
+    }
+    if (p0[i] != p1[i]) {
+      uint32_t hi = (uint8_t)(p1[i] - p0[i] - 1);
+      uint32_t j = (hi << 8) | p0[i];
+      if ((j >= PDEFLATE__HISTORY_LEN) ||
+          (j < (PDEFLATE__HISTORY_LEN - history_len))) {
+        return wuffs_deflate__error__bad_distance;
+      }
+      p0[i] = history[j];
+    }
+    i++;
+  }
+  return NULL;
+}
+
+// pdeflate__chunk__crc32 returns the CRC-32 checksum of a decoded (and, if
+// speculative, resolved) chunk's output.
+static WUFFS_BASE__POTENTIALLY_UNUSED uint32_t  //
+pdeflate__chunk__crc32(pdeflate__chunk* c) {
+  return wuffs_crc32__ieee_combine(
+      pdeflate__crc32(c->dst[0] + PDEFLATE__HISTORY_LEN, c->diff_len),
+      c->suffix_crc, c->dst_len - c->diff_len);
+}
+
+#endif  // WUFFS_EXAMPLE_ZCAT_PDEFLATE_H
@@ -16,15 +16,32 @@
 
 /*
 zcat decodes gzip'ed data to stdout. It is similar to the standard /bin/zcat
-program, except that this example program only reads from stdin. On Linux, it
+program, except that this example program only reads from stdin. Like
+"gzip -dc", it decodes every member of a multi-member gzip file. On Linux, it
 also self-imposes a SECCOMP_MODE_STRICT sandbox. To run:
 
-$CC zcat.c && ./a.out < ../../test/data/romeo.txt.gz; rm -f a.out
+$CC zcat.c -lpthread && ./a.out < ../../test/data/romeo.txt.gz; rm -f a.out
 
 for a C compiler $CC, such as clang or gcc.
+
+On Linux, the -j=N flag (for N > 1) decodes a single gzip stream using N
+worker threads, similar to the "pugz" approach. Each worker speculatively
+decodes a chunk of the compressed input without knowing that chunk's 32 KiB
+history, and the main thread then resolves the back-references into that
+history. The algorithm is in pdeflate.h, which does not depend on zcat. The
+"Parallel decoding" section below has more details.
+
+The -stats flag prints, to stderr, what the DEFLATE decoder saw: how many of
+each block type, how many bytes came from stored blocks or from the decoder's
+fast or slow Huffman code paths, how many literals and matches (with
+histograms of match lengths and distances) and how many Huffman tables were
+built. This can help diagnose why a particular file decodes slowly. It cannot
+be combined with -j=N.
 */
 
 #include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
 #include <unistd.h>
 
 // Wuffs ships as a "single file C library" or "header file library" as per
@@ -53,11 +70,19 @@ for a C compiler $CC, such as clang or gcc.
 // program to generate a stand-alone C file.
 #include "../../release/c/wuffs-unsupported-snapshot.c"
 
+// pdeflate.h implements the -j=N flag's parallel decoding.
+#include "pdeflate.h"
+
 #if defined(__linux__)
 #include <linux/prctl.h>
 #include <linux/seccomp.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <sys/mman.h>
 #include <sys/prctl.h>
 #include <sys/syscall.h>
+#define WUFFS_EXAMPLE_USE_MMAP_RING_BUFFER
+#define WUFFS_EXAMPLE_USE_PARALLEL
 #define WUFFS_EXAMPLE_USE_SECCOMP
 #endif
 
@@ -81,6 +106,93 @@ uint8_t work_buffer_array[WORK_BUFFER_ARRAY_SIZE];
 uint8_t work_buffer_array[1];
 #endif
 
+// HISTORY_LEN is the maximum distance in a DEFLATE length-distance
+// back-reference.
+#define HISTORY_LEN PDEFLATE__HISTORY_LEN
+
+// PARALLEL_MAX_J is the maximum value of the -j=N flag.
+#define PARALLEL_MAX_J 64
+
+// ----
+
+// When available, dst is a ring buffer instead of dst_buffer_array. The ring
+// buffer's DST_BUFFER_ARRAY_SIZE bytes of physical memory are mapped three
+// times, contiguously, into virtual memory, as per script/mmap-ring-buffer.c.
+//
+// After writing the decoded output to stdout, instead of compacting dst (which
+// discards the history), dst.data.ptr is re-based to keep the most recent
+// HISTORY_LEN bytes of output just before dst's write index. Those bytes are
+// not moved: re-basing only changes which of the three aliases we point at.
+// The decoder can therefore resolve every back-reference against dst's
+// history and never has to copy the output into its own history ringbuffer.
+//
+// The mmap calls happen before the SECCOMP_MODE_STRICT sandbox is imposed.
+static uint8_t* ring_buffer_base = NULL;
+
+#if defined(WUFFS_EXAMPLE_USE_MMAP_RING_BUFFER)
+
+// We call memfd_create via syscall instead of #include'ing <sys/memfd.h>, as
+// per script/mmap-ring-buffer.c.
+static uint8_t*  //
+make_ring_buffer(size_t n) {
+  long page_size = sysconf(_SC_PAGESIZE);
+  if ((page_size <= 0) || (n < (size_t)(page_size)) ||
+      ((n % (size_t)(page_size)) != 0) || (n <= HISTORY_LEN)) {
+    return NULL;
+  }
+
+  int memfd = syscall(__NR_memfd_create, "zcat-ring", 0);
+  if (memfd == -1) {
+    return NULL;
+  }
+  uint8_t* base = NULL;
+  if (ftruncate(memfd, n) == 0) {
+    // Have the kernel find a contiguous range of unused address space, then
+    // map the memfd 3 times, filling that range exactly.
+    void* p = mmap(NULL, 3 * n, PROT_NONE, MAP_ANONYMOUS | MAP_PRIVATE, -1, 0);
+    if (p != MAP_FAILED) {
+      base = (uint8_t*)(p);
+      int i;
+      for (i = 0; i < 3; i++) {
+        if (mmap(base + (i * n), n, PROT_READ | PROT_WRITE,
+                 MAP_FIXED | MAP_SHARED, memfd, 0) == MAP_FAILED) {
+          munmap(base, 3 * n);
+          base = NULL;
+          break;
+        }
+      }
+    }
+  }
+  close(memfd);
+  return base;
+}
+
+#endif  // defined(WUFFS_EXAMPLE_USE_MMAP_RING_BUFFER)
+
+// rebase_ring_buffer is like wuffs_base__io_buffer__compact, for a ring
+// buffer dst that has no unread data (dst->meta.ri == dst->meta.wi), except
+// that it keeps up to HISTORY_LEN bytes of history.
+static void  //
+rebase_ring_buffer(wuffs_base__io_buffer* dst) {
+  const size_t n = DST_BUFFER_ARRAY_SIZE;
+  size_t h = dst->meta.wi;
+  if (h > HISTORY_LEN) {
+    h = HISTORY_LEN;
+  }
+  // o is the write index's offset within the ring buffer's physical memory.
+  size_t o = ((size_t)(dst->data.ptr + dst->meta.wi - ring_buffer_base)) % n;
+  // Point into the middle mapping. The resultant data.ptr is at least
+  // (ring_buffer_base + n - HISTORY_LEN) and data.ptr + n is at most
+  // (ring_buffer_base + 3*n), so all of dst is within the three mappings.
+  // Writing up to (n - h) bytes, starting at the write index, does not
+  // overwrite the h bytes of history.
+  dst->meta.pos = wuffs_base__u64__sat_add(dst->meta.pos, dst->meta.wi - h);
+  dst->data.ptr = ring_buffer_base + n + o - h;
+  dst->data.len = n;
+  dst->meta.wi = h;
+  dst->meta.ri = h;
+}
+
 // ----
 
 static bool sandboxed = false;
@@ -90,6 +202,8 @@ struct {
   char** remaining_argv;
 
   bool fail_if_unsandboxed;
+  uint32_t j;
+  bool stats;
 } flags = {0};
 
 const char*  //
@@ -118,6 +232,22 @@ parse_flags(int argc, char** argv) {
       flags.fail_if_unsandboxed = true;
       continue;
     }
+    if (!strncmp(arg, "j=", 2)) {
+      while (*arg++ != '=') {
+      }
+      wuffs_base__result_u64 u = wuffs_base__parse_number_u64(
+          wuffs_base__make_slice_u8((uint8_t*)arg, strlen(arg)));
+      if (wuffs_base__status__is_ok(&u.status) && (u.value >= 1) &&
+          (u.value <= PARALLEL_MAX_J)) {
+        flags.j = (uint32_t)(u.value);
+        continue;
+      }
+      return "main: bad -j=N flag value";
+    }
+    if (!strcmp(arg, "stats")) {
+      flags.stats = true;
+      continue;
+    }
 
     return "main: unrecognized flag argument";
   }
@@ -127,21 +257,574 @@ parse_flags(int argc, char** argv) {
   return NULL;
 }
 
+// ---- Parallel decoding (the -j flag)
+
+// With -j=N, each gzip member's DEFLATE stream is decoded in rounds, using
+// pdeflate.h (which describes the algorithm in more detail). Each round reads
+// about N * PARALLEL_CHUNK_SRC_LEN bytes of compressed input into in_buf and
+// then:
+//
+//  1. Each of N worker threads looks for the first block boundary at or after
+//     its chunk's nominal start.
+//  2. Each worker decodes a chunk, from one boundary to the next. The first
+//     chunk's history is known: it is the previous round's output. The other
+//     chunks are decoded speculatively.
+//  3. The main thread, in chunk order, resolves the speculative chunks against
+//     the real history, combines the chunks' CRC-32 checksums and writes the
+//     output to stdout.
+//
+// If anything goes wrong, such as a wrongly guessed boundary or a chunk
+// decoding to more than PARALLEL_CHUNK_DST_LEN bytes, the main thread falls
+// back to decoding the rest of the member sequentially. The gzip trailer's
+// CRC-32 and length are checked either way. Each member of a multi-member gzip
+// file is decoded in turn, starting with an empty history.
+//
+// The workers are started before the sandbox is imposed and then sandbox
+// themselves. SECCOMP_MODE_STRICT does not allow futexes (which pthread mutexes
+// and condition variables need), so the threads communicate over pipes.
+
+#if defined(WUFFS_EXAMPLE_USE_PARALLEL)
+
+#ifndef PARALLEL_CHUNK_SRC_LEN
+#define PARALLEL_CHUNK_SRC_LEN (4 * 1024 * 1024)
+#endif
+
+// PARALLEL_CHUNK_DST_LEN is the maximum decoded length of a chunk. The memory
+// is reserved but, for typical compression ratios, mostly never touched.
+#define PARALLEL_CHUNK_DST_LEN (16 * PARALLEL_CHUNK_SRC_LEN)
+
+// PARALLEL_SCAN_LEN is how much input (in bytes) past the last chunk's nominal
+// start is read, to find the block boundary that ends that chunk.
+#define PARALLEL_SCAN_LEN (1024 * 1024)
+
+#define PARALLEL_IN_LEN(j) \
+  (((j)*PARALLEL_CHUNK_SRC_LEN) + PARALLEL_SCAN_LEN + PDEFLATE__TRIAL_SRC_LEN)
+
+// in_buf holds in_len bytes of compressed input. Bit offsets, such as a
+// pdeflate__chunk's begin and end, are relative to in_buf[0].
+static uint8_t* in_buf = NULL;
+static size_t in_cap = 0;
+static size_t in_len = 0;
+static bool in_closed = false;
+
+// parallel_chunks[w] is worker w's chunk to decode. When finding a block
+// boundary, it is worker w's scratch space instead: parallel_finds[w] holds
+// that task's inputs (lo and hi) and output (found).
+static pdeflate__chunk* parallel_chunks = NULL;
+static struct {
+  uint64_t lo;
+  uint64_t hi;
+  uint64_t found;
+} parallel_finds[PARALLEL_MAX_J];
+
+static uint32_t parallel_n_workers = 0;
+static int parallel_cmd_fds[PARALLEL_MAX_J][2];
+static int parallel_resp_fds[PARALLEL_MAX_J][2];
+
+static wuffs_deflate__decoder sequential_decoder;
+static uint8_t sequential_work_buffer
+    [WUFFS_DEFLATE__DECODER_WORKBUF_LEN_MAX_INCL_WORST_CASE];
+
+// po is the main thread's running state for the current gzip member: the most
+// recent HISTORY_LEN bytes of output and the CRC-32 and length of all of the
+// output.
+static struct {
+  uint8_t history[HISTORY_LEN];
+  size_t history_len;
+  uint32_t crc;
+  uint64_t len;
+} po = {0};
+
+// parallel_worker runs worker w's tasks: 'f' to find a block boundary, 'd' to
+// decode a chunk and 'q' to quit.
+static void*  //
+parallel_worker(void* arg) {
+  uint32_t w = (uint32_t)(uintptr_t)(arg);
+#if defined(WUFFS_EXAMPLE_USE_SECCOMP)
+  prctl(PR_SET_SECCOMP, SECCOMP_MODE_STRICT);
+#endif
+  while (true) {
+    uint8_t op = 0;
+    ssize_t n = read(parallel_cmd_fds[w][0], &op, 1);
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      break;
+    } else if ((n == 0) || (op == 'q')) {
+      break;
+    }
+
+    if (op == 'f') {
+      parallel_finds[w].found = pdeflate__chunk__find_block_start(
+          &parallel_chunks[w], in_buf, in_len, in_closed, parallel_finds[w].lo,
+          parallel_finds[w].hi);
+    } else if (op == 'd') {
+      pdeflate__chunk__decode(&parallel_chunks[w], in_buf, in_len, in_closed);
+    }
+
+    while ((n = write(parallel_resp_fds[w][1], &op, 1)) < 0) {
+      if (errno != EINTR) {
+        break;
+      }
+    }
+    if (n < 0) {
+      break;
+    }
+  }
+#if defined(WUFFS_EXAMPLE_USE_SECCOMP)
+  // SECCOMP_MODE_STRICT allows only SYS_exit, which ends just this thread.
+  syscall(SYS_exit, 0);
+#endif
+  return NULL;
+}
+
+// start_parallel_workers is called before the sandbox is imposed.
+static const char*  //
+start_parallel_workers() {
+  in_cap = PARALLEL_IN_LEN(flags.j);
+  size_t dst_len = HISTORY_LEN + PARALLEL_CHUNK_DST_LEN;
+  size_t shifted_len = in_cap + 16;
+  size_t total_len = in_cap + (flags.j * ((2 * dst_len) + shifted_len));
+  void* p = mmap(NULL, total_len, PROT_READ | PROT_WRITE,
+                 MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+  parallel_chunks = calloc(flags.j, sizeof(pdeflate__chunk));
+  if ((p == MAP_FAILED) || !parallel_chunks) {
+    return "main: could not allocate memory";
+  }
+  uint8_t* q = (uint8_t*)(p);
+  in_buf = q;
+  q += in_cap;
+  uint32_t w;
+  for (w = 0; w < flags.j; w++) {
+    parallel_chunks[w].dst[0] = q;
+    q += dst_len;
+    parallel_chunks[w].dst[1] = q;
+    q += dst_len;
+    parallel_chunks[w].dst_cap = PARALLEL_CHUNK_DST_LEN;
+    parallel_chunks[w].shifted = q;
+    q += shifted_len;
+  }
+
+  for (w = 0; w < flags.j; w++) {
+    if ((pipe(parallel_cmd_fds[w]) != 0) || (pipe(parallel_resp_fds[w]) != 0)) {
+      return "main: could not create pipes";
+    }
+    pthread_t thread;
+    if (pthread_create(&thread, NULL, parallel_worker,
+                       (void*)(uintptr_t)(w))) {
+      return "main: could not create threads";
+    }
+    pthread_detach(thread);
+    parallel_n_workers++;
+  }
+  return NULL;
+}
+
+static const char*  //
+parallel_call(uint32_t w, uint8_t op) {
+  while (write(parallel_cmd_fds[w][1], &op, 1) < 0) {
+    if (errno != EINTR) {
+      return strerror(errno);
+    }
+  }
+  return NULL;
+}
+
+static const char*  //
+parallel_wait(uint32_t w) {
+  while (true) {
+    uint8_t op = 0;
+    ssize_t n = read(parallel_resp_fds[w][0], &op, 1);
+    if (n > 0) {
+      return NULL;
+    } else if (n == 0) {
+      return "main: internal error: worker exited";
+    } else if (errno != EINTR) {
+      return strerror(errno);
+    }
+  }
+}
+
+// stop_parallel_workers asks every worker to quit, after finishing any task
+// that it is busy with. Under SECCOMP_MODE_STRICT, the main thread's SYS_exit
+// does not end the other threads.
+static void  //
+stop_parallel_workers() {
+  uint32_t w;
+  for (w = 0; w < parallel_n_workers; w++) {
+    parallel_call(w, 'q');
+  }
+}
+
 // ----
 
-// ignore_return_value suppresses errors from -Wall -Werror.
+// read_in reads from stdin into in_buf until in_buf is full or at EOF.
+static const char*  //
+read_in() {
+  while (!in_closed && (in_len < in_cap)) {
+    const int stdin_fd = 0;
+    ssize_t n = read(stdin_fd, in_buf + in_len, in_cap - in_len);
+    if (n < 0) {
+      if (errno != EINTR) {
+        return strerror(errno);
+      }
+      continue;
+    } else if (n == 0) {
+      in_closed = true;
+    } else {
+      in_len += (size_t)(n);
+    }
+  }
+  return NULL;
+}
+
+// discard_in discards in_buf's first n bytes.
 static void  //
-ignore_return_value(int ignored) {}
+discard_in(size_t n) {
+  memmove(in_buf, in_buf + n, in_len - n);
+  in_len -= n;
+}
 
-const char*  //
-main1(int argc, char** argv) {
-  const char* z = parse_flags(argc, argv);
+// emit writes len bytes of output, whose CRC-32 is crc, to stdout.
+static const char*  //
+emit(const uint8_t* ptr, size_t len, uint32_t crc) {
+  po.crc = wuffs_crc32__ieee_combine(po.crc, crc, len);
+  po.len += len;
+
+  if (len >= HISTORY_LEN) {
+    memcpy(po.history, ptr + len - HISTORY_LEN, HISTORY_LEN);
+  } else {
+    memmove(po.history, po.history + len, HISTORY_LEN - len);
+    memcpy(po.history + HISTORY_LEN - len, ptr, len);
+  }
+  po.history_len = wuffs_base__u64__min(po.history_len + len, HISTORY_LEN);
+
+  while (len > 0) {
+    const int stdout_fd = 1;
+    ssize_t n = write(stdout_fd, ptr, len);
+    if (n < 0) {
+      if (errno != EINTR) {
+        return strerror(errno);
+      }
+      continue;
+    }
+    ptr += n;
+    len -= (size_t)(n);
+  }
+  return NULL;
+}
+
+// check_trailer checks and then discards the gzip trailer, given that the
+// DEFLATE stream ended within the 8 bits before in_buf's bit offset c.
+static const char*  //
+check_trailer(uint64_t c) {
+  discard_in((size_t)(c / 8));
+  const char* z = read_in();
   if (z) {
     return z;
   }
+  // The trailer starts at the first byte boundary after the DEFLATE stream.
+  // If c isn't byte aligned then that is either byte 0 or byte 1.
+  size_t i;
+  for (i = 0; i <= ((c % 8) ? 1 : 0); i++) {
+    if (((i + 8) <= in_len) &&
+        (wuffs_base__load_u32le__no_bounds_check(in_buf + i + 0) == po.crc) &&
+        (wuffs_base__load_u32le__no_bounds_check(in_buf + i + 4) ==
+         (uint32_t)(po.len))) {
+      discard_in(i + 8);
+      return NULL;
+    }
+  }
+  return (in_len < 8) ? wuffs_base__error__not_enough_data
+                      : wuffs_gzip__error__bad_checksum;
+}
+
+// parse_gzip_header sets *begin to the bit offset, into in_buf, of the DEFLATE
+// stream after the gzip header.
+static const char*  //
+parse_gzip_header(uint64_t* begin) {
+  uint8_t* p = in_buf;
+  size_t n = in_len;
+  if (n < 10) {
+    return wuffs_base__error__not_enough_data;
+  } else if ((p[0] != 0x1F) || (p[1] != 0x8B)) {
+    return wuffs_gzip__error__bad_header;
+  } else if (p[2] != 0x08) {
+    return wuffs_gzip__error__bad_compression_method;
+  } else if (p[3] & 0xE0) {
+    return wuffs_gzip__error__bad_encoding_flags;
+  }
+  uint8_t gz_flags = p[3];
+  size_t i = 10;
+  // FEXTRA.
+  if (gz_flags & 0x04) {
+    if ((i + 2) > n) {
+      return wuffs_base__error__not_enough_data;
+    }
+    i += 2 + wuffs_base__load_u16le__no_bounds_check(p + i);
+  }
+  // FNAME and FCOMMENT.
+  uint8_t bit;
+  for (bit = 0x08; bit <= 0x10; bit <<= 1) {
+    if (gz_flags & bit) {
+      for (; (i < n) && p[i]; i++) {
+      }
+      i++;
+    }
+  }
+  // FHCRC.
+  if (gz_flags & 0x02) {
+    i += 2;
+  }
+  if (i > n) {
+    return wuffs_base__error__not_enough_data;
+  }
+  *begin = 8 * (uint64_t)(i);
+  return NULL;
+}
+
+// decode_sequentially decodes the rest of the gzip member, from in_buf's bit
+// offset begin, on the main thread. It handles everything that the parallel
+// code path gives up on. It borrows the first chunk's buffers.
+static const char*  //
+decode_sequentially(uint64_t begin) {
+  pdeflate__chunk* c = &parallel_chunks[0];
+  wuffs_deflate__decoder* dec = &sequential_decoder;
+  wuffs_base__slice_u8 workbuf = wuffs_base__make_slice_u8(
+      sequential_work_buffer, sizeof sequential_work_buffer);
+
+  size_t h = po.history_len;
+  memcpy(c->dst[0] + HISTORY_LEN - h, po.history + HISTORY_LEN - h, h);
+  if (!pdeflate__start_decoder(dec, 0, c->dst[0] + HISTORY_LEN - h, h,
+                               workbuf)) {
+    return "main: internal error: could not initialize decoder";
+  }
+  wuffs_base__io_buffer dst = pdeflate__make_io_buffer(
+      c->dst[0] + HISTORY_LEN - h, h + c->dst_cap, h, false);
+  dst.meta.ri = h;
+  wuffs_base__io_buffer src =
+      pdeflate__make_io_buffer(c->shifted, in_cap + 16, 0, false);
+
+  // next is the bit offset, into in_buf, of the next bit to shift into src.
+  // Each src byte holds 8 in_buf bits, except that at EOF, src's final byte
+  // can be partial. next still advances by 8 bits for that byte (past the end
+  // of in_buf) so that (next - 8 * unread_src_bytes) is always exact.
+  uint64_t next = begin;
+  while (true) {
+    // Shift in_buf's whole bytes (or, at EOF, all of its bits) into src.
+    uint64_t hi = wuffs_base__u64__min(
+        8 * (uint64_t)(in_len),
+        next + (8 * (uint64_t)(src.data.len - src.meta.wi)));
+    if (!in_closed) {
+      hi -= (hi - next) % 8;
+    }
+    if (hi > next) {
+      size_t n =
+          pdeflate__shift_bits(src.data.ptr + src.meta.wi, in_buf, next, hi);
+      src.meta.wi += n;
+      next += 8 * (uint64_t)(n);
+    }
+    src.meta.closed = in_closed && (next >= (8 * (uint64_t)(in_len)));
+
+    wuffs_base__status status =
+        wuffs_deflate__decoder__transform_io(dec, &dst, &src, workbuf);
+
+    size_t n = dst.meta.wi - dst.meta.ri;
+    const char* z = emit(dst.data.ptr + dst.meta.ri, n,
+                         pdeflate__crc32(dst.data.ptr + dst.meta.ri, n));
+    if (z) {
+      return z;
+    }
+    h = wuffs_base__u64__min(dst.meta.wi, HISTORY_LEN);
+    memmove(c->dst[0] + HISTORY_LEN - h, dst.data.ptr + dst.meta.wi - h, h);
+    dst.data.ptr = c->dst[0] + HISTORY_LEN - h;
+    dst.data.len = h + c->dst_cap;
+    dst.meta.wi = h;
+    dst.meta.ri = h;
+
+    if (status.repr == NULL) {
+      return check_trailer(next - (8 * (src.meta.wi - src.meta.ri)));
+    } else if (status.repr == wuffs_base__suspension__short_write) {
+      continue;
+    } else if (status.repr != wuffs_base__suspension__short_read) {
+      return wuffs_base__status__message(&status);
+    } else if (src.meta.closed) {
+      return wuffs_base__error__not_enough_data;
+    }
+    wuffs_base__io_buffer__compact(&src);
+    discard_in((size_t)(next / 8));
+    next %= 8;
+    z = read_in();
+    if (z) {
+      return z;
+    }
+  }
+}
+
+// decode_member decodes one gzip member's DEFLATE stream, from in_buf's bit
+// offset begin, and then checks and discards its trailer.
+static const char*  //
+decode_member(uint64_t begin) {
+  po.history_len = 0;
+  po.crc = 0;
+  po.len = 0;
+
+  const char* z = NULL;
+  uint64_t found[PARALLEL_MAX_J];
+  while (!z) {
+    discard_in((size_t)(begin / 8));
+    begin %= 8;
+    z = read_in();
+    if (z) {
+      break;
+    }
+    // Find the block boundaries near the chunks' nominal starts. Unless at
+    // EOF, leave enough input after each candidate for a trial decoding.
+    uint64_t scan_end = 8 * (uint64_t)(in_len);
+    if (!in_closed) {
+      scan_end -= 8 * PDEFLATE__TRIAL_SRC_LEN;
+    }
+    uint32_t w;
+    for (w = 0; w < flags.j; w++) {
+      parallel_finds[w].lo = 8 * (uint64_t)(w + 1) * PARALLEL_CHUNK_SRC_LEN;
+      parallel_finds[w].hi = scan_end;
+      if ((z = parallel_call(w, 'f'))) {
+        return z;
+      }
+    }
+    for (w = 0; w < flags.j; w++) {
+      if ((z = parallel_wait(w))) {
+        return z;
+      }
+      found[w] = parallel_finds[w].found;
+    }
+
+    // Decode the chunks between those boundaries, plus the stream's tail
+    // chunk (with no end boundary) if all of the input has been read.
+    uint32_t n =
+        pdeflate__split(parallel_chunks, begin, found, flags.j, in_closed);
+    if (n == 0) {
+      return decode_sequentially(begin);
+    }
+    pdeflate__chunk__set_history(&parallel_chunks[0], po.history,
+                                 po.history_len);
+    for (w = 0; w < n; w++) {
+      if ((z = parallel_call(w, 'd'))) {
+        return z;
+      }
+    }
+    for (w = 0; w < n; w++) {
+      if ((z = parallel_wait(w))) {
+        return z;
+      }
+    }
+
+    // Resolve the chunks and write them out, in order.
+    for (w = 0; w < n; w++) {
+      pdeflate__chunk* c = &parallel_chunks[w];
+      if (!c->ok) {
+        return decode_sequentially(c->begin);
+      } else if ((z = pdeflate__chunk__resolve(c, po.history,
+                                               po.history_len))) {
+        return z;
+      } else if ((z = emit(c->dst[0] + HISTORY_LEN, c->dst_len,
+                           pdeflate__chunk__crc32(c)))) {
+        return z;
+      } else if (c->final) {
+        return check_trailer(c->begin + (8 * (uint64_t)(c->src_len)));
+      }
+    }
+    begin = parallel_chunks[n - 1].end;
+  }
+  return z;
+}
+
+// parallel_main1 decodes every member of a multi-member gzip file, like the
+// non-parallel code path (and like "gzip -dc").
+static const char*  //
+parallel_main1() {
+  const char* z = read_in();
+  while (!z) {
+    uint64_t begin = 0;
+    if ((z = parse_gzip_header(&begin)) || (z = decode_member(begin)) ||
+        (z = read_in()) || (in_len == 0)) {
+      break;
+    }
+  }
+  return z;
+}
+
+#endif  // defined(WUFFS_EXAMPLE_USE_PARALLEL)
+
+// ----
+
+// ignore_return_value suppresses errors from -Wall -Werror.
+static void  //
+ignore_return_value(int ignored) {}
+
+// print_stat writes one line of the -stats flag's output to stderr.
+static void  //
+print_stat(const char* label, uint64_t value) {
+  char buf[128];
+  int n = snprintf(buf, sizeof buf, "%-28s %12" PRIu64 "\n", label, value);
+  if ((n > 0) && (n < (int)(sizeof buf))) {
+    const int stderr_fd = 2;
+    ignore_return_value(write(stderr_fd, buf, n));
+  }
+}
+
+// print_stats implements the -stats flag. Zero counts in the match length and
+// distance histograms are not printed.
+static void  //
+print_stats(wuffs_gzip__decoder* dec) {
+  static const char* names[] = {
+      "stored blocks", "fixed blocks", "dynamic blocks", "stored bytes",
+      "fast bytes",    "slow bytes",   "literals",       "matches",
+      "match bytes",   "huffman table inits", "tail bytes",
+  };
+  char label[64];
+  uint32_t k;
+  for (k = 0; k < (sizeof names / sizeof names[0]); k++) {
+    print_stat(names[k], wuffs_gzip__decoder__stats(dec, k));
+  }
+  for (k = 0; k < 256; k++) {
+    uint64_t c = wuffs_gzip__decoder__stats(
+        dec, WUFFS_DEFLATE__STATS_KEY_MATCH_LENGTHS + k);
+    if (c) {
+      snprintf(label, sizeof label, "match length %" PRIu32, k + 3);
+      print_stat(label, c);
+    }
+  }
+  for (k = 0; k < 14; k++) {
+    uint64_t c = wuffs_gzip__decoder__stats(
+        dec, WUFFS_DEFLATE__STATS_KEY_MATCH_DISTANCES + k);
+    if (c) {
+      uint32_t lo = k ? ((1u << (k + 1)) + 1) : 1;
+      uint32_t hi = 1u << (k + 2);
+      snprintf(label, sizeof label, "match distance %" PRIu32 "..%" PRIu32,
+               lo, hi);
+      print_stat(label, c);
+    }
+  }
+}
+
+const char*  //
+main1() {
   if (flags.fail_if_unsandboxed && !sandboxed) {
     return "main: unsandboxed";
   }
+  if ((flags.j > 1) && flags.stats) {
+    return "main: the -stats flag cannot be combined with -j=N (for N > 1)";
+  } else if (flags.j > 1) {
+#if defined(WUFFS_EXAMPLE_USE_PARALLEL)
+    // parallel_main1 can return Wuffs status strings, which start with "#".
+    wuffs_base__status z = wuffs_base__make_status(parallel_main1());
+    return wuffs_base__status__message(&z);
+#else
+    return "main: the -j=N flag (for N > 1) is unsupported on this platform";
+#endif
+  }
 
   wuffs_gzip__decoder dec;
   wuffs_base__status status =
@@ -149,10 +832,19 @@ main1(int argc, char** argv) {
   if (!wuffs_base__status__is_ok(&status)) {
     return wuffs_base__status__message(&status);
   }
+  // Like "gzip -dc", decode every member of a multi-member gzip file.
+  wuffs_gzip__decoder__set_decode_concatenated_members(&dec, true);
+  if (flags.stats) {
+    wuffs_gzip__decoder__set_collect_stats(&dec, true);
+  }
 
   wuffs_base__io_buffer dst;
   dst.data.ptr = dst_buffer_array;
   dst.data.len = DST_BUFFER_ARRAY_SIZE;
+  if (ring_buffer_base) {
+    dst.data.ptr = ring_buffer_base + DST_BUFFER_ARRAY_SIZE;
+    wuffs_gzip__decoder__set_whole_output_in_dst(&dec, true);
+  }
   dst.meta.wi = 0;
   dst.meta.ri = 0;
   dst.meta.pos = 0;
@@ -186,20 +878,32 @@ main1(int argc, char** argv) {
           &dec, &dst, &src,
           wuffs_base__make_slice_u8(work_buffer_array, WORK_BUFFER_ARRAY_SIZE));
 
-      if (dst.meta.wi) {
+      if (dst.meta.wi > dst.meta.ri) {
         // TODO: handle EINTR and other write errors; see "man 2 write".
         const int stdout_fd = 1;
-        ignore_return_value(write(stdout_fd, dst_buffer_array, dst.meta.wi));
+        ignore_return_value(write(stdout_fd, dst.data.ptr + dst.meta.ri,
+                                  dst.meta.wi - dst.meta.ri));
         dst.meta.ri = dst.meta.wi;
-        wuffs_base__io_buffer__compact(&dst);
+        if (ring_buffer_base) {
+          rebase_ring_buffer(&dst);
+        } else {
+          wuffs_base__io_buffer__compact(&dst);
+        }
       }
 
       if (status.repr == wuffs_base__suspension__short_read) {
+        if (src.meta.closed) {
+          status = wuffs_base__make_status(wuffs_base__error__not_enough_data);
+          return wuffs_base__status__message(&status);
+        }
         break;
       }
       if (status.repr == wuffs_base__suspension__short_write) {
         continue;
       }
+      if (flags.stats) {
+        print_stats(&dec);
+      }
       return wuffs_base__status__message(&status);
     }
 
@@ -239,12 +943,28 @@ compute_exit_code(const char* status_msg) {
 
 int  //
 main(int argc, char** argv) {
+  const char* z = parse_flags(argc, argv);
+
+#if defined(WUFFS_EXAMPLE_USE_MMAP_RING_BUFFER)
+  ring_buffer_base = make_ring_buffer(DST_BUFFER_ARRAY_SIZE);
+#endif
+
+#if defined(WUFFS_EXAMPLE_USE_PARALLEL)
+  if (!z && (flags.j > 1)) {
+    z = start_parallel_workers();
+  }
+#endif
+
 #if defined(WUFFS_EXAMPLE_USE_SECCOMP)
   prctl(PR_SET_SECCOMP, SECCOMP_MODE_STRICT);
   sandboxed = true;
 #endif
 
-  int exit_code = compute_exit_code(main1(argc, argv));
+  int exit_code = compute_exit_code(z ? z : main1());
+
+#if defined(WUFFS_EXAMPLE_USE_PARALLEL)
+  stop_parallel_workers();
+#endif
 
 #if defined(WUFFS_EXAMPLE_USE_SECCOMP)
   // Call SYS_exit explicitly, instead of calling SYS_exit_group implicitly by
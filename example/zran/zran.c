@@ -0,0 +1,618 @@
+// Copyright 2020 The Wuffs Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// ----------------
+
+/*
+zran builds and uses a random access index into gzip'ed or zlib'ed data, so
+that decoding from the middle of a large file doesn't have to start from the
+beginning. It is similar to zlib's examples/zran.c program.
+
+Building the index decodes the whole file once, recording a checkpoint at a
+DEFLATE block boundary every -span=N MiB (default 1) of decoded output. Each
+checkpoint holds a compressed position (in bits, as blocks need not start on
+a byte boundary), an uncompressed position and the 32 KiB of history (decoded
+output) before it. To extract part of the decoded file, a new DEFLATE decoder
+resumes from the closest earlier checkpoint, primed with that history. To run:
+
+$CC zran.c -o zran
+./zran -build -span=4 foo.gz foo.gz.zri
+./zran -offset=123456789 -length=100 foo.gz foo.gz.zri
+rm -f zran
+
+for a C compiler $CC, such as clang or gcc.
+
+The index file format is an 8 byte magic identifier, "WuffsZRI", followed by
+zero or more checkpoints. Each checkpoint is, with numbers in little-endian:
+  - 8 bytes: the compressed position, in bits.
+  - 8 bytes: the uncompressed position, in bytes.
+  - 4 bytes: the history length, n, in bytes. It is at most 32768.
+  - n bytes: the history.
+
+Histories are stored as is (uncompressed), so that the index is roughly 32
+KiB per checkpoint. Only the first member of a multi-member gzip file is
+indexed.
+*/
+
+#include <errno.h>
+#include <limits.h>
+#include <stdio.h>
+
+// Wuffs ships as a "single file C library" or "header file library" as per
+// https://github.com/nothings/stb/blob/master/docs/stb_howto.txt
+//
+// To use that single file as a "foo.c"-like implementation, instead of a
+// "foo.h"-like header, #define WUFFS_IMPLEMENTATION before #include'ing or
+// compiling it.
+#define WUFFS_IMPLEMENTATION
+
+// Defining the WUFFS_CONFIG__MODULE* macros are optional, but it lets users of
+// release/c/etc.c whitelist which parts of Wuffs to build. That file contains
+// the entire Wuffs standard library, implementing a variety of codecs and file
+// formats. Without this macro definition, an optimizing compiler or linker may
+// very well discard Wuffs code for unused codecs, but listing the Wuffs
+// modules we use makes that process explicit. Preprocessing means that such
+// code simply isn't compiled.
+#define WUFFS_CONFIG__MODULES
+#define WUFFS_CONFIG__MODULE__ADLER32
+#define WUFFS_CONFIG__MODULE__BASE
+#define WUFFS_CONFIG__MODULE__CRC32
+#define WUFFS_CONFIG__MODULE__DEFLATE
+#define WUFFS_CONFIG__MODULE__GZIP
+#define WUFFS_CONFIG__MODULE__ZLIB
+
+// If building this program in an environment that doesn't easily accommodate
+// relative includes, you can use the script/inline-c-relative-includes.go
+// program to generate a stand-alone C file.
+#include "../../release/c/wuffs-unsupported-snapshot.c"
+
+#ifndef DST_BUFFER_ARRAY_SIZE
+#define DST_BUFFER_ARRAY_SIZE (128 * 1024)
+#endif
+
+#ifndef SRC_BUFFER_ARRAY_SIZE
+#define SRC_BUFFER_ARRAY_SIZE (128 * 1024)
+#endif
+
+#define WORK_BUFFER_ARRAY_SIZE \
+  WUFFS_DEFLATE__DECODER_WORKBUF_LEN_MAX_INCL_WORST_CASE
+
+// HISTORY_LEN is the maximum distance in a DEFLATE length-distance
+// back-reference.
+#define HISTORY_LEN (32 * 1024)
+
+// MAGIC_LEN is the length of the index file's "WuffsZRI" magic identifier.
+#define MAGIC_LEN 8
+
+// CHECKPOINT_HEADER_LEN is the length of a checkpoint, excluding its history.
+#define CHECKPOINT_HEADER_LEN 20
+
+// When building the index, dst_buffer_array's first HISTORY_LEN bytes hold
+// the most recent output (see wuffs_deflate__decoder__set_whole_output_in_dst)
+// so that a checkpoint's history is always available in dst.
+uint8_t dst_buffer_array[HISTORY_LEN + DST_BUFFER_ARRAY_SIZE];
+uint8_t src_buffer_array[SRC_BUFFER_ARRAY_SIZE];
+uint8_t work_buffer_array[WORK_BUFFER_ARRAY_SIZE];
+uint8_t history_array[HISTORY_LEN];
+
+wuffs_deflate__decoder dec;
+
+struct {
+  int remaining_argc;
+  char** remaining_argv;
+
+  bool build;
+  uint64_t length;
+  uint64_t offset;
+  uint64_t span;
+} flags = {0};
+
+static const char*  //
+parse_u64_flag_value(const char* arg, uint64_t* value) {
+  while (*arg++ != '=') {
+  }
+  wuffs_base__result_u64 u = wuffs_base__parse_number_u64(
+      wuffs_base__make_slice_u8((uint8_t*)arg, strlen(arg)));
+  if (!wuffs_base__status__is_ok(&u.status)) {
+    return u.status.repr;
+  }
+  *value = u.value;
+  return NULL;
+}
+
+const char*  //
+parse_flags(int argc, char** argv) {
+  flags.length = UINT64_MAX;
+  flags.span = 1;
+
+  int c = (argc > 0) ? 1 : 0;  // Skip argv[0], the program name.
+  for (; c < argc; c++) {
+    char* arg = argv[c];
+    if (*arg++ != '-') {
+      break;
+    }
+
+    // A double-dash "--foo" is equivalent to a single-dash "-foo". As special
+    // cases, a bare "-" is not a flag (some programs may interpret it as
+    // stdin) and a bare "--" means to stop parsing flags.
+    if (*arg == '\x00') {
+      break;
+    } else if (*arg == '-') {
+      arg++;
+      if (*arg == '\x00') {
+        c++;
+        break;
+      }
+    }
+
+    if (!strcmp(arg, "build")) {
+      flags.build = true;
+      continue;
+    }
+    if (!strncmp(arg, "length=", 7)) {
+      if (parse_u64_flag_value(arg, &flags.length)) {
+        return "main: bad -length=N flag value";
+      }
+      continue;
+    }
+    if (!strncmp(arg, "offset=", 7)) {
+      if (parse_u64_flag_value(arg, &flags.offset)) {
+        return "main: bad -offset=N flag value";
+      }
+      continue;
+    }
+    if (!strncmp(arg, "span=", 5)) {
+      if (parse_u64_flag_value(arg, &flags.span) || (flags.span == 0) ||
+          (flags.span > 0xFFFFFFFF)) {
+        return "main: bad -span=N flag value";
+      }
+      continue;
+    }
+
+    return "main: unrecognized flag argument";
+  }
+
+  flags.remaining_argc = argc - c;
+  flags.remaining_argv = argv + c;
+  return NULL;
+}
+
+// ----
+
+// read_src compacts src and then reads more of the compressed file into it.
+static const char*  //
+read_src(FILE* f, wuffs_base__io_buffer* src) {
+  if (src->meta.closed) {
+    return "main: internal error: read requested on a closed source";
+  }
+  wuffs_base__io_buffer__compact(src);
+  if (src->meta.wi >= src->data.len) {
+    return "main: src buffer is full";
+  }
+  src->meta.wi += fread(src->data.ptr + src->meta.wi, sizeof(uint8_t),
+                        src->data.len - src->meta.wi, f);
+  if (feof(f)) {
+    src->meta.closed = true;
+  } else if (ferror(f)) {
+    return "main: error reading file";
+  }
+  return NULL;
+}
+
+// parse_header parses the gzip or zlib header at the start of src, setting
+// *is_gzip and advancing src past that header.
+static const char*  //
+parse_header(wuffs_base__io_buffer* src, bool* is_gzip) {
+  uint8_t* p = src->data.ptr + src->meta.ri;
+  size_t n = src->meta.wi - src->meta.ri;
+  if (n < 2) {
+    return wuffs_base__error__not_enough_data;
+  }
+
+  // zlib: a compression method of 8 (DEFLATE), a 32 KiB (or smaller) window,
+  // no preset dictionary and a valid parity check.
+  if ((p[0] != 0x1F) || (p[1] != 0x8B)) {
+    *is_gzip = false;
+    if (((p[0] & 0x0F) != 0x08) || ((p[0] >> 4) > 7)) {
+      return wuffs_zlib__error__bad_compression_method;
+    } else if (p[1] & 0x20) {
+      return "main: unsupported zlib preset dictionary";
+    } else if (((256 * (uint32_t)(p[0])) + p[1]) % 31) {
+      return wuffs_zlib__error__bad_parity_check;
+    }
+    src->meta.ri += 2;
+    return NULL;
+  }
+
+  *is_gzip = true;
+  if (n < 10) {
+    return wuffs_base__error__not_enough_data;
+  } else if (p[2] != 0x08) {
+    return wuffs_gzip__error__bad_compression_method;
+  } else if (p[3] & 0xE0) {
+    return wuffs_gzip__error__bad_encoding_flags;
+  }
+  uint8_t gz_flags = p[3];
+  size_t i = 10;
+  // FEXTRA.
+  if (gz_flags & 0x04) {
+    if ((i + 2) > n) {
+      return wuffs_base__error__not_enough_data;
+    }
+    i += 2 + wuffs_base__load_u16le__no_bounds_check(p + i);
+  }
+  // FNAME and FCOMMENT.
+  uint8_t bit;
+  for (bit = 0x08; bit <= 0x10; bit <<= 1) {
+    if (gz_flags & bit) {
+      for (; (i < n) && p[i]; i++) {
+      }
+      i++;
+    }
+  }
+  // FHCRC.
+  if (gz_flags & 0x02) {
+    i += 2;
+  }
+  if (i > n) {
+    return wuffs_base__error__not_enough_data;
+  }
+  src->meta.ri += i;
+  return NULL;
+}
+
+static const char*  //
+write_checkpoint(FILE* f,
+                 uint64_t bit_position,
+                 uint64_t dst_position,
+                 wuffs_base__slice_u8 history) {
+  uint8_t buf[CHECKPOINT_HEADER_LEN];
+  wuffs_base__store_u64le__no_bounds_check(buf + 0, bit_position);
+  wuffs_base__store_u64le__no_bounds_check(buf + 8, dst_position);
+  wuffs_base__store_u32le__no_bounds_check(buf + 16, (uint32_t)(history.len));
+  if ((fwrite(buf, sizeof(uint8_t), CHECKPOINT_HEADER_LEN, f) !=
+       CHECKPOINT_HEADER_LEN) ||
+      (fwrite(history.ptr, sizeof(uint8_t), history.len, f) != history.len)) {
+    return "main: error writing index";
+  }
+  return NULL;
+}
+
+static const char*  //
+start_decoder() {
+  wuffs_base__status status =
+      wuffs_deflate__decoder__initialize(&dec, sizeof dec, WUFFS_VERSION, 0);
+  if (!wuffs_base__status__is_ok(&status)) {
+    return wuffs_base__status__message(&status);
+  }
+  return NULL;
+}
+
+// ---- Building the index
+
+static const char*  //
+build(FILE* in, FILE* out) {
+  wuffs_base__io_buffer src = wuffs_base__make_io_buffer(
+      wuffs_base__make_slice_u8(src_buffer_array, SRC_BUFFER_ARRAY_SIZE),
+      wuffs_base__empty_io_buffer_meta());
+  wuffs_base__io_buffer dst = wuffs_base__make_io_buffer(
+      wuffs_base__make_slice_u8(dst_buffer_array,
+                                HISTORY_LEN + DST_BUFFER_ARRAY_SIZE),
+      wuffs_base__empty_io_buffer_meta());
+
+  const char* z = read_src(in, &src);
+  if (z) {
+    return z;
+  }
+  bool is_gzip = false;
+  z = parse_header(&src, &is_gzip);
+  if (z) {
+    return z;
+  }
+
+  if (fwrite("WuffsZRI", sizeof(uint8_t), MAGIC_LEN, out) != MAGIC_LEN) {
+    return "main: error writing index";
+  }
+  // The first checkpoint is at the start of the DEFLATE stream.
+  z = write_checkpoint(out, 8 * wuffs_base__io_buffer__reader_io_position(&src),
+                       0, wuffs_base__make_slice_u8(NULL, 0));
+  if (z) {
+    return z;
+  }
+
+  z = start_decoder();
+  if (z) {
+    return z;
+  }
+  wuffs_deflate__decoder__set_whole_output_in_dst(&dec, true);
+  wuffs_deflate__decoder__set_report_block_boundaries(&dec, true);
+
+  // Verify the checksum while we're here.
+  wuffs_crc32__ieee_hasher crc32;
+  wuffs_adler32__hasher adler32;
+  wuffs_base__status status = is_gzip
+                                  ? wuffs_crc32__ieee_hasher__initialize(
+                                        &crc32, sizeof crc32, WUFFS_VERSION, 0)
+                                  : wuffs_adler32__hasher__initialize(
+                                        &adler32, sizeof adler32, WUFFS_VERSION,
+                                        0);
+  if (!wuffs_base__status__is_ok(&status)) {
+    return wuffs_base__status__message(&status);
+  }
+  uint32_t checksum_got = 0;
+
+  const uint64_t span = flags.span * 1024 * 1024;
+  uint64_t prev_dst_position = 0;
+  while (true) {
+    status = wuffs_deflate__decoder__transform_io(
+        &dec, &dst,
+        &src, wuffs_base__make_slice_u8(work_buffer_array,
+                                        WORK_BUFFER_ARRAY_SIZE));
+
+    wuffs_base__slice_u8 output = wuffs_base__make_slice_u8(
+        dst.data.ptr + dst.meta.ri, dst.meta.wi - dst.meta.ri);
+    checksum_got =
+        is_gzip ? wuffs_crc32__ieee_hasher__update_u32(&crc32, output)
+                : wuffs_adler32__hasher__update_u32(&adler32, output);
+    dst.meta.ri = dst.meta.wi;
+
+    if (status.repr == wuffs_deflate__note__block_boundary) {
+      uint64_t dst_position = wuffs_base__io_buffer__writer_io_position(&dst);
+      if ((dst_position - prev_dst_position) >= span) {
+        size_t h = (dst.meta.wi < HISTORY_LEN) ? dst.meta.wi : HISTORY_LEN;
+        z = write_checkpoint(
+            out, wuffs_deflate__decoder__block_boundary_bit_position(&dec),
+            dst_position,
+            wuffs_base__make_slice_u8(dst.data.ptr + dst.meta.wi - h, h));
+        if (z) {
+          return z;
+        }
+        prev_dst_position = dst_position;
+      }
+      continue;
+
+    } else if (status.repr == wuffs_base__suspension__short_write) {
+      // Keep up to HISTORY_LEN bytes of history, as per the
+      // set_whole_output_in_dst promise.
+      dst.meta.ri = dst.meta.wi - HISTORY_LEN;
+      wuffs_base__io_buffer__compact(&dst);
+      dst.meta.ri = dst.meta.wi;
+      continue;
+
+    } else if (status.repr == wuffs_base__suspension__short_read) {
+      if (src.meta.closed) {
+        return "main: truncated input";
+      }
+      z = read_src(in, &src);
+      if (z) {
+        return z;
+      }
+      continue;
+
+    } else if (!wuffs_base__status__is_ok(&status)) {
+      return wuffs_base__status__message(&status);
+    }
+    break;
+  }
+
+  // Check the gzip or zlib trailer.
+  const size_t trailer_len = is_gzip ? 8 : 4;
+  if ((src.meta.wi - src.meta.ri) < trailer_len) {
+    z = src.meta.closed ? "main: truncated input" : read_src(in, &src);
+    if (z) {
+      return z;
+    } else if ((src.meta.wi - src.meta.ri) < trailer_len) {
+      return "main: truncated input";
+    }
+  }
+  uint8_t* p = src.data.ptr + src.meta.ri;
+  if (is_gzip) {
+    if (checksum_got != wuffs_base__load_u32le__no_bounds_check(p + 0)) {
+      return wuffs_gzip__error__bad_checksum;
+    } else if ((uint32_t)(wuffs_base__io_buffer__writer_io_position(&dst)) !=
+               wuffs_base__load_u32le__no_bounds_check(p + 4)) {
+      return wuffs_gzip__error__bad_checksum;
+    }
+  } else if (checksum_got != wuffs_base__load_u32be__no_bounds_check(p)) {
+    return wuffs_zlib__error__bad_checksum;
+  }
+
+  if (fflush(out)) {
+    return "main: error writing index";
+  }
+  return NULL;
+}
+
+// ---- Using the index
+
+// find_checkpoint finds the last checkpoint in the index whose uncompressed
+// position is at or before flags.offset, and loads its history into
+// history_array.
+static const char*  //
+find_checkpoint(FILE* index,
+                uint64_t* bit_position,
+                uint64_t* dst_position,
+                size_t* history_len) {
+  uint8_t buf[CHECKPOINT_HEADER_LEN];
+  if ((fread(buf, sizeof(uint8_t), MAGIC_LEN, index) != MAGIC_LEN) ||
+      memcmp(buf, "WuffsZRI", MAGIC_LEN)) {
+    return "main: bad index";
+  }
+
+  bool found = false;
+  long history_offset = 0;
+  while (fread(buf, sizeof(uint8_t), CHECKPOINT_HEADER_LEN, index) ==
+         CHECKPOINT_HEADER_LEN) {
+    uint64_t b = wuffs_base__load_u64le__no_bounds_check(buf + 0);
+    uint64_t d = wuffs_base__load_u64le__no_bounds_check(buf + 8);
+    uint32_t h = wuffs_base__load_u32le__no_bounds_check(buf + 16);
+    if ((h > HISTORY_LEN) || (h > d)) {
+      return "main: bad index";
+    } else if (d > flags.offset) {
+      break;
+    }
+    found = true;
+    *bit_position = b;
+    *dst_position = d;
+    *history_len = h;
+    history_offset = ftell(index);
+    if (fseek(index, h, SEEK_CUR)) {
+      return "main: bad index";
+    }
+  }
+  if (ferror(index)) {
+    return "main: error reading index";
+  } else if (!found) {
+    return "main: bad index";
+  }
+
+  if (fseek(index, history_offset, SEEK_SET) ||
+      (fread(history_array, sizeof(uint8_t), *history_len, index) !=
+       *history_len)) {
+    return "main: bad index";
+  }
+  return NULL;
+}
+
+static const char*  //
+extract(FILE* in, FILE* index) {
+  uint64_t bit_position = 0;
+  uint64_t dst_position = 0;
+  size_t history_len = 0;
+  const char* z =
+      find_checkpoint(index, &bit_position, &dst_position, &history_len);
+  if (z) {
+    return z;
+  }
+
+  if ((bit_position > (((uint64_t)LONG_MAX) * 8)) ||
+      fseek(in, (long)(bit_position / 8), SEEK_SET)) {
+    return "main: could not seek to the checkpoint";
+  }
+  wuffs_base__io_buffer src = wuffs_base__make_io_buffer(
+      wuffs_base__make_slice_u8(src_buffer_array, SRC_BUFFER_ARRAY_SIZE),
+      wuffs_base__make_io_buffer_meta(0, 0, bit_position / 8, false));
+  wuffs_base__io_buffer dst = wuffs_base__make_io_buffer(
+      wuffs_base__make_slice_u8(dst_buffer_array, DST_BUFFER_ARRAY_SIZE),
+      wuffs_base__make_io_buffer_meta(0, 0, dst_position, false));
+  wuffs_base__slice_u8 work_slice =
+      wuffs_base__make_slice_u8(work_buffer_array, WORK_BUFFER_ARRAY_SIZE);
+
+  z = start_decoder();
+  if (z) {
+    return z;
+  }
+  wuffs_base__status hist_status = wuffs_deflate__decoder__add_history(
+      &dec, wuffs_base__make_slice_u8(history_array, history_len), work_slice);
+  if (!wuffs_base__status__is_ok(&hist_status)) {
+    return wuffs_base__status__message(&hist_status);
+  }
+  wuffs_deflate__decoder__set_initial_bit_offset(&dec,
+                                                 (uint32_t)(bit_position & 7));
+
+  uint64_t remaining = flags.length;
+  while (remaining > 0) {
+    wuffs_base__status status =
+        wuffs_deflate__decoder__transform_io(&dec, &dst, &src, work_slice);
+
+    // Write the part of dst that is at or after flags.offset.
+    uint64_t p = dst.meta.pos;
+    size_t i = (p < flags.offset)
+                   ? ((flags.offset - p) < dst.meta.wi ? (flags.offset - p)
+                                                       : dst.meta.wi)
+                   : 0;
+    size_t n = dst.meta.wi - i;
+    if (n > remaining) {
+      n = remaining;
+    }
+    if (n > 0) {
+      if (fwrite(dst.data.ptr + i, sizeof(uint8_t), n, stdout) != n) {
+        return "main: error writing output";
+      }
+      remaining -= n;
+    }
+    dst.meta.ri = dst.meta.wi;
+    wuffs_base__io_buffer__compact(&dst);
+
+    if (status.repr == wuffs_base__suspension__short_write) {
+      continue;
+    } else if (status.repr == wuffs_base__suspension__short_read) {
+      if (src.meta.closed) {
+        return "main: truncated input";
+      }
+      z = read_src(in, &src);
+      if (z) {
+        return z;
+      }
+      continue;
+    } else if (!wuffs_base__status__is_ok(&status)) {
+      return wuffs_base__status__message(&status);
+    }
+    break;
+  }
+  return NULL;
+}
+
+// ----
+
+const char*  //
+main1(int argc, char** argv) {
+  const char* z = parse_flags(argc, argv);
+  if (z) {
+    return z;
+  } else if (flags.remaining_argc != 2) {
+    return "main: usage: zran [flags] data.gz index.zri";
+  }
+
+  FILE* in = fopen(flags.remaining_argv[0], "rb");
+  if (!in) {
+    return strerror(errno);
+  }
+  FILE* index = fopen(flags.remaining_argv[1], flags.build ? "wb" : "rb");
+  if (!index) {
+    fclose(in);
+    return strerror(errno);
+  }
+  z = flags.build ? build(in, index) : extract(in, index);
+  fclose(index);
+  fclose(in);
+  // Strip any leading '#' from Wuffs' error messages.
+  wuffs_base__status status = wuffs_base__make_status(z);
+  return wuffs_base__status__message(&status);
+}
+
+int  //
+compute_exit_code(const char* status_msg) {
+  if (!status_msg) {
+    return 0;
+  }
+  fprintf(stderr, "%s\n", status_msg);
+  // Return an exit code of 1 for regular (forseen) errors, e.g. badly
+  // formatted or unsupported input.
+  //
+  // Return an exit code of 2 for internal (exceptional) errors, e.g. defensive
+  // run-time checks found that an internal invariant did not hold.
+  //
+  // Automated testing, including badly formatted inputs, can therefore
+  // discriminate between expected failure (exit code 1) and unexpected failure
+  // (other non-zero exit codes). Specifically, exit code 2 for internal
+  // invariant violation, exit code 139 (which is 128 + SIGSEGV on x86_64
+  // linux) for a segmentation fault (e.g. null pointer dereference).
+  return strstr(status_msg, "internal error:") ? 2 : 1;
+}
+
+int  //
+main(int argc, char** argv) {
+  return compute_exit_code(main1(argc, argv));
+}
@@ -57,6 +57,15 @@ extern "C" {
 // WUFFS C HEADER ENDS HERE.
 #ifdef WUFFS_IMPLEMENTATION
 
+// WUFFS_BASE__CPU_ARCH__ETC are defined when the compiler can emit the
+// instructions for a CPU architecture-specific code path. Whether the CPU that
+// runs the code supports those instructions is checked at run time.
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define WUFFS_BASE__CPU_ARCH__X86_64
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+
 // GCC does not warn for unused *static inline* functions, but clang does.
 #ifdef __clang__
 #pragma clang diagnostic push
@@ -73,6 +73,67 @@ wuffs_base__ignore_status(wuffs_base__status z) {
 #define WUFFS_BASE__UNLIKELY(expr) (expr)
 #endif
 
+// ---------------- CPU Architecture
+
+// WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET enables the compiler to emit instructions
+// (e.g. SIMD) for a single function, without requiring the whole translation
+// unit to be compiled with e.g. "-msse4.2".
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+#define WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET(arg) __attribute__((target(arg)))
+#else
+#define WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET(arg)
+#endif
+
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+
+// wuffs_base__private_implementation__cpu_arch__x86_sse42 caches the result
+// of wuffs_base__cpu_arch__have_x86_sse42: 0 means unknown, 1 means false and
+// 2 means true.
+static int wuffs_base__private_implementation__cpu_arch__x86_sse42 = 0;
+
+// wuffs_base__cpu_arch__have_x86_sse42 returns whether the CPU supports the
+// instructions of a Wuffs "choose cpu_arch >= x86_sse42" function: PCLMUL,
+// POPCNT, SSE4.2 and the SSE4.2 prerequisites SSE4.1 and SSSE3.
+//
+// The CPUID instruction can be slow (e.g. inside a virtual machine, it traps to
+// the hypervisor), so its result is cached. Concurrent callers all compute and
+// store the same value, and the cache is accessed with relaxed atomics so that
+// doing so is not a data race.
+static inline bool  //
+wuffs_base__cpu_arch__have_x86_sse42() {
+  int* cached = &wuffs_base__private_implementation__cpu_arch__x86_sse42;
+  int value = __atomic_load_n(cached, __ATOMIC_RELAXED);
+  if (value == 0) {
+    unsigned int eax1 = 0;
+    unsigned int ebx1 = 0;
+    unsigned int ecx1 = 0;
+    unsigned int edx1 = 0;
+    const unsigned int sse42_ecx1_bits =
+        bit_PCLMUL | bit_POPCNT | bit_SSE4_1 | bit_SSE4_2 | bit_SSSE3;
+    value = (__get_cpuid(1, &eax1, &ebx1, &ecx1, &edx1) &&
+             ((ecx1 & sse42_ecx1_bits) == sse42_ecx1_bits))
+                ? 2
+                : 1;
+    __atomic_store_n(cached, value, __ATOMIC_RELAXED);
+  }
+  return value == 2;
+}
+
+// wuffs_base__cpu_arch__override_x86_sse42 makes later
+// wuffs_base__cpu_arch__have_x86_sse42 calls return have, without checking
+// the CPU. It only affects receivers that have not yet chosen between their
+// portable and x86_sse42 implementations, such as newly initialized hashers.
+//
+// It is intended for tests and benchmarks of the portable implementations,
+// and is not thread-safe.
+static inline void  //
+wuffs_base__cpu_arch__override_x86_sse42(bool have) {
+  __atomic_store_n(&wuffs_base__private_implementation__cpu_arch__x86_sse42,
+                   have ? 2 : 1, __ATOMIC_RELAXED);
+}
+
+#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_64)
+
 // ---------------- Numeric Types
 
 extern const uint8_t wuffs_base__low_bits_mask__u8[9];
@@ -59,10 +59,8 @@ wuffs_base__io_writer__copy_n32_from_history(uint8_t** ptr_iop_w,
   // argument, and the cgen can look if that argument is the constant
   // expression '3'.
   //
-  // See also wuffs_base__io_writer__copy_n32_from_history_fast below.
-  //
-  // Alternatively, or additionally, have a sloppy_copy_n32_from_history method
-  // that copies 8 bytes at a time, possibly writing more than length bytes?
+  // See also wuffs_base__io_writer__copy_n32_from_history_fast below, and
+  // its 8_byte_chunks variant, which can write more than length bytes.
   for (; n >= 3; n -= 3) {
     *p++ = *q++;
     *p++ = *q++;
@@ -102,6 +100,62 @@ wuffs_base__io_writer__copy_n32_from_history_fast(uint8_t** ptr_iop_w,
   return length;
 }
 
+// wuffs_base__io_writer__copy_n32_from_history_8_byte_chunks_fast is like the
+// wuffs_base__io_writer__copy_n32_from_history_fast function above, but copies
+// 8 bytes at a time. It can therefore write up to 7 bytes past length, so the
+// caller needs to prove a stronger pre-condition, that:
+//  - distance >  0
+//  - distance <= (*ptr_iop_w - io1_w)
+//  - length   <= (io2_w      - *ptr_iop_w) - 8
+//
+// Those extra bytes are overwritten by later writes (or are past the end of
+// the meaningful data), so they are never observable by the caller. The
+// *ptr_iop_w pointer only advances by length.
+//
+// For distance >= 8, each 8 byte chunk read (from q) was either already in
+// the buffer or was completely written by earlier chunks. For distance < 8,
+// a chunk would overlap the bytes it is writing, so instead we splat an 8 byte
+// pattern of the distance-periodic bytes, advancing by the largest multiple
+// of distance that is no more than 8.
+static inline uint32_t  //
+wuffs_base__io_writer__copy_n32_from_history_8_byte_chunks_fast(
+    uint8_t** ptr_iop_w,
+    uint8_t* io1_w,
+    uint8_t* io2_w,
+    uint32_t length,
+    uint32_t distance) {
+  uint8_t* p = *ptr_iop_w;
+  uint8_t* q = p - distance;
+  uint32_t n = length;
+  if (distance >= 8) {
+    for (; n > 8; n -= 8) {
+      wuffs_base__store_u64le__no_bounds_check(
+          p, wuffs_base__load_u64le__no_bounds_check(q));
+      p += 8;
+      q += 8;
+    }
+    wuffs_base__store_u64le__no_bounds_check(
+        p, wuffs_base__load_u64le__no_bounds_check(q));
+  } else {
+    uint64_t x = 0;
+    uint32_t s = 0;
+    for (; s < distance; s++) {
+      x |= ((uint64_t)(q[s])) << (8 * s);
+    }
+    for (; s < 8; s *= 2) {
+      x |= x << (8 * s);
+    }
+    uint32_t step = (8 / distance) * distance;
+    for (; n > step; n -= step) {
+      wuffs_base__store_u64le__no_bounds_check(p, x);
+      p += step;
+    }
+    wuffs_base__store_u64le__no_bounds_check(p, x);
+  }
+  *ptr_iop_w += length;
+  return length;
+}
+
 static inline uint32_t  //
 wuffs_base__io_writer__copy_n32_from_reader(uint8_t** ptr_iop_w,
                                             uint8_t* io2_w,
@@ -106,7 +106,16 @@ func (g *gen) writeBuiltinCall(b *buffer, n *a.Expr, depth uint32) error {
 				}
 				b.writes("&empty_io_buffer")
 				return nil
+
+			case t.IDMakeM128IMultipleU64, t.IDMakeM128ISingleU32,
+				t.IDMakeM128ISlice128, t.IDMakeM128IZeroes:
+				return g.writeBuiltinMakeM128I(b, method.Ident(), n.Args(), depth)
+			}
+			if strings.HasPrefix(method.Ident().Str(g.tm), "_mm_") {
+				return g.writeBuiltinX86M128I(b, n, nil, method.Ident(), n.Args(), depth)
 			}
+		case t.IDX86M128I:
+			return g.writeBuiltinX86M128I(b, n, recv, method.Ident(), n.Args(), depth)
 		}
 	}
 	return errNoSuchBuiltin
@@ -241,10 +250,12 @@ func (g *gen) writeBuiltinIOWriter(b *buffer, recv *a.Expr, method t.ID, args []
 	}
 
 	switch method {
-	case t.IDCopyN32FromHistory, t.IDCopyN32FromHistoryFast:
+	case t.IDCopyN32FromHistory, t.IDCopyN32FromHistoryFast, t.IDCopyN32FromHistory8ByteChunksFast:
 		suffix := ""
 		if method == t.IDCopyN32FromHistoryFast {
 			suffix = "_fast"
+		} else if method == t.IDCopyN32FromHistory8ByteChunksFast {
+			suffix = "_8_byte_chunks_fast"
 		}
 		b.printf("wuffs_base__io_writer__copy_n32_from_history%s(&%s%s, %s%s, %s%s",
 			suffix, iopPrefix, name, io0Prefix, name, io2Prefix, name)
@@ -453,10 +464,83 @@ func (g *gen) writeBuiltinNumType(b *buffer, recv *a.Expr, method t.ID, args []*
 	return errNoSuchBuiltin
 }
 
+func (g *gen) writeBuiltinMakeM128I(b *buffer, method t.ID, args []*a.Node, depth uint32) error {
+	switch method {
+	case t.IDMakeM128IMultipleU64:
+		// _mm_set_epi64x takes its arguments high lane first.
+		b.writes("_mm_set_epi64x((int64_t)(")
+		if err := g.writeExpr(b, args[1].AsArg().Value(), depth); err != nil {
+			return err
+		}
+		b.writes("), (int64_t)(")
+		if err := g.writeExpr(b, args[0].AsArg().Value(), depth); err != nil {
+			return err
+		}
+		b.writes("))")
+		return nil
+
+	case t.IDMakeM128ISingleU32:
+		b.writes("_mm_cvtsi32_si128((int)(")
+		if err := g.writeExpr(b, args[0].AsArg().Value(), depth); err != nil {
+			return err
+		}
+		b.writes("))")
+		return nil
+
+	case t.IDMakeM128ISlice128:
+		b.writes("_mm_lddqu_si128((const __m128i*)(const void*)(")
+		if err := g.writeExpr(b, args[0].AsArg().Value(), depth); err != nil {
+			return err
+		}
+		b.writes(".ptr))")
+		return nil
+
+	case t.IDMakeM128IZeroes:
+		b.writes("_mm_setzero_si128()")
+		return nil
+	}
+	return errNoSuchBuiltin
+}
+
+// writeBuiltinX86M128I writes "recv.foo(etc)" as the C intrinsic
+// "foo(recv, etc)". Non-vector return values are cast to the Wuffs type. A nil
+// recv, for "this.util._mm_foo(etc)", writes the intrinsic "_mm_foo(etc)".
+func (g *gen) writeBuiltinX86M128I(b *buffer, n *a.Expr, recv *a.Expr, method t.ID, args []*a.Node, depth uint32) error {
+	cast := ""
+	if typ := n.MType(); typ.IsNumType() {
+		cast = cTypeNames[typ.QID()[1]]
+		b.printf("((%s)(", cast)
+	}
+
+	b.printf("%s(", method.Str(g.tm))
+	comma := false
+	if recv != nil {
+		if err := g.writeExpr(b, recv, depth); err != nil {
+			return err
+		}
+		comma = true
+	}
+	for _, o := range args {
+		if comma {
+			b.writes(", ")
+		}
+		comma = true
+		if err := g.writeExpr(b, o.AsArg().Value(), depth); err != nil {
+			return err
+		}
+	}
+	b.writeb(')')
+
+	if cast != "" {
+		b.writes("))")
+	}
+	return nil
+}
+
 func (g *gen) writeBuiltinSlice(b *buffer, recv *a.Expr, method t.ID, args []*a.Node, depth uint32) error {
 	switch method {
 	case t.IDCopyFromSlice:
-		if err := g.writeBuiltinSliceCopyFromSlice8(b, recv, method, args, depth); err != errOptimizationNotApplicable {
+		if err := g.writeBuiltinSliceCopyFromSliceN(b, recv, method, args, depth); err != errOptimizationNotApplicable {
 			return err
 		}
 
@@ -476,6 +560,15 @@ func (g *gen) writeBuiltinSlice(b *buffer, recv *a.Expr, method t.ID, args []*a.
 		b.writes(".len))")
 		return nil
 
+	case t.IDPeekU64LE:
+		// TODO: don't assume that the slice is a slice of base.u8.
+		b.writes("wuffs_base__load_u64le__no_bounds_check(")
+		if err := g.writeExpr(b, recv, depth); err != nil {
+			return err
+		}
+		b.writes(".ptr)")
+		return nil
+
 	case t.IDSuffix:
 		// TODO: don't assume that the slice is a slice of base.u8.
 		b.writes("wuffs_base__slice_u8__suffix(")
@@ -488,16 +581,18 @@ func (g *gen) writeBuiltinSlice(b *buffer, recv *a.Expr, method t.ID, args []*a.
 	return errNoSuchBuiltin
 }
 
-// writeBuiltinSliceCopyFromSlice8 writes an optimized version of:
+// writeBuiltinSliceCopyFromSliceN writes an optimized version of:
+//
+// foo[fIndex .. fIndex + N].copy_from_slice!(s:bar[bIndex .. bIndex + N])
 //
-// foo[fIndex .. fIndex + 8].copy_from_slice!(s:bar[bIndex .. bIndex + 8])
-func (g *gen) writeBuiltinSliceCopyFromSlice8(b *buffer, recv *a.Expr, method t.ID, args []*a.Node, depth uint32) error {
+// for a small constant N, such as 8 or 16.
+func (g *gen) writeBuiltinSliceCopyFromSliceN(b *buffer, recv *a.Expr, method t.ID, args []*a.Node, depth uint32) error {
 	if method != t.IDCopyFromSlice || len(args) != 1 {
 		return errOptimizationNotApplicable
 	}
-	foo, fIndex := matchFooIndexIndexPlus8(recv)
-	bar, bIndex := matchFooIndexIndexPlus8(args[0].AsArg().Value())
-	if foo == nil || bar == nil {
+	foo, fIndex, fN := matchFooIndexIndexPlusN(recv)
+	bar, bIndex, bN := matchFooIndexIndexPlusN(args[0].AsArg().Value())
+	if foo == nil || bar == nil || fN != bN {
 		return errOptimizationNotApplicable
 	}
 	b.writes("memcpy((")
@@ -527,35 +622,41 @@ func (g *gen) writeBuiltinSliceCopyFromSlice8(b *buffer, recv *a.Expr, method t.
 		}
 	}
 	// TODO: don't assume that the slice is a slice of base.u8.
-	b.writes("), 8)")
+	b.printf("), %d)", fN)
 	return nil
 }
 
-// matchFooIndexIndexPlus8 matches n with "foo[index .. index + 8]" or "foo[..
-// 8]". It returns a nil foo if there isn't a match.
-func matchFooIndexIndexPlus8(n *a.Expr) (foo *a.Expr, index *a.Expr) {
+// matchFooIndexIndexPlusN matches n with "foo[index .. index + N]" or "foo[..
+// N]", for a constant N that is one of 8, 16 or 32. It returns a nil foo if
+// there isn't a match.
+func matchFooIndexIndexPlusN(n *a.Expr) (foo *a.Expr, index *a.Expr, length int64) {
 	if n.Operator() != t.IDDotDot {
-		return nil, nil
+		return nil, nil, 0
 	}
 	foo = n.LHS().AsExpr()
 	index = n.MHS().AsExpr()
 	rhs := n.RHS().AsExpr()
 	if rhs == nil {
-		return nil, nil
+		return nil, nil, 0
 	}
 
 	if index == nil {
 		// No-op.
 	} else if rhs.Operator() != t.IDXBinaryPlus || !rhs.LHS().AsExpr().Eq(index) {
-		return nil, nil
+		return nil, nil, 0
 	} else {
 		rhs = rhs.RHS().AsExpr()
 	}
 
-	if cv := rhs.ConstValue(); cv == nil || cv.Cmp(eight) != 0 {
-		return nil, nil
+	cv := rhs.ConstValue()
+	if cv == nil || !cv.IsInt64() {
+		return nil, nil, 0
+	}
+	switch length = cv.Int64(); length {
+	case 8, 16, 32:
+		return foo, index, length
 	}
-	return foo, index
+	return nil, nil, 0
 }
 
 func (g *gen) writeBuiltinTable(b *buffer, recv *a.Expr, method t.ID, args []*a.Node, depth uint32) error {
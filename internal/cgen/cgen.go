@@ -39,9 +39,10 @@ import (
 var (
 	zero      = big.NewInt(0)
 	one       = big.NewInt(1)
-	eight     = big.NewInt(8)
 	sixtyFour = big.NewInt(64)
 
+	maxInt32 = big.NewInt(0x7FFF_FFFF)
+
 	mibi = big.NewInt(1 << 20)
 
 	typeExprUtility = a.NewTypeExpr(0, t.IDBase, t.IDUtility, nil, nil, nil)
@@ -791,6 +792,37 @@ func (g *gen) forEachConst(b *buffer, v visibility, f func(*gen, *buffer, *a.Con
 	return nil
 }
 
+func (g *gen) findFunc(qqid t.QQID) *a.Func {
+	for _, file := range g.files {
+		for _, tld := range file.TopLevelDecls() {
+			if tld.Kind() != a.KFunc {
+				continue
+			}
+			if o := tld.AsFunc(); o.QQID() == qqid {
+				return o
+			}
+		}
+	}
+	return nil
+}
+
+// forEachChoosyFunc calls f for each choosy method of the struct n.
+func (g *gen) forEachChoosyFunc(n *a.Struct, f func(*a.Func) error) error {
+	for _, file := range g.files {
+		for _, tld := range file.TopLevelDecls() {
+			if tld.Kind() != a.KFunc {
+				continue
+			}
+			if o := tld.AsFunc(); (o.Receiver() == n.QID()) && o.Choosy() {
+				if err := f(o); err != nil {
+					return err
+				}
+			}
+		}
+	}
+	return nil
+}
+
 func (g *gen) forEachFunc(b *buffer, v visibility, f func(*gen, *buffer, *a.Func) error) error {
 	for _, file := range g.files {
 		for _, tld := range file.TopLevelDecls() {
@@ -977,6 +1009,17 @@ func (g *gen) writeStructPrivateImpl(b *buffer, n *a.Struct) error {
 		b.writes(";\n")
 	}
 
+	if err := g.forEachChoosyFunc(n, func(o *a.Func) error {
+		b.writeb('\n')
+		if err := g.writeFuncSignature(b, o, wfsCChoosyField); err != nil {
+			return err
+		}
+		b.writes(";\n")
+		return nil
+	}); err != nil {
+		return err
+	}
+
 	if n.Classy() {
 		b.writeb('\n')
 		for _, file := range g.files {
@@ -1300,6 +1343,14 @@ func (g *gen) writeInitializerImpl(b *buffer, n *a.Struct) error {
 		b.printf("}\n")
 	}
 
+	if err := g.forEachChoosyFunc(n, func(o *a.Func) error {
+		b.printf("self->private_impl.choosy_%s = &%s__choosy_default;\n",
+			o.FuncName().Str(g.tm), g.funcCName(o))
+		return nil
+	}); err != nil {
+		return err
+	}
+
 	b.writes("self->private_impl.magic = WUFFS_BASE__MAGIC;\n")
 	for _, impl := range n.Implements() {
 		qid := impl.AsTypeExpr().QID()
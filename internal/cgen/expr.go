@@ -98,7 +98,7 @@ func (g *gen) writeExprOther(b *buffer, n *a.Expr, depth uint32) error {
 			return err
 		}
 
-		if n.LHS().AsExpr().Ident() == t.IDReset {
+		if n.BuiltInReset() {
 			method := n.LHS().AsExpr()
 			recv := method.LHS().AsExpr()
 			recvTyp, addr := recv.MType(), "&"
@@ -279,6 +279,7 @@ func (g *gen) writeExprBinaryOp(b *buffer, n *a.Expr, depth uint32) error {
 	if g.hasRepr(n.LHS().AsExpr()) {
 		b.writes(".repr")
 	}
+	g.writeU32Suffix(b, n, n.LHS().AsExpr())
 	b.writes(opName)
 	if err := g.writeExpr(b, n.RHS().AsExpr(), depth); err != nil {
 		return err
@@ -286,6 +287,7 @@ func (g *gen) writeExprBinaryOp(b *buffer, n *a.Expr, depth uint32) error {
 	if g.hasRepr(n.RHS().AsExpr()) {
 		b.writes(".repr")
 	}
+	g.writeU32Suffix(b, n, n.RHS().AsExpr())
 	b.writeb(')')
 	return nil
 }
@@ -294,6 +296,17 @@ func (g *gen) hasRepr(n *a.Expr) bool {
 	return n.MType().IsStatus()
 }
 
+// writeU32Suffix writes an unsigned suffix after operand, a constant operand
+// of the u32 binary op n, if that constant is too large for a C int. Without
+// it, the C literal's type is signed and wider than 32 bits, and arithmetic
+// like "x ~mod* 0x9E37_79B1" would not be modulo 2^32.
+func (g *gen) writeU32Suffix(b *buffer, n *a.Expr, operand *a.Expr) {
+	if cv := operand.ConstValue(); (cv != nil) && (cv.Cmp(maxInt32) > 0) &&
+		(uintBits(n.MType().QID()) == 32) {
+		b.writeb('u')
+	}
+}
+
 func (g *gen) writeExprAs(b *buffer, lhs *a.Expr, rhs *a.TypeExpr, depth uint32) error {
 	b.writes("((")
 	// TODO: watch for passing an array type to writeCTypeName? In C, an array
@@ -484,6 +497,8 @@ var cTypeNames = [...]string{
 	t.IDIOWriter:    "wuffs_base__io_buffer*",
 	t.IDTokenReader: "wuffs_base__token_buffer*",
 	t.IDTokenWriter: "wuffs_base__token_buffer*",
+
+	t.IDX86M128I: "__m128i",
 }
 
 const noSuchCOperator = " no_such_C_operator "
@@ -79,10 +79,12 @@ func (g *gen) funcCName(n *a.Func) string {
 
 // writeFunctionSignature modes.
 const (
-	wfsCDecl         = 0
-	wfsCppDecl       = 1
-	wfsCFuncPtrField = 2
-	wfsCFuncPtrType  = 3
+	wfsCDecl          = 0
+	wfsCppDecl        = 1
+	wfsCFuncPtrField  = 2
+	wfsCFuncPtrType   = 3
+	wfsCChoosyDefault = 4
+	wfsCChoosyField   = 5
 )
 
 func (g *gen) writeFuncSignature(b *buffer, n *a.Func, wfs uint32) error {
@@ -90,6 +92,13 @@ func (g *gen) writeFuncSignature(b *buffer, n *a.Func, wfs uint32) error {
 	case wfsCDecl:
 		if n.Public() {
 			b.writes("WUFFS_BASE__MAYBE_STATIC ")
+			// A program that uses a package's types, such as its hasher,
+			// might not call that package's free-standing functions. Don't
+			// warn about those when WUFFS_CONFIG__STATIC_FUNCTIONS is
+			// defined.
+			if n.Receiver().IsZero() {
+				b.writes("WUFFS_BASE__POTENTIALLY_UNUSED ")
+			}
 		} else {
 			b.writes("static ")
 		}
@@ -97,7 +106,10 @@ func (g *gen) writeFuncSignature(b *buffer, n *a.Func, wfs uint32) error {
 	case wfsCppDecl:
 		b.writes("inline ")
 
-	case wfsCFuncPtrField, wfsCFuncPtrType:
+	case wfsCChoosyDefault:
+		b.writes("static ")
+
+	case wfsCFuncPtrField, wfsCFuncPtrType, wfsCChoosyField:
 		// No-op.
 	}
 
@@ -113,14 +125,24 @@ func (g *gen) writeFuncSignature(b *buffer, n *a.Func, wfs uint32) error {
 
 	// The empty // comment makes clang-format place the function name at the
 	// start of a line.
-	if (wfs != wfsCFuncPtrField) && (wfs != wfsCFuncPtrType) {
+	if (wfs != wfsCFuncPtrField) && (wfs != wfsCFuncPtrType) && (wfs != wfsCChoosyField) {
 		b.writes("//\n")
 	}
 
 	comma := false
 	switch wfs {
-	case wfsCDecl:
-		b.writes(g.funcCName(n))
+	case wfsCDecl, wfsCChoosyDefault, wfsCChoosyField:
+		switch wfs {
+		case wfsCDecl:
+			b.writes(g.funcCName(n))
+		case wfsCChoosyDefault:
+			b.writes(g.funcCName(n))
+			b.writes("__choosy_default")
+		case wfsCChoosyField:
+			b.writes("(*choosy_")
+			b.writes(n.FuncName().Str(g.tm))
+			b.writeb(')')
+		}
 		b.writeb('(')
 		if r := n.Receiver(); !r.IsZero() {
 			if n.Effect().Pure() {
@@ -172,11 +194,35 @@ func (g *gen) writeFuncSignature(b *buffer, n *a.Func, wfs uint32) error {
 	return nil
 }
 
+// cpuArchCNames maps a func's "choose cpu_arch >= etc" to the C macro that
+// guards its declaration and the C compiler attribute that enables the
+// corresponding instructions.
+var cpuArchCNames = map[t.ID]struct {
+	guard  string
+	target string
+}{
+	t.IDX86SSE42: {"WUFFS_BASE__CPU_ARCH__X86_64", "pclmul,popcnt,sse4.2"},
+}
+
 func (g *gen) writeFuncPrototype(b *buffer, n *a.Func) error {
+	if ca := n.CPUArch(); ca != 0 {
+		b.printf("#if defined(%s)\n", cpuArchCNames[ca].guard)
+	}
 	if err := g.writeFuncSignature(b, n, wfsCDecl); err != nil {
 		return err
 	}
-	b.writes(";\n\n")
+	b.writes(";\n")
+	if ca := n.CPUArch(); ca != 0 {
+		b.printf("#endif  // defined(%s)\n", cpuArchCNames[ca].guard)
+	}
+	b.writes("\n")
+
+	if n.Choosy() {
+		if err := g.writeFuncSignature(b, n, wfsCChoosyDefault); err != nil {
+			return err
+		}
+		b.writes(";\n\n")
+	}
 	return nil
 }
 
@@ -184,11 +230,42 @@ func (g *gen) writeFuncImpl(b *buffer, n *a.Func) error {
 	k := g.funks[n.QQID()]
 
 	b.printf("// -------- func %s.%s\n\n", g.pkgName, n.QQID().Str(g.tm))
-	if err := g.writeFuncSignature(b, n, wfsCDecl); err != nil {
-		return err
+
+	if n.Choosy() {
+		// The choosy func itself dispatches to the chosen implementation,
+		// which defaults to the func body as written in the Wuffs source.
+		if err := g.writeFuncSignature(b, n, wfsCDecl); err != nil {
+			return err
+		}
+		b.printf("{\nreturn (*self->private_impl.choosy_%s)(self", n.FuncName().Str(g.tm))
+		for _, o := range n.In().Fields() {
+			b.writeb(',')
+			b.writes(aPrefix)
+			b.writes(o.AsField().Name().Str(g.tm))
+		}
+		b.writes(");\n}\n\n")
+
+		if err := g.writeFuncSignature(b, n, wfsCChoosyDefault); err != nil {
+			return err
+		}
+
+	} else {
+		if ca := n.CPUArch(); ca != 0 {
+			b.printf("#if defined(%s)\n", cpuArchCNames[ca].guard)
+			b.printf("WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET(\"%s\")\n", cpuArchCNames[ca].target)
+		}
+		if err := g.writeFuncSignature(b, n, wfsCDecl); err != nil {
+			return err
+		}
 	}
+
 	b.writes("{\n")
 	b.writex(k.bPrologue)
+	if n.FuncName() == t.IDReset {
+		if err := g.writeResetPrologue(b, n); err != nil {
+			return err
+		}
+	}
 	if k.astFunc.Effect().Coroutine() {
 		b.writex(k.bBodyResume)
 	}
@@ -199,7 +276,47 @@ func (g *gen) writeFuncImpl(b *buffer, n *a.Func) error {
 		b.writes("\ngoto ok;ok:\n") // The goto avoids the "unused label" warning.
 	}
 	b.writex(k.bEpilogue)
-	b.writes("}\n\n")
+	b.writes("}\n")
+	if ca := n.CPUArch(); ca != 0 {
+		b.printf("#endif  // defined(%s)\n", cpuArchCNames[ca].guard)
+	}
+	b.writes("\n")
+	return nil
+}
+
+// writeResetPrologue writes the start of a user-defined reset method (one that
+// replaces the implied reset method). It re-enables a receiver that an earlier
+// error disabled and abandons any suspended coroutines. The rest of the
+// receiver's state is left as is, for the method body to reset as needed.
+//
+// This is called from writeFuncImpl, not gatherFuncImpl, as it needs every
+// coroutine's funk and not just those of the funcs gathered so far.
+func (g *gen) writeResetPrologue(b *buffer, n *a.Func) error {
+	s := g.structMap[n.Receiver()]
+	if s == nil {
+		return fmt.Errorf("cannot generate reset method for receiver type %q", n.Receiver().Str(g.tm))
+	} else if !s.Classy() {
+		return nil
+	}
+	b.writes("self->private_impl.magic = WUFFS_BASE__MAGIC;\n")
+	b.writes("self->private_impl.active_coroutine = 0;\n")
+	for _, file := range g.files {
+		for _, tld := range file.TopLevelDecls() {
+			if tld.Kind() != a.KFunc {
+				continue
+			}
+			o := tld.AsFunc()
+			if o.Receiver() != n.Receiver() || !o.Effect().Coroutine() {
+				continue
+			}
+			if k := g.funks[o.QQID()]; k.coroSuspPoint == 0 {
+				continue
+			}
+			b.printf("memset(self->private_impl.%s%s, 0, sizeof(self->private_impl.%s%s));\n",
+				pPrefix, o.FuncName().Str(g.tm), pPrefix, o.FuncName().Str(g.tm))
+		}
+	}
+	b.writes("\n")
 	return nil
 }
 
@@ -297,7 +414,9 @@ func writeFuncImplSelfMagicCheck(b *buffer, tm *t.Map, f *a.Func) error {
 	}
 	b.writes(";}")
 
-	if f.Effect().Pure() {
+	// A user-defined reset method can be called after an error. It re-enables
+	// the receiver: see writeResetPrologue.
+	if f.Effect().Pure() || (f.FuncName() == t.IDReset) {
 		b.writes("if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&")
 		b.writes("    (self->private_impl.magic != WUFFS_BASE__DISABLED)) {")
 	} else {
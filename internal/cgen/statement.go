@@ -57,6 +57,8 @@ func (g *gen) writeStatement(b *buffer, n *a.Node, depth uint32) error {
 	case a.KAssign:
 		n := n.AsAssign()
 		return g.writeStatementAssign(b, n.Operator(), n.LHS(), n.RHS(), depth)
+	case a.KChoose:
+		return g.writeStatementChoose(b, n.AsChoose(), depth)
 	case a.KIOBind:
 		return g.writeStatementIOBind(b, n.AsIOBind(), depth)
 	case a.KIf:
@@ -243,6 +245,32 @@ func (g *gen) writeStatementAssign1(b *buffer, op t.ID, lhs *a.Expr, rhs *a.Expr
 	return nil
 }
 
+func (g *gen) writeStatementChoose(b *buffer, n *a.Choose, depth uint32) error {
+	recv := g.currFunk.astFunc.Receiver()
+	name := n.Name().Str(g.tm)
+	args := n.Args()
+	// Each choice is a separate statement, guarded by its own #if, so that
+	// the guards do not end up inside an expression. They are written in
+	// reverse order so that earlier (preferred) choices overwrite later ones.
+	for i := len(args) - 1; i >= 0; i-- {
+		id := args[i].AsExpr().Ident()
+		f := g.findFunc(t.QQID{recv[0], recv[1], id})
+		if f == nil {
+			return fmt.Errorf("cannot find func %q", id.Str(g.tm))
+		}
+		ca, ok := cpuArchCNames[f.CPUArch()]
+		if !ok {
+			return fmt.Errorf("unsupported cpu_arch for func %q", id.Str(g.tm))
+		}
+		b.printf("#if defined(%s)\n", ca.guard)
+		b.printf("if (wuffs_base__cpu_arch__have_%s()) {\n", f.CPUArch().Str(g.tm))
+		b.printf("self->private_impl.choosy_%s = &%s;\n", name, g.funcCName(f))
+		b.printf("}\n")
+		b.printf("#endif\n")
+	}
+	return nil
+}
+
 func (g *gen) writeStatementIOBind(b *buffer, n *a.IOBind, depth uint32) error {
 	if g.currFunk.ioBinds > maxIOBinds {
 		return fmt.Errorf("too many temporary variables required")
@@ -40,6 +40,7 @@ const (
 	KArg
 	KAssert
 	KAssign
+	KChoose
 	KConst
 	KExpr
 	KField
@@ -71,6 +72,7 @@ var kindStrings = [...]string{
 	KArg:      "KArg",
 	KAssert:   "KAssert",
 	KAssign:   "KAssign",
+	KChoose:   "KChoose",
 	KConst:    "KConst",
 	KExpr:     "KExpr",
 	KField:    "KField",
@@ -103,6 +105,9 @@ const (
 	FlagsSubExprHasEffect = Flags(0x00002000)
 	FlagsRetsError        = Flags(0x00004000)
 	FlagsPrivateData      = Flags(0x00008000)
+	FlagsChoosy           = Flags(0x00010000)
+	FlagsCPUArchX86SSE42  = Flags(0x00020000)
+	FlagsBuiltInReset     = Flags(0x00040000)
 )
 
 func (f Flags) AsEffect() Effect { return Effect(f) }
@@ -159,6 +164,7 @@ type Node struct {
 	// Arg           .             .             name          Arg
 	// Assert        keyword       .             lit(reason)   Assert
 	// Assign        operator      .             .             Assign
+	// Choose        .             .             name          Choose
 	// Const         .             pkg           name          Const
 	// Expr          operator      pkg           literal/ident Expr
 	// Field         .             .             name          Field
@@ -197,6 +203,7 @@ func (n *Node) SetMType(x *TypeExpr)           { n.mType = x }
 func (n *Node) AsArg() *Arg           { return (*Arg)(n) }
 func (n *Node) AsAssert() *Assert     { return (*Assert)(n) }
 func (n *Node) AsAssign() *Assign     { return (*Assign)(n) }
+func (n *Node) AsChoose() *Choose     { return (*Choose)(n) }
 func (n *Node) AsConst() *Const       { return (*Const)(n) }
 func (n *Node) AsExpr() *Expr         { return (*Expr)(n) }
 func (n *Node) AsField() *Field       { return (*Field)(n) }
@@ -336,6 +343,7 @@ type Expr Node
 func (n *Expr) AsNode() *Node              { return (*Node)(n) }
 func (n *Expr) Effect() Effect             { return Effect(n.flags) }
 func (n *Expr) GlobalIdent() bool          { return n.flags&FlagsGlobalIdent != 0 }
+func (n *Expr) BuiltInReset() bool         { return n.flags&FlagsBuiltInReset != 0 }
 func (n *Expr) SubExprHasEffect() bool     { return n.flags&FlagsSubExprHasEffect != 0 }
 func (n *Expr) ConstValue() *big.Int       { return n.constValue }
 func (n *Expr) MBounds() interval.IntRange { return n.mBounds }
@@ -350,6 +358,7 @@ func (n *Expr) Args() []*Node              { return n.list0 }
 
 func (n *Expr) SetConstValue(x *big.Int)       { n.constValue = x }
 func (n *Expr) SetGlobalIdent()                { n.flags |= FlagsGlobalIdent }
+func (n *Expr) SetBuiltInReset()               { n.flags |= FlagsBuiltInReset }
 func (n *Expr) SetMBounds(x interval.IntRange) { n.mBounds = x }
 func (n *Expr) SetMType(x *TypeExpr)           { n.mType = x }
 
@@ -446,6 +455,23 @@ func NewAssign(operator t.ID, lhs *Expr, rhs *Expr) *Assign {
 	}
 }
 
+// Choose is "choose ID2 = [List0]":
+//  - ID2:   name
+//  - List0: <Expr> method names.
+type Choose Node
+
+func (n *Choose) AsNode() *Node { return (*Node)(n) }
+func (n *Choose) Name() t.ID    { return n.id2 }
+func (n *Choose) Args() []*Node { return n.list0 }
+
+func NewChoose(name t.ID, args []*Node) *Choose {
+	return &Choose{
+		kind:  KChoose,
+		id2:   name,
+		list0: args,
+	}
+}
+
 // Var is "var ID2 LHS":
 //  - ID2:   name
 //  - LHS:   <TypeExpr>
@@ -813,6 +839,8 @@ const MaxBodyDepth = 255
 
 // Func is "func ID2.ID0(LHS)(RHS) { List2 }":
 //  - FlagsPublic      is "pub" vs "pri"
+//  - FlagsChoosy      is whether the func can be re-targeted by a "choose"
+//  - FlagsCPUArchXxx  is a "choose cpu_arch >= xxx" requirement
 //  - ID0:   funcName
 //  - ID1:   <0|receiverPkg> (set by calling SetPackage)
 //  - ID2:   <0|receiverName>
@@ -824,6 +852,7 @@ const MaxBodyDepth = 255
 // Statement means one of:
 //  - Assert
 //  - Assign
+//  - Choose
 //  - IOBind
 //  - If
 //  - Iterate
@@ -836,6 +865,7 @@ type Func Node
 func (n *Func) AsNode() *Node    { return (*Node)(n) }
 func (n *Func) Effect() Effect   { return Effect(n.flags) }
 func (n *Func) Public() bool     { return n.flags&FlagsPublic != 0 }
+func (n *Func) Choosy() bool     { return n.flags&FlagsChoosy != 0 }
 func (n *Func) Filename() string { return n.filename }
 func (n *Func) Line() uint32     { return n.line }
 func (n *Func) QQID() t.QQID     { return t.QQID{n.id1, n.id2, n.id0} }
@@ -846,6 +876,15 @@ func (n *Func) Out() *TypeExpr   { return n.rhs.AsTypeExpr() }
 func (n *Func) Asserts() []*Node { return n.list1 }
 func (n *Func) Body() []*Node    { return n.list2 }
 
+// CPUArch returns the minimum CPU architecture (e.g. t.IDX86SSE42) required by
+// the func, or zero if it is portable.
+func (n *Func) CPUArch() t.ID {
+	if n.flags&FlagsCPUArchX86SSE42 != 0 {
+		return t.IDX86SSE42
+	}
+	return 0
+}
+
 func (n *Func) BodyEndsWithReturn() bool {
 	if len(n.list2) == 0 {
 		return false
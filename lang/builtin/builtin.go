@@ -100,6 +100,8 @@ var Types = []string{
 	"pixel_swizzler",
 
 	"decode_frame_options",
+
+	"x86_m128i",
 }
 
 var Funcs = []string{
@@ -144,6 +146,37 @@ var Funcs = []string{
 	"utility.make_rect_ie_u32(" +
 		"min_incl_x: u32, min_incl_y: u32, max_excl_x: u32, max_excl_y: u32) rect_ie_u32",
 
+	// ---- x86_m128i
+
+	// The x86 SIMD funcs can only be called from funcs that also have the
+	// "choose cpu_arch >= x86_sse42" annotation. They map directly to the C
+	// intrinsics of the same name (or, for the make_etc funcs, to the
+	// obvious _mm_set_etc or _mm_loadu_etc equivalent).
+	//
+	// Arguments named imm8 must be constant values.
+
+	"utility.make_m128i_multiple_u64(a00: u64, a01: u64) x86_m128i, choose cpu_arch >= x86_sse42",
+	"utility.make_m128i_single_u32(a: u32) x86_m128i, choose cpu_arch >= x86_sse42",
+	"utility.make_m128i_slice128(a: slice u8) x86_m128i, choose cpu_arch >= x86_sse42",
+	"utility.make_m128i_zeroes() x86_m128i, choose cpu_arch >= x86_sse42",
+
+	"utility._mm_crc32_u8(crc: u32, v: u8) u32, choose cpu_arch >= x86_sse42",
+	"utility._mm_crc32_u64(crc: u64, v: u64) u64[..= 0xFFFF_FFFF], choose cpu_arch >= x86_sse42",
+
+	"x86_m128i._mm_add_epi32(b: x86_m128i) x86_m128i, choose cpu_arch >= x86_sse42",
+	"x86_m128i._mm_and_si128(b: x86_m128i) x86_m128i, choose cpu_arch >= x86_sse42",
+	"x86_m128i._mm_clmulepi64_si128(b: x86_m128i, imm8: u32[..= 0xFF]) x86_m128i, choose cpu_arch >= x86_sse42",
+	"x86_m128i._mm_cvtsi128_si32() u32, choose cpu_arch >= x86_sse42",
+	"x86_m128i._mm_cvtsi128_si64() u64, choose cpu_arch >= x86_sse42",
+	"x86_m128i._mm_extract_epi32(imm8: u32[..= 3]) u32, choose cpu_arch >= x86_sse42",
+	"x86_m128i._mm_madd_epi16(b: x86_m128i) x86_m128i, choose cpu_arch >= x86_sse42",
+	"x86_m128i._mm_maddubs_epi16(b: x86_m128i) x86_m128i, choose cpu_arch >= x86_sse42",
+	"x86_m128i._mm_sad_epu8(b: x86_m128i) x86_m128i, choose cpu_arch >= x86_sse42",
+	"x86_m128i._mm_shuffle_epi32(imm8: u32[..= 0xFF]) x86_m128i, choose cpu_arch >= x86_sse42",
+	"x86_m128i._mm_slli_epi32(imm8: u32[..= 0xFF]) x86_m128i, choose cpu_arch >= x86_sse42",
+	"x86_m128i._mm_srli_si128(imm8: u32[..= 0xFF]) x86_m128i, choose cpu_arch >= x86_sse42",
+	"x86_m128i._mm_xor_si128(b: x86_m128i) x86_m128i, choose cpu_arch >= x86_sse42",
+
 	// ---- ranges
 
 	"range_ie_u32.reset!()",
@@ -329,6 +362,11 @@ var Funcs = []string{
 	// For now, that's all implicitly checked (i.e. hard coded).
 	"io_writer.copy_n32_from_history_fast!(n: u32, distance: u32) u32",
 
+	// copy_n32_from_history_8_byte_chunks_fast is like
+	// copy_n32_from_history_fast but it can write up to 8 bytes past n, so it
+	// requires "(n + 8) <= available()", proven via n's upper bound.
+	"io_writer.copy_n32_from_history_8_byte_chunks_fast!(n: u32, distance: u32) u32",
+
 	// ---- token_writer
 
 	"token_writer.write_token?(" +
@@ -441,6 +479,7 @@ const (
 var SliceFuncs = []string{
 	"GENERIC T1.copy_from_slice!(s: T1) u64",
 	"GENERIC T1.length() u64",
+	"GENERIC T1.peek_u64le() u64",
 	"GENERIC T1.prefix(up_to: u64) T1",
 	"GENERIC T1.suffix(up_to: u64) T1",
 }
@@ -120,7 +120,15 @@ func (z facts) refine(n *a.Expr, nb bounds, tm *t.Map) (bounds, error) {
 		}
 		cv := other.ConstValue()
 		if cv == nil {
-			continue
+			// Named consts, such as "x < foo_max" where "pri const foo_max",
+			// don't have a ConstValue but do have exact bounds.
+			if !other.GlobalIdent() {
+				continue
+			} else if ob := other.MBounds(); (ob[0] != nil) && (ob[1] != nil) && (ob[0].Cmp(ob[1]) == 0) {
+				cv = ob[0]
+			} else {
+				continue
+			}
 		}
 
 		originalNB, changed := nb, false
@@ -354,11 +362,18 @@ func proveReasonRequirementForRHSLength(q *checker, op t.ID, lhs *a.Expr, rhs *a
 		if (op == t.IDXBinaryLessThan) || (op == t.IDXBinaryLessEq) {
 			for _, x := range q.facts {
 				// Try to prove "lhs op rhs" by proving "lhs op const", given a
-				// fact x of the form "rhs >= const".
-				if (x.Operator() == t.IDXBinaryGreaterEq) && x.LHS().AsExpr().Eq(rhs) &&
-					(x.RHS().AsExpr().ConstValue() != nil) &&
-					(proveReasonRequirement(q, op, lhs, x.RHS().AsExpr()) == nil) {
-
+				// fact x of the form "rhs >= const". The const can be a
+				// literal or a named const.
+				if (x.Operator() != t.IDXBinaryGreaterEq) || !x.LHS().AsExpr().Eq(rhs) {
+					continue
+				}
+				c := x.RHS().AsExpr()
+				if c.ConstValue() == nil {
+					if c = q.namedConstValueExpr(c); c == nil {
+						continue
+					}
+				}
+				if proveReasonRequirement(q, op, lhs, c) == nil {
 					return nil
 				}
 			}
@@ -367,3 +382,24 @@ func proveReasonRequirementForRHSLength(q *checker, op t.ID, lhs *a.Expr, rhs *a
 	}
 	return nil
 }
+
+// namedConstValueExpr returns an expression for n's value, if n names a const
+// of this package, or nil otherwise.
+func (q *checker) namedConstValueExpr(n *a.Expr) *a.Expr {
+	if n.Operator() != 0 {
+		return nil
+	}
+	c, ok := q.c.consts[t.QID{0, n.Ident()}]
+	if !ok {
+		return nil
+	}
+	cv := c.Value().ConstValue()
+	if cv == nil {
+		return nil
+	}
+	o, err := makeConstValueExpr(q.tm, cv)
+	if err != nil {
+		return nil
+	}
+	return o
+}
@@ -242,6 +242,9 @@ func (q *checker) bcheckStatement(n *a.Node) error {
 			return err
 		}
 
+	case a.KChoose:
+		// No-op.
+
 	case a.KIOBind:
 		n := n.AsIOBind()
 		if _, err := q.bcheckExpr(n.IO(), 0); err != nil {
@@ -918,7 +921,7 @@ func (q *checker) bcheckExprOther(n *a.Expr, depth uint32) (bounds, error) {
 				return bounds{}, err
 			}
 		}
-		if err := proveReasonRequirement(q, t.IDXBinaryLessEq, mhs, rhs); err != nil {
+		if err := proveReasonRequirementForRHSLength(q, t.IDXBinaryLessEq, mhs, rhs); err != nil {
 			return bounds{}, err
 		}
 		if rhs != lengthExpr {
@@ -1044,6 +1047,29 @@ func (q *checker) bcheckExprCallSpecialCases(n *a.Expr, depth uint32) (bounds, e
 			}
 		}
 
+	} else if recvTyp.IsSliceType() {
+		if method == t.IDPeekU64LE {
+			if err := q.bcheckSliceLengthAtLeast(recv, eight); err != nil {
+				return bounds{}, err
+			}
+		}
+
+	} else if recvTyp.Eq(typeExprUtility) {
+		if method == t.IDMakeM128ISlice128 {
+			// The C intrinsic loads 16 bytes, regardless of the slice length.
+			if err := q.bcheckSliceLengthAtLeast(n.Args()[0].AsArg().Value(), sixteen); err != nil {
+				return bounds{}, err
+			}
+		}
+
+	} else if recvTyp.Eq(typeExprX86M128I) {
+		for _, o := range n.Args() {
+			if o := o.AsArg(); (o.Name() == t.IDImm8) && (o.Value().ConstValue() == nil) {
+				return bounds{}, fmt.Errorf("check: %s imm8 argument is not a constant value",
+					method.Str(q.tm))
+			}
+		}
+
 	} else if recvTyp.IsIOTokenType() {
 		advance, update := (*big.Int)(nil), false
 
@@ -1053,7 +1079,12 @@ func (q *checker) bcheckExprCallSpecialCases(n *a.Expr, depth uint32) (bounds, e
 			}
 
 		} else if method == t.IDCopyN32FromHistoryFast {
-			if err := q.canCopyN32FromHistoryFast(recv, n.Args()); err != nil {
+			if err := q.canCopyN32FromHistoryFast(recv, n.Args(), false); err != nil {
+				return bounds{}, err
+			}
+
+		} else if method == t.IDCopyN32FromHistory8ByteChunksFast {
+			if err := q.canCopyN32FromHistoryFast(recv, n.Args(), true); err != nil {
 				return bounds{}, err
 			}
 
@@ -1110,6 +1141,38 @@ func (q *checker) bcheckExprCallSpecialCases(n *a.Expr, depth uint32) (bounds, e
 	return bounds{}, errNotASpecialCase
 }
 
+// bcheckSliceLengthAtLeast proves that "x.length() >= n". As a special case,
+// x can be a "foo[i .. j]" expression for constant i and j.
+func (q *checker) bcheckSliceLengthAtLeast(x *a.Expr, n *big.Int) error {
+	if x.Operator() == t.IDDotDot {
+		i, j := big.NewInt(0), x.RHS().AsExpr()
+		if mhs := x.MHS().AsExpr(); mhs != nil {
+			i = mhs.ConstValue()
+		}
+		if (i != nil) && (j != nil) && (j.ConstValue() != nil) {
+			length := big.NewInt(0).Sub(j.ConstValue(), i)
+			if length.Cmp(n) >= 0 {
+				return nil
+			}
+		}
+	}
+
+	nID, err := q.tm.Insert(n.String())
+	if err != nil {
+		return err
+	}
+	nExpr := a.NewExpr(0, 0, 0, nID, nil, nil, nil, nil)
+	nExpr.SetConstValue(n)
+	nExpr.SetMBounds(bounds{n, n})
+	nExpr.SetMType(typeExprIdeal)
+	if err := q.proveBinaryOp(t.IDXBinaryGreaterEq, makeSliceLength(x), nExpr); err == errFailed {
+		return fmt.Errorf("check: could not prove %s.length() >= %v", x.Str(q.tm), n)
+	} else if err != nil {
+		return err
+	}
+	return nil
+}
+
 func (q *checker) canUndoByte(recv *a.Expr) error {
 	for _, x := range q.facts {
 		if x.Operator() != t.IDOpenParen || len(x.Args()) != 0 {
@@ -1133,11 +1196,16 @@ func (q *checker) canUndoByte(recv *a.Expr) error {
 	return fmt.Errorf("check: could not prove %s.can_undo_byte()", recv.Str(q.tm))
 }
 
-func (q *checker) canCopyN32FromHistoryFast(recv *a.Expr, args []*a.Node) error {
+func (q *checker) canCopyN32FromHistoryFast(recv *a.Expr, args []*a.Node, eightByteChunks bool) error {
 	// As per cgen's io-private.h, there are three pre-conditions:
 	//  - n <= this.available()
 	//  - distance > 0
 	//  - distance <= this.history_available()
+	//
+	// For the 8_byte_chunks variant, the first one is instead:
+	//  - (n + 8) <= this.available()
+	// which we prove via n's upper bound and a "this.available() >= c" fact
+	// for some constant c.
 
 	if len(args) != 2 {
 		return fmt.Errorf("check: internal error: inconsistent copy_n_from_history_fast arguments")
@@ -1145,9 +1213,24 @@ func (q *checker) canCopyN32FromHistoryFast(recv *a.Expr, args []*a.Node) error
 	n := args[0].AsArg().Value()
 	distance := args[1].AsArg().Value()
 
+	// Check "(n + 8) <= this.available()".
+	if eightByteChunks {
+		nb := n.MBounds()
+		if nb[1] == nil {
+			return fmt.Errorf("check: internal error: %q has no bounds", n.Str(q.tm))
+		}
+		advance := big.NewInt(0).Add(nb[1], eight)
+		if ok, err := q.optimizeIOMethodAdvance(recv, advance, false); err != nil {
+			return err
+		} else if !ok {
+			return fmt.Errorf("check: could not prove (n + 8) <= %s.available(), for n <= %v",
+				recv.Str(q.tm), nb[1])
+		}
+	}
+
 	// Check "n <= this.available()".
 check0:
-	for {
+	for !eightByteChunks {
 		for _, x := range q.facts {
 			if x.Operator() != t.IDXBinaryLessEq {
 				continue
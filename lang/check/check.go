@@ -94,7 +94,8 @@ func Check(tm *t.Map, files []*a.File, resolveUse func(usePath string) ([]byte,
 		statuses:  map[t.QID]*a.Status{},
 		structs:   map[t.QID]*a.Struct{},
 
-		useBaseNames: map[t.ID]struct{}{},
+		impliedResets: map[t.QQID]*a.Func{},
+		useBaseNames:  map[t.ID]struct{}{},
 
 		builtInSliceFuncs: map[t.QQID]*a.Func{},
 		builtInTableFuncs: map[t.QQID]*a.Func{},
@@ -193,6 +194,10 @@ type Checker struct {
 	statuses  map[t.QID]*a.Status
 	structs   map[t.QID]*a.Struct
 
+	// impliedResets are the reset methods implied by struct declarations. A
+	// struct can replace its implied reset method by declaring its own.
+	impliedResets map[t.QQID]*a.Func
+
 	// useBaseNames are the base names of packages referred to by `use
 	// "foo/bar"` lines. The keys are `bar`, not `"foo/bar"`.
 	useBaseNames map[t.ID]struct{}
@@ -404,13 +409,21 @@ func (c *Checker) checkStructDecl(node *a.Node) error {
 		}
 	}
 
-	// A struct declaration implies a reset method.
+	// A struct declaration implies a reset method, unless the struct declares
+	// its own (and a used package's funcs can precede its structs).
+	if _, ok := c.funcs[t.QQID{qid[0], qid[1], t.IDReset}]; ok {
+		return nil
+	}
 	in := a.NewStruct(0, n.Filename(), n.Line(), t.IDArgs, nil, nil)
 	f := a.NewFunc(a.EffectImpure.AsFlags(), n.Filename(), n.Line(), qid[1], t.IDReset, in, nil, nil, nil)
 	if qid[0] != 0 {
 		f.AsNode().AsRaw().SetPackage(c.tm, qid[0])
 	}
-	return c.checkFuncSignature(f.AsNode())
+	if err := c.checkFuncSignature(f.AsNode()); err != nil {
+		return err
+	}
+	c.impliedResets[f.QQID()] = f
+	return nil
 }
 
 func (c *Checker) checkStructCycles(_ *a.Node) error {
@@ -490,6 +503,16 @@ func (c *Checker) checkFuncSignature(node *a.Node) error {
 		}
 	}
 	setPlaceholderMBoundsMType(n.In().AsNode())
+	if n.Choosy() {
+		if n.Public() || n.Receiver().IsZero() || n.Effect().Coroutine() || (n.CPUArch() != 0) {
+			return &Error{
+				Err: fmt.Errorf("func %s is choosy but is public, has no receiver, "+
+					"has ? effect or has a cpu_arch", n.QQID().Str(c.tm)),
+				Filename: n.Filename(),
+				Line:     n.Line(),
+			}
+		}
+	}
 	if out := n.Out(); out != nil {
 		if n.Effect().Coroutine() && n.Receiver()[0] != t.IDBase {
 			return &Error{
@@ -518,6 +541,21 @@ func (c *Checker) checkFuncSignature(node *a.Node) error {
 	// implicit "return out"?
 
 	qqid := n.QQID()
+	if (qqid[2] == t.IDReset) && (qqid[1] != 0) {
+		if (n.Effect() != a.EffectImpure) || (len(n.In().Fields()) != 0) || (n.Out() != nil) {
+			return &Error{
+				Err:      fmt.Errorf("check: reset method %s must be impure, with no args or return value", qqid.Str(c.tm)),
+				Filename: n.Filename(),
+				Line:     n.Line(),
+			}
+		}
+		// A user-defined reset method replaces the implied one. The
+		// implied one was added by checkStructDecl, an earlier phase.
+		if other := c.impliedResets[qqid]; (other != nil) && (other != n) {
+			delete(c.impliedResets, qqid)
+			delete(c.funcs, qqid)
+		}
+	}
 	if other, ok := c.funcs[qqid]; ok {
 		return &Error{
 			Err:           fmt.Errorf("check: duplicate function %s", qqid.Str(c.tm)),
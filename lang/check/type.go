@@ -57,6 +57,11 @@ func (q *checker) tcheckStatement(n *a.Node) error {
 			return err
 		}
 
+	case a.KChoose:
+		if err := q.tcheckChoose(n.AsChoose()); err != nil {
+			return err
+		}
+
 	case a.KIf:
 		for n := n.AsIf(); n != nil; n = n.ElseIf() {
 			cond := n.Condition()
@@ -240,6 +245,49 @@ func (q *checker) tcheckAssert(n *a.Assert) error {
 	return nil
 }
 
+func (q *checker) tcheckChoose(n *a.Choose) error {
+	recv := q.astFunc.Receiver()
+	f := q.c.funcs[t.QQID{recv[0], recv[1], n.Name()}]
+	if (f == nil) || !f.Choosy() {
+		return fmt.Errorf("check: choose target %q is not a choosy method", n.Name().Str(q.tm))
+	}
+	for _, o := range n.Args() {
+		o := o.AsExpr()
+		g := q.c.funcs[t.QQID{recv[0], recv[1], o.Ident()}]
+		if g == nil {
+			return fmt.Errorf("check: choose argument %q is not a method", o.Ident().Str(q.tm))
+		} else if g.CPUArch() == 0 {
+			return fmt.Errorf("check: choose argument %q does not have a cpu_arch", o.Ident().Str(q.tm))
+		} else if !sameFuncSignature(f, g) {
+			return fmt.Errorf("check: choose argument %q does not match %q's signature",
+				o.Ident().Str(q.tm), n.Name().Str(q.tm))
+		}
+		o.SetMBounds(bounds{zero, zero})
+		o.SetMType(a.NewTypeExpr(t.IDFunc, 0, o.Ident(),
+			a.NewTypeExpr(0, recv[0], recv[1], nil, nil, nil).AsNode(), nil, nil))
+	}
+	return nil
+}
+
+// sameFuncSignature returns whether f and g have the same effect, in-params
+// (including names) and out-param.
+func sameFuncSignature(f *a.Func, g *a.Func) bool {
+	if (f.Effect() != g.Effect()) || !f.Out().Eq(g.Out()) {
+		return false
+	}
+	fArgs, gArgs := f.In().Fields(), g.In().Fields()
+	if len(fArgs) != len(gArgs) {
+		return false
+	}
+	for i := range fArgs {
+		fa, ga := fArgs[i].AsField(), gArgs[i].AsField()
+		if (fa.Name() != ga.Name()) || !fa.XType().Eq(ga.XType()) {
+			return false
+		}
+	}
+	return true
+}
+
 func (q *checker) tcheckEq(lID t.ID, lhs *a.Expr, lTyp *a.TypeExpr, rhs *a.Expr, rTyp *a.TypeExpr) error {
 	if (rTyp.IsIdeal() && lTyp.IsNumType()) ||
 		(rTyp.EqIgnoringRefinements(lTyp)) ||
@@ -536,6 +584,14 @@ func (q *checker) tcheckExprCall(n *a.Expr, depth uint32) error {
 		return fmt.Errorf("check: %q has effect %q but %q has effect %q",
 			n.Str(q.tm), ne, f.QQID().Str(q.tm), fe)
 	}
+	if fa := f.CPUArch(); (fa != 0) && ((q.astFunc == nil) || (fa != q.astFunc.CPUArch())) {
+		return fmt.Errorf("check: %q requires \"choose cpu_arch >= %s\"",
+			n.Str(q.tm), fa.Str(q.tm))
+	}
+	if (f.FuncName() == t.IDReset) &&
+		((f.Receiver()[0] == t.IDBase) || (q.c.impliedResets[f.QQID()] == f)) {
+		n.SetBuiltInReset()
+	}
 
 	genericType1 := (*a.TypeExpr)(nil)
 	genericType2 := (*a.TypeExpr)(nil)
@@ -166,8 +166,9 @@ func (p *parser) parseTopLevelDecl() (*a.Node, error) {
 				return nil, err
 			}
 			if !p.opts.AllowBuiltInNames {
-				switch id1 {
-				case t.IDInitialize, t.IDReset:
+				// A struct may declare its own reset method, replacing the
+				// implied one, but not its own initialize method.
+				if id1 == t.IDInitialize {
 					return nil, fmt.Errorf(`parse: cannot have a method named %q at %s:%d`,
 						id1.Str(p.tm), p.filename, p.line())
 				}
@@ -186,7 +187,7 @@ func (p *parser) parseTopLevelDecl() (*a.Node, error) {
 				return nil, err
 			}
 			out := (*a.TypeExpr)(nil)
-			if p.peek1() != t.IDOpenCurly {
+			if x := p.peek1(); (x != t.IDOpenCurly) && (x != t.IDComma) {
 				out, err = p.parseTypeExpr()
 				if err != nil {
 					return nil, err
@@ -195,6 +196,11 @@ func (p *parser) parseTopLevelDecl() (*a.Node, error) {
 			asserts := []*a.Node(nil)
 			if p.peek1() == t.IDComma {
 				p.src = p.src[1:]
+				chooseFlags, err := p.parseChooseFlags()
+				if err != nil {
+					return nil, err
+				}
+				flags |= chooseFlags
 				asserts, err = p.parseList(t.IDOpenCurly, (*parser).parseAssertNode)
 				if err != nil {
 					return nil, err
@@ -560,6 +566,44 @@ func (p *parser) parseBlock() ([]*a.Node, error) {
 	return nil, fmt.Errorf(`parse: expected "}" at %s:%d`, p.filename, p.line())
 }
 
+// parseChooseFlags parses the optional "choosy" and "choose cpu_arch >= etc"
+// annotations that can precede a func's "pre", "inv" and "post" assertions.
+func (p *parser) parseChooseFlags() (a.Flags, error) {
+	flags := a.Flags(0)
+	for {
+		switch p.peek1() {
+		case t.IDChoosy:
+			p.src = p.src[1:]
+			flags |= a.FlagsChoosy
+
+		case t.IDChoose:
+			p.src = p.src[1:]
+			if (p.peek1() != t.IDCPUArch) || (len(p.src) < 3) || (p.src[1].ID != t.IDGreaterEq) {
+				return 0, fmt.Errorf(`parse: expected "choose cpu_arch >= etc" at %s:%d`,
+					p.filename, p.line())
+			}
+			switch p.src[2].ID {
+			case t.IDX86SSE42:
+				flags |= a.FlagsCPUArchX86SSE42
+			default:
+				return 0, fmt.Errorf(`parse: unrecognized cpu_arch %q at %s:%d`,
+					p.tm.ByID(p.src[2].ID), p.filename, p.line())
+			}
+			p.src = p.src[3:]
+
+		default:
+			return flags, nil
+		}
+
+		if x := p.peek1(); x == t.IDComma {
+			p.src = p.src[1:]
+		} else if x != t.IDOpenCurly {
+			return 0, fmt.Errorf(`parse: expected "," or "{", got %q at %s:%d`,
+				p.tm.ByID(x), p.filename, p.line())
+		}
+	}
+}
+
 func (p *parser) assertsSorted(asserts []*a.Node) error {
 	seenInv, seenPost := false, false
 	for _, a := range asserts {
@@ -678,6 +722,28 @@ func (p *parser) parseStatement1() (*a.Node, error) {
 	case t.IDAssert, t.IDPre, t.IDPost:
 		return p.parseAssertNode()
 
+	case t.IDChoose:
+		p.src = p.src[1:]
+		name, err := p.parseIdent()
+		if err != nil {
+			return nil, err
+		}
+		if x := p.peek1(); x != t.IDEq {
+			got := p.tm.ByID(x)
+			return nil, fmt.Errorf(`parse: expected "=", got %q at %s:%d`, got, p.filename, p.line())
+		}
+		p.src = p.src[1:]
+		if x := p.peek1(); x != t.IDOpenBracket {
+			got := p.tm.ByID(x)
+			return nil, fmt.Errorf(`parse: expected "[", got %q at %s:%d`, got, p.filename, p.line())
+		}
+		p.src = p.src[1:]
+		args, err := p.parseList(t.IDCloseBracket, (*parser).parseChooseArgNode)
+		if err != nil {
+			return nil, err
+		}
+		return a.NewChoose(name, args).AsNode(), nil
+
 	case t.IDBreak, t.IDContinue:
 		p.src = p.src[1:]
 		label, err := p.parseLabel()
@@ -1059,6 +1125,14 @@ func (p *parser) parseIterateBlock(label t.ID, assigns []*a.Node) (*a.Iterate, e
 	return a.NewIterate(label, assigns, length, unroll, asserts, body, elseIterate), nil
 }
 
+func (p *parser) parseChooseArgNode() (*a.Node, error) {
+	name, err := p.parseIdent()
+	if err != nil {
+		return nil, err
+	}
+	return a.NewExpr(0, 0, 0, name, nil, nil, nil, nil).AsNode(), nil
+}
+
 func (p *parser) parseArgNode() (*a.Node, error) {
 	name, err := p.parseIdent()
 	if err != nil {
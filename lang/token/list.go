@@ -374,28 +374,29 @@ const (
 
 	IDAssert     = ID(0xA0)
 	IDBreak      = ID(0xA1)
-	IDConst      = ID(0xA2)
-	IDContinue   = ID(0xA3)
-	IDElse       = ID(0xA4)
-	IDEndwhile   = ID(0xA5)
-	IDFunc       = ID(0xA6)
-	IDIOBind     = ID(0xA7)
-	IDIOLimit    = ID(0xA8)
-	IDIf         = ID(0xA9)
-	IDImplements = ID(0xAA)
-	IDInv        = ID(0xAB)
-	IDIterate    = ID(0xAC)
-	IDPost       = ID(0xAD)
-	IDPre        = ID(0xAE)
-	IDPri        = ID(0xAF)
-	IDPub        = ID(0xB0)
-	IDReturn     = ID(0xB1)
-	IDStruct     = ID(0xB2)
-	IDUse        = ID(0xB3)
-	IDVar        = ID(0xB4)
-	IDVia        = ID(0xB5)
-	IDWhile      = ID(0xB6)
-	IDYield      = ID(0xB7)
+	IDChoose     = ID(0xA2)
+	IDConst      = ID(0xA3)
+	IDContinue   = ID(0xA4)
+	IDElse       = ID(0xA5)
+	IDEndwhile   = ID(0xA6)
+	IDFunc       = ID(0xA7)
+	IDIOBind     = ID(0xA8)
+	IDIOLimit    = ID(0xA9)
+	IDIf         = ID(0xAA)
+	IDImplements = ID(0xAB)
+	IDInv        = ID(0xAC)
+	IDIterate    = ID(0xAD)
+	IDPost       = ID(0xAE)
+	IDPre        = ID(0xAF)
+	IDPri        = ID(0xB0)
+	IDPub        = ID(0xB1)
+	IDReturn     = ID(0xB2)
+	IDStruct     = ID(0xB3)
+	IDUse        = ID(0xB4)
+	IDVar        = ID(0xB5)
+	IDVia        = ID(0xB6)
+	IDWhile      = ID(0xB7)
+	IDYield      = ID(0xB8)
 )
 
 const (
@@ -482,6 +483,7 @@ const (
 	IDTokenReader   = ID(0x128)
 	IDTokenWriter   = ID(0x129)
 	IDUtility       = ID(0x12A)
+	IDX86M128I      = ID(0x12B)
 
 	IDRangeIEU32 = ID(0x130)
 	IDRangeIIU32 = ID(0x131)
@@ -490,6 +492,10 @@ const (
 	IDRectIEU32  = ID(0x134)
 	IDRectIIU32  = ID(0x135)
 
+	IDChoosy   = ID(0x140)
+	IDCPUArch  = ID(0x141)
+	IDX86SSE42 = ID(0x142)
+
 	IDFrameConfig   = ID(0x150)
 	IDImageConfig   = ID(0x151)
 	IDPixelBlend    = ID(0x152)
@@ -521,6 +527,8 @@ const (
 	IDCopyN32FromReader      = ID(0x173)
 	IDCopyN32FromSlice       = ID(0x174)
 
+	IDCopyN32FromHistory8ByteChunksFast = ID(0x175)
+
 	// -------- 0x180 block.
 
 	IDUndoByte = ID(0x180)
@@ -659,6 +667,12 @@ const (
 	IDIO        = ID(0x248)
 	IDLimit     = ID(0x249)
 	IDData      = ID(0x24A)
+
+	IDImm8                 = ID(0x250)
+	IDMakeM128IMultipleU64 = ID(0x251)
+	IDMakeM128ISingleU32   = ID(0x252)
+	IDMakeM128ISlice128    = ID(0x253)
+	IDMakeM128IZeroes      = ID(0x254)
 )
 
 var builtInsByID = [nBuiltInIDs]string{
@@ -734,6 +748,7 @@ var builtInsByID = [nBuiltInIDs]string{
 
 	IDAssert:     "assert",
 	IDBreak:      "break",
+	IDChoose:     "choose",
 	IDConst:      "const",
 	IDContinue:   "continue",
 	IDElse:       "else",
@@ -839,6 +854,7 @@ var builtInsByID = [nBuiltInIDs]string{
 	IDTokenReader:   "token_reader",
 	IDTokenWriter:   "token_writer",
 	IDUtility:       "utility",
+	IDX86M128I:      "x86_m128i",
 
 	IDRangeIEU32: "range_ie_u32",
 	IDRangeIIU32: "range_ii_u32",
@@ -847,6 +863,10 @@ var builtInsByID = [nBuiltInIDs]string{
 	IDRectIEU32:  "rect_ie_u32",
 	IDRectIIU32:  "rect_ii_u32",
 
+	IDChoosy:   "choosy",
+	IDCPUArch:  "cpu_arch",
+	IDX86SSE42: "x86_sse42",
+
 	IDFrameConfig:   "frame_config",
 	IDImageConfig:   "image_config",
 	IDPixelBlend:    "pixel_blend",
@@ -878,6 +898,8 @@ var builtInsByID = [nBuiltInIDs]string{
 	IDCopyN32FromReader:      "copy_n32_from_reader",
 	IDCopyN32FromSlice:       "copy_n32_from_slice",
 
+	IDCopyN32FromHistory8ByteChunksFast: "copy_n32_from_history_8_byte_chunks_fast",
+
 	// -------- 0x180 block.
 
 	IDUndoByte: "undo_byte",
@@ -1012,6 +1034,12 @@ var builtInsByID = [nBuiltInIDs]string{
 	IDIO:        "io",
 	IDLimit:     "limit",
 	IDData:      "data",
+
+	IDImm8:                 "imm8",
+	IDMakeM128IMultipleU64: "make_m128i_multiple_u64",
+	IDMakeM128ISingleU32:   "make_m128i_single_u32",
+	IDMakeM128ISlice128:    "make_m128i_slice128",
+	IDMakeM128IZeroes:      "make_m128i_zeroes",
 }
 
 var builtInsByName = map[string]ID{}
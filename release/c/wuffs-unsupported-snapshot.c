@@ -4138,6 +4138,11 @@ WUFFS_BASE__MAYBE_STATIC uint32_t  //
 wuffs_adler32__hasher__update_u32(wuffs_adler32__hasher* self,
                                   wuffs_base__slice_u8 a_x);
 
+WUFFS_BASE__MAYBE_STATIC WUFFS_BASE__POTENTIALLY_UNUSED uint32_t  //
+wuffs_adler32__combine(uint32_t a_adler_a,
+                       uint32_t a_adler_b,
+                       uint64_t a_length_b);
+
 // ---------------- Struct Definitions
 
 // These structs' fields, and the sizeof them, are private implementation
@@ -4164,6 +4169,9 @@ struct wuffs_adler32__hasher__struct {
     uint32_t f_state;
     bool f_started;
 
+    wuffs_base__empty_struct (*choosy_up)(wuffs_adler32__hasher* self,
+                                          wuffs_base__slice_u8 a_x);
+
   } private_impl;
 
 #ifdef __cplusplus
@@ -4522,6 +4530,9 @@ extern "C" {
 
 // ---------------- Struct Declarations
 
+typedef struct wuffs_crc32__castagnoli_hasher__struct
+    wuffs_crc32__castagnoli_hasher;
+
 typedef struct wuffs_crc32__ieee_hasher__struct wuffs_crc32__ieee_hasher;
 
 // ---------------- Public Initializer Prototypes
@@ -4532,6 +4543,15 @@ typedef struct wuffs_crc32__ieee_hasher__struct wuffs_crc32__ieee_hasher;
 // Pass sizeof(*self) and WUFFS_VERSION for sizeof_star_self and wuffs_version.
 // Pass 0 (or some combination of WUFFS_INITIALIZE__XXX) for initialize_flags.
 
+wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT  //
+wuffs_crc32__castagnoli_hasher__initialize(wuffs_crc32__castagnoli_hasher* self,
+                                           size_t sizeof_star_self,
+                                           uint64_t wuffs_version,
+                                           uint32_t initialize_flags);
+
+size_t  //
+sizeof__wuffs_crc32__castagnoli_hasher();
+
 wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT  //
 wuffs_crc32__ieee_hasher__initialize(wuffs_crc32__ieee_hasher* self,
                                      size_t sizeof_star_self,
@@ -4543,6 +4563,12 @@ sizeof__wuffs_crc32__ieee_hasher();
 
 // ---------------- Upcasts
 
+static inline wuffs_base__hasher_u32*  //
+wuffs_crc32__castagnoli_hasher__upcast_as__wuffs_base__hasher_u32(
+    wuffs_crc32__castagnoli_hasher* p) {
+  return (wuffs_base__hasher_u32*)p;
+}
+
 static inline wuffs_base__hasher_u32*  //
 wuffs_crc32__ieee_hasher__upcast_as__wuffs_base__hasher_u32(
     wuffs_crc32__ieee_hasher* p) {
@@ -4551,10 +4577,19 @@ wuffs_crc32__ieee_hasher__upcast_as__wuffs_base__hasher_u32(
 
 // ---------------- Public Function Prototypes
 
+WUFFS_BASE__MAYBE_STATIC uint32_t  //
+wuffs_crc32__castagnoli_hasher__update_u32(wuffs_crc32__castagnoli_hasher* self,
+                                           wuffs_base__slice_u8 a_x);
+
 WUFFS_BASE__MAYBE_STATIC uint32_t  //
 wuffs_crc32__ieee_hasher__update_u32(wuffs_crc32__ieee_hasher* self,
                                      wuffs_base__slice_u8 a_x);
 
+WUFFS_BASE__MAYBE_STATIC WUFFS_BASE__POTENTIALLY_UNUSED uint32_t  //
+wuffs_crc32__ieee_combine(uint32_t a_crc_a,
+                          uint32_t a_crc_b,
+                          uint64_t a_length_b);
+
 // ---------------- Struct Definitions
 
 // These structs' fields, and the sizeof them, are private implementation
@@ -4564,6 +4599,79 @@ wuffs_crc32__ieee_hasher__update_u32(wuffs_crc32__ieee_hasher* self,
 
 #if defined(__cplusplus) || defined(WUFFS_IMPLEMENTATION)
 
+struct wuffs_crc32__castagnoli_hasher__struct {
+  // Do not access the private_impl's or private_data's fields directly. There
+  // is no API/ABI compatibility or safety guarantee if you do so. Instead, use
+  // the wuffs_foo__bar__baz functions.
+  //
+  // It is a struct, not a struct*, so that the outermost wuffs_foo__bar struct
+  // can be stack allocated when WUFFS_IMPLEMENTATION is defined.
+
+  struct {
+    uint32_t magic;
+    uint32_t active_coroutine;
+    wuffs_base__vtable vtable_for__wuffs_base__hasher_u32;
+    wuffs_base__vtable null_vtable;
+
+    uint32_t f_state;
+
+    wuffs_base__empty_struct (*choosy_up)(wuffs_crc32__castagnoli_hasher* self,
+                                          wuffs_base__slice_u8 a_x);
+
+  } private_impl;
+
+#ifdef __cplusplus
+#if (__cplusplus >= 201103L) && !defined(WUFFS_IMPLEMENTATION)
+  // Disallow constructing or copying an object via standard C++ mechanisms,
+  // e.g. the "new" operator, as this struct is intentionally opaque. Its total
+  // size and field layout is not part of the public, stable, memory-safe API.
+  // Use malloc or memcpy and the sizeof__wuffs_foo__bar function instead, and
+  // call wuffs_foo__bar__baz methods (which all take a "this"-like pointer as
+  // their first argument) rather than tweaking bar.private_impl.qux fields.
+  //
+  // In C, we can just leave wuffs_foo__bar as an incomplete type (unless
+  // WUFFS_IMPLEMENTATION is #define'd). In C++, we define a complete type in
+  // order to provide convenience methods. These forward on "this", so that you
+  // can write "bar->baz(etc)" instead of "wuffs_foo__bar__baz(bar, etc)".
+  wuffs_crc32__castagnoli_hasher__struct() = delete;
+  wuffs_crc32__castagnoli_hasher__struct(
+      const wuffs_crc32__castagnoli_hasher__struct&) = delete;
+  wuffs_crc32__castagnoli_hasher__struct& operator=(
+      const wuffs_crc32__castagnoli_hasher__struct&) = delete;
+
+  // As above, the size of the struct is not part of the public API, and unless
+  // WUFFS_IMPLEMENTATION is #define'd, this struct type T should be heap
+  // allocated, not stack allocated. Its size is not intended to be known at
+  // compile time, but it is unfortunately divulged as a side effect of
+  // defining C++ convenience methods. Use "sizeof__T()", calling the function,
+  // instead of "sizeof T", invoking the operator. To make the two values
+  // different, so that passing the latter will be rejected by the initialize
+  // function, we add an arbitrary amount of dead weight.
+  uint8_t dead_weight[123000000];  // 123 MB.
+#endif  // (__cplusplus >= 201103L) && !defined(WUFFS_IMPLEMENTATION)
+
+  inline wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT  //
+  initialize(size_t sizeof_star_self,
+             uint64_t wuffs_version,
+             uint32_t initialize_flags) {
+    return wuffs_crc32__castagnoli_hasher__initialize(
+        this, sizeof_star_self, wuffs_version, initialize_flags);
+  }
+
+  inline wuffs_base__hasher_u32*  //
+  upcast_as__wuffs_base__hasher_u32() {
+    return (wuffs_base__hasher_u32*)this;
+  }
+
+  inline uint32_t  //
+  update_u32(wuffs_base__slice_u8 a_x) {
+    return wuffs_crc32__castagnoli_hasher__update_u32(this, a_x);
+  }
+
+#endif  // __cplusplus
+
+};  // struct wuffs_crc32__castagnoli_hasher__struct
+
 struct wuffs_crc32__ieee_hasher__struct {
   // Do not access the private_impl's or private_data's fields directly. There
   // is no API/ABI compatibility or safety guarantee if you do so. Instead, use
@@ -4580,6 +4688,9 @@ struct wuffs_crc32__ieee_hasher__struct {
 
     uint32_t f_state;
 
+    wuffs_base__empty_struct (*choosy_up)(wuffs_crc32__ieee_hasher* self,
+                                          wuffs_base__slice_u8 a_x);
+
   } private_impl;
 
 #ifdef __cplusplus
@@ -4646,6 +4757,7 @@ extern "C" {
 
 // ---------------- Status Codes
 
+extern const char* wuffs_deflate__note__block_boundary;
 extern const char* wuffs_deflate__error__bad_huffman_code_over_subscribed;
 extern const char* wuffs_deflate__error__bad_huffman_code_under_subscribed;
 extern const char* wuffs_deflate__error__bad_huffman_code_length_count;
@@ -4662,12 +4774,46 @@ extern const char* wuffs_deflate__error__no_huffman_codes;
 
 // ---------------- Public Consts
 
-#define WUFFS_DEFLATE__DECODER_WORKBUF_LEN_MAX_INCL_WORST_CASE 1
+#define WUFFS_DEFLATE__DECODER_WORKBUF_LEN_MAX_INCL_WORST_CASE 33025
+
+#define WUFFS_DEFLATE__STATS_KEY_NUM_STORED_BLOCKS 0
+
+#define WUFFS_DEFLATE__STATS_KEY_NUM_FIXED_BLOCKS 1
+
+#define WUFFS_DEFLATE__STATS_KEY_NUM_DYNAMIC_BLOCKS 2
+
+#define WUFFS_DEFLATE__STATS_KEY_NUM_STORED_BYTES 3
+
+#define WUFFS_DEFLATE__STATS_KEY_NUM_FAST_BYTES 4
+
+#define WUFFS_DEFLATE__STATS_KEY_NUM_SLOW_BYTES 5
+
+#define WUFFS_DEFLATE__STATS_KEY_NUM_LITERALS 6
+
+#define WUFFS_DEFLATE__STATS_KEY_NUM_MATCHES 7
+
+#define WUFFS_DEFLATE__STATS_KEY_NUM_MATCH_BYTES 8
+
+#define WUFFS_DEFLATE__STATS_KEY_NUM_HUFFMAN_TABLE_INITS 9
+
+#define WUFFS_DEFLATE__STATS_KEY_NUM_TAIL_BYTES 10
+
+#define WUFFS_DEFLATE__STATS_KEY_MATCH_LENGTHS 16
+
+#define WUFFS_DEFLATE__STATS_KEY_MATCH_DISTANCES 272
+
+#define WUFFS_DEFLATE__STATS_KEY_END 288
+
+#define WUFFS_DEFLATE__ENCODER_WORKBUF_LEN_MAX_INCL_WORST_CASE 0
+
+#define WUFFS_DEFLATE__DEFAULT_LEVEL 6
 
 // ---------------- Struct Declarations
 
 typedef struct wuffs_deflate__decoder__struct wuffs_deflate__decoder;
 
+typedef struct wuffs_deflate__encoder__struct wuffs_deflate__encoder;
+
 // ---------------- Public Initializer Prototypes
 
 // For any given "wuffs_foo__bar* self", "wuffs_foo__bar__initialize(self,
@@ -4685,6 +4831,15 @@ wuffs_deflate__decoder__initialize(wuffs_deflate__decoder* self,
 size_t  //
 sizeof__wuffs_deflate__decoder();
 
+wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT  //
+wuffs_deflate__encoder__initialize(wuffs_deflate__encoder* self,
+                                   size_t sizeof_star_self,
+                                   uint64_t wuffs_version,
+                                   uint32_t initialize_flags);
+
+size_t  //
+sizeof__wuffs_deflate__encoder();
+
 // ---------------- Upcasts
 
 static inline wuffs_base__io_transformer*  //
@@ -4693,11 +4848,50 @@ wuffs_deflate__decoder__upcast_as__wuffs_base__io_transformer(
   return (wuffs_base__io_transformer*)p;
 }
 
+static inline wuffs_base__io_transformer*  //
+wuffs_deflate__encoder__upcast_as__wuffs_base__io_transformer(
+    wuffs_deflate__encoder* p) {
+  return (wuffs_base__io_transformer*)p;
+}
+
 // ---------------- Public Function Prototypes
 
 WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_deflate__decoder__reset(wuffs_deflate__decoder* self);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
 wuffs_deflate__decoder__add_history(wuffs_deflate__decoder* self,
-                                    wuffs_base__slice_u8 a_hist);
+                                    wuffs_base__slice_u8 a_hist,
+                                    wuffs_base__slice_u8 a_workbuf);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_deflate__decoder__set_whole_output_in_dst(wuffs_deflate__decoder* self,
+                                                bool a_w);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_deflate__decoder__set_report_block_boundaries(
+    wuffs_deflate__decoder* self,
+    bool a_r);
+
+WUFFS_BASE__MAYBE_STATIC uint64_t  //
+wuffs_deflate__decoder__block_boundary_bit_position(
+    const wuffs_deflate__decoder* self);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_deflate__decoder__set_initial_bit_offset(wuffs_deflate__decoder* self,
+                                               uint32_t a_o);
+
+WUFFS_BASE__MAYBE_STATIC uint64_t  //
+wuffs_deflate__decoder__num_reused_lcode_tables(
+    const wuffs_deflate__decoder* self);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_deflate__decoder__set_collect_stats(wuffs_deflate__decoder* self,
+                                          bool a_c);
+
+WUFFS_BASE__MAYBE_STATIC uint64_t  //
+wuffs_deflate__decoder__stats(const wuffs_deflate__decoder* self,
+                              uint32_t a_key);
 
 WUFFS_BASE__MAYBE_STATIC wuffs_base__range_ii_u64  //
 wuffs_deflate__decoder__workbuf_len(const wuffs_deflate__decoder* self);
@@ -4708,6 +4902,18 @@ wuffs_deflate__decoder__transform_io(wuffs_deflate__decoder* self,
                                      wuffs_base__io_buffer* a_src,
                                      wuffs_base__slice_u8 a_workbuf);
 
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_deflate__encoder__set_level(wuffs_deflate__encoder* self, uint32_t a_l);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__range_ii_u64  //
+wuffs_deflate__encoder__workbuf_len(const wuffs_deflate__encoder* self);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_deflate__encoder__transform_io(wuffs_deflate__encoder* self,
+                                     wuffs_base__io_buffer* a_dst,
+                                     wuffs_base__io_buffer* a_src,
+                                     wuffs_base__slice_u8 a_workbuf);
+
 // ---------------- Struct Definitions
 
 // These structs' fields, and the sizeof them, are private implementation
@@ -4734,7 +4940,16 @@ struct wuffs_deflate__decoder__struct {
     uint32_t f_bits;
     uint32_t f_n_bits;
     uint32_t f_history_index;
+    bool f_whole_output_in_dst;
+    uint32_t f_n_output_since_reset;
+    uint64_t f_dst_history_floor;
+    bool f_report_block_boundaries;
+    uint64_t f_boundary_bit_position;
+    uint32_t f_n_initial_bits_to_skip;
+    bool f_collect_stats;
     uint32_t f_n_huffs_bits[2];
+    uint32_t f_prev_n_lit;
+    uint64_t f_n_reused_lcode_tables;
     bool f_end_of_block;
 
     uint32_t p_transform_io[1];
@@ -4746,8 +4961,9 @@ struct wuffs_deflate__decoder__struct {
 
   struct {
     uint32_t f_huffs[2][1024];
-    uint8_t f_history[33025];
     uint8_t f_code_lengths[320];
+    uint8_t f_prev_lcode_lengths[288];
+    uint64_t f_stats_counts[288];
 
     struct {
       uint32_t v_final;
@@ -4782,6 +4998,7 @@ struct wuffs_deflate__decoder__struct {
       uint32_t v_dist_minus_1;
       uint32_t v_hlen;
       uint32_t v_hdist;
+      bool v_collect_stats;
       uint64_t scratch;
     } s_decode_huffman_slow[1];
   } private_data;
@@ -4830,8 +5047,48 @@ struct wuffs_deflate__decoder__struct {
   }
 
   inline wuffs_base__empty_struct  //
-  add_history(wuffs_base__slice_u8 a_hist) {
-    return wuffs_deflate__decoder__add_history(this, a_hist);
+  reset() {
+    return wuffs_deflate__decoder__reset(this);
+  }
+
+  inline wuffs_base__status  //
+  add_history(wuffs_base__slice_u8 a_hist, wuffs_base__slice_u8 a_workbuf) {
+    return wuffs_deflate__decoder__add_history(this, a_hist, a_workbuf);
+  }
+
+  inline wuffs_base__empty_struct  //
+  set_whole_output_in_dst(bool a_w) {
+    return wuffs_deflate__decoder__set_whole_output_in_dst(this, a_w);
+  }
+
+  inline wuffs_base__empty_struct  //
+  set_report_block_boundaries(bool a_r) {
+    return wuffs_deflate__decoder__set_report_block_boundaries(this, a_r);
+  }
+
+  inline uint64_t  //
+  block_boundary_bit_position() const {
+    return wuffs_deflate__decoder__block_boundary_bit_position(this);
+  }
+
+  inline wuffs_base__empty_struct  //
+  set_initial_bit_offset(uint32_t a_o) {
+    return wuffs_deflate__decoder__set_initial_bit_offset(this, a_o);
+  }
+
+  inline uint64_t  //
+  num_reused_lcode_tables() const {
+    return wuffs_deflate__decoder__num_reused_lcode_tables(this);
+  }
+
+  inline wuffs_base__empty_struct  //
+  set_collect_stats(bool a_c) {
+    return wuffs_deflate__decoder__set_collect_stats(this, a_c);
+  }
+
+  inline uint64_t  //
+  stats(uint32_t a_key) const {
+    return wuffs_deflate__decoder__stats(this, a_key);
   }
 
   inline wuffs_base__range_ii_u64  //
@@ -4850,6 +5107,143 @@ struct wuffs_deflate__decoder__struct {
 
 };  // struct wuffs_deflate__decoder__struct
 
+struct wuffs_deflate__encoder__struct {
+  // Do not access the private_impl's or private_data's fields directly. There
+  // is no API/ABI compatibility or safety guarantee if you do so. Instead, use
+  // the wuffs_foo__bar__baz functions.
+  //
+  // It is a struct, not a struct*, so that the outermost wuffs_foo__bar struct
+  // can be stack allocated when WUFFS_IMPLEMENTATION is defined.
+
+  struct {
+    uint32_t magic;
+    uint32_t active_coroutine;
+    wuffs_base__vtable vtable_for__wuffs_base__io_transformer;
+    wuffs_base__vtable null_vtable;
+
+    uint32_t f_level_plus_1;
+    bool f_lazy;
+    uint32_t f_max_chain;
+    uint32_t f_nice_len;
+    uint32_t f_max_lazy;
+    uint32_t f_good_len;
+    uint32_t f_pos;
+    uint32_t f_wend;
+    uint32_t f_block_start;
+    bool f_block_start_valid;
+    bool f_match_available;
+    uint32_t f_prev_len;
+    uint32_t f_prev_dist;
+    uint32_t f_n_tokens;
+    uint64_t f_bits;
+    uint32_t f_n_bits;
+    uint32_t f_n_cl_tokens;
+
+    uint32_t p_transform_io[1];
+    uint32_t p_write_block[1];
+    uint32_t p_flush_bits[1];
+    uint32_t p_write_dynamic_header[1];
+  } private_impl;
+
+  struct {
+    uint8_t f_window[65800];
+    uint16_t f_head[32768];
+    uint16_t f_prev[32768];
+    uint32_t f_tokens[16384];
+    uint32_t f_freqs[3][288];
+    uint8_t f_lens[3][288];
+    uint32_t f_codes[3][288];
+    uint32_t f_sorted[512];
+    uint32_t f_depths[512];
+    uint32_t f_cl_tokens[320];
+
+    struct {
+      uint32_t v_level;
+      uint32_t v_wmax;
+      bool v_final;
+    } s_transform_io[1];
+    struct {
+      uint32_t v_hlit;
+      uint32_t v_hdist;
+      uint32_t v_hclen;
+      uint32_t v_block_end;
+      uint32_t v_i;
+      uint32_t v_n;
+      uint32_t v_remaining;
+      uint32_t v_tok;
+    } s_write_block[1];
+    struct {
+      uint64_t scratch;
+    } s_flush_bits[1];
+    struct {
+      uint32_t v_i;
+    } s_write_dynamic_header[1];
+  } private_data;
+
+#ifdef __cplusplus
+#if (__cplusplus >= 201103L) && !defined(WUFFS_IMPLEMENTATION)
+  // Disallow constructing or copying an object via standard C++ mechanisms,
+  // e.g. the "new" operator, as this struct is intentionally opaque. Its total
+  // size and field layout is not part of the public, stable, memory-safe API.
+  // Use malloc or memcpy and the sizeof__wuffs_foo__bar function instead, and
+  // call wuffs_foo__bar__baz methods (which all take a "this"-like pointer as
+  // their first argument) rather than tweaking bar.private_impl.qux fields.
+  //
+  // In C, we can just leave wuffs_foo__bar as an incomplete type (unless
+  // WUFFS_IMPLEMENTATION is #define'd). In C++, we define a complete type in
+  // order to provide convenience methods. These forward on "this", so that you
+  // can write "bar->baz(etc)" instead of "wuffs_foo__bar__baz(bar, etc)".
+  wuffs_deflate__encoder__struct() = delete;
+  wuffs_deflate__encoder__struct(const wuffs_deflate__encoder__struct&) =
+      delete;
+  wuffs_deflate__encoder__struct& operator=(
+      const wuffs_deflate__encoder__struct&) = delete;
+
+  // As above, the size of the struct is not part of the public API, and unless
+  // WUFFS_IMPLEMENTATION is #define'd, this struct type T should be heap
+  // allocated, not stack allocated. Its size is not intended to be known at
+  // compile time, but it is unfortunately divulged as a side effect of
+  // defining C++ convenience methods. Use "sizeof__T()", calling the function,
+  // instead of "sizeof T", invoking the operator. To make the two values
+  // different, so that passing the latter will be rejected by the initialize
+  // function, we add an arbitrary amount of dead weight.
+  uint8_t dead_weight[123000000];  // 123 MB.
+#endif  // (__cplusplus >= 201103L) && !defined(WUFFS_IMPLEMENTATION)
+
+  inline wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT  //
+  initialize(size_t sizeof_star_self,
+             uint64_t wuffs_version,
+             uint32_t initialize_flags) {
+    return wuffs_deflate__encoder__initialize(this, sizeof_star_self,
+                                              wuffs_version, initialize_flags);
+  }
+
+  inline wuffs_base__io_transformer*  //
+  upcast_as__wuffs_base__io_transformer() {
+    return (wuffs_base__io_transformer*)this;
+  }
+
+  inline wuffs_base__empty_struct  //
+  set_level(uint32_t a_l) {
+    return wuffs_deflate__encoder__set_level(this, a_l);
+  }
+
+  inline wuffs_base__range_ii_u64  //
+  workbuf_len() const {
+    return wuffs_deflate__encoder__workbuf_len(this);
+  }
+
+  inline wuffs_base__status  //
+  transform_io(wuffs_base__io_buffer* a_dst,
+               wuffs_base__io_buffer* a_src,
+               wuffs_base__slice_u8 a_workbuf) {
+    return wuffs_deflate__encoder__transform_io(this, a_dst, a_src, a_workbuf);
+  }
+
+#endif  // __cplusplus
+
+};  // struct wuffs_deflate__encoder__struct
+
 #endif  // defined(__cplusplus) || defined(WUFFS_IMPLEMENTATION)
 
 #ifdef __cplusplus
@@ -4863,15 +5257,20 @@ extern "C" {
 // ---------------- Status Codes
 
 extern const char* wuffs_lzw__error__bad_code;
+extern const char* wuffs_lzw__error__bad_input_byte;
 
 // ---------------- Public Consts
 
 #define WUFFS_LZW__DECODER_WORKBUF_LEN_MAX_INCL_WORST_CASE 0
 
+#define WUFFS_LZW__ENCODER_WORKBUF_LEN_MAX_INCL_WORST_CASE 0
+
 // ---------------- Struct Declarations
 
 typedef struct wuffs_lzw__decoder__struct wuffs_lzw__decoder;
 
+typedef struct wuffs_lzw__encoder__struct wuffs_lzw__encoder;
+
 // ---------------- Public Initializer Prototypes
 
 // For any given "wuffs_foo__bar* self", "wuffs_foo__bar__initialize(self,
@@ -4889,6 +5288,15 @@ wuffs_lzw__decoder__initialize(wuffs_lzw__decoder* self,
 size_t  //
 sizeof__wuffs_lzw__decoder();
 
+wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT  //
+wuffs_lzw__encoder__initialize(wuffs_lzw__encoder* self,
+                               size_t sizeof_star_self,
+                               uint64_t wuffs_version,
+                               uint32_t initialize_flags);
+
+size_t  //
+sizeof__wuffs_lzw__encoder();
+
 // ---------------- Upcasts
 
 static inline wuffs_base__io_transformer*  //
@@ -4897,6 +5305,12 @@ wuffs_lzw__decoder__upcast_as__wuffs_base__io_transformer(
   return (wuffs_base__io_transformer*)p;
 }
 
+static inline wuffs_base__io_transformer*  //
+wuffs_lzw__encoder__upcast_as__wuffs_base__io_transformer(
+    wuffs_lzw__encoder* p) {
+  return (wuffs_base__io_transformer*)p;
+}
+
 // ---------------- Public Function Prototypes
 
 WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
@@ -4914,9 +5328,24 @@ wuffs_lzw__decoder__transform_io(wuffs_lzw__decoder* self,
 WUFFS_BASE__MAYBE_STATIC wuffs_base__slice_u8  //
 wuffs_lzw__decoder__flush(wuffs_lzw__decoder* self);
 
-// ---------------- Struct Definitions
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_lzw__encoder__set_literal_width(wuffs_lzw__encoder* self, uint32_t a_lw);
 
-// These structs' fields, and the sizeof them, are private implementation
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_lzw__encoder__close_input(wuffs_lzw__encoder* self);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__range_ii_u64  //
+wuffs_lzw__encoder__workbuf_len(const wuffs_lzw__encoder* self);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_lzw__encoder__transform_io(wuffs_lzw__encoder* self,
+                                 wuffs_base__io_buffer* a_dst,
+                                 wuffs_base__io_buffer* a_src,
+                                 wuffs_base__slice_u8 a_workbuf);
+
+// ---------------- Struct Definitions
+
+// These structs' fields, and the sizeof them, are private implementation
 // details that aren't guaranteed to be stable across Wuffs versions.
 //
 // See https://en.wikipedia.org/wiki/Opaque_pointer#C
@@ -4956,9 +5385,9 @@ struct wuffs_lzw__decoder__struct {
   } private_impl;
 
   struct {
-    uint8_t f_suffixes[4096][8];
+    uint8_t f_suffixes[4096][16];
     uint16_t f_lm1s[4096];
-    uint8_t f_output[8199];
+    uint8_t f_output[8207];
 
   } private_data;
 
@@ -5030,6 +5459,112 @@ struct wuffs_lzw__decoder__struct {
 
 };  // struct wuffs_lzw__decoder__struct
 
+struct wuffs_lzw__encoder__struct {
+  // Do not access the private_impl's or private_data's fields directly. There
+  // is no API/ABI compatibility or safety guarantee if you do so. Instead, use
+  // the wuffs_foo__bar__baz functions.
+  //
+  // It is a struct, not a struct*, so that the outermost wuffs_foo__bar struct
+  // can be stack allocated when WUFFS_IMPLEMENTATION is defined.
+
+  struct {
+    uint32_t magic;
+    uint32_t active_coroutine;
+    wuffs_base__vtable vtable_for__wuffs_base__io_transformer;
+    wuffs_base__vtable null_vtable;
+
+    uint32_t f_set_literal_width_arg;
+    bool f_input_closed;
+    uint32_t f_literal_width;
+    uint32_t f_clear_code;
+    uint32_t f_end_code;
+    bool f_has_code;
+    uint32_t f_code;
+    uint32_t f_hi;
+    uint32_t f_width;
+    uint64_t f_bits;
+    uint32_t f_n_bits;
+
+    uint32_t p_transform_io[1];
+    uint32_t p_flush_bits[1];
+  } private_impl;
+
+  struct {
+    uint32_t f_hash_table[8192];
+
+    struct {
+      uint64_t scratch;
+    } s_flush_bits[1];
+  } private_data;
+
+#ifdef __cplusplus
+#if (__cplusplus >= 201103L) && !defined(WUFFS_IMPLEMENTATION)
+  // Disallow constructing or copying an object via standard C++ mechanisms,
+  // e.g. the "new" operator, as this struct is intentionally opaque. Its total
+  // size and field layout is not part of the public, stable, memory-safe API.
+  // Use malloc or memcpy and the sizeof__wuffs_foo__bar function instead, and
+  // call wuffs_foo__bar__baz methods (which all take a "this"-like pointer as
+  // their first argument) rather than tweaking bar.private_impl.qux fields.
+  //
+  // In C, we can just leave wuffs_foo__bar as an incomplete type (unless
+  // WUFFS_IMPLEMENTATION is #define'd). In C++, we define a complete type in
+  // order to provide convenience methods. These forward on "this", so that you
+  // can write "bar->baz(etc)" instead of "wuffs_foo__bar__baz(bar, etc)".
+  wuffs_lzw__encoder__struct() = delete;
+  wuffs_lzw__encoder__struct(const wuffs_lzw__encoder__struct&) = delete;
+  wuffs_lzw__encoder__struct& operator=(const wuffs_lzw__encoder__struct&) =
+      delete;
+
+  // As above, the size of the struct is not part of the public API, and unless
+  // WUFFS_IMPLEMENTATION is #define'd, this struct type T should be heap
+  // allocated, not stack allocated. Its size is not intended to be known at
+  // compile time, but it is unfortunately divulged as a side effect of
+  // defining C++ convenience methods. Use "sizeof__T()", calling the function,
+  // instead of "sizeof T", invoking the operator. To make the two values
+  // different, so that passing the latter will be rejected by the initialize
+  // function, we add an arbitrary amount of dead weight.
+  uint8_t dead_weight[123000000];  // 123 MB.
+#endif  // (__cplusplus >= 201103L) && !defined(WUFFS_IMPLEMENTATION)
+
+  inline wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT  //
+  initialize(size_t sizeof_star_self,
+             uint64_t wuffs_version,
+             uint32_t initialize_flags) {
+    return wuffs_lzw__encoder__initialize(this, sizeof_star_self, wuffs_version,
+                                          initialize_flags);
+  }
+
+  inline wuffs_base__io_transformer*  //
+  upcast_as__wuffs_base__io_transformer() {
+    return (wuffs_base__io_transformer*)this;
+  }
+
+  inline wuffs_base__empty_struct  //
+  set_literal_width(uint32_t a_lw) {
+    return wuffs_lzw__encoder__set_literal_width(this, a_lw);
+  }
+
+  inline wuffs_base__empty_struct  //
+  close_input() {
+    return wuffs_lzw__encoder__close_input(this);
+  }
+
+  inline wuffs_base__range_ii_u64  //
+  workbuf_len() const {
+    return wuffs_lzw__encoder__workbuf_len(this);
+  }
+
+  inline wuffs_base__status  //
+  transform_io(wuffs_base__io_buffer* a_dst,
+               wuffs_base__io_buffer* a_src,
+               wuffs_base__slice_u8 a_workbuf) {
+    return wuffs_lzw__encoder__transform_io(this, a_dst, a_src, a_workbuf);
+  }
+
+#endif  // __cplusplus
+
+};  // struct wuffs_lzw__encoder__struct
+
 #endif  // defined(__cplusplus) || defined(WUFFS_IMPLEMENTATION)
 
 #ifdef __cplusplus
@@ -5049,11 +5584,18 @@ extern const char* wuffs_gif__error__bad_graphic_control;
 extern const char* wuffs_gif__error__bad_header;
 extern const char* wuffs_gif__error__bad_literal_width;
 extern const char* wuffs_gif__error__bad_palette;
+extern const char* wuffs_gif__error__unsupported_pixel_format;
 
 // ---------------- Public Consts
 
 #define WUFFS_GIF__DECODER_WORKBUF_LEN_MAX_INCL_WORST_CASE 0
 
+#define WUFFS_GIF__FRAME_INDEX_ENTRY_LENGTH 20
+
+#define WUFFS_GIF__FRAME_INDEX_FLAG_LOCAL_PALETTE 1
+
+#define WUFFS_GIF__FRAME_INDEX_FLAG_OPAQUE_WITHIN_BOUNDS 2
+
 #define WUFFS_GIF__QUIRK_DELAY_NUM_DECODED_FRAMES 1041635328
 
 #define WUFFS_GIF__QUIRK_FIRST_FRAME_LOCAL_PALETTE_MEANS_BLACK_BACKGROUND \
@@ -5075,6 +5617,8 @@ typedef struct wuffs_gif__config_decoder__struct wuffs_gif__config_decoder;
 
 typedef struct wuffs_gif__decoder__struct wuffs_gif__decoder;
 
+typedef struct wuffs_gif__encoder__struct wuffs_gif__encoder;
+
 // ---------------- Public Initializer Prototypes
 
 // For any given "wuffs_foo__bar* self", "wuffs_foo__bar__initialize(self,
@@ -5101,6 +5645,15 @@ wuffs_gif__decoder__initialize(wuffs_gif__decoder* self,
 size_t  //
 sizeof__wuffs_gif__decoder();
 
+wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT  //
+wuffs_gif__encoder__initialize(wuffs_gif__encoder* self,
+                               size_t sizeof_star_self,
+                               uint64_t wuffs_version,
+                               uint32_t initialize_flags);
+
+size_t  //
+sizeof__wuffs_gif__encoder();
+
 // ---------------- Upcasts
 
 static inline wuffs_base__image_decoder*  //
@@ -5168,6 +5721,11 @@ wuffs_gif__config_decoder__restart_frame(wuffs_gif__config_decoder* self,
                                          uint64_t a_index,
                                          uint64_t a_io_position);
 
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_gif__config_decoder__decode_frame_index(wuffs_gif__config_decoder* self,
+                                              wuffs_base__io_buffer* a_dst,
+                                              wuffs_base__io_buffer* a_src);
+
 WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
 wuffs_gif__config_decoder__decode_frame_config(wuffs_gif__config_decoder* self,
                                                wuffs_base__frame_config* a_dst,
@@ -5227,6 +5785,11 @@ wuffs_gif__decoder__restart_frame(wuffs_gif__decoder* self,
                                   uint64_t a_index,
                                   uint64_t a_io_position);
 
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_gif__decoder__decode_frame_index(wuffs_gif__decoder* self,
+                                       wuffs_base__io_buffer* a_dst,
+                                       wuffs_base__io_buffer* a_src);
+
 WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
 wuffs_gif__decoder__decode_frame_config(wuffs_gif__decoder* self,
                                         wuffs_base__frame_config* a_dst,
@@ -5240,6 +5803,20 @@ wuffs_gif__decoder__decode_frame(wuffs_gif__decoder* self,
                                  wuffs_base__slice_u8 a_workbuf,
                                  wuffs_base__decode_frame_options* a_opts);
 
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_gif__encoder__set_num_animation_loops(wuffs_gif__encoder* self,
+                                            uint32_t a_n);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_gif__encoder__encode_frame(wuffs_gif__encoder* self,
+                                 wuffs_base__io_buffer* a_dst,
+                                 wuffs_base__pixel_buffer* a_src,
+                                 uint64_t a_duration);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_gif__encoder__encode_trailer(wuffs_gif__encoder* self,
+                                   wuffs_base__io_buffer* a_dst);
+
 // ---------------- Struct Definitions
 
 // These structs' fields, and the sizeof them, are private implementation
@@ -5303,6 +5880,7 @@ struct wuffs_gif__config_decoder__struct {
 
     uint32_t p_decode_image_config[1];
     uint32_t p_ack_metadata_chunk[1];
+    uint32_t p_decode_frame_index[1];
     uint32_t p_decode_frame_config[1];
     uint32_t p_skip_frame[1];
     uint32_t p_decode_up_to_id_part1[1];
@@ -5318,6 +5896,11 @@ struct wuffs_gif__config_decoder__struct {
   struct {
     uint8_t f_palettes[1][1024];
 
+    struct {
+      uint64_t v_entry;
+      uint8_t v_flags;
+      uint64_t v_duration;
+    } s_decode_frame_index[1];
     struct {
       uint32_t v_background_color;
     } s_decode_frame_config[1];
@@ -5461,6 +6044,12 @@ struct wuffs_gif__config_decoder__struct {
                                                     a_io_position);
   }
 
+  inline wuffs_base__status  //
+  decode_frame_index(wuffs_base__io_buffer* a_dst,
+                     wuffs_base__io_buffer* a_src) {
+    return wuffs_gif__config_decoder__decode_frame_index(this, a_dst, a_src);
+  }
+
   inline wuffs_base__status  //
   decode_frame_config(wuffs_base__frame_config* a_dst,
                       wuffs_base__io_buffer* a_src) {
@@ -5541,6 +6130,7 @@ struct wuffs_gif__decoder__struct {
 
     uint32_t p_decode_image_config[1];
     uint32_t p_ack_metadata_chunk[1];
+    uint32_t p_decode_frame_index[1];
     uint32_t p_decode_frame_config[1];
     uint32_t p_skip_frame[1];
     uint32_t p_decode_frame[1];
@@ -5562,6 +6152,11 @@ struct wuffs_gif__decoder__struct {
     uint8_t f_dst_palette[1024];
     wuffs_lzw__decoder f_lzw;
 
+    struct {
+      uint64_t v_entry;
+      uint8_t v_flags;
+      uint64_t v_duration;
+    } s_decode_frame_index[1];
     struct {
       uint32_t v_background_color;
     } s_decode_frame_config[1];
@@ -5605,6 +6200,7 @@ struct wuffs_gif__decoder__struct {
     struct {
       uint64_t v_block_size;
       bool v_need_block_size;
+      bool v_direct;
       wuffs_base__status v_lzw_status;
       uint64_t scratch;
     } s_decode_id_part2[1];
@@ -5713,6 +6309,12 @@ struct wuffs_gif__decoder__struct {
     return wuffs_gif__decoder__restart_frame(this, a_index, a_io_position);
   }
 
+  inline wuffs_base__status  //
+  decode_frame_index(wuffs_base__io_buffer* a_dst,
+                     wuffs_base__io_buffer* a_src) {
+    return wuffs_gif__decoder__decode_frame_index(this, a_dst, a_src);
+  }
+
   inline wuffs_base__status  //
   decode_frame_config(wuffs_base__frame_config* a_dst,
                       wuffs_base__io_buffer* a_src) {
@@ -5733,6 +6335,122 @@ struct wuffs_gif__decoder__struct {
 
 };  // struct wuffs_gif__decoder__struct
 
+struct wuffs_gif__encoder__struct {
+  // Do not access the private_impl's or private_data's fields directly. There
+  // is no API/ABI compatibility or safety guarantee if you do so. Instead, use
+  // the wuffs_foo__bar__baz functions.
+  //
+  // It is a struct, not a struct*, so that the outermost wuffs_foo__bar struct
+  // can be stack allocated when WUFFS_IMPLEMENTATION is defined.
+
+  struct {
+    uint32_t magic;
+    uint32_t active_coroutine;
+    wuffs_base__vtable null_vtable;
+
+    uint32_t f_num_loops_plus_1;
+    bool f_header_written;
+    uint32_t f_width;
+    uint32_t f_height;
+
+    uint32_t p_encode_frame[1];
+    uint32_t p_encode_trailer[1];
+    uint32_t p_write_u16le[1];
+    uint32_t p_write_color_table[1];
+    uint32_t p_write_image_data[1];
+  } private_impl;
+
+  struct {
+    uint8_t f_palettes[2][1024];
+    uint8_t f_block[255];
+    wuffs_lzw__encoder f_lzw;
+
+    struct {
+      uint32_t v_i;
+      uint64_t v_x;
+      uint64_t v_delay;
+      bool v_has_lct;
+      uint64_t scratch;
+    } s_encode_frame[1];
+    struct {
+      uint64_t scratch;
+    } s_encode_trailer[1];
+    struct {
+      uint64_t scratch;
+    } s_write_u16le[1];
+    struct {
+      uint32_t v_i;
+      uint64_t scratch;
+    } s_write_color_table[1];
+    struct {
+      uint32_t v_height;
+      uint32_t v_y;
+      uint64_t v_row_ri;
+      uint64_t v_block_wi;
+      wuffs_base__status v_lzw_status;
+      uint64_t v_i;
+      uint64_t scratch;
+    } s_write_image_data[1];
+  } private_data;
+
+#ifdef __cplusplus
+#if (__cplusplus >= 201103L) && !defined(WUFFS_IMPLEMENTATION)
+  // Disallow constructing or copying an object via standard C++ mechanisms,
+  // e.g. the "new" operator, as this struct is intentionally opaque. Its total
+  // size and field layout is not part of the public, stable, memory-safe API.
+  // Use malloc or memcpy and the sizeof__wuffs_foo__bar function instead, and
+  // call wuffs_foo__bar__baz methods (which all take a "this"-like pointer as
+  // their first argument) rather than tweaking bar.private_impl.qux fields.
+  //
+  // In C, we can just leave wuffs_foo__bar as an incomplete type (unless
+  // WUFFS_IMPLEMENTATION is #define'd). In C++, we define a complete type in
+  // order to provide convenience methods. These forward on "this", so that you
+  // can write "bar->baz(etc)" instead of "wuffs_foo__bar__baz(bar, etc)".
+  wuffs_gif__encoder__struct() = delete;
+  wuffs_gif__encoder__struct(const wuffs_gif__encoder__struct&) = delete;
+  wuffs_gif__encoder__struct& operator=(const wuffs_gif__encoder__struct&) =
+      delete;
+
+  // As above, the size of the struct is not part of the public API, and unless
+  // WUFFS_IMPLEMENTATION is #define'd, this struct type T should be heap
+  // allocated, not stack allocated. Its size is not intended to be known at
+  // compile time, but it is unfortunately divulged as a side effect of
+  // defining C++ convenience methods. Use "sizeof__T()", calling the function,
+  // instead of "sizeof T", invoking the operator. To make the two values
+  // different, so that passing the latter will be rejected by the initialize
+  // function, we add an arbitrary amount of dead weight.
+  uint8_t dead_weight[123000000];  // 123 MB.
+#endif  // (__cplusplus >= 201103L) && !defined(WUFFS_IMPLEMENTATION)
+
+  inline wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT  //
+  initialize(size_t sizeof_star_self,
+             uint64_t wuffs_version,
+             uint32_t initialize_flags) {
+    return wuffs_gif__encoder__initialize(this, sizeof_star_self, wuffs_version,
+                                          initialize_flags);
+  }
+
+  inline wuffs_base__empty_struct  //
+  set_num_animation_loops(uint32_t a_n) {
+    return wuffs_gif__encoder__set_num_animation_loops(this, a_n);
+  }
+
+  inline wuffs_base__status  //
+  encode_frame(wuffs_base__io_buffer* a_dst,
+               wuffs_base__pixel_buffer* a_src,
+               uint64_t a_duration) {
+    return wuffs_gif__encoder__encode_frame(this, a_dst, a_src, a_duration);
+  }
+
+  inline wuffs_base__status  //
+  encode_trailer(wuffs_base__io_buffer* a_dst) {
+    return wuffs_gif__encoder__encode_trailer(this, a_dst);
+  }
+
+#endif  // __cplusplus
+
+};  // struct wuffs_gif__encoder__struct
+
 #endif  // defined(__cplusplus) || defined(WUFFS_IMPLEMENTATION)
 
 #ifdef __cplusplus
@@ -5752,12 +6470,16 @@ extern const char* wuffs_gzip__error__bad_header;
 
 // ---------------- Public Consts
 
-#define WUFFS_GZIP__DECODER_WORKBUF_LEN_MAX_INCL_WORST_CASE 1
+#define WUFFS_GZIP__DECODER_WORKBUF_LEN_MAX_INCL_WORST_CASE 33025
+
+#define WUFFS_GZIP__ENCODER_WORKBUF_LEN_MAX_INCL_WORST_CASE 0
 
 // ---------------- Struct Declarations
 
 typedef struct wuffs_gzip__decoder__struct wuffs_gzip__decoder;
 
+typedef struct wuffs_gzip__encoder__struct wuffs_gzip__encoder;
+
 // ---------------- Public Initializer Prototypes
 
 // For any given "wuffs_foo__bar* self", "wuffs_foo__bar__initialize(self,
@@ -5775,6 +6497,15 @@ wuffs_gzip__decoder__initialize(wuffs_gzip__decoder* self,
 size_t  //
 sizeof__wuffs_gzip__decoder();
 
+wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT  //
+wuffs_gzip__encoder__initialize(wuffs_gzip__encoder* self,
+                                size_t sizeof_star_self,
+                                uint64_t wuffs_version,
+                                uint32_t initialize_flags);
+
+size_t  //
+sizeof__wuffs_gzip__encoder();
+
 // ---------------- Upcasts
 
 static inline wuffs_base__io_transformer*  //
@@ -5783,11 +6514,37 @@ wuffs_gzip__decoder__upcast_as__wuffs_base__io_transformer(
   return (wuffs_base__io_transformer*)p;
 }
 
+static inline wuffs_base__io_transformer*  //
+wuffs_gzip__encoder__upcast_as__wuffs_base__io_transformer(
+    wuffs_gzip__encoder* p) {
+  return (wuffs_base__io_transformer*)p;
+}
+
 // ---------------- Public Function Prototypes
 
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_gzip__decoder__reset(wuffs_gzip__decoder* self);
+
 WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
 wuffs_gzip__decoder__set_ignore_checksum(wuffs_gzip__decoder* self, bool a_ic);
 
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_gzip__decoder__set_decode_concatenated_members(wuffs_gzip__decoder* self,
+                                                     bool a_d);
+
+WUFFS_BASE__MAYBE_STATIC uint32_t  //
+wuffs_gzip__decoder__bgzf_block_size(const wuffs_gzip__decoder* self);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_gzip__decoder__set_whole_output_in_dst(wuffs_gzip__decoder* self,
+                                             bool a_w);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_gzip__decoder__set_collect_stats(wuffs_gzip__decoder* self, bool a_c);
+
+WUFFS_BASE__MAYBE_STATIC uint64_t  //
+wuffs_gzip__decoder__stats(const wuffs_gzip__decoder* self, uint32_t a_key);
+
 WUFFS_BASE__MAYBE_STATIC wuffs_base__range_ii_u64  //
 wuffs_gzip__decoder__workbuf_len(const wuffs_gzip__decoder* self);
 
@@ -5797,6 +6554,18 @@ wuffs_gzip__decoder__transform_io(wuffs_gzip__decoder* self,
                                   wuffs_base__io_buffer* a_src,
                                   wuffs_base__slice_u8 a_workbuf);
 
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_gzip__encoder__set_level(wuffs_gzip__encoder* self, uint32_t a_l);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__range_ii_u64  //
+wuffs_gzip__encoder__workbuf_len(const wuffs_gzip__encoder* self);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_gzip__encoder__transform_io(wuffs_gzip__encoder* self,
+                                  wuffs_base__io_buffer* a_dst,
+                                  wuffs_base__io_buffer* a_src,
+                                  wuffs_base__slice_u8 a_workbuf);
+
 // ---------------- Struct Definitions
 
 // These structs' fields, and the sizeof them, are private implementation
@@ -5821,6 +6590,8 @@ struct wuffs_gzip__decoder__struct {
     wuffs_base__vtable null_vtable;
 
     bool f_ignore_checksum;
+    bool f_decode_concatenated_members;
+    uint32_t f_bgzf_size;
 
     uint32_t p_transform_io[1];
   } private_impl;
@@ -5831,6 +6602,8 @@ struct wuffs_gzip__decoder__struct {
 
     struct {
       uint8_t v_flags;
+      uint16_t v_xlen;
+      uint16_t v_si;
       uint32_t v_checksum_got;
       uint32_t v_decoded_length_got;
       uint32_t v_checksum_want;
@@ -5880,18 +6653,48 @@ struct wuffs_gzip__decoder__struct {
     return (wuffs_base__io_transformer*)this;
   }
 
+  inline wuffs_base__empty_struct  //
+  reset() {
+    return wuffs_gzip__decoder__reset(this);
+  }
+
   inline wuffs_base__empty_struct  //
   set_ignore_checksum(bool a_ic) {
     return wuffs_gzip__decoder__set_ignore_checksum(this, a_ic);
   }
 
-  inline wuffs_base__range_ii_u64  //
-  workbuf_len() const {
-    return wuffs_gzip__decoder__workbuf_len(this);
+  inline wuffs_base__empty_struct  //
+  set_decode_concatenated_members(bool a_d) {
+    return wuffs_gzip__decoder__set_decode_concatenated_members(this, a_d);
   }
 
-  inline wuffs_base__status  //
-  transform_io(wuffs_base__io_buffer* a_dst,
+  inline uint32_t  //
+  bgzf_block_size() const {
+    return wuffs_gzip__decoder__bgzf_block_size(this);
+  }
+
+  inline wuffs_base__empty_struct  //
+  set_whole_output_in_dst(bool a_w) {
+    return wuffs_gzip__decoder__set_whole_output_in_dst(this, a_w);
+  }
+
+  inline wuffs_base__empty_struct  //
+  set_collect_stats(bool a_c) {
+    return wuffs_gzip__decoder__set_collect_stats(this, a_c);
+  }
+
+  inline uint64_t  //
+  stats(uint32_t a_key) const {
+    return wuffs_gzip__decoder__stats(this, a_key);
+  }
+
+  inline wuffs_base__range_ii_u64  //
+  workbuf_len() const {
+    return wuffs_gzip__decoder__workbuf_len(this);
+  }
+
+  inline wuffs_base__status  //
+  transform_io(wuffs_base__io_buffer* a_dst,
                wuffs_base__io_buffer* a_src,
                wuffs_base__slice_u8 a_workbuf) {
     return wuffs_gzip__decoder__transform_io(this, a_dst, a_src, a_workbuf);
@@ -5901,6 +6704,102 @@ struct wuffs_gzip__decoder__struct {
 
 };  // struct wuffs_gzip__decoder__struct
 
+struct wuffs_gzip__encoder__struct {
+  // Do not access the private_impl's or private_data's fields directly. There
+  // is no API/ABI compatibility or safety guarantee if you do so. Instead, use
+  // the wuffs_foo__bar__baz functions.
+  //
+  // It is a struct, not a struct*, so that the outermost wuffs_foo__bar struct
+  // can be stack allocated when WUFFS_IMPLEMENTATION is defined.
+
+  struct {
+    uint32_t magic;
+    uint32_t active_coroutine;
+    wuffs_base__vtable vtable_for__wuffs_base__io_transformer;
+    wuffs_base__vtable null_vtable;
+
+    uint32_t f_level_plus_1;
+
+    uint32_t p_transform_io[1];
+  } private_impl;
+
+  struct {
+    wuffs_crc32__ieee_hasher f_checksum;
+    wuffs_deflate__encoder f_flate;
+
+    struct {
+      uint8_t v_xfl;
+      uint64_t v_x;
+      uint32_t v_i;
+      uint32_t v_checksum_got;
+      uint32_t v_decoded_length;
+      uint64_t scratch;
+    } s_transform_io[1];
+  } private_data;
+
+#ifdef __cplusplus
+#if (__cplusplus >= 201103L) && !defined(WUFFS_IMPLEMENTATION)
+  // Disallow constructing or copying an object via standard C++ mechanisms,
+  // e.g. the "new" operator, as this struct is intentionally opaque. Its total
+  // size and field layout is not part of the public, stable, memory-safe API.
+  // Use malloc or memcpy and the sizeof__wuffs_foo__bar function instead, and
+  // call wuffs_foo__bar__baz methods (which all take a "this"-like pointer as
+  // their first argument) rather than tweaking bar.private_impl.qux fields.
+  //
+  // In C, we can just leave wuffs_foo__bar as an incomplete type (unless
+  // WUFFS_IMPLEMENTATION is #define'd). In C++, we define a complete type in
+  // order to provide convenience methods. These forward on "this", so that you
+  // can write "bar->baz(etc)" instead of "wuffs_foo__bar__baz(bar, etc)".
+  wuffs_gzip__encoder__struct() = delete;
+  wuffs_gzip__encoder__struct(const wuffs_gzip__encoder__struct&) = delete;
+  wuffs_gzip__encoder__struct& operator=(const wuffs_gzip__encoder__struct&) =
+      delete;
+
+  // As above, the size of the struct is not part of the public API, and unless
+  // WUFFS_IMPLEMENTATION is #define'd, this struct type T should be heap
+  // allocated, not stack allocated. Its size is not intended to be known at
+  // compile time, but it is unfortunately divulged as a side effect of
+  // defining C++ convenience methods. Use "sizeof__T()", calling the function,
+  // instead of "sizeof T", invoking the operator. To make the two values
+  // different, so that passing the latter will be rejected by the initialize
+  // function, we add an arbitrary amount of dead weight.
+  uint8_t dead_weight[123000000];  // 123 MB.
+#endif  // (__cplusplus >= 201103L) && !defined(WUFFS_IMPLEMENTATION)
+
+  inline wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT  //
+  initialize(size_t sizeof_star_self,
+             uint64_t wuffs_version,
+             uint32_t initialize_flags) {
+    return wuffs_gzip__encoder__initialize(this, sizeof_star_self,
+                                           wuffs_version, initialize_flags);
+  }
+
+  inline wuffs_base__io_transformer*  //
+  upcast_as__wuffs_base__io_transformer() {
+    return (wuffs_base__io_transformer*)this;
+  }
+
+  inline wuffs_base__empty_struct  //
+  set_level(uint32_t a_l) {
+    return wuffs_gzip__encoder__set_level(this, a_l);
+  }
+
+  inline wuffs_base__range_ii_u64  //
+  workbuf_len() const {
+    return wuffs_gzip__encoder__workbuf_len(this);
+  }
+
+  inline wuffs_base__status  //
+  transform_io(wuffs_base__io_buffer* a_dst,
+               wuffs_base__io_buffer* a_src,
+               wuffs_base__slice_u8 a_workbuf) {
+    return wuffs_gzip__encoder__transform_io(this, a_dst, a_src, a_workbuf);
+  }
+
+#endif  // __cplusplus
+
+};  // struct wuffs_gzip__encoder__struct
+
 #endif  // defined(__cplusplus) || defined(WUFFS_IMPLEMENTATION)
 
 #ifdef __cplusplus
@@ -6423,12 +7322,16 @@ extern const char* wuffs_zlib__error__incorrect_dictionary;
 
 // ---------------- Public Consts
 
-#define WUFFS_ZLIB__DECODER_WORKBUF_LEN_MAX_INCL_WORST_CASE 1
+#define WUFFS_ZLIB__DECODER_WORKBUF_LEN_MAX_INCL_WORST_CASE 33025
+
+#define WUFFS_ZLIB__ENCODER_WORKBUF_LEN_MAX_INCL_WORST_CASE 0
 
 // ---------------- Struct Declarations
 
 typedef struct wuffs_zlib__decoder__struct wuffs_zlib__decoder;
 
+typedef struct wuffs_zlib__encoder__struct wuffs_zlib__encoder;
+
 // ---------------- Public Initializer Prototypes
 
 // For any given "wuffs_foo__bar* self", "wuffs_foo__bar__initialize(self,
@@ -6446,6 +7349,15 @@ wuffs_zlib__decoder__initialize(wuffs_zlib__decoder* self,
 size_t  //
 sizeof__wuffs_zlib__decoder();
 
+wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT  //
+wuffs_zlib__encoder__initialize(wuffs_zlib__encoder* self,
+                                size_t sizeof_star_self,
+                                uint64_t wuffs_version,
+                                uint32_t initialize_flags);
+
+size_t  //
+sizeof__wuffs_zlib__encoder();
+
 // ---------------- Upcasts
 
 static inline wuffs_base__io_transformer*  //
@@ -6454,18 +7366,38 @@ wuffs_zlib__decoder__upcast_as__wuffs_base__io_transformer(
   return (wuffs_base__io_transformer*)p;
 }
 
+static inline wuffs_base__io_transformer*  //
+wuffs_zlib__encoder__upcast_as__wuffs_base__io_transformer(
+    wuffs_zlib__encoder* p) {
+  return (wuffs_base__io_transformer*)p;
+}
+
 // ---------------- Public Function Prototypes
 
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_zlib__decoder__reset(wuffs_zlib__decoder* self);
+
 WUFFS_BASE__MAYBE_STATIC uint32_t  //
 wuffs_zlib__decoder__dictionary_id(const wuffs_zlib__decoder* self);
 
-WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
 wuffs_zlib__decoder__add_dictionary(wuffs_zlib__decoder* self,
-                                    wuffs_base__slice_u8 a_dict);
+                                    wuffs_base__slice_u8 a_dict,
+                                    wuffs_base__slice_u8 a_workbuf);
 
 WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
 wuffs_zlib__decoder__set_ignore_checksum(wuffs_zlib__decoder* self, bool a_ic);
 
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_zlib__decoder__set_whole_output_in_dst(wuffs_zlib__decoder* self,
+                                             bool a_w);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_zlib__decoder__set_collect_stats(wuffs_zlib__decoder* self, bool a_c);
+
+WUFFS_BASE__MAYBE_STATIC uint64_t  //
+wuffs_zlib__decoder__stats(const wuffs_zlib__decoder* self, uint32_t a_key);
+
 WUFFS_BASE__MAYBE_STATIC wuffs_base__range_ii_u64  //
 wuffs_zlib__decoder__workbuf_len(const wuffs_zlib__decoder* self);
 
@@ -6475,6 +7407,18 @@ wuffs_zlib__decoder__transform_io(wuffs_zlib__decoder* self,
                                   wuffs_base__io_buffer* a_src,
                                   wuffs_base__slice_u8 a_workbuf);
 
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_zlib__encoder__set_level(wuffs_zlib__encoder* self, uint32_t a_l);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__range_ii_u64  //
+wuffs_zlib__encoder__workbuf_len(const wuffs_zlib__encoder* self);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_zlib__encoder__transform_io(wuffs_zlib__encoder* self,
+                                  wuffs_base__io_buffer* a_dst,
+                                  wuffs_base__io_buffer* a_src,
+                                  wuffs_base__slice_u8 a_workbuf);
+
 // ---------------- Struct Definitions
 
 // These structs' fields, and the sizeof them, are private implementation
@@ -6562,14 +7506,19 @@ struct wuffs_zlib__decoder__struct {
     return (wuffs_base__io_transformer*)this;
   }
 
+  inline wuffs_base__empty_struct  //
+  reset() {
+    return wuffs_zlib__decoder__reset(this);
+  }
+
   inline uint32_t  //
   dictionary_id() const {
     return wuffs_zlib__decoder__dictionary_id(this);
   }
 
-  inline wuffs_base__empty_struct  //
-  add_dictionary(wuffs_base__slice_u8 a_dict) {
-    return wuffs_zlib__decoder__add_dictionary(this, a_dict);
+  inline wuffs_base__status  //
+  add_dictionary(wuffs_base__slice_u8 a_dict, wuffs_base__slice_u8 a_workbuf) {
+    return wuffs_zlib__decoder__add_dictionary(this, a_dict, a_workbuf);
   }
 
   inline wuffs_base__empty_struct  //
@@ -6577,6 +7526,21 @@ struct wuffs_zlib__decoder__struct {
     return wuffs_zlib__decoder__set_ignore_checksum(this, a_ic);
   }
 
+  inline wuffs_base__empty_struct  //
+  set_whole_output_in_dst(bool a_w) {
+    return wuffs_zlib__decoder__set_whole_output_in_dst(this, a_w);
+  }
+
+  inline wuffs_base__empty_struct  //
+  set_collect_stats(bool a_c) {
+    return wuffs_zlib__decoder__set_collect_stats(this, a_c);
+  }
+
+  inline uint64_t  //
+  stats(uint32_t a_key) const {
+    return wuffs_zlib__decoder__stats(this, a_key);
+  }
+
   inline wuffs_base__range_ii_u64  //
   workbuf_len() const {
     return wuffs_zlib__decoder__workbuf_len(this);
@@ -6593,6 +7557,100 @@ struct wuffs_zlib__decoder__struct {
 
 };  // struct wuffs_zlib__decoder__struct
 
+struct wuffs_zlib__encoder__struct {
+  // Do not access the private_impl's or private_data's fields directly. There
+  // is no API/ABI compatibility or safety guarantee if you do so. Instead, use
+  // the wuffs_foo__bar__baz functions.
+  //
+  // It is a struct, not a struct*, so that the outermost wuffs_foo__bar struct
+  // can be stack allocated when WUFFS_IMPLEMENTATION is defined.
+
+  struct {
+    uint32_t magic;
+    uint32_t active_coroutine;
+    wuffs_base__vtable vtable_for__wuffs_base__io_transformer;
+    wuffs_base__vtable null_vtable;
+
+    uint32_t f_level_plus_1;
+
+    uint32_t p_transform_io[1];
+  } private_impl;
+
+  struct {
+    wuffs_adler32__hasher f_checksum;
+    wuffs_deflate__encoder f_flate;
+
+    struct {
+      uint16_t v_x;
+      uint32_t v_i;
+      uint32_t v_checksum_got;
+      uint64_t scratch;
+    } s_transform_io[1];
+  } private_data;
+
+#ifdef __cplusplus
+#if (__cplusplus >= 201103L) && !defined(WUFFS_IMPLEMENTATION)
+  // Disallow constructing or copying an object via standard C++ mechanisms,
+  // e.g. the "new" operator, as this struct is intentionally opaque. Its total
+  // size and field layout is not part of the public, stable, memory-safe API.
+  // Use malloc or memcpy and the sizeof__wuffs_foo__bar function instead, and
+  // call wuffs_foo__bar__baz methods (which all take a "this"-like pointer as
+  // their first argument) rather than tweaking bar.private_impl.qux fields.
+  //
+  // In C, we can just leave wuffs_foo__bar as an incomplete type (unless
+  // WUFFS_IMPLEMENTATION is #define'd). In C++, we define a complete type in
+  // order to provide convenience methods. These forward on "this", so that you
+  // can write "bar->baz(etc)" instead of "wuffs_foo__bar__baz(bar, etc)".
+  wuffs_zlib__encoder__struct() = delete;
+  wuffs_zlib__encoder__struct(const wuffs_zlib__encoder__struct&) = delete;
+  wuffs_zlib__encoder__struct& operator=(const wuffs_zlib__encoder__struct&) =
+      delete;
+
+  // As above, the size of the struct is not part of the public API, and unless
+  // WUFFS_IMPLEMENTATION is #define'd, this struct type T should be heap
+  // allocated, not stack allocated. Its size is not intended to be known at
+  // compile time, but it is unfortunately divulged as a side effect of
+  // defining C++ convenience methods. Use "sizeof__T()", calling the function,
+  // instead of "sizeof T", invoking the operator. To make the two values
+  // different, so that passing the latter will be rejected by the initialize
+  // function, we add an arbitrary amount of dead weight.
+  uint8_t dead_weight[123000000];  // 123 MB.
+#endif  // (__cplusplus >= 201103L) && !defined(WUFFS_IMPLEMENTATION)
+
+  inline wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT  //
+  initialize(size_t sizeof_star_self,
+             uint64_t wuffs_version,
+             uint32_t initialize_flags) {
+    return wuffs_zlib__encoder__initialize(this, sizeof_star_self,
+                                           wuffs_version, initialize_flags);
+  }
+
+  inline wuffs_base__io_transformer*  //
+  upcast_as__wuffs_base__io_transformer() {
+    return (wuffs_base__io_transformer*)this;
+  }
+
+  inline wuffs_base__empty_struct  //
+  set_level(uint32_t a_l) {
+    return wuffs_zlib__encoder__set_level(this, a_l);
+  }
+
+  inline wuffs_base__range_ii_u64  //
+  workbuf_len() const {
+    return wuffs_zlib__encoder__workbuf_len(this);
+  }
+
+  inline wuffs_base__status  //
+  transform_io(wuffs_base__io_buffer* a_dst,
+               wuffs_base__io_buffer* a_src,
+               wuffs_base__slice_u8 a_workbuf) {
+    return wuffs_zlib__encoder__transform_io(this, a_dst, a_src, a_workbuf);
+  }
+
+#endif  // __cplusplus
+
+};  // struct wuffs_zlib__encoder__struct
+
 #endif  // defined(__cplusplus) || defined(WUFFS_IMPLEMENTATION)
 
 #ifdef __cplusplus
@@ -6602,6 +7660,15 @@ struct wuffs_zlib__decoder__struct {
 // WUFFS C HEADER ENDS HERE.
 #ifdef WUFFS_IMPLEMENTATION
 
+// WUFFS_BASE__CPU_ARCH__ETC are defined when the compiler can emit the
+// instructions for a CPU architecture-specific code path. Whether the CPU that
+// runs the code supports those instructions is checked at run time.
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define WUFFS_BASE__CPU_ARCH__X86_64
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+
 // GCC does not warn for unused *static inline* functions, but clang does.
 #ifdef __clang__
 #pragma clang diagnostic push
@@ -6671,6 +7738,67 @@ wuffs_base__ignore_status(wuffs_base__status z) {
 #define WUFFS_BASE__UNLIKELY(expr) (expr)
 #endif
 
+// ---------------- CPU Architecture
+
+// WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET enables the compiler to emit instructions
+// (e.g. SIMD) for a single function, without requiring the whole translation
+// unit to be compiled with e.g. "-msse4.2".
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+#define WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET(arg) __attribute__((target(arg)))
+#else
+#define WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET(arg)
+#endif
+
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+
+// wuffs_base__private_implementation__cpu_arch__x86_sse42 caches the result
+// of wuffs_base__cpu_arch__have_x86_sse42: 0 means unknown, 1 means false and
+// 2 means true.
+static int wuffs_base__private_implementation__cpu_arch__x86_sse42 = 0;
+
+// wuffs_base__cpu_arch__have_x86_sse42 returns whether the CPU supports the
+// instructions of a Wuffs "choose cpu_arch >= x86_sse42" function: PCLMUL,
+// POPCNT, SSE4.2 and the SSE4.2 prerequisites SSE4.1 and SSSE3.
+//
+// The CPUID instruction can be slow (e.g. inside a virtual machine, it traps to
+// the hypervisor), so its result is cached. Concurrent callers all compute and
+// store the same value, and the cache is accessed with relaxed atomics so that
+// doing so is not a data race.
+static inline bool  //
+wuffs_base__cpu_arch__have_x86_sse42() {
+  int* cached = &wuffs_base__private_implementation__cpu_arch__x86_sse42;
+  int value = __atomic_load_n(cached, __ATOMIC_RELAXED);
+  if (value == 0) {
+    unsigned int eax1 = 0;
+    unsigned int ebx1 = 0;
+    unsigned int ecx1 = 0;
+    unsigned int edx1 = 0;
+    const unsigned int sse42_ecx1_bits =
+        bit_PCLMUL | bit_POPCNT | bit_SSE4_1 | bit_SSE4_2 | bit_SSSE3;
+    value = (__get_cpuid(1, &eax1, &ebx1, &ecx1, &edx1) &&
+             ((ecx1 & sse42_ecx1_bits) == sse42_ecx1_bits))
+                ? 2
+                : 1;
+    __atomic_store_n(cached, value, __ATOMIC_RELAXED);
+  }
+  return value == 2;
+}
+
+// wuffs_base__cpu_arch__override_x86_sse42 makes later
+// wuffs_base__cpu_arch__have_x86_sse42 calls return have, without checking
+// the CPU. It only affects receivers that have not yet chosen between their
+// portable and x86_sse42 implementations, such as newly initialized hashers.
+//
+// It is intended for tests and benchmarks of the portable implementations,
+// and is not thread-safe.
+static inline void  //
+wuffs_base__cpu_arch__override_x86_sse42(bool have) {
+  __atomic_store_n(&wuffs_base__private_implementation__cpu_arch__x86_sse42,
+                   have ? 2 : 1, __ATOMIC_RELAXED);
+}
+
+#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_64)
+
 // ---------------- Numeric Types
 
 extern const uint8_t wuffs_base__low_bits_mask__u8[9];
@@ -6877,10 +8005,8 @@ wuffs_base__io_writer__copy_n32_from_history(uint8_t** ptr_iop_w,
   // argument, and the cgen can look if that argument is the constant
   // expression '3'.
   //
-  // See also wuffs_base__io_writer__copy_n32_from_history_fast below.
-  //
-  // Alternatively, or additionally, have a sloppy_copy_n32_from_history method
-  // that copies 8 bytes at a time, possibly writing more than length bytes?
+  // See also wuffs_base__io_writer__copy_n32_from_history_fast below, and
+  // its 8_byte_chunks variant, which can write more than length bytes.
   for (; n >= 3; n -= 3) {
     *p++ = *q++;
     *p++ = *q++;
@@ -6920,15 +8046,71 @@ wuffs_base__io_writer__copy_n32_from_history_fast(uint8_t** ptr_iop_w,
   return length;
 }
 
+// wuffs_base__io_writer__copy_n32_from_history_8_byte_chunks_fast is like the
+// wuffs_base__io_writer__copy_n32_from_history_fast function above, but copies
+// 8 bytes at a time. It can therefore write up to 7 bytes past length, so the
+// caller needs to prove a stronger pre-condition, that:
+//  - distance >  0
+//  - distance <= (*ptr_iop_w - io1_w)
+//  - length   <= (io2_w      - *ptr_iop_w) - 8
+//
+// Those extra bytes are overwritten by later writes (or are past the end of
+// the meaningful data), so they are never observable by the caller. The
+// *ptr_iop_w pointer only advances by length.
+//
+// For distance >= 8, each 8 byte chunk read (from q) was either already in
+// the buffer or was completely written by earlier chunks. For distance < 8,
+// a chunk would overlap the bytes it is writing, so instead we splat an 8 byte
+// pattern of the distance-periodic bytes, advancing by the largest multiple
+// of distance that is no more than 8.
 static inline uint32_t  //
-wuffs_base__io_writer__copy_n32_from_reader(uint8_t** ptr_iop_w,
-                                            uint8_t* io2_w,
-                                            uint32_t length,
-                                            uint8_t** ptr_iop_r,
-                                            uint8_t* io2_r) {
-  uint8_t* iop_w = *ptr_iop_w;
-  size_t n = length;
-  if (n > ((size_t)(io2_w - iop_w))) {
+wuffs_base__io_writer__copy_n32_from_history_8_byte_chunks_fast(
+    uint8_t** ptr_iop_w,
+    uint8_t* io1_w,
+    uint8_t* io2_w,
+    uint32_t length,
+    uint32_t distance) {
+  uint8_t* p = *ptr_iop_w;
+  uint8_t* q = p - distance;
+  uint32_t n = length;
+  if (distance >= 8) {
+    for (; n > 8; n -= 8) {
+      wuffs_base__store_u64le__no_bounds_check(
+          p, wuffs_base__load_u64le__no_bounds_check(q));
+      p += 8;
+      q += 8;
+    }
+    wuffs_base__store_u64le__no_bounds_check(
+        p, wuffs_base__load_u64le__no_bounds_check(q));
+  } else {
+    uint64_t x = 0;
+    uint32_t s = 0;
+    for (; s < distance; s++) {
+      x |= ((uint64_t)(q[s])) << (8 * s);
+    }
+    for (; s < 8; s *= 2) {
+      x |= x << (8 * s);
+    }
+    uint32_t step = (8 / distance) * distance;
+    for (; n > step; n -= step) {
+      wuffs_base__store_u64le__no_bounds_check(p, x);
+      p += step;
+    }
+    wuffs_base__store_u64le__no_bounds_check(p, x);
+  }
+  *ptr_iop_w += length;
+  return length;
+}
+
+static inline uint32_t  //
+wuffs_base__io_writer__copy_n32_from_reader(uint8_t** ptr_iop_w,
+                                            uint8_t* io2_w,
+                                            uint32_t length,
+                                            uint8_t** ptr_iop_r,
+                                            uint8_t* io2_r) {
+  uint8_t* iop_w = *ptr_iop_w;
+  size_t n = length;
+  if (n > ((size_t)(io2_w - iop_w))) {
     n = (size_t)(io2_w - iop_w);
   }
   uint8_t* iop_r = *ptr_iop_r;
@@ -9980,6 +11162,20 @@ wuffs_base__ascii__longest_valid_prefix(wuffs_base__slice_u8 s) {
 
 // ---------------- Private Function Prototypes
 
+static wuffs_base__empty_struct  //
+wuffs_adler32__hasher__up(wuffs_adler32__hasher* self,
+                          wuffs_base__slice_u8 a_x);
+
+static wuffs_base__empty_struct  //
+wuffs_adler32__hasher__up__choosy_default(wuffs_adler32__hasher* self,
+                                          wuffs_base__slice_u8 a_x);
+
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+static wuffs_base__empty_struct  //
+wuffs_adler32__hasher__up_x86_sse42(wuffs_adler32__hasher* self,
+                                    wuffs_base__slice_u8 a_x);
+#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_64)
+
 // ---------------- VTables
 
 const wuffs_base__hasher_u32__func_ptrs
@@ -10030,6 +11226,7 @@ wuffs_adler32__hasher__initialize(wuffs_adler32__hasher* self,
     }
   }
 
+  self->private_impl.choosy_up = &wuffs_adler32__hasher__up__choosy_default;
   self->private_impl.magic = WUFFS_BASE__MAGIC;
   self->private_impl.vtable_for__wuffs_base__hasher_u32.vtable_name =
       wuffs_base__hasher_u32__vtable_name;
@@ -10057,15 +11254,35 @@ wuffs_adler32__hasher__update_u32(wuffs_adler32__hasher* self,
     return 0;
   }
 
+  if (!self->private_impl.f_started) {
+    self->private_impl.f_started = true;
+    self->private_impl.f_state = 1;
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+    if (wuffs_base__cpu_arch__have_x86_sse42()) {
+      self->private_impl.choosy_up = &wuffs_adler32__hasher__up_x86_sse42;
+    }
+#endif
+  }
+  wuffs_adler32__hasher__up(self, a_x);
+  return self->private_impl.f_state;
+}
+
+// -------- func adler32.hasher.up
+
+static wuffs_base__empty_struct  //
+wuffs_adler32__hasher__up(wuffs_adler32__hasher* self,
+                          wuffs_base__slice_u8 a_x) {
+  return (*self->private_impl.choosy_up)(self, a_x);
+}
+
+static wuffs_base__empty_struct  //
+wuffs_adler32__hasher__up__choosy_default(wuffs_adler32__hasher* self,
+                                          wuffs_base__slice_u8 a_x) {
   uint32_t v_s1 = 0;
   uint32_t v_s2 = 0;
   wuffs_base__slice_u8 v_remaining = {0};
   wuffs_base__slice_u8 v_p = {0};
 
-  if (!self->private_impl.f_started) {
-    self->private_impl.f_started = true;
-    self->private_impl.f_state = 1;
-  }
   v_s1 = ((self->private_impl.f_state) & 0xFFFF);
   v_s2 = ((self->private_impl.f_state) >> (32 - (16)));
   while (((uint64_t)(a_x.len)) > 0) {
@@ -10118,7 +11335,113 @@ wuffs_adler32__hasher__update_u32(wuffs_adler32__hasher* self,
     a_x = v_remaining;
   }
   self->private_impl.f_state = (((v_s2 & 65535) << 16) | (v_s1 & 65535));
-  return self->private_impl.f_state;
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func adler32.hasher.up_x86_sse42
+
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2")
+    static wuffs_base__empty_struct  //
+    wuffs_adler32__hasher__up_x86_sse42(wuffs_adler32__hasher* self,
+                                        wuffs_base__slice_u8 a_x) {
+  uint32_t v_s1 = 0;
+  uint32_t v_s2 = 0;
+  wuffs_base__slice_u8 v_remaining = {0};
+  wuffs_base__slice_u8 v_p = {0};
+  __m128i v_zeroes = {0};
+  __m128i v_ones = {0};
+  __m128i v_weights_l = {0};
+  __m128i v_weights_r = {0};
+  __m128i v_p_l = {0};
+  __m128i v_p_r = {0};
+  __m128i v_v1 = {0};
+  __m128i v_v2 = {0};
+  __m128i v_v1_sum = {0};
+
+  v_s1 = ((self->private_impl.f_state) & 0xFFFF);
+  v_s2 = ((self->private_impl.f_state) >> (32 - (16)));
+  v_zeroes = _mm_setzero_si128();
+  v_ones =
+      _mm_set_epi64x((int64_t)(281479271743489), (int64_t)(281479271743489));
+  v_weights_l = _mm_set_epi64x((int64_t)(1230066625199609624),
+                               (int64_t)(1808788007904223008));
+  v_weights_r = _mm_set_epi64x((int64_t)(72623859790382856),
+                               (int64_t)(651345242494996240));
+  while (((uint64_t)(a_x.len)) > 0) {
+    v_remaining = wuffs_base__slice_u8__subslice_j(a_x, 0);
+    if (((uint64_t)(a_x.len)) > 5536) {
+      v_remaining = wuffs_base__slice_u8__subslice_i(a_x, 5536);
+      a_x = wuffs_base__slice_u8__subslice_j(a_x, 5536);
+    }
+    v_v1 = _mm_cvtsi32_si128((int)(v_s1));
+    v_v2 = _mm_cvtsi32_si128((int)(v_s2));
+    v_v1_sum = v_zeroes;
+    while (((uint64_t)(a_x.len)) >= 32) {
+      v_p_l = _mm_lddqu_si128(
+          (const __m128i*)(const void*)(wuffs_base__slice_u8__subslice_ij(
+                                            a_x, 0, 16).ptr));
+      v_p_r = _mm_lddqu_si128(
+          (const __m128i*)(const void*)(wuffs_base__slice_u8__subslice_ij(
+                                            a_x, 16, 32).ptr));
+      v_v1_sum = _mm_add_epi32(v_v1_sum, v_v1);
+      v_v1 = _mm_add_epi32(v_v1, _mm_sad_epu8(v_p_l, v_zeroes));
+      v_v2 = _mm_add_epi32(
+          v_v2, _mm_madd_epi16(_mm_maddubs_epi16(v_p_l, v_weights_l), v_ones));
+      v_v1 = _mm_add_epi32(v_v1, _mm_sad_epu8(v_p_r, v_zeroes));
+      v_v2 = _mm_add_epi32(
+          v_v2, _mm_madd_epi16(_mm_maddubs_epi16(v_p_r, v_weights_r), v_ones));
+      a_x = wuffs_base__slice_u8__subslice_i(a_x, 32);
+    }
+    v_v2 = _mm_add_epi32(v_v2, _mm_slli_epi32(v_v1_sum, 5));
+    v_v1 = _mm_add_epi32(v_v1, _mm_shuffle_epi32(v_v1, 177));
+    v_v1 = _mm_add_epi32(v_v1, _mm_shuffle_epi32(v_v1, 78));
+    v_s1 = ((uint32_t)(_mm_cvtsi128_si32(v_v1)));
+    v_v2 = _mm_add_epi32(v_v2, _mm_shuffle_epi32(v_v2, 177));
+    v_v2 = _mm_add_epi32(v_v2, _mm_shuffle_epi32(v_v2, 78));
+    v_s2 = ((uint32_t)(_mm_cvtsi128_si32(v_v2)));
+    {
+      wuffs_base__slice_u8 i_slice_p = a_x;
+      v_p = i_slice_p;
+      v_p.len = 1;
+      uint8_t* i_end0_p = i_slice_p.ptr + (i_slice_p.len / 1) * 1;
+      while (v_p.ptr < i_end0_p) {
+        v_s1 += ((uint32_t)(v_p.ptr[0]));
+        v_s2 += v_s1;
+        v_p.ptr += 1;
+      }
+    }
+    v_s1 %= 65521;
+    v_s2 %= 65521;
+    a_x = v_remaining;
+  }
+  self->private_impl.f_state = (((v_s2 & 65535) << 16) | (v_s1 & 65535));
+  return wuffs_base__make_empty_struct();
+}
+#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_64)
+
+// -------- func adler32.combine
+
+WUFFS_BASE__MAYBE_STATIC WUFFS_BASE__POTENTIALLY_UNUSED uint32_t  //
+wuffs_adler32__combine(uint32_t a_adler_a,
+                       uint32_t a_adler_b,
+                       uint64_t a_length_b) {
+  uint32_t v_n = 0;
+  uint32_t v_a1 = 0;
+  uint32_t v_a2 = 0;
+  uint32_t v_b1 = 0;
+  uint32_t v_b2 = 0;
+  uint32_t v_s1 = 0;
+  uint32_t v_s2 = 0;
+
+  v_n = ((uint32_t)((a_length_b % 65521)));
+  v_a1 = ((a_adler_a & 65535) % 65521);
+  v_a2 = ((a_adler_a >> 16) % 65521);
+  v_b1 = ((a_adler_b & 65535) % 65521);
+  v_b2 = ((a_adler_b >> 16) % 65521);
+  v_s1 = ((v_a1 + v_b1 + 65520) % 65521);
+  v_s2 = (((((v_n * v_a1) % 65521) + v_a2 + v_b2 + 65521) - v_n) % 65521);
+  return ((v_s2 << 16) | v_s1);
 }
 
 #endif  // !defined(WUFFS_CONFIG__MODULES) ||
@@ -11505,6 +12828,886 @@ wuffs_bmp__decoder__workbuf_len(const wuffs_bmp__decoder* self) {
 
 // ---------------- Private Consts
 
+static const uint32_t                       //
+    wuffs_crc32__castagnoli_table[16][256]  //
+    WUFFS_BASE__POTENTIALLY_UNUSED = {
+        {
+            0,          4067132163, 3778769143, 324072436,  3348797215,
+            904991772,  648144872,  3570033899, 2329499855, 2024987596,
+            1809983544, 2575936315, 1296289744, 3207089363, 2893594407,
+            1578318884, 274646895,  3795141740, 4049975192, 51262619,
+            3619967088, 632279923,  922689671,  3298075524, 2592579488,
+            1760304291, 2075979607, 2312596564, 1562183871, 2943781820,
+            3156637768, 1313733451, 549293790,  3537243613, 3246849577,
+            871202090,  3878099393, 357341890,  102525238,  4101499445,
+            2858735121, 1477399826, 1264559846, 3107202533, 1845379342,
+            2677391885, 2361733625, 2125378298, 820201905,  3263744690,
+            3520608582, 598981189,  4151959214, 85089709,   373468761,
+            3827903834, 3124367742, 1213305469, 1526817161, 2842354314,
+            2107672161, 2412447074, 2627466902, 1861252501, 1098587580,
+            3004210879, 2688576843, 1378610760, 2262928035, 1955203488,
+            1742404180, 2511436119, 3416409459, 969524848,  714683780,
+            3639785095, 205050476,  4266873199, 3976438427, 526918040,
+            1361435347, 2739821008, 2954799652, 1114974503, 2529119692,
+            1691668175, 2005155131, 2247081528, 3690758684, 697762079,
+            986182379,  3366744552, 476452099,  3993867776, 4250756596,
+            255256311,  1640403810, 2477592673, 2164122517, 1922457750,
+            2791048317, 1412925310, 1197962378, 3037525897, 3944729517,
+            427051182,  170179418,  4165941337, 746937522,  3740196785,
+            3451792453, 1070968646, 1905808397, 2213795598, 2426610938,
+            1657317369, 3053634322, 1147748369, 1463399397, 2773627110,
+            4215344322, 153784257,  444234805,  3893493558, 1021025245,
+            3467647198, 3722505002, 797665321,  2197175160, 1889384571,
+            1674398607, 2443626636, 1164749927, 3070701412, 2757221520,
+            1446797203, 137323447,  4198817972, 3910406976, 461344835,
+            3484808360, 1037989803, 781091935,  3705997148, 2460548119,
+            1623424788, 1939049696, 2180517859, 1429367560, 2807687179,
+            3020495871, 1180866812, 410100952,  3927582683, 4182430767,
+            186734380,  3756733383, 763408580,  1053836080, 3434856499,
+            2722870694, 1344288421, 1131464017, 2971354706, 1708204729,
+            2545590714, 2229949006, 1988219213, 680717673,  3673779818,
+            3383336350, 1002577565, 4010310262, 493091189,  238226049,
+            4233660802, 2987750089, 1082061258, 1395524158, 2705686845,
+            1972364758, 2279892693, 2494862625, 1725896226, 952904198,
+            3399985413, 3656866545, 731699698,  4283874585, 222117402,
+            510512622,  3959836397, 3280807620, 837199303,  582374963,
+            3504198960, 68661723,   4135334616, 3844915500, 390545967,
+            1230274059, 3141532936, 2825850620, 1510247935, 2395924756,
+            2091215383, 1878366691, 2644384480, 3553878443, 565732008,
+            854102364,  3229815391, 340358836,  3861050807, 4117890627,
+            119113024,  1493875044, 2875275879, 3090270611, 1247431312,
+            2660249211, 1828433272, 2141937292, 2378227087, 3811616794,
+            291187481,  34330861,   4032846830, 615137029,  3603020806,
+            3314634738, 939183345,  1776939221, 2609017814, 2295496738,
+            2058945313, 2926798794, 1545135305, 1330124605, 3173225534,
+            4084100981, 17165430,   307568514,  3762199681, 888469610,
+            3332340585, 3587147933, 665062302,  2042050490, 2346497209,
+            2559330125, 1793573966, 3190661285, 1279665062, 1595330642,
+            2910671697,
+        },
+        {
+            0,          329422967,  658845934,  887597209,  1317691868,
+            1562966443, 1775194418, 2054015301, 2635383736, 2394315727,
+            3125932886, 2851302177, 3550388836, 3225172499, 4108030602,
+            3883469565, 1069937025, 744974838,  411091311,  186800408,
+            1901039709, 1659701290, 1443537075, 1168652484, 2731618873,
+            2977147470, 2241069783, 2520160928, 3965408229, 4294560658,
+            3407766283, 3636263804, 2139874050, 1814657909, 1489949676,
+            1265388443, 822182622,  581114537,  373600816,  98970183,
+            3802079418, 4047354061, 3319402580, 3598223395, 2887074150,
+            3216496913, 2337304968, 2566056447, 1078858371, 1408010996,
+            1728782957, 1957280282, 247755615,  493284136,  696337329,
+            975428550,  3713716539, 3472378188, 4196393429, 3921508770,
+            2479927527, 2154965136, 3029696521, 2805405822, 4279748100,
+            3971309171, 3629315818, 3421531805, 2979899352, 2722054063,
+            2530776886, 2239369025, 1644365244, 1906417099, 1162229074,
+            1457827109, 747201632,  1059847191, 197940366,  409914617,
+            3235002245, 3547377650, 3885434731, 4097154844, 2388153945,
+            2650459694, 2837276343, 3133144768, 1573319741, 1315204170,
+            2055455955, 1763794084, 323786209,  15601046,   873047311,
+            665533816,  2157716742, 2470362481, 2816021992, 3027996063,
+            3457565914, 3719617709, 3914560564, 4210158659, 495511230,
+            237665993,  986568272,  695160359,  1392674658, 1084235541,
+            1950857100, 1743073275, 3210335367, 2902150384, 2552030313,
+            2344516638, 4057183579, 3799067948, 3600188853, 3308527042,
+            575477567,  837783368,  84420561,   380288934,  1825011427,
+            2137386644, 1266828813, 1478549114, 4223924985, 3898696334,
+            3699821079, 3475264096, 3041499941, 2800419666, 2450303947,
+            2175677372, 1725380929, 1970643254, 1100089775, 1378914776,
+            677206173,  1006616810, 253257843,  482013188,  3288730488,
+            3617886991, 3812834198, 4041319393, 2324458148, 2569990867,
+            2915654218, 3194733117, 1494403264, 1253068983, 2119694382,
+            1844797529, 395880732,  70922603,   819829234,  595526021,
+            2219317755, 2548728204, 2735548693, 2964304226, 3401742375,
+            3647004752, 3985066185, 4263891134, 425515587,  184435252,
+            1041885869, 767259354,  1473690527, 1148462056, 1888717681,
+            1664160518, 3146639482, 2821681165, 2630408340, 2406105315,
+            4110911910, 3869577681, 3527588168, 3252691263, 647572418,
+            893105077,  31202092,   310281051,  1746094622, 2075251305,
+            1331067632, 1559552647, 81018109,   393651338,  596708371,
+            808686692,  1247698209, 1509737814, 1830514127, 2126116280,
+            2579562309, 2321704754, 3196440491, 2905036764, 3611991705,
+            3303540462, 4027559543, 3819779584, 991022460,  682841355,
+            475331986,  267806181,  1973136544, 1715025111, 1390320718,
+            1098646585, 2785349316, 3047659187, 2168471082, 2464327261,
+            3901714200, 4214093679, 3486146550, 3697854337, 2069880831,
+            1761429384, 1545269009, 1337489254, 903200291,  645342804,
+            311463629,  20059834,   3863682119, 4125721648, 3238931625,
+            3534533854, 2831252891, 3143886316, 2407812469, 2619790594,
+            1150955134, 1463334409, 1675566736, 1887274727, 168841122,
+            431151061,  760577868,  1056433979, 3650022854, 3391911345,
+            4274773288, 3983099231, 2533657626, 2225476717, 2957098228,
+            2749572227,
+        },
+        {
+            0,          2772537982, 1332695565, 3928932467, 2665391130,
+            1000289892, 3518101015, 1961911401, 944848581,  2635115707,
+            2000579784, 3531603638, 2794429151, 63834273,   3923822802,
+            1285642924, 1889697162, 3588485108, 1070411655, 2592914937,
+            4001159568, 1262308334, 2702412701, 72489443,   1223902031,
+            3987919153, 127668546,  2732426044, 3593332565, 1936487723,
+            2571285848, 1006839590, 3779394324, 1141205354, 2922096921,
+            191511399,  2140823310, 3671838064, 821366019,  2511642493,
+            3642082769, 2085902255, 2524616668, 859506082,  1204511179,
+            3800757173, 144978886,  2917507512, 2447804062, 883365088,
+            3733574803, 2076722925, 255337092,  2860101882, 1079472265,
+            3843482359, 2847389787, 217459237,  3872975446, 1134131240,
+            929635393,  2452131391, 2013679180, 3712474162, 3345318105,
+            1646531239, 2282410708, 759906474,  1505436867, 4244289213,
+            383022798,  3012945072, 4281646620, 1517628514, 2958814225,
+            354057839,  1642732038, 3299575928, 780486667,  2344934005,
+            3083337043, 310800173,  4171804510, 1575566624, 689527113,
+            2354629431, 1719012164, 3275200826, 2409022358, 718754280,
+            3237581211, 1706558437, 289957772,  3020551666, 1579627905,
+            4217808895, 639728589,  2204166579, 1766730176, 3423583166,
+            3103776727, 499010985,  4153445850, 1389436836, 510674184,
+            3140605814, 1360992005, 4099835259, 2158944530, 636449644,
+            3485578015, 1786782049, 1451427399, 4089615417, 434918474,
+            3165505076, 3361579613, 1830563875, 2268262480, 577987118,
+            1859270786, 3415452412, 566061711,  2231171313, 4027358360,
+            1431113446, 3210989205, 438459627,  2334619459, 778495293,
+            3293062478, 1628026672, 368694105,  2964865319, 1519812948,
+            4292285226, 3010873734, 372759544,  4229503883, 1498974709,
+            766045596,  2297004002, 1657257873, 3347459567, 4219800265,
+            1589942455, 3035257028, 296471226,  1700507347, 3222944941,
+            708115678,  2406837920, 3285464076, 1721083506, 2361091585,
+            704312447,  1560973334, 4165665384, 308658715,  3072610405,
+            1784908887, 3475119657, 621600346,  2152549412, 4106037325,
+            1375517235, 3151133248, 513009726,  1379054226, 4151517420,
+            492691615,  3088872161, 3438024328, 1772979446, 2206418053,
+            650303227,  448917981,  3212862371, 1437508560, 4042207662,
+            2216646087, 559859641,  3413116874, 1848743348, 579915544,
+            2278645094, 1845468437, 3367898987, 3159255810, 420477308,
+            4079040783, 1449175921, 1279457178, 3909314020, 53323159,
+            2792110057, 3533460352, 2011021822, 2649948557, 951227379,
+            1947453791, 3511835425, 998021970,  2654800172, 3939331397,
+            1334640443, 2778873672, 14921014,   1021348368, 2577471598,
+            1938806813, 3603843683, 2721984010, 125811828,  3981540359,
+            1209069177, 78755029,   2716870315, 1272899288, 4003427494,
+            2590970063, 1060012721, 3573564098, 1883361468, 2902854798,
+            138911472,  3798556291, 1193856253, 869836948,  2526624490,
+            2092432025, 3656804583, 2505519691, 806789173,  3661127750,
+            2138698296, 193566289,  2932343855, 1155974236, 3785840162,
+            3718541572, 2028331898, 2462786313, 931836279,  1132123422,
+            3862644576, 202737427,  2840860013, 3858059201, 1085595071,
+            2862226892, 266047410,  2066475995, 3731519909, 876919254,
+            2433035176,
+        },
+        {
+            0,          3712330424, 3211207553, 1646430521, 2065838579,
+            2791807819, 3292861042, 419477706,  4131677158, 721537374,
+            1227047015, 2489772767, 2372293141, 1344534701, 838955412,
+            4014267180, 3915690301, 874584965,  1443074748, 2336634884,
+            2454094030, 1325607542, 757179215,  4033087991, 522244827,
+            3261429859, 2689069402, 2097306594, 1677910824, 3108456848,
+            3680878761, 102787601,  3609531531, 174112307,  1749169930,
+            3037175218, 2886149496, 1900187584, 325060345,  3458575425,
+            560035693,  4230274517, 2651215084, 1128529492, 1514358430,
+            2265377830, 3844367647, 945934247,  1044489654, 3808694030,
+            2166785591, 1550003343, 1164153925, 2552643325, 4194613188,
+            658578812,  3355821648, 356543720,  2002970065, 2854702953,
+            3005740963, 1851940123, 205575202,  3506798234, 2879807463,
+            1994650975, 348224614,  3380926174, 3498339860, 230802604,
+            1877167509, 2997282605, 1575107585, 2158466745, 3800375168,
+            1069593912, 650120690,  4219840330, 2577870451, 1155695819,
+            1120071386, 2676442210, 4255501659, 551577571,  971038505,
+            3836048785, 2257058984, 1539462672, 3028716860, 1774397316,
+            199339709,  3601073157, 3483679951, 316741239,  1891868494,
+            2911254006, 2088979308, 2714165716, 3286526189, 513917525,
+            128023199,  3672428583, 3100006686, 1703146406, 2328307850,
+            1468170802, 899681035,  3907363251, 4058323321, 748729281,
+            1317157624, 2479329344, 2515008081, 1218597097, 713087440,
+            4156912488, 4005940130, 864051482,  1369630755, 2363966107,
+            1671666103, 3202757391, 3703880246, 25235598,   411150404,
+            3317957372, 2816904133, 2057511293, 1386268991, 2414175111,
+            3989301950, 813842438,  696449228,  4106703476, 2531646285,
+            1268806133, 2766449369, 2040594529, 461605208,  3334874080,
+            3754335018, 42152338,   1621211307, 3185840659, 3150215170,
+            1719784122, 77814659,   3655790907, 3236317681, 497279817,
+            2139187824, 2730803400, 1300241380, 2428875100, 4075239525,
+            799183581,  916597271,  3957817519, 2311391638, 1417716526,
+            2240142772, 1489008396, 987954741,  3886503053, 4272417863,
+            602031871,  1103155142, 2625987966, 1942077010, 2927891690,
+            3433471443, 300103531,  149131169,  3584435481, 3078925344,
+            1791035032, 1826712713, 2980365873, 3548794632, 247719344,
+            398679418,  3397842882, 2829352699, 1977734211, 2594508655,
+            1205904855, 633482478,  4169631318, 3783736988, 1019384868,
+            1591745821, 2208675749, 4177958616, 608386144,  1180808537,
+            2602835937, 2183440171, 1600195987, 1027835050, 3758501394,
+            256046398,  3523698566, 2955269823, 1835039751, 1952498893,
+            2837802613, 3406292812, 373444084,  274868197,  3441921373,
+            2936341604, 1916841692, 1799362070, 3053829294, 3559339415,
+            157458223,  3861267459, 996404923,  1497458562, 2214907194,
+            2634315248, 1078058824, 576935537,  4280745161, 774079059,
+            4083558635, 2437194194, 1275136874, 1426174880, 2286164248,
+            3932590113, 925055641,  3630686645, 86133517,   1728102964,
+            3125110924, 2739261510, 2113960702, 472052679,  3244775807,
+            3343332206, 436378070,  2015367407, 2774907479, 3160736413,
+            1629530149, 50471196,   3729230756, 822300808,  3964074544,
+            2388947721, 1394727345, 1243701627, 2539965379, 4115022586,
+            671344706,
+        },
+        {
+            0,          940666796,  1881333592, 1211347188, 3762667184,
+            3629437212, 2422694376, 2826309188, 3311864721, 4252394557,
+            3041252553, 2371140453, 623031585,  489937549,  1426090617,
+            1829832149, 2401395155, 3073576575, 4278238859, 3339833639,
+            1869078371, 1467396303, 524615739,  659845015,  1246063170,
+            1918109166, 979875098,  41343670,   2852181234, 2450635614,
+            3659664298, 3795018758, 464041303,  599382779,  1804233231,
+            1402668451, 4226616295, 3288097867, 2345653439, 3017718547,
+            3738156742, 3873362282, 2934792606, 2533101106, 1049231478,
+            110850010,  1319690030, 1991880834, 2492126340, 2895887144,
+            3836218332, 3703137392, 1959750196, 1289618840, 82687340,
+            1023204032, 1374543637, 1778167993, 567214157,  434008033,
+            2980602277, 2310606345, 3247095549, 4187738449, 928082606,
+            255853826,  1198765558, 2137184858, 3608466462, 4010130354,
+            2805336902, 2670159082, 4063650111, 3391557267, 2182397543,
+            3120943563, 309583759,  711110691,  1649475799, 1514172283,
+            3094547325, 2153931985, 3360805925, 4030774153, 1479980493,
+            1613224545, 672426645,  268764473,  2098462956, 1157984064,
+            221700020,  891793432,  2639380060, 2772488688, 3983761668,
+            3579973288, 754573305,  350793813,  1557856417, 1690988301,
+            3434897737, 4104982245, 3164519953, 2224017853, 3919500392,
+            3515857860, 2579237680, 2712495260, 165374680,  835323252,
+            2046408064, 1105779244, 2749087274, 2613760390, 3556335986,
+            3957853918, 1134428314, 2072997686, 868016066,  195932270,
+            1723643323, 1588451863, 379480803,  781124943,  2264468235,
+            3202901159, 4141601875, 3469392895, 1856165212, 1454619376,
+            511707652,  647062952,  2397531116, 3069576256, 4274369716,
+            3335838488, 2881871565, 2480189793, 3689349525, 3824578105,
+            1266704509, 1938886609, 1000521509, 62115977,   3783308431,
+            3650214691, 2443340759, 2847081595, 29690431,   970220947,
+            1911018855, 1240906443, 619167518,  485937330,  1422221382,
+            1825837034, 3298951598, 4239617538, 3028344566, 2358358362,
+            1963614219, 1293619111, 86556499,   1027199231, 2505039547,
+            2908664087, 3849126371, 3715919439, 2959960986, 2289828918,
+            3226449090, 4166966126, 1344853290, 1748613766, 537528946,
+            404448734,  4196925912, 3258543732, 2315968128, 2988159276,
+            443400040,  578605252,  1783586864, 1381896092, 1062144585,
+            123626981,  1332598033, 2004662973, 3742020857, 3877362517,
+            2938661793, 2537096205, 1509146610, 1642254430, 701587626,
+            297799430,  3115712834, 2175233774, 3381976602, 4052070838,
+            2626991203, 2760235983, 3971377979, 3567715479, 2094074579,
+            1153459583, 217306507,  887274023,  3604078113, 4005605773,
+            2800943481, 2665639637, 915693713,  243601213,  1186381769,
+            2124927077, 330749360,  732412444,  1670646504, 1535468868,
+            4092816128, 3420587180, 2211558488, 3149978612, 1113262757,
+            2051695881, 846845437,  174635601,  2719921173, 2584730553,
+            3527174989, 3928818913, 2268856628, 3207425688, 4145995372,
+            3473912256, 1736032132, 1600704552, 391864540,  793382768,
+            3447286646, 4117234906, 3176903726, 2236275586, 758961606,
+            355318378,  1562249886, 1695507762, 136208615,  806293323,
+            2017247167, 1076744211, 3898334807, 3494556155, 2558066959,
+            2691198627,
+        },
+        {
+            0,          4012927769, 3683426499, 884788186,  3002414967,
+            1573215342, 1769576372, 2252995757, 1611012127, 2402710278,
+            3146430684, 1421530053, 3539152744, 1036207217, 159354795,
+            3863995570, 3222024254, 792484647,  461410557,  4105239524,
+            1928922953, 2647223376, 2843060106, 1178979475, 2685020193,
+            1329218360, 2072414434, 2495013883, 318709590,  4258231375,
+            3379806101, 641979532,  2247366285, 1791262100, 1584969294,
+            2974342487, 922821114,  3627109091, 3968696633, 62777888,
+            3857845906, 180512139,  1048489553, 3511600456, 1460091365,
+            3090633468, 2357958950, 1673261631, 1173890739, 2865253802,
+            2658436720, 1900342633, 4144828868, 406682333,  746696967,
+            3283212830, 637419180,  3402519989, 4268924527, 289600886,
+            2534083035, 2017157826, 1283959064, 2746728961, 235166699,
+            3778294002, 3582524200, 985174065,  3169938588, 1405159301,
+            1736297567, 2286790470, 1845642228, 2167548141, 3046040375,
+            1522436142, 3707204739, 868687770,  125555776,  3897278297,
+            3456658389, 557318348,  361024278,  4206141455, 2096979106,
+            2479699899, 2809265249, 1212258168, 2920182730, 1094588627,
+            1971507977, 2595403792, 486229181,  4090179492, 3346523262,
+            675778407,  2347781478, 1690314367, 1350364581, 3209463484,
+            956660241,  3593801992, 3800685266, 230273483,  3958789497,
+            80100960,   813364666,  3746209443, 1493393934, 3056797975,
+            2190459597, 1841277396, 1274838360, 2764838465, 2423315867,
+            2134947458, 4178135599, 372842806,  579201772,  3451224565,
+            737830215,  3301576286, 4034315652, 524725917,  2567918128,
+            1983854889, 1115943667, 2914228714, 470333398,  4080590031,
+            3347322645, 682916876,  2935849121, 1104014264, 1970348130,
+            2587970427, 2081337289, 2470364368, 2810318602, 1219650579,
+            3472595134, 567014311,  360134781,  4198978404, 3691284456,
+            859106545,  126363435,  3904392242, 1861333151, 2176965510,
+            3044872284, 1515027269, 3154288631, 1395848430, 1737375540,
+            2294174765, 251111552,  3787965337, 3581610051, 978019162,
+            2583470427, 1993132610, 1114636696, 2906679937, 722048556,
+            3292134709, 4035262191, 531979766,  4193958212, 382390877,
+            578165127,  3443946142, 1259310643, 2755650858, 2424516336,
+            2142455273, 1508938085, 3066100348, 2189177254, 1833720511,
+            3943015954, 70634763,   814286545,  3753471432, 972458362,
+            3603358307, 3799656889, 222970528,  2332278285, 1681118484,
+            1351556814, 3216995799, 302836797,  4248602404, 3380628734,
+            649078759,  2700729162, 1338617939, 2071296905, 2487554192,
+            1913320482, 2637864763, 2844153057, 1186349048, 3237987157,
+            802138188,  460546966,  4098033807, 3523271683, 1026602778,
+            160201920,  3871086553, 1626729332, 2412085357, 3145288631,
+            1414078638, 2986787868, 1563864837, 1770677471, 2260340678,
+            15987563,   4022573170, 3682554792, 877607089,  2549676720,
+            2026410409, 1282693747, 2739155306, 621661639,  3393038046,
+            4269894916, 296814109,  4160676527, 416188854,  745685612,
+            3275893109, 1158403544, 2856042177, 2659677467, 1907826178,
+            1475660430, 3099894167, 2356701773, 1665663316, 3842113017,
+            171022048,  1049451834, 3518838307, 938660497,  3636640136,
+            3967709778, 55449931,   2231887334, 1782025983, 1586185509,
+            2981834300,
+        },
+        {
+            0,          1745038536, 3490077072, 3087365464, 2782971345,
+            3454265625, 1978047553, 501592201,  1311636819, 640602523,
+            2653660355, 4129851403, 3956095106, 2211320906, 1003184402,
+            1405636058, 2623273638, 4099462766, 1281205046, 610177022,
+            968572791,  1371018175, 3921503975, 2176731695, 3530950645,
+            3128240957, 40918629,   1785950893, 2006368804, 529919724,
+            2811272116, 3482564476, 1029407677, 1431875445, 3982350893,
+            2237593317, 2562410092, 4038617764, 1220354044, 549335860,
+            1937145582, 460673574,  2742036350, 3413314486, 3600202559,
+            3197474807, 110158511,  1855180391, 2701162779, 3372438995,
+            1896226955, 419761219,  81837258,   1826852866, 3571901786,
+            3169175954, 4012737608, 2267981952, 1059839448, 1462300944,
+            1254965657, 583953745,  2597001225, 4073206977, 2058815354,
+            313797554,  2863750890, 3266474530, 3747070635, 3075796579,
+            257006395,  1733474291, 882571817,  1553585889, 3835470777,
+            2359267185, 2440708088, 4185461552, 1098671720, 696208032,
+            3874291164, 2398081300, 921347148,  1592363140, 1124874253,
+            722408645,  2466931101, 4211690837, 2831220879, 3233950791,
+            2026330399, 281310679,  220317022,  1696786838, 3710360782,
+            3039080454, 1206682823, 804235279,  2548751703, 4293521823,
+            3792453910, 2316266974, 839522438,  1510552654, 163674516,
+            1640125788, 3653705732, 2982415564, 2887892037, 3290599565,
+            2082989525, 337955101,  3686235745, 3014939305, 196159473,
+            1672612665, 2119678896, 374642552,  2924601888, 3327315688,
+            2509931314, 4254707706, 1167907490, 765458026,  813319907,
+            1484352043, 3766230899, 2290037691, 4117630708, 2641175100,
+            627595108,  1298889644, 1351535397, 948824045,  2156434101,
+            3901472381, 3141792679, 3544244079, 1799727671, 54953727,
+            514012790,  1990204094, 3466948582, 2795914030, 1765143634,
+            20371610,   3107171778, 3509616906, 3436523907, 2765495627,
+            483616787,  1959806171, 655886593,  1327179209, 4145959057,
+            2669509721, 2197343440, 3942375448, 1392416064, 989706632,
+            3358952777, 2687934849, 406050009,  1882257425, 1842694296,
+            97936464,   3184726280, 3587194304, 2249748506, 3994770642,
+            1444817290, 1042089282, 603502027,  1274779907, 4093570139,
+            2617098387, 1416525807, 1013799719, 2221420159, 3966436023,
+            4052660798, 2576195318, 562621358,  1233897318, 440634044,
+            1916839540, 3393573676, 2722562020, 3215150957, 3617612709,
+            1873090301, 128334389,  2413365646, 3889833286, 1608470558,
+            937196758,  708430943,  1111154839, 4198471119, 2453453063,
+            3254056157, 2851592213, 301116749,  2045870469, 1679044876,
+            202841540,  3021105308, 3692119124, 327349032,  2072109024,
+            3280251576, 2877785712, 3059889913, 3730905649, 1717858153,
+            241648545,  1571753595, 900473523,  2376685547, 3853155107,
+            4165979050, 2420959074, 675910202,  1078640370, 2994899507,
+            3665929979, 1652872099, 176684907,  392318946,  2137088810,
+            3345225330, 2942778042, 4239357792, 2494323624, 749285104,
+            1151992376, 1498395313, 827104889,  2303322913, 3779774441,
+            786002069,  1188715613, 4276037893, 2531001805, 2335814980,
+            3812268428, 1530916052, 859619356,  1626639814, 150446350,
+            2968704086, 3639736478, 3306440727, 2903991519, 353505671,
+            2098281807,
+        },
+        {
+            0,          1228700967, 2457401934, 3678701417, 555582061,
+            1747058506, 3009771555, 4200137988, 1111164122, 185039357,
+            3494117012, 2575270835, 1663469239, 706411408,  4049501433,
+            3093430750, 2222328244, 3444208787, 370078714,  1597148893,
+            2775288793, 3965187838, 924021143,  2117012656, 3326938478,
+            2406576201, 1412822816, 487164423,  3880816387, 2926375460,
+            1965585741, 1007945834, 218129817,  1144789182, 2675482583,
+            3594838768, 740157428,  1696701139, 3194297786, 4149829789,
+            1329291587, 101129316,  3712195341, 2491409962, 1848042286,
+            656055817,  4234025312, 3043124295, 2306239533, 3226079498,
+            453940835,  1379068740, 2825645632, 3780612967, 974328846,
+            1932486953, 3410847991, 2188449232, 1496683193, 269086622,
+            3931171482, 2741802941, 2015891668, 823422451,  436259634,
+            1396487701, 2289578364, 3242478683, 991775071,  1914778744,
+            2842014481, 3763981878, 1480314856, 285717199,  3393402278,
+            2206156929, 2032553349, 807022754,  3948853195, 2724383468,
+            2658583174, 3612000161, 202258632,  1160922607, 3211477227,
+            4132912588, 756267685,  1680852866, 3696084572, 2507258747,
+            1312111634, 118047029,  4249895985, 3026991382, 1864941183,
+            638894936,  385920683,  1581044620, 2239255781, 3427019202,
+            907881670,  2132890081, 2758137480, 3982076847, 1429973617,
+            470275926,  3343077439, 2390699288, 1948657692, 1025135931,
+            3864973906, 2942480245, 2474026783, 3662338616, 17718609,
+            1211244662, 2993366386, 4216805461, 538173244,  1764729371,
+            3511526341, 2557599458, 1127569803, 168371372,  4031783336,
+            3110886543, 1646844902, 722773697,  872519268,  2101209923,
+            2792975402, 4014280973, 354161673,  1545627950, 2271538759,
+            3461911392, 1983550142, 1057419161, 3829557488, 2910721495,
+            1462178003, 505114100,  3311397533, 2355337146, 2960629712,
+            4182500087, 571434398,  1798510777, 2439650749, 3629539482,
+            51570675,   1244568276, 4065106698, 3144738349, 1614045508,
+            688397411,  3545307495, 2590860352, 1093264169, 135634446,
+            956429309,  1883082458, 2876836275, 3796202644, 404517264,
+            1361054903, 2321845214, 3277387513, 2067461927, 839289344,
+            3913420137, 2692640846, 1512535370, 320538733,  3361705732,
+            2170810915, 3178756681, 4098590574, 789512199,  1714650400,
+            2624223268, 3579184387, 236094058,  1194262349, 4283235987,
+            3060827060, 1832125661, 604535290,  3729882366, 2540503513,
+            1277789872, 85326743,   771841366,  1732059249, 3162089240,
+            4114995775, 253550395,  1176543772, 2640586101, 3562559570,
+            1815763340, 621159595,  4265780162, 3078545125, 1294457825,
+            68921030,   3747553711, 2523094152, 2859947234, 3813353925,
+            940551852,  1899221899, 2339034767, 3260459944, 420621505,
+            1345212902, 3897315384, 2708483359, 2050271862, 856217425,
+            3377582677, 2154671986, 1529423899, 303387964,  587282639,
+            1782400488, 2977546881, 4165320614, 35437218,   1260439429,
+            2422489324, 3646438859, 1631206421, 671498546,  4081239643,
+            3128867708, 1076346488, 152814431,  3529458742, 2606971153,
+            2809606523, 3997912156, 890227509,  2083763730, 2255139606,
+            3478572593, 336742744,  1563309183, 3846976929, 2893039750,
+            1999949807, 1040757448, 3293689804, 2372782827, 1445547394,
+            521482405,
+        },
+        {
+            0,          4097758792, 3985758817, 430902313,  3738157619,
+            720442491,  861804626,  3345010202, 3094606487, 1280124127,
+            1440884982, 2715614910, 1723609252, 2458052332, 2335042245,
+            2131967117, 1963693023, 2167752087, 2560248254, 1822728182,
+            2881769964, 1610254244, 1180011405, 2993380805, 3447218504,
+            960935680,  552188713,  3570888033, 330802043,  3884545331,
+            4263934234, 169389906,  3927386046, 506065398,  126287327,
+            4088933271, 886629773,  3236312005, 3645456364, 762833316,
+            1382339881, 2790916961, 3220508488, 1271650560, 2360022810,
+            2023080274, 1631243643, 2500074291, 2669458529, 1797415465,
+            1921871360, 2259925064, 1104377426, 3052249114, 2890050611,
+            1484552827, 661604086,  3545338046, 3405683863, 1052789471,
+            4188046533, 228479629,  338779812,  3759114476, 3519166861,
+            637333445,  1012130796, 3362600356, 252574654,  4214435318,
+            3801883103, 379778967,  1773259546, 2643402066, 2216694139,
+            1881065267, 3078490409, 1128324961, 1525666632, 2932933888,
+            2764679762, 1358396442, 1230532659, 3177621115, 2047240289,
+            2386083369, 2543301120, 1672045640, 481974469,  3901001357,
+            4046160548, 85284076,   3262487286, 910904510,  803487895,
+            3688535775, 1003822643, 3488335995, 3594830930, 578425370,
+            3843742720, 287574600,  143328865,  4239773737, 2208754852,
+            2006465260, 1849112261, 2584338573, 1567174295, 2841114847,
+            2969105654, 1153835710, 1323208172, 3135265700, 2739885965,
+            1467056581, 2417053663, 1680841111, 2105578942, 2310947830,
+            4138565499, 43231539,   456959258,  4009915218, 677559624,
+            3697044224, 3321063209, 835563873,  2791835115, 1381421987,
+            1274666890, 3217492418, 2024261592, 2358841744, 2503351737,
+            1627966449, 505149308,  3928301876, 4085919005, 129301333,
+            3235132751, 887808775,  759557934,  3648731494, 3546519092,
+            660422780,  1056066645, 3402406429, 229397511,  4187128399,
+            3762130534, 335763502,  1796236451, 2670637803, 2256649922,
+            1925146762, 3051333264, 1105293528, 1481538801, 2893064889,
+            1283400277, 3091330077, 2716792884, 1439706748, 2461065318,
+            1720596014, 2132883975, 2334125135, 4094480578, 3278474,
+            429722275,  3986939115, 717427441,  3741172921, 3344091280,
+            862723800,  963948938,  3444205506, 3571805163, 551271843,
+            3887821753, 327525873,  170568152,  4262756240, 2164736797,
+            1966708053, 1821809020, 2561167156, 1606975790, 2885048166,
+            2992200527, 1181191431, 2007645286, 2207574574, 2587616775,
+            1845833807, 2842033749, 1566255133, 1156850740, 2966090364,
+            3487158001, 1005000889, 575149200,  3598107352, 286657730,
+            3844659850, 4236760739, 146342123,  44150713,   4137646577,
+            4012930520, 453944208,  3698224522, 676379586,  838842347,
+            3317784995, 3134348590, 1324125030, 1464043343, 2742898951,
+            1679662877, 2418231637, 2307671420, 2108855092, 2646416344,
+            1770245520, 1881981369, 2215778289, 1131600363, 3075215267,
+            2934113162, 1524487618, 634317135,  3522182919, 3361682222,
+            1013048678, 4211157884, 255851828,  378597661,  3803064149,
+            3904276487, 478699087,  86463078,   4044981294, 913918516,
+            3259473020, 3689451605, 802571805,  1355119248, 2767957208,
+            3176440049, 1231713977, 2383067299, 2050256619, 1671127746,
+            2544219274,
+        },
+        {
+            0,          3411442597, 2470478267, 1477900830, 594376071,
+            3896184354, 2955801660, 2071695257, 1188752142, 2374799531,
+            3583666869, 516690192,  1706532489, 2934039852, 4143390514,
+            1033987223, 2377504284, 1189326265, 519395239,  3584240642,
+            2933433243, 1703860286, 1033380384, 4140718469, 3413064978,
+            3753655,    1479523497, 2474231564, 3892463765, 592720688,
+            2067974446, 2954146443, 512219849,  3587285356, 2378652530,
+            1183916247, 1038790478, 4139570411, 2930388725, 1711035728,
+            1482502599, 2466990690, 3407720572, 4967385,    2066760768,
+            2959491045, 3899704827, 589741662,  2469530837, 1482979184,
+            7507310,    3408197323, 2959046994, 2064188151, 589297897,
+            3897131852, 3588810715, 515808382,  1185441376, 2382241221,
+            4135948892, 1037298169, 1707414503, 2928896066, 1024439698,
+            4133080631, 2924426281, 1696157580, 509788181,  3577002928,
+            2367832494, 1182022155, 2077580956, 2961384761, 3902136103,
+            600024194,  1488464667, 2481868990, 3422071456, 11456773,
+            2965005198, 2079070251, 603644469,  3903625616, 2480346633,
+            1484877228, 9934770,    3418483735, 4133521536, 1027011365,
+            1696598331, 2926998174, 3574463751, 509314722,  1179483324,
+            2367358745, 596143963,  3906868478, 2965958368, 2073990469,
+            15014620,   3417530745, 2477103975, 1492377794, 1699906645,
+            2919563248, 4128376302, 1027898955, 1178595794, 2372504183,
+            3581898857, 506006476,  2923280711, 1701561058, 1031616764,
+            4130030425, 2370882752, 1174845285, 504384891,  3578148574,
+            3907473993, 598813164,  2074596338, 2968627287, 3414829006,
+            14441579,   1489675893, 2476531152, 2048879396, 2974355585,
+            3915377311, 571052346,  1500651171, 2451858694, 3392315160,
+            23389373,   1019576362, 4153670543, 2944729489, 1691580980,
+            531166637,  3573452296, 2364044310, 1203638195, 4155161912,
+            1023198877, 1693072515, 2948351782, 3569862847, 529642266,
+            1200048388, 2362520225, 2976929334, 2049322387, 573626253,
+            3915820072, 2451383217, 1498109972, 22913546,   3389774255,
+            1687728621, 2949565000, 4158140502, 1015958515, 1207288938,
+            2359541711, 3568649681, 534986356,  574773987,  3910410566,
+            2969754456, 2052366589, 19869540,   3396949185, 2456792799,
+            1496962426, 3912067057, 578493524,  2054022730, 2973474287,
+            3393196662, 18246099,   1493210061, 2455169128, 2952236287,
+            1688336218, 1018629444, 4158748385, 2358966648, 1204585181,
+            534411459,  3565945702, 1192287926, 2353440019, 3562037005,
+            520496296,  1685957425, 2938884244, 4147980938, 1013666095,
+            30029240,   3399241245, 2458563587, 1507643302, 581386303,
+            3924900762, 2984755588, 2058467873, 3399813290, 32731919,
+            1508215057, 2461266612, 3922230573, 580781704,  2055797910,
+            2984150835, 2357191588, 1193908225, 524247583,  3563657658,
+            2937230883, 1682238854, 1012012952, 4144262205, 1503069311,
+            2462154714, 3403122116, 25296481,   2063233528, 2980842077,
+            3921342531, 585927654,  525201265,  3558577364, 2349690570,
+            1197151599, 1008769782, 4151763283, 2942311245, 1681285352,
+            3559051875, 527739334,  1197626328, 2352228477, 4149192676,
+            1008327745, 1678714463, 2941869562, 2465741165, 1504592584,
+            28883158,   3404645235, 2979351786, 2059614031, 584437073,
+            3917723380,
+        },
+        {
+            0,          2540828609, 722442611,  3162402482, 1444885222,
+            3245262119, 2098244501, 3932249172, 2889770444, 995070477,
+            2268200127, 272632702,  4196489002, 1834000619, 3509505625,
+            1180645784, 1569766761, 3403762344, 1990140954, 3790525403,
+            193957775,  2633922638, 545265404,  3086082365, 4054767781,
+            1725902692, 3668001238, 1305523735, 2813454915, 817896834,
+            2361291568, 466584817,  3139533522, 743476499,  2418992033,
+            123671648,  3980281908, 2052046837, 3325153607, 1363158662,
+            387915550,  2154752223, 1007715949, 2875290028, 1090530808,
+            3597785657, 1779414155, 4252910410, 3870410683, 1908420730,
+            3451805384, 1523558665, 2964256093, 668926620,  2611047470,
+            214997999,  1250927223, 3724432822, 1635793668, 4143041733,
+            479236241,  2346805072, 933169634,  2700017187, 1940816725,
+            3839849620, 1486952998, 3486576103, 632402355,  2998945394,
+            247343296,  2580537089, 3750815385, 1222709592, 4104093674,
+            1676576811, 2307904639, 519971774,  2726317324, 905034445,
+            775831100,  3109014013, 87140175,   2453688462, 2015431898,
+            4015061787, 1395561897, 3294585448, 2181061616, 359771185,
+            2836382339, 1048458562, 3558828310, 1131323095, 4279300197,
+            1751189412, 3364878727, 1610485318, 3816841460, 1961989941,
+            2660289377, 165756064,  3047117330, 586065363,  1689361483,
+            4089473930, 1337853240, 3637506809, 850308781,  2782878060,
+            429995998,  2396045343, 2501854446, 40809263,   3188776349,
+            694233692,  3271587336, 1416724937, 3893358459, 2138970298,
+            958472482,  2924533475, 305051729,  2237616016, 1866339268,
+            4165985285, 1144097463, 3544218998, 3881633450, 1881993579,
+            3427966937, 1529047064, 2973905996, 640926605,  2588781887,
+            222059262,  1264804710, 3692205223, 1617754645, 4145876436,
+            494686592,  2316150337, 913557747,  2701279026, 3134045123,
+            767314946,  2445419184, 112448881,  3973220645, 2074312420,
+            3353153622, 1353508759, 385080847,  2172791246, 1039943548,
+            2861412541, 1089268969, 3617397544, 1810068890, 4237460059,
+            1551662200, 3406662585, 2004083979, 3758232266, 174280350,
+            2635250015, 560781293,  3055362092, 4030863796, 1731456629,
+            3679289543, 1279031046, 2791123794, 825023635,  2371007009,
+            438519264,  32293137,   2526885584, 719542370,  3180507043,
+            1475605495, 3229746230, 2096917124, 3951926597, 2916263133,
+            983782172,  2262646190, 296536687,  4224554555, 1824285178,
+            3502378824, 1202976905, 2498987519, 58880574,   3220970636,
+            680389453,  3270293273, 1436369112, 3923979882, 2123553195,
+            953016371,  2948339698, 331512128,  2226359937, 1859310293,
+            4188218644, 1172130726, 3534535783, 3378722966, 1578291031,
+            3798770149, 1964856868, 2675706480, 135134641,  3027473155,
+            587359426,  1700617562, 4063013531, 1314047017, 3642962920,
+            859991996,  2754844797, 407762639,  2403074318, 802357037,
+            3097692396, 81618526,   2477560223, 2043530699, 4005313034,
+            1388467384, 3316884345, 2213321441, 345861408,  2833449874,
+            1066595411, 3589515271, 1115840454, 4277940596, 1770899125,
+            1916944964, 3845371269, 1498274615, 3460050166, 610103458,
+            3006039907, 257092049,  2552438288, 3732678536, 1225642057,
+            4118003451, 1644316986, 2288194926, 521331375,  2741799965,
+            874347484,
+        },
+        {
+            0,          829543472,  1659086944, 1402109008, 3318173888,
+            4105602288, 2804218016, 2522164368, 2388842353, 3205694273,
+            3967909649, 3723537185, 1269139377, 2060735361, 692465617,
+            406322145,  422172691,  676858915,  2076864627, 1253811267,
+            3706620115, 3986644195, 3188531379, 2407330947, 2538278754,
+            2788875090, 4121470722, 3302585138, 1384931234, 1677560722,
+            812644290,  18752498,   844345382,  52585494,   1353717830,
+            1640090742, 4153729254, 3336910038, 2507622534, 2751896758,
+            3157354327, 2369827687, 3738357559, 4020443911, 2046179223,
+            1216865191, 454402039,  711216071,  729442357,  436976645,
+            1234813013, 2028475493, 4005378293, 3754749125, 2355007637,
+            3173991589, 2769862468, 2489936756, 3355121444, 4136289044,
+            1625288580, 1370373044, 37504996,   860722132,  1688690764,
+            1440134268, 105170988,  926227484,  2707435660, 2417091772,
+            3280181484, 4075965660, 3938826045, 3686032141, 2284199773,
+            3109538669, 788719613,  510866381,  1306611613, 2089851821,
+            2106505311, 1291807855, 527241279,  773637135,  3091851423,
+            2302164143, 3668590847, 3957036239, 4092358446, 3265116958,
+            2433730382, 2692617086, 908804078,  123399134,  1422432142,
+            1706640318, 1458884714, 1736770650, 873953290,  90614842,
+            2469626026, 2722256026, 4056950986, 3231841530, 3633710875,
+            3924284203, 3128274811, 2332326731, 491870171,  740328427,
+            2142437307, 1321413515, 1339885689, 2125257801, 759078937,
+            474969129,  2316982457, 3144387721, 3908694233, 3649578217,
+            3250577160, 4040035128, 2740746088, 2452464472, 75009992,
+            889805816,  1721444264, 1475015576, 3377381528, 4164883624,
+            2880268536, 2598157512, 210341976,  1039680616, 1852454968,
+            1595665416, 1194072041, 1985856473, 634371977,  348023737,
+            2196457257, 3013251865, 3758681929, 3514383225, 3496417419,
+            3776367803, 2995040491, 2213897435, 362825803,  617716859,
+            2000937003, 1177695259, 1577439226, 1869880266, 1021732762,
+            228045738,  2613223226, 2863876874, 4179703642, 3360744298,
+            4213010622, 3396117646, 2583615710, 2827947246, 1054482558,
+            262927438,  1547274270, 1833458734, 1971300303, 1141797887,
+            396103599,  653122463,  2964911887, 2177442623, 3529203567,
+            3811216223, 3795101869, 3544546461, 2161574093, 2980500733,
+            670300269,  377629789,  1158696973, 1952547901, 1817608156,
+            1562881004, 246798268,  1069810572, 2844864284, 2564881196,
+            3413280636, 4194521932, 2917769428, 2627237092, 3473541300,
+            4269530244, 1747906580, 1499407396, 181229684,  1002212420,
+            596342693,  318415765,  1097392069, 1880689653, 3863750501,
+            3611161429, 2226097925, 3051248437, 3032512711, 2243013879,
+            3592671399, 3880912023, 1896294407, 1081539639, 333742183,
+            580211799,  983740342,  198409094,  1480656854, 1764807654,
+            4284874614, 3457428294, 2642827030, 2901902118, 2679771378,
+            2932589762, 4250515602, 3425201314, 1518157874, 1795986434,
+            949938258,  166673506,  299419523,  547951539,  1933275107,
+            1112194003, 3558840131, 3849208691, 3069984547, 2274224915,
+            2257832161, 3085049041, 3832569985, 3573658801, 1129617441,
+            1915046929, 565653569,  281470065,  150019984,  964742048,
+            1779611632, 1533240256, 3442888528, 4232551264, 2950031152,
+            2661561088,
+        },
+        {
+            0,          819083365,  1638166730, 1366706351, 3276333460,
+            4087011825, 2733412702, 2453580091, 2206053849, 3014626748,
+            3805922579, 3524001142, 1077236813, 1894214696, 563160199,
+            289610978,  51846467,   868558118,  1655926153, 1382110700,
+            3227516119, 4035822770, 2717617181, 2435429496, 2154473626,
+            2964885759, 3788429392, 3508330549, 1126320398, 1945137515,
+            579221956,  307495329,  103692934,  922485475,  1737116236,
+            1465414185, 3311852306, 4122272631, 2764221400, 2484114365,
+            2236845919, 3045177146, 3841458069, 3559245808, 1176202955,
+            1992906414, 666836481,  393029220,  87631813,   904601504,
+            1688033039, 1414492010, 3329345105, 4137942580, 2815800987,
+            2533854974, 2252640796, 3063327353, 3890275030, 3610434227,
+            1158443912, 1977502701, 614990658,  343554855,  207385868,
+            1015958889, 1844970950, 1563049379, 3474232472, 4291210493,
+            2930828370, 2657279031, 2401353941, 3220437168, 4001738783,
+            3730278522, 1281958209, 2092636452, 768430475,  488597998,
+            256600143,  1067012138, 1861163141, 1581064416, 3422783963,
+            4241600958, 2913466641, 2641740148, 2352405910, 3169117683,
+            3985812828, 3711997241, 1333672962, 2141979751, 786058440,
+            503870637,  175263626,  983594991,  1809203008, 1526990629,
+            3376066078, 4192769659, 2828984020, 2555176625, 2299525715,
+            3118318134, 3903556249, 3631854332, 1246174151, 2056594338,
+            736324365,  456217448,  157635273,  968321708,  1757487619,
+            1477646950, 3391992669, 4211051320, 2877932439, 2606496754,
+            2316887824, 3133857653, 3955005402, 3681464255, 1229981316,
+            2038578913, 687109710,  405163563,  414771736,  678089341,
+            2031917778, 1238278839, 3689941900, 3944887273, 3126098758,
+            2324054819, 2613403585, 2870437796, 4200673035, 3400734574,
+            1485684309, 1751090736, 959041183,  167507706,  464516955,
+            729665342,  2047575953, 1255784436, 3639023311, 3895799466,
+            3108201989, 2308005472, 2563916418, 2818603751, 4185272904,
+            3382970925, 1536860950, 1799920499, 977195996,  183299001,
+            513200286,  776268027,  2134024276, 1340119089, 3722326282,
+            3976989039, 3162128832, 2359851429, 2649449799, 2906217762,
+            4233041293, 3432852968, 1587774675, 1852947638, 1057485849,
+            265669756,  495046109,  760477112,  2082848023, 1291289970,
+            3737726025, 3994752044, 3211615363, 2411685094, 2667345924,
+            2922266721, 4283959502, 3481940139, 1572116880, 1835442677,
+            1007741274, 214094143,  350527252,  607561585,  1967189982,
+            1167251387, 3618406016, 3883812581, 3053981258, 2262447663,
+            2543397581, 2806715048, 4131215879, 3337577058, 1423035225,
+            1677980476, 896908179,  94864374,   401834583,  656521778,
+            1985475229, 1183173368, 3569050563, 3832109990, 3038712585,
+            2244815724, 2492348302, 2757496811, 4113188676, 3321397025,
+            1472648730, 1729425023, 912434896,  112238261,  315270546,
+            572038647,  1936643416, 1136454973, 3514975238, 3780148323,
+            2955293900, 2163477673, 2444693579, 2707761198, 4027801729,
+            3233896676, 1392505311, 1647167930, 861634837,  59357552,
+            299743441,  554664116,  1887029275, 1085010046, 3533003077,
+            3796328736, 3006343567, 2212696554, 2459962632, 2725393773,
+            4077157826, 3285599655, 1374219420, 1631245561, 810327126,
+            10396723,
+        },
+        {
+            0,          1409766726, 2819533452, 4228513738, 1441866729,
+            32929455,   4261382501, 2851658787, 2883733458, 4293202580,
+            65858910,   1475065880, 4262683707, 2853450109, 1444794039,
+            35298289,   1378416981, 103787539,  4196815833, 2921399967,
+            131717820,  1407094778, 2950131760, 4224722294, 4190813831,
+            2915953601, 1371804683, 96682317,   2889588078, 4164732968,
+            70596578,   1345479332, 2756833962, 4032210924, 207575078,
+            1482165600, 4053848387, 2779218949, 1504607183, 229191305,
+            263435640,  1538580542, 2814189556, 4089072306, 1514313361,
+            239453143,  4065082397, 2789960027, 4135128063, 2726190777,
+            1584898419, 175174709,  2743609366, 4153376080, 193364634,
+            1602344924, 1570458669, 161225067,  4120241825, 2710746087,
+            141193156,  1550662274, 2690958664, 4100165646, 1297060773,
+            424199907,  3846256937, 2974182511, 415150156,  1287251210,
+            2964331200, 3837218694, 3870151799, 2997518641, 1319337723,
+            446966717,  3009214366, 3881542360, 458382610,  1330972756,
+            526871280,  1264598966, 3077161084, 3815675194, 1251363097,
+            512826463,  3801670549, 3063920339, 3028626722, 3766646884,
+            478906286,  1217188584, 3782479563, 3044236173, 1232774215,
+            494792961,  3911082255, 3172545609, 1091619715, 353869509,
+            3169796838, 3907524512, 350349418,  1088863532, 1123821277,
+            385577883,  3941764177, 3203782935, 386729268,  1124749426,
+            3204689848, 3942972158, 3140917338, 4013018396, 322450134,
+            1195337616, 4006067123, 3133206261, 1187582271, 315507833,
+            282386312,  1154714318, 3101324548, 3973914690, 1160117345,
+            287484199,  3979040493, 3106669483, 2594121546, 3466097164,
+            848399814,  1721161856, 3480093859, 2607370725, 1734389295,
+            862452585,  830300312,  1702507998, 2574502420, 3446972242,
+            1686913905, 814421559,  3431131645, 2558901435, 3367493151,
+            2628815705, 1622766739, 884875733,  2638675446, 3376523440,
+            893933434,  1632567868, 1666554317, 928173195,  3411751745,
+            2673632775, 916765220,  1654910818, 2661945512, 3400353262,
+            1053742560, 1791590566, 2529197932, 3267832362, 1799353865,
+            1060676431, 3274792069, 2536901059, 2502726194, 3240871796,
+            1025652926, 1764060664, 3235754459, 2497373341, 1758665559,
+            1020546577, 1827024053, 954300915,  3303573049, 2431636351,
+            957812572,  1829788186, 2434377168, 3307139222, 3338955623,
+            2466463265, 1862975979, 990745773,  2465548430, 3337756104,
+            989585922,  1862055748, 3620779247, 2211963305, 2145263203,
+            735660837,  2183239430, 3592864320, 707739018,  2116577484,
+            2083713853, 674604667,  3560724913, 2151353591, 700698836,
+            2110031250, 2177727064, 3586797342, 2247642554, 3523156220,
+            771155766,  2045882992, 3490278995, 2215525141, 2013775071,
+            738234777,  773458536,  2048745262, 2249498852, 3524523426,
+            2079009153, 804027591,  3555033869, 2279790155, 1937851973,
+            663098115,  3683642569, 2408102287, 644900268,  1920413930,
+            2390675232, 3665402470, 3630367127, 2355385553, 1886235419,
+            610991709,  2375164542, 3650451256, 631015666,  1906040244,
+            564772624,  1974397526, 2309428636, 3718267098, 1951964409,
+            543148479,  3696637557, 2287035187, 2320234690, 3729567108,
+            574968398,  1984038664, 3753564971, 2344455789, 2008314279,
+            598942945,
+        },
+        {
+            0,          1737424129, 3474848258, 2828207875, 2614592245,
+            4233723892, 1422555383, 860128758,  843281179,  1439534618,
+            4250831129, 2597352472, 2845110766, 3457813743, 1720257516,
+            17299181,   1686562358, 50862903,   2879069236, 3423985973,
+            4283524291, 2564790722, 810327745,  1472357312, 1455789357,
+            827025452,  2581098287, 4267086382, 3440515032, 2862410457,
+            34598362,   1702957275, 3373124716, 2927833453, 101725806,
+            1637796719, 1390038681, 894743448,  2647110811, 4199106970,
+            4216242039, 2629845622, 877872501,  1407039604, 1620655490,
+            118997123,  2944714624, 3356113537, 2911578714, 3389380443,
+            1654050904, 85470553,   912042159,  1372738990, 4181807789,
+            2664411052, 2680707393, 4165379136, 1356178243, 928734786,
+            69196724,   1670457013, 3405914550, 2894912695, 2549607977,
+            4034466600, 1491735595, 1063577898, 203451612,  1806602717,
+            3275593438, 2763221983, 2780077362, 3258605619, 1789486896,
+            220699185,  1046683591, 1508762310, 4051625413, 2532317380,
+            4084271135, 2499802398, 1013772829, 1541541660, 1755745002,
+            254310379,  2814079208, 3224735209, 3241310980, 2797372933,
+            237994246,  1772190727, 1525021169, 1030423792, 2516059123,
+            4067884786, 1593451077, 963960644,  2447890503, 4134085958,
+            3308101808, 2728615345, 170941106,  1841211315, 1824084318,
+            188197983,  2745477980, 3291108957, 4151235499, 2430611114,
+            947071401,  1610470568, 981255283,  1576155506, 4116790897,
+            2465186672, 2712356486, 3324361607, 1857469572, 154681733,
+            138393448,  1873889897, 3340914026, 2695671915, 2481468829,
+            4100376732, 1559613343, 997929630,  704883363,  1301108642,
+            3843969185, 2190519712, 2983471190, 3596277079, 2127155796,
+            424095573,  406903224,  2144216249, 3613205434, 2966675131,
+            2207734605, 3826886220, 1284153679, 721706062,  1317358741,
+            688632212,  2174269079, 3860220822, 3578973792, 3000775521,
+            441398370,  2109852003, 2093367182, 457753231,  3017524620,
+            3562354829, 3876699515, 2157920378, 671893369,  1333967480,
+            3809371855, 2223021006, 739482829,  1268605388, 2027545658,
+            525801787,  3083083320, 3494568761, 3511490004, 3066292437,
+            508620758,  2044596951, 1251645217, 756312608,  2240245027,
+            3792277538, 2273870073, 3758521848, 1217755899, 790333434,
+            475988492,  2077359885, 3544381454, 3033269519, 3050042338,
+            3527741155, 2060847584, 492369121,  773615895,  1234340886,
+            3774974741, 2257548820, 3186902154, 3665475979, 1927921288,
+            359089033,  639878783,  1101871998, 3913170045, 2393948540,
+            2411149201, 3896101520, 1084935571, 656683154,  341882212,
+            1944995941, 3682422630, 3170087527, 3648168636, 3204210621,
+            376395966,  1910613439, 1118117961, 623631688,  2377701963,
+            3929417546, 3945910695, 2361339046, 606874533,  1134745252,
+            1894142802, 392736339,  3220941136, 3631567953, 1962510566,
+            326596071,  3152311012, 3697971173, 4012771859, 2292250386,
+            540274705,  1203571984, 1186659325, 557057788,  2309423615,
+            3995729150, 3714939144, 3135472649, 309363466,  1979612683,
+            276786896,  2012320721, 3747779794, 3102501331, 2343103525,
+            3961917732, 1152718375, 591129382,  574365131,  1169350858,
+            3978422217, 2326731464, 3119226686, 3731186239, 1995859260,
+            293115965,
+        },
+        {
+            0,          4060876286, 3790892301, 335044851,  3322195179,
+            872980757,  670089702,  3590114328, 2313498407, 2078876377,
+            1745961514, 2585612244, 1340179404, 3186462258, 2920672961,
+            1545200447, 371599551,  3827967297, 4157752754, 98453580,
+            3491923028, 573475242,  836168025,  3285902503, 2680358808,
+            1842285158, 2117560981, 2352703339, 1506257779, 2882250381,
+            3090400894, 1245694848, 743199102,  3728759936, 3451403379,
+            1068773773, 3930652053, 407171179,  196907160,  4189101414,
+            2779348569, 1470460839, 1146950484, 3058769578, 1672336050,
+            2443304780, 2186919871, 1884664385, 980056513,  3362157631,
+            3684570316, 697440562,  4235121962, 241359060,  496678951,
+            4019631577, 3012515558, 1099127576, 1383807979, 2692167189,
+            1972107789, 2273834995, 2491389696, 1718852350, 1486398204,
+            2861870850, 3110916081, 1264632335, 2661027351, 1821377513,
+            2137547546, 2372169444, 3514666459, 594640933,  814342358,
+            3263556904, 393814320,  3849661646, 4136455229, 75579843,
+            1321110083, 3165816765, 2940921678, 1564928688, 2293900968,
+            2058758998, 1766738853, 2604811867, 3344672100, 894937242,
+            649054313,  3567502743, 23005583,   4082304113, 3769328770,
+            312961404,  1960113026, 2262367868, 2501942927, 1730974577,
+            3000000361, 1088180887, 1394881124, 2703769498, 4247903397,
+            255709531,  482718120,  4006198358, 993357902,  3375988144,
+            3670089027, 684527805,  1660083005, 2432620227, 2198255152,
+            1896528846, 2767615958, 1459255848, 1157765851, 3071153957,
+            3944215578, 421263844,  182688023,  4176450793, 756242673,
+            3743372559, 3437704700, 1055602690, 2972796408, 1128089606,
+            1355098357, 2731091211, 2000021779, 2235163885, 2529264670,
+            1691191776, 953445087,  3403179809, 3642755026, 724306476,
+            4275095092, 215796682,  522496825,  3978864327, 2803330375,
+            1427857593, 1189281866, 3035565492, 1628684716, 2468334674,
+            2162666657, 1928044895, 787628640,  3707654046, 3473289069,
+            1024074387, 3908497035, 452649845,  151159686,  4212035192,
+            2642220166, 1869683064, 2089384331, 2391110773, 1534703725,
+            2843063699, 3129857376, 1216469150, 345521057,  3868472927,
+            4117517996, 123755346,  3533477706, 546347700,  862517831,
+            3244619705, 2338012217, 2035757511, 1789874484, 2560842954,
+            1298108626, 3209927980, 2896952799, 1588064289, 46011166,
+            4038205152, 3813309971, 289829869,  3300573173, 917942795,
+            625922808,  3611483910, 3920226052, 463858426,  140347913,
+            4199647223, 799886319,  3718333969, 3461949154, 1012214556,
+            1615644707, 2453718493, 2176361774, 1941219536, 2789762248,
+            1413769526, 1203505605, 3048211515, 4287614907, 226738757,
+            511419062,  3967266632, 965436240,  3414650542, 3632205405,
+            712180643,  1986715804, 2221337954, 2543750545, 1704099951,
+            2960018551, 1113735561, 1369055610, 2744528004, 3320166010,
+            938064772,  605150071,  3592279689, 65084049,   4058847087,
+            3793057692, 270105186,  1275107677, 3188495523, 2918511696,
+            1610152366, 2315531702, 2013804616, 1810913467, 2583450949,
+            3552812741, 567251771,  842527688,  3225157174, 365376046,
+            3888857040, 4097007395, 104813277,  1512485346, 2821372956,
+            3151158511, 1239339281, 2619481353, 1848512759, 2111205380,
+            2413460986,
+        },
+};
+
+static const uint32_t                //
+    wuffs_crc32__ieee_x2n_table[32]  //
+    WUFFS_BASE__POTENTIALLY_UNUSED = {
+        1073741824, 536870912,  134217728,  8388608,    32768,      3988292384,
+        2984685714, 2691310871, 3982654894, 2295415911, 3619421802, 3963911953,
+        2390663536, 1680310286, 1296546528, 167662735,  2206543119, 808857370,
+        2069535939, 838779241,  2683044394, 1821240772, 366380877,  1608415822,
+        3134787127, 776888047,  1319870996, 2829349568, 1117427358, 344797226,
+        3289097936, 3303156796,
+};
+
 static const uint32_t                 //
     wuffs_crc32__ieee_table[16][256]  //
     WUFFS_BASE__POTENTIALLY_UNUSED = {
@@ -12378,8 +14581,44 @@ static const uint32_t                 //
 
 // ---------------- Private Function Prototypes
 
+static wuffs_base__empty_struct  //
+wuffs_crc32__castagnoli_hasher__up(wuffs_crc32__castagnoli_hasher* self,
+                                   wuffs_base__slice_u8 a_x);
+
+static wuffs_base__empty_struct  //
+wuffs_crc32__castagnoli_hasher__up__choosy_default(
+    wuffs_crc32__castagnoli_hasher* self,
+    wuffs_base__slice_u8 a_x);
+
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+static wuffs_base__empty_struct  //
+wuffs_crc32__castagnoli_hasher__up_x86_sse42(
+    wuffs_crc32__castagnoli_hasher* self,
+    wuffs_base__slice_u8 a_x);
+#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_64)
+
+static wuffs_base__empty_struct  //
+wuffs_crc32__ieee_hasher__up(wuffs_crc32__ieee_hasher* self,
+                             wuffs_base__slice_u8 a_x);
+
+static wuffs_base__empty_struct  //
+wuffs_crc32__ieee_hasher__up__choosy_default(wuffs_crc32__ieee_hasher* self,
+                                             wuffs_base__slice_u8 a_x);
+
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+static wuffs_base__empty_struct  //
+wuffs_crc32__ieee_hasher__up_x86_sse42(wuffs_crc32__ieee_hasher* self,
+                                       wuffs_base__slice_u8 a_x);
+#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_64)
+
 // ---------------- VTables
 
+const wuffs_base__hasher_u32__func_ptrs
+    wuffs_crc32__castagnoli_hasher__func_ptrs_for__wuffs_base__hasher_u32 = {
+        (uint32_t(*)(void*, wuffs_base__slice_u8))(
+            &wuffs_crc32__castagnoli_hasher__update_u32),
+};
+
 const wuffs_base__hasher_u32__func_ptrs
     wuffs_crc32__ieee_hasher__func_ptrs_for__wuffs_base__hasher_u32 = {
         (uint32_t(*)(void*, wuffs_base__slice_u8))(
@@ -12388,6 +14627,61 @@ const wuffs_base__hasher_u32__func_ptrs
 
 // ---------------- Initializer Implementations
 
+wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT  //
+wuffs_crc32__castagnoli_hasher__initialize(wuffs_crc32__castagnoli_hasher* self,
+                                           size_t sizeof_star_self,
+                                           uint64_t wuffs_version,
+                                           uint32_t initialize_flags) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (sizeof(*self) != sizeof_star_self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_sizeof_receiver);
+  }
+  if (((wuffs_version >> 32) != WUFFS_VERSION_MAJOR) ||
+      (((wuffs_version >> 16) & 0xFFFF) > WUFFS_VERSION_MINOR)) {
+    return wuffs_base__make_status(wuffs_base__error__bad_wuffs_version);
+  }
+
+  if ((initialize_flags & WUFFS_INITIALIZE__ALREADY_ZEROED) != 0) {
+// The whole point of this if-check is to detect an uninitialized *self.
+// We disable the warning on GCC. Clang-5.0 does not have this warning.
+#if !defined(__clang__) && defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+    if (self->private_impl.magic != 0) {
+      return wuffs_base__make_status(
+          wuffs_base__error__initialize_falsely_claimed_already_zeroed);
+    }
+#if !defined(__clang__) && defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+  } else {
+    if ((initialize_flags &
+         WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED) == 0) {
+      memset(self, 0, sizeof(*self));
+      initialize_flags |= WUFFS_INITIALIZE__ALREADY_ZEROED;
+    } else {
+      memset(&(self->private_impl), 0, sizeof(self->private_impl));
+    }
+  }
+
+  self->private_impl.choosy_up =
+      &wuffs_crc32__castagnoli_hasher__up__choosy_default;
+  self->private_impl.magic = WUFFS_BASE__MAGIC;
+  self->private_impl.vtable_for__wuffs_base__hasher_u32.vtable_name =
+      wuffs_base__hasher_u32__vtable_name;
+  self->private_impl.vtable_for__wuffs_base__hasher_u32.function_pointers =
+      (const void*)(&wuffs_crc32__castagnoli_hasher__func_ptrs_for__wuffs_base__hasher_u32);
+  return wuffs_base__make_status(NULL);
+}
+
+size_t  //
+sizeof__wuffs_crc32__castagnoli_hasher() {
+  return sizeof(wuffs_crc32__castagnoli_hasher);
+}
+
 wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT  //
 wuffs_crc32__ieee_hasher__initialize(wuffs_crc32__ieee_hasher* self,
                                      size_t sizeof_star_self,
@@ -12428,6 +14722,7 @@ wuffs_crc32__ieee_hasher__initialize(wuffs_crc32__ieee_hasher* self,
     }
   }
 
+  self->private_impl.choosy_up = &wuffs_crc32__ieee_hasher__up__choosy_default;
   self->private_impl.magic = WUFFS_BASE__MAGIC;
   self->private_impl.vtable_for__wuffs_base__hasher_u32.vtable_name =
       wuffs_base__hasher_u32__vtable_name;
@@ -12443,11 +14738,11 @@ sizeof__wuffs_crc32__ieee_hasher() {
 
 // ---------------- Function Implementations
 
-// -------- func crc32.ieee_hasher.update_u32
+// -------- func crc32.castagnoli_hasher.update_u32
 
 WUFFS_BASE__MAYBE_STATIC uint32_t  //
-wuffs_crc32__ieee_hasher__update_u32(wuffs_crc32__ieee_hasher* self,
-                                     wuffs_base__slice_u8 a_x) {
+wuffs_crc32__castagnoli_hasher__update_u32(wuffs_crc32__castagnoli_hasher* self,
+                                           wuffs_base__slice_u8 a_x) {
   if (!self) {
     return 0;
   }
@@ -12455,10 +14750,34 @@ wuffs_crc32__ieee_hasher__update_u32(wuffs_crc32__ieee_hasher* self,
     return 0;
   }
 
+  if (self->private_impl.f_state == 0) {
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+    if (wuffs_base__cpu_arch__have_x86_sse42()) {
+      self->private_impl.choosy_up =
+          &wuffs_crc32__castagnoli_hasher__up_x86_sse42;
+    }
+#endif
+  }
+  wuffs_crc32__castagnoli_hasher__up(self, a_x);
+  return self->private_impl.f_state;
+}
+
+// -------- func crc32.castagnoli_hasher.up
+
+static wuffs_base__empty_struct  //
+wuffs_crc32__castagnoli_hasher__up(wuffs_crc32__castagnoli_hasher* self,
+                                   wuffs_base__slice_u8 a_x) {
+  return (*self->private_impl.choosy_up)(self, a_x);
+}
+
+static wuffs_base__empty_struct  //
+wuffs_crc32__castagnoli_hasher__up__choosy_default(
+    wuffs_crc32__castagnoli_hasher* self,
+    wuffs_base__slice_u8 a_x) {
   uint32_t v_s = 0;
   wuffs_base__slice_u8 v_p = {0};
 
-  v_s = (4294967295 ^ self->private_impl.f_state);
+  v_s = (4294967295u ^ self->private_impl.f_state);
   {
     wuffs_base__slice_u8 i_slice_p = a_x;
     v_p = i_slice_p;
@@ -12468,42 +14787,42 @@ wuffs_crc32__ieee_hasher__update_u32(wuffs_crc32__ieee_hasher* self,
       v_s ^=
           ((((uint32_t)(v_p.ptr[0])) << 0) | (((uint32_t)(v_p.ptr[1])) << 8) |
            (((uint32_t)(v_p.ptr[2])) << 16) | (((uint32_t)(v_p.ptr[3])) << 24));
-      v_s = (wuffs_crc32__ieee_table[0][v_p.ptr[15]] ^
-             wuffs_crc32__ieee_table[1][v_p.ptr[14]] ^
-             wuffs_crc32__ieee_table[2][v_p.ptr[13]] ^
-             wuffs_crc32__ieee_table[3][v_p.ptr[12]] ^
-             wuffs_crc32__ieee_table[4][v_p.ptr[11]] ^
-             wuffs_crc32__ieee_table[5][v_p.ptr[10]] ^
-             wuffs_crc32__ieee_table[6][v_p.ptr[9]] ^
-             wuffs_crc32__ieee_table[7][v_p.ptr[8]] ^
-             wuffs_crc32__ieee_table[8][v_p.ptr[7]] ^
-             wuffs_crc32__ieee_table[9][v_p.ptr[6]] ^
-             wuffs_crc32__ieee_table[10][v_p.ptr[5]] ^
-             wuffs_crc32__ieee_table[11][v_p.ptr[4]] ^
-             wuffs_crc32__ieee_table[12][(255 & (v_s >> 24))] ^
-             wuffs_crc32__ieee_table[13][(255 & (v_s >> 16))] ^
-             wuffs_crc32__ieee_table[14][(255 & (v_s >> 8))] ^
-             wuffs_crc32__ieee_table[15][(255 & (v_s >> 0))]);
+      v_s = (wuffs_crc32__castagnoli_table[0][v_p.ptr[15]] ^
+             wuffs_crc32__castagnoli_table[1][v_p.ptr[14]] ^
+             wuffs_crc32__castagnoli_table[2][v_p.ptr[13]] ^
+             wuffs_crc32__castagnoli_table[3][v_p.ptr[12]] ^
+             wuffs_crc32__castagnoli_table[4][v_p.ptr[11]] ^
+             wuffs_crc32__castagnoli_table[5][v_p.ptr[10]] ^
+             wuffs_crc32__castagnoli_table[6][v_p.ptr[9]] ^
+             wuffs_crc32__castagnoli_table[7][v_p.ptr[8]] ^
+             wuffs_crc32__castagnoli_table[8][v_p.ptr[7]] ^
+             wuffs_crc32__castagnoli_table[9][v_p.ptr[6]] ^
+             wuffs_crc32__castagnoli_table[10][v_p.ptr[5]] ^
+             wuffs_crc32__castagnoli_table[11][v_p.ptr[4]] ^
+             wuffs_crc32__castagnoli_table[12][(255 & (v_s >> 24))] ^
+             wuffs_crc32__castagnoli_table[13][(255 & (v_s >> 16))] ^
+             wuffs_crc32__castagnoli_table[14][(255 & (v_s >> 8))] ^
+             wuffs_crc32__castagnoli_table[15][(255 & (v_s >> 0))]);
       v_p.ptr += 16;
       v_s ^=
           ((((uint32_t)(v_p.ptr[0])) << 0) | (((uint32_t)(v_p.ptr[1])) << 8) |
            (((uint32_t)(v_p.ptr[2])) << 16) | (((uint32_t)(v_p.ptr[3])) << 24));
-      v_s = (wuffs_crc32__ieee_table[0][v_p.ptr[15]] ^
-             wuffs_crc32__ieee_table[1][v_p.ptr[14]] ^
-             wuffs_crc32__ieee_table[2][v_p.ptr[13]] ^
-             wuffs_crc32__ieee_table[3][v_p.ptr[12]] ^
-             wuffs_crc32__ieee_table[4][v_p.ptr[11]] ^
-             wuffs_crc32__ieee_table[5][v_p.ptr[10]] ^
-             wuffs_crc32__ieee_table[6][v_p.ptr[9]] ^
-             wuffs_crc32__ieee_table[7][v_p.ptr[8]] ^
-             wuffs_crc32__ieee_table[8][v_p.ptr[7]] ^
-             wuffs_crc32__ieee_table[9][v_p.ptr[6]] ^
-             wuffs_crc32__ieee_table[10][v_p.ptr[5]] ^
-             wuffs_crc32__ieee_table[11][v_p.ptr[4]] ^
-             wuffs_crc32__ieee_table[12][(255 & (v_s >> 24))] ^
-             wuffs_crc32__ieee_table[13][(255 & (v_s >> 16))] ^
-             wuffs_crc32__ieee_table[14][(255 & (v_s >> 8))] ^
-             wuffs_crc32__ieee_table[15][(255 & (v_s >> 0))]);
+      v_s = (wuffs_crc32__castagnoli_table[0][v_p.ptr[15]] ^
+             wuffs_crc32__castagnoli_table[1][v_p.ptr[14]] ^
+             wuffs_crc32__castagnoli_table[2][v_p.ptr[13]] ^
+             wuffs_crc32__castagnoli_table[3][v_p.ptr[12]] ^
+             wuffs_crc32__castagnoli_table[4][v_p.ptr[11]] ^
+             wuffs_crc32__castagnoli_table[5][v_p.ptr[10]] ^
+             wuffs_crc32__castagnoli_table[6][v_p.ptr[9]] ^
+             wuffs_crc32__castagnoli_table[7][v_p.ptr[8]] ^
+             wuffs_crc32__castagnoli_table[8][v_p.ptr[7]] ^
+             wuffs_crc32__castagnoli_table[9][v_p.ptr[6]] ^
+             wuffs_crc32__castagnoli_table[10][v_p.ptr[5]] ^
+             wuffs_crc32__castagnoli_table[11][v_p.ptr[4]] ^
+             wuffs_crc32__castagnoli_table[12][(255 & (v_s >> 24))] ^
+             wuffs_crc32__castagnoli_table[13][(255 & (v_s >> 16))] ^
+             wuffs_crc32__castagnoli_table[14][(255 & (v_s >> 8))] ^
+             wuffs_crc32__castagnoli_table[15][(255 & (v_s >> 0))]);
       v_p.ptr += 16;
     }
     v_p.len = 16;
@@ -12512,44 +14831,407 @@ wuffs_crc32__ieee_hasher__update_u32(wuffs_crc32__ieee_hasher* self,
       v_s ^=
           ((((uint32_t)(v_p.ptr[0])) << 0) | (((uint32_t)(v_p.ptr[1])) << 8) |
            (((uint32_t)(v_p.ptr[2])) << 16) | (((uint32_t)(v_p.ptr[3])) << 24));
-      v_s = (wuffs_crc32__ieee_table[0][v_p.ptr[15]] ^
-             wuffs_crc32__ieee_table[1][v_p.ptr[14]] ^
-             wuffs_crc32__ieee_table[2][v_p.ptr[13]] ^
-             wuffs_crc32__ieee_table[3][v_p.ptr[12]] ^
-             wuffs_crc32__ieee_table[4][v_p.ptr[11]] ^
-             wuffs_crc32__ieee_table[5][v_p.ptr[10]] ^
-             wuffs_crc32__ieee_table[6][v_p.ptr[9]] ^
-             wuffs_crc32__ieee_table[7][v_p.ptr[8]] ^
-             wuffs_crc32__ieee_table[8][v_p.ptr[7]] ^
-             wuffs_crc32__ieee_table[9][v_p.ptr[6]] ^
-             wuffs_crc32__ieee_table[10][v_p.ptr[5]] ^
-             wuffs_crc32__ieee_table[11][v_p.ptr[4]] ^
-             wuffs_crc32__ieee_table[12][(255 & (v_s >> 24))] ^
-             wuffs_crc32__ieee_table[13][(255 & (v_s >> 16))] ^
-             wuffs_crc32__ieee_table[14][(255 & (v_s >> 8))] ^
-             wuffs_crc32__ieee_table[15][(255 & (v_s >> 0))]);
+      v_s = (wuffs_crc32__castagnoli_table[0][v_p.ptr[15]] ^
+             wuffs_crc32__castagnoli_table[1][v_p.ptr[14]] ^
+             wuffs_crc32__castagnoli_table[2][v_p.ptr[13]] ^
+             wuffs_crc32__castagnoli_table[3][v_p.ptr[12]] ^
+             wuffs_crc32__castagnoli_table[4][v_p.ptr[11]] ^
+             wuffs_crc32__castagnoli_table[5][v_p.ptr[10]] ^
+             wuffs_crc32__castagnoli_table[6][v_p.ptr[9]] ^
+             wuffs_crc32__castagnoli_table[7][v_p.ptr[8]] ^
+             wuffs_crc32__castagnoli_table[8][v_p.ptr[7]] ^
+             wuffs_crc32__castagnoli_table[9][v_p.ptr[6]] ^
+             wuffs_crc32__castagnoli_table[10][v_p.ptr[5]] ^
+             wuffs_crc32__castagnoli_table[11][v_p.ptr[4]] ^
+             wuffs_crc32__castagnoli_table[12][(255 & (v_s >> 24))] ^
+             wuffs_crc32__castagnoli_table[13][(255 & (v_s >> 16))] ^
+             wuffs_crc32__castagnoli_table[14][(255 & (v_s >> 8))] ^
+             wuffs_crc32__castagnoli_table[15][(255 & (v_s >> 0))]);
       v_p.ptr += 16;
     }
     v_p.len = 1;
     uint8_t* i_end2_p = i_slice_p.ptr + (i_slice_p.len / 1) * 1;
     while (v_p.ptr < i_end2_p) {
-      v_s =
-          (wuffs_crc32__ieee_table[0][(((uint8_t)((v_s & 255))) ^ v_p.ptr[0])] ^
-           (v_s >> 8));
+      v_s = (wuffs_crc32__castagnoli_table[0][(((uint8_t)((v_s & 255))) ^
+                                               v_p.ptr[0])] ^
+             (v_s >> 8));
       v_p.ptr += 1;
     }
   }
-  self->private_impl.f_state = (4294967295 ^ v_s);
-  return self->private_impl.f_state;
+  self->private_impl.f_state = (4294967295u ^ v_s);
+  return wuffs_base__make_empty_struct();
 }
 
-#endif  // !defined(WUFFS_CONFIG__MODULES) ||
-        // defined(WUFFS_CONFIG__MODULE__CRC32)
+// -------- func crc32.castagnoli_hasher.up_x86_sse42
+
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2")
+    static wuffs_base__empty_struct  //
+    wuffs_crc32__castagnoli_hasher__up_x86_sse42(
+        wuffs_crc32__castagnoli_hasher* self,
+        wuffs_base__slice_u8 a_x) {
+  uint64_t v_s = 0;
+  uint64_t v_s1 = 0;
+  uint64_t v_s2 = 0;
+  wuffs_base__slice_u8 v_q0 = {0};
+  wuffs_base__slice_u8 v_q1 = {0};
+  wuffs_base__slice_u8 v_q2 = {0};
+  __m128i v_k = {0};
+  __m128i v_v = {0};
+  wuffs_base__slice_u8 v_p = {0};
+
+  v_s = ((uint64_t)((4294967295u ^ self->private_impl.f_state)));
+  v_k = _mm_set_epi64x((int64_t)(3716037388), (int64_t)(385906426));
+  while (((uint64_t)(a_x.len)) >= 1536) {
+    v_q0 = wuffs_base__slice_u8__subslice_ij(a_x, 0, 512);
+    v_q1 = wuffs_base__slice_u8__subslice_ij(a_x, 512, 1024);
+    v_q2 = wuffs_base__slice_u8__subslice_ij(a_x, 1024, 1536);
+    v_s1 = 0;
+    v_s2 = 0;
+    while ((((uint64_t)(v_q0.len)) >= 8) && (((uint64_t)(v_q1.len)) >= 8) &&
+           (((uint64_t)(v_q2.len)) >= 8)) {
+      v_s = ((uint64_t)(_mm_crc32_u64(
+          v_s, wuffs_base__load_u64le__no_bounds_check(v_q0.ptr))));
+      v_s1 = ((uint64_t)(_mm_crc32_u64(
+          v_s1, wuffs_base__load_u64le__no_bounds_check(v_q1.ptr))));
+      v_s2 = ((uint64_t)(_mm_crc32_u64(
+          v_s2, wuffs_base__load_u64le__no_bounds_check(v_q2.ptr))));
+      v_q0 = wuffs_base__slice_u8__subslice_i(v_q0, 8);
+      v_q1 = wuffs_base__slice_u8__subslice_i(v_q1, 8);
+      v_q2 = wuffs_base__slice_u8__subslice_i(v_q2, 8);
+    }
+    v_v = _mm_set_epi64x((int64_t)(v_s1), (int64_t)(v_s));
+    v_v = _mm_xor_si128(_mm_clmulepi64_si128(v_v, v_k, 0),
+                        _mm_clmulepi64_si128(v_v, v_k, 17));
+    v_s =
+        (((uint64_t)(_mm_crc32_u64(0, ((uint64_t)(_mm_cvtsi128_si64(v_v)))))) ^
+         v_s2);
+    a_x = wuffs_base__slice_u8__subslice_i(a_x, 1536);
+  }
+  while (((uint64_t)(a_x.len)) >= 8) {
+    v_s = ((uint64_t)(
+        _mm_crc32_u64(v_s, wuffs_base__load_u64le__no_bounds_check(a_x.ptr))));
+    a_x = wuffs_base__slice_u8__subslice_i(a_x, 8);
+  }
+  {
+    wuffs_base__slice_u8 i_slice_p = a_x;
+    v_p = i_slice_p;
+    v_p.len = 1;
+    uint8_t* i_end0_p = i_slice_p.ptr + (i_slice_p.len / 1) * 1;
+    while (v_p.ptr < i_end0_p) {
+      v_s = ((uint64_t)(
+          ((uint32_t)(_mm_crc32_u8(((uint32_t)(v_s)), v_p.ptr[0])))));
+      v_p.ptr += 1;
+    }
+  }
+  self->private_impl.f_state = (4294967295u ^ ((uint32_t)(v_s)));
+  return wuffs_base__make_empty_struct();
+}
+#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_64)
+
+// -------- func crc32.ieee_hasher.update_u32
+
+WUFFS_BASE__MAYBE_STATIC uint32_t  //
+wuffs_crc32__ieee_hasher__update_u32(wuffs_crc32__ieee_hasher* self,
+                                     wuffs_base__slice_u8 a_x) {
+  if (!self) {
+    return 0;
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return 0;
+  }
+
+  if (self->private_impl.f_state == 0) {
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+    if (wuffs_base__cpu_arch__have_x86_sse42()) {
+      self->private_impl.choosy_up = &wuffs_crc32__ieee_hasher__up_x86_sse42;
+    }
+#endif
+  }
+  wuffs_crc32__ieee_hasher__up(self, a_x);
+  return self->private_impl.f_state;
+}
+
+// -------- func crc32.ieee_hasher.up
+
+static wuffs_base__empty_struct  //
+wuffs_crc32__ieee_hasher__up(wuffs_crc32__ieee_hasher* self,
+                             wuffs_base__slice_u8 a_x) {
+  return (*self->private_impl.choosy_up)(self, a_x);
+}
+
+static wuffs_base__empty_struct  //
+wuffs_crc32__ieee_hasher__up__choosy_default(wuffs_crc32__ieee_hasher* self,
+                                             wuffs_base__slice_u8 a_x) {
+  uint32_t v_s = 0;
+  wuffs_base__slice_u8 v_p = {0};
+
+  v_s = (4294967295u ^ self->private_impl.f_state);
+  {
+    wuffs_base__slice_u8 i_slice_p = a_x;
+    v_p = i_slice_p;
+    v_p.len = 16;
+    uint8_t* i_end0_p = i_slice_p.ptr + (i_slice_p.len / 32) * 32;
+    while (v_p.ptr < i_end0_p) {
+      v_s ^=
+          ((((uint32_t)(v_p.ptr[0])) << 0) | (((uint32_t)(v_p.ptr[1])) << 8) |
+           (((uint32_t)(v_p.ptr[2])) << 16) | (((uint32_t)(v_p.ptr[3])) << 24));
+      v_s = (wuffs_crc32__ieee_table[0][v_p.ptr[15]] ^
+             wuffs_crc32__ieee_table[1][v_p.ptr[14]] ^
+             wuffs_crc32__ieee_table[2][v_p.ptr[13]] ^
+             wuffs_crc32__ieee_table[3][v_p.ptr[12]] ^
+             wuffs_crc32__ieee_table[4][v_p.ptr[11]] ^
+             wuffs_crc32__ieee_table[5][v_p.ptr[10]] ^
+             wuffs_crc32__ieee_table[6][v_p.ptr[9]] ^
+             wuffs_crc32__ieee_table[7][v_p.ptr[8]] ^
+             wuffs_crc32__ieee_table[8][v_p.ptr[7]] ^
+             wuffs_crc32__ieee_table[9][v_p.ptr[6]] ^
+             wuffs_crc32__ieee_table[10][v_p.ptr[5]] ^
+             wuffs_crc32__ieee_table[11][v_p.ptr[4]] ^
+             wuffs_crc32__ieee_table[12][(255 & (v_s >> 24))] ^
+             wuffs_crc32__ieee_table[13][(255 & (v_s >> 16))] ^
+             wuffs_crc32__ieee_table[14][(255 & (v_s >> 8))] ^
+             wuffs_crc32__ieee_table[15][(255 & (v_s >> 0))]);
+      v_p.ptr += 16;
+      v_s ^=
+          ((((uint32_t)(v_p.ptr[0])) << 0) | (((uint32_t)(v_p.ptr[1])) << 8) |
+           (((uint32_t)(v_p.ptr[2])) << 16) | (((uint32_t)(v_p.ptr[3])) << 24));
+      v_s = (wuffs_crc32__ieee_table[0][v_p.ptr[15]] ^
+             wuffs_crc32__ieee_table[1][v_p.ptr[14]] ^
+             wuffs_crc32__ieee_table[2][v_p.ptr[13]] ^
+             wuffs_crc32__ieee_table[3][v_p.ptr[12]] ^
+             wuffs_crc32__ieee_table[4][v_p.ptr[11]] ^
+             wuffs_crc32__ieee_table[5][v_p.ptr[10]] ^
+             wuffs_crc32__ieee_table[6][v_p.ptr[9]] ^
+             wuffs_crc32__ieee_table[7][v_p.ptr[8]] ^
+             wuffs_crc32__ieee_table[8][v_p.ptr[7]] ^
+             wuffs_crc32__ieee_table[9][v_p.ptr[6]] ^
+             wuffs_crc32__ieee_table[10][v_p.ptr[5]] ^
+             wuffs_crc32__ieee_table[11][v_p.ptr[4]] ^
+             wuffs_crc32__ieee_table[12][(255 & (v_s >> 24))] ^
+             wuffs_crc32__ieee_table[13][(255 & (v_s >> 16))] ^
+             wuffs_crc32__ieee_table[14][(255 & (v_s >> 8))] ^
+             wuffs_crc32__ieee_table[15][(255 & (v_s >> 0))]);
+      v_p.ptr += 16;
+    }
+    v_p.len = 16;
+    uint8_t* i_end1_p = i_slice_p.ptr + (i_slice_p.len / 16) * 16;
+    while (v_p.ptr < i_end1_p) {
+      v_s ^=
+          ((((uint32_t)(v_p.ptr[0])) << 0) | (((uint32_t)(v_p.ptr[1])) << 8) |
+           (((uint32_t)(v_p.ptr[2])) << 16) | (((uint32_t)(v_p.ptr[3])) << 24));
+      v_s = (wuffs_crc32__ieee_table[0][v_p.ptr[15]] ^
+             wuffs_crc32__ieee_table[1][v_p.ptr[14]] ^
+             wuffs_crc32__ieee_table[2][v_p.ptr[13]] ^
+             wuffs_crc32__ieee_table[3][v_p.ptr[12]] ^
+             wuffs_crc32__ieee_table[4][v_p.ptr[11]] ^
+             wuffs_crc32__ieee_table[5][v_p.ptr[10]] ^
+             wuffs_crc32__ieee_table[6][v_p.ptr[9]] ^
+             wuffs_crc32__ieee_table[7][v_p.ptr[8]] ^
+             wuffs_crc32__ieee_table[8][v_p.ptr[7]] ^
+             wuffs_crc32__ieee_table[9][v_p.ptr[6]] ^
+             wuffs_crc32__ieee_table[10][v_p.ptr[5]] ^
+             wuffs_crc32__ieee_table[11][v_p.ptr[4]] ^
+             wuffs_crc32__ieee_table[12][(255 & (v_s >> 24))] ^
+             wuffs_crc32__ieee_table[13][(255 & (v_s >> 16))] ^
+             wuffs_crc32__ieee_table[14][(255 & (v_s >> 8))] ^
+             wuffs_crc32__ieee_table[15][(255 & (v_s >> 0))]);
+      v_p.ptr += 16;
+    }
+    v_p.len = 1;
+    uint8_t* i_end2_p = i_slice_p.ptr + (i_slice_p.len / 1) * 1;
+    while (v_p.ptr < i_end2_p) {
+      v_s =
+          (wuffs_crc32__ieee_table[0][(((uint8_t)((v_s & 255))) ^ v_p.ptr[0])] ^
+           (v_s >> 8));
+      v_p.ptr += 1;
+    }
+  }
+  self->private_impl.f_state = (4294967295u ^ v_s);
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func crc32.ieee_hasher.up_x86_sse42
+
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2")
+    static wuffs_base__empty_struct  //
+    wuffs_crc32__ieee_hasher__up_x86_sse42(wuffs_crc32__ieee_hasher* self,
+                                           wuffs_base__slice_u8 a_x) {
+  uint32_t v_s = 0;
+  wuffs_base__slice_u8 v_p = {0};
+  __m128i v_k = {0};
+  __m128i v_x0 = {0};
+  __m128i v_x1 = {0};
+  __m128i v_x2 = {0};
+  __m128i v_x3 = {0};
+  __m128i v_y0 = {0};
+  __m128i v_y1 = {0};
+  __m128i v_y2 = {0};
+  __m128i v_y3 = {0};
+
+  v_s = (4294967295u ^ self->private_impl.f_state);
+  if (((uint64_t)(a_x.len)) >= 64) {
+    v_x0 = _mm_lddqu_si128(
+        (const __m128i*)(const void*)(wuffs_base__slice_u8__subslice_ij(
+                                          a_x, 0, 16).ptr));
+    v_x1 = _mm_lddqu_si128(
+        (const __m128i*)(const void*)(wuffs_base__slice_u8__subslice_ij(
+                                          a_x, 16, 32).ptr));
+    v_x2 = _mm_lddqu_si128(
+        (const __m128i*)(const void*)(wuffs_base__slice_u8__subslice_ij(
+                                          a_x, 32, 48).ptr));
+    v_x3 = _mm_lddqu_si128(
+        (const __m128i*)(const void*)(wuffs_base__slice_u8__subslice_ij(
+                                          a_x, 48, 64).ptr));
+    v_x0 = _mm_xor_si128(v_x0, _mm_cvtsi32_si128((int)(v_s)));
+    a_x = wuffs_base__slice_u8__subslice_i(a_x, 64);
+    v_k = _mm_set_epi64x((int64_t)(7631803798), (int64_t)(5708721108));
+    while (((uint64_t)(a_x.len)) >= 64) {
+      v_y0 = _mm_clmulepi64_si128(v_x0, v_k, 0);
+      v_x0 = _mm_clmulepi64_si128(v_x0, v_k, 17);
+      v_y1 = _mm_clmulepi64_si128(v_x1, v_k, 0);
+      v_x1 = _mm_clmulepi64_si128(v_x1, v_k, 17);
+      v_y2 = _mm_clmulepi64_si128(v_x2, v_k, 0);
+      v_x2 = _mm_clmulepi64_si128(v_x2, v_k, 17);
+      v_y3 = _mm_clmulepi64_si128(v_x3, v_k, 0);
+      v_x3 = _mm_clmulepi64_si128(v_x3, v_k, 17);
+      v_x0 = _mm_xor_si128(
+          _mm_xor_si128(v_x0, v_y0),
+          _mm_lddqu_si128(
+              (const __m128i*)(const void*)(wuffs_base__slice_u8__subslice_ij(
+                                                a_x, 0, 16).ptr)));
+      v_x1 = _mm_xor_si128(
+          _mm_xor_si128(v_x1, v_y1),
+          _mm_lddqu_si128(
+              (const __m128i*)(const void*)(wuffs_base__slice_u8__subslice_ij(
+                                                a_x, 16, 32).ptr)));
+      v_x2 = _mm_xor_si128(
+          _mm_xor_si128(v_x2, v_y2),
+          _mm_lddqu_si128(
+              (const __m128i*)(const void*)(wuffs_base__slice_u8__subslice_ij(
+                                                a_x, 32, 48).ptr)));
+      v_x3 = _mm_xor_si128(
+          _mm_xor_si128(v_x3, v_y3),
+          _mm_lddqu_si128(
+              (const __m128i*)(const void*)(wuffs_base__slice_u8__subslice_ij(
+                                                a_x, 48, 64).ptr)));
+      a_x = wuffs_base__slice_u8__subslice_i(a_x, 64);
+    }
+    v_k = _mm_set_epi64x((int64_t)(3433693342), (int64_t)(6259578832));
+    v_y0 = _mm_clmulepi64_si128(v_x0, v_k, 0);
+    v_x0 = _mm_clmulepi64_si128(v_x0, v_k, 17);
+    v_x0 = _mm_xor_si128(_mm_xor_si128(v_x0, v_x1), v_y0);
+    v_y0 = _mm_clmulepi64_si128(v_x0, v_k, 0);
+    v_x0 = _mm_clmulepi64_si128(v_x0, v_k, 17);
+    v_x0 = _mm_xor_si128(_mm_xor_si128(v_x0, v_x2), v_y0);
+    v_y0 = _mm_clmulepi64_si128(v_x0, v_k, 0);
+    v_x0 = _mm_clmulepi64_si128(v_x0, v_k, 17);
+    v_x0 = _mm_xor_si128(_mm_xor_si128(v_x0, v_x3), v_y0);
+    while (((uint64_t)(a_x.len)) >= 16) {
+      v_y0 = _mm_clmulepi64_si128(v_x0, v_k, 0);
+      v_x0 = _mm_clmulepi64_si128(v_x0, v_k, 17);
+      v_x0 = _mm_xor_si128(
+          _mm_xor_si128(v_x0, v_y0),
+          _mm_lddqu_si128(
+              (const __m128i*)(const void*)(wuffs_base__slice_u8__subslice_ij(
+                                                a_x, 0, 16).ptr)));
+      a_x = wuffs_base__slice_u8__subslice_i(a_x, 16);
+    }
+    v_y0 = _mm_clmulepi64_si128(v_x0, v_k, 16);
+    v_x0 = _mm_xor_si128(_mm_srli_si128(v_x0, 8), v_y0);
+    v_k = _mm_set_epi64x((int64_t)(0), (int64_t)(5969371428));
+    v_y3 = _mm_set_epi64x((int64_t)(4294967295), (int64_t)(4294967295));
+    v_y0 = _mm_srli_si128(v_x0, 4);
+    v_x0 = _mm_clmulepi64_si128(_mm_and_si128(v_x0, v_y3), v_k, 0);
+    v_x0 = _mm_xor_si128(v_x0, v_y0);
+    v_k = _mm_set_epi64x((int64_t)(8439010881), (int64_t)(7976584769));
+    v_y0 = _mm_clmulepi64_si128(_mm_and_si128(v_x0, v_y3), v_k, 16);
+    v_y0 = _mm_clmulepi64_si128(_mm_and_si128(v_y0, v_y3), v_k, 0);
+    v_x0 = _mm_xor_si128(v_x0, v_y0);
+    v_s = ((uint32_t)(_mm_extract_epi32(v_x0, 1)));
+  }
+  {
+    wuffs_base__slice_u8 i_slice_p = a_x;
+    v_p = i_slice_p;
+    v_p.len = 8;
+    uint8_t* i_end0_p = i_slice_p.ptr + (i_slice_p.len / 8) * 8;
+    while (v_p.ptr < i_end0_p) {
+      v_s ^=
+          ((((uint32_t)(v_p.ptr[0])) << 0) | (((uint32_t)(v_p.ptr[1])) << 8) |
+           (((uint32_t)(v_p.ptr[2])) << 16) | (((uint32_t)(v_p.ptr[3])) << 24));
+      v_s = (wuffs_crc32__ieee_table[0][v_p.ptr[7]] ^
+             wuffs_crc32__ieee_table[1][v_p.ptr[6]] ^
+             wuffs_crc32__ieee_table[2][v_p.ptr[5]] ^
+             wuffs_crc32__ieee_table[3][v_p.ptr[4]] ^
+             wuffs_crc32__ieee_table[4][(255 & (v_s >> 24))] ^
+             wuffs_crc32__ieee_table[5][(255 & (v_s >> 16))] ^
+             wuffs_crc32__ieee_table[6][(255 & (v_s >> 8))] ^
+             wuffs_crc32__ieee_table[7][(255 & (v_s >> 0))]);
+      v_p.ptr += 8;
+    }
+    v_p.len = 1;
+    uint8_t* i_end1_p = i_slice_p.ptr + (i_slice_p.len / 1) * 1;
+    while (v_p.ptr < i_end1_p) {
+      v_s =
+          (wuffs_crc32__ieee_table[0][(((uint8_t)((v_s & 255))) ^ v_p.ptr[0])] ^
+           (v_s >> 8));
+      v_p.ptr += 1;
+    }
+  }
+  self->private_impl.f_state = (4294967295u ^ v_s);
+  return wuffs_base__make_empty_struct();
+}
+#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_64)
+
+// -------- func crc32.ieee_combine
+
+WUFFS_BASE__MAYBE_STATIC WUFFS_BASE__POTENTIALLY_UNUSED uint32_t  //
+wuffs_crc32__ieee_combine(uint32_t a_crc_a,
+                          uint32_t a_crc_b,
+                          uint64_t a_length_b) {
+  uint32_t v_p = 0;
+  uint32_t v_q = 0;
+  uint32_t v_x = 0;
+  uint32_t v_m = 0;
+  uint64_t v_n = 0;
+  uint32_t v_k = 0;
+
+  v_p = a_crc_a;
+  v_n = a_length_b;
+  v_k = 3;
+  while (v_n > 0) {
+    if ((v_n & 1) != 0) {
+      v_q = 0;
+      v_x = v_p;
+      v_m = 2147483648;
+      while (v_m > 0) {
+        if ((wuffs_crc32__ieee_x2n_table[v_k] & v_m) != 0) {
+          v_q ^= v_x;
+        }
+        if ((v_x & 1) != 0) {
+          v_x = ((v_x >> 1) ^ 3988292384u);
+        } else {
+          v_x >>= 1;
+        }
+        v_m >>= 1;
+      }
+      v_p = v_q;
+    }
+    v_n >>= 1;
+    v_k = ((v_k + 1) & 31);
+  }
+  return (v_p ^ a_crc_b);
+}
+
+#endif  // !defined(WUFFS_CONFIG__MODULES) ||
+        // defined(WUFFS_CONFIG__MODULE__CRC32)
 
 #if !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__DEFLATE)
 
 // ---------------- Status Codes Implementations
 
+const char* wuffs_deflate__note__block_boundary = "@deflate: block boundary";
 const char* wuffs_deflate__error__bad_huffman_code_over_subscribed =
     "#deflate: bad Huffman code (over-subscribed)";
 const char* wuffs_deflate__error__bad_huffman_code_under_subscribed =
@@ -12583,6 +15265,8 @@ const char* wuffs_deflate__error__internal_error_inconsistent_distance =
     "#deflate: internal error: inconsistent distance";
 const char* wuffs_deflate__error__internal_error_inconsistent_n_bits =
     "#deflate: internal error: inconsistent n_bits";
+const char* wuffs_deflate__error__internal_error_inconsistent_encoder_state =
+    "#deflate: internal error: inconsistent encoder state";
 
 // ---------------- Private Consts
 
@@ -12638,10 +15322,231 @@ static const uint32_t                       //
         134217728,  134217728,
 };
 
+static const uint32_t                      //
+    wuffs_deflate__fixed_lcode_huffs[512]  //
+    WUFFS_BASE__POTENTIALLY_UNUSED = {
+        536870919,  2147504136, 2147487752, 1073770568, 1073749031, 2147512328,
+        2147495944, 2147532809, 1073743623, 2147508232, 2147491848, 2147524617,
+        2147483656, 2147516424, 2147500040, 2147541001, 1073742599, 2147506184,
+        2147489800, 2147520521, 1073756215, 2147514376, 2147497992, 2147536905,
+        1073745431, 2147510280, 2147493896, 2147528713, 2147485704, 2147518472,
+        2147502088, 2147545097, 1073742087, 2147505160, 2147488776, 1073799256,
+        1073752119, 2147513352, 2147496968, 2147534857, 1073744407, 2147509256,
+        2147492872, 2147526665, 2147484680, 2147517448, 2147501064, 2147543049,
+        1073743111, 2147507208, 2147490824, 2147522569, 1073762375, 2147515400,
+        2147499016, 2147538953, 1073746983, 2147511304, 2147494920, 2147530761,
+        2147486728, 2147519496, 2147503112, 2147547145, 1073741831, 2147504648,
+        2147488264, 1073782872, 1073750071, 2147512840, 2147496456, 2147533833,
+        1073743895, 2147508744, 2147492360, 2147525641, 2147484168, 2147516936,
+        2147500552, 2147542025, 1073742855, 2147506696, 2147490312, 2147521545,
+        1073758279, 2147514888, 2147498504, 2147537929, 1073745959, 2147510792,
+        2147494408, 2147529737, 2147486216, 2147518984, 2147502600, 2147546121,
+        1073742343, 2147505672, 2147489288, 134217736,  1073754167, 2147513864,
+        2147497480, 2147535881, 1073744919, 2147509768, 2147493384, 2147527689,
+        2147485192, 2147517960, 2147501576, 2147544073, 1073743367, 2147507720,
+        2147491336, 2147523593, 1073766471, 2147515912, 2147499528, 2147539977,
+        1073748007, 2147511816, 2147495432, 2147531785, 2147487240, 2147520008,
+        2147503624, 2147548169, 536870919,  2147504392, 2147488008, 1073774680,
+        1073749031, 2147512584, 2147496200, 2147533321, 1073743623, 2147508488,
+        2147492104, 2147525129, 2147483912, 2147516680, 2147500296, 2147541513,
+        1073742599, 2147506440, 2147490056, 2147521033, 1073756215, 2147514632,
+        2147498248, 2147537417, 1073745431, 2147510536, 2147494152, 2147529225,
+        2147485960, 2147518728, 2147502344, 2147545609, 1073742087, 2147505416,
+        2147489032, 1073807112, 1073752119, 2147513608, 2147497224, 2147535369,
+        1073744407, 2147509512, 2147493128, 2147527177, 2147484936, 2147517704,
+        2147501320, 2147543561, 1073743111, 2147507464, 2147491080, 2147523081,
+        1073762375, 2147515656, 2147499272, 2147539465, 1073746983, 2147511560,
+        2147495176, 2147531273, 2147486984, 2147519752, 2147503368, 2147547657,
+        1073741831, 2147504904, 2147488520, 1073791064, 1073750071, 2147513096,
+        2147496712, 2147534345, 1073743895, 2147509000, 2147492616, 2147526153,
+        2147484424, 2147517192, 2147500808, 2147542537, 1073742855, 2147506952,
+        2147490568, 2147522057, 1073758279, 2147515144, 2147498760, 2147538441,
+        1073745959, 2147511048, 2147494664, 2147530249, 2147486472, 2147519240,
+        2147502856, 2147546633, 1073742343, 2147505928, 2147489544, 134217736,
+        1073754167, 2147514120, 2147497736, 2147536393, 1073744919, 2147510024,
+        2147493640, 2147528201, 2147485448, 2147518216, 2147501832, 2147544585,
+        1073743367, 2147507976, 2147491592, 2147524105, 1073766471, 2147516168,
+        2147499784, 2147540489, 1073748007, 2147512072, 2147495688, 2147532297,
+        2147487496, 2147520264, 2147503880, 2147548681, 536870919,  2147504136,
+        2147487752, 1073770568, 1073749031, 2147512328, 2147495944, 2147533065,
+        1073743623, 2147508232, 2147491848, 2147524873, 2147483656, 2147516424,
+        2147500040, 2147541257, 1073742599, 2147506184, 2147489800, 2147520777,
+        1073756215, 2147514376, 2147497992, 2147537161, 1073745431, 2147510280,
+        2147493896, 2147528969, 2147485704, 2147518472, 2147502088, 2147545353,
+        1073742087, 2147505160, 2147488776, 1073799256, 1073752119, 2147513352,
+        2147496968, 2147535113, 1073744407, 2147509256, 2147492872, 2147526921,
+        2147484680, 2147517448, 2147501064, 2147543305, 1073743111, 2147507208,
+        2147490824, 2147522825, 1073762375, 2147515400, 2147499016, 2147539209,
+        1073746983, 2147511304, 2147494920, 2147531017, 2147486728, 2147519496,
+        2147503112, 2147547401, 1073741831, 2147504648, 2147488264, 1073782872,
+        1073750071, 2147512840, 2147496456, 2147534089, 1073743895, 2147508744,
+        2147492360, 2147525897, 2147484168, 2147516936, 2147500552, 2147542281,
+        1073742855, 2147506696, 2147490312, 2147521801, 1073758279, 2147514888,
+        2147498504, 2147538185, 1073745959, 2147510792, 2147494408, 2147529993,
+        2147486216, 2147518984, 2147502600, 2147546377, 1073742343, 2147505672,
+        2147489288, 134217736,  1073754167, 2147513864, 2147497480, 2147536137,
+        1073744919, 2147509768, 2147493384, 2147527945, 2147485192, 2147517960,
+        2147501576, 2147544329, 1073743367, 2147507720, 2147491336, 2147523849,
+        1073766471, 2147515912, 2147499528, 2147540233, 1073748007, 2147511816,
+        2147495432, 2147532041, 2147487240, 2147520008, 2147503624, 2147548425,
+        536870919,  2147504392, 2147488008, 1073774680, 1073749031, 2147512584,
+        2147496200, 2147533577, 1073743623, 2147508488, 2147492104, 2147525385,
+        2147483912, 2147516680, 2147500296, 2147541769, 1073742599, 2147506440,
+        2147490056, 2147521289, 1073756215, 2147514632, 2147498248, 2147537673,
+        1073745431, 2147510536, 2147494152, 2147529481, 2147485960, 2147518728,
+        2147502344, 2147545865, 1073742087, 2147505416, 2147489032, 1073807112,
+        1073752119, 2147513608, 2147497224, 2147535625, 1073744407, 2147509512,
+        2147493128, 2147527433, 2147484936, 2147517704, 2147501320, 2147543817,
+        1073743111, 2147507464, 2147491080, 2147523337, 1073762375, 2147515656,
+        2147499272, 2147539721, 1073746983, 2147511560, 2147495176, 2147531529,
+        2147486984, 2147519752, 2147503368, 2147547913, 1073741831, 2147504904,
+        2147488520, 1073791064, 1073750071, 2147513096, 2147496712, 2147534601,
+        1073743895, 2147509000, 2147492616, 2147526409, 2147484424, 2147517192,
+        2147500808, 2147542793, 1073742855, 2147506952, 2147490568, 2147522313,
+        1073758279, 2147515144, 2147498760, 2147538697, 1073745959, 2147511048,
+        2147494664, 2147530505, 2147486472, 2147519240, 2147502856, 2147546889,
+        1073742343, 2147505928, 2147489544, 134217736,  1073754167, 2147514120,
+        2147497736, 2147536649, 1073744919, 2147510024, 2147493640, 2147528457,
+        2147485448, 2147518216, 2147501832, 2147544841, 1073743367, 2147507976,
+        2147491592, 2147524361, 1073766471, 2147516168, 2147499784, 2147540745,
+        1073748007, 2147512072, 2147495688, 2147532553, 2147487496, 2147520264,
+        2147503880, 2147548937,
+};
+
+static const uint32_t                     //
+    wuffs_deflate__fixed_dcode_huffs[32]  //
+    WUFFS_BASE__POTENTIALLY_UNUSED = {
+        1073741829, 1073807477, 1073745973, 1074790581, 1073742869, 1074004117,
+        1073758293, 1077936341, 1073742341, 1073873029, 1073750085, 1075839173,
+        1073743909, 1074266277, 1073774693, 134217733,  1073742085, 1073840245,
+        1073748021, 1075314869, 1073743381, 1074135189, 1073766485, 1080033493,
+        1073742597, 1073938565, 1073754181, 1076887749, 1073744933, 1074528421,
+        1073791077, 134217733,
+};
+
+#define WUFFS_DEFLATE__STATS_TOTAL_BYTES 15
+
+#define WUFFS_DEFLATE__HUFFS_PRIMARY_BITS 9
+
+#define WUFFS_DEFLATE__HUFFS_PRIMARY_SIZE 512
+
+#define WUFFS_DEFLATE__HUFFS_PRIMARY_MASK 511
+
 #define WUFFS_DEFLATE__HUFFS_TABLE_SIZE 1024
 
 #define WUFFS_DEFLATE__HUFFS_TABLE_MASK 1023
 
+static const uint32_t                    //
+    wuffs_deflate__level_max_chains[10]  //
+    WUFFS_BASE__POTENTIALLY_UNUSED = {
+        0, 4, 8, 32, 16, 32, 128, 256, 1024, 4096,
+};
+
+static const uint32_t                      //
+    wuffs_deflate__level_nice_lengths[10]  //
+    WUFFS_BASE__POTENTIALLY_UNUSED = {
+        0, 8, 16, 32, 16, 32, 128, 128, 258, 258,
+};
+
+static const uint32_t                    //
+    wuffs_deflate__level_max_lazies[10]  //
+    WUFFS_BASE__POTENTIALLY_UNUSED = {
+        0, 4, 5, 6, 4, 16, 16, 32, 128, 258,
+};
+
+static const uint32_t                      //
+    wuffs_deflate__level_good_lengths[10]  //
+    WUFFS_BASE__POTENTIALLY_UNUSED = {
+        0, 4, 4, 4, 4, 8, 8, 8, 32, 32,
+};
+
+#define WUFFS_DEFLATE__ENCODER_MAX_N_TOKENS 16384
+
+#define WUFFS_DEFLATE__ENCODER_MIN_LOOKAHEAD 262
+
+static const uint8_t                     //
+    wuffs_deflate__length_to_lcode[256]  //
+    WUFFS_BASE__POTENTIALLY_UNUSED = {
+        0,  1,  2,  3,  4,  5,  6,  7,  8,  8,  9,  9,  10, 10, 11, 11, 12, 12,
+        12, 12, 13, 13, 13, 13, 14, 14, 14, 14, 15, 15, 15, 15, 16, 16, 16, 16,
+        16, 16, 16, 16, 17, 17, 17, 17, 17, 17, 17, 17, 18, 18, 18, 18, 18, 18,
+        18, 18, 19, 19, 19, 19, 19, 19, 19, 19, 20, 20, 20, 20, 20, 20, 20, 20,
+        20, 20, 20, 20, 20, 20, 20, 20, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21,
+        21, 21, 21, 21, 21, 21, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22,
+        22, 22, 22, 22, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23,
+        23, 23, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24,
+        24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 25, 25,
+        25, 25, 25, 25, 25, 25, 25, 25, 25, 25, 25, 25, 25, 25, 25, 25, 25, 25,
+        25, 25, 25, 25, 25, 25, 25, 25, 25, 25, 25, 25, 26, 26, 26, 26, 26, 26,
+        26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26,
+        26, 26, 26, 26, 26, 26, 26, 26, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27,
+        27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27,
+        27, 27, 27, 28,
+};
+
+static const uint32_t               //
+    wuffs_deflate__lcode_bases[29]  //
+    WUFFS_BASE__POTENTIALLY_UNUSED = {
+        3,  4,  5,  6,  7,  8,  9,  10, 11,  13,  15,  17,  19,  23,  27,
+        31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258,
+};
+
+static const uint32_t                      //
+    wuffs_deflate__lcode_n_extra_bits[29]  //
+    WUFFS_BASE__POTENTIALLY_UNUSED = {
+        0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2,
+        2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0,
+};
+
+static const uint8_t                       //
+    wuffs_deflate__distance_to_dcode[512]  //
+    WUFFS_BASE__POTENTIALLY_UNUSED = {
+        0,  1,  2,  3,  4,  4,  5,  5,  6,  6,  6,  6,  7,  7,  7,  7,  8,  8,
+        8,  8,  8,  8,  8,  8,  9,  9,  9,  9,  9,  9,  9,  9,  10, 10, 10, 10,
+        10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 11, 11, 11, 11, 11, 11,
+        11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 12, 12, 12, 12, 12, 12, 12, 12,
+        12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12,
+        12, 12, 12, 12, 12, 12, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13,
+        13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13,
+        13, 13, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14,
+        14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14,
+        14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14,
+        14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 15, 15, 15, 15, 15, 15,
+        15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,
+        15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,
+        15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,
+        15, 15, 15, 15, 0,  14, 16, 17, 18, 18, 19, 19, 20, 20, 20, 20, 21, 21,
+        21, 21, 22, 22, 22, 22, 22, 22, 22, 22, 23, 23, 23, 23, 23, 23, 23, 23,
+        24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 25, 25,
+        25, 25, 25, 25, 25, 25, 25, 25, 25, 25, 25, 25, 25, 25, 26, 26, 26, 26,
+        26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26,
+        26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 27, 27, 27, 27, 27, 27, 27, 27,
+        27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27,
+        27, 27, 27, 27, 27, 27, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28,
+        28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28,
+        28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28,
+        28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 29, 29,
+        29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29,
+        29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29,
+        29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29,
+        29, 29, 29, 29, 29, 29, 29, 29,
+};
+
+static const uint32_t               //
+    wuffs_deflate__dcode_bases[30]  //
+    WUFFS_BASE__POTENTIALLY_UNUSED = {
+        1,    2,    3,    4,    5,    7,    9,    13,    17,    25,
+        33,   49,   65,   97,   129,  193,  257,  385,   513,   769,
+        1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577,
+};
+
+static const uint32_t                      //
+    wuffs_deflate__dcode_n_extra_bits[30]  //
+    WUFFS_BASE__POTENTIALLY_UNUSED = {
+        0, 0, 0, 0, 1, 1, 2, 2,  3,  3,  4,  4,  5,  5,  6,
+        6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13,
+};
+
 // ---------------- Private Initializer Prototypes
 
 // ---------------- Private Function Prototypes
@@ -12649,7 +15554,8 @@ static const uint32_t                       //
 static wuffs_base__status  //
 wuffs_deflate__decoder__decode_blocks(wuffs_deflate__decoder* self,
                                       wuffs_base__io_buffer* a_dst,
-                                      wuffs_base__io_buffer* a_src);
+                                      wuffs_base__io_buffer* a_src,
+                                      wuffs_base__slice_u8 a_workbuf);
 
 static wuffs_base__status  //
 wuffs_deflate__decoder__decode_uncompressed(wuffs_deflate__decoder* self,
@@ -12663,6 +15569,11 @@ static wuffs_base__status  //
 wuffs_deflate__decoder__init_dynamic_huffman(wuffs_deflate__decoder* self,
                                              wuffs_base__io_buffer* a_src);
 
+static bool  //
+wuffs_deflate__decoder__lcode_lengths_are_unchanged(
+    const wuffs_deflate__decoder* self,
+    uint32_t a_n_lit);
+
 static wuffs_base__status  //
 wuffs_deflate__decoder__init_huff(wuffs_deflate__decoder* self,
                                   uint32_t a_which,
@@ -12673,12 +15584,100 @@ wuffs_deflate__decoder__init_huff(wuffs_deflate__decoder* self,
 static wuffs_base__status  //
 wuffs_deflate__decoder__decode_huffman_fast(wuffs_deflate__decoder* self,
                                             wuffs_base__io_buffer* a_dst,
-                                            wuffs_base__io_buffer* a_src);
+                                            wuffs_base__io_buffer* a_src,
+                                            wuffs_base__slice_u8 a_workbuf);
 
 static wuffs_base__status  //
 wuffs_deflate__decoder__decode_huffman_slow(wuffs_deflate__decoder* self,
                                             wuffs_base__io_buffer* a_dst,
-                                            wuffs_base__io_buffer* a_src);
+                                            wuffs_base__io_buffer* a_src,
+                                            wuffs_base__slice_u8 a_workbuf);
+
+static wuffs_base__status  //
+wuffs_deflate__decoder__decode_huffman_tail(wuffs_deflate__decoder* self,
+                                            wuffs_base__io_buffer* a_dst,
+                                            wuffs_base__io_buffer* a_src,
+                                            wuffs_base__slice_u8 a_workbuf);
+
+static wuffs_base__empty_struct  //
+wuffs_deflate__encoder__start_stream(wuffs_deflate__encoder* self,
+                                     uint32_t a_level);
+
+static wuffs_base__empty_struct  //
+wuffs_deflate__encoder__clear_freqs(wuffs_deflate__encoder* self);
+
+static wuffs_base__empty_struct  //
+wuffs_deflate__encoder__slide_window(wuffs_deflate__encoder* self);
+
+static uint32_t  //
+wuffs_deflate__encoder__insert_hash(wuffs_deflate__encoder* self, uint32_t a_p);
+
+static uint32_t  //
+wuffs_deflate__encoder__longest_match(wuffs_deflate__encoder* self,
+                                      uint32_t a_pos,
+                                      uint32_t a_cand,
+                                      uint32_t a_max_len,
+                                      uint32_t a_best_len,
+                                      uint32_t a_max_chain);
+
+static wuffs_base__empty_struct  //
+wuffs_deflate__encoder__match_greedy(wuffs_deflate__encoder* self,
+                                     bool a_final);
+
+static wuffs_base__empty_struct  //
+wuffs_deflate__encoder__match_lazy(wuffs_deflate__encoder* self, bool a_final);
+
+static uint32_t  //
+wuffs_deflate__encoder__dcode_for(const wuffs_deflate__encoder* self,
+                                  uint32_t a_d);
+
+static wuffs_base__status  //
+wuffs_deflate__encoder__write_block(wuffs_deflate__encoder* self,
+                                    wuffs_base__io_buffer* a_dst,
+                                    bool a_final);
+
+static wuffs_base__status  //
+wuffs_deflate__encoder__flush_bits(wuffs_deflate__encoder* self,
+                                   wuffs_base__io_buffer* a_dst);
+
+static wuffs_base__status  //
+wuffs_deflate__encoder__write_dynamic_header(wuffs_deflate__encoder* self,
+                                             wuffs_base__io_buffer* a_dst,
+                                             bool a_final,
+                                             uint32_t a_hlit,
+                                             uint32_t a_hdist,
+                                             uint32_t a_hclen);
+
+static uint64_t  //
+wuffs_deflate__encoder__data_cost(const wuffs_deflate__encoder* self,
+                                  bool a_fixed);
+
+static uint64_t  //
+wuffs_deflate__encoder__cl_cost(const wuffs_deflate__encoder* self);
+
+static wuffs_base__empty_struct  //
+wuffs_deflate__encoder__set_fixed_lens(wuffs_deflate__encoder* self);
+
+static wuffs_base__empty_struct  //
+wuffs_deflate__encoder__run_length_encode(wuffs_deflate__encoder* self,
+                                          uint32_t a_hlit,
+                                          uint32_t a_hdist);
+
+static uint32_t  //
+wuffs_deflate__encoder__cl_len(const wuffs_deflate__encoder* self,
+                               uint32_t a_hlit,
+                               uint32_t a_k);
+
+static wuffs_base__empty_struct  //
+wuffs_deflate__encoder__build_huffman(wuffs_deflate__encoder* self,
+                                      uint32_t a_which,
+                                      uint32_t a_n_codes,
+                                      uint32_t a_max_len);
+
+static wuffs_base__empty_struct  //
+wuffs_deflate__encoder__assign_codes(wuffs_deflate__encoder* self,
+                                     uint32_t a_which,
+                                     uint32_t a_n_codes);
 
 // ---------------- VTables
 
@@ -12693,13 +15692,24 @@ const wuffs_base__io_transformer__func_ptrs
             &wuffs_deflate__decoder__workbuf_len),
 };
 
-// ---------------- Initializer Implementations
-
-wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT  //
-wuffs_deflate__decoder__initialize(wuffs_deflate__decoder* self,
-                                   size_t sizeof_star_self,
-                                   uint64_t wuffs_version,
-                                   uint32_t initialize_flags) {
+const wuffs_base__io_transformer__func_ptrs
+    wuffs_deflate__encoder__func_ptrs_for__wuffs_base__io_transformer = {
+        (wuffs_base__status(*)(void*,
+                               wuffs_base__io_buffer*,
+                               wuffs_base__io_buffer*,
+                               wuffs_base__slice_u8))(
+            &wuffs_deflate__encoder__transform_io),
+        (wuffs_base__range_ii_u64(*)(const void*))(
+            &wuffs_deflate__encoder__workbuf_len),
+};
+
+// ---------------- Initializer Implementations
+
+wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT  //
+wuffs_deflate__decoder__initialize(wuffs_deflate__decoder* self,
+                                   size_t sizeof_star_self,
+                                   uint64_t wuffs_version,
+                                   uint32_t initialize_flags) {
   if (!self) {
     return wuffs_base__make_status(wuffs_base__error__bad_receiver);
   }
@@ -12748,46 +15758,135 @@ sizeof__wuffs_deflate__decoder() {
   return sizeof(wuffs_deflate__decoder);
 }
 
+wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT  //
+wuffs_deflate__encoder__initialize(wuffs_deflate__encoder* self,
+                                   size_t sizeof_star_self,
+                                   uint64_t wuffs_version,
+                                   uint32_t initialize_flags) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (sizeof(*self) != sizeof_star_self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_sizeof_receiver);
+  }
+  if (((wuffs_version >> 32) != WUFFS_VERSION_MAJOR) ||
+      (((wuffs_version >> 16) & 0xFFFF) > WUFFS_VERSION_MINOR)) {
+    return wuffs_base__make_status(wuffs_base__error__bad_wuffs_version);
+  }
+
+  if ((initialize_flags & WUFFS_INITIALIZE__ALREADY_ZEROED) != 0) {
+// The whole point of this if-check is to detect an uninitialized *self.
+// We disable the warning on GCC. Clang-5.0 does not have this warning.
+#if !defined(__clang__) && defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+    if (self->private_impl.magic != 0) {
+      return wuffs_base__make_status(
+          wuffs_base__error__initialize_falsely_claimed_already_zeroed);
+    }
+#if !defined(__clang__) && defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+  } else {
+    if ((initialize_flags &
+         WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED) == 0) {
+      memset(self, 0, sizeof(*self));
+      initialize_flags |= WUFFS_INITIALIZE__ALREADY_ZEROED;
+    } else {
+      memset(&(self->private_impl), 0, sizeof(self->private_impl));
+    }
+  }
+
+  self->private_impl.magic = WUFFS_BASE__MAGIC;
+  self->private_impl.vtable_for__wuffs_base__io_transformer.vtable_name =
+      wuffs_base__io_transformer__vtable_name;
+  self->private_impl.vtable_for__wuffs_base__io_transformer.function_pointers =
+      (const void*)(&wuffs_deflate__encoder__func_ptrs_for__wuffs_base__io_transformer);
+  return wuffs_base__make_status(NULL);
+}
+
+size_t  //
+sizeof__wuffs_deflate__encoder() {
+  return sizeof(wuffs_deflate__encoder);
+}
+
 // ---------------- Function Implementations
 
-// -------- func deflate.decoder.add_history
+// -------- func deflate.decoder.reset
 
 WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
-wuffs_deflate__decoder__add_history(wuffs_deflate__decoder* self,
-                                    wuffs_base__slice_u8 a_hist) {
+wuffs_deflate__decoder__reset(wuffs_deflate__decoder* self) {
   if (!self) {
     return wuffs_base__make_empty_struct();
   }
-  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
     return wuffs_base__make_empty_struct();
   }
 
+  self->private_impl.magic = WUFFS_BASE__MAGIC;
+  self->private_impl.active_coroutine = 0;
+  memset(self->private_impl.p_transform_io, 0,
+         sizeof(self->private_impl.p_transform_io));
+  memset(self->private_impl.p_decode_blocks, 0,
+         sizeof(self->private_impl.p_decode_blocks));
+  memset(self->private_impl.p_decode_uncompressed, 0,
+         sizeof(self->private_impl.p_decode_uncompressed));
+  memset(self->private_impl.p_init_dynamic_huffman, 0,
+         sizeof(self->private_impl.p_init_dynamic_huffman));
+  memset(self->private_impl.p_decode_huffman_slow, 0,
+         sizeof(self->private_impl.p_decode_huffman_slow));
+
+  self->private_impl.f_bits = 0;
+  self->private_impl.f_n_bits = 0;
+  self->private_impl.f_history_index = 0;
+  self->private_impl.f_n_output_since_reset = 0;
+  self->private_impl.f_boundary_bit_position = 0;
+  self->private_impl.f_n_initial_bits_to_skip = 0;
+  self->private_impl.f_n_reused_lcode_tables = 0;
+  self->private_impl.f_end_of_block = false;
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func deflate.decoder.add_history
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_deflate__decoder__add_history(wuffs_deflate__decoder* self,
+                                    wuffs_base__slice_u8 a_hist,
+                                    wuffs_base__slice_u8 a_workbuf) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_status(
+        (self->private_impl.magic == WUFFS_BASE__DISABLED)
+            ? wuffs_base__error__disabled_by_previous_error
+            : wuffs_base__error__initialize_not_called);
+  }
+
   wuffs_base__slice_u8 v_s = {0};
   uint64_t v_n_copied = 0;
   uint32_t v_already_full = 0;
 
+  if (((uint64_t)(a_workbuf.len)) < 33025) {
+    return wuffs_base__make_status(wuffs_base__error__bad_workbuf_length);
+  }
   v_s = a_hist;
   if (((uint64_t)(v_s.len)) >= 32768) {
     v_s = wuffs_base__slice_u8__suffix(v_s, 32768);
     wuffs_base__slice_u8__copy_from_slice(
-        wuffs_base__slice_u8__subslice_j(
-            wuffs_base__make_slice_u8(self->private_data.f_history, 33025),
-            32768),
-        v_s);
+        wuffs_base__slice_u8__subslice_j(a_workbuf, 32768), v_s);
     self->private_impl.f_history_index = 32768;
   } else {
     v_n_copied = wuffs_base__slice_u8__copy_from_slice(
         wuffs_base__slice_u8__subslice_ij(
-            wuffs_base__make_slice_u8(self->private_data.f_history, 33025),
-            (self->private_impl.f_history_index & 32767), 32768),
+            a_workbuf, (self->private_impl.f_history_index & 32767), 32768),
         v_s);
     if (v_n_copied < ((uint64_t)(v_s.len))) {
       v_s = wuffs_base__slice_u8__subslice_i(v_s, v_n_copied);
       v_n_copied = wuffs_base__slice_u8__copy_from_slice(
-          wuffs_base__slice_u8__subslice_j(
-              wuffs_base__make_slice_u8(self->private_data.f_history, 33025),
-              32768),
-          v_s);
+          wuffs_base__slice_u8__subslice_j(a_workbuf, 32768), v_s);
       self->private_impl.f_history_index =
           (((uint32_t)((v_n_copied & 32767))) + 32768);
     } else {
@@ -12801,13 +15900,146 @@ wuffs_deflate__decoder__add_history(wuffs_deflate__decoder* self,
     }
   }
   wuffs_base__slice_u8__copy_from_slice(
-      wuffs_base__slice_u8__subslice_i(
-          wuffs_base__make_slice_u8(self->private_data.f_history, 33025),
-          32768),
-      wuffs_base__make_slice_u8(self->private_data.f_history, 33025));
+      wuffs_base__slice_u8__subslice_ij(a_workbuf, 32768, 33025),
+      wuffs_base__slice_u8__subslice_j(a_workbuf, 257));
+  return wuffs_base__make_status(NULL);
+}
+
+// -------- func deflate.decoder.set_whole_output_in_dst
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_deflate__decoder__set_whole_output_in_dst(wuffs_deflate__decoder* self,
+                                                bool a_w) {
+  if (!self) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_empty_struct();
+  }
+
+  self->private_impl.f_whole_output_in_dst = a_w;
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func deflate.decoder.set_report_block_boundaries
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_deflate__decoder__set_report_block_boundaries(
+    wuffs_deflate__decoder* self,
+    bool a_r) {
+  if (!self) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_empty_struct();
+  }
+
+  self->private_impl.f_report_block_boundaries = a_r;
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func deflate.decoder.block_boundary_bit_position
+
+WUFFS_BASE__MAYBE_STATIC uint64_t  //
+wuffs_deflate__decoder__block_boundary_bit_position(
+    const wuffs_deflate__decoder* self) {
+  if (!self) {
+    return 0;
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return 0;
+  }
+
+  return self->private_impl.f_boundary_bit_position;
+}
+
+// -------- func deflate.decoder.set_initial_bit_offset
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_deflate__decoder__set_initial_bit_offset(wuffs_deflate__decoder* self,
+                                               uint32_t a_o) {
+  if (!self) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_empty_struct();
+  }
+
+  self->private_impl.f_n_initial_bits_to_skip = (a_o & 7);
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func deflate.decoder.num_reused_lcode_tables
+
+WUFFS_BASE__MAYBE_STATIC uint64_t  //
+wuffs_deflate__decoder__num_reused_lcode_tables(
+    const wuffs_deflate__decoder* self) {
+  if (!self) {
+    return 0;
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return 0;
+  }
+
+  return self->private_impl.f_n_reused_lcode_tables;
+}
+
+// -------- func deflate.decoder.set_collect_stats
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_deflate__decoder__set_collect_stats(wuffs_deflate__decoder* self,
+                                          bool a_c) {
+  if (!self) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_empty_struct();
+  }
+
+  uint32_t v_i = 0;
+
+  if (a_c) {
+    while (v_i < 288) {
+      self->private_data.f_stats_counts[v_i] = 0;
+      v_i += 1;
+    }
+  }
+  self->private_impl.f_collect_stats = a_c;
   return wuffs_base__make_empty_struct();
 }
 
+// -------- func deflate.decoder.stats
+
+WUFFS_BASE__MAYBE_STATIC uint64_t  //
+wuffs_deflate__decoder__stats(const wuffs_deflate__decoder* self,
+                              uint32_t a_key) {
+  if (!self) {
+    return 0;
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return 0;
+  }
+
+  uint64_t v_n = 0;
+
+  if (a_key == 5) {
+    v_n = wuffs_base__u64__sat_sub(self->private_data.f_stats_counts[15],
+                                   self->private_data.f_stats_counts[3]);
+    v_n = wuffs_base__u64__sat_sub(v_n, self->private_data.f_stats_counts[4]);
+    return wuffs_base__u64__sat_sub(v_n, self->private_data.f_stats_counts[10]);
+  } else if (a_key == 6) {
+    v_n = wuffs_base__u64__sat_sub(self->private_data.f_stats_counts[15],
+                                   self->private_data.f_stats_counts[3]);
+    return wuffs_base__u64__sat_sub(v_n, self->private_data.f_stats_counts[8]);
+  } else if ((a_key < 288) && (a_key != 15)) {
+    return self->private_data.f_stats_counts[a_key];
+  }
+  return 0;
+}
+
 // -------- func deflate.decoder.workbuf_len
 
 WUFFS_BASE__MAYBE_STATIC wuffs_base__range_ii_u64  //
@@ -12820,7 +16052,7 @@ wuffs_deflate__decoder__workbuf_len(const wuffs_deflate__decoder* self) {
     return wuffs_base__utility__empty_range_ii_u64();
   }
 
-  return wuffs_base__utility__make_range_ii_u64(1, 1);
+  return wuffs_base__utility__make_range_ii_u64(33025, 33025);
 }
 
 // -------- func deflate.decoder.transform_io
@@ -12854,6 +16086,8 @@ wuffs_deflate__decoder__transform_io(wuffs_deflate__decoder* self,
 
   uint64_t v_mark = 0;
   wuffs_base__status v_status = wuffs_base__make_status(NULL);
+  uint64_t v_n_output = 0;
+  wuffs_base__status v_hist_status = wuffs_base__make_status(NULL);
 
   uint8_t* iop_a_dst = NULL;
   uint8_t* io0_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
@@ -12873,20 +16107,63 @@ wuffs_deflate__decoder__transform_io(wuffs_deflate__decoder* self,
   switch (coro_susp_point) {
     WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
 
+    if (((uint64_t)(a_workbuf.len)) < 33025) {
+      status = wuffs_base__make_status(wuffs_base__error__bad_workbuf_length);
+      goto exit;
+    }
     while (true) {
       v_mark = ((uint64_t)(iop_a_dst - io0_a_dst));
+      if (self->private_impl.f_whole_output_in_dst) {
+        self->private_impl.f_dst_history_floor = wuffs_base__u64__sat_sub(
+            v_mark, ((uint64_t)(self->private_impl.f_n_output_since_reset)));
+      } else {
+        self->private_impl.f_dst_history_floor = v_mark;
+      }
       {
         if (a_dst) {
           a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
         }
-        wuffs_base__status t_0 =
-            wuffs_deflate__decoder__decode_blocks(self, a_dst, a_src);
+        wuffs_base__status t_0 = wuffs_deflate__decoder__decode_blocks(
+            self, a_dst, a_src, a_workbuf);
         if (a_dst) {
           iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
         }
         v_status = t_0;
       }
-      if (!wuffs_base__status__is_suspension(&v_status)) {
+      v_n_output = wuffs_base__u64__sat_add(
+          ((uint64_t)(self->private_impl.f_n_output_since_reset)),
+          wuffs_base__io__count_since(v_mark,
+                                      ((uint64_t)(iop_a_dst - io0_a_dst))));
+      self->private_impl.f_n_output_since_reset =
+          ((uint32_t)(wuffs_base__u64__min(v_n_output, 32768)));
+      if (self->private_impl.f_collect_stats) {
+        self->private_data.f_stats_counts[15] += wuffs_base__io__count_since(
+            v_mark, ((uint64_t)(iop_a_dst - io0_a_dst)));
+      }
+      if (!wuffs_base__status__is_suspension(&v_status) &&
+          !wuffs_base__status__is_note(&v_status)) {
+        status = v_status;
+        if (wuffs_base__status__is_error(&status)) {
+          goto exit;
+        } else if (wuffs_base__status__is_suspension(&status)) {
+          status = wuffs_base__make_status(
+              wuffs_base__error__cannot_return_a_suspension);
+          goto exit;
+        }
+        goto ok;
+      }
+      if (!self->private_impl.f_whole_output_in_dst) {
+        v_hist_status = wuffs_deflate__decoder__add_history(
+            self,
+            wuffs_base__io__since(v_mark, ((uint64_t)(iop_a_dst - io0_a_dst)),
+                                  io0_a_dst),
+            a_workbuf);
+        if (wuffs_base__status__is_error(&v_hist_status)) {
+          status = v_hist_status;
+          goto exit;
+        }
+      }
+      if (wuffs_base__status__is_note(&v_status)) {
         status = v_status;
         if (wuffs_base__status__is_error(&status)) {
           goto exit;
@@ -12897,9 +16174,6 @@ wuffs_deflate__decoder__transform_io(wuffs_deflate__decoder* self,
         }
         goto ok;
       }
-      wuffs_deflate__decoder__add_history(
-          self, wuffs_base__io__since(
-                    v_mark, ((uint64_t)(iop_a_dst - io0_a_dst)), io0_a_dst));
       status = v_status;
       WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(1);
     }
@@ -12934,14 +16208,29 @@ exit:
 static wuffs_base__status  //
 wuffs_deflate__decoder__decode_blocks(wuffs_deflate__decoder* self,
                                       wuffs_base__io_buffer* a_dst,
-                                      wuffs_base__io_buffer* a_src) {
+                                      wuffs_base__io_buffer* a_src,
+                                      wuffs_base__slice_u8 a_workbuf) {
   wuffs_base__status status = wuffs_base__make_status(NULL);
 
   uint32_t v_final = 0;
   uint32_t v_b0 = 0;
   uint32_t v_type = 0;
   wuffs_base__status v_status = wuffs_base__make_status(NULL);
+  uint64_t v_mark = 0;
 
+  uint8_t* iop_a_dst = NULL;
+  uint8_t* io0_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_dst) {
+    io0_a_dst = a_dst->data.ptr;
+    io1_a_dst = io0_a_dst + a_dst->meta.wi;
+    iop_a_dst = io1_a_dst;
+    io2_a_dst = io0_a_dst + a_dst->data.len;
+    if (a_dst->meta.closed) {
+      io2_a_dst = iop_a_dst;
+    }
+  }
   uint8_t* iop_a_src = NULL;
   uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
   uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
@@ -12960,18 +16249,33 @@ wuffs_deflate__decoder__decode_blocks(wuffs_deflate__decoder* self,
   switch (coro_susp_point) {
     WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
 
-  label__outer__continue:;
+    if (self->private_impl.f_n_initial_bits_to_skip > 0) {
+      {
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+        if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+          goto suspend;
+        }
+        uint32_t t_0 = *iop_a_src++;
+        v_b0 = t_0;
+      }
+      self->private_impl.f_bits =
+          (v_b0 >> self->private_impl.f_n_initial_bits_to_skip);
+      self->private_impl.f_n_bits =
+          (8 - self->private_impl.f_n_initial_bits_to_skip);
+      self->private_impl.f_n_initial_bits_to_skip = 0;
+    }
     while (v_final == 0) {
       while (self->private_impl.f_n_bits < 3) {
         {
-          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
           if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
             status =
                 wuffs_base__make_status(wuffs_base__suspension__short_read);
             goto suspend;
           }
-          uint32_t t_0 = *iop_a_src++;
-          v_b0 = t_0;
+          uint32_t t_1 = *iop_a_src++;
+          v_b0 = t_1;
         }
         self->private_impl.f_bits |= (v_b0 << self->private_impl.f_n_bits);
         self->private_impl.f_n_bits += 8;
@@ -12980,39 +16284,22 @@ wuffs_deflate__decoder__decode_blocks(wuffs_deflate__decoder* self,
       v_type = ((self->private_impl.f_bits >> 1) & 3);
       self->private_impl.f_bits >>= 3;
       self->private_impl.f_n_bits -= 3;
+      if (self->private_impl.f_collect_stats && (v_type < 3)) {
+        self->private_data.f_stats_counts[v_type] += 1;
+      }
       if (v_type == 0) {
+        if (a_dst) {
+          a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+        }
         if (a_src) {
           a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
         }
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
         status =
             wuffs_deflate__decoder__decode_uncompressed(self, a_dst, a_src);
-        if (a_src) {
-          iop_a_src = a_src->data.ptr + a_src->meta.ri;
-        }
-        if (status.repr) {
-          goto suspend;
-        }
-        goto label__outer__continue;
-      } else if (v_type == 1) {
-        v_status = wuffs_deflate__decoder__init_fixed_huffman(self);
-        if (!wuffs_base__status__is_ok(&v_status)) {
-          status = v_status;
-          if (wuffs_base__status__is_error(&status)) {
-            goto exit;
-          } else if (wuffs_base__status__is_suspension(&status)) {
-            status = wuffs_base__make_status(
-                wuffs_base__error__cannot_return_a_suspension);
-            goto exit;
-          }
-          goto ok;
-        }
-      } else if (v_type == 2) {
-        if (a_src) {
-          a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
-        }
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
-        status = wuffs_deflate__decoder__init_dynamic_huffman(self, a_src);
+        if (a_dst) {
+          iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+        }
         if (a_src) {
           iop_a_src = a_src->data.ptr + a_src->meta.ri;
         }
@@ -13020,41 +16307,121 @@ wuffs_deflate__decoder__decode_blocks(wuffs_deflate__decoder* self,
           goto suspend;
         }
       } else {
-        status = wuffs_base__make_status(wuffs_deflate__error__bad_block);
-        goto exit;
-      }
-      self->private_impl.f_end_of_block = false;
-      while (true) {
-        if (a_src) {
-          a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
-        }
-        v_status =
-            wuffs_deflate__decoder__decode_huffman_fast(self, a_dst, a_src);
-        if (a_src) {
-          iop_a_src = a_src->data.ptr + a_src->meta.ri;
-        }
-        if (wuffs_base__status__is_error(&v_status)) {
-          status = v_status;
+        if (v_type == 1) {
+          v_status = wuffs_deflate__decoder__init_fixed_huffman(self);
+          if (!wuffs_base__status__is_ok(&v_status)) {
+            status = v_status;
+            if (wuffs_base__status__is_error(&status)) {
+              goto exit;
+            } else if (wuffs_base__status__is_suspension(&status)) {
+              status = wuffs_base__make_status(
+                  wuffs_base__error__cannot_return_a_suspension);
+              goto exit;
+            }
+            goto ok;
+          }
+        } else if (v_type == 2) {
+          if (a_src) {
+            a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+          }
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+          status = wuffs_deflate__decoder__init_dynamic_huffman(self, a_src);
+          if (a_src) {
+            iop_a_src = a_src->data.ptr + a_src->meta.ri;
+          }
+          if (status.repr) {
+            goto suspend;
+          }
+        } else {
+          status = wuffs_base__make_status(wuffs_deflate__error__bad_block);
           goto exit;
         }
-        if (self->private_impl.f_end_of_block) {
-          goto label__outer__continue;
-        }
-        if (a_src) {
-          a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
-        }
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
-        status =
-            wuffs_deflate__decoder__decode_huffman_slow(self, a_dst, a_src);
-        if (a_src) {
-          iop_a_src = a_src->data.ptr + a_src->meta.ri;
-        }
-        if (status.repr) {
-          goto suspend;
-        }
-        if (self->private_impl.f_end_of_block) {
-          goto label__outer__continue;
+        self->private_impl.f_end_of_block = false;
+        while (true) {
+          v_mark = ((uint64_t)(iop_a_dst - io0_a_dst));
+          if (a_dst) {
+            a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+          }
+          if (a_src) {
+            a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+          }
+          v_status = wuffs_deflate__decoder__decode_huffman_fast(
+              self, a_dst, a_src, a_workbuf);
+          if (a_dst) {
+            iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+          }
+          if (a_src) {
+            iop_a_src = a_src->data.ptr + a_src->meta.ri;
+          }
+          if (self->private_impl.f_collect_stats) {
+            self->private_data.f_stats_counts[4] += wuffs_base__io__count_since(
+                v_mark, ((uint64_t)(iop_a_dst - io0_a_dst)));
+          }
+          if (wuffs_base__status__is_error(&v_status)) {
+            status = v_status;
+            goto exit;
+          }
+          if (self->private_impl.f_end_of_block) {
+            goto label__0__break;
+          }
+          v_mark = ((uint64_t)(iop_a_dst - io0_a_dst));
+          if (a_dst) {
+            a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+          }
+          if (a_src) {
+            a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+          }
+          v_status = wuffs_deflate__decoder__decode_huffman_tail(
+              self, a_dst, a_src, a_workbuf);
+          if (a_dst) {
+            iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+          }
+          if (a_src) {
+            iop_a_src = a_src->data.ptr + a_src->meta.ri;
+          }
+          if (self->private_impl.f_collect_stats) {
+            self->private_data.f_stats_counts[10] +=
+                wuffs_base__io__count_since(
+                    v_mark, ((uint64_t)(iop_a_dst - io0_a_dst)));
+          }
+          if (wuffs_base__status__is_error(&v_status)) {
+            status = v_status;
+            goto exit;
+          }
+          if (self->private_impl.f_end_of_block) {
+            goto label__0__break;
+          }
+          if (a_dst) {
+            a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+          }
+          if (a_src) {
+            a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+          }
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(5);
+          status = wuffs_deflate__decoder__decode_huffman_slow(
+              self, a_dst, a_src, a_workbuf);
+          if (a_dst) {
+            iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+          }
+          if (a_src) {
+            iop_a_src = a_src->data.ptr + a_src->meta.ri;
+          }
+          if (status.repr) {
+            goto suspend;
+          }
+          if (self->private_impl.f_end_of_block) {
+            goto label__0__break;
+          }
         }
+      label__0__break:;
+      }
+      if ((v_final == 0) && self->private_impl.f_report_block_boundaries) {
+        self->private_impl.f_boundary_bit_position =
+            ((wuffs_base__u64__sat_add(
+                  a_src->meta.pos, ((uint64_t)(iop_a_src - io0_a_src))) << 3) -
+             ((uint64_t)(self->private_impl.f_n_bits)));
+        status = wuffs_base__make_status(wuffs_deflate__note__block_boundary);
+        goto ok;
       }
     }
 
@@ -13072,6 +16439,9 @@ suspend:
 
   goto exit;
 exit:
+  if (a_dst) {
+    a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+  }
   if (a_src) {
     a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
   }
@@ -13170,6 +16540,9 @@ wuffs_deflate__decoder__decode_uncompressed(wuffs_deflate__decoder* self,
     while (true) {
       v_n_copied = wuffs_base__io_writer__copy_n32_from_reader(
           &iop_a_dst, io2_a_dst, v_length, &iop_a_src, io2_a_src);
+      if (self->private_impl.f_collect_stats) {
+        self->private_data.f_stats_counts[3] += ((uint64_t)(v_n_copied));
+      }
       if (v_length <= v_n_copied) {
         status = wuffs_base__make_status(NULL);
         goto ok;
@@ -13213,36 +16586,19 @@ exit:
 static wuffs_base__status  //
 wuffs_deflate__decoder__init_fixed_huffman(wuffs_deflate__decoder* self) {
   uint32_t v_i = 0;
-  wuffs_base__status v_status = wuffs_base__make_status(NULL);
 
-  while (v_i < 144) {
-    self->private_data.f_code_lengths[v_i] = 8;
-    v_i += 1;
-  }
-  while (v_i < 256) {
-    self->private_data.f_code_lengths[v_i] = 9;
-    v_i += 1;
-  }
-  while (v_i < 280) {
-    self->private_data.f_code_lengths[v_i] = 7;
-    v_i += 1;
-  }
-  while (v_i < 288) {
-    self->private_data.f_code_lengths[v_i] = 8;
+  while (v_i < 512) {
+    self->private_data.f_huffs[0][v_i] = wuffs_deflate__fixed_lcode_huffs[v_i];
     v_i += 1;
   }
-  while (v_i < 320) {
-    self->private_data.f_code_lengths[v_i] = 5;
+  v_i = 0;
+  while (v_i < 32) {
+    self->private_data.f_huffs[1][v_i] = wuffs_deflate__fixed_dcode_huffs[v_i];
     v_i += 1;
   }
-  v_status = wuffs_deflate__decoder__init_huff(self, 0, 0, 288, 257);
-  if (wuffs_base__status__is_error(&v_status)) {
-    return v_status;
-  }
-  v_status = wuffs_deflate__decoder__init_huff(self, 1, 288, 320, 0);
-  if (wuffs_base__status__is_error(&v_status)) {
-    return v_status;
-  }
+  self->private_impl.f_n_huffs_bits[0] = 9;
+  self->private_impl.f_n_huffs_bits[1] = 5;
+  self->private_impl.f_prev_n_lit = 0;
   return wuffs_base__make_status(NULL);
 }
 
@@ -13358,17 +16714,17 @@ wuffs_deflate__decoder__init_dynamic_huffman(wuffs_deflate__decoder* self,
       self->private_data.f_code_lengths[wuffs_deflate__code_order[v_i]] = 0;
       v_i += 1;
     }
-    v_status = wuffs_deflate__decoder__init_huff(self, 0, 0, 19, 4095);
+    v_status = wuffs_deflate__decoder__init_huff(self, 1, 0, 19, 4095);
     if (wuffs_base__status__is_error(&v_status)) {
       status = v_status;
       goto exit;
     }
-    v_mask = ((((uint32_t)(1)) << self->private_impl.f_n_huffs_bits[0]) - 1);
+    v_mask = ((((uint32_t)(1)) << self->private_impl.f_n_huffs_bits[1]) - 1);
     v_i = 0;
   label__0__continue:;
     while (v_i < (v_n_lit + v_n_dist)) {
       while (true) {
-        v_table_entry = self->private_data.f_huffs[0][(v_bits & v_mask)];
+        v_table_entry = self->private_data.f_huffs[1][(v_bits & v_mask)];
         v_table_entry_n_bits = (v_table_entry & 15);
         if (v_n_bits >= v_table_entry_n_bits) {
           v_bits >>= v_table_entry_n_bits;
@@ -13463,10 +16819,23 @@ wuffs_deflate__decoder__init_dynamic_huffman(wuffs_deflate__decoder* self,
           wuffs_deflate__error__missing_end_of_block_code);
       goto exit;
     }
-    v_status = wuffs_deflate__decoder__init_huff(self, 0, 0, v_n_lit, 257);
-    if (wuffs_base__status__is_error(&v_status)) {
-      status = v_status;
-      goto exit;
+    if (wuffs_deflate__decoder__lcode_lengths_are_unchanged(self, v_n_lit)) {
+      wuffs_base__u64__sat_add_indirect(
+          &self->private_impl.f_n_reused_lcode_tables, 1);
+    } else {
+      self->private_impl.f_prev_n_lit = 0;
+      v_status = wuffs_deflate__decoder__init_huff(self, 0, 0, v_n_lit, 257);
+      if (wuffs_base__status__is_error(&v_status)) {
+        status = v_status;
+        goto exit;
+      }
+      wuffs_base__slice_u8__copy_from_slice(
+          wuffs_base__make_slice_u8(self->private_data.f_prev_lcode_lengths,
+                                    288),
+          wuffs_base__slice_u8__subslice_j(
+              wuffs_base__make_slice_u8(self->private_data.f_code_lengths, 320),
+              v_n_lit));
+      self->private_impl.f_prev_n_lit = v_n_lit;
     }
     v_status = wuffs_deflate__decoder__init_huff(self, 1, v_n_lit,
                                                  (v_n_lit + v_n_dist), 0);
@@ -13508,6 +16877,27 @@ exit:
   return status;
 }
 
+// -------- func deflate.decoder.lcode_lengths_are_unchanged
+
+static bool  //
+wuffs_deflate__decoder__lcode_lengths_are_unchanged(
+    const wuffs_deflate__decoder* self,
+    uint32_t a_n_lit) {
+  uint32_t v_i = 0;
+
+  if (self->private_impl.f_prev_n_lit != a_n_lit) {
+    return false;
+  }
+  while (v_i < a_n_lit) {
+    if (self->private_data.f_code_lengths[v_i] !=
+        self->private_data.f_prev_lcode_lengths[v_i]) {
+      return false;
+    }
+    v_i += 1;
+  }
+  return true;
+}
+
 // -------- func deflate.decoder.init_huff
 
 static wuffs_base__status  //
@@ -13541,6 +16931,9 @@ wuffs_deflate__decoder__init_huff(wuffs_deflate__decoder* self,
   uint32_t v_high_bits = 0;
   uint32_t v_delta = 0;
 
+  if (self->private_impl.f_collect_stats) {
+    self->private_data.f_stats_counts[9] += 1;
+  }
   v_i = a_n_codes0;
   while (v_i < a_n_codes1) {
     if (v_counts[(self->private_data.f_code_lengths[v_i] & 15)] >= 320) {
@@ -13576,7 +16969,7 @@ wuffs_deflate__decoder__init_huff(wuffs_deflate__decoder* self,
     v_i += 1;
   }
   if (v_remaining != 0) {
-    if ((a_which == 1) && (v_counts[1] == 1) &&
+    if ((a_which == 1) && (a_base_symbol == 0) && (v_counts[1] == 1) &&
         (self->private_data.f_code_lengths[a_n_codes0] == 1) &&
         ((((uint32_t)(v_counts[0])) + a_n_codes0 + 1) == a_n_codes1)) {
       self->private_impl.f_n_huffs_bits[1] = 1;
@@ -13730,10 +17123,12 @@ label__1__break:;
         }
         v_next_top = (v_top + (((uint32_t)(1)) << v_j));
         v_redirect_key =
-            (((uint32_t)(wuffs_deflate__reverse8[(v_redirect_key >> 1)])) |
-             ((v_redirect_key & 1) << 8));
+            (((((uint32_t)(wuffs_deflate__reverse8[(v_redirect_key & 255)]))
+               << 8) |
+              ((uint32_t)(wuffs_deflate__reverse8[(v_redirect_key >> 8)]))) >>
+             (16 - 9));
         self->private_data.f_huffs[a_which][v_redirect_key] =
-            (268435465 | (v_top << 8) | (v_j << 4));
+            (268435456 | (v_top << 8) | (v_j << 4) | 9);
       }
     }
     if ((v_key >= 512) || (v_counts[v_prev_cl] <= 0)) {
@@ -13748,13 +17143,15 @@ label__1__break:;
 #if defined(__GNUC__)
 #pragma GCC diagnostic pop
 #endif
-    v_reversed_key = (((uint32_t)(wuffs_deflate__reverse8[(v_key >> 1)])) |
-                      ((v_key & 1) << 8));
-    v_reversed_key >>= (9 - v_cl);
+    v_reversed_key =
+        ((((((uint32_t)(wuffs_deflate__reverse8[(v_key & 255)])) << 8) |
+           ((uint32_t)(wuffs_deflate__reverse8[(v_key >> 8)]))) >>
+          (16 - v_cl)) &
+         511);
     v_symbol = ((uint32_t)(v_symbols[v_i]));
     if (v_symbol == 256) {
       v_value = (536870912 | v_cl);
-    } else if ((v_symbol < 256) && (a_which == 0)) {
+    } else if (v_symbol < a_base_symbol) {
       v_value = (2147483648 | (v_symbol << 8) | v_cl);
     } else if (v_symbol >= a_base_symbol) {
       v_symbol -= a_base_symbol;
@@ -13798,21 +17195,25 @@ label__3__break:;
 static wuffs_base__status  //
 wuffs_deflate__decoder__decode_huffman_fast(wuffs_deflate__decoder* self,
                                             wuffs_base__io_buffer* a_dst,
-                                            wuffs_base__io_buffer* a_src) {
+                                            wuffs_base__io_buffer* a_src,
+                                            wuffs_base__slice_u8 a_workbuf) {
   wuffs_base__status status = wuffs_base__make_status(NULL);
 
-  uint32_t v_bits = 0;
+  uint64_t v_bits = 0;
   uint32_t v_n_bits = 0;
   uint32_t v_table_entry = 0;
   uint32_t v_table_entry_n_bits = 0;
-  uint32_t v_lmask = 0;
-  uint32_t v_dmask = 0;
+  uint64_t v_lmask = 0;
+  uint64_t v_dmask = 0;
   uint32_t v_redir_top = 0;
-  uint32_t v_redir_mask = 0;
+  uint64_t v_redir_mask = 0;
   uint32_t v_length = 0;
   uint32_t v_dist_minus_1 = 0;
   uint32_t v_hlen = 0;
   uint32_t v_hdist = 0;
+  uint64_t v_n_dst_history = 0;
+  uint64_t v_dst_history_floor = 0;
+  bool v_collect_stats = false;
 
   uint8_t* iop_a_dst = NULL;
   uint8_t* io0_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
@@ -13844,24 +17245,18 @@ wuffs_deflate__decoder__decode_huffman_fast(wuffs_deflate__decoder* self,
         wuffs_deflate__error__internal_error_inconsistent_n_bits);
     goto exit;
   }
-  v_bits = self->private_impl.f_bits;
+  v_bits = ((uint64_t)(self->private_impl.f_bits));
   v_n_bits = self->private_impl.f_n_bits;
-  v_lmask = ((((uint32_t)(1)) << self->private_impl.f_n_huffs_bits[0]) - 1);
-  v_dmask = ((((uint32_t)(1)) << self->private_impl.f_n_huffs_bits[1]) - 1);
+  v_dst_history_floor = self->private_impl.f_dst_history_floor;
+  v_collect_stats = self->private_impl.f_collect_stats;
+  v_lmask = ((((uint64_t)(1)) << self->private_impl.f_n_huffs_bits[0]) - 1);
+  v_dmask = ((((uint64_t)(1)) << self->private_impl.f_n_huffs_bits[1]) - 1);
 label__loop__continue:;
-  while ((((uint64_t)(io2_a_dst - iop_a_dst)) >= 258) &&
-         (((uint64_t)(io2_a_src - iop_a_src)) >= 12)) {
-    if (v_n_bits < 15) {
-      v_bits |= (((uint32_t)(wuffs_base__load_u8be__no_bounds_check(iop_a_src)))
-                 << v_n_bits);
-      (iop_a_src += 1, wuffs_base__make_empty_struct());
-      v_n_bits += 8;
-      v_bits |= (((uint32_t)(wuffs_base__load_u8be__no_bounds_check(iop_a_src)))
-                 << v_n_bits);
-      (iop_a_src += 1, wuffs_base__make_empty_struct());
-      v_n_bits += 8;
-    } else {
-    }
+  while ((((uint64_t)(io2_a_dst - iop_a_dst)) >= 266) &&
+         (((uint64_t)(io2_a_src - iop_a_src)) >= 13)) {
+    v_bits |= (wuffs_base__load_u64le__no_bounds_check(iop_a_src) << v_n_bits);
+    (iop_a_src += ((63 - v_n_bits) >> 3), wuffs_base__make_empty_struct());
+    v_n_bits |= 56;
     v_table_entry = self->private_data.f_huffs[0][(v_bits & v_lmask)];
     v_table_entry_n_bits = (v_table_entry & 15);
     v_bits >>= v_table_entry_n_bits;
@@ -13876,24 +17271,10 @@ label__loop__continue:;
       self->private_impl.f_end_of_block = true;
       goto label__loop__break;
     } else if ((v_table_entry >> 28) != 0) {
-      if (v_n_bits < 15) {
-        v_bits |=
-            (((uint32_t)(wuffs_base__load_u8be__no_bounds_check(iop_a_src)))
-             << v_n_bits);
-        (iop_a_src += 1, wuffs_base__make_empty_struct());
-        v_n_bits += 8;
-        v_bits |=
-            (((uint32_t)(wuffs_base__load_u8be__no_bounds_check(iop_a_src)))
-             << v_n_bits);
-        (iop_a_src += 1, wuffs_base__make_empty_struct());
-        v_n_bits += 8;
-      } else {
-      }
       v_redir_top = ((v_table_entry >> 8) & 65535);
-      v_redir_mask = ((((uint32_t)(1)) << ((v_table_entry >> 4) & 15)) - 1);
-      v_table_entry =
-          self->private_data
-              .f_huffs[0][((v_redir_top + (v_bits & v_redir_mask)) & 1023)];
+      v_redir_mask = ((((uint64_t)(1)) << ((v_table_entry >> 4) & 15)) - 1);
+      v_table_entry = self->private_data.f_huffs[0][(
+          (v_redir_top + ((uint32_t)((v_bits & v_redir_mask)))) & 1023)];
       v_table_entry_n_bits = (v_table_entry & 15);
       v_bits >>= v_table_entry_n_bits;
       v_n_bits -= v_table_entry_n_bits;
@@ -13930,34 +17311,21 @@ label__loop__continue:;
     v_length = (((v_table_entry >> 8) & 255) + 3);
     v_table_entry_n_bits = ((v_table_entry >> 4) & 15);
     if (v_table_entry_n_bits > 0) {
-      if (v_n_bits < 15) {
-        v_bits |=
-            (((uint32_t)(wuffs_base__load_u8be__no_bounds_check(iop_a_src)))
-             << v_n_bits);
-        (iop_a_src += 1, wuffs_base__make_empty_struct());
-        v_n_bits += 8;
-        v_bits |=
-            (((uint32_t)(wuffs_base__load_u8be__no_bounds_check(iop_a_src)))
-             << v_n_bits);
-        (iop_a_src += 1, wuffs_base__make_empty_struct());
-        v_n_bits += 8;
-      } else {
-      }
-      v_length =
-          (((v_length + 253 +
-             ((v_bits)&WUFFS_BASE__LOW_BITS_MASK__U32(v_table_entry_n_bits))) &
-            255) +
-           3);
+      v_length = (((v_length + 253 +
+                    ((uint32_t)(((v_bits)&WUFFS_BASE__LOW_BITS_MASK__U64(
+                        v_table_entry_n_bits))))) &
+                   255) +
+                  3);
       v_bits >>= v_table_entry_n_bits;
       v_n_bits -= v_table_entry_n_bits;
     } else {
     }
     if (v_n_bits < 15) {
-      v_bits |= (((uint32_t)(wuffs_base__load_u8be__no_bounds_check(iop_a_src)))
+      v_bits |= (((uint64_t)(wuffs_base__load_u8be__no_bounds_check(iop_a_src)))
                  << v_n_bits);
       (iop_a_src += 1, wuffs_base__make_empty_struct());
       v_n_bits += 8;
-      v_bits |= (((uint32_t)(wuffs_base__load_u8be__no_bounds_check(iop_a_src)))
+      v_bits |= (((uint64_t)(wuffs_base__load_u8be__no_bounds_check(iop_a_src)))
                  << v_n_bits);
       (iop_a_src += 1, wuffs_base__make_empty_struct());
       v_n_bits += 8;
@@ -13970,22 +17338,21 @@ label__loop__continue:;
     if ((v_table_entry >> 28) == 1) {
       if (v_n_bits < 15) {
         v_bits |=
-            (((uint32_t)(wuffs_base__load_u8be__no_bounds_check(iop_a_src)))
+            (((uint64_t)(wuffs_base__load_u8be__no_bounds_check(iop_a_src)))
              << v_n_bits);
         (iop_a_src += 1, wuffs_base__make_empty_struct());
         v_n_bits += 8;
         v_bits |=
-            (((uint32_t)(wuffs_base__load_u8be__no_bounds_check(iop_a_src)))
+            (((uint64_t)(wuffs_base__load_u8be__no_bounds_check(iop_a_src)))
              << v_n_bits);
         (iop_a_src += 1, wuffs_base__make_empty_struct());
         v_n_bits += 8;
       } else {
       }
       v_redir_top = ((v_table_entry >> 8) & 65535);
-      v_redir_mask = ((((uint32_t)(1)) << ((v_table_entry >> 4) & 15)) - 1);
-      v_table_entry =
-          self->private_data
-              .f_huffs[1][((v_redir_top + (v_bits & v_redir_mask)) & 1023)];
+      v_redir_mask = ((((uint64_t)(1)) << ((v_table_entry >> 4) & 15)) - 1);
+      v_table_entry = self->private_data.f_huffs[1][(
+          (v_redir_top + ((uint32_t)((v_bits & v_redir_mask)))) & 1023)];
       v_table_entry_n_bits = (v_table_entry & 15);
       v_bits >>= v_table_entry_n_bits;
       v_n_bits -= v_table_entry_n_bits;
@@ -14004,27 +17371,34 @@ label__loop__continue:;
     v_dist_minus_1 = ((v_table_entry >> 8) & 32767);
     v_table_entry_n_bits = ((v_table_entry >> 4) & 15);
     if (v_n_bits < v_table_entry_n_bits) {
-      v_bits |= (((uint32_t)(wuffs_base__load_u8be__no_bounds_check(iop_a_src)))
+      v_bits |= (((uint64_t)(wuffs_base__load_u8be__no_bounds_check(iop_a_src)))
                  << v_n_bits);
       (iop_a_src += 1, wuffs_base__make_empty_struct());
       v_n_bits += 8;
-      v_bits |= (((uint32_t)(wuffs_base__load_u8be__no_bounds_check(iop_a_src)))
+      v_bits |= (((uint64_t)(wuffs_base__load_u8be__no_bounds_check(iop_a_src)))
                  << v_n_bits);
       (iop_a_src += 1, wuffs_base__make_empty_struct());
       v_n_bits += 8;
     }
     v_dist_minus_1 =
-        ((v_dist_minus_1 +
-          ((v_bits)&WUFFS_BASE__LOW_BITS_MASK__U32(v_table_entry_n_bits))) &
+        ((v_dist_minus_1 + ((uint32_t)(((v_bits)&WUFFS_BASE__LOW_BITS_MASK__U64(
+                               v_table_entry_n_bits))))) &
          32767);
     v_bits >>= v_table_entry_n_bits;
     v_n_bits -= v_table_entry_n_bits;
+    if (v_collect_stats) {
+      self->private_data.f_stats_counts[7] += 1;
+      self->private_data.f_stats_counts[8] += ((uint64_t)(v_length));
+      self->private_data.f_stats_counts[((16 - 3) + v_length)] += 1;
+      self->private_data.f_stats_counts[(272 + v_table_entry_n_bits)] += 1;
+    }
     while (true) {
-      if (((uint64_t)((v_dist_minus_1 + 1))) >
-          ((uint64_t)(iop_a_dst - io0_a_dst))) {
+      v_n_dst_history = wuffs_base__u64__sat_sub(
+          ((uint64_t)(iop_a_dst - io0_a_dst)), v_dst_history_floor);
+      if (((uint64_t)((v_dist_minus_1 + 1))) > v_n_dst_history) {
         v_hlen = 0;
-        v_hdist = ((uint32_t)((((uint64_t)((v_dist_minus_1 + 1))) -
-                               ((uint64_t)(iop_a_dst - io0_a_dst)))));
+        v_hdist = ((uint32_t)(
+            (((uint64_t)((v_dist_minus_1 + 1))) - v_n_dst_history)));
         if (v_length > v_hdist) {
           v_length -= v_hdist;
           v_hlen = v_hdist;
@@ -14037,22 +17411,25 @@ label__loop__continue:;
           goto exit;
         }
         v_hdist = (self->private_impl.f_history_index - v_hdist);
+        if (((uint64_t)(a_workbuf.len)) < 33025) {
+          status =
+              wuffs_base__make_status(wuffs_base__error__bad_workbuf_length);
+          goto exit;
+        }
         wuffs_base__io_writer__copy_n32_from_slice(
             &iop_a_dst, io2_a_dst, v_hlen,
-            wuffs_base__slice_u8__subslice_i(
-                wuffs_base__make_slice_u8(self->private_data.f_history, 33025),
-                (v_hdist & 32767)));
+            wuffs_base__slice_u8__subslice_i(a_workbuf, (v_hdist & 32767)));
         if (v_length == 0) {
           goto label__loop__continue;
         }
-        if (((uint64_t)((v_dist_minus_1 + 1))) >
-            ((uint64_t)(iop_a_dst - io0_a_dst))) {
-          status = wuffs_base__make_status(
-              wuffs_deflate__error__internal_error_inconsistent_distance);
-          goto exit;
-        }
       }
-      wuffs_base__io_writer__copy_n32_from_history_fast(
+      if (((uint64_t)((v_dist_minus_1 + 1))) >
+          ((uint64_t)(iop_a_dst - io0_a_dst))) {
+        status = wuffs_base__make_status(
+            wuffs_deflate__error__internal_error_inconsistent_distance);
+        goto exit;
+      }
+      wuffs_base__io_writer__copy_n32_from_history_8_byte_chunks_fast(
           &iop_a_dst, io0_a_dst, io2_a_dst, v_length, (v_dist_minus_1 + 1));
       goto label__0__break;
     }
@@ -14069,7 +17446,8 @@ label__loop__break:;
       goto exit;
     }
   }
-  self->private_impl.f_bits = (v_bits & ((((uint32_t)(1)) << v_n_bits) - 1));
+  self->private_impl.f_bits =
+      ((uint32_t)((v_bits & ((((uint64_t)(1)) << v_n_bits) - 1))));
   self->private_impl.f_n_bits = v_n_bits;
   if ((self->private_impl.f_n_bits >= 8) ||
       ((self->private_impl.f_bits >> self->private_impl.f_n_bits) != 0)) {
@@ -14094,7 +17472,8 @@ exit:
 static wuffs_base__status  //
 wuffs_deflate__decoder__decode_huffman_slow(wuffs_deflate__decoder* self,
                                             wuffs_base__io_buffer* a_dst,
-                                            wuffs_base__io_buffer* a_src) {
+                                            wuffs_base__io_buffer* a_src,
+                                            wuffs_base__slice_u8 a_workbuf) {
   wuffs_base__status status = wuffs_base__make_status(NULL);
 
   uint32_t v_bits = 0;
@@ -14116,6 +17495,8 @@ wuffs_deflate__decoder__decode_huffman_slow(wuffs_deflate__decoder* self,
   uint32_t v_n_copied = 0;
   uint32_t v_hlen = 0;
   uint32_t v_hdist = 0;
+  uint64_t v_n_dst_history = 0;
+  bool v_collect_stats = false;
 
   uint8_t* iop_a_dst = NULL;
   uint8_t* io0_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
@@ -14156,6 +17537,8 @@ wuffs_deflate__decoder__decode_huffman_slow(wuffs_deflate__decoder* self,
     v_dist_minus_1 = self->private_data.s_decode_huffman_slow[0].v_dist_minus_1;
     v_hlen = self->private_data.s_decode_huffman_slow[0].v_hlen;
     v_hdist = self->private_data.s_decode_huffman_slow[0].v_hdist;
+    v_collect_stats =
+        self->private_data.s_decode_huffman_slow[0].v_collect_stats;
   }
   switch (coro_susp_point) {
     WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
@@ -14169,6 +17552,7 @@ wuffs_deflate__decoder__decode_huffman_slow(wuffs_deflate__decoder* self,
     }
     v_bits = self->private_impl.f_bits;
     v_n_bits = self->private_impl.f_n_bits;
+    v_collect_stats = self->private_impl.f_collect_stats;
     v_lmask = ((((uint32_t)(1)) << self->private_impl.f_n_huffs_bits[0]) - 1);
     v_dmask = ((((uint32_t)(1)) << self->private_impl.f_n_huffs_bits[1]) - 1);
   label__loop__continue:;
@@ -14384,11 +17768,19 @@ wuffs_deflate__decoder__decode_huffman_slow(wuffs_deflate__decoder* self,
         v_bits >>= v_table_entry_n_bits;
         v_n_bits -= v_table_entry_n_bits;
       }
+      if (v_collect_stats) {
+        self->private_data.f_stats_counts[7] += 1;
+        self->private_data.f_stats_counts[8] += ((uint64_t)(v_length));
+        self->private_data.f_stats_counts[((16 - 3) + v_length)] += 1;
+        self->private_data.f_stats_counts[(272 + v_table_entry_n_bits)] += 1;
+      }
       while (true) {
-        if (((uint64_t)((v_dist_minus_1 + 1))) >
-            ((uint64_t)(iop_a_dst - io0_a_dst))) {
-          v_hdist = ((uint32_t)((((uint64_t)((v_dist_minus_1 + 1))) -
-                                 ((uint64_t)(iop_a_dst - io0_a_dst)))));
+        v_n_dst_history =
+            wuffs_base__u64__sat_sub(((uint64_t)(iop_a_dst - io0_a_dst)),
+                                     self->private_impl.f_dst_history_floor);
+        if (((uint64_t)((v_dist_minus_1 + 1))) > v_n_dst_history) {
+          v_hdist = ((uint32_t)(
+              (((uint64_t)((v_dist_minus_1 + 1))) - v_n_dst_history)));
           if (v_length > v_hdist) {
             v_length -= v_hdist;
             v_hlen = v_hdist;
@@ -14403,12 +17795,15 @@ wuffs_deflate__decoder__decode_huffman_slow(wuffs_deflate__decoder* self,
           }
           v_hdist = (self->private_impl.f_history_index - v_hdist);
           while (true) {
+            if (((uint64_t)(a_workbuf.len)) < 33025) {
+              status = wuffs_base__make_status(
+                  wuffs_base__error__bad_workbuf_length);
+              goto exit;
+            }
             v_n_copied = wuffs_base__io_writer__copy_n32_from_slice(
                 &iop_a_dst, io2_a_dst, v_hlen,
-                wuffs_base__slice_u8__subslice_ij(
-                    wuffs_base__make_slice_u8(self->private_data.f_history,
-                                              33025),
-                    (v_hdist & 32767), 32768));
+                wuffs_base__slice_u8__subslice_ij(a_workbuf, (v_hdist & 32767),
+                                                  32768));
             if (v_hlen <= v_n_copied) {
               v_hlen = 0;
               goto label__4__break;
@@ -14427,12 +17822,15 @@ wuffs_deflate__decoder__decode_huffman_slow(wuffs_deflate__decoder* self,
         label__4__break:;
           if (v_hlen > 0) {
             while (true) {
+              if (((uint64_t)(a_workbuf.len)) < 33025) {
+                status = wuffs_base__make_status(
+                    wuffs_base__error__bad_workbuf_length);
+                goto exit;
+              }
               v_n_copied = wuffs_base__io_writer__copy_n32_from_slice(
                   &iop_a_dst, io2_a_dst, v_hlen,
-                  wuffs_base__slice_u8__subslice_ij(
-                      wuffs_base__make_slice_u8(self->private_data.f_history,
-                                                33025),
-                      (v_hdist & 32767), 32768));
+                  wuffs_base__slice_u8__subslice_ij(a_workbuf,
+                                                    (v_hdist & 32767), 32768));
               if (v_hlen <= v_n_copied) {
                 v_hlen = 0;
                 goto label__5__break;
@@ -14495,6 +17893,7 @@ suspend:
   self->private_data.s_decode_huffman_slow[0].v_dist_minus_1 = v_dist_minus_1;
   self->private_data.s_decode_huffman_slow[0].v_hlen = v_hlen;
   self->private_data.s_decode_huffman_slow[0].v_hdist = v_hdist;
+  self->private_data.s_decode_huffman_slow[0].v_collect_stats = v_collect_stats;
 
   goto exit;
 exit:
@@ -14508,124 +17907,315 @@ exit:
   return status;
 }
 
-#endif  // !defined(WUFFS_CONFIG__MODULES) ||
-        // defined(WUFFS_CONFIG__MODULE__DEFLATE)
-
-#if !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__LZW)
-
-// ---------------- Status Codes Implementations
-
-const char* wuffs_lzw__error__bad_code = "#lzw: bad code";
-const char* wuffs_lzw__error__internal_error_inconsistent_i_o =
-    "#lzw: internal error: inconsistent I/O";
-
-// ---------------- Private Consts
-
-// ---------------- Private Initializer Prototypes
-
-// ---------------- Private Function Prototypes
-
-static wuffs_base__empty_struct  //
-wuffs_lzw__decoder__read_from(wuffs_lzw__decoder* self,
-                              wuffs_base__io_buffer* a_src);
+// -------- func deflate.decoder.decode_huffman_tail
 
 static wuffs_base__status  //
-wuffs_lzw__decoder__write_to(wuffs_lzw__decoder* self,
-                             wuffs_base__io_buffer* a_dst);
-
-// ---------------- VTables
-
-const wuffs_base__io_transformer__func_ptrs
-    wuffs_lzw__decoder__func_ptrs_for__wuffs_base__io_transformer = {
-        (wuffs_base__status(*)(void*,
-                               wuffs_base__io_buffer*,
-                               wuffs_base__io_buffer*,
-                               wuffs_base__slice_u8))(
-            &wuffs_lzw__decoder__transform_io),
-        (wuffs_base__range_ii_u64(*)(const void*))(
-            &wuffs_lzw__decoder__workbuf_len),
-};
-
-// ---------------- Initializer Implementations
+wuffs_deflate__decoder__decode_huffman_tail(wuffs_deflate__decoder* self,
+                                            wuffs_base__io_buffer* a_dst,
+                                            wuffs_base__io_buffer* a_src,
+                                            wuffs_base__slice_u8 a_workbuf) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
 
-wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT  //
-wuffs_lzw__decoder__initialize(wuffs_lzw__decoder* self,
-                               size_t sizeof_star_self,
-                               uint64_t wuffs_version,
-                               uint32_t initialize_flags) {
-  if (!self) {
-    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
-  }
-  if (sizeof(*self) != sizeof_star_self) {
-    return wuffs_base__make_status(wuffs_base__error__bad_sizeof_receiver);
-  }
-  if (((wuffs_version >> 32) != WUFFS_VERSION_MAJOR) ||
-      (((wuffs_version >> 16) & 0xFFFF) > WUFFS_VERSION_MINOR)) {
-    return wuffs_base__make_status(wuffs_base__error__bad_wuffs_version);
-  }
+  uint64_t v_bits = 0;
+  uint32_t v_n_bits = 0;
+  uint64_t v_tbits = 0;
+  uint32_t v_tn_bits = 0;
+  uint32_t v_table_entry = 0;
+  uint32_t v_table_entry_n_bits = 0;
+  uint64_t v_lmask = 0;
+  uint64_t v_dmask = 0;
+  uint32_t v_redir_top = 0;
+  uint64_t v_redir_mask = 0;
+  uint32_t v_length = 0;
+  uint32_t v_dist_minus_1 = 0;
+  uint32_t v_hlen = 0;
+  uint32_t v_hdist = 0;
+  uint64_t v_n_dst_history = 0;
+  uint64_t v_dst_history_floor = 0;
+  bool v_collect_stats = false;
 
-  if ((initialize_flags & WUFFS_INITIALIZE__ALREADY_ZEROED) != 0) {
-// The whole point of this if-check is to detect an uninitialized *self.
-// We disable the warning on GCC. Clang-5.0 does not have this warning.
-#if !defined(__clang__) && defined(__GNUC__)
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
-#endif
-    if (self->private_impl.magic != 0) {
-      return wuffs_base__make_status(
-          wuffs_base__error__initialize_falsely_claimed_already_zeroed);
+  uint8_t* iop_a_dst = NULL;
+  uint8_t* io0_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_dst) {
+    io0_a_dst = a_dst->data.ptr;
+    io1_a_dst = io0_a_dst + a_dst->meta.wi;
+    iop_a_dst = io1_a_dst;
+    io2_a_dst = io0_a_dst + a_dst->data.len;
+    if (a_dst->meta.closed) {
+      io2_a_dst = iop_a_dst;
     }
-#if !defined(__clang__) && defined(__GNUC__)
-#pragma GCC diagnostic pop
-#endif
-  } else {
-    if ((initialize_flags &
-         WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED) == 0) {
-      memset(self, 0, sizeof(*self));
-      initialize_flags |= WUFFS_INITIALIZE__ALREADY_ZEROED;
+  }
+  uint8_t* iop_a_src = NULL;
+  uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  if ((self->private_impl.f_n_bits >= 8) ||
+      ((self->private_impl.f_bits >> (self->private_impl.f_n_bits & 7)) != 0)) {
+    status = wuffs_base__make_status(
+        wuffs_deflate__error__internal_error_inconsistent_n_bits);
+    goto exit;
+  }
+  v_bits = ((uint64_t)(self->private_impl.f_bits));
+  v_n_bits = self->private_impl.f_n_bits;
+  v_dst_history_floor = self->private_impl.f_dst_history_floor;
+  v_collect_stats = self->private_impl.f_collect_stats;
+  v_lmask = ((((uint64_t)(1)) << self->private_impl.f_n_huffs_bits[0]) - 1);
+  v_dmask = ((((uint64_t)(1)) << self->private_impl.f_n_huffs_bits[1]) - 1);
+label__loop__continue:;
+  while (((uint64_t)(io2_a_dst - iop_a_dst)) > 0) {
+    if (((uint64_t)(io2_a_src - iop_a_src)) >= 8) {
+      v_bits |=
+          (wuffs_base__load_u64le__no_bounds_check(iop_a_src) << v_n_bits);
+      (iop_a_src += ((63 - v_n_bits) >> 3), wuffs_base__make_empty_struct());
+      v_n_bits |= 56;
     } else {
-      memset(&(self->private_impl), 0, sizeof(self->private_impl));
+      while ((v_n_bits <= 55) && (((uint64_t)(io2_a_src - iop_a_src)) > 0)) {
+        v_bits |=
+            (((uint64_t)(wuffs_base__load_u8be__no_bounds_check(iop_a_src)))
+             << v_n_bits);
+        (iop_a_src += 1, wuffs_base__make_empty_struct());
+        v_n_bits += 8;
+      }
+    }
+    v_tbits = v_bits;
+    v_tn_bits = v_n_bits;
+    v_table_entry = self->private_data.f_huffs[0][(v_tbits & v_lmask)];
+    v_table_entry_n_bits = (v_table_entry & 15);
+    if (v_tn_bits < v_table_entry_n_bits) {
+      goto label__loop__break;
+    }
+    v_tbits >>= v_table_entry_n_bits;
+    v_tn_bits -= v_table_entry_n_bits;
+    if ((v_table_entry >> 31) != 0) {
+      (wuffs_base__store_u8be__no_bounds_check(
+           iop_a_dst, ((uint8_t)(((v_table_entry >> 8) & 255)))),
+       iop_a_dst += 1, wuffs_base__make_empty_struct());
+      v_bits = v_tbits;
+      v_n_bits = v_tn_bits;
+      goto label__loop__continue;
+    } else if ((v_table_entry >> 30) != 0) {
+    } else if ((v_table_entry >> 29) != 0) {
+      v_bits = v_tbits;
+      v_n_bits = v_tn_bits;
+      self->private_impl.f_end_of_block = true;
+      goto label__loop__break;
+    } else if ((v_table_entry >> 28) != 0) {
+      v_redir_top = ((v_table_entry >> 8) & 65535);
+      v_redir_mask = ((((uint64_t)(1)) << ((v_table_entry >> 4) & 15)) - 1);
+      v_table_entry = self->private_data.f_huffs[0][(
+          (v_redir_top + ((uint32_t)((v_tbits & v_redir_mask)))) & 1023)];
+      v_table_entry_n_bits = (v_table_entry & 15);
+      if (v_tn_bits < v_table_entry_n_bits) {
+        goto label__loop__break;
+      }
+      v_tbits >>= v_table_entry_n_bits;
+      v_tn_bits -= v_table_entry_n_bits;
+      if ((v_table_entry >> 31) != 0) {
+        (wuffs_base__store_u8be__no_bounds_check(
+             iop_a_dst, ((uint8_t)(((v_table_entry >> 8) & 255)))),
+         iop_a_dst += 1, wuffs_base__make_empty_struct());
+        v_bits = v_tbits;
+        v_n_bits = v_tn_bits;
+        goto label__loop__continue;
+      } else if ((v_table_entry >> 30) != 0) {
+      } else if ((v_table_entry >> 29) != 0) {
+        v_bits = v_tbits;
+        v_n_bits = v_tn_bits;
+        self->private_impl.f_end_of_block = true;
+        goto label__loop__break;
+      } else if ((v_table_entry >> 28) != 0) {
+        status = wuffs_base__make_status(
+            wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
+        goto exit;
+      } else if ((v_table_entry >> 27) != 0) {
+        status =
+            wuffs_base__make_status(wuffs_deflate__error__bad_huffman_code);
+        goto exit;
+      } else {
+        status = wuffs_base__make_status(
+            wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
+        goto exit;
+      }
+    } else if ((v_table_entry >> 27) != 0) {
+      status = wuffs_base__make_status(wuffs_deflate__error__bad_huffman_code);
+      goto exit;
+    } else {
+      status = wuffs_base__make_status(
+          wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
+      goto exit;
+    }
+    v_length = (((v_table_entry >> 8) & 255) + 3);
+    v_table_entry_n_bits = ((v_table_entry >> 4) & 15);
+    if (v_table_entry_n_bits > 0) {
+      if (v_tn_bits < v_table_entry_n_bits) {
+        goto label__loop__break;
+      }
+      v_length = (((v_length + 253 +
+                    ((uint32_t)(((v_tbits)&WUFFS_BASE__LOW_BITS_MASK__U64(
+                        v_table_entry_n_bits))))) &
+                   255) +
+                  3);
+      v_tbits >>= v_table_entry_n_bits;
+      v_tn_bits -= v_table_entry_n_bits;
+    }
+    v_table_entry = self->private_data.f_huffs[1][(v_tbits & v_dmask)];
+    v_table_entry_n_bits = (v_table_entry & 15);
+    if (v_tn_bits < v_table_entry_n_bits) {
+      goto label__loop__break;
+    }
+    v_tbits >>= v_table_entry_n_bits;
+    v_tn_bits -= v_table_entry_n_bits;
+    if ((v_table_entry >> 28) == 1) {
+      v_redir_top = ((v_table_entry >> 8) & 65535);
+      v_redir_mask = ((((uint64_t)(1)) << ((v_table_entry >> 4) & 15)) - 1);
+      v_table_entry = self->private_data.f_huffs[1][(
+          (v_redir_top + ((uint32_t)((v_tbits & v_redir_mask)))) & 1023)];
+      v_table_entry_n_bits = (v_table_entry & 15);
+      if (v_tn_bits < v_table_entry_n_bits) {
+        goto label__loop__break;
+      }
+      v_tbits >>= v_table_entry_n_bits;
+      v_tn_bits -= v_table_entry_n_bits;
+    }
+    if ((v_table_entry >> 24) != 64) {
+      if ((v_table_entry >> 24) == 8) {
+        status =
+            wuffs_base__make_status(wuffs_deflate__error__bad_huffman_code);
+        goto exit;
+      }
+      status = wuffs_base__make_status(
+          wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
+      goto exit;
+    }
+    v_dist_minus_1 = ((v_table_entry >> 8) & 32767);
+    v_table_entry_n_bits = ((v_table_entry >> 4) & 15);
+    if (v_tn_bits < v_table_entry_n_bits) {
+      goto label__loop__break;
+    }
+    v_dist_minus_1 = ((v_dist_minus_1 +
+                       ((uint32_t)(((v_tbits)&WUFFS_BASE__LOW_BITS_MASK__U64(
+                           v_table_entry_n_bits))))) &
+                      32767);
+    v_tbits >>= v_table_entry_n_bits;
+    v_tn_bits -= v_table_entry_n_bits;
+    if (((uint64_t)(v_length)) > ((uint64_t)(io2_a_dst - iop_a_dst))) {
+      goto label__loop__break;
+    }
+    v_bits = v_tbits;
+    v_n_bits = v_tn_bits;
+    if (v_collect_stats) {
+      self->private_data.f_stats_counts[7] += 1;
+      self->private_data.f_stats_counts[8] += ((uint64_t)(v_length));
+      self->private_data.f_stats_counts[((16 - 3) + v_length)] += 1;
+      self->private_data.f_stats_counts[(272 + v_table_entry_n_bits)] += 1;
+    }
+    v_n_dst_history = wuffs_base__u64__sat_sub(
+        ((uint64_t)(iop_a_dst - io0_a_dst)), v_dst_history_floor);
+    if (((uint64_t)((v_dist_minus_1 + 1))) > v_n_dst_history) {
+      v_hlen = 0;
+      v_hdist =
+          ((uint32_t)((((uint64_t)((v_dist_minus_1 + 1))) - v_n_dst_history)));
+      if (v_length > v_hdist) {
+        v_length -= v_hdist;
+        v_hlen = v_hdist;
+      } else {
+        v_hlen = v_length;
+        v_length = 0;
+      }
+      if (self->private_impl.f_history_index < v_hdist) {
+        status = wuffs_base__make_status(wuffs_deflate__error__bad_distance);
+        goto exit;
+      }
+      v_hdist = (self->private_impl.f_history_index - v_hdist);
+      if (((uint64_t)(a_workbuf.len)) < 33025) {
+        status = wuffs_base__make_status(wuffs_base__error__bad_workbuf_length);
+        goto exit;
+      }
+      wuffs_base__io_writer__copy_n32_from_slice(
+          &iop_a_dst, io2_a_dst, v_hlen,
+          wuffs_base__slice_u8__subslice_i(a_workbuf, (v_hdist & 32767)));
+      if (v_length == 0) {
+        goto label__loop__continue;
+      }
+    }
+    if (((uint64_t)((v_dist_minus_1 + 1))) >
+        ((uint64_t)(iop_a_dst - io0_a_dst))) {
+      status = wuffs_base__make_status(
+          wuffs_deflate__error__internal_error_inconsistent_distance);
+      goto exit;
+    }
+    if (((uint64_t)(v_length)) > ((uint64_t)(io2_a_dst - iop_a_dst))) {
+      status = wuffs_base__make_status(
+          wuffs_deflate__error__internal_error_inconsistent_distance);
+      goto exit;
     }
+    wuffs_base__io_writer__copy_n32_from_history_fast(
+        &iop_a_dst, io0_a_dst, io2_a_dst, v_length, (v_dist_minus_1 + 1));
+  }
+label__loop__break:;
+  while (v_n_bits >= 8) {
+    v_n_bits -= 8;
+    if (iop_a_src > io1_a_src) {
+      (iop_a_src--, wuffs_base__make_empty_struct());
+    } else {
+      status = wuffs_base__make_status(
+          wuffs_deflate__error__internal_error_inconsistent_i_o);
+      goto exit;
+    }
+  }
+  self->private_impl.f_bits =
+      ((uint32_t)((v_bits & ((((uint64_t)(1)) << v_n_bits) - 1))));
+  self->private_impl.f_n_bits = v_n_bits;
+  if ((self->private_impl.f_n_bits >= 8) ||
+      ((self->private_impl.f_bits >> self->private_impl.f_n_bits) != 0)) {
+    status = wuffs_base__make_status(
+        wuffs_deflate__error__internal_error_inconsistent_n_bits);
+    goto exit;
+  }
+  goto exit;
+exit:
+  if (a_dst) {
+    a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+  }
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
   }
 
-  self->private_impl.magic = WUFFS_BASE__MAGIC;
-  self->private_impl.vtable_for__wuffs_base__io_transformer.vtable_name =
-      wuffs_base__io_transformer__vtable_name;
-  self->private_impl.vtable_for__wuffs_base__io_transformer.function_pointers =
-      (const void*)(&wuffs_lzw__decoder__func_ptrs_for__wuffs_base__io_transformer);
-  return wuffs_base__make_status(NULL);
-}
-
-size_t  //
-sizeof__wuffs_lzw__decoder() {
-  return sizeof(wuffs_lzw__decoder);
+  return status;
 }
 
-// ---------------- Function Implementations
-
-// -------- func lzw.decoder.set_literal_width
+// -------- func deflate.encoder.set_level
 
 WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
-wuffs_lzw__decoder__set_literal_width(wuffs_lzw__decoder* self, uint32_t a_lw) {
+wuffs_deflate__encoder__set_level(wuffs_deflate__encoder* self, uint32_t a_l) {
   if (!self) {
     return wuffs_base__make_empty_struct();
   }
   if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
     return wuffs_base__make_empty_struct();
   }
-  if (a_lw > 8) {
-    self->private_impl.magic = WUFFS_BASE__DISABLED;
-    return wuffs_base__make_empty_struct();
-  }
 
-  self->private_impl.f_set_literal_width_arg = (a_lw + 1);
+  if (a_l >= 9) {
+    self->private_impl.f_level_plus_1 = 10;
+  } else {
+    self->private_impl.f_level_plus_1 = (a_l + 1);
+  }
   return wuffs_base__make_empty_struct();
 }
 
-// -------- func lzw.decoder.workbuf_len
+// -------- func deflate.encoder.workbuf_len
 
 WUFFS_BASE__MAYBE_STATIC wuffs_base__range_ii_u64  //
-wuffs_lzw__decoder__workbuf_len(const wuffs_lzw__decoder* self) {
+wuffs_deflate__encoder__workbuf_len(const wuffs_deflate__encoder* self) {
   if (!self) {
     return wuffs_base__utility__empty_range_ii_u64();
   }
@@ -14637,13 +18227,13 @@ wuffs_lzw__decoder__workbuf_len(const wuffs_lzw__decoder* self) {
   return wuffs_base__utility__make_range_ii_u64(0, 0);
 }
 
-// -------- func lzw.decoder.transform_io
+// -------- func deflate.encoder.transform_io
 
 WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
-wuffs_lzw__decoder__transform_io(wuffs_lzw__decoder* self,
-                                 wuffs_base__io_buffer* a_dst,
-                                 wuffs_base__io_buffer* a_src,
-                                 wuffs_base__slice_u8 a_workbuf) {
+wuffs_deflate__encoder__transform_io(wuffs_deflate__encoder* self,
+                                     wuffs_base__io_buffer* a_dst,
+                                     wuffs_base__io_buffer* a_src,
+                                     wuffs_base__slice_u8 a_workbuf) {
   if (!self) {
     return wuffs_base__make_status(wuffs_base__error__bad_receiver);
   }
@@ -14666,60 +18256,119 @@ wuffs_lzw__decoder__transform_io(wuffs_lzw__decoder* self,
   self->private_impl.active_coroutine = 0;
   wuffs_base__status status = wuffs_base__make_status(NULL);
 
-  uint32_t v_i = 0;
+  uint32_t v_level = 0;
+  uint32_t v_wmax = 0;
+  uint64_t v_n = 0;
+  wuffs_base__slice_u8 v_s = {0};
+  bool v_final = false;
+
+  uint8_t* iop_a_src = NULL;
+  uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
 
   uint32_t coro_susp_point = self->private_impl.p_transform_io[0];
+  if (coro_susp_point) {
+    v_level = self->private_data.s_transform_io[0].v_level;
+    v_wmax = self->private_data.s_transform_io[0].v_wmax;
+    v_final = self->private_data.s_transform_io[0].v_final;
+  }
   switch (coro_susp_point) {
     WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
 
-    self->private_impl.f_literal_width = 8;
-    if (self->private_impl.f_set_literal_width_arg > 0) {
-      self->private_impl.f_literal_width =
-          (self->private_impl.f_set_literal_width_arg - 1);
+    v_level = 6;
+    if (self->private_impl.f_level_plus_1 > 0) {
+      v_level = (self->private_impl.f_level_plus_1 - 1);
     }
-    self->private_impl.f_clear_code =
-        (((uint32_t)(1)) << self->private_impl.f_literal_width);
-    self->private_impl.f_end_code = (self->private_impl.f_clear_code + 1);
-    self->private_impl.f_save_code = self->private_impl.f_end_code;
-    self->private_impl.f_prev_code = self->private_impl.f_end_code;
-    self->private_impl.f_width = (self->private_impl.f_literal_width + 1);
-    self->private_impl.f_bits = 0;
-    self->private_impl.f_n_bits = 0;
-    self->private_impl.f_output_ri = 0;
-    self->private_impl.f_output_wi = 0;
-    v_i = 0;
-    while (v_i < self->private_impl.f_clear_code) {
-      self->private_data.f_lm1s[v_i] = 0;
-      self->private_data.f_suffixes[v_i][0] = ((uint8_t)(v_i));
-      v_i += 1;
+    wuffs_deflate__encoder__start_stream(self, v_level);
+    v_wmax = 65536;
+    if (v_level == 0) {
+      v_wmax = 65535;
     }
   label__0__continue:;
     while (true) {
-      wuffs_lzw__decoder__read_from(self, a_src);
-      if (self->private_impl.f_output_wi > 0) {
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
-        status = wuffs_lzw__decoder__write_to(self, a_dst);
-        if (status.repr) {
-          goto suspend;
+      if (self->private_impl.f_wend < v_wmax) {
+        v_n = ((uint64_t)(io2_a_src - iop_a_src));
+        if (v_n > ((uint64_t)(wuffs_base__u32__sat_sub(
+                      v_wmax, self->private_impl.f_wend)))) {
+          v_n = ((uint64_t)(
+              wuffs_base__u32__sat_sub(v_wmax, self->private_impl.f_wend)));
+        }
+        v_s = wuffs_base__io_reader__take(&iop_a_src, io2_a_src, v_n);
+        v_n = wuffs_base__slice_u8__copy_from_slice(
+            wuffs_base__slice_u8__subslice_ij(
+                wuffs_base__make_slice_u8(self->private_data.f_window, 65800),
+                self->private_impl.f_wend, v_wmax),
+            v_s);
+        v_n = wuffs_base__u64__sat_add(v_n,
+                                       ((uint64_t)(self->private_impl.f_wend)));
+        self->private_impl.f_wend =
+            ((uint32_t)(wuffs_base__u64__min(v_n, ((uint64_t)(v_wmax)))));
+      }
+      v_final = ((a_src && a_src->meta.closed) &&
+                 (((uint64_t)(io2_a_src - iop_a_src)) <= 0));
+      if (v_level == 0) {
+        self->private_impl.f_pos = self->private_impl.f_wend;
+        if (!v_final && (self->private_impl.f_wend < v_wmax)) {
+          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(1);
+          goto label__0__continue;
         }
-      }
-      if (self->private_impl.f_read_from_return_value == 0) {
-        goto label__0__break;
-      } else if (self->private_impl.f_read_from_return_value == 1) {
-        goto label__0__continue;
-      } else if (self->private_impl.f_read_from_return_value == 2) {
-        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(2);
-      } else if (self->private_impl.f_read_from_return_value == 3) {
-        status = wuffs_base__make_status(wuffs_lzw__error__bad_code);
-        goto exit;
       } else {
-        status = wuffs_base__make_status(
-            wuffs_lzw__error__internal_error_inconsistent_i_o);
-        goto exit;
+        if (!v_final &&
+            (self->private_impl.f_wend <= (self->private_impl.f_pos + 262))) {
+          if (self->private_impl.f_wend < 65536) {
+            status =
+                wuffs_base__make_status(wuffs_base__suspension__short_read);
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(2);
+          } else {
+            wuffs_deflate__encoder__slide_window(self);
+          }
+          goto label__0__continue;
+        }
+        if (self->private_impl.f_lazy) {
+          wuffs_deflate__encoder__match_lazy(self, v_final);
+        } else {
+          wuffs_deflate__encoder__match_greedy(self, v_final);
+        }
+        if ((self->private_impl.f_n_tokens < 16384) &&
+            (!v_final ||
+             (self->private_impl.f_pos < self->private_impl.f_wend) ||
+             self->private_impl.f_match_available)) {
+          goto label__0__continue;
+        }
+      }
+      v_final =
+          (v_final && (self->private_impl.f_pos >= self->private_impl.f_wend) &&
+           !self->private_impl.f_match_available);
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+      status = wuffs_deflate__encoder__write_block(self, a_dst, v_final);
+      if (status.repr) {
+        goto suspend;
+      }
+      if (v_final) {
+        self->private_impl.f_n_bits =
+            ((self->private_impl.f_n_bits + 7) & 4294967288u);
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+        status = wuffs_deflate__encoder__flush_bits(self, a_dst);
+        if (status.repr) {
+          goto suspend;
+        }
+        status = wuffs_base__make_status(NULL);
+        goto ok;
+      }
+      if (v_level == 0) {
+        self->private_impl.f_pos = 0;
+        self->private_impl.f_wend = 0;
+        self->private_impl.f_block_start = 0;
       }
     }
-  label__0__break:;
 
     goto ok;
   ok:
@@ -14733,219 +18382,439 @@ suspend:
       wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
   self->private_impl.active_coroutine =
       wuffs_base__status__is_suspension(&status) ? 1 : 0;
+  self->private_data.s_transform_io[0].v_level = v_level;
+  self->private_data.s_transform_io[0].v_wmax = v_wmax;
+  self->private_data.s_transform_io[0].v_final = v_final;
 
   goto exit;
 exit:
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
   if (wuffs_base__status__is_error(&status)) {
     self->private_impl.magic = WUFFS_BASE__DISABLED;
   }
   return status;
 }
 
-// -------- func lzw.decoder.read_from
+// -------- func deflate.encoder.start_stream
 
 static wuffs_base__empty_struct  //
-wuffs_lzw__decoder__read_from(wuffs_lzw__decoder* self,
-                              wuffs_base__io_buffer* a_src) {
-  uint32_t v_clear_code = 0;
-  uint32_t v_end_code = 0;
-  uint32_t v_save_code = 0;
-  uint32_t v_prev_code = 0;
-  uint32_t v_width = 0;
-  uint32_t v_bits = 0;
-  uint32_t v_n_bits = 0;
-  uint32_t v_output_wi = 0;
-  uint32_t v_code = 0;
-  uint32_t v_c = 0;
-  uint32_t v_o = 0;
-  uint32_t v_steps = 0;
-  uint8_t v_first_byte = 0;
-  uint16_t v_lm1_b = 0;
-  uint16_t v_lm1_a = 0;
+wuffs_deflate__encoder__start_stream(wuffs_deflate__encoder* self,
+                                     uint32_t a_level) {
+  uint32_t v_i = 0;
 
-  uint8_t* iop_a_src = NULL;
-  uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
-  uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
-  uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
-  if (a_src) {
-    io0_a_src = a_src->data.ptr;
-    io1_a_src = io0_a_src + a_src->meta.ri;
-    iop_a_src = io1_a_src;
-    io2_a_src = io0_a_src + a_src->meta.wi;
+  self->private_impl.f_lazy = (a_level >= 4);
+  self->private_impl.f_max_chain = wuffs_deflate__level_max_chains[a_level];
+  self->private_impl.f_nice_len = wuffs_deflate__level_nice_lengths[a_level];
+  self->private_impl.f_max_lazy = wuffs_deflate__level_max_lazies[a_level];
+  self->private_impl.f_good_len = wuffs_deflate__level_good_lengths[a_level];
+  self->private_impl.f_pos = 0;
+  self->private_impl.f_wend = 0;
+  self->private_impl.f_block_start = 0;
+  self->private_impl.f_block_start_valid = true;
+  self->private_impl.f_match_available = false;
+  self->private_impl.f_prev_len = 0;
+  self->private_impl.f_prev_dist = 0;
+  self->private_impl.f_n_tokens = 0;
+  self->private_impl.f_bits = 0;
+  self->private_impl.f_n_bits = 0;
+  v_i = 0;
+  while (v_i < 32768) {
+    self->private_data.f_head[v_i] = 0;
+    v_i += 1;
   }
+  wuffs_deflate__encoder__clear_freqs(self);
+  return wuffs_base__make_empty_struct();
+}
 
-  v_clear_code = self->private_impl.f_clear_code;
-  v_end_code = self->private_impl.f_end_code;
-  v_save_code = self->private_impl.f_save_code;
-  v_prev_code = self->private_impl.f_prev_code;
-  v_width = self->private_impl.f_width;
-  v_bits = self->private_impl.f_bits;
-  v_n_bits = self->private_impl.f_n_bits;
-  v_output_wi = self->private_impl.f_output_wi;
-  while (true) {
-    if (v_n_bits < v_width) {
-      if (((uint64_t)(io2_a_src - iop_a_src)) >= 4) {
-        v_bits |=
-            (wuffs_base__load_u32le__no_bounds_check(iop_a_src) << v_n_bits);
-        (iop_a_src += ((31 - v_n_bits) >> 3), wuffs_base__make_empty_struct());
-        v_n_bits |= 24;
-      } else if (((uint64_t)(io2_a_src - iop_a_src)) <= 0) {
-        self->private_impl.f_read_from_return_value = 2;
-        goto label__0__break;
-      } else {
-        v_bits |=
-            (((uint32_t)(wuffs_base__load_u8be__no_bounds_check(iop_a_src)))
-             << v_n_bits);
-        (iop_a_src += 1, wuffs_base__make_empty_struct());
-        v_n_bits += 8;
-        if (v_n_bits >= v_width) {
-        } else if (((uint64_t)(io2_a_src - iop_a_src)) <= 0) {
-          self->private_impl.f_read_from_return_value = 2;
-          goto label__0__break;
-        } else {
-          v_bits |=
-              (((uint32_t)(wuffs_base__load_u8be__no_bounds_check(iop_a_src)))
-               << v_n_bits);
-          (iop_a_src += 1, wuffs_base__make_empty_struct());
-          v_n_bits += 8;
-          if (v_n_bits < v_width) {
-            self->private_impl.f_read_from_return_value = 4;
-            goto label__0__break;
-          }
-        }
-      }
+// -------- func deflate.encoder.clear_freqs
+
+static wuffs_base__empty_struct  //
+wuffs_deflate__encoder__clear_freqs(wuffs_deflate__encoder* self) {
+  uint32_t v_i = 0;
+
+  v_i = 0;
+  while (v_i < 288) {
+    self->private_data.f_freqs[0][v_i] = 0;
+    v_i += 1;
+  }
+  v_i = 0;
+  while (v_i < 30) {
+    self->private_data.f_freqs[1][v_i] = 0;
+    v_i += 1;
+  }
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func deflate.encoder.slide_window
+
+static wuffs_base__empty_struct  //
+wuffs_deflate__encoder__slide_window(wuffs_deflate__encoder* self) {
+  uint32_t v_i = 0;
+  uint32_t v_v = 0;
+
+  if ((self->private_impl.f_pos < 32768) ||
+      (self->private_impl.f_wend < 32768)) {
+    return wuffs_base__make_empty_struct();
+  }
+  wuffs_base__slice_u8__copy_from_slice(
+      wuffs_base__slice_u8__subslice_j(
+          wuffs_base__make_slice_u8(self->private_data.f_window, 65800), 32768),
+      wuffs_base__slice_u8__subslice_ij(
+          wuffs_base__make_slice_u8(self->private_data.f_window, 65800), 32768,
+          65536));
+  self->private_impl.f_pos -= 32768;
+  self->private_impl.f_wend -= 32768;
+  if (self->private_impl.f_block_start >= 32768) {
+    self->private_impl.f_block_start -= 32768;
+  } else {
+    self->private_impl.f_block_start = 0;
+    self->private_impl.f_block_start_valid = false;
+  }
+  v_i = 0;
+  while (v_i < 32768) {
+    v_v = ((uint32_t)(self->private_data.f_head[v_i]));
+    if (v_v >= 32768) {
+      self->private_data.f_head[v_i] = ((uint16_t)((v_v - 32768)));
+    } else {
+      self->private_data.f_head[v_i] = 0;
     }
-    v_code = ((v_bits)&WUFFS_BASE__LOW_BITS_MASK__U32(v_width));
-    v_bits >>= v_width;
-    v_n_bits -= v_width;
-    if (v_code < v_clear_code) {
-      self->private_data.f_output[v_output_wi] = ((uint8_t)(v_code));
-      v_output_wi = ((v_output_wi + 1) & 8191);
-      if (v_save_code <= 4095) {
-        v_lm1_a = ((self->private_data.f_lm1s[v_prev_code] + 1) & 4095);
-        self->private_data.f_lm1s[v_save_code] = v_lm1_a;
-        if ((v_lm1_a % 8) != 0) {
-          self->private_impl.f_prefixes[v_save_code] =
-              self->private_impl.f_prefixes[v_prev_code];
-          memcpy(self->private_data.f_suffixes[v_save_code],
-                 self->private_data.f_suffixes[v_prev_code],
-                 sizeof(self->private_data.f_suffixes[v_save_code]));
-          self->private_data.f_suffixes[v_save_code][(v_lm1_a % 8)] =
-              ((uint8_t)(v_code));
-        } else {
-          self->private_impl.f_prefixes[v_save_code] =
-              ((uint16_t)(v_prev_code));
-          self->private_data.f_suffixes[v_save_code][0] = ((uint8_t)(v_code));
-        }
-        v_save_code += 1;
-        if (v_width < 12) {
-          v_width += (1 & (v_save_code >> v_width));
-        }
-        v_prev_code = v_code;
-      }
-    } else if (v_code <= v_end_code) {
-      if (v_code == v_end_code) {
-        self->private_impl.f_read_from_return_value = 0;
-        goto label__0__break;
-      }
-      v_save_code = v_end_code;
-      v_prev_code = v_end_code;
-      v_width = (self->private_impl.f_literal_width + 1);
-    } else if (v_code <= v_save_code) {
-      v_c = v_code;
-      if (v_code == v_save_code) {
-        v_c = v_prev_code;
-      }
-      v_o = ((v_output_wi +
-              (((uint32_t)(self->private_data.f_lm1s[v_c])) & 4294967288)) &
-             8191);
-      v_output_wi =
-          ((v_output_wi + 1 + ((uint32_t)(self->private_data.f_lm1s[v_c]))) &
-           8191);
-      v_steps = (((uint32_t)(self->private_data.f_lm1s[v_c])) >> 3);
-      while (true) {
-        memcpy((self->private_data.f_output) + (v_o),
-               (self->private_data.f_suffixes[v_c]), 8);
-        if (v_steps <= 0) {
+    v_v = ((uint32_t)(self->private_data.f_prev[v_i]));
+    if (v_v >= 32768) {
+      self->private_data.f_prev[v_i] = ((uint16_t)((v_v - 32768)));
+    } else {
+      self->private_data.f_prev[v_i] = 0;
+    }
+    v_i += 1;
+  }
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func deflate.encoder.insert_hash
+
+static uint32_t  //
+wuffs_deflate__encoder__insert_hash(wuffs_deflate__encoder* self,
+                                    uint32_t a_p) {
+  uint32_t v_x = 0;
+  uint32_t v_h = 0;
+  uint32_t v_ret = 0;
+
+  v_x = ((((uint32_t)(self->private_data.f_window[a_p])) |
+          (((uint32_t)(self->private_data.f_window[(a_p + 1)])) << 8) |
+          (((uint32_t)(self->private_data.f_window[(a_p + 2)])) << 16)) *
+         2654435761u);
+  v_h = (v_x >> 17);
+  v_ret = ((uint32_t)(self->private_data.f_head[v_h]));
+  self->private_data.f_head[v_h] = ((uint16_t)(a_p));
+  self->private_data.f_prev[(a_p & 32767)] = ((uint16_t)(v_ret));
+  return v_ret;
+}
+
+// -------- func deflate.encoder.longest_match
+
+static uint32_t  //
+wuffs_deflate__encoder__longest_match(wuffs_deflate__encoder* self,
+                                      uint32_t a_pos,
+                                      uint32_t a_cand,
+                                      uint32_t a_max_len,
+                                      uint32_t a_best_len,
+                                      uint32_t a_max_chain) {
+  uint32_t v_chain = 0;
+  uint32_t v_c = 0;
+  uint32_t v_next = 0;
+  uint32_t v_dist = 0;
+  uint32_t v_best = 0;
+  uint32_t v_best_dist = 0;
+  uint32_t v_len = 0;
+
+  v_chain = a_max_chain;
+  v_c = a_cand;
+  v_best = a_best_len;
+  while (v_chain > 0) {
+    if (a_pos <= v_c) {
+      goto label__0__break;
+    }
+    if ((a_pos - v_c) > 32768) {
+      goto label__0__break;
+    }
+    v_dist = (a_pos - v_c);
+    if (v_best >= a_max_len) {
+      goto label__0__break;
+    }
+    if (self->private_data.f_window[(v_c + v_best)] ==
+        self->private_data.f_window[(a_pos + v_best)]) {
+      v_len = 0;
+      while (v_len < a_max_len) {
+        if (self->private_data.f_window[(v_c + v_len)] !=
+            self->private_data.f_window[(a_pos + v_len)]) {
           goto label__1__break;
         }
-        v_steps -= 1;
-        v_o = ((v_o - 8) & 8191);
-        v_c = ((uint32_t)(self->private_impl.f_prefixes[v_c]));
+        v_len += 1;
       }
     label__1__break:;
-      v_first_byte = self->private_data.f_suffixes[v_c][0];
-      if (v_code == v_save_code) {
-        self->private_data.f_output[v_output_wi] = v_first_byte;
-        v_output_wi = ((v_output_wi + 1) & 8191);
-      }
-      if (v_save_code <= 4095) {
-        v_lm1_b = ((self->private_data.f_lm1s[v_prev_code] + 1) & 4095);
-        self->private_data.f_lm1s[v_save_code] = v_lm1_b;
-        if ((v_lm1_b % 8) != 0) {
-          self->private_impl.f_prefixes[v_save_code] =
-              self->private_impl.f_prefixes[v_prev_code];
-          memcpy(self->private_data.f_suffixes[v_save_code],
-                 self->private_data.f_suffixes[v_prev_code],
-                 sizeof(self->private_data.f_suffixes[v_save_code]));
-          self->private_data.f_suffixes[v_save_code][(v_lm1_b % 8)] =
-              v_first_byte;
-        } else {
-          self->private_impl.f_prefixes[v_save_code] =
-              ((uint16_t)(v_prev_code));
-          self->private_data.f_suffixes[v_save_code][0] =
-              ((uint8_t)(v_first_byte));
-        }
-        v_save_code += 1;
-        if (v_width < 12) {
-          v_width += (1 & (v_save_code >> v_width));
+      if (v_len > v_best) {
+        v_best = v_len;
+        v_best_dist = v_dist;
+        if (v_best >= self->private_impl.f_nice_len) {
+          goto label__0__break;
         }
-        v_prev_code = v_code;
       }
-    } else {
-      self->private_impl.f_read_from_return_value = 3;
-      goto label__0__break;
     }
-    if (v_output_wi > 4095) {
-      self->private_impl.f_read_from_return_value = 1;
+    v_next = ((uint32_t)(self->private_data.f_prev[(v_c & 32767)]));
+    if (v_next >= v_c) {
       goto label__0__break;
     }
+    v_c = v_next;
+    wuffs_base__u32__sat_sub_indirect(&v_chain, 1);
   }
 label__0__break:;
-  if (self->private_impl.f_read_from_return_value != 2) {
-    while (v_n_bits >= 8) {
-      v_n_bits -= 8;
-      if (iop_a_src > io1_a_src) {
-        (iop_a_src--, wuffs_base__make_empty_struct());
-      } else {
-        self->private_impl.f_read_from_return_value = 4;
-        goto label__2__break;
-      }
-    }
-  label__2__break:;
-  }
-  self->private_impl.f_save_code = v_save_code;
-  self->private_impl.f_prev_code = v_prev_code;
-  self->private_impl.f_width = v_width;
-  self->private_impl.f_bits = v_bits;
-  self->private_impl.f_n_bits = v_n_bits;
-  self->private_impl.f_output_wi = v_output_wi;
-  if (a_src) {
-    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  if (v_best_dist == 0) {
+    return 0;
   }
+  return ((v_best << 16) | v_best_dist);
+}
 
+// -------- func deflate.encoder.match_greedy
+
+static wuffs_base__empty_struct  //
+wuffs_deflate__encoder__match_greedy(wuffs_deflate__encoder* self,
+                                     bool a_final) {
+  uint32_t v_pos = 0;
+  uint32_t v_wend = 0;
+  uint32_t v_limit = 0;
+  uint32_t v_n_tokens = 0;
+  uint32_t v_cand = 0;
+  uint32_t v_max_len = 0;
+  uint32_t v_avail = 0;
+  uint32_t v_m = 0;
+  uint32_t v_j = 0;
+  uint32_t v_ml = 0;
+  uint32_t v_md = 0;
+  uint32_t v_len = 0;
+  uint32_t v_dist = 0;
+  uint32_t v_i = 0;
+  uint32_t v_c = 0;
+
+  v_pos = self->private_impl.f_pos;
+  v_wend = self->private_impl.f_wend;
+  v_limit = v_wend;
+  if (!a_final && (v_wend >= 262)) {
+    v_limit = (v_wend - 262);
+  }
+  v_n_tokens = self->private_impl.f_n_tokens;
+  while ((v_pos < v_limit) && (v_n_tokens < 16384)) {
+    if (v_wend <= v_pos) {
+      goto label__0__break;
+    }
+    v_avail = (v_wend - v_pos);
+    v_len = 0;
+    if (v_avail >= 3) {
+      v_cand = wuffs_deflate__encoder__insert_hash(self, v_pos);
+      v_max_len = wuffs_base__u32__min(v_avail, 258);
+      v_m = wuffs_deflate__encoder__longest_match(
+          self, v_pos, v_cand, v_max_len, 2, self->private_impl.f_max_chain);
+      v_ml = (v_m >> 16);
+      v_md = (v_m & 65535);
+      v_len = wuffs_base__u32__min(v_ml, 258);
+      v_dist = wuffs_base__u32__min(v_md, 32768);
+    }
+    if ((v_len >= 3) && (v_dist > 0)) {
+      v_c = ((uint32_t)(wuffs_deflate__length_to_lcode[((v_len - 3) & 255)]));
+      self->private_data.f_tokens[v_n_tokens] =
+          (2147483648 | ((v_len - 3) << 16) | (v_dist - 1));
+      v_n_tokens += 1;
+      self->private_data.f_freqs[0][(257 + v_c)] += 1;
+      self->private_data
+          .f_freqs[1][wuffs_deflate__encoder__dcode_for(self, (v_dist - 1))] +=
+          1;
+      v_i = (v_pos + 1);
+      v_j = (v_pos + v_len);
+      v_pos = wuffs_base__u32__min(v_j, v_wend);
+      if (v_len <= self->private_impl.f_max_lazy) {
+        while (v_i < v_pos) {
+          if ((v_i + 3) > v_wend) {
+            goto label__1__break;
+          }
+          wuffs_deflate__encoder__insert_hash(self, v_i);
+          v_i += 1;
+        }
+      label__1__break:;
+      }
+    } else {
+      self->private_data.f_tokens[v_n_tokens] =
+          ((uint32_t)(self->private_data.f_window[v_pos]));
+      v_n_tokens += 1;
+      self->private_data.f_freqs[0][self->private_data.f_window[v_pos]] += 1;
+      v_pos += 1;
+    }
+  }
+label__0__break:;
+  self->private_impl.f_pos = v_pos;
+  self->private_impl.f_n_tokens = v_n_tokens;
   return wuffs_base__make_empty_struct();
 }
 
-// -------- func lzw.decoder.write_to
+// -------- func deflate.encoder.match_lazy
+
+static wuffs_base__empty_struct  //
+wuffs_deflate__encoder__match_lazy(wuffs_deflate__encoder* self, bool a_final) {
+  uint32_t v_pos = 0;
+  uint32_t v_wend = 0;
+  uint32_t v_limit = 0;
+  uint32_t v_n_tokens = 0;
+  uint32_t v_cand = 0;
+  uint32_t v_max_len = 0;
+  uint32_t v_avail = 0;
+  uint32_t v_m = 0;
+  uint32_t v_j = 0;
+  uint32_t v_ml = 0;
+  uint32_t v_md = 0;
+  uint32_t v_chain = 0;
+  uint32_t v_cur_len = 0;
+  uint32_t v_cur_dist = 0;
+  uint32_t v_prev_len = 0;
+  uint32_t v_prev_dist = 0;
+  uint32_t v_end = 0;
+  uint32_t v_i = 0;
+  uint32_t v_c = 0;
+  uint8_t v_b = 0;
+
+  v_pos = self->private_impl.f_pos;
+  v_wend = self->private_impl.f_wend;
+  v_limit = v_wend;
+  if (!a_final && (v_wend >= 262)) {
+    v_limit = (v_wend - 262);
+  }
+  v_n_tokens = self->private_impl.f_n_tokens;
+  v_prev_len = self->private_impl.f_prev_len;
+  v_prev_dist = self->private_impl.f_prev_dist;
+  while ((v_pos < v_limit) && (v_n_tokens < 16384)) {
+    if (v_wend <= v_pos) {
+      goto label__0__break;
+    }
+    v_avail = (v_wend - v_pos);
+    v_cur_len = 0;
+    v_cur_dist = 0;
+    if (v_avail >= 3) {
+      v_cand = wuffs_deflate__encoder__insert_hash(self, v_pos);
+      if (v_prev_len < self->private_impl.f_max_lazy) {
+        v_max_len = wuffs_base__u32__min(v_avail, 258);
+        v_chain = self->private_impl.f_max_chain;
+        if (v_prev_len >= self->private_impl.f_good_len) {
+          v_chain = (v_chain >> 2);
+        }
+        v_m = wuffs_deflate__encoder__longest_match(
+            self, v_pos, v_cand, v_max_len, wuffs_base__u32__max(v_prev_len, 2),
+            v_chain);
+        v_ml = (v_m >> 16);
+        v_md = (v_m & 65535);
+        v_cur_len = wuffs_base__u32__min(v_ml, 258);
+        v_cur_dist = wuffs_base__u32__min(v_md, 32768);
+        if ((v_cur_len == 3) && (v_cur_dist > 4096)) {
+          v_cur_len = 0;
+        }
+      }
+    }
+    if ((v_prev_len >= 3) && (v_prev_dist > 0) && (v_cur_len <= v_prev_len)) {
+      v_c = ((uint32_t)(
+          wuffs_deflate__length_to_lcode[((v_prev_len - 3) & 255)]));
+      self->private_data.f_tokens[v_n_tokens] =
+          (2147483648 | ((v_prev_len - 3) << 16) | (v_prev_dist - 1));
+      self->private_data.f_freqs[0][(257 + v_c)] += 1;
+      self->private_data.f_freqs[1][wuffs_deflate__encoder__dcode_for(
+          self, (v_prev_dist - 1))] += 1;
+      v_n_tokens += 1;
+      if (v_pos < 1) {
+        return wuffs_base__make_empty_struct();
+      }
+      v_j = ((v_pos - 1) + v_prev_len);
+      v_end = wuffs_base__u32__min(v_j, v_wend);
+      v_i = (v_pos + 1);
+      while (v_i < v_end) {
+        if ((v_i + 3) > v_wend) {
+          goto label__1__break;
+        }
+        wuffs_deflate__encoder__insert_hash(self, v_i);
+        v_i += 1;
+      }
+    label__1__break:;
+      v_pos = v_end;
+      self->private_impl.f_match_available = false;
+      v_prev_len = 0;
+      v_prev_dist = 0;
+    } else {
+      if (self->private_impl.f_match_available) {
+        if (v_pos < 1) {
+          return wuffs_base__make_empty_struct();
+        }
+        v_b = self->private_data.f_window[(v_pos - 1)];
+        self->private_data.f_tokens[v_n_tokens] = ((uint32_t)(v_b));
+        self->private_data.f_freqs[0][v_b] += 1;
+        v_n_tokens += 1;
+      }
+      self->private_impl.f_match_available = true;
+      v_prev_len = v_cur_len;
+      v_prev_dist = v_cur_dist;
+      v_pos += 1;
+    }
+  }
+label__0__break:;
+  if (a_final && (v_pos >= v_wend) && self->private_impl.f_match_available &&
+      (v_n_tokens < 16384) && (v_pos >= 1)) {
+    v_b = self->private_data.f_window[(v_pos - 1)];
+    self->private_data.f_tokens[v_n_tokens] = ((uint32_t)(v_b));
+    self->private_data.f_freqs[0][v_b] += 1;
+    v_n_tokens += 1;
+    self->private_impl.f_match_available = false;
+    v_prev_len = 0;
+    v_prev_dist = 0;
+  }
+  self->private_impl.f_pos = v_pos;
+  self->private_impl.f_n_tokens = v_n_tokens;
+  self->private_impl.f_prev_len = v_prev_len;
+  self->private_impl.f_prev_dist = v_prev_dist;
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func deflate.encoder.dcode_for
+
+static uint32_t  //
+wuffs_deflate__encoder__dcode_for(const wuffs_deflate__encoder* self,
+                                  uint32_t a_d) {
+  if (a_d < 256) {
+    return ((uint32_t)(wuffs_deflate__distance_to_dcode[a_d]));
+  }
+  return ((uint32_t)(wuffs_deflate__distance_to_dcode[(256 + (a_d >> 7))]));
+}
+
+// -------- func deflate.encoder.write_block
 
 static wuffs_base__status  //
-wuffs_lzw__decoder__write_to(wuffs_lzw__decoder* self,
-                             wuffs_base__io_buffer* a_dst) {
+wuffs_deflate__encoder__write_block(wuffs_deflate__encoder* self,
+                                    wuffs_base__io_buffer* a_dst,
+                                    bool a_final) {
   wuffs_base__status status = wuffs_base__make_status(NULL);
 
-  wuffs_base__slice_u8 v_s = {0};
-  uint64_t v_n = 0;
+  uint32_t v_level = 0;
+  uint32_t v_hlit = 0;
+  uint32_t v_hdist = 0;
+  uint32_t v_hclen = 0;
+  uint64_t v_dynamic_len = 0;
+  uint64_t v_fixed_len = 0;
+  uint64_t v_stored_len = 0;
+  uint64_t v_data_len = 0;
+  uint32_t v_block_end = 0;
+  uint32_t v_cu = 0;
+  uint32_t v_bs = 0;
+  uint32_t v_i = 0;
+  uint32_t v_n = 0;
+  uint32_t v_remaining = 0;
+  uint64_t v_copied = 0;
+  uint32_t v_tok = 0;
+  uint32_t v_c = 0;
+  uint32_t v_x = 0;
 
   uint8_t* iop_a_dst = NULL;
   uint8_t* io0_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
@@ -14961,43 +18830,286 @@ wuffs_lzw__decoder__write_to(wuffs_lzw__decoder* self,
     }
   }
 
-  uint32_t coro_susp_point = self->private_impl.p_write_to[0];
+  uint32_t coro_susp_point = self->private_impl.p_write_block[0];
+  if (coro_susp_point) {
+    v_hlit = self->private_data.s_write_block[0].v_hlit;
+    v_hdist = self->private_data.s_write_block[0].v_hdist;
+    v_hclen = self->private_data.s_write_block[0].v_hclen;
+    v_block_end = self->private_data.s_write_block[0].v_block_end;
+    v_i = self->private_data.s_write_block[0].v_i;
+    v_n = self->private_data.s_write_block[0].v_n;
+    v_remaining = self->private_data.s_write_block[0].v_remaining;
+    v_tok = self->private_data.s_write_block[0].v_tok;
+  }
   switch (coro_susp_point) {
     WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
 
-    while (self->private_impl.f_output_wi > 0) {
-      if (self->private_impl.f_output_ri > self->private_impl.f_output_wi) {
+    v_level = 6;
+    if (self->private_impl.f_level_plus_1 > 0) {
+      v_level = (self->private_impl.f_level_plus_1 - 1);
+    }
+    if (v_level > 0) {
+      self->private_data.f_freqs[0][256] = 1;
+      wuffs_deflate__encoder__build_huffman(self, 0, 286, 15);
+      wuffs_deflate__encoder__build_huffman(self, 1, 30, 15);
+      self->private_data.f_lens[0][286] = 0;
+      self->private_data.f_lens[0][287] = 0;
+      v_hlit = 286;
+      while (v_hlit > 257) {
+        if (self->private_data.f_lens[0][(v_hlit - 1)] != 0) {
+          goto label__0__break;
+        }
+        v_hlit -= 1;
+      }
+    label__0__break:;
+      v_hdist = 30;
+      while (v_hdist > 1) {
+        if (self->private_data.f_lens[1][(v_hdist - 1)] != 0) {
+          goto label__1__break;
+        }
+        v_hdist -= 1;
+      }
+    label__1__break:;
+      wuffs_deflate__encoder__run_length_encode(self, v_hlit, v_hdist);
+      wuffs_deflate__encoder__build_huffman(self, 2, 19, 7);
+      v_hclen = 19;
+      while (v_hclen > 4) {
+        if (self->private_data
+                .f_lens[2][wuffs_deflate__code_order[(v_hclen - 1)]] != 0) {
+          goto label__2__break;
+        }
+        v_hclen -= 1;
+      }
+    label__2__break:;
+      v_dynamic_len = (((17 + (3 * ((uint64_t)(v_hclen)))) +
+                        wuffs_deflate__encoder__cl_cost(self)) +
+                       wuffs_deflate__encoder__data_cost(self, false));
+      v_fixed_len = (3 + wuffs_deflate__encoder__data_cost(self, true));
+    }
+    v_block_end = self->private_impl.f_pos;
+    if (self->private_impl.f_match_available && (v_block_end > 0)) {
+      v_block_end -= 1;
+    }
+    v_stored_len = 281474976710655;
+    if (self->private_impl.f_block_start_valid &&
+        (v_block_end >= self->private_impl.f_block_start)) {
+      v_data_len =
+          ((uint64_t)((v_block_end - self->private_impl.f_block_start)));
+      v_stored_len = ((8 * v_data_len) + (42 * (1 + (v_data_len / 65535))));
+    }
+    if ((v_level == 0) ||
+        ((v_stored_len <= v_fixed_len) && (v_stored_len <= v_dynamic_len))) {
+      if (!self->private_impl.f_block_start_valid ||
+          (v_block_end < self->private_impl.f_block_start)) {
         status = wuffs_base__make_status(
-            wuffs_lzw__error__internal_error_inconsistent_i_o);
+            wuffs_deflate__error__internal_error_inconsistent_encoder_state);
         goto exit;
       }
-      v_s = wuffs_base__slice_u8__subslice_ij(
-          wuffs_base__make_slice_u8(self->private_data.f_output, 8199),
-          self->private_impl.f_output_ri, self->private_impl.f_output_wi);
-      v_n = wuffs_base__io_writer__copy_from_slice(&iop_a_dst, io2_a_dst, v_s);
-      if (v_n == ((uint64_t)(v_s.len))) {
-        self->private_impl.f_output_ri = 0;
-        self->private_impl.f_output_wi = 0;
-        status = wuffs_base__make_status(NULL);
-        goto ok;
+      v_remaining = (v_block_end - self->private_impl.f_block_start);
+      while (true) {
+        v_n = wuffs_base__u32__min(v_remaining, 65535);
+        wuffs_base__u32__sat_sub_indirect(&v_remaining, v_n);
+        v_x = 0;
+        if (a_final && (v_remaining == 0)) {
+          v_x = 1;
+        }
+        self->private_impl.f_bits |=
+            (((uint64_t)(v_x)) << (self->private_impl.f_n_bits & 63));
+        self->private_impl.f_n_bits =
+            (((self->private_impl.f_n_bits + 3) + 7) & 4294967288u);
+        if (a_dst) {
+          a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+        }
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+        status = wuffs_deflate__encoder__flush_bits(self, a_dst);
+        if (a_dst) {
+          iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+        }
+        if (status.repr) {
+          goto suspend;
+        }
+        self->private_impl.f_bits = ((uint64_t)((((v_n ^ 65535) << 16) | v_n)));
+        self->private_impl.f_n_bits = 32;
+        if (a_dst) {
+          a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+        }
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+        status = wuffs_deflate__encoder__flush_bits(self, a_dst);
+        if (a_dst) {
+          iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+        }
+        if (status.repr) {
+          goto suspend;
+        }
+        while (v_n > 0) {
+          if (v_block_end < v_n) {
+            status = wuffs_base__make_status(
+                wuffs_deflate__error__internal_error_inconsistent_encoder_state);
+            goto exit;
+          } else if (self->private_impl.f_block_start > (v_block_end - v_n)) {
+            status = wuffs_base__make_status(
+                wuffs_deflate__error__internal_error_inconsistent_encoder_state);
+            goto exit;
+          }
+          v_copied = wuffs_base__io_writer__copy_from_slice(
+              &iop_a_dst, io2_a_dst,
+              wuffs_base__slice_u8__subslice_ij(
+                  wuffs_base__make_slice_u8(self->private_data.f_window, 65800),
+                  self->private_impl.f_block_start,
+                  (self->private_impl.f_block_start + v_n)));
+          v_cu = ((uint32_t)((v_copied & 65535)));
+          if (v_n < v_cu) {
+            status = wuffs_base__make_status(
+                wuffs_deflate__error__internal_error_inconsistent_encoder_state);
+            goto exit;
+          }
+          v_n -= v_cu;
+          v_bs = (self->private_impl.f_block_start + v_cu);
+          self->private_impl.f_block_start = wuffs_base__u32__min(v_bs, 65536);
+          if (v_n > 0) {
+            status =
+                wuffs_base__make_status(wuffs_base__suspension__short_write);
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(3);
+          }
+        }
+        if (v_remaining == 0) {
+          goto label__3__break;
+        }
+      }
+    label__3__break:;
+    } else {
+      if (v_dynamic_len < v_fixed_len) {
+        if (a_dst) {
+          a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+        }
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+        status = wuffs_deflate__encoder__write_dynamic_header(
+            self, a_dst, a_final, v_hlit, v_hdist, v_hclen);
+        if (a_dst) {
+          iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+        }
+        if (status.repr) {
+          goto suspend;
+        }
+      } else {
+        wuffs_deflate__encoder__set_fixed_lens(self);
+        v_x = 2;
+        if (a_final) {
+          v_x = 3;
+        }
+        self->private_impl.f_bits |=
+            (((uint64_t)(v_x)) << (self->private_impl.f_n_bits & 63));
+        self->private_impl.f_n_bits += 3;
+      }
+      wuffs_deflate__encoder__assign_codes(self, 0, 288);
+      wuffs_deflate__encoder__assign_codes(self, 1, 30);
+      v_i = 0;
+      while (v_i <= self->private_impl.f_n_tokens) {
+        if (v_i < self->private_impl.f_n_tokens) {
+          v_tok = self->private_data.f_tokens[(v_i & (16384 - 1))];
+        } else {
+          v_tok = 256;
+        }
+        if (v_tok < 2147483648) {
+          v_x = (v_tok & 511);
+          v_c = self->private_data.f_codes[0][wuffs_base__u32__min(v_x, 287)];
+          self->private_impl.f_bits |= (((uint64_t)((v_c & 65535)))
+                                        << (self->private_impl.f_n_bits & 63));
+          self->private_impl.f_n_bits += (v_c >> 16);
+        } else {
+          v_x = ((v_tok >> 16) & 255);
+          v_c = self->private_data.f_codes[0][(
+              257 + ((uint32_t)(wuffs_deflate__length_to_lcode[v_x])))];
+          self->private_impl.f_bits |= (((uint64_t)((v_c & 65535)))
+                                        << (self->private_impl.f_n_bits & 63));
+          self->private_impl.f_n_bits += (v_c >> 16);
+          v_c = ((uint32_t)(wuffs_deflate__length_to_lcode[v_x]));
+          self->private_impl.f_bits |=
+              (((uint64_t)(((v_x + 3) - wuffs_deflate__lcode_bases[v_c])))
+               << (self->private_impl.f_n_bits & 63));
+          self->private_impl.f_n_bits += wuffs_deflate__lcode_n_extra_bits[v_c];
+          if (self->private_impl.f_n_bits >= 32) {
+            if (((uint64_t)(io2_a_dst - iop_a_dst)) >= 4) {
+              (wuffs_base__store_u32le__no_bounds_check(
+                   iop_a_dst,
+                   ((uint32_t)((self->private_impl.f_bits & 4294967295)))),
+               iop_a_dst += 4, wuffs_base__make_empty_struct());
+              self->private_impl.f_bits >>= 32;
+              self->private_impl.f_n_bits -= 32;
+            } else {
+              if (a_dst) {
+                a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+              }
+              WUFFS_BASE__COROUTINE_SUSPENSION_POINT(5);
+              status = wuffs_deflate__encoder__flush_bits(self, a_dst);
+              if (a_dst) {
+                iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+              }
+              if (status.repr) {
+                goto suspend;
+              }
+            }
+          }
+          v_x = (v_tok & 32767);
+          v_c = wuffs_deflate__encoder__dcode_for(self, v_x);
+          self->private_impl.f_bits |=
+              (((uint64_t)((self->private_data.f_codes[1][v_c] & 65535)))
+               << (self->private_impl.f_n_bits & 63));
+          self->private_impl.f_n_bits +=
+              (self->private_data.f_codes[1][v_c] >> 16);
+          self->private_impl.f_bits |=
+              (((uint64_t)(((v_x + 1) - wuffs_deflate__dcode_bases[v_c])))
+               << (self->private_impl.f_n_bits & 63));
+          self->private_impl.f_n_bits += wuffs_deflate__dcode_n_extra_bits[v_c];
+        }
+        if (self->private_impl.f_n_bits >= 32) {
+          if (((uint64_t)(io2_a_dst - iop_a_dst)) >= 4) {
+            (wuffs_base__store_u32le__no_bounds_check(
+                 iop_a_dst,
+                 ((uint32_t)((self->private_impl.f_bits & 4294967295)))),
+             iop_a_dst += 4, wuffs_base__make_empty_struct());
+            self->private_impl.f_bits >>= 32;
+            self->private_impl.f_n_bits -= 32;
+          } else {
+            if (a_dst) {
+              a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+            }
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(6);
+            status = wuffs_deflate__encoder__flush_bits(self, a_dst);
+            if (a_dst) {
+              iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+            }
+            if (status.repr) {
+              goto suspend;
+            }
+          }
+        }
+        v_i += 1;
       }
-      self->private_impl.f_output_ri =
-          ((self->private_impl.f_output_ri + ((uint32_t)((v_n & 4294967295)))) &
-           8191);
-      status = wuffs_base__make_status(wuffs_base__suspension__short_write);
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(1);
     }
+    self->private_impl.f_block_start = v_block_end;
+    self->private_impl.f_block_start_valid = true;
+    self->private_impl.f_n_tokens = 0;
+    wuffs_deflate__encoder__clear_freqs(self);
 
     goto ok;
   ok:
-    self->private_impl.p_write_to[0] = 0;
+    self->private_impl.p_write_block[0] = 0;
     goto exit;
   }
 
   goto suspend;
 suspend:
-  self->private_impl.p_write_to[0] =
+  self->private_impl.p_write_block[0] =
       wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_data.s_write_block[0].v_hlit = v_hlit;
+  self->private_data.s_write_block[0].v_hdist = v_hdist;
+  self->private_data.s_write_block[0].v_hclen = v_hclen;
+  self->private_data.s_write_block[0].v_block_end = v_block_end;
+  self->private_data.s_write_block[0].v_i = v_i;
+  self->private_data.s_write_block[0].v_n = v_n;
+  self->private_data.s_write_block[0].v_remaining = v_remaining;
+  self->private_data.s_write_block[0].v_tok = v_tok;
 
   goto exit;
 exit:
@@ -15008,271 +19120,630 @@ exit:
   return status;
 }
 
-// -------- func lzw.decoder.flush
+// -------- func deflate.encoder.flush_bits
 
-WUFFS_BASE__MAYBE_STATIC wuffs_base__slice_u8  //
-wuffs_lzw__decoder__flush(wuffs_lzw__decoder* self) {
-  if (!self) {
-    return wuffs_base__make_slice_u8(NULL, 0);
-  }
-  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
-    return wuffs_base__make_slice_u8(NULL, 0);
+static wuffs_base__status  //
+wuffs_deflate__encoder__flush_bits(wuffs_deflate__encoder* self,
+                                   wuffs_base__io_buffer* a_dst) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint8_t* iop_a_dst = NULL;
+  uint8_t* io0_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_dst) {
+    io0_a_dst = a_dst->data.ptr;
+    io1_a_dst = io0_a_dst + a_dst->meta.wi;
+    iop_a_dst = io1_a_dst;
+    io2_a_dst = io0_a_dst + a_dst->data.len;
+    if (a_dst->meta.closed) {
+      io2_a_dst = iop_a_dst;
+    }
   }
 
-  wuffs_base__slice_u8 v_s = {0};
+  uint32_t coro_susp_point = self->private_impl.p_flush_bits[0];
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
 
-  if (self->private_impl.f_output_ri <= self->private_impl.f_output_wi) {
-    v_s = wuffs_base__slice_u8__subslice_ij(
-        wuffs_base__make_slice_u8(self->private_data.f_output, 8199),
-        self->private_impl.f_output_ri, self->private_impl.f_output_wi);
+    while (self->private_impl.f_n_bits >= 8) {
+      self->private_data.s_flush_bits[0].scratch =
+          ((uint8_t)((self->private_impl.f_bits & 255)));
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+      if (iop_a_dst == io2_a_dst) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+        goto suspend;
+      }
+      *iop_a_dst++ = ((uint8_t)(self->private_data.s_flush_bits[0].scratch));
+      self->private_impl.f_bits >>= 8;
+      self->private_impl.f_n_bits -= 8;
+    }
+
+    goto ok;
+  ok:
+    self->private_impl.p_flush_bits[0] = 0;
+    goto exit;
   }
-  self->private_impl.f_output_ri = 0;
-  self->private_impl.f_output_wi = 0;
-  return v_s;
-}
 
-#endif  // !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__LZW)
+  goto suspend;
+suspend:
+  self->private_impl.p_flush_bits[0] =
+      wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
 
-#if !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__GIF)
+  goto exit;
+exit:
+  if (a_dst) {
+    a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+  }
 
-// ---------------- Status Codes Implementations
+  return status;
+}
 
-const char* wuffs_gif__error__bad_block = "#gif: bad block";
-const char* wuffs_gif__error__bad_extension_label = "#gif: bad extension label";
-const char* wuffs_gif__error__bad_frame_size = "#gif: bad frame size";
-const char* wuffs_gif__error__bad_graphic_control = "#gif: bad graphic control";
-const char* wuffs_gif__error__bad_header = "#gif: bad header";
-const char* wuffs_gif__error__bad_literal_width = "#gif: bad literal width";
-const char* wuffs_gif__error__bad_palette = "#gif: bad palette";
-const char* wuffs_gif__error__internal_error_inconsistent_ri_wi =
-    "#gif: internal error: inconsistent ri/wi";
+// -------- func deflate.encoder.write_dynamic_header
 
-// ---------------- Private Consts
+static wuffs_base__status  //
+wuffs_deflate__encoder__write_dynamic_header(wuffs_deflate__encoder* self,
+                                             wuffs_base__io_buffer* a_dst,
+                                             bool a_final,
+                                             uint32_t a_hlit,
+                                             uint32_t a_hdist,
+                                             uint32_t a_hclen) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
 
-static const uint32_t              //
-    wuffs_gif__interlace_start[5]  //
-    WUFFS_BASE__POTENTIALLY_UNUSED = {
-        4294967295, 1, 2, 4, 0,
-};
+  uint32_t v_x = 0;
+  uint32_t v_i = 0;
+  uint32_t v_tok = 0;
+  uint32_t v_c = 0;
 
-static const uint8_t               //
-    wuffs_gif__interlace_delta[5]  //
-    WUFFS_BASE__POTENTIALLY_UNUSED = {
-        1, 2, 4, 8, 8,
-};
+  uint32_t coro_susp_point = self->private_impl.p_write_dynamic_header[0];
+  if (coro_susp_point) {
+    v_i = self->private_data.s_write_dynamic_header[0].v_i;
+  }
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
 
-static const uint8_t               //
-    wuffs_gif__interlace_count[5]  //
-    WUFFS_BASE__POTENTIALLY_UNUSED = {
-        0, 1, 2, 4, 8,
-};
+    v_x = 4;
+    if (a_final) {
+      v_x = 5;
+    }
+    v_x |= (((a_hlit - 257) & 31) << 3);
+    v_x |= (((a_hdist - 1) & 31) << 8);
+    v_x |= (((a_hclen - 4) & 15) << 13);
+    self->private_impl.f_bits |=
+        (((uint64_t)(v_x)) << (self->private_impl.f_n_bits & 63));
+    self->private_impl.f_n_bits += 17;
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+    status = wuffs_deflate__encoder__flush_bits(self, a_dst);
+    if (status.repr) {
+      goto suspend;
+    }
+    wuffs_deflate__encoder__assign_codes(self, 2, 19);
+    v_i = 0;
+    while (v_i < a_hclen) {
+      v_x = ((uint32_t)(
+          self->private_data.f_lens[2][wuffs_deflate__code_order[v_i]]));
+      self->private_impl.f_bits |=
+          (((uint64_t)(v_x)) << (self->private_impl.f_n_bits & 63));
+      self->private_impl.f_n_bits += 3;
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+      status = wuffs_deflate__encoder__flush_bits(self, a_dst);
+      if (status.repr) {
+        goto suspend;
+      }
+      v_i += 1;
+    }
+    v_i = 0;
+    while (v_i < self->private_impl.f_n_cl_tokens) {
+      v_tok = self->private_data.f_cl_tokens[v_i];
+      v_c = self->private_data.f_codes[2][(v_tok & 31)];
+      self->private_impl.f_bits |=
+          (((uint64_t)((v_c & 65535))) << (self->private_impl.f_n_bits & 63));
+      self->private_impl.f_n_bits += (v_c >> 16);
+      v_x = (v_tok & 31);
+      if (v_x == 16) {
+        self->private_impl.f_bits |= (((uint64_t)(((v_tok >> 8) & 3)))
+                                      << (self->private_impl.f_n_bits & 63));
+        self->private_impl.f_n_bits += 2;
+      } else if (v_x == 17) {
+        self->private_impl.f_bits |= (((uint64_t)(((v_tok >> 8) & 7)))
+                                      << (self->private_impl.f_n_bits & 63));
+        self->private_impl.f_n_bits += 3;
+      } else if (v_x == 18) {
+        self->private_impl.f_bits |= (((uint64_t)(((v_tok >> 8) & 127)))
+                                      << (self->private_impl.f_n_bits & 63));
+        self->private_impl.f_n_bits += 7;
+      }
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+      status = wuffs_deflate__encoder__flush_bits(self, a_dst);
+      if (status.repr) {
+        goto suspend;
+      }
+      v_i += 1;
+    }
 
-static const uint8_t              //
-    wuffs_gif__animexts1dot0[11]  //
-    WUFFS_BASE__POTENTIALLY_UNUSED = {
-        65, 78, 73, 77, 69, 88, 84, 83, 49, 46, 48,
-};
+    goto ok;
+  ok:
+    self->private_impl.p_write_dynamic_header[0] = 0;
+    goto exit;
+  }
 
-static const uint8_t              //
-    wuffs_gif__netscape2dot0[11]  //
-    WUFFS_BASE__POTENTIALLY_UNUSED = {
-        78, 69, 84, 83, 67, 65, 80, 69, 50, 46, 48,
-};
+  goto suspend;
+suspend:
+  self->private_impl.p_write_dynamic_header[0] =
+      wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_data.s_write_dynamic_header[0].v_i = v_i;
 
-static const uint8_t            //
-    wuffs_gif__iccrgbg1012[11]  //
-    WUFFS_BASE__POTENTIALLY_UNUSED = {
-        73, 67, 67, 82, 71, 66, 71, 49, 48, 49, 50,
-};
+  goto exit;
+exit:
+  return status;
+}
 
-static const uint8_t           //
-    wuffs_gif__xmpdataxmp[11]  //
-    WUFFS_BASE__POTENTIALLY_UNUSED = {
-        88, 77, 80, 32, 68, 97, 116, 97, 88, 77, 80,
-};
+// -------- func deflate.encoder.data_cost
 
-// ---------------- Private Initializer Prototypes
+static uint64_t  //
+wuffs_deflate__encoder__data_cost(const wuffs_deflate__encoder* self,
+                                  bool a_fixed) {
+  uint64_t v_ret = 0;
+  uint32_t v_i = 0;
+  uint64_t v_f = 0;
+  uint64_t v_n = 0;
+  uint64_t v_e = 0;
 
-// ---------------- Private Function Prototypes
+  v_i = 0;
+  while (v_i < 286) {
+    v_f = ((uint64_t)((self->private_data.f_freqs[0][v_i] & 65535)));
+    if (!a_fixed) {
+      v_n = ((uint64_t)((self->private_data.f_lens[0][v_i] & 15)));
+    } else if ((v_i >= 144) && (v_i < 256)) {
+      v_n = 9;
+    } else if ((v_i >= 256) && (v_i < 280)) {
+      v_n = 7;
+    } else {
+      v_n = 8;
+    }
+    v_e = 0;
+    if (v_i >= 257) {
+      v_e = ((uint64_t)(wuffs_deflate__lcode_n_extra_bits[(v_i - 257)]));
+    }
+    v_ret += (v_f * (v_n + v_e));
+    v_i += 1;
+  }
+  v_i = 0;
+  while (v_i < 30) {
+    v_f = ((uint64_t)((self->private_data.f_freqs[1][v_i] & 65535)));
+    v_n = 5;
+    if (!a_fixed) {
+      v_n = ((uint64_t)((self->private_data.f_lens[1][v_i] & 15)));
+    }
+    v_e = ((uint64_t)(wuffs_deflate__dcode_n_extra_bits[v_i]));
+    v_ret += (v_f * (v_n + v_e));
+    v_i += 1;
+  }
+  return v_ret;
+}
 
-static wuffs_base__status  //
-wuffs_gif__config_decoder__skip_frame(wuffs_gif__config_decoder* self,
-                                      wuffs_base__io_buffer* a_src);
+// -------- func deflate.encoder.cl_cost
+
+static uint64_t  //
+wuffs_deflate__encoder__cl_cost(const wuffs_deflate__encoder* self) {
+  uint64_t v_ret = 0;
+  uint32_t v_i = 0;
+
+  v_i = 0;
+  while (v_i < 19) {
+    v_ret += (((uint64_t)((self->private_data.f_freqs[2][v_i] & 65535))) *
+              ((uint64_t)(self->private_data.f_lens[2][v_i])));
+    v_i += 1;
+  }
+  v_ret += (((uint64_t)((self->private_data.f_freqs[2][16] & 65535))) * 2);
+  v_ret += (((uint64_t)((self->private_data.f_freqs[2][17] & 65535))) * 3);
+  v_ret += (((uint64_t)((self->private_data.f_freqs[2][18] & 65535))) * 7);
+  return v_ret;
+}
+
+// -------- func deflate.encoder.set_fixed_lens
 
 static wuffs_base__empty_struct  //
-wuffs_gif__config_decoder__reset_gc(wuffs_gif__config_decoder* self);
+wuffs_deflate__encoder__set_fixed_lens(wuffs_deflate__encoder* self) {
+  uint32_t v_i = 0;
 
-static wuffs_base__status  //
-wuffs_gif__config_decoder__decode_up_to_id_part1(
-    wuffs_gif__config_decoder* self,
-    wuffs_base__io_buffer* a_src);
+  v_i = 0;
+  while (v_i < 288) {
+    if (v_i < 144) {
+      self->private_data.f_lens[0][v_i] = 8;
+    } else if (v_i < 256) {
+      self->private_data.f_lens[0][v_i] = 9;
+    } else if (v_i < 280) {
+      self->private_data.f_lens[0][v_i] = 7;
+    } else {
+      self->private_data.f_lens[0][v_i] = 8;
+    }
+    v_i += 1;
+  }
+  v_i = 0;
+  while (v_i < 30) {
+    self->private_data.f_lens[1][v_i] = 5;
+    v_i += 1;
+  }
+  return wuffs_base__make_empty_struct();
+}
 
-static wuffs_base__status  //
-wuffs_gif__config_decoder__decode_header(wuffs_gif__config_decoder* self,
-                                         wuffs_base__io_buffer* a_src);
+// -------- func deflate.encoder.run_length_encode
 
-static wuffs_base__status  //
-wuffs_gif__config_decoder__decode_lsd(wuffs_gif__config_decoder* self,
-                                      wuffs_base__io_buffer* a_src);
+static wuffs_base__empty_struct  //
+wuffs_deflate__encoder__run_length_encode(wuffs_deflate__encoder* self,
+                                          uint32_t a_hlit,
+                                          uint32_t a_hdist) {
+  uint32_t v_total = 0;
+  uint32_t v_i = 0;
+  uint32_t v_j = 0;
+  uint32_t v_run = 0;
+  uint32_t v_r = 0;
+  uint32_t v_cur = 0;
+  uint32_t v_n = 0;
 
-static wuffs_base__status  //
-wuffs_gif__config_decoder__decode_extension(wuffs_gif__config_decoder* self,
-                                            wuffs_base__io_buffer* a_src);
+  v_i = 0;
+  while (v_i < 19) {
+    self->private_data.f_freqs[2][v_i] = 0;
+    v_i += 1;
+  }
+  v_total = (a_hlit + a_hdist);
+  v_i = 0;
+  v_n = 0;
+  while (v_i < v_total) {
+    v_cur = wuffs_deflate__encoder__cl_len(self, a_hlit, v_i);
+    v_j = (v_i + 1);
+    while (v_j < v_total) {
+      if (wuffs_deflate__encoder__cl_len(self, a_hlit, v_j) != v_cur) {
+        goto label__0__break;
+      }
+      if (v_j >= (v_i + 138)) {
+        goto label__0__break;
+      }
+      v_j += 1;
+    }
+  label__0__break:;
+    if ((v_j < v_i) || (v_n >= 320)) {
+      goto label__1__break;
+    }
+    v_run = (v_j - v_i);
+    if ((v_cur == 0) && (v_run >= 11)) {
+      self->private_data.f_cl_tokens[v_n] = (18 | ((v_run - 11) << 8));
+      self->private_data.f_freqs[2][18] += 1;
+      v_n += 1;
+    } else if ((v_cur == 0) && (v_run >= 3)) {
+      self->private_data.f_cl_tokens[v_n] = (17 | ((v_run - 3) << 8));
+      self->private_data.f_freqs[2][17] += 1;
+      v_n += 1;
+    } else {
+      self->private_data.f_cl_tokens[v_n] = v_cur;
+      self->private_data.f_freqs[2][v_cur] += 1;
+      v_n += 1;
+      wuffs_base__u32__sat_sub_indirect(&v_run, 1);
+      if (v_cur != 0) {
+        while ((v_run >= 3) && (v_n < 320)) {
+          v_r = wuffs_base__u32__min(v_run, 6);
+          self->private_data.f_cl_tokens[v_n] = (16 | ((v_r - 3) << 8));
+          self->private_data.f_freqs[2][16] += 1;
+          v_n += 1;
+          wuffs_base__u32__sat_sub_indirect(&v_run, v_r);
+        }
+      }
+      wuffs_base__u32__sat_sub_indirect(&v_j, v_run);
+    }
+    v_i = v_j;
+  }
+label__1__break:;
+  self->private_impl.f_n_cl_tokens = v_n;
+  return wuffs_base__make_empty_struct();
+}
 
-static wuffs_base__status  //
-wuffs_gif__config_decoder__skip_blocks(wuffs_gif__config_decoder* self,
-                                       wuffs_base__io_buffer* a_src);
+// -------- func deflate.encoder.cl_len
 
-static wuffs_base__status  //
-wuffs_gif__config_decoder__decode_ae(wuffs_gif__config_decoder* self,
-                                     wuffs_base__io_buffer* a_src);
+static uint32_t  //
+wuffs_deflate__encoder__cl_len(const wuffs_deflate__encoder* self,
+                               uint32_t a_hlit,
+                               uint32_t a_k) {
+  if (a_k < a_hlit) {
+    return ((uint32_t)((self->private_data.f_lens[0][a_k] & 15)));
+  } else if ((a_k - a_hlit) < 30) {
+    return ((uint32_t)((self->private_data.f_lens[1][(a_k - a_hlit)] & 15)));
+  }
+  return 0;
+}
 
-static wuffs_base__status  //
-wuffs_gif__config_decoder__decode_gc(wuffs_gif__config_decoder* self,
-                                     wuffs_base__io_buffer* a_src);
+// -------- func deflate.encoder.build_huffman
 
-static wuffs_base__status  //
-wuffs_gif__config_decoder__decode_id_part0(wuffs_gif__config_decoder* self,
-                                           wuffs_base__io_buffer* a_src);
+static wuffs_base__empty_struct  //
+wuffs_deflate__encoder__build_huffman(wuffs_deflate__encoder* self,
+                                      uint32_t a_which,
+                                      uint32_t a_n_codes,
+                                      uint32_t a_max_len) {
+  uint32_t v_i = 0;
+  uint32_t v_j = 0;
+  uint32_t v_m = 0;
+  uint32_t v_m2 = 0;
+  uint32_t v_key = 0;
+  uint32_t v_f = 0;
+  uint32_t v_root = 0;
+  uint32_t v_leaf = 0;
+  uint32_t v_next = 0;
+  uint32_t v_avbl = 0;
+  uint32_t v_used = 0;
+  uint32_t v_dpth = 0;
+  uint32_t v_counts[16] = {0};
+  uint32_t v_total = 0;
+  uint32_t v_l = 0;
+  uint32_t v_k = 0;
+
+  v_m = 0;
+  v_i = 0;
+  while (v_i < a_n_codes) {
+    self->private_data.f_lens[a_which][v_i] = 0;
+    v_f = (self->private_data.f_freqs[a_which][v_i] & 65535);
+    if ((v_f > 0) && (v_m < 288)) {
+      self->private_data.f_sorted[(v_m & 511)] = ((v_f << 9) | v_i);
+      v_m += 1;
+    }
+    v_i += 1;
+  }
+  if (v_m < 2) {
+    if ((v_m == 0) || ((self->private_data.f_sorted[0] & 511) != 0)) {
+      self->private_data.f_sorted[(v_m & 511)] = 512;
+    } else {
+      self->private_data.f_sorted[(v_m & 511)] = 513;
+    }
+    v_m += 1;
+    if (v_m < 2) {
+      self->private_data.f_sorted[(v_m & 511)] = 513;
+      v_m += 1;
+    }
+  }
+  if (v_m < 2) {
+    return wuffs_base__make_empty_struct();
+  }
+  v_m2 = (v_m - 2);
+  v_i = 1;
+  while (v_i < v_m) {
+    v_key = self->private_data.f_sorted[(v_i & 511)];
+    v_j = v_i;
+    v_i += 1;
+    while (v_j > 0) {
+      if (self->private_data.f_sorted[((v_j - 1) & 511)] <= v_key) {
+        goto label__0__break;
+      }
+      self->private_data.f_sorted[(v_j & 511)] =
+          self->private_data.f_sorted[((v_j - 1) & 511)];
+      v_j -= 1;
+    }
+  label__0__break:;
+    self->private_data.f_sorted[(v_j & 511)] = v_key;
+  }
+  v_i = 0;
+  while (v_i < v_m) {
+    self->private_data.f_depths[(v_i & 511)] =
+        (self->private_data.f_sorted[(v_i & 511)] >> 9);
+    v_i += 1;
+  }
+  self->private_data.f_depths[0] += self->private_data.f_depths[1];
+  v_root = 0;
+  v_leaf = 2;
+  v_next = 1;
+  while (v_next <= v_m2) {
+    if ((v_leaf >= v_m) || (self->private_data.f_depths[(v_root & 511)] <
+                            self->private_data.f_depths[(v_leaf & 511)])) {
+      self->private_data.f_depths[(v_next & 511)] =
+          self->private_data.f_depths[(v_root & 511)];
+      self->private_data.f_depths[(v_root & 511)] = v_next;
+      v_root += 1;
+    } else {
+      self->private_data.f_depths[(v_next & 511)] =
+          self->private_data.f_depths[(v_leaf & 511)];
+      v_leaf += 1;
+    }
+    if ((v_leaf >= v_m) ||
+        ((v_root < v_next) && (self->private_data.f_depths[(v_root & 511)] <
+                               self->private_data.f_depths[(v_leaf & 511)]))) {
+      self->private_data.f_depths[(v_next & 511)] +=
+          self->private_data.f_depths[(v_root & 511)];
+      self->private_data.f_depths[(v_root & 511)] = v_next;
+      v_root += 1;
+    } else {
+      self->private_data.f_depths[(v_next & 511)] +=
+          self->private_data.f_depths[(v_leaf & 511)];
+      v_leaf += 1;
+    }
+    v_next += 1;
+  }
+  self->private_data.f_depths[(v_m2 & 511)] = 0;
+  v_next = v_m2;
+  while (v_next > 0) {
+    v_next -= 1;
+    self->private_data.f_depths[(v_next & 511)] =
+        (self->private_data
+             .f_depths[(self->private_data.f_depths[(v_next & 511)] & 511)] +
+         1);
+  }
+  v_avbl = 1;
+  v_used = 0;
+  v_dpth = 0;
+  v_root = (v_m2 + 1);
+  v_next = v_m;
+  while (v_avbl > 0) {
+    while ((v_root > 0) &&
+           (self->private_data.f_depths[((v_root - 1) & 511)] == v_dpth)) {
+      v_used += 1;
+      v_root -= 1;
+    }
+    while ((v_avbl > v_used) && (v_next > 0)) {
+      v_next -= 1;
+      self->private_data.f_depths[(v_next & 511)] = v_dpth;
+      v_avbl -= 1;
+    }
+    v_avbl = (v_used * 2);
+    v_dpth += 1;
+    v_used = 0;
+  }
+  v_i = 0;
+  while (v_i < v_m) {
+    v_counts[wuffs_base__u32__min(self->private_data.f_depths[(v_i & 511)],
+                                  a_max_len)] += 1;
+    v_i += 1;
+  }
+  v_total = 0;
+  v_l = 1;
+  while (a_max_len >= v_l) {
+    v_total += (v_counts[(v_l & 15)] << (a_max_len - v_l));
+    v_l += 1;
+  }
+  while (v_total > (((uint32_t)(1)) << a_max_len)) {
+    v_counts[a_max_len] -= 1;
+    v_l = a_max_len;
+    while (v_l > 1) {
+      v_l -= 1;
+      if (v_counts[(v_l & 15)] > 0) {
+        v_counts[(v_l & 15)] -= 1;
+        v_counts[((v_l + 1) & 15)] += 2;
+        goto label__1__break;
+      }
+    }
+  label__1__break:;
+    v_total -= 1;
+  }
+  v_k = v_m;
+  v_i = 1;
+  while (v_i <= a_max_len) {
+    v_j = v_counts[(v_i & 15)];
+    v_l = (v_i & 15);
+    v_i += 1;
+    while ((v_j > 0) && (v_k > 0)) {
+      v_k -= 1;
+      v_key = (self->private_data.f_sorted[(v_k & 511)] & 511);
+      self->private_data.f_lens[a_which][wuffs_base__u32__min(v_key, 287)] =
+          ((uint8_t)(v_l));
+      v_j -= 1;
+    }
+  }
+  return wuffs_base__make_empty_struct();
+}
 
-static wuffs_base__status  //
-wuffs_gif__decoder__skip_frame(wuffs_gif__decoder* self,
-                               wuffs_base__io_buffer* a_src);
+// -------- func deflate.encoder.assign_codes
 
 static wuffs_base__empty_struct  //
-wuffs_gif__decoder__reset_gc(wuffs_gif__decoder* self);
+wuffs_deflate__encoder__assign_codes(wuffs_deflate__encoder* self,
+                                     uint32_t a_which,
+                                     uint32_t a_n_codes) {
+  uint32_t v_counts[16] = {0};
+  uint32_t v_next_codes[16] = {0};
+  uint32_t v_i = 0;
+  uint32_t v_code = 0;
+  uint32_t v_len = 0;
 
-static wuffs_base__status  //
-wuffs_gif__decoder__decode_up_to_id_part1(wuffs_gif__decoder* self,
-                                          wuffs_base__io_buffer* a_src);
+  v_i = 0;
+  while (v_i < a_n_codes) {
+    v_len = ((uint32_t)((self->private_data.f_lens[a_which][v_i] & 15)));
+    self->private_data.f_codes[a_which][v_i] = v_len;
+    v_counts[v_len] += 1;
+    v_i += 1;
+  }
+  v_counts[0] = 0;
+  v_code = 0;
+  v_i = 0;
+  while (v_i < 15) {
+    v_code = ((v_code + v_counts[v_i]) << 1);
+    v_next_codes[(v_i + 1)] = v_code;
+    v_i += 1;
+  }
+  v_i = 0;
+  while (v_i < a_n_codes) {
+    v_len = (self->private_data.f_codes[a_which][v_i] & 15);
+    if (v_len == 0) {
+      self->private_data.f_codes[a_which][v_i] = 0;
+    } else {
+      v_code = v_next_codes[v_len];
+      v_next_codes[v_len] = (v_code + 1);
+      v_code =
+          ((((((uint32_t)(wuffs_deflate__reverse8[(v_code & 255)])) << 8) |
+             ((uint32_t)(wuffs_deflate__reverse8[((v_code >> 8) & 255)]))) >>
+            (16 - v_len)) &
+           65535);
+      self->private_data.f_codes[a_which][v_i] = (v_code | (v_len << 16));
+    }
+    v_i += 1;
+  }
+  return wuffs_base__make_empty_struct();
+}
 
-static wuffs_base__status  //
-wuffs_gif__decoder__decode_header(wuffs_gif__decoder* self,
-                                  wuffs_base__io_buffer* a_src);
+#endif  // !defined(WUFFS_CONFIG__MODULES) ||
+        // defined(WUFFS_CONFIG__MODULE__DEFLATE)
 
-static wuffs_base__status  //
-wuffs_gif__decoder__decode_lsd(wuffs_gif__decoder* self,
-                               wuffs_base__io_buffer* a_src);
+#if !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__LZW)
 
-static wuffs_base__status  //
-wuffs_gif__decoder__decode_extension(wuffs_gif__decoder* self,
-                                     wuffs_base__io_buffer* a_src);
+// ---------------- Status Codes Implementations
 
-static wuffs_base__status  //
-wuffs_gif__decoder__skip_blocks(wuffs_gif__decoder* self,
-                                wuffs_base__io_buffer* a_src);
+const char* wuffs_lzw__error__bad_code = "#lzw: bad code";
+const char* wuffs_lzw__error__internal_error_inconsistent_i_o =
+    "#lzw: internal error: inconsistent I/O";
+const char* wuffs_lzw__error__bad_input_byte = "#lzw: bad input byte";
 
-static wuffs_base__status  //
-wuffs_gif__decoder__decode_ae(wuffs_gif__decoder* self,
-                              wuffs_base__io_buffer* a_src);
+// ---------------- Private Consts
 
-static wuffs_base__status  //
-wuffs_gif__decoder__decode_gc(wuffs_gif__decoder* self,
+#define WUFFS_LZW__ENCODER_HASH_TABLE_MASK 8191
+
+// ---------------- Private Initializer Prototypes
+
+// ---------------- Private Function Prototypes
+
+static wuffs_base__empty_struct  //
+wuffs_lzw__decoder__read_from(wuffs_lzw__decoder* self,
                               wuffs_base__io_buffer* a_src);
 
 static wuffs_base__status  //
-wuffs_gif__decoder__decode_id_part0(wuffs_gif__decoder* self,
-                                    wuffs_base__io_buffer* a_src);
+wuffs_lzw__decoder__write_to(wuffs_lzw__decoder* self,
+                             wuffs_base__io_buffer* a_dst);
+
+static wuffs_base__empty_struct  //
+wuffs_lzw__encoder__clear_hash_table(wuffs_lzw__encoder* self);
 
 static wuffs_base__status  //
-wuffs_gif__decoder__decode_id_part1(wuffs_gif__decoder* self,
-                                    wuffs_base__pixel_buffer* a_dst,
-                                    wuffs_base__io_buffer* a_src,
-                                    wuffs_base__pixel_blend a_blend);
+wuffs_lzw__encoder__encode_codes(wuffs_lzw__encoder* self,
+                                 wuffs_base__io_buffer* a_dst,
+                                 wuffs_base__io_buffer* a_src);
 
 static wuffs_base__status  //
-wuffs_gif__decoder__decode_id_part2(wuffs_gif__decoder* self,
-                                    wuffs_base__pixel_buffer* a_dst,
-                                    wuffs_base__io_buffer* a_src,
-                                    wuffs_base__slice_u8 a_workbuf);
-
-static wuffs_base__status  //
-wuffs_gif__decoder__copy_to_image_buffer(wuffs_gif__decoder* self,
-                                         wuffs_base__pixel_buffer* a_pb,
-                                         wuffs_base__slice_u8 a_src);
+wuffs_lzw__encoder__flush_bits(wuffs_lzw__encoder* self,
+                               wuffs_base__io_buffer* a_dst);
 
 // ---------------- VTables
 
-const wuffs_base__image_decoder__func_ptrs
-    wuffs_gif__config_decoder__func_ptrs_for__wuffs_base__image_decoder = {
-        (wuffs_base__status(*)(void*, wuffs_base__io_buffer*))(
-            &wuffs_gif__config_decoder__ack_metadata_chunk),
+const wuffs_base__io_transformer__func_ptrs
+    wuffs_lzw__decoder__func_ptrs_for__wuffs_base__io_transformer = {
         (wuffs_base__status(*)(void*,
-                               wuffs_base__pixel_buffer*,
                                wuffs_base__io_buffer*,
-                               wuffs_base__pixel_blend,
-                               wuffs_base__slice_u8,
-                               wuffs_base__decode_frame_options*))(
-            &wuffs_gif__config_decoder__decode_frame),
-        (wuffs_base__status(*)(void*,
-                               wuffs_base__frame_config*,
-                               wuffs_base__io_buffer*))(
-            &wuffs_gif__config_decoder__decode_frame_config),
-        (wuffs_base__status(*)(void*,
-                               wuffs_base__image_config*,
-                               wuffs_base__io_buffer*))(
-            &wuffs_gif__config_decoder__decode_image_config),
-        (wuffs_base__rect_ie_u32(*)(const void*))(
-            &wuffs_gif__config_decoder__frame_dirty_rect),
-        (uint64_t(*)(const void*))(
-            &wuffs_gif__config_decoder__metadata_chunk_length),
-        (uint32_t(*)(const void*))(&wuffs_gif__config_decoder__metadata_fourcc),
-        (uint32_t(*)(const void*))(
-            &wuffs_gif__config_decoder__num_animation_loops),
-        (uint64_t(*)(const void*))(
-            &wuffs_gif__config_decoder__num_decoded_frame_configs),
-        (uint64_t(*)(const void*))(
-            &wuffs_gif__config_decoder__num_decoded_frames),
-        (wuffs_base__status(*)(void*, uint64_t, uint64_t))(
-            &wuffs_gif__config_decoder__restart_frame),
-        (wuffs_base__empty_struct(*)(void*, uint32_t, bool))(
-            &wuffs_gif__config_decoder__set_report_metadata),
+                               wuffs_base__io_buffer*,
+                               wuffs_base__slice_u8))(
+            &wuffs_lzw__decoder__transform_io),
         (wuffs_base__range_ii_u64(*)(const void*))(
-            &wuffs_gif__config_decoder__workbuf_len),
+            &wuffs_lzw__decoder__workbuf_len),
 };
 
-const wuffs_base__image_decoder__func_ptrs
-    wuffs_gif__decoder__func_ptrs_for__wuffs_base__image_decoder = {
-        (wuffs_base__status(*)(void*, wuffs_base__io_buffer*))(
-            &wuffs_gif__decoder__ack_metadata_chunk),
+const wuffs_base__io_transformer__func_ptrs
+    wuffs_lzw__encoder__func_ptrs_for__wuffs_base__io_transformer = {
         (wuffs_base__status(*)(void*,
-                               wuffs_base__pixel_buffer*,
                                wuffs_base__io_buffer*,
-                               wuffs_base__pixel_blend,
-                               wuffs_base__slice_u8,
-                               wuffs_base__decode_frame_options*))(
-            &wuffs_gif__decoder__decode_frame),
-        (wuffs_base__status(*)(void*,
-                               wuffs_base__frame_config*,
-                               wuffs_base__io_buffer*))(
-            &wuffs_gif__decoder__decode_frame_config),
-        (wuffs_base__status(*)(void*,
-                               wuffs_base__image_config*,
-                               wuffs_base__io_buffer*))(
-            &wuffs_gif__decoder__decode_image_config),
-        (wuffs_base__rect_ie_u32(*)(const void*))(
-            &wuffs_gif__decoder__frame_dirty_rect),
-        (uint64_t(*)(const void*))(&wuffs_gif__decoder__metadata_chunk_length),
-        (uint32_t(*)(const void*))(&wuffs_gif__decoder__metadata_fourcc),
-        (uint32_t(*)(const void*))(&wuffs_gif__decoder__num_animation_loops),
-        (uint64_t(*)(const void*))(
-            &wuffs_gif__decoder__num_decoded_frame_configs),
-        (uint64_t(*)(const void*))(&wuffs_gif__decoder__num_decoded_frames),
-        (wuffs_base__status(*)(void*, uint64_t, uint64_t))(
-            &wuffs_gif__decoder__restart_frame),
-        (wuffs_base__empty_struct(*)(void*, uint32_t, bool))(
-            &wuffs_gif__decoder__set_report_metadata),
+                               wuffs_base__io_buffer*,
+                               wuffs_base__slice_u8))(
+            &wuffs_lzw__encoder__transform_io),
         (wuffs_base__range_ii_u64(*)(const void*))(
-            &wuffs_gif__decoder__workbuf_len),
+            &wuffs_lzw__encoder__workbuf_len),
 };
 
 // ---------------- Initializer Implementations
 
 wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT  //
-wuffs_gif__config_decoder__initialize(wuffs_gif__config_decoder* self,
-                                      size_t sizeof_star_self,
-                                      uint64_t wuffs_version,
-                                      uint32_t initialize_flags) {
+wuffs_lzw__decoder__initialize(wuffs_lzw__decoder* self,
+                               size_t sizeof_star_self,
+                               uint64_t wuffs_version,
+                               uint32_t initialize_flags) {
   if (!self) {
     return wuffs_base__make_status(wuffs_base__error__bad_receiver);
   }
@@ -15309,20 +19780,20 @@ wuffs_gif__config_decoder__initialize(wuffs_gif__config_decoder* self,
   }
 
   self->private_impl.magic = WUFFS_BASE__MAGIC;
-  self->private_impl.vtable_for__wuffs_base__image_decoder.vtable_name =
-      wuffs_base__image_decoder__vtable_name;
-  self->private_impl.vtable_for__wuffs_base__image_decoder.function_pointers =
-      (const void*)(&wuffs_gif__config_decoder__func_ptrs_for__wuffs_base__image_decoder);
+  self->private_impl.vtable_for__wuffs_base__io_transformer.vtable_name =
+      wuffs_base__io_transformer__vtable_name;
+  self->private_impl.vtable_for__wuffs_base__io_transformer.function_pointers =
+      (const void*)(&wuffs_lzw__decoder__func_ptrs_for__wuffs_base__io_transformer);
   return wuffs_base__make_status(NULL);
 }
 
 size_t  //
-sizeof__wuffs_gif__config_decoder() {
-  return sizeof(wuffs_gif__config_decoder);
+sizeof__wuffs_lzw__decoder() {
+  return sizeof(wuffs_lzw__decoder);
 }
 
 wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT  //
-wuffs_gif__decoder__initialize(wuffs_gif__decoder* self,
+wuffs_lzw__encoder__initialize(wuffs_lzw__encoder* self,
                                size_t sizeof_star_self,
                                uint64_t wuffs_version,
                                uint32_t initialize_flags) {
@@ -15361,70 +19832,62 @@ wuffs_gif__decoder__initialize(wuffs_gif__decoder* self,
     }
   }
 
-  {
-    wuffs_base__status z = wuffs_lzw__decoder__initialize(
-        &self->private_data.f_lzw, sizeof(self->private_data.f_lzw),
-        WUFFS_VERSION, initialize_flags);
-    if (z.repr) {
-      return z;
-    }
-  }
   self->private_impl.magic = WUFFS_BASE__MAGIC;
-  self->private_impl.vtable_for__wuffs_base__image_decoder.vtable_name =
-      wuffs_base__image_decoder__vtable_name;
-  self->private_impl.vtable_for__wuffs_base__image_decoder.function_pointers =
-      (const void*)(&wuffs_gif__decoder__func_ptrs_for__wuffs_base__image_decoder);
+  self->private_impl.vtable_for__wuffs_base__io_transformer.vtable_name =
+      wuffs_base__io_transformer__vtable_name;
+  self->private_impl.vtable_for__wuffs_base__io_transformer.function_pointers =
+      (const void*)(&wuffs_lzw__encoder__func_ptrs_for__wuffs_base__io_transformer);
   return wuffs_base__make_status(NULL);
 }
 
 size_t  //
-sizeof__wuffs_gif__decoder() {
-  return sizeof(wuffs_gif__decoder);
+sizeof__wuffs_lzw__encoder() {
+  return sizeof(wuffs_lzw__encoder);
 }
 
 // ---------------- Function Implementations
 
-// -------- func gif.config_decoder.set_quirk_enabled
+// -------- func lzw.decoder.set_literal_width
 
 WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
-wuffs_gif__config_decoder__set_quirk_enabled(wuffs_gif__config_decoder* self,
-                                             uint32_t a_quirk,
-                                             bool a_enabled) {
+wuffs_lzw__decoder__set_literal_width(wuffs_lzw__decoder* self, uint32_t a_lw) {
   if (!self) {
     return wuffs_base__make_empty_struct();
   }
   if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
     return wuffs_base__make_empty_struct();
   }
-
-  if (self->private_impl.f_call_sequence == 0) {
-    if (a_quirk == 1041635328) {
-      self->private_impl.f_quirk_enabled_delay_num_decoded_frames = a_enabled;
-    } else if (a_quirk == 1041635329) {
-      self->private_impl
-          .f_quirk_enabled_first_frame_local_palette_means_black_background =
-          a_enabled;
-    } else if (a_quirk == 1041635330) {
-      self->private_impl.f_quirk_enabled_honor_background_color = a_enabled;
-    } else if (a_quirk == 1041635331) {
-      self->private_impl.f_quirk_enabled_ignore_too_much_pixel_data = a_enabled;
-    } else if (a_quirk == 1041635332) {
-      self->private_impl.f_quirk_enabled_image_bounds_are_strict = a_enabled;
-    } else if (a_quirk == 1041635333) {
-      self->private_impl.f_quirk_enabled_reject_empty_frame = a_enabled;
-    } else if (a_quirk == 1041635334) {
-      self->private_impl.f_quirk_enabled_reject_empty_palette = a_enabled;
-    }
+  if (a_lw > 8) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_empty_struct();
   }
+
+  self->private_impl.f_set_literal_width_arg = (a_lw + 1);
   return wuffs_base__make_empty_struct();
 }
 
-// -------- func gif.config_decoder.decode_image_config
+// -------- func lzw.decoder.workbuf_len
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__range_ii_u64  //
+wuffs_lzw__decoder__workbuf_len(const wuffs_lzw__decoder* self) {
+  if (!self) {
+    return wuffs_base__utility__empty_range_ii_u64();
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return wuffs_base__utility__empty_range_ii_u64();
+  }
+
+  return wuffs_base__utility__make_range_ii_u64(0, 0);
+}
+
+// -------- func lzw.decoder.transform_io
 
 WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
-wuffs_gif__config_decoder__decode_image_config(wuffs_gif__config_decoder* self,
-                                               wuffs_base__image_config* a_dst,
-                                               wuffs_base__io_buffer* a_src) {
+wuffs_lzw__decoder__transform_io(wuffs_lzw__decoder* self,
+                                 wuffs_base__io_buffer* a_dst,
+                                 wuffs_base__io_buffer* a_src,
+                                 wuffs_base__slice_u8 a_workbuf) {
   if (!self) {
     return wuffs_base__make_status(wuffs_base__error__bad_receiver);
   }
@@ -15434,7 +19897,7 @@ wuffs_gif__config_decoder__decode_image_config(wuffs_gif__config_decoder* self,
             ? wuffs_base__error__disabled_by_previous_error
             : wuffs_base__error__initialize_not_called);
   }
-  if (!a_src) {
+  if (!a_dst || !a_src) {
     self->private_impl.magic = WUFFS_BASE__DISABLED;
     return wuffs_base__make_status(wuffs_base__error__bad_argument);
   }
@@ -15447,63 +19910,70 @@ wuffs_gif__config_decoder__decode_image_config(wuffs_gif__config_decoder* self,
   self->private_impl.active_coroutine = 0;
   wuffs_base__status status = wuffs_base__make_status(NULL);
 
-  bool v_ffio = false;
+  uint32_t v_i = 0;
 
-  uint32_t coro_susp_point = self->private_impl.p_decode_image_config[0];
+  uint32_t coro_susp_point = self->private_impl.p_transform_io[0];
   switch (coro_susp_point) {
     WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
 
-    if (self->private_impl.f_call_sequence == 0) {
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
-      status = wuffs_gif__config_decoder__decode_header(self, a_src);
-      if (status.repr) {
-        goto suspend;
-      }
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
-      status = wuffs_gif__config_decoder__decode_lsd(self, a_src);
-      if (status.repr) {
-        goto suspend;
-      }
-    } else if (self->private_impl.f_call_sequence != 2) {
-      status = wuffs_base__make_status(wuffs_base__error__bad_call_sequence);
-      goto exit;
-    }
-    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
-    status = wuffs_gif__config_decoder__decode_up_to_id_part1(self, a_src);
-    if (status.repr) {
-      goto suspend;
+    self->private_impl.f_literal_width = 8;
+    if (self->private_impl.f_set_literal_width_arg > 0) {
+      self->private_impl.f_literal_width =
+          (self->private_impl.f_set_literal_width_arg - 1);
     }
-    v_ffio = !self->private_impl.f_gc_has_transparent_index;
-    if (!self->private_impl.f_quirk_enabled_honor_background_color) {
-      v_ffio =
-          (v_ffio && (self->private_impl.f_frame_rect_x0 == 0) &&
-           (self->private_impl.f_frame_rect_y0 == 0) &&
-           (self->private_impl.f_frame_rect_x1 == self->private_impl.f_width) &&
-           (self->private_impl.f_frame_rect_y1 == self->private_impl.f_height));
-    } else if (v_ffio) {
-      self->private_impl.f_black_color_u32_argb_premul = 4278190080;
+    self->private_impl.f_clear_code =
+        (((uint32_t)(1)) << self->private_impl.f_literal_width);
+    self->private_impl.f_end_code = (self->private_impl.f_clear_code + 1);
+    self->private_impl.f_save_code = self->private_impl.f_end_code;
+    self->private_impl.f_prev_code = self->private_impl.f_end_code;
+    self->private_impl.f_width = (self->private_impl.f_literal_width + 1);
+    self->private_impl.f_bits = 0;
+    self->private_impl.f_n_bits = 0;
+    self->private_impl.f_output_ri = 0;
+    self->private_impl.f_output_wi = 0;
+    v_i = 0;
+    while (v_i < self->private_impl.f_clear_code) {
+      self->private_data.f_lm1s[v_i] = 0;
+      self->private_data.f_suffixes[v_i][0] = ((uint8_t)(v_i));
+      v_i += 1;
     }
-    if (self->private_impl.f_background_color_u32_argb_premul == 77) {
-      self->private_impl.f_background_color_u32_argb_premul =
-          self->private_impl.f_black_color_u32_argb_premul;
+  label__0__continue:;
+    while (true) {
+      wuffs_lzw__decoder__read_from(self, a_src);
+      if (self->private_impl.f_output_wi > 0) {
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+        status = wuffs_lzw__decoder__write_to(self, a_dst);
+        if (status.repr) {
+          goto suspend;
+        }
+      }
+      if (self->private_impl.f_read_from_return_value == 0) {
+        goto label__0__break;
+      } else if (self->private_impl.f_read_from_return_value == 1) {
+        goto label__0__continue;
+      } else if (self->private_impl.f_read_from_return_value == 2) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(2);
+      } else if (self->private_impl.f_read_from_return_value == 3) {
+        status = wuffs_base__make_status(wuffs_lzw__error__bad_code);
+        goto exit;
+      } else {
+        status = wuffs_base__make_status(
+            wuffs_lzw__error__internal_error_inconsistent_i_o);
+        goto exit;
+      }
     }
-    if (a_dst != NULL) {
-      wuffs_base__image_config__set(
-          a_dst, 1191444488, 0, self->private_impl.f_width,
-          self->private_impl.f_height,
-          self->private_impl.f_frame_config_io_position, v_ffio);
-    }
-    self->private_impl.f_call_sequence = 3;
+  label__0__break:;
 
     goto ok;
   ok:
-    self->private_impl.p_decode_image_config[0] = 0;
+    self->private_impl.p_transform_io[0] = 0;
     goto exit;
   }
 
   goto suspend;
 suspend:
-  self->private_impl.p_decode_image_config[0] =
+  self->private_impl.p_transform_io[0] =
       wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
   self->private_impl.active_coroutine =
       wuffs_base__status__is_suspension(&status) ? 1 : 0;
@@ -15516,53 +19986,26 @@ exit:
   return status;
 }
 
-// -------- func gif.config_decoder.set_report_metadata
-
-WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
-wuffs_gif__config_decoder__set_report_metadata(wuffs_gif__config_decoder* self,
-                                               uint32_t a_fourcc,
-                                               bool a_report) {
-  if (!self) {
-    return wuffs_base__make_empty_struct();
-  }
-  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
-    return wuffs_base__make_empty_struct();
-  }
-
-  if (a_fourcc == 1229144912) {
-    self->private_impl.f_report_metadata_iccp = a_report;
-  } else if (a_fourcc == 1481461792) {
-    self->private_impl.f_report_metadata_xmp = a_report;
-  }
-  return wuffs_base__make_empty_struct();
-}
-
-// -------- func gif.config_decoder.ack_metadata_chunk
+// -------- func lzw.decoder.read_from
 
-WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
-wuffs_gif__config_decoder__ack_metadata_chunk(wuffs_gif__config_decoder* self,
-                                              wuffs_base__io_buffer* a_src) {
-  if (!self) {
-    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
-  }
-  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
-    return wuffs_base__make_status(
-        (self->private_impl.magic == WUFFS_BASE__DISABLED)
-            ? wuffs_base__error__disabled_by_previous_error
-            : wuffs_base__error__initialize_not_called);
-  }
-  if (!a_src) {
-    self->private_impl.magic = WUFFS_BASE__DISABLED;
-    return wuffs_base__make_status(wuffs_base__error__bad_argument);
-  }
-  if ((self->private_impl.active_coroutine != 0) &&
-      (self->private_impl.active_coroutine != 2)) {
-    self->private_impl.magic = WUFFS_BASE__DISABLED;
-    return wuffs_base__make_status(
-        wuffs_base__error__interleaved_coroutine_calls);
-  }
-  self->private_impl.active_coroutine = 0;
-  wuffs_base__status status = wuffs_base__make_status(NULL);
+static wuffs_base__empty_struct  //
+wuffs_lzw__decoder__read_from(wuffs_lzw__decoder* self,
+                              wuffs_base__io_buffer* a_src) {
+  uint32_t v_clear_code = 0;
+  uint32_t v_end_code = 0;
+  uint32_t v_save_code = 0;
+  uint32_t v_prev_code = 0;
+  uint32_t v_width = 0;
+  uint32_t v_bits = 0;
+  uint32_t v_n_bits = 0;
+  uint32_t v_output_wi = 0;
+  uint32_t v_code = 0;
+  uint32_t v_c = 0;
+  uint32_t v_o = 0;
+  uint32_t v_steps = 0;
+  uint8_t v_first_byte = 0;
+  uint16_t v_lm1_b = 0;
+  uint16_t v_lm1_a = 0;
 
   uint8_t* iop_a_src = NULL;
   uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
@@ -15575,175 +20018,301 @@ wuffs_gif__config_decoder__ack_metadata_chunk(wuffs_gif__config_decoder* self,
     io2_a_src = io0_a_src + a_src->meta.wi;
   }
 
-  uint32_t coro_susp_point = self->private_impl.p_ack_metadata_chunk[0];
-  switch (coro_susp_point) {
-    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
-
-    if (self->private_impl.f_call_sequence != 1) {
-      status = wuffs_base__make_status(wuffs_base__error__bad_call_sequence);
-      goto exit;
-    }
-    if (wuffs_base__u64__sat_add(a_src->meta.pos,
-                                 ((uint64_t)(iop_a_src - io0_a_src))) !=
-        self->private_impl.f_metadata_io_position) {
-      status = wuffs_base__make_status(wuffs_base__error__bad_i_o_position);
-      goto exit;
+  v_clear_code = self->private_impl.f_clear_code;
+  v_end_code = self->private_impl.f_end_code;
+  v_save_code = self->private_impl.f_save_code;
+  v_prev_code = self->private_impl.f_prev_code;
+  v_width = self->private_impl.f_width;
+  v_bits = self->private_impl.f_bits;
+  v_n_bits = self->private_impl.f_n_bits;
+  v_output_wi = self->private_impl.f_output_wi;
+  while (true) {
+    if (v_n_bits < v_width) {
+      if (((uint64_t)(io2_a_src - iop_a_src)) >= 4) {
+        v_bits |=
+            (wuffs_base__load_u32le__no_bounds_check(iop_a_src) << v_n_bits);
+        (iop_a_src += ((31 - v_n_bits) >> 3), wuffs_base__make_empty_struct());
+        v_n_bits |= 24;
+      } else if (((uint64_t)(io2_a_src - iop_a_src)) <= 0) {
+        self->private_impl.f_read_from_return_value = 2;
+        goto label__0__break;
+      } else {
+        v_bits |=
+            (((uint32_t)(wuffs_base__load_u8be__no_bounds_check(iop_a_src)))
+             << v_n_bits);
+        (iop_a_src += 1, wuffs_base__make_empty_struct());
+        v_n_bits += 8;
+        if (v_n_bits >= v_width) {
+        } else if (((uint64_t)(io2_a_src - iop_a_src)) <= 0) {
+          self->private_impl.f_read_from_return_value = 2;
+          goto label__0__break;
+        } else {
+          v_bits |=
+              (((uint32_t)(wuffs_base__load_u8be__no_bounds_check(iop_a_src)))
+               << v_n_bits);
+          (iop_a_src += 1, wuffs_base__make_empty_struct());
+          v_n_bits += 8;
+          if (v_n_bits < v_width) {
+            self->private_impl.f_read_from_return_value = 4;
+            goto label__0__break;
+          }
+        }
+      }
     }
-    if (self->private_impl.f_metadata_chunk_length_value > 0) {
-      while (((uint64_t)(io2_a_src - iop_a_src)) <= 0) {
-        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(1);
+    v_code = ((v_bits)&WUFFS_BASE__LOW_BITS_MASK__U32(v_width));
+    v_bits >>= v_width;
+    v_n_bits -= v_width;
+    if (v_code < v_clear_code) {
+      self->private_data.f_output[v_output_wi] = ((uint8_t)(v_code));
+      v_output_wi = ((v_output_wi + 1) & 8191);
+      if (v_save_code <= 4095) {
+        v_lm1_a = ((self->private_data.f_lm1s[v_prev_code] + 1) & 4095);
+        self->private_data.f_lm1s[v_save_code] = v_lm1_a;
+        if ((v_lm1_a % 16) != 0) {
+          self->private_impl.f_prefixes[v_save_code] =
+              self->private_impl.f_prefixes[v_prev_code];
+          memcpy(self->private_data.f_suffixes[v_save_code],
+                 self->private_data.f_suffixes[v_prev_code],
+                 sizeof(self->private_data.f_suffixes[v_save_code]));
+          self->private_data.f_suffixes[v_save_code][(v_lm1_a % 16)] =
+              ((uint8_t)(v_code));
+        } else {
+          self->private_impl.f_prefixes[v_save_code] =
+              ((uint16_t)(v_prev_code));
+          self->private_data.f_suffixes[v_save_code][0] = ((uint8_t)(v_code));
+        }
+        v_save_code += 1;
+        if (v_width < 12) {
+          v_width += (1 & (v_save_code >> v_width));
+        }
+        v_prev_code = v_code;
       }
-      self->private_impl.f_metadata_chunk_length_value =
-          ((uint64_t)(wuffs_base__load_u8be__no_bounds_check(iop_a_src)));
-      if (self->private_impl.f_metadata_chunk_length_value > 0) {
-        if (self->private_impl.f_metadata_fourcc_value == 1481461792) {
-          self->private_impl.f_metadata_chunk_length_value += 1;
+    } else if (v_code <= v_end_code) {
+      if (v_code == v_end_code) {
+        self->private_impl.f_read_from_return_value = 0;
+        goto label__0__break;
+      }
+      v_save_code = v_end_code;
+      v_prev_code = v_end_code;
+      v_width = (self->private_impl.f_literal_width + 1);
+    } else if (v_code <= v_save_code) {
+      v_c = v_code;
+      if (v_code == v_save_code) {
+        v_c = v_prev_code;
+      }
+      v_o = ((v_output_wi +
+              (((uint32_t)(self->private_data.f_lm1s[v_c])) & 4294967280u)) &
+             8191);
+      v_output_wi =
+          ((v_output_wi + 1 + ((uint32_t)(self->private_data.f_lm1s[v_c]))) &
+           8191);
+      v_steps = (((uint32_t)(self->private_data.f_lm1s[v_c])) >> 4);
+      while (true) {
+        memcpy((self->private_data.f_output) + (v_o),
+               (self->private_data.f_suffixes[v_c]), 16);
+        if (v_steps <= 0) {
+          goto label__1__break;
+        }
+        v_steps -= 1;
+        v_o = ((v_o - 16) & 8191);
+        v_c = ((uint32_t)(self->private_impl.f_prefixes[v_c]));
+      }
+    label__1__break:;
+      v_first_byte = self->private_data.f_suffixes[v_c][0];
+      if (v_code == v_save_code) {
+        self->private_data.f_output[v_output_wi] = v_first_byte;
+        v_output_wi = ((v_output_wi + 1) & 8191);
+      }
+      if (v_save_code <= 4095) {
+        v_lm1_b = ((self->private_data.f_lm1s[v_prev_code] + 1) & 4095);
+        self->private_data.f_lm1s[v_save_code] = v_lm1_b;
+        if ((v_lm1_b % 16) != 0) {
+          self->private_impl.f_prefixes[v_save_code] =
+              self->private_impl.f_prefixes[v_prev_code];
+          memcpy(self->private_data.f_suffixes[v_save_code],
+                 self->private_data.f_suffixes[v_prev_code],
+                 sizeof(self->private_data.f_suffixes[v_save_code]));
+          self->private_data.f_suffixes[v_save_code][(v_lm1_b % 16)] =
+              v_first_byte;
         } else {
-          (iop_a_src += 1, wuffs_base__make_empty_struct());
+          self->private_impl.f_prefixes[v_save_code] =
+              ((uint16_t)(v_prev_code));
+          self->private_data.f_suffixes[v_save_code][0] =
+              ((uint8_t)(v_first_byte));
         }
-        self->private_impl.f_metadata_io_position = wuffs_base__u64__sat_add(
-            wuffs_base__u64__sat_add(a_src->meta.pos,
-                                     ((uint64_t)(iop_a_src - io0_a_src))),
-            self->private_impl.f_metadata_chunk_length_value);
-        status = wuffs_base__make_status(wuffs_base__note__metadata_reported);
-        goto ok;
+        v_save_code += 1;
+        if (v_width < 12) {
+          v_width += (1 & (v_save_code >> v_width));
+        }
+        v_prev_code = v_code;
       }
-      (iop_a_src += 1, wuffs_base__make_empty_struct());
+    } else {
+      self->private_impl.f_read_from_return_value = 3;
+      goto label__0__break;
     }
-    self->private_impl.f_call_sequence = 2;
-    self->private_impl.f_metadata_fourcc_value = 0;
-    self->private_impl.f_metadata_io_position = 0;
-    status = wuffs_base__make_status(NULL);
-    goto ok;
-    goto ok;
-  ok:
-    self->private_impl.p_ack_metadata_chunk[0] = 0;
-    goto exit;
+    if (v_output_wi > 4095) {
+      self->private_impl.f_read_from_return_value = 1;
+      goto label__0__break;
+    }
+  }
+label__0__break:;
+  if (self->private_impl.f_read_from_return_value != 2) {
+    while (v_n_bits >= 8) {
+      v_n_bits -= 8;
+      if (iop_a_src > io1_a_src) {
+        (iop_a_src--, wuffs_base__make_empty_struct());
+      } else {
+        self->private_impl.f_read_from_return_value = 4;
+        goto label__2__break;
+      }
+    }
+  label__2__break:;
+  }
+  self->private_impl.f_save_code = v_save_code;
+  self->private_impl.f_prev_code = v_prev_code;
+  self->private_impl.f_width = v_width;
+  self->private_impl.f_bits = v_bits;
+  self->private_impl.f_n_bits = v_n_bits;
+  self->private_impl.f_output_wi = v_output_wi;
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
   }
 
-  goto suspend;
-suspend:
-  self->private_impl.p_ack_metadata_chunk[0] =
-      wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
-  self->private_impl.active_coroutine =
-      wuffs_base__status__is_suspension(&status) ? 2 : 0;
+  return wuffs_base__make_empty_struct();
+}
 
-  goto exit;
-exit:
-  if (a_src) {
-    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
-  }
+// -------- func lzw.decoder.write_to
 
-  if (wuffs_base__status__is_error(&status)) {
-    self->private_impl.magic = WUFFS_BASE__DISABLED;
-  }
-  return status;
-}
+static wuffs_base__status  //
+wuffs_lzw__decoder__write_to(wuffs_lzw__decoder* self,
+                             wuffs_base__io_buffer* a_dst) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
 
-// -------- func gif.config_decoder.metadata_fourcc
+  wuffs_base__slice_u8 v_s = {0};
+  uint64_t v_n = 0;
 
-WUFFS_BASE__MAYBE_STATIC uint32_t  //
-wuffs_gif__config_decoder__metadata_fourcc(
-    const wuffs_gif__config_decoder* self) {
-  if (!self) {
-    return 0;
-  }
-  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
-      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
-    return 0;
+  uint8_t* iop_a_dst = NULL;
+  uint8_t* io0_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_dst) {
+    io0_a_dst = a_dst->data.ptr;
+    io1_a_dst = io0_a_dst + a_dst->meta.wi;
+    iop_a_dst = io1_a_dst;
+    io2_a_dst = io0_a_dst + a_dst->data.len;
+    if (a_dst->meta.closed) {
+      io2_a_dst = iop_a_dst;
+    }
   }
 
-  return self->private_impl.f_metadata_fourcc_value;
-}
+  uint32_t coro_susp_point = self->private_impl.p_write_to[0];
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
 
-// -------- func gif.config_decoder.metadata_chunk_length
+    while (self->private_impl.f_output_wi > 0) {
+      if (self->private_impl.f_output_ri > self->private_impl.f_output_wi) {
+        status = wuffs_base__make_status(
+            wuffs_lzw__error__internal_error_inconsistent_i_o);
+        goto exit;
+      }
+      v_s = wuffs_base__slice_u8__subslice_ij(
+          wuffs_base__make_slice_u8(self->private_data.f_output, 8207),
+          self->private_impl.f_output_ri, self->private_impl.f_output_wi);
+      v_n = wuffs_base__io_writer__copy_from_slice(&iop_a_dst, io2_a_dst, v_s);
+      if (v_n == ((uint64_t)(v_s.len))) {
+        self->private_impl.f_output_ri = 0;
+        self->private_impl.f_output_wi = 0;
+        status = wuffs_base__make_status(NULL);
+        goto ok;
+      }
+      self->private_impl.f_output_ri =
+          ((self->private_impl.f_output_ri + ((uint32_t)((v_n & 4294967295)))) &
+           8191);
+      status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(1);
+    }
 
-WUFFS_BASE__MAYBE_STATIC uint64_t  //
-wuffs_gif__config_decoder__metadata_chunk_length(
-    const wuffs_gif__config_decoder* self) {
-  if (!self) {
-    return 0;
-  }
-  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
-      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
-    return 0;
+    goto ok;
+  ok:
+    self->private_impl.p_write_to[0] = 0;
+    goto exit;
   }
 
-  return self->private_impl.f_metadata_chunk_length_value;
-}
-
-// -------- func gif.config_decoder.num_animation_loops
+  goto suspend;
+suspend:
+  self->private_impl.p_write_to[0] =
+      wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
 
-WUFFS_BASE__MAYBE_STATIC uint32_t  //
-wuffs_gif__config_decoder__num_animation_loops(
-    const wuffs_gif__config_decoder* self) {
-  if (!self) {
-    return 0;
-  }
-  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
-      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
-    return 0;
+  goto exit;
+exit:
+  if (a_dst) {
+    a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
   }
 
-  if (self->private_impl.f_seen_num_loops) {
-    return self->private_impl.f_num_loops;
-  }
-  return 1;
+  return status;
 }
 
-// -------- func gif.config_decoder.num_decoded_frame_configs
+// -------- func lzw.decoder.flush
 
-WUFFS_BASE__MAYBE_STATIC uint64_t  //
-wuffs_gif__config_decoder__num_decoded_frame_configs(
-    const wuffs_gif__config_decoder* self) {
+WUFFS_BASE__MAYBE_STATIC wuffs_base__slice_u8  //
+wuffs_lzw__decoder__flush(wuffs_lzw__decoder* self) {
   if (!self) {
-    return 0;
+    return wuffs_base__make_slice_u8(NULL, 0);
   }
-  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
-      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
-    return 0;
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_slice_u8(NULL, 0);
   }
 
-  return self->private_impl.f_num_decoded_frame_configs_value;
+  wuffs_base__slice_u8 v_s = {0};
+
+  if (self->private_impl.f_output_ri <= self->private_impl.f_output_wi) {
+    v_s = wuffs_base__slice_u8__subslice_ij(
+        wuffs_base__make_slice_u8(self->private_data.f_output, 8207),
+        self->private_impl.f_output_ri, self->private_impl.f_output_wi);
+  }
+  self->private_impl.f_output_ri = 0;
+  self->private_impl.f_output_wi = 0;
+  return v_s;
 }
 
-// -------- func gif.config_decoder.num_decoded_frames
+// -------- func lzw.encoder.set_literal_width
 
-WUFFS_BASE__MAYBE_STATIC uint64_t  //
-wuffs_gif__config_decoder__num_decoded_frames(
-    const wuffs_gif__config_decoder* self) {
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_lzw__encoder__set_literal_width(wuffs_lzw__encoder* self, uint32_t a_lw) {
   if (!self) {
-    return 0;
+    return wuffs_base__make_empty_struct();
   }
-  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
-      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
-    return 0;
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (a_lw > 8) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_empty_struct();
   }
 
-  return self->private_impl.f_num_decoded_frames_value;
+  self->private_impl.f_set_literal_width_arg = (a_lw + 1);
+  return wuffs_base__make_empty_struct();
 }
 
-// -------- func gif.config_decoder.frame_dirty_rect
+// -------- func lzw.encoder.close_input
 
-WUFFS_BASE__MAYBE_STATIC wuffs_base__rect_ie_u32  //
-wuffs_gif__config_decoder__frame_dirty_rect(
-    const wuffs_gif__config_decoder* self) {
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_lzw__encoder__close_input(wuffs_lzw__encoder* self) {
   if (!self) {
-    return wuffs_base__utility__empty_rect_ie_u32();
+    return wuffs_base__make_empty_struct();
   }
-  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
-      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
-    return wuffs_base__utility__empty_rect_ie_u32();
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_empty_struct();
   }
 
-  return wuffs_base__utility__empty_rect_ie_u32();
+  self->private_impl.f_input_closed = true;
+  return wuffs_base__make_empty_struct();
 }
 
-// -------- func gif.config_decoder.workbuf_len
+// -------- func lzw.encoder.workbuf_len
 
 WUFFS_BASE__MAYBE_STATIC wuffs_base__range_ii_u64  //
-wuffs_gif__config_decoder__workbuf_len(const wuffs_gif__config_decoder* self) {
+wuffs_lzw__encoder__workbuf_len(const wuffs_lzw__encoder* self) {
   if (!self) {
     return wuffs_base__utility__empty_range_ii_u64();
   }
@@ -15752,44 +20321,16 @@ wuffs_gif__config_decoder__workbuf_len(const wuffs_gif__config_decoder* self) {
     return wuffs_base__utility__empty_range_ii_u64();
   }
 
-  return wuffs_base__utility__empty_range_ii_u64();
-}
-
-// -------- func gif.config_decoder.restart_frame
-
-WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
-wuffs_gif__config_decoder__restart_frame(wuffs_gif__config_decoder* self,
-                                         uint64_t a_index,
-                                         uint64_t a_io_position) {
-  if (!self) {
-    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
-  }
-  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
-    return wuffs_base__make_status(
-        (self->private_impl.magic == WUFFS_BASE__DISABLED)
-            ? wuffs_base__error__disabled_by_previous_error
-            : wuffs_base__error__initialize_not_called);
-  }
-
-  if (self->private_impl.f_call_sequence == 0) {
-    return wuffs_base__make_status(wuffs_base__error__bad_call_sequence);
-  }
-  self->private_impl.f_delayed_num_decoded_frames = false;
-  self->private_impl.f_end_of_data = false;
-  self->private_impl.f_restarted = true;
-  self->private_impl.f_frame_config_io_position = a_io_position;
-  self->private_impl.f_num_decoded_frame_configs_value = a_index;
-  self->private_impl.f_num_decoded_frames_value = a_index;
-  wuffs_gif__config_decoder__reset_gc(self);
-  return wuffs_base__make_status(NULL);
+  return wuffs_base__utility__make_range_ii_u64(0, 0);
 }
 
-// -------- func gif.config_decoder.decode_frame_config
+// -------- func lzw.encoder.transform_io
 
 WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
-wuffs_gif__config_decoder__decode_frame_config(wuffs_gif__config_decoder* self,
-                                               wuffs_base__frame_config* a_dst,
-                                               wuffs_base__io_buffer* a_src) {
+wuffs_lzw__encoder__transform_io(wuffs_lzw__encoder* self,
+                                 wuffs_base__io_buffer* a_dst,
+                                 wuffs_base__io_buffer* a_src,
+                                 wuffs_base__slice_u8 a_workbuf) {
   if (!self) {
     return wuffs_base__make_status(wuffs_base__error__bad_receiver);
   }
@@ -15799,12 +20340,12 @@ wuffs_gif__config_decoder__decode_frame_config(wuffs_gif__config_decoder* self,
             ? wuffs_base__error__disabled_by_previous_error
             : wuffs_base__error__initialize_not_called);
   }
-  if (!a_src) {
+  if (!a_dst || !a_src) {
     self->private_impl.magic = WUFFS_BASE__DISABLED;
     return wuffs_base__make_status(wuffs_base__error__bad_argument);
   }
   if ((self->private_impl.active_coroutine != 0) &&
-      (self->private_impl.active_coroutine != 3)) {
+      (self->private_impl.active_coroutine != 1)) {
     self->private_impl.magic = WUFFS_BASE__DISABLED;
     return wuffs_base__make_status(
         wuffs_base__error__interleaved_coroutine_calls);
@@ -15812,8 +20353,8 @@ wuffs_gif__config_decoder__decode_frame_config(wuffs_gif__config_decoder* self,
   self->private_impl.active_coroutine = 0;
   wuffs_base__status status = wuffs_base__make_status(NULL);
 
-  uint32_t v_background_color = 0;
-  uint8_t v_flags = 0;
+  uint32_t v_lw = 0;
+  wuffs_base__status v_status = wuffs_base__make_status(NULL);
 
   uint8_t* iop_a_src = NULL;
   uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
@@ -15826,114 +20367,96 @@ wuffs_gif__config_decoder__decode_frame_config(wuffs_gif__config_decoder* self,
     io2_a_src = io0_a_src + a_src->meta.wi;
   }
 
-  uint32_t coro_susp_point = self->private_impl.p_decode_frame_config[0];
-  if (coro_susp_point) {
-    v_background_color =
-        self->private_data.s_decode_frame_config[0].v_background_color;
-  }
+  uint32_t coro_susp_point = self->private_impl.p_transform_io[0];
   switch (coro_susp_point) {
     WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
 
-    self->private_impl.f_ignore_metadata = true;
-    if (!self->private_impl.f_end_of_data) {
-      if (self->private_impl.f_call_sequence == 0) {
-        if (a_src) {
-          a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
-        }
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
-        status =
-            wuffs_gif__config_decoder__decode_image_config(self, NULL, a_src);
-        if (a_src) {
-          iop_a_src = a_src->data.ptr + a_src->meta.ri;
-        }
-        if (status.repr) {
-          goto suspend;
-        }
-      } else if (self->private_impl.f_call_sequence != 3) {
-        if (self->private_impl.f_call_sequence == 4) {
-          if (a_src) {
-            a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
-          }
-          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
-          status = wuffs_gif__config_decoder__skip_frame(self, a_src);
-          if (a_src) {
-            iop_a_src = a_src->data.ptr + a_src->meta.ri;
-          }
-          if (status.repr) {
-            goto suspend;
-          }
-        }
-        if (a_src) {
-          a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
-        }
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
-        status = wuffs_gif__config_decoder__decode_up_to_id_part1(self, a_src);
-        if (a_src) {
-          iop_a_src = a_src->data.ptr + a_src->meta.ri;
-        }
-        if (status.repr) {
-          goto suspend;
-        }
-      }
+    v_lw = 8;
+    if (self->private_impl.f_set_literal_width_arg > 0) {
+      v_lw = (self->private_impl.f_set_literal_width_arg - 1);
     }
-    if (self->private_impl.f_end_of_data) {
-      status = wuffs_base__make_status(wuffs_base__note__end_of_data);
-      goto ok;
+    self->private_impl.f_literal_width = wuffs_base__u32__max(v_lw, 2);
+    self->private_impl.f_clear_code =
+        (((uint32_t)(1)) << self->private_impl.f_literal_width);
+    self->private_impl.f_end_code = (self->private_impl.f_clear_code + 1);
+    self->private_impl.f_has_code = false;
+    self->private_impl.f_code = 0;
+    self->private_impl.f_hi = self->private_impl.f_end_code;
+    self->private_impl.f_width = (self->private_impl.f_literal_width + 1);
+    wuffs_lzw__encoder__clear_hash_table(self);
+    self->private_impl.f_bits = ((uint64_t)(self->private_impl.f_clear_code));
+    self->private_impl.f_n_bits = self->private_impl.f_width;
+  label__0__continue:;
+    while (true) {
+      if (a_src) {
+        a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+      }
+      v_status = wuffs_lzw__encoder__encode_codes(self, a_dst, a_src);
+      if (a_src) {
+        iop_a_src = a_src->data.ptr + a_src->meta.ri;
+      }
+      if (wuffs_base__status__is_error(&v_status)) {
+        status = v_status;
+        goto exit;
+      }
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+      status = wuffs_lzw__encoder__flush_bits(self, a_dst);
+      if (status.repr) {
+        goto suspend;
+      }
+      if (((uint64_t)(io2_a_src - iop_a_src)) > 0) {
+        goto label__0__continue;
+      } else if ((a_src && a_src->meta.closed) ||
+                 self->private_impl.f_input_closed) {
+        goto label__0__break;
+      }
+      status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(2);
     }
-    v_background_color = self->private_impl.f_black_color_u32_argb_premul;
-    if (!self->private_impl.f_gc_has_transparent_index) {
-      v_background_color =
-          self->private_impl.f_background_color_u32_argb_premul;
-      if (self->private_impl
-              .f_quirk_enabled_first_frame_local_palette_means_black_background &&
-          (self->private_impl.f_num_decoded_frame_configs_value == 0)) {
-        while (((uint64_t)(io2_a_src - iop_a_src)) <= 0) {
-          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-          WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(4);
-        }
-        v_flags = wuffs_base__load_u8be__no_bounds_check(iop_a_src);
-        if ((v_flags & 128) != 0) {
-          v_background_color = self->private_impl.f_black_color_u32_argb_premul;
+  label__0__break:;
+    if (self->private_impl.f_has_code) {
+      self->private_impl.f_bits |= (((uint64_t)(self->private_impl.f_code))
+                                    << (self->private_impl.f_n_bits & 63));
+      self->private_impl.f_n_bits += self->private_impl.f_width;
+      if (self->private_impl.f_hi >= 4094) {
+        self->private_impl.f_bits |=
+            (((uint64_t)(self->private_impl.f_clear_code))
+             << (self->private_impl.f_n_bits & 63));
+        self->private_impl.f_n_bits += self->private_impl.f_width;
+        self->private_impl.f_width = (self->private_impl.f_literal_width + 1);
+      } else {
+        self->private_impl.f_hi += 1;
+        if ((self->private_impl.f_hi ==
+             (((uint32_t)(1)) << self->private_impl.f_width)) &&
+            (self->private_impl.f_width < 12)) {
+          self->private_impl.f_width += 1;
         }
       }
     }
-    if (a_dst != NULL) {
-      wuffs_base__frame_config__update(
-          a_dst,
-          wuffs_base__utility__make_rect_ie_u32(
-              wuffs_base__u32__min(self->private_impl.f_frame_rect_x0,
-                                   self->private_impl.f_width),
-              wuffs_base__u32__min(self->private_impl.f_frame_rect_y0,
-                                   self->private_impl.f_height),
-              wuffs_base__u32__min(self->private_impl.f_frame_rect_x1,
-                                   self->private_impl.f_width),
-              wuffs_base__u32__min(self->private_impl.f_frame_rect_y1,
-                                   self->private_impl.f_height)),
-          ((wuffs_base__flicks)(self->private_impl.f_gc_duration)),
-          self->private_impl.f_num_decoded_frame_configs_value,
-          self->private_impl.f_frame_config_io_position,
-          self->private_impl.f_gc_disposal,
-          !self->private_impl.f_gc_has_transparent_index, false,
-          v_background_color);
+    self->private_impl.f_bits |= (((uint64_t)(self->private_impl.f_end_code))
+                                  << (self->private_impl.f_n_bits & 63));
+    self->private_impl.f_n_bits += self->private_impl.f_width;
+    self->private_impl.f_n_bits =
+        ((self->private_impl.f_n_bits + 7) & 4294967288u);
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+    status = wuffs_lzw__encoder__flush_bits(self, a_dst);
+    if (status.repr) {
+      goto suspend;
     }
-    wuffs_base__u64__sat_add_indirect(
-        &self->private_impl.f_num_decoded_frame_configs_value, 1);
-    self->private_impl.f_call_sequence = 4;
+    self->private_impl.f_input_closed = false;
 
     goto ok;
   ok:
-    self->private_impl.p_decode_frame_config[0] = 0;
+    self->private_impl.p_transform_io[0] = 0;
     goto exit;
   }
 
   goto suspend;
 suspend:
-  self->private_impl.p_decode_frame_config[0] =
+  self->private_impl.p_transform_io[0] =
       wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
   self->private_impl.active_coroutine =
-      wuffs_base__status__is_suspension(&status) ? 3 : 0;
-  self->private_data.s_decode_frame_config[0].v_background_color =
-      v_background_color;
+      wuffs_base__status__is_suspension(&status) ? 1 : 0;
 
   goto exit;
 exit:
@@ -15947,16 +20470,53 @@ exit:
   return status;
 }
 
-// -------- func gif.config_decoder.skip_frame
+// -------- func lzw.encoder.clear_hash_table
+
+static wuffs_base__empty_struct  //
+wuffs_lzw__encoder__clear_hash_table(wuffs_lzw__encoder* self) {
+  uint32_t v_i = 0;
+
+  v_i = 0;
+  while (v_i <= 8191) {
+    self->private_data.f_hash_table[v_i] = 0;
+    v_i += 1;
+  }
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func lzw.encoder.encode_codes
 
 static wuffs_base__status  //
-wuffs_gif__config_decoder__skip_frame(wuffs_gif__config_decoder* self,
-                                      wuffs_base__io_buffer* a_src) {
+wuffs_lzw__encoder__encode_codes(wuffs_lzw__encoder* self,
+                                 wuffs_base__io_buffer* a_dst,
+                                 wuffs_base__io_buffer* a_src) {
   wuffs_base__status status = wuffs_base__make_status(NULL);
 
-  uint8_t v_flags = 0;
-  uint8_t v_lw = 0;
+  uint32_t v_clear_code = 0;
+  uint32_t v_end_code = 0;
+  uint32_t v_code = 0;
+  uint32_t v_hi = 0;
+  uint32_t v_width = 0;
+  uint64_t v_bits = 0;
+  uint32_t v_n_bits = 0;
+  uint32_t v_literal = 0;
+  uint32_t v_key = 0;
+  uint32_t v_h = 0;
+  uint32_t v_entry = 0;
 
+  uint8_t* iop_a_dst = NULL;
+  uint8_t* io0_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_dst) {
+    io0_a_dst = a_dst->data.ptr;
+    io1_a_dst = io0_a_dst + a_dst->meta.wi;
+    iop_a_dst = io1_a_dst;
+    io2_a_dst = io0_a_dst + a_dst->data.len;
+    if (a_dst->meta.closed) {
+      io2_a_dst = iop_a_dst;
+    }
+  }
   uint8_t* iop_a_src = NULL;
   uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
   uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
@@ -15968,338 +20528,3065 @@ wuffs_gif__config_decoder__skip_frame(wuffs_gif__config_decoder* self,
     io2_a_src = io0_a_src + a_src->meta.wi;
   }
 
-  uint32_t coro_susp_point = self->private_impl.p_skip_frame[0];
-  switch (coro_susp_point) {
-    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
-
-    {
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
-      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-        goto suspend;
-      }
-      uint8_t t_0 = *iop_a_src++;
-      v_flags = t_0;
+  v_clear_code = self->private_impl.f_clear_code;
+  v_end_code = self->private_impl.f_end_code;
+  if (!self->private_impl.f_has_code) {
+    if (((uint64_t)(io2_a_src - iop_a_src)) <= 0) {
+      status = wuffs_base__make_status(NULL);
+      goto ok;
     }
-    if ((v_flags & 128) != 0) {
-      self->private_data.s_skip_frame[0].scratch =
-          (((uint32_t)(3)) << (1 + (v_flags & 7)));
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
-      if (self->private_data.s_skip_frame[0].scratch >
-          ((uint64_t)(io2_a_src - iop_a_src))) {
-        self->private_data.s_skip_frame[0].scratch -=
-            ((uint64_t)(io2_a_src - iop_a_src));
-        iop_a_src = io2_a_src;
-        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-        goto suspend;
-      }
-      iop_a_src += self->private_data.s_skip_frame[0].scratch;
+    v_literal = ((uint32_t)(wuffs_base__load_u8be__no_bounds_check(iop_a_src)));
+    if (v_literal >= v_clear_code) {
+      status = wuffs_base__make_status(wuffs_lzw__error__bad_input_byte);
+      goto exit;
     }
-    {
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
-      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-        goto suspend;
+    (iop_a_src += 1, wuffs_base__make_empty_struct());
+    self->private_impl.f_code = v_literal;
+    self->private_impl.f_has_code = true;
+  }
+  v_code = self->private_impl.f_code;
+  v_hi = self->private_impl.f_hi;
+  v_width = self->private_impl.f_width;
+  v_bits = self->private_impl.f_bits;
+  v_n_bits = self->private_impl.f_n_bits;
+label__loop__continue:;
+  while (((uint64_t)(io2_a_src - iop_a_src)) > 0) {
+    if (v_n_bits >= 32) {
+      if (((uint64_t)(io2_a_dst - iop_a_dst)) < 4) {
+        goto label__loop__break;
       }
-      uint8_t t_1 = *iop_a_src++;
-      v_lw = t_1;
-    }
-    if (v_lw > 8) {
-      status = wuffs_base__make_status(wuffs_gif__error__bad_literal_width);
+      (wuffs_base__store_u32le__no_bounds_check(
+           iop_a_dst, ((uint32_t)((v_bits & 4294967295)))),
+       iop_a_dst += 4, wuffs_base__make_empty_struct());
+      v_bits >>= 32;
+      v_n_bits -= 32;
+    }
+    v_literal = ((uint32_t)(wuffs_base__load_u8be__no_bounds_check(iop_a_src)));
+    if (v_literal >= v_clear_code) {
+      self->private_impl.f_code = v_code;
+      self->private_impl.f_hi = v_hi;
+      self->private_impl.f_width = v_width;
+      self->private_impl.f_bits = v_bits;
+      self->private_impl.f_n_bits = v_n_bits;
+      status = wuffs_base__make_status(wuffs_lzw__error__bad_input_byte);
       goto exit;
     }
-    if (a_src) {
-      a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+    (iop_a_src += 1, wuffs_base__make_empty_struct());
+    v_key = ((v_code << 8) | v_literal);
+    v_h = ((v_key * 2654435761u) >> 19);
+    while (true) {
+      v_entry = self->private_data.f_hash_table[v_h];
+      if (v_entry == 0) {
+        goto label__0__break;
+      } else if ((v_entry >> 12) == v_key) {
+        v_code = (v_entry & 4095);
+        goto label__loop__continue;
+      }
+      v_h = ((v_h + 1) & 8191);
     }
-    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
-    status = wuffs_gif__config_decoder__skip_blocks(self, a_src);
-    if (a_src) {
-      iop_a_src = a_src->data.ptr + a_src->meta.ri;
+  label__0__break:;
+    v_bits |= (((uint64_t)(v_code)) << (v_n_bits & 63));
+    v_n_bits += v_width;
+    v_code = v_literal;
+    if (v_hi >= 4094) {
+      v_bits |= (((uint64_t)(v_clear_code)) << (v_n_bits & 63));
+      v_n_bits += v_width;
+      v_hi = v_end_code;
+      v_width = (self->private_impl.f_literal_width + 1);
+      wuffs_lzw__encoder__clear_hash_table(self);
+      goto label__loop__continue;
     }
-    if (status.repr) {
-      goto suspend;
+    v_hi += 1;
+    if ((v_hi == (((uint32_t)(1)) << v_width)) && (v_width < 12)) {
+      v_width += 1;
     }
-    if (self->private_impl.f_quirk_enabled_delay_num_decoded_frames) {
-      self->private_impl.f_delayed_num_decoded_frames = true;
-    } else {
-      wuffs_base__u64__sat_add_indirect(
-          &self->private_impl.f_num_decoded_frames_value, 1);
+    self->private_data.f_hash_table[v_h] = ((v_key << 12) | v_hi);
+  }
+label__loop__break:;
+  self->private_impl.f_code = v_code;
+  self->private_impl.f_hi = v_hi;
+  self->private_impl.f_width = v_width;
+  self->private_impl.f_bits = v_bits;
+  self->private_impl.f_n_bits = v_n_bits;
+  status = wuffs_base__make_status(NULL);
+  goto ok;
+  goto ok;
+ok:
+  goto exit;
+exit:
+  if (a_dst) {
+    a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+  }
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  return status;
+}
+
+// -------- func lzw.encoder.flush_bits
+
+static wuffs_base__status  //
+wuffs_lzw__encoder__flush_bits(wuffs_lzw__encoder* self,
+                               wuffs_base__io_buffer* a_dst) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint8_t* iop_a_dst = NULL;
+  uint8_t* io0_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_dst) {
+    io0_a_dst = a_dst->data.ptr;
+    io1_a_dst = io0_a_dst + a_dst->meta.wi;
+    iop_a_dst = io1_a_dst;
+    io2_a_dst = io0_a_dst + a_dst->data.len;
+    if (a_dst->meta.closed) {
+      io2_a_dst = iop_a_dst;
+    }
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_flush_bits[0];
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    while (self->private_impl.f_n_bits >= 8) {
+      self->private_data.s_flush_bits[0].scratch =
+          ((uint8_t)((self->private_impl.f_bits & 255)));
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+      if (iop_a_dst == io2_a_dst) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+        goto suspend;
+      }
+      *iop_a_dst++ = ((uint8_t)(self->private_data.s_flush_bits[0].scratch));
+      self->private_impl.f_bits >>= 8;
+      self->private_impl.f_n_bits -= 8;
     }
-    wuffs_gif__config_decoder__reset_gc(self);
 
     goto ok;
   ok:
-    self->private_impl.p_skip_frame[0] = 0;
+    self->private_impl.p_flush_bits[0] = 0;
     goto exit;
   }
 
   goto suspend;
 suspend:
-  self->private_impl.p_skip_frame[0] =
+  self->private_impl.p_flush_bits[0] =
       wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
 
   goto exit;
 exit:
-  if (a_src) {
-    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  if (a_dst) {
+    a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
   }
 
   return status;
 }
 
-// -------- func gif.config_decoder.decode_frame
+#endif  // !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__LZW)
 
-WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
-wuffs_gif__config_decoder__decode_frame(
-    wuffs_gif__config_decoder* self,
-    wuffs_base__pixel_buffer* a_dst,
-    wuffs_base__io_buffer* a_src,
-    wuffs_base__pixel_blend a_blend,
-    wuffs_base__slice_u8 a_workbuf,
-    wuffs_base__decode_frame_options* a_opts) {
-  if (!self) {
-    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
-  }
-  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
-    return wuffs_base__make_status(
-        (self->private_impl.magic == WUFFS_BASE__DISABLED)
-            ? wuffs_base__error__disabled_by_previous_error
-            : wuffs_base__error__initialize_not_called);
-  }
-  if (!a_dst || !a_src) {
-    self->private_impl.magic = WUFFS_BASE__DISABLED;
-    return wuffs_base__make_status(wuffs_base__error__bad_argument);
-  }
-  if ((self->private_impl.active_coroutine != 0) &&
-      (self->private_impl.active_coroutine != 4)) {
-    self->private_impl.magic = WUFFS_BASE__DISABLED;
-    return wuffs_base__make_status(
-        wuffs_base__error__interleaved_coroutine_calls);
-  }
-  self->private_impl.active_coroutine = 0;
-  wuffs_base__status status = wuffs_base__make_status(NULL);
+#if !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__GIF)
 
-  status = wuffs_base__make_status(wuffs_base__error__unsupported_method);
-  goto exit;
-  goto ok;
-ok:
-  goto exit;
-exit:
-  if (wuffs_base__status__is_error(&status)) {
-    self->private_impl.magic = WUFFS_BASE__DISABLED;
-  }
-  return status;
-}
+// ---------------- Status Codes Implementations
 
-// -------- func gif.config_decoder.reset_gc
+const char* wuffs_gif__error__bad_block = "#gif: bad block";
+const char* wuffs_gif__error__bad_extension_label = "#gif: bad extension label";
+const char* wuffs_gif__error__bad_frame_size = "#gif: bad frame size";
+const char* wuffs_gif__error__bad_graphic_control = "#gif: bad graphic control";
+const char* wuffs_gif__error__bad_header = "#gif: bad header";
+const char* wuffs_gif__error__bad_literal_width = "#gif: bad literal width";
+const char* wuffs_gif__error__bad_palette = "#gif: bad palette";
+const char* wuffs_gif__error__internal_error_inconsistent_ri_wi =
+    "#gif: internal error: inconsistent ri/wi";
+const char* wuffs_gif__error__unsupported_pixel_format =
+    "#gif: unsupported pixel format";
+const char* wuffs_gif__error__internal_error_inconsistent_encoder_state =
+    "#gif: internal error: inconsistent encoder state";
 
-static wuffs_base__empty_struct  //
-wuffs_gif__config_decoder__reset_gc(wuffs_gif__config_decoder* self) {
-  self->private_impl.f_call_sequence = 5;
-  self->private_impl.f_gc_has_transparent_index = false;
-  self->private_impl.f_gc_transparent_index = 0;
-  self->private_impl.f_gc_disposal = 0;
-  self->private_impl.f_gc_duration = 0;
-  return wuffs_base__make_empty_struct();
-}
+// ---------------- Private Consts
 
-// -------- func gif.config_decoder.decode_up_to_id_part1
+static const uint32_t              //
+    wuffs_gif__interlace_start[5]  //
+    WUFFS_BASE__POTENTIALLY_UNUSED = {
+        4294967295, 1, 2, 4, 0,
+};
 
-static wuffs_base__status  //
-wuffs_gif__config_decoder__decode_up_to_id_part1(
-    wuffs_gif__config_decoder* self,
-    wuffs_base__io_buffer* a_src) {
-  wuffs_base__status status = wuffs_base__make_status(NULL);
+static const uint8_t               //
+    wuffs_gif__interlace_delta[5]  //
+    WUFFS_BASE__POTENTIALLY_UNUSED = {
+        1, 2, 4, 8, 8,
+};
 
-  uint8_t v_block_type = 0;
+static const uint8_t               //
+    wuffs_gif__interlace_count[5]  //
+    WUFFS_BASE__POTENTIALLY_UNUSED = {
+        0, 1, 2, 4, 8,
+};
 
-  uint8_t* iop_a_src = NULL;
-  uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
-  uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
-  uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
-  if (a_src) {
-    io0_a_src = a_src->data.ptr;
-    io1_a_src = io0_a_src + a_src->meta.ri;
-    iop_a_src = io1_a_src;
-    io2_a_src = io0_a_src + a_src->meta.wi;
-  }
+static const uint8_t              //
+    wuffs_gif__animexts1dot0[11]  //
+    WUFFS_BASE__POTENTIALLY_UNUSED = {
+        65, 78, 73, 77, 69, 88, 84, 83, 49, 46, 48,
+};
 
-  uint32_t coro_susp_point = self->private_impl.p_decode_up_to_id_part1[0];
-  switch (coro_susp_point) {
-    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+static const uint8_t              //
+    wuffs_gif__netscape2dot0[11]  //
+    WUFFS_BASE__POTENTIALLY_UNUSED = {
+        78, 69, 84, 83, 67, 65, 80, 69, 50, 46, 48,
+};
 
-    if (!self->private_impl.f_restarted) {
-      if (self->private_impl.f_call_sequence != 2) {
-        self->private_impl.f_frame_config_io_position =
-            wuffs_base__u64__sat_add(a_src->meta.pos,
-                                     ((uint64_t)(iop_a_src - io0_a_src)));
-      }
-    } else if (self->private_impl.f_frame_config_io_position !=
-               wuffs_base__u64__sat_add(a_src->meta.pos,
-                                        ((uint64_t)(iop_a_src - io0_a_src)))) {
-      status = wuffs_base__make_status(wuffs_base__error__bad_restart);
-      goto exit;
-    } else {
-      self->private_impl.f_restarted = false;
-    }
-    while (true) {
-      {
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
-        if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-          goto suspend;
-        }
-        uint8_t t_0 = *iop_a_src++;
-        v_block_type = t_0;
-      }
-      if (v_block_type == 33) {
-        if (a_src) {
-          a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
-        }
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
-        status = wuffs_gif__config_decoder__decode_extension(self, a_src);
-        if (a_src) {
-          iop_a_src = a_src->data.ptr + a_src->meta.ri;
-        }
-        if (status.repr) {
-          goto suspend;
-        }
-      } else if (v_block_type == 44) {
-        if (self->private_impl.f_delayed_num_decoded_frames) {
-          self->private_impl.f_delayed_num_decoded_frames = false;
-          wuffs_base__u64__sat_add_indirect(
-              &self->private_impl.f_num_decoded_frames_value, 1);
-        }
-        if (a_src) {
-          a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
-        }
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
-        status = wuffs_gif__config_decoder__decode_id_part0(self, a_src);
-        if (a_src) {
-          iop_a_src = a_src->data.ptr + a_src->meta.ri;
-        }
-        if (status.repr) {
-          goto suspend;
-        }
-        goto label__0__break;
-      } else if (v_block_type == 59) {
-        if (self->private_impl.f_delayed_num_decoded_frames) {
-          self->private_impl.f_delayed_num_decoded_frames = false;
-          wuffs_base__u64__sat_add_indirect(
-              &self->private_impl.f_num_decoded_frames_value, 1);
-        }
-        self->private_impl.f_end_of_data = true;
-        goto label__0__break;
-      } else {
-        status = wuffs_base__make_status(wuffs_gif__error__bad_block);
-        goto exit;
-      }
-    }
-  label__0__break:;
+static const uint8_t            //
+    wuffs_gif__iccrgbg1012[11]  //
+    WUFFS_BASE__POTENTIALLY_UNUSED = {
+        73, 67, 67, 82, 71, 66, 71, 49, 48, 49, 50,
+};
 
-    goto ok;
-  ok:
-    self->private_impl.p_decode_up_to_id_part1[0] = 0;
-    goto exit;
-  }
+static const uint8_t           //
+    wuffs_gif__xmpdataxmp[11]  //
+    WUFFS_BASE__POTENTIALLY_UNUSED = {
+        88, 77, 80, 32, 68, 97, 116, 97, 88, 77, 80,
+};
 
-  goto suspend;
-suspend:
-  self->private_impl.p_decode_up_to_id_part1[0] =
-      wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+// ---------------- Private Initializer Prototypes
 
-  goto exit;
-exit:
-  if (a_src) {
-    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
-  }
+// ---------------- Private Function Prototypes
 
-  return status;
-}
+static wuffs_base__status  //
+wuffs_gif__config_decoder__skip_frame(wuffs_gif__config_decoder* self,
+                                      wuffs_base__io_buffer* a_src);
 
-// -------- func gif.config_decoder.decode_header
+static wuffs_base__empty_struct  //
+wuffs_gif__config_decoder__reset_gc(wuffs_gif__config_decoder* self);
+
+static wuffs_base__status  //
+wuffs_gif__config_decoder__decode_up_to_id_part1(
+    wuffs_gif__config_decoder* self,
+    wuffs_base__io_buffer* a_src);
 
 static wuffs_base__status  //
 wuffs_gif__config_decoder__decode_header(wuffs_gif__config_decoder* self,
-                                         wuffs_base__io_buffer* a_src) {
-  wuffs_base__status status = wuffs_base__make_status(NULL);
+                                         wuffs_base__io_buffer* a_src);
 
-  uint8_t v_c[6] = {0};
-  uint32_t v_i = 0;
+static wuffs_base__status  //
+wuffs_gif__config_decoder__decode_lsd(wuffs_gif__config_decoder* self,
+                                      wuffs_base__io_buffer* a_src);
 
-  uint8_t* iop_a_src = NULL;
-  uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
-  uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
-  uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
-  if (a_src) {
-    io0_a_src = a_src->data.ptr;
-    io1_a_src = io0_a_src + a_src->meta.ri;
-    iop_a_src = io1_a_src;
-    io2_a_src = io0_a_src + a_src->meta.wi;
-  }
+static wuffs_base__status  //
+wuffs_gif__config_decoder__decode_extension(wuffs_gif__config_decoder* self,
+                                            wuffs_base__io_buffer* a_src);
 
-  uint32_t coro_susp_point = self->private_impl.p_decode_header[0];
-  if (coro_susp_point) {
-    memcpy(v_c, self->private_data.s_decode_header[0].v_c, sizeof(v_c));
-    v_i = self->private_data.s_decode_header[0].v_i;
-  }
-  switch (coro_susp_point) {
-    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+static wuffs_base__status  //
+wuffs_gif__config_decoder__skip_blocks(wuffs_gif__config_decoder* self,
+                                       wuffs_base__io_buffer* a_src);
 
-    while (v_i < 6) {
-      {
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
-        if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-          goto suspend;
-        }
-        uint8_t t_0 = *iop_a_src++;
-        v_c[v_i] = t_0;
-      }
-      v_i += 1;
-    }
-    if ((v_c[0] != 71) || (v_c[1] != 73) || (v_c[2] != 70) || (v_c[3] != 56) ||
-        ((v_c[4] != 55) && (v_c[4] != 57)) || (v_c[5] != 97)) {
-      status = wuffs_base__make_status(wuffs_gif__error__bad_header);
-      goto exit;
-    }
+static wuffs_base__status  //
+wuffs_gif__config_decoder__decode_ae(wuffs_gif__config_decoder* self,
+                                     wuffs_base__io_buffer* a_src);
 
-    goto ok;
-  ok:
-    self->private_impl.p_decode_header[0] = 0;
-    goto exit;
+static wuffs_base__status  //
+wuffs_gif__config_decoder__decode_gc(wuffs_gif__config_decoder* self,
+                                     wuffs_base__io_buffer* a_src);
+
+static wuffs_base__status  //
+wuffs_gif__config_decoder__decode_id_part0(wuffs_gif__config_decoder* self,
+                                           wuffs_base__io_buffer* a_src);
+
+static wuffs_base__status  //
+wuffs_gif__decoder__skip_frame(wuffs_gif__decoder* self,
+                               wuffs_base__io_buffer* a_src);
+
+static wuffs_base__empty_struct  //
+wuffs_gif__decoder__reset_gc(wuffs_gif__decoder* self);
+
+static wuffs_base__status  //
+wuffs_gif__decoder__decode_up_to_id_part1(wuffs_gif__decoder* self,
+                                          wuffs_base__io_buffer* a_src);
+
+static wuffs_base__status  //
+wuffs_gif__decoder__decode_header(wuffs_gif__decoder* self,
+                                  wuffs_base__io_buffer* a_src);
+
+static wuffs_base__status  //
+wuffs_gif__decoder__decode_lsd(wuffs_gif__decoder* self,
+                               wuffs_base__io_buffer* a_src);
+
+static wuffs_base__status  //
+wuffs_gif__decoder__decode_extension(wuffs_gif__decoder* self,
+                                     wuffs_base__io_buffer* a_src);
+
+static wuffs_base__status  //
+wuffs_gif__decoder__skip_blocks(wuffs_gif__decoder* self,
+                                wuffs_base__io_buffer* a_src);
+
+static wuffs_base__status  //
+wuffs_gif__decoder__decode_ae(wuffs_gif__decoder* self,
+                              wuffs_base__io_buffer* a_src);
+
+static wuffs_base__status  //
+wuffs_gif__decoder__decode_gc(wuffs_gif__decoder* self,
+                              wuffs_base__io_buffer* a_src);
+
+static wuffs_base__status  //
+wuffs_gif__decoder__decode_id_part0(wuffs_gif__decoder* self,
+                                    wuffs_base__io_buffer* a_src);
+
+static wuffs_base__status  //
+wuffs_gif__decoder__decode_id_part1(wuffs_gif__decoder* self,
+                                    wuffs_base__pixel_buffer* a_dst,
+                                    wuffs_base__io_buffer* a_src,
+                                    wuffs_base__pixel_blend a_blend);
+
+static wuffs_base__status  //
+wuffs_gif__decoder__decode_id_part2(wuffs_gif__decoder* self,
+                                    wuffs_base__pixel_buffer* a_dst,
+                                    wuffs_base__io_buffer* a_src,
+                                    wuffs_base__slice_u8 a_workbuf);
+
+static wuffs_base__status  //
+wuffs_gif__decoder__copy_to_image_buffer(wuffs_gif__decoder* self,
+                                         wuffs_base__pixel_buffer* a_pb,
+                                         wuffs_base__slice_u8 a_src);
+
+static wuffs_base__status  //
+wuffs_gif__encoder__write_u16le(wuffs_gif__encoder* self,
+                                wuffs_base__io_buffer* a_dst,
+                                uint32_t a_a);
+
+static wuffs_base__status  //
+wuffs_gif__encoder__write_color_table(wuffs_gif__encoder* self,
+                                      wuffs_base__io_buffer* a_dst,
+                                      uint32_t a_which);
+
+static wuffs_base__status  //
+wuffs_gif__encoder__write_image_data(wuffs_gif__encoder* self,
+                                     wuffs_base__io_buffer* a_dst,
+                                     wuffs_base__pixel_buffer* a_src);
+
+// ---------------- VTables
+
+const wuffs_base__image_decoder__func_ptrs
+    wuffs_gif__config_decoder__func_ptrs_for__wuffs_base__image_decoder = {
+        (wuffs_base__status(*)(void*, wuffs_base__io_buffer*))(
+            &wuffs_gif__config_decoder__ack_metadata_chunk),
+        (wuffs_base__status(*)(void*,
+                               wuffs_base__pixel_buffer*,
+                               wuffs_base__io_buffer*,
+                               wuffs_base__pixel_blend,
+                               wuffs_base__slice_u8,
+                               wuffs_base__decode_frame_options*))(
+            &wuffs_gif__config_decoder__decode_frame),
+        (wuffs_base__status(*)(void*,
+                               wuffs_base__frame_config*,
+                               wuffs_base__io_buffer*))(
+            &wuffs_gif__config_decoder__decode_frame_config),
+        (wuffs_base__status(*)(void*,
+                               wuffs_base__image_config*,
+                               wuffs_base__io_buffer*))(
+            &wuffs_gif__config_decoder__decode_image_config),
+        (wuffs_base__rect_ie_u32(*)(const void*))(
+            &wuffs_gif__config_decoder__frame_dirty_rect),
+        (uint64_t(*)(const void*))(
+            &wuffs_gif__config_decoder__metadata_chunk_length),
+        (uint32_t(*)(const void*))(&wuffs_gif__config_decoder__metadata_fourcc),
+        (uint32_t(*)(const void*))(
+            &wuffs_gif__config_decoder__num_animation_loops),
+        (uint64_t(*)(const void*))(
+            &wuffs_gif__config_decoder__num_decoded_frame_configs),
+        (uint64_t(*)(const void*))(
+            &wuffs_gif__config_decoder__num_decoded_frames),
+        (wuffs_base__status(*)(void*, uint64_t, uint64_t))(
+            &wuffs_gif__config_decoder__restart_frame),
+        (wuffs_base__empty_struct(*)(void*, uint32_t, bool))(
+            &wuffs_gif__config_decoder__set_report_metadata),
+        (wuffs_base__range_ii_u64(*)(const void*))(
+            &wuffs_gif__config_decoder__workbuf_len),
+};
+
+const wuffs_base__image_decoder__func_ptrs
+    wuffs_gif__decoder__func_ptrs_for__wuffs_base__image_decoder = {
+        (wuffs_base__status(*)(void*, wuffs_base__io_buffer*))(
+            &wuffs_gif__decoder__ack_metadata_chunk),
+        (wuffs_base__status(*)(void*,
+                               wuffs_base__pixel_buffer*,
+                               wuffs_base__io_buffer*,
+                               wuffs_base__pixel_blend,
+                               wuffs_base__slice_u8,
+                               wuffs_base__decode_frame_options*))(
+            &wuffs_gif__decoder__decode_frame),
+        (wuffs_base__status(*)(void*,
+                               wuffs_base__frame_config*,
+                               wuffs_base__io_buffer*))(
+            &wuffs_gif__decoder__decode_frame_config),
+        (wuffs_base__status(*)(void*,
+                               wuffs_base__image_config*,
+                               wuffs_base__io_buffer*))(
+            &wuffs_gif__decoder__decode_image_config),
+        (wuffs_base__rect_ie_u32(*)(const void*))(
+            &wuffs_gif__decoder__frame_dirty_rect),
+        (uint64_t(*)(const void*))(&wuffs_gif__decoder__metadata_chunk_length),
+        (uint32_t(*)(const void*))(&wuffs_gif__decoder__metadata_fourcc),
+        (uint32_t(*)(const void*))(&wuffs_gif__decoder__num_animation_loops),
+        (uint64_t(*)(const void*))(
+            &wuffs_gif__decoder__num_decoded_frame_configs),
+        (uint64_t(*)(const void*))(&wuffs_gif__decoder__num_decoded_frames),
+        (wuffs_base__status(*)(void*, uint64_t, uint64_t))(
+            &wuffs_gif__decoder__restart_frame),
+        (wuffs_base__empty_struct(*)(void*, uint32_t, bool))(
+            &wuffs_gif__decoder__set_report_metadata),
+        (wuffs_base__range_ii_u64(*)(const void*))(
+            &wuffs_gif__decoder__workbuf_len),
+};
+
+// ---------------- Initializer Implementations
+
+wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT  //
+wuffs_gif__config_decoder__initialize(wuffs_gif__config_decoder* self,
+                                      size_t sizeof_star_self,
+                                      uint64_t wuffs_version,
+                                      uint32_t initialize_flags) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (sizeof(*self) != sizeof_star_self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_sizeof_receiver);
+  }
+  if (((wuffs_version >> 32) != WUFFS_VERSION_MAJOR) ||
+      (((wuffs_version >> 16) & 0xFFFF) > WUFFS_VERSION_MINOR)) {
+    return wuffs_base__make_status(wuffs_base__error__bad_wuffs_version);
+  }
+
+  if ((initialize_flags & WUFFS_INITIALIZE__ALREADY_ZEROED) != 0) {
+// The whole point of this if-check is to detect an uninitialized *self.
+// We disable the warning on GCC. Clang-5.0 does not have this warning.
+#if !defined(__clang__) && defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+    if (self->private_impl.magic != 0) {
+      return wuffs_base__make_status(
+          wuffs_base__error__initialize_falsely_claimed_already_zeroed);
+    }
+#if !defined(__clang__) && defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+  } else {
+    if ((initialize_flags &
+         WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED) == 0) {
+      memset(self, 0, sizeof(*self));
+      initialize_flags |= WUFFS_INITIALIZE__ALREADY_ZEROED;
+    } else {
+      memset(&(self->private_impl), 0, sizeof(self->private_impl));
+    }
+  }
+
+  self->private_impl.magic = WUFFS_BASE__MAGIC;
+  self->private_impl.vtable_for__wuffs_base__image_decoder.vtable_name =
+      wuffs_base__image_decoder__vtable_name;
+  self->private_impl.vtable_for__wuffs_base__image_decoder.function_pointers =
+      (const void*)(&wuffs_gif__config_decoder__func_ptrs_for__wuffs_base__image_decoder);
+  return wuffs_base__make_status(NULL);
+}
+
+size_t  //
+sizeof__wuffs_gif__config_decoder() {
+  return sizeof(wuffs_gif__config_decoder);
+}
+
+wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT  //
+wuffs_gif__decoder__initialize(wuffs_gif__decoder* self,
+                               size_t sizeof_star_self,
+                               uint64_t wuffs_version,
+                               uint32_t initialize_flags) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (sizeof(*self) != sizeof_star_self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_sizeof_receiver);
+  }
+  if (((wuffs_version >> 32) != WUFFS_VERSION_MAJOR) ||
+      (((wuffs_version >> 16) & 0xFFFF) > WUFFS_VERSION_MINOR)) {
+    return wuffs_base__make_status(wuffs_base__error__bad_wuffs_version);
+  }
+
+  if ((initialize_flags & WUFFS_INITIALIZE__ALREADY_ZEROED) != 0) {
+// The whole point of this if-check is to detect an uninitialized *self.
+// We disable the warning on GCC. Clang-5.0 does not have this warning.
+#if !defined(__clang__) && defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+    if (self->private_impl.magic != 0) {
+      return wuffs_base__make_status(
+          wuffs_base__error__initialize_falsely_claimed_already_zeroed);
+    }
+#if !defined(__clang__) && defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+  } else {
+    if ((initialize_flags &
+         WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED) == 0) {
+      memset(self, 0, sizeof(*self));
+      initialize_flags |= WUFFS_INITIALIZE__ALREADY_ZEROED;
+    } else {
+      memset(&(self->private_impl), 0, sizeof(self->private_impl));
+    }
+  }
+
+  {
+    wuffs_base__status z = wuffs_lzw__decoder__initialize(
+        &self->private_data.f_lzw, sizeof(self->private_data.f_lzw),
+        WUFFS_VERSION, initialize_flags);
+    if (z.repr) {
+      return z;
+    }
+  }
+  self->private_impl.magic = WUFFS_BASE__MAGIC;
+  self->private_impl.vtable_for__wuffs_base__image_decoder.vtable_name =
+      wuffs_base__image_decoder__vtable_name;
+  self->private_impl.vtable_for__wuffs_base__image_decoder.function_pointers =
+      (const void*)(&wuffs_gif__decoder__func_ptrs_for__wuffs_base__image_decoder);
+  return wuffs_base__make_status(NULL);
+}
+
+size_t  //
+sizeof__wuffs_gif__decoder() {
+  return sizeof(wuffs_gif__decoder);
+}
+
+wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT  //
+wuffs_gif__encoder__initialize(wuffs_gif__encoder* self,
+                               size_t sizeof_star_self,
+                               uint64_t wuffs_version,
+                               uint32_t initialize_flags) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (sizeof(*self) != sizeof_star_self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_sizeof_receiver);
+  }
+  if (((wuffs_version >> 32) != WUFFS_VERSION_MAJOR) ||
+      (((wuffs_version >> 16) & 0xFFFF) > WUFFS_VERSION_MINOR)) {
+    return wuffs_base__make_status(wuffs_base__error__bad_wuffs_version);
+  }
+
+  if ((initialize_flags & WUFFS_INITIALIZE__ALREADY_ZEROED) != 0) {
+// The whole point of this if-check is to detect an uninitialized *self.
+// We disable the warning on GCC. Clang-5.0 does not have this warning.
+#if !defined(__clang__) && defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+    if (self->private_impl.magic != 0) {
+      return wuffs_base__make_status(
+          wuffs_base__error__initialize_falsely_claimed_already_zeroed);
+    }
+#if !defined(__clang__) && defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+  } else {
+    if ((initialize_flags &
+         WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED) == 0) {
+      memset(self, 0, sizeof(*self));
+      initialize_flags |= WUFFS_INITIALIZE__ALREADY_ZEROED;
+    } else {
+      memset(&(self->private_impl), 0, sizeof(self->private_impl));
+    }
+  }
+
+  {
+    wuffs_base__status z = wuffs_lzw__encoder__initialize(
+        &self->private_data.f_lzw, sizeof(self->private_data.f_lzw),
+        WUFFS_VERSION, initialize_flags);
+    if (z.repr) {
+      return z;
+    }
+  }
+  self->private_impl.magic = WUFFS_BASE__MAGIC;
+  return wuffs_base__make_status(NULL);
+}
+
+size_t  //
+sizeof__wuffs_gif__encoder() {
+  return sizeof(wuffs_gif__encoder);
+}
+
+// ---------------- Function Implementations
+
+// -------- func gif.config_decoder.set_quirk_enabled
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_gif__config_decoder__set_quirk_enabled(wuffs_gif__config_decoder* self,
+                                             uint32_t a_quirk,
+                                             bool a_enabled) {
+  if (!self) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_empty_struct();
+  }
+
+  if (self->private_impl.f_call_sequence == 0) {
+    if (a_quirk == 1041635328) {
+      self->private_impl.f_quirk_enabled_delay_num_decoded_frames = a_enabled;
+    } else if (a_quirk == 1041635329) {
+      self->private_impl
+          .f_quirk_enabled_first_frame_local_palette_means_black_background =
+          a_enabled;
+    } else if (a_quirk == 1041635330) {
+      self->private_impl.f_quirk_enabled_honor_background_color = a_enabled;
+    } else if (a_quirk == 1041635331) {
+      self->private_impl.f_quirk_enabled_ignore_too_much_pixel_data = a_enabled;
+    } else if (a_quirk == 1041635332) {
+      self->private_impl.f_quirk_enabled_image_bounds_are_strict = a_enabled;
+    } else if (a_quirk == 1041635333) {
+      self->private_impl.f_quirk_enabled_reject_empty_frame = a_enabled;
+    } else if (a_quirk == 1041635334) {
+      self->private_impl.f_quirk_enabled_reject_empty_palette = a_enabled;
+    }
+  }
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func gif.config_decoder.decode_image_config
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_gif__config_decoder__decode_image_config(wuffs_gif__config_decoder* self,
+                                               wuffs_base__image_config* a_dst,
+                                               wuffs_base__io_buffer* a_src) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_status(
+        (self->private_impl.magic == WUFFS_BASE__DISABLED)
+            ? wuffs_base__error__disabled_by_previous_error
+            : wuffs_base__error__initialize_not_called);
+  }
+  if (!a_src) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+  }
+  if ((self->private_impl.active_coroutine != 0) &&
+      (self->private_impl.active_coroutine != 1)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(
+        wuffs_base__error__interleaved_coroutine_calls);
+  }
+  self->private_impl.active_coroutine = 0;
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  bool v_ffio = false;
+
+  uint32_t coro_susp_point = self->private_impl.p_decode_image_config[0];
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    if (self->private_impl.f_call_sequence == 0) {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+      status = wuffs_gif__config_decoder__decode_header(self, a_src);
+      if (status.repr) {
+        goto suspend;
+      }
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+      status = wuffs_gif__config_decoder__decode_lsd(self, a_src);
+      if (status.repr) {
+        goto suspend;
+      }
+    } else if (self->private_impl.f_call_sequence != 2) {
+      status = wuffs_base__make_status(wuffs_base__error__bad_call_sequence);
+      goto exit;
+    }
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+    status = wuffs_gif__config_decoder__decode_up_to_id_part1(self, a_src);
+    if (status.repr) {
+      goto suspend;
+    }
+    v_ffio = !self->private_impl.f_gc_has_transparent_index;
+    if (!self->private_impl.f_quirk_enabled_honor_background_color) {
+      v_ffio =
+          (v_ffio && (self->private_impl.f_frame_rect_x0 == 0) &&
+           (self->private_impl.f_frame_rect_y0 == 0) &&
+           (self->private_impl.f_frame_rect_x1 == self->private_impl.f_width) &&
+           (self->private_impl.f_frame_rect_y1 == self->private_impl.f_height));
+    } else if (v_ffio) {
+      self->private_impl.f_black_color_u32_argb_premul = 4278190080;
+    }
+    if (self->private_impl.f_background_color_u32_argb_premul == 77) {
+      self->private_impl.f_background_color_u32_argb_premul =
+          self->private_impl.f_black_color_u32_argb_premul;
+    }
+    if (a_dst != NULL) {
+      wuffs_base__image_config__set(
+          a_dst, 1191444488, 0, self->private_impl.f_width,
+          self->private_impl.f_height,
+          self->private_impl.f_frame_config_io_position, v_ffio);
+    }
+    self->private_impl.f_call_sequence = 3;
+
+    goto ok;
+  ok:
+    self->private_impl.p_decode_image_config[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+suspend:
+  self->private_impl.p_decode_image_config[0] =
+      wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_impl.active_coroutine =
+      wuffs_base__status__is_suspension(&status) ? 1 : 0;
+
+  goto exit;
+exit:
+  if (wuffs_base__status__is_error(&status)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+  }
+  return status;
+}
+
+// -------- func gif.config_decoder.set_report_metadata
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_gif__config_decoder__set_report_metadata(wuffs_gif__config_decoder* self,
+                                               uint32_t a_fourcc,
+                                               bool a_report) {
+  if (!self) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_empty_struct();
+  }
+
+  if (a_fourcc == 1229144912) {
+    self->private_impl.f_report_metadata_iccp = a_report;
+  } else if (a_fourcc == 1481461792) {
+    self->private_impl.f_report_metadata_xmp = a_report;
+  }
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func gif.config_decoder.ack_metadata_chunk
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_gif__config_decoder__ack_metadata_chunk(wuffs_gif__config_decoder* self,
+                                              wuffs_base__io_buffer* a_src) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_status(
+        (self->private_impl.magic == WUFFS_BASE__DISABLED)
+            ? wuffs_base__error__disabled_by_previous_error
+            : wuffs_base__error__initialize_not_called);
+  }
+  if (!a_src) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+  }
+  if ((self->private_impl.active_coroutine != 0) &&
+      (self->private_impl.active_coroutine != 2)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(
+        wuffs_base__error__interleaved_coroutine_calls);
+  }
+  self->private_impl.active_coroutine = 0;
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint8_t* iop_a_src = NULL;
+  uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_ack_metadata_chunk[0];
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    if (self->private_impl.f_call_sequence != 1) {
+      status = wuffs_base__make_status(wuffs_base__error__bad_call_sequence);
+      goto exit;
+    }
+    if (wuffs_base__u64__sat_add(a_src->meta.pos,
+                                 ((uint64_t)(iop_a_src - io0_a_src))) !=
+        self->private_impl.f_metadata_io_position) {
+      status = wuffs_base__make_status(wuffs_base__error__bad_i_o_position);
+      goto exit;
+    }
+    if (self->private_impl.f_metadata_chunk_length_value > 0) {
+      while (((uint64_t)(io2_a_src - iop_a_src)) <= 0) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(1);
+      }
+      self->private_impl.f_metadata_chunk_length_value =
+          ((uint64_t)(wuffs_base__load_u8be__no_bounds_check(iop_a_src)));
+      if (self->private_impl.f_metadata_chunk_length_value > 0) {
+        if (self->private_impl.f_metadata_fourcc_value == 1481461792) {
+          self->private_impl.f_metadata_chunk_length_value += 1;
+        } else {
+          (iop_a_src += 1, wuffs_base__make_empty_struct());
+        }
+        self->private_impl.f_metadata_io_position = wuffs_base__u64__sat_add(
+            wuffs_base__u64__sat_add(a_src->meta.pos,
+                                     ((uint64_t)(iop_a_src - io0_a_src))),
+            self->private_impl.f_metadata_chunk_length_value);
+        status = wuffs_base__make_status(wuffs_base__note__metadata_reported);
+        goto ok;
+      }
+      (iop_a_src += 1, wuffs_base__make_empty_struct());
+    }
+    self->private_impl.f_call_sequence = 2;
+    self->private_impl.f_metadata_fourcc_value = 0;
+    self->private_impl.f_metadata_io_position = 0;
+    status = wuffs_base__make_status(NULL);
+    goto ok;
+    goto ok;
+  ok:
+    self->private_impl.p_ack_metadata_chunk[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+suspend:
+  self->private_impl.p_ack_metadata_chunk[0] =
+      wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_impl.active_coroutine =
+      wuffs_base__status__is_suspension(&status) ? 2 : 0;
+
+  goto exit;
+exit:
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  if (wuffs_base__status__is_error(&status)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+  }
+  return status;
+}
+
+// -------- func gif.config_decoder.metadata_fourcc
+
+WUFFS_BASE__MAYBE_STATIC uint32_t  //
+wuffs_gif__config_decoder__metadata_fourcc(
+    const wuffs_gif__config_decoder* self) {
+  if (!self) {
+    return 0;
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return 0;
+  }
+
+  return self->private_impl.f_metadata_fourcc_value;
+}
+
+// -------- func gif.config_decoder.metadata_chunk_length
+
+WUFFS_BASE__MAYBE_STATIC uint64_t  //
+wuffs_gif__config_decoder__metadata_chunk_length(
+    const wuffs_gif__config_decoder* self) {
+  if (!self) {
+    return 0;
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return 0;
+  }
+
+  return self->private_impl.f_metadata_chunk_length_value;
+}
+
+// -------- func gif.config_decoder.num_animation_loops
+
+WUFFS_BASE__MAYBE_STATIC uint32_t  //
+wuffs_gif__config_decoder__num_animation_loops(
+    const wuffs_gif__config_decoder* self) {
+  if (!self) {
+    return 0;
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return 0;
+  }
+
+  if (self->private_impl.f_seen_num_loops) {
+    return self->private_impl.f_num_loops;
+  }
+  return 1;
+}
+
+// -------- func gif.config_decoder.num_decoded_frame_configs
+
+WUFFS_BASE__MAYBE_STATIC uint64_t  //
+wuffs_gif__config_decoder__num_decoded_frame_configs(
+    const wuffs_gif__config_decoder* self) {
+  if (!self) {
+    return 0;
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return 0;
+  }
+
+  return self->private_impl.f_num_decoded_frame_configs_value;
+}
+
+// -------- func gif.config_decoder.num_decoded_frames
+
+WUFFS_BASE__MAYBE_STATIC uint64_t  //
+wuffs_gif__config_decoder__num_decoded_frames(
+    const wuffs_gif__config_decoder* self) {
+  if (!self) {
+    return 0;
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return 0;
+  }
+
+  return self->private_impl.f_num_decoded_frames_value;
+}
+
+// -------- func gif.config_decoder.frame_dirty_rect
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__rect_ie_u32  //
+wuffs_gif__config_decoder__frame_dirty_rect(
+    const wuffs_gif__config_decoder* self) {
+  if (!self) {
+    return wuffs_base__utility__empty_rect_ie_u32();
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return wuffs_base__utility__empty_rect_ie_u32();
+  }
+
+  return wuffs_base__utility__empty_rect_ie_u32();
+}
+
+// -------- func gif.config_decoder.workbuf_len
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__range_ii_u64  //
+wuffs_gif__config_decoder__workbuf_len(const wuffs_gif__config_decoder* self) {
+  if (!self) {
+    return wuffs_base__utility__empty_range_ii_u64();
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return wuffs_base__utility__empty_range_ii_u64();
+  }
+
+  return wuffs_base__utility__empty_range_ii_u64();
+}
+
+// -------- func gif.config_decoder.restart_frame
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_gif__config_decoder__restart_frame(wuffs_gif__config_decoder* self,
+                                         uint64_t a_index,
+                                         uint64_t a_io_position) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_status(
+        (self->private_impl.magic == WUFFS_BASE__DISABLED)
+            ? wuffs_base__error__disabled_by_previous_error
+            : wuffs_base__error__initialize_not_called);
+  }
+
+  if (self->private_impl.f_call_sequence == 0) {
+    return wuffs_base__make_status(wuffs_base__error__bad_call_sequence);
+  }
+  self->private_impl.f_delayed_num_decoded_frames = false;
+  self->private_impl.f_end_of_data = false;
+  self->private_impl.f_restarted = true;
+  self->private_impl.f_frame_config_io_position = a_io_position;
+  self->private_impl.f_num_decoded_frame_configs_value = a_index;
+  self->private_impl.f_num_decoded_frames_value = a_index;
+  wuffs_gif__config_decoder__reset_gc(self);
+  return wuffs_base__make_status(NULL);
+}
+
+// -------- func gif.config_decoder.decode_frame_index
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_gif__config_decoder__decode_frame_index(wuffs_gif__config_decoder* self,
+                                              wuffs_base__io_buffer* a_dst,
+                                              wuffs_base__io_buffer* a_src) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_status(
+        (self->private_impl.magic == WUFFS_BASE__DISABLED)
+            ? wuffs_base__error__disabled_by_previous_error
+            : wuffs_base__error__initialize_not_called);
+  }
+  if (!a_dst || !a_src) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+  }
+  if ((self->private_impl.active_coroutine != 0) &&
+      (self->private_impl.active_coroutine != 3)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(
+        wuffs_base__error__interleaved_coroutine_calls);
+  }
+  self->private_impl.active_coroutine = 0;
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  wuffs_base__status v_status = wuffs_base__make_status(NULL);
+  uint64_t v_entry = 0;
+  uint64_t v_x = 0;
+  uint8_t v_flags = 0;
+  uint64_t v_duration = 0;
+
+  uint8_t* iop_a_dst = NULL;
+  uint8_t* io0_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_dst) {
+    io0_a_dst = a_dst->data.ptr;
+    io1_a_dst = io0_a_dst + a_dst->meta.wi;
+    iop_a_dst = io1_a_dst;
+    io2_a_dst = io0_a_dst + a_dst->data.len;
+    if (a_dst->meta.closed) {
+      io2_a_dst = iop_a_dst;
+    }
+  }
+  uint8_t* iop_a_src = NULL;
+  uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_decode_frame_index[0];
+  if (coro_susp_point) {
+    v_entry = self->private_data.s_decode_frame_index[0].v_entry;
+    v_flags = self->private_data.s_decode_frame_index[0].v_flags;
+    v_duration = self->private_data.s_decode_frame_index[0].v_duration;
+  }
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+  label__0__continue:;
+    while (true) {
+      {
+        if (a_src) {
+          a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+        }
+        wuffs_base__status t_0 =
+            wuffs_gif__config_decoder__decode_frame_config(self, NULL, a_src);
+        if (a_src) {
+          iop_a_src = a_src->data.ptr + a_src->meta.ri;
+        }
+        v_status = t_0;
+      }
+      if (v_status.repr ==
+          wuffs_base__make_status(wuffs_base__suspension__short_read).repr) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(1);
+        goto label__0__continue;
+      } else if (v_status.repr ==
+                 wuffs_base__make_status(wuffs_base__note__end_of_data).repr) {
+        goto label__0__break;
+      } else if (!wuffs_base__status__is_ok(&v_status)) {
+        status = v_status;
+        if (wuffs_base__status__is_error(&status)) {
+          goto exit;
+        } else if (wuffs_base__status__is_suspension(&status)) {
+          status = wuffs_base__make_status(
+              wuffs_base__error__cannot_return_a_suspension);
+          goto exit;
+        }
+        goto ok;
+      }
+      while (((uint64_t)(io2_a_src - iop_a_src)) <= 0) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(2);
+      }
+      v_flags = 0;
+      if ((wuffs_base__load_u8be__no_bounds_check(iop_a_src) & 128) != 0) {
+        v_flags = 1;
+      }
+      if (!self->private_impl.f_gc_has_transparent_index) {
+        v_flags |= 2;
+      }
+      v_x = ((uint64_t)(wuffs_base__u32__min(self->private_impl.f_frame_rect_x0,
+                                             self->private_impl.f_width)));
+      v_entry = wuffs_base__u64__min(v_x, 65535);
+      v_x = ((uint64_t)(wuffs_base__u32__min(self->private_impl.f_frame_rect_y0,
+                                             self->private_impl.f_height)));
+      v_x = wuffs_base__u64__min(v_x, 65535);
+      v_entry |= (v_x << 16);
+      v_x = ((uint64_t)(wuffs_base__u32__min(self->private_impl.f_frame_rect_x1,
+                                             self->private_impl.f_width)));
+      v_x = wuffs_base__u64__min(v_x, 65535);
+      v_entry |= (v_x << 32);
+      v_x = ((uint64_t)(wuffs_base__u32__min(self->private_impl.f_frame_rect_y1,
+                                             self->private_impl.f_height)));
+      v_x = wuffs_base__u64__min(v_x, 65535);
+      v_entry |= (v_x << 48);
+      v_duration = (self->private_impl.f_gc_duration / 7056000);
+      while (((uint64_t)(io2_a_dst - iop_a_dst)) < 20) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(3);
+      }
+      (wuffs_base__store_u64le__no_bounds_check(
+           iop_a_dst, self->private_impl.f_frame_config_io_position),
+       iop_a_dst += 8, wuffs_base__make_empty_struct());
+      (wuffs_base__store_u64le__no_bounds_check(iop_a_dst, v_entry),
+       iop_a_dst += 8, wuffs_base__make_empty_struct());
+      (wuffs_base__store_u32le__no_bounds_check(
+           iop_a_dst, (((uint32_t)(v_duration)) |
+                       (((uint32_t)(self->private_impl.f_gc_disposal)) << 16) |
+                       (((uint32_t)(v_flags)) << 24))),
+       iop_a_dst += 4, wuffs_base__make_empty_struct());
+    }
+  label__0__break:;
+
+    goto ok;
+  ok:
+    self->private_impl.p_decode_frame_index[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+suspend:
+  self->private_impl.p_decode_frame_index[0] =
+      wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_impl.active_coroutine =
+      wuffs_base__status__is_suspension(&status) ? 3 : 0;
+  self->private_data.s_decode_frame_index[0].v_entry = v_entry;
+  self->private_data.s_decode_frame_index[0].v_flags = v_flags;
+  self->private_data.s_decode_frame_index[0].v_duration = v_duration;
+
+  goto exit;
+exit:
+  if (a_dst) {
+    a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+  }
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  if (wuffs_base__status__is_error(&status)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+  }
+  return status;
+}
+
+// -------- func gif.config_decoder.decode_frame_config
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_gif__config_decoder__decode_frame_config(wuffs_gif__config_decoder* self,
+                                               wuffs_base__frame_config* a_dst,
+                                               wuffs_base__io_buffer* a_src) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_status(
+        (self->private_impl.magic == WUFFS_BASE__DISABLED)
+            ? wuffs_base__error__disabled_by_previous_error
+            : wuffs_base__error__initialize_not_called);
+  }
+  if (!a_src) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+  }
+  if ((self->private_impl.active_coroutine != 0) &&
+      (self->private_impl.active_coroutine != 4)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(
+        wuffs_base__error__interleaved_coroutine_calls);
+  }
+  self->private_impl.active_coroutine = 0;
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint32_t v_background_color = 0;
+  uint8_t v_flags = 0;
+
+  uint8_t* iop_a_src = NULL;
+  uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_decode_frame_config[0];
+  if (coro_susp_point) {
+    v_background_color =
+        self->private_data.s_decode_frame_config[0].v_background_color;
+  }
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    self->private_impl.f_ignore_metadata = true;
+    if (!self->private_impl.f_end_of_data) {
+      if (self->private_impl.f_call_sequence == 0) {
+        if (a_src) {
+          a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+        }
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+        status =
+            wuffs_gif__config_decoder__decode_image_config(self, NULL, a_src);
+        if (a_src) {
+          iop_a_src = a_src->data.ptr + a_src->meta.ri;
+        }
+        if (status.repr) {
+          goto suspend;
+        }
+      } else if (self->private_impl.f_call_sequence != 3) {
+        if (self->private_impl.f_call_sequence == 4) {
+          if (a_src) {
+            a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+          }
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+          status = wuffs_gif__config_decoder__skip_frame(self, a_src);
+          if (a_src) {
+            iop_a_src = a_src->data.ptr + a_src->meta.ri;
+          }
+          if (status.repr) {
+            goto suspend;
+          }
+        }
+        if (a_src) {
+          a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+        }
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+        status = wuffs_gif__config_decoder__decode_up_to_id_part1(self, a_src);
+        if (a_src) {
+          iop_a_src = a_src->data.ptr + a_src->meta.ri;
+        }
+        if (status.repr) {
+          goto suspend;
+        }
+      }
+    }
+    if (self->private_impl.f_end_of_data) {
+      status = wuffs_base__make_status(wuffs_base__note__end_of_data);
+      goto ok;
+    }
+    v_background_color = self->private_impl.f_black_color_u32_argb_premul;
+    if (!self->private_impl.f_gc_has_transparent_index) {
+      v_background_color =
+          self->private_impl.f_background_color_u32_argb_premul;
+      if (self->private_impl
+              .f_quirk_enabled_first_frame_local_palette_means_black_background &&
+          (self->private_impl.f_num_decoded_frame_configs_value == 0)) {
+        while (((uint64_t)(io2_a_src - iop_a_src)) <= 0) {
+          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(4);
+        }
+        v_flags = wuffs_base__load_u8be__no_bounds_check(iop_a_src);
+        if ((v_flags & 128) != 0) {
+          v_background_color = self->private_impl.f_black_color_u32_argb_premul;
+        }
+      }
+    }
+    if (a_dst != NULL) {
+      wuffs_base__frame_config__update(
+          a_dst,
+          wuffs_base__utility__make_rect_ie_u32(
+              wuffs_base__u32__min(self->private_impl.f_frame_rect_x0,
+                                   self->private_impl.f_width),
+              wuffs_base__u32__min(self->private_impl.f_frame_rect_y0,
+                                   self->private_impl.f_height),
+              wuffs_base__u32__min(self->private_impl.f_frame_rect_x1,
+                                   self->private_impl.f_width),
+              wuffs_base__u32__min(self->private_impl.f_frame_rect_y1,
+                                   self->private_impl.f_height)),
+          ((wuffs_base__flicks)(self->private_impl.f_gc_duration)),
+          self->private_impl.f_num_decoded_frame_configs_value,
+          self->private_impl.f_frame_config_io_position,
+          self->private_impl.f_gc_disposal,
+          !self->private_impl.f_gc_has_transparent_index, false,
+          v_background_color);
+    }
+    wuffs_base__u64__sat_add_indirect(
+        &self->private_impl.f_num_decoded_frame_configs_value, 1);
+    self->private_impl.f_call_sequence = 4;
+
+    goto ok;
+  ok:
+    self->private_impl.p_decode_frame_config[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+suspend:
+  self->private_impl.p_decode_frame_config[0] =
+      wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_impl.active_coroutine =
+      wuffs_base__status__is_suspension(&status) ? 4 : 0;
+  self->private_data.s_decode_frame_config[0].v_background_color =
+      v_background_color;
+
+  goto exit;
+exit:
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  if (wuffs_base__status__is_error(&status)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+  }
+  return status;
+}
+
+// -------- func gif.config_decoder.skip_frame
+
+static wuffs_base__status  //
+wuffs_gif__config_decoder__skip_frame(wuffs_gif__config_decoder* self,
+                                      wuffs_base__io_buffer* a_src) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint8_t v_flags = 0;
+  uint8_t v_lw = 0;
+
+  uint8_t* iop_a_src = NULL;
+  uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_skip_frame[0];
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        goto suspend;
+      }
+      uint8_t t_0 = *iop_a_src++;
+      v_flags = t_0;
+    }
+    if ((v_flags & 128) != 0) {
+      self->private_data.s_skip_frame[0].scratch =
+          (((uint32_t)(3)) << (1 + (v_flags & 7)));
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+      if (self->private_data.s_skip_frame[0].scratch >
+          ((uint64_t)(io2_a_src - iop_a_src))) {
+        self->private_data.s_skip_frame[0].scratch -=
+            ((uint64_t)(io2_a_src - iop_a_src));
+        iop_a_src = io2_a_src;
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        goto suspend;
+      }
+      iop_a_src += self->private_data.s_skip_frame[0].scratch;
+    }
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        goto suspend;
+      }
+      uint8_t t_1 = *iop_a_src++;
+      v_lw = t_1;
+    }
+    if (v_lw > 8) {
+      status = wuffs_base__make_status(wuffs_gif__error__bad_literal_width);
+      goto exit;
+    }
+    if (a_src) {
+      a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+    }
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+    status = wuffs_gif__config_decoder__skip_blocks(self, a_src);
+    if (a_src) {
+      iop_a_src = a_src->data.ptr + a_src->meta.ri;
+    }
+    if (status.repr) {
+      goto suspend;
+    }
+    if (self->private_impl.f_quirk_enabled_delay_num_decoded_frames) {
+      self->private_impl.f_delayed_num_decoded_frames = true;
+    } else {
+      wuffs_base__u64__sat_add_indirect(
+          &self->private_impl.f_num_decoded_frames_value, 1);
+    }
+    wuffs_gif__config_decoder__reset_gc(self);
+
+    goto ok;
+  ok:
+    self->private_impl.p_skip_frame[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+suspend:
+  self->private_impl.p_skip_frame[0] =
+      wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+
+  goto exit;
+exit:
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  return status;
+}
+
+// -------- func gif.config_decoder.decode_frame
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_gif__config_decoder__decode_frame(
+    wuffs_gif__config_decoder* self,
+    wuffs_base__pixel_buffer* a_dst,
+    wuffs_base__io_buffer* a_src,
+    wuffs_base__pixel_blend a_blend,
+    wuffs_base__slice_u8 a_workbuf,
+    wuffs_base__decode_frame_options* a_opts) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_status(
+        (self->private_impl.magic == WUFFS_BASE__DISABLED)
+            ? wuffs_base__error__disabled_by_previous_error
+            : wuffs_base__error__initialize_not_called);
+  }
+  if (!a_dst || !a_src) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+  }
+  if ((self->private_impl.active_coroutine != 0) &&
+      (self->private_impl.active_coroutine != 5)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(
+        wuffs_base__error__interleaved_coroutine_calls);
+  }
+  self->private_impl.active_coroutine = 0;
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  status = wuffs_base__make_status(wuffs_base__error__unsupported_method);
+  goto exit;
+  goto ok;
+ok:
+  goto exit;
+exit:
+  if (wuffs_base__status__is_error(&status)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+  }
+  return status;
+}
+
+// -------- func gif.config_decoder.reset_gc
+
+static wuffs_base__empty_struct  //
+wuffs_gif__config_decoder__reset_gc(wuffs_gif__config_decoder* self) {
+  self->private_impl.f_call_sequence = 5;
+  self->private_impl.f_gc_has_transparent_index = false;
+  self->private_impl.f_gc_transparent_index = 0;
+  self->private_impl.f_gc_disposal = 0;
+  self->private_impl.f_gc_duration = 0;
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func gif.config_decoder.decode_up_to_id_part1
+
+static wuffs_base__status  //
+wuffs_gif__config_decoder__decode_up_to_id_part1(
+    wuffs_gif__config_decoder* self,
+    wuffs_base__io_buffer* a_src) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint8_t v_block_type = 0;
+
+  uint8_t* iop_a_src = NULL;
+  uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_decode_up_to_id_part1[0];
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    if (!self->private_impl.f_restarted) {
+      if (self->private_impl.f_call_sequence != 2) {
+        self->private_impl.f_frame_config_io_position =
+            wuffs_base__u64__sat_add(a_src->meta.pos,
+                                     ((uint64_t)(iop_a_src - io0_a_src)));
+      }
+    } else if (self->private_impl.f_frame_config_io_position !=
+               wuffs_base__u64__sat_add(a_src->meta.pos,
+                                        ((uint64_t)(iop_a_src - io0_a_src)))) {
+      status = wuffs_base__make_status(wuffs_base__error__bad_restart);
+      goto exit;
+    } else {
+      self->private_impl.f_restarted = false;
+    }
+    while (true) {
+      {
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+        if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+          goto suspend;
+        }
+        uint8_t t_0 = *iop_a_src++;
+        v_block_type = t_0;
+      }
+      if (v_block_type == 33) {
+        if (a_src) {
+          a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+        }
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+        status = wuffs_gif__config_decoder__decode_extension(self, a_src);
+        if (a_src) {
+          iop_a_src = a_src->data.ptr + a_src->meta.ri;
+        }
+        if (status.repr) {
+          goto suspend;
+        }
+      } else if (v_block_type == 44) {
+        if (self->private_impl.f_delayed_num_decoded_frames) {
+          self->private_impl.f_delayed_num_decoded_frames = false;
+          wuffs_base__u64__sat_add_indirect(
+              &self->private_impl.f_num_decoded_frames_value, 1);
+        }
+        if (a_src) {
+          a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+        }
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+        status = wuffs_gif__config_decoder__decode_id_part0(self, a_src);
+        if (a_src) {
+          iop_a_src = a_src->data.ptr + a_src->meta.ri;
+        }
+        if (status.repr) {
+          goto suspend;
+        }
+        goto label__0__break;
+      } else if (v_block_type == 59) {
+        if (self->private_impl.f_delayed_num_decoded_frames) {
+          self->private_impl.f_delayed_num_decoded_frames = false;
+          wuffs_base__u64__sat_add_indirect(
+              &self->private_impl.f_num_decoded_frames_value, 1);
+        }
+        self->private_impl.f_end_of_data = true;
+        goto label__0__break;
+      } else {
+        status = wuffs_base__make_status(wuffs_gif__error__bad_block);
+        goto exit;
+      }
+    }
+  label__0__break:;
+
+    goto ok;
+  ok:
+    self->private_impl.p_decode_up_to_id_part1[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+suspend:
+  self->private_impl.p_decode_up_to_id_part1[0] =
+      wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+
+  goto exit;
+exit:
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  return status;
+}
+
+// -------- func gif.config_decoder.decode_header
+
+static wuffs_base__status  //
+wuffs_gif__config_decoder__decode_header(wuffs_gif__config_decoder* self,
+                                         wuffs_base__io_buffer* a_src) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint8_t v_c[6] = {0};
+  uint32_t v_i = 0;
+
+  uint8_t* iop_a_src = NULL;
+  uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_decode_header[0];
+  if (coro_susp_point) {
+    memcpy(v_c, self->private_data.s_decode_header[0].v_c, sizeof(v_c));
+    v_i = self->private_data.s_decode_header[0].v_i;
+  }
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    while (v_i < 6) {
+      {
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+        if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+          goto suspend;
+        }
+        uint8_t t_0 = *iop_a_src++;
+        v_c[v_i] = t_0;
+      }
+      v_i += 1;
+    }
+    if ((v_c[0] != 71) || (v_c[1] != 73) || (v_c[2] != 70) || (v_c[3] != 56) ||
+        ((v_c[4] != 55) && (v_c[4] != 57)) || (v_c[5] != 97)) {
+      status = wuffs_base__make_status(wuffs_gif__error__bad_header);
+      goto exit;
+    }
+
+    goto ok;
+  ok:
+    self->private_impl.p_decode_header[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+suspend:
+  self->private_impl.p_decode_header[0] =
+      wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  memcpy(self->private_data.s_decode_header[0].v_c, v_c, sizeof(v_c));
+  self->private_data.s_decode_header[0].v_i = v_i;
+
+  goto exit;
+exit:
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  return status;
+}
+
+// -------- func gif.config_decoder.decode_lsd
+
+static wuffs_base__status  //
+wuffs_gif__config_decoder__decode_lsd(wuffs_gif__config_decoder* self,
+                                      wuffs_base__io_buffer* a_src) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint8_t v_flags = 0;
+  uint8_t v_background_color_index = 0;
+  uint32_t v_num_palette_entries = 0;
+  uint32_t v_i = 0;
+  uint32_t v_j = 0;
+  uint32_t v_argb = 0;
+
+  uint8_t* iop_a_src = NULL;
+  uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_decode_lsd[0];
+  if (coro_susp_point) {
+    v_flags = self->private_data.s_decode_lsd[0].v_flags;
+    v_background_color_index =
+        self->private_data.s_decode_lsd[0].v_background_color_index;
+    v_num_palette_entries =
+        self->private_data.s_decode_lsd[0].v_num_palette_entries;
+    v_i = self->private_data.s_decode_lsd[0].v_i;
+  }
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+      uint32_t t_0;
+      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
+        t_0 = ((uint32_t)(wuffs_base__load_u16le__no_bounds_check(iop_a_src)));
+        iop_a_src += 2;
+      } else {
+        self->private_data.s_decode_lsd[0].scratch = 0;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+        while (true) {
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status =
+                wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint64_t* scratch = &self->private_data.s_decode_lsd[0].scratch;
+          uint32_t num_bits_0 = ((uint32_t)(*scratch >> 56));
+          *scratch <<= 8;
+          *scratch >>= 8;
+          *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_0;
+          if (num_bits_0 == 8) {
+            t_0 = ((uint32_t)(*scratch));
+            break;
+          }
+          num_bits_0 += 8;
+          *scratch |= ((uint64_t)(num_bits_0)) << 56;
+        }
+      }
+      self->private_impl.f_width = t_0;
+    }
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+      uint32_t t_1;
+      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
+        t_1 = ((uint32_t)(wuffs_base__load_u16le__no_bounds_check(iop_a_src)));
+        iop_a_src += 2;
+      } else {
+        self->private_data.s_decode_lsd[0].scratch = 0;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+        while (true) {
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status =
+                wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint64_t* scratch = &self->private_data.s_decode_lsd[0].scratch;
+          uint32_t num_bits_1 = ((uint32_t)(*scratch >> 56));
+          *scratch <<= 8;
+          *scratch >>= 8;
+          *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_1;
+          if (num_bits_1 == 8) {
+            t_1 = ((uint32_t)(*scratch));
+            break;
+          }
+          num_bits_1 += 8;
+          *scratch |= ((uint64_t)(num_bits_1)) << 56;
+        }
+      }
+      self->private_impl.f_height = t_1;
+    }
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(5);
+      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        goto suspend;
+      }
+      uint8_t t_2 = *iop_a_src++;
+      v_flags = t_2;
+    }
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(6);
+      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        goto suspend;
+      }
+      uint8_t t_3 = *iop_a_src++;
+      v_background_color_index = t_3;
+    }
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(7);
+    if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+      status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+      goto suspend;
+    }
+    iop_a_src++;
+    v_i = 0;
+    self->private_impl.f_has_global_palette = ((v_flags & 128) != 0);
+    if (self->private_impl.f_has_global_palette) {
+      v_num_palette_entries = (((uint32_t)(1)) << (1 + (v_flags & 7)));
+      while (v_i < v_num_palette_entries) {
+        {
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(8);
+          uint32_t t_4;
+          if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 3)) {
+            t_4 = ((uint32_t)(
+                wuffs_base__load_u24be__no_bounds_check(iop_a_src)));
+            iop_a_src += 3;
+          } else {
+            self->private_data.s_decode_lsd[0].scratch = 0;
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(9);
+            while (true) {
+              if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+                status =
+                    wuffs_base__make_status(wuffs_base__suspension__short_read);
+                goto suspend;
+              }
+              uint64_t* scratch = &self->private_data.s_decode_lsd[0].scratch;
+              uint32_t num_bits_4 = ((uint32_t)(*scratch & 0xFF));
+              *scratch >>= 8;
+              *scratch <<= 8;
+              *scratch |= ((uint64_t)(*iop_a_src++)) << (56 - num_bits_4);
+              if (num_bits_4 == 16) {
+                t_4 = ((uint32_t)(*scratch >> 40));
+                break;
+              }
+              num_bits_4 += 8;
+              *scratch |= ((uint64_t)(num_bits_4));
+            }
+          }
+          v_argb = t_4;
+        }
+        v_argb |= 4278190080;
+        self->private_data.f_palettes[0][((4 * v_i) + 0)] =
+            ((uint8_t)(((v_argb >> 0) & 255)));
+        self->private_data.f_palettes[0][((4 * v_i) + 1)] =
+            ((uint8_t)(((v_argb >> 8) & 255)));
+        self->private_data.f_palettes[0][((4 * v_i) + 2)] =
+            ((uint8_t)(((v_argb >> 16) & 255)));
+        self->private_data.f_palettes[0][((4 * v_i) + 3)] =
+            ((uint8_t)(((v_argb >> 24) & 255)));
+        v_i += 1;
+      }
+      if (self->private_impl.f_quirk_enabled_honor_background_color) {
+        if ((v_background_color_index != 0) &&
+            (((uint32_t)(v_background_color_index)) < v_num_palette_entries)) {
+          v_j = (4 * ((uint32_t)(v_background_color_index)));
+          self->private_impl.f_background_color_u32_argb_premul =
+              ((((uint32_t)(self->private_data.f_palettes[0][(v_j + 0)]))
+                << 0) |
+               (((uint32_t)(self->private_data.f_palettes[0][(v_j + 1)]))
+                << 8) |
+               (((uint32_t)(self->private_data.f_palettes[0][(v_j + 2)]))
+                << 16) |
+               (((uint32_t)(self->private_data.f_palettes[0][(v_j + 3)]))
+                << 24));
+        } else {
+          self->private_impl.f_background_color_u32_argb_premul = 77;
+        }
+      }
+    }
+    while (v_i < 256) {
+      self->private_data.f_palettes[0][((4 * v_i) + 0)] = 0;
+      self->private_data.f_palettes[0][((4 * v_i) + 1)] = 0;
+      self->private_data.f_palettes[0][((4 * v_i) + 2)] = 0;
+      self->private_data.f_palettes[0][((4 * v_i) + 3)] = 255;
+      v_i += 1;
+    }
+
+    goto ok;
+  ok:
+    self->private_impl.p_decode_lsd[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+suspend:
+  self->private_impl.p_decode_lsd[0] =
+      wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_data.s_decode_lsd[0].v_flags = v_flags;
+  self->private_data.s_decode_lsd[0].v_background_color_index =
+      v_background_color_index;
+  self->private_data.s_decode_lsd[0].v_num_palette_entries =
+      v_num_palette_entries;
+  self->private_data.s_decode_lsd[0].v_i = v_i;
+
+  goto exit;
+exit:
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  return status;
+}
+
+// -------- func gif.config_decoder.decode_extension
+
+static wuffs_base__status  //
+wuffs_gif__config_decoder__decode_extension(wuffs_gif__config_decoder* self,
+                                            wuffs_base__io_buffer* a_src) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint8_t v_label = 0;
+
+  uint8_t* iop_a_src = NULL;
+  uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_decode_extension[0];
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        goto suspend;
+      }
+      uint8_t t_0 = *iop_a_src++;
+      v_label = t_0;
+    }
+    if (v_label == 249) {
+      if (a_src) {
+        a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+      }
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+      status = wuffs_gif__config_decoder__decode_gc(self, a_src);
+      if (a_src) {
+        iop_a_src = a_src->data.ptr + a_src->meta.ri;
+      }
+      if (status.repr) {
+        goto suspend;
+      }
+      status = wuffs_base__make_status(NULL);
+      goto ok;
+    } else if (v_label == 255) {
+      if (a_src) {
+        a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+      }
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+      status = wuffs_gif__config_decoder__decode_ae(self, a_src);
+      if (a_src) {
+        iop_a_src = a_src->data.ptr + a_src->meta.ri;
+      }
+      if (status.repr) {
+        goto suspend;
+      }
+      status = wuffs_base__make_status(NULL);
+      goto ok;
+    }
+    if (a_src) {
+      a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+    }
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+    status = wuffs_gif__config_decoder__skip_blocks(self, a_src);
+    if (a_src) {
+      iop_a_src = a_src->data.ptr + a_src->meta.ri;
+    }
+    if (status.repr) {
+      goto suspend;
+    }
+
+    goto ok;
+  ok:
+    self->private_impl.p_decode_extension[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+suspend:
+  self->private_impl.p_decode_extension[0] =
+      wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+
+  goto exit;
+exit:
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  return status;
+}
+
+// -------- func gif.config_decoder.skip_blocks
+
+static wuffs_base__status  //
+wuffs_gif__config_decoder__skip_blocks(wuffs_gif__config_decoder* self,
+                                       wuffs_base__io_buffer* a_src) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint8_t v_block_size = 0;
+
+  uint8_t* iop_a_src = NULL;
+  uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_skip_blocks[0];
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    while (true) {
+      {
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+        if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+          goto suspend;
+        }
+        uint8_t t_0 = *iop_a_src++;
+        v_block_size = t_0;
+      }
+      if (v_block_size == 0) {
+        status = wuffs_base__make_status(NULL);
+        goto ok;
+      }
+      self->private_data.s_skip_blocks[0].scratch = ((uint32_t)(v_block_size));
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+      if (self->private_data.s_skip_blocks[0].scratch >
+          ((uint64_t)(io2_a_src - iop_a_src))) {
+        self->private_data.s_skip_blocks[0].scratch -=
+            ((uint64_t)(io2_a_src - iop_a_src));
+        iop_a_src = io2_a_src;
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        goto suspend;
+      }
+      iop_a_src += self->private_data.s_skip_blocks[0].scratch;
+    }
+
+    goto ok;
+  ok:
+    self->private_impl.p_skip_blocks[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+suspend:
+  self->private_impl.p_skip_blocks[0] =
+      wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+
+  goto exit;
+exit:
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  return status;
+}
+
+// -------- func gif.config_decoder.decode_ae
+
+static wuffs_base__status  //
+wuffs_gif__config_decoder__decode_ae(wuffs_gif__config_decoder* self,
+                                     wuffs_base__io_buffer* a_src) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint8_t v_c = 0;
+  uint8_t v_block_size = 0;
+  bool v_is_animexts = false;
+  bool v_is_netscape = false;
+  bool v_is_iccp = false;
+  bool v_is_xmp = false;
+
+  uint8_t* iop_a_src = NULL;
+  uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_decode_ae[0];
+  if (coro_susp_point) {
+    v_block_size = self->private_data.s_decode_ae[0].v_block_size;
+    v_is_animexts = self->private_data.s_decode_ae[0].v_is_animexts;
+    v_is_netscape = self->private_data.s_decode_ae[0].v_is_netscape;
+    v_is_iccp = self->private_data.s_decode_ae[0].v_is_iccp;
+    v_is_xmp = self->private_data.s_decode_ae[0].v_is_xmp;
+  }
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    while (true) {
+      {
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+        if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+          goto suspend;
+        }
+        uint8_t t_0 = *iop_a_src++;
+        v_block_size = t_0;
+      }
+      if (v_block_size == 0) {
+        status = wuffs_base__make_status(NULL);
+        goto ok;
+      }
+      if (v_block_size != 11) {
+        self->private_data.s_decode_ae[0].scratch = ((uint32_t)(v_block_size));
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+        if (self->private_data.s_decode_ae[0].scratch >
+            ((uint64_t)(io2_a_src - iop_a_src))) {
+          self->private_data.s_decode_ae[0].scratch -=
+              ((uint64_t)(io2_a_src - iop_a_src));
+          iop_a_src = io2_a_src;
+          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+          goto suspend;
+        }
+        iop_a_src += self->private_data.s_decode_ae[0].scratch;
+        goto label__goto_done__break;
+      }
+      v_is_animexts = true;
+      v_is_netscape = true;
+      v_is_iccp = true;
+      v_is_xmp = true;
+      v_block_size = 0;
+      while (v_block_size < 11) {
+        {
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status =
+                wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint8_t t_1 = *iop_a_src++;
+          v_c = t_1;
+        }
+        v_is_animexts =
+            (v_is_animexts && (v_c == wuffs_gif__animexts1dot0[v_block_size]));
+        v_is_netscape =
+            (v_is_netscape && (v_c == wuffs_gif__netscape2dot0[v_block_size]));
+        v_is_iccp =
+            (v_is_iccp && (v_c == wuffs_gif__iccrgbg1012[v_block_size]));
+        v_is_xmp = (v_is_xmp && (v_c == wuffs_gif__xmpdataxmp[v_block_size]));
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wconversion"
+#endif
+        v_block_size += 1;
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+      }
+      if (v_is_animexts || v_is_netscape) {
+        {
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status =
+                wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint8_t t_2 = *iop_a_src++;
+          v_block_size = t_2;
+        }
+        if (v_block_size != 3) {
+          self->private_data.s_decode_ae[0].scratch =
+              ((uint32_t)(v_block_size));
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(5);
+          if (self->private_data.s_decode_ae[0].scratch >
+              ((uint64_t)(io2_a_src - iop_a_src))) {
+            self->private_data.s_decode_ae[0].scratch -=
+                ((uint64_t)(io2_a_src - iop_a_src));
+            iop_a_src = io2_a_src;
+            status =
+                wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          iop_a_src += self->private_data.s_decode_ae[0].scratch;
+          goto label__goto_done__break;
+        }
+        {
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(6);
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status =
+                wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint8_t t_3 = *iop_a_src++;
+          v_c = t_3;
+        }
+        if (v_c != 1) {
+          self->private_data.s_decode_ae[0].scratch = 2;
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(7);
+          if (self->private_data.s_decode_ae[0].scratch >
+              ((uint64_t)(io2_a_src - iop_a_src))) {
+            self->private_data.s_decode_ae[0].scratch -=
+                ((uint64_t)(io2_a_src - iop_a_src));
+            iop_a_src = io2_a_src;
+            status =
+                wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          iop_a_src += self->private_data.s_decode_ae[0].scratch;
+          goto label__goto_done__break;
+        }
+        {
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(8);
+          uint32_t t_4;
+          if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
+            t_4 = ((uint32_t)(
+                wuffs_base__load_u16le__no_bounds_check(iop_a_src)));
+            iop_a_src += 2;
+          } else {
+            self->private_data.s_decode_ae[0].scratch = 0;
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(9);
+            while (true) {
+              if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+                status =
+                    wuffs_base__make_status(wuffs_base__suspension__short_read);
+                goto suspend;
+              }
+              uint64_t* scratch = &self->private_data.s_decode_ae[0].scratch;
+              uint32_t num_bits_4 = ((uint32_t)(*scratch >> 56));
+              *scratch <<= 8;
+              *scratch >>= 8;
+              *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_4;
+              if (num_bits_4 == 8) {
+                t_4 = ((uint32_t)(*scratch));
+                break;
+              }
+              num_bits_4 += 8;
+              *scratch |= ((uint64_t)(num_bits_4)) << 56;
+            }
+          }
+          self->private_impl.f_num_loops = t_4;
+        }
+        self->private_impl.f_seen_num_loops = true;
+        if ((0 < self->private_impl.f_num_loops) &&
+            (self->private_impl.f_num_loops <= 65535)) {
+          self->private_impl.f_num_loops += 1;
+        }
+      } else if (self->private_impl.f_ignore_metadata) {
+      } else if (v_is_iccp && self->private_impl.f_report_metadata_iccp) {
+        while (((uint64_t)(io2_a_src - iop_a_src)) <= 0) {
+          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(10);
+        }
+        self->private_impl.f_metadata_chunk_length_value =
+            ((uint64_t)(wuffs_base__load_u8be__no_bounds_check(iop_a_src)));
+        (iop_a_src += 1, wuffs_base__make_empty_struct());
+        self->private_impl.f_metadata_fourcc_value = 1229144912;
+        self->private_impl.f_metadata_io_position = wuffs_base__u64__sat_add(
+            wuffs_base__u64__sat_add(a_src->meta.pos,
+                                     ((uint64_t)(iop_a_src - io0_a_src))),
+            self->private_impl.f_metadata_chunk_length_value);
+        self->private_impl.f_call_sequence = 1;
+        status = wuffs_base__make_status(wuffs_base__note__metadata_reported);
+        goto ok;
+      } else if (v_is_xmp && self->private_impl.f_report_metadata_xmp) {
+        while (((uint64_t)(io2_a_src - iop_a_src)) <= 0) {
+          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(11);
+        }
+        self->private_impl.f_metadata_chunk_length_value =
+            ((uint64_t)(wuffs_base__load_u8be__no_bounds_check(iop_a_src)));
+        if (self->private_impl.f_metadata_chunk_length_value > 0) {
+          self->private_impl.f_metadata_chunk_length_value += 1;
+        } else {
+          (iop_a_src += 1, wuffs_base__make_empty_struct());
+        }
+        self->private_impl.f_metadata_fourcc_value = 1481461792;
+        self->private_impl.f_metadata_io_position = wuffs_base__u64__sat_add(
+            wuffs_base__u64__sat_add(a_src->meta.pos,
+                                     ((uint64_t)(iop_a_src - io0_a_src))),
+            self->private_impl.f_metadata_chunk_length_value);
+        self->private_impl.f_call_sequence = 1;
+        status = wuffs_base__make_status(wuffs_base__note__metadata_reported);
+        goto ok;
+      }
+      goto label__goto_done__break;
+    }
+  label__goto_done__break:;
+    if (a_src) {
+      a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+    }
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(12);
+    status = wuffs_gif__config_decoder__skip_blocks(self, a_src);
+    if (a_src) {
+      iop_a_src = a_src->data.ptr + a_src->meta.ri;
+    }
+    if (status.repr) {
+      goto suspend;
+    }
+
+    goto ok;
+  ok:
+    self->private_impl.p_decode_ae[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+suspend:
+  self->private_impl.p_decode_ae[0] =
+      wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_data.s_decode_ae[0].v_block_size = v_block_size;
+  self->private_data.s_decode_ae[0].v_is_animexts = v_is_animexts;
+  self->private_data.s_decode_ae[0].v_is_netscape = v_is_netscape;
+  self->private_data.s_decode_ae[0].v_is_iccp = v_is_iccp;
+  self->private_data.s_decode_ae[0].v_is_xmp = v_is_xmp;
+
+  goto exit;
+exit:
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  return status;
+}
+
+// -------- func gif.config_decoder.decode_gc
+
+static wuffs_base__status  //
+wuffs_gif__config_decoder__decode_gc(wuffs_gif__config_decoder* self,
+                                     wuffs_base__io_buffer* a_src) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint8_t v_c = 0;
+  uint8_t v_flags = 0;
+  uint16_t v_gc_duration_centiseconds = 0;
+
+  uint8_t* iop_a_src = NULL;
+  uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_decode_gc[0];
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        goto suspend;
+      }
+      uint8_t t_0 = *iop_a_src++;
+      v_c = t_0;
+    }
+    if (v_c != 4) {
+      status = wuffs_base__make_status(wuffs_gif__error__bad_graphic_control);
+      goto exit;
+    }
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        goto suspend;
+      }
+      uint8_t t_1 = *iop_a_src++;
+      v_flags = t_1;
+    }
+    self->private_impl.f_gc_has_transparent_index = ((v_flags & 1) != 0);
+    v_flags = ((v_flags >> 2) & 7);
+    if (v_flags == 2) {
+      self->private_impl.f_gc_disposal = 1;
+    } else if ((v_flags == 3) || (v_flags == 4)) {
+      self->private_impl.f_gc_disposal = 2;
+    } else {
+      self->private_impl.f_gc_disposal = 0;
+    }
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+      uint16_t t_2;
+      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
+        t_2 = wuffs_base__load_u16le__no_bounds_check(iop_a_src);
+        iop_a_src += 2;
+      } else {
+        self->private_data.s_decode_gc[0].scratch = 0;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+        while (true) {
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status =
+                wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint64_t* scratch = &self->private_data.s_decode_gc[0].scratch;
+          uint32_t num_bits_2 = ((uint32_t)(*scratch >> 56));
+          *scratch <<= 8;
+          *scratch >>= 8;
+          *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_2;
+          if (num_bits_2 == 8) {
+            t_2 = ((uint16_t)(*scratch));
+            break;
+          }
+          num_bits_2 += 8;
+          *scratch |= ((uint64_t)(num_bits_2)) << 56;
+        }
+      }
+      v_gc_duration_centiseconds = t_2;
+    }
+    self->private_impl.f_gc_duration =
+        (((uint64_t)(v_gc_duration_centiseconds)) * 7056000);
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(5);
+      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        goto suspend;
+      }
+      uint8_t t_3 = *iop_a_src++;
+      self->private_impl.f_gc_transparent_index = t_3;
+    }
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(6);
+      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        goto suspend;
+      }
+      uint8_t t_4 = *iop_a_src++;
+      v_c = t_4;
+    }
+    if (v_c != 0) {
+      status = wuffs_base__make_status(wuffs_gif__error__bad_graphic_control);
+      goto exit;
+    }
+
+    goto ok;
+  ok:
+    self->private_impl.p_decode_gc[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+suspend:
+  self->private_impl.p_decode_gc[0] =
+      wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+
+  goto exit;
+exit:
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  return status;
+}
+
+// -------- func gif.config_decoder.decode_id_part0
+
+static wuffs_base__status  //
+wuffs_gif__config_decoder__decode_id_part0(wuffs_gif__config_decoder* self,
+                                           wuffs_base__io_buffer* a_src) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint8_t* iop_a_src = NULL;
+  uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_decode_id_part0[0];
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+      uint32_t t_0;
+      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
+        t_0 = ((uint32_t)(wuffs_base__load_u16le__no_bounds_check(iop_a_src)));
+        iop_a_src += 2;
+      } else {
+        self->private_data.s_decode_id_part0[0].scratch = 0;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+        while (true) {
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status =
+                wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint64_t* scratch = &self->private_data.s_decode_id_part0[0].scratch;
+          uint32_t num_bits_0 = ((uint32_t)(*scratch >> 56));
+          *scratch <<= 8;
+          *scratch >>= 8;
+          *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_0;
+          if (num_bits_0 == 8) {
+            t_0 = ((uint32_t)(*scratch));
+            break;
+          }
+          num_bits_0 += 8;
+          *scratch |= ((uint64_t)(num_bits_0)) << 56;
+        }
+      }
+      self->private_impl.f_frame_rect_x0 = t_0;
+    }
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+      uint32_t t_1;
+      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
+        t_1 = ((uint32_t)(wuffs_base__load_u16le__no_bounds_check(iop_a_src)));
+        iop_a_src += 2;
+      } else {
+        self->private_data.s_decode_id_part0[0].scratch = 0;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+        while (true) {
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status =
+                wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint64_t* scratch = &self->private_data.s_decode_id_part0[0].scratch;
+          uint32_t num_bits_1 = ((uint32_t)(*scratch >> 56));
+          *scratch <<= 8;
+          *scratch >>= 8;
+          *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_1;
+          if (num_bits_1 == 8) {
+            t_1 = ((uint32_t)(*scratch));
+            break;
+          }
+          num_bits_1 += 8;
+          *scratch |= ((uint64_t)(num_bits_1)) << 56;
+        }
+      }
+      self->private_impl.f_frame_rect_y0 = t_1;
+    }
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(5);
+      uint32_t t_2;
+      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
+        t_2 = ((uint32_t)(wuffs_base__load_u16le__no_bounds_check(iop_a_src)));
+        iop_a_src += 2;
+      } else {
+        self->private_data.s_decode_id_part0[0].scratch = 0;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(6);
+        while (true) {
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status =
+                wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint64_t* scratch = &self->private_data.s_decode_id_part0[0].scratch;
+          uint32_t num_bits_2 = ((uint32_t)(*scratch >> 56));
+          *scratch <<= 8;
+          *scratch >>= 8;
+          *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_2;
+          if (num_bits_2 == 8) {
+            t_2 = ((uint32_t)(*scratch));
+            break;
+          }
+          num_bits_2 += 8;
+          *scratch |= ((uint64_t)(num_bits_2)) << 56;
+        }
+      }
+      self->private_impl.f_frame_rect_x1 = t_2;
+    }
+    self->private_impl.f_frame_rect_x1 += self->private_impl.f_frame_rect_x0;
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(7);
+      uint32_t t_3;
+      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
+        t_3 = ((uint32_t)(wuffs_base__load_u16le__no_bounds_check(iop_a_src)));
+        iop_a_src += 2;
+      } else {
+        self->private_data.s_decode_id_part0[0].scratch = 0;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(8);
+        while (true) {
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status =
+                wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint64_t* scratch = &self->private_data.s_decode_id_part0[0].scratch;
+          uint32_t num_bits_3 = ((uint32_t)(*scratch >> 56));
+          *scratch <<= 8;
+          *scratch >>= 8;
+          *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_3;
+          if (num_bits_3 == 8) {
+            t_3 = ((uint32_t)(*scratch));
+            break;
+          }
+          num_bits_3 += 8;
+          *scratch |= ((uint64_t)(num_bits_3)) << 56;
+        }
+      }
+      self->private_impl.f_frame_rect_y1 = t_3;
+    }
+    self->private_impl.f_frame_rect_y1 += self->private_impl.f_frame_rect_y0;
+    if ((self->private_impl.f_call_sequence == 0) &&
+        !self->private_impl.f_quirk_enabled_image_bounds_are_strict) {
+      self->private_impl.f_width = wuffs_base__u32__max(
+          self->private_impl.f_width, self->private_impl.f_frame_rect_x1);
+      self->private_impl.f_height = wuffs_base__u32__max(
+          self->private_impl.f_height, self->private_impl.f_frame_rect_y1);
+    }
+
+    goto ok;
+  ok:
+    self->private_impl.p_decode_id_part0[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+suspend:
+  self->private_impl.p_decode_id_part0[0] =
+      wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+
+  goto exit;
+exit:
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  return status;
+}
+
+// -------- func gif.decoder.set_quirk_enabled
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_gif__decoder__set_quirk_enabled(wuffs_gif__decoder* self,
+                                      uint32_t a_quirk,
+                                      bool a_enabled) {
+  if (!self) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_empty_struct();
+  }
+
+  if (self->private_impl.f_call_sequence == 0) {
+    if (a_quirk == 1041635328) {
+      self->private_impl.f_quirk_enabled_delay_num_decoded_frames = a_enabled;
+    } else if (a_quirk == 1041635329) {
+      self->private_impl
+          .f_quirk_enabled_first_frame_local_palette_means_black_background =
+          a_enabled;
+    } else if (a_quirk == 1041635330) {
+      self->private_impl.f_quirk_enabled_honor_background_color = a_enabled;
+    } else if (a_quirk == 1041635331) {
+      self->private_impl.f_quirk_enabled_ignore_too_much_pixel_data = a_enabled;
+    } else if (a_quirk == 1041635332) {
+      self->private_impl.f_quirk_enabled_image_bounds_are_strict = a_enabled;
+    } else if (a_quirk == 1041635333) {
+      self->private_impl.f_quirk_enabled_reject_empty_frame = a_enabled;
+    } else if (a_quirk == 1041635334) {
+      self->private_impl.f_quirk_enabled_reject_empty_palette = a_enabled;
+    }
+  }
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func gif.decoder.decode_image_config
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_gif__decoder__decode_image_config(wuffs_gif__decoder* self,
+                                        wuffs_base__image_config* a_dst,
+                                        wuffs_base__io_buffer* a_src) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_status(
+        (self->private_impl.magic == WUFFS_BASE__DISABLED)
+            ? wuffs_base__error__disabled_by_previous_error
+            : wuffs_base__error__initialize_not_called);
+  }
+  if (!a_src) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+  }
+  if ((self->private_impl.active_coroutine != 0) &&
+      (self->private_impl.active_coroutine != 1)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(
+        wuffs_base__error__interleaved_coroutine_calls);
+  }
+  self->private_impl.active_coroutine = 0;
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  bool v_ffio = false;
+
+  uint32_t coro_susp_point = self->private_impl.p_decode_image_config[0];
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    if (self->private_impl.f_call_sequence == 0) {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+      status = wuffs_gif__decoder__decode_header(self, a_src);
+      if (status.repr) {
+        goto suspend;
+      }
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+      status = wuffs_gif__decoder__decode_lsd(self, a_src);
+      if (status.repr) {
+        goto suspend;
+      }
+    } else if (self->private_impl.f_call_sequence != 2) {
+      status = wuffs_base__make_status(wuffs_base__error__bad_call_sequence);
+      goto exit;
+    }
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+    status = wuffs_gif__decoder__decode_up_to_id_part1(self, a_src);
+    if (status.repr) {
+      goto suspend;
+    }
+    v_ffio = !self->private_impl.f_gc_has_transparent_index;
+    if (!self->private_impl.f_quirk_enabled_honor_background_color) {
+      v_ffio =
+          (v_ffio && (self->private_impl.f_frame_rect_x0 == 0) &&
+           (self->private_impl.f_frame_rect_y0 == 0) &&
+           (self->private_impl.f_frame_rect_x1 == self->private_impl.f_width) &&
+           (self->private_impl.f_frame_rect_y1 == self->private_impl.f_height));
+    } else if (v_ffio) {
+      self->private_impl.f_black_color_u32_argb_premul = 4278190080;
+    }
+    if (self->private_impl.f_background_color_u32_argb_premul == 77) {
+      self->private_impl.f_background_color_u32_argb_premul =
+          self->private_impl.f_black_color_u32_argb_premul;
+    }
+    if (a_dst != NULL) {
+      wuffs_base__image_config__set(
+          a_dst, 1191444488, 0, self->private_impl.f_width,
+          self->private_impl.f_height,
+          self->private_impl.f_frame_config_io_position, v_ffio);
+    }
+    self->private_impl.f_call_sequence = 3;
+
+    goto ok;
+  ok:
+    self->private_impl.p_decode_image_config[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+suspend:
+  self->private_impl.p_decode_image_config[0] =
+      wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_impl.active_coroutine =
+      wuffs_base__status__is_suspension(&status) ? 1 : 0;
+
+  goto exit;
+exit:
+  if (wuffs_base__status__is_error(&status)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+  }
+  return status;
+}
+
+// -------- func gif.decoder.set_report_metadata
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_gif__decoder__set_report_metadata(wuffs_gif__decoder* self,
+                                        uint32_t a_fourcc,
+                                        bool a_report) {
+  if (!self) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_empty_struct();
+  }
+
+  if (a_fourcc == 1229144912) {
+    self->private_impl.f_report_metadata_iccp = a_report;
+  } else if (a_fourcc == 1481461792) {
+    self->private_impl.f_report_metadata_xmp = a_report;
+  }
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func gif.decoder.ack_metadata_chunk
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_gif__decoder__ack_metadata_chunk(wuffs_gif__decoder* self,
+                                       wuffs_base__io_buffer* a_src) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_status(
+        (self->private_impl.magic == WUFFS_BASE__DISABLED)
+            ? wuffs_base__error__disabled_by_previous_error
+            : wuffs_base__error__initialize_not_called);
+  }
+  if (!a_src) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+  }
+  if ((self->private_impl.active_coroutine != 0) &&
+      (self->private_impl.active_coroutine != 2)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(
+        wuffs_base__error__interleaved_coroutine_calls);
+  }
+  self->private_impl.active_coroutine = 0;
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint8_t* iop_a_src = NULL;
+  uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_ack_metadata_chunk[0];
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    if (self->private_impl.f_call_sequence != 1) {
+      status = wuffs_base__make_status(wuffs_base__error__bad_call_sequence);
+      goto exit;
+    }
+    if (wuffs_base__u64__sat_add(a_src->meta.pos,
+                                 ((uint64_t)(iop_a_src - io0_a_src))) !=
+        self->private_impl.f_metadata_io_position) {
+      status = wuffs_base__make_status(wuffs_base__error__bad_i_o_position);
+      goto exit;
+    }
+    if (self->private_impl.f_metadata_chunk_length_value > 0) {
+      while (((uint64_t)(io2_a_src - iop_a_src)) <= 0) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(1);
+      }
+      self->private_impl.f_metadata_chunk_length_value =
+          ((uint64_t)(wuffs_base__load_u8be__no_bounds_check(iop_a_src)));
+      if (self->private_impl.f_metadata_chunk_length_value > 0) {
+        if (self->private_impl.f_metadata_fourcc_value == 1481461792) {
+          self->private_impl.f_metadata_chunk_length_value += 1;
+        } else {
+          (iop_a_src += 1, wuffs_base__make_empty_struct());
+        }
+        self->private_impl.f_metadata_io_position = wuffs_base__u64__sat_add(
+            wuffs_base__u64__sat_add(a_src->meta.pos,
+                                     ((uint64_t)(iop_a_src - io0_a_src))),
+            self->private_impl.f_metadata_chunk_length_value);
+        status = wuffs_base__make_status(wuffs_base__note__metadata_reported);
+        goto ok;
+      }
+      (iop_a_src += 1, wuffs_base__make_empty_struct());
+    }
+    self->private_impl.f_call_sequence = 2;
+    self->private_impl.f_metadata_fourcc_value = 0;
+    self->private_impl.f_metadata_io_position = 0;
+    status = wuffs_base__make_status(NULL);
+    goto ok;
+    goto ok;
+  ok:
+    self->private_impl.p_ack_metadata_chunk[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+suspend:
+  self->private_impl.p_ack_metadata_chunk[0] =
+      wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_impl.active_coroutine =
+      wuffs_base__status__is_suspension(&status) ? 2 : 0;
+
+  goto exit;
+exit:
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  if (wuffs_base__status__is_error(&status)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+  }
+  return status;
+}
+
+// -------- func gif.decoder.metadata_fourcc
+
+WUFFS_BASE__MAYBE_STATIC uint32_t  //
+wuffs_gif__decoder__metadata_fourcc(const wuffs_gif__decoder* self) {
+  if (!self) {
+    return 0;
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return 0;
+  }
+
+  return self->private_impl.f_metadata_fourcc_value;
+}
+
+// -------- func gif.decoder.metadata_chunk_length
+
+WUFFS_BASE__MAYBE_STATIC uint64_t  //
+wuffs_gif__decoder__metadata_chunk_length(const wuffs_gif__decoder* self) {
+  if (!self) {
+    return 0;
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return 0;
+  }
+
+  return self->private_impl.f_metadata_chunk_length_value;
+}
+
+// -------- func gif.decoder.num_animation_loops
+
+WUFFS_BASE__MAYBE_STATIC uint32_t  //
+wuffs_gif__decoder__num_animation_loops(const wuffs_gif__decoder* self) {
+  if (!self) {
+    return 0;
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return 0;
+  }
+
+  if (self->private_impl.f_seen_num_loops) {
+    return self->private_impl.f_num_loops;
+  }
+  return 1;
+}
+
+// -------- func gif.decoder.num_decoded_frame_configs
+
+WUFFS_BASE__MAYBE_STATIC uint64_t  //
+wuffs_gif__decoder__num_decoded_frame_configs(const wuffs_gif__decoder* self) {
+  if (!self) {
+    return 0;
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return 0;
+  }
+
+  return self->private_impl.f_num_decoded_frame_configs_value;
+}
+
+// -------- func gif.decoder.num_decoded_frames
+
+WUFFS_BASE__MAYBE_STATIC uint64_t  //
+wuffs_gif__decoder__num_decoded_frames(const wuffs_gif__decoder* self) {
+  if (!self) {
+    return 0;
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return 0;
+  }
+
+  return self->private_impl.f_num_decoded_frames_value;
+}
+
+// -------- func gif.decoder.frame_dirty_rect
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__rect_ie_u32  //
+wuffs_gif__decoder__frame_dirty_rect(const wuffs_gif__decoder* self) {
+  if (!self) {
+    return wuffs_base__utility__empty_rect_ie_u32();
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return wuffs_base__utility__empty_rect_ie_u32();
+  }
+
+  return wuffs_base__utility__make_rect_ie_u32(
+      wuffs_base__u32__min(self->private_impl.f_frame_rect_x0,
+                           self->private_impl.f_width),
+      wuffs_base__u32__min(self->private_impl.f_frame_rect_y0,
+                           self->private_impl.f_height),
+      wuffs_base__u32__min(self->private_impl.f_frame_rect_x1,
+                           self->private_impl.f_width),
+      wuffs_base__u32__min(self->private_impl.f_dirty_max_excl_y,
+                           self->private_impl.f_height));
+}
+
+// -------- func gif.decoder.workbuf_len
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__range_ii_u64  //
+wuffs_gif__decoder__workbuf_len(const wuffs_gif__decoder* self) {
+  if (!self) {
+    return wuffs_base__utility__empty_range_ii_u64();
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return wuffs_base__utility__empty_range_ii_u64();
   }
 
-  goto suspend;
-suspend:
-  self->private_impl.p_decode_header[0] =
-      wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
-  memcpy(self->private_data.s_decode_header[0].v_c, v_c, sizeof(v_c));
-  self->private_data.s_decode_header[0].v_i = v_i;
+  return wuffs_base__utility__make_range_ii_u64(0, 0);
+}
 
-  goto exit;
-exit:
-  if (a_src) {
-    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+// -------- func gif.decoder.restart_frame
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_gif__decoder__restart_frame(wuffs_gif__decoder* self,
+                                  uint64_t a_index,
+                                  uint64_t a_io_position) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_status(
+        (self->private_impl.magic == WUFFS_BASE__DISABLED)
+            ? wuffs_base__error__disabled_by_previous_error
+            : wuffs_base__error__initialize_not_called);
   }
 
-  return status;
+  if (self->private_impl.f_call_sequence == 0) {
+    return wuffs_base__make_status(wuffs_base__error__bad_call_sequence);
+  }
+  self->private_impl.f_delayed_num_decoded_frames = false;
+  self->private_impl.f_end_of_data = false;
+  self->private_impl.f_restarted = true;
+  self->private_impl.f_frame_config_io_position = a_io_position;
+  self->private_impl.f_num_decoded_frame_configs_value = a_index;
+  self->private_impl.f_num_decoded_frames_value = a_index;
+  wuffs_gif__decoder__reset_gc(self);
+  return wuffs_base__make_status(NULL);
 }
 
-// -------- func gif.config_decoder.decode_lsd
+// -------- func gif.decoder.decode_frame_index
 
-static wuffs_base__status  //
-wuffs_gif__config_decoder__decode_lsd(wuffs_gif__config_decoder* self,
-                                      wuffs_base__io_buffer* a_src) {
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_gif__decoder__decode_frame_index(wuffs_gif__decoder* self,
+                                       wuffs_base__io_buffer* a_dst,
+                                       wuffs_base__io_buffer* a_src) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_status(
+        (self->private_impl.magic == WUFFS_BASE__DISABLED)
+            ? wuffs_base__error__disabled_by_previous_error
+            : wuffs_base__error__initialize_not_called);
+  }
+  if (!a_dst || !a_src) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+  }
+  if ((self->private_impl.active_coroutine != 0) &&
+      (self->private_impl.active_coroutine != 3)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(
+        wuffs_base__error__interleaved_coroutine_calls);
+  }
+  self->private_impl.active_coroutine = 0;
   wuffs_base__status status = wuffs_base__make_status(NULL);
 
+  wuffs_base__status v_status = wuffs_base__make_status(NULL);
+  uint64_t v_entry = 0;
+  uint64_t v_x = 0;
   uint8_t v_flags = 0;
-  uint8_t v_background_color_index = 0;
-  uint32_t v_num_palette_entries = 0;
-  uint32_t v_i = 0;
-  uint32_t v_j = 0;
-  uint32_t v_argb = 0;
+  uint64_t v_duration = 0;
 
+  uint8_t* iop_a_dst = NULL;
+  uint8_t* io0_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_dst) {
+    io0_a_dst = a_dst->data.ptr;
+    io1_a_dst = io0_a_dst + a_dst->meta.wi;
+    iop_a_dst = io1_a_dst;
+    io2_a_dst = io0_a_dst + a_dst->data.len;
+    if (a_dst->meta.closed) {
+      io2_a_dst = iop_a_dst;
+    }
+  }
   uint8_t* iop_a_src = NULL;
   uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
   uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
@@ -16311,209 +23598,152 @@ wuffs_gif__config_decoder__decode_lsd(wuffs_gif__config_decoder* self,
     io2_a_src = io0_a_src + a_src->meta.wi;
   }
 
-  uint32_t coro_susp_point = self->private_impl.p_decode_lsd[0];
+  uint32_t coro_susp_point = self->private_impl.p_decode_frame_index[0];
   if (coro_susp_point) {
-    v_flags = self->private_data.s_decode_lsd[0].v_flags;
-    v_background_color_index =
-        self->private_data.s_decode_lsd[0].v_background_color_index;
-    v_num_palette_entries =
-        self->private_data.s_decode_lsd[0].v_num_palette_entries;
-    v_i = self->private_data.s_decode_lsd[0].v_i;
+    v_entry = self->private_data.s_decode_frame_index[0].v_entry;
+    v_flags = self->private_data.s_decode_frame_index[0].v_flags;
+    v_duration = self->private_data.s_decode_frame_index[0].v_duration;
   }
   switch (coro_susp_point) {
     WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
 
-    {
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
-      uint32_t t_0;
-      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
-        t_0 = ((uint32_t)(wuffs_base__load_u16le__no_bounds_check(iop_a_src)));
-        iop_a_src += 2;
-      } else {
-        self->private_data.s_decode_lsd[0].scratch = 0;
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
-        while (true) {
-          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-            status =
-                wuffs_base__make_status(wuffs_base__suspension__short_read);
-            goto suspend;
-          }
-          uint64_t* scratch = &self->private_data.s_decode_lsd[0].scratch;
-          uint32_t num_bits_0 = ((uint32_t)(*scratch >> 56));
-          *scratch <<= 8;
-          *scratch >>= 8;
-          *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_0;
-          if (num_bits_0 == 8) {
-            t_0 = ((uint32_t)(*scratch));
-            break;
-          }
-          num_bits_0 += 8;
-          *scratch |= ((uint64_t)(num_bits_0)) << 56;
+  label__0__continue:;
+    while (true) {
+      {
+        if (a_src) {
+          a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
         }
-      }
-      self->private_impl.f_width = t_0;
-    }
-    {
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
-      uint32_t t_1;
-      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
-        t_1 = ((uint32_t)(wuffs_base__load_u16le__no_bounds_check(iop_a_src)));
-        iop_a_src += 2;
-      } else {
-        self->private_data.s_decode_lsd[0].scratch = 0;
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
-        while (true) {
-          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-            status =
-                wuffs_base__make_status(wuffs_base__suspension__short_read);
-            goto suspend;
-          }
-          uint64_t* scratch = &self->private_data.s_decode_lsd[0].scratch;
-          uint32_t num_bits_1 = ((uint32_t)(*scratch >> 56));
-          *scratch <<= 8;
-          *scratch >>= 8;
-          *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_1;
-          if (num_bits_1 == 8) {
-            t_1 = ((uint32_t)(*scratch));
-            break;
-          }
-          num_bits_1 += 8;
-          *scratch |= ((uint64_t)(num_bits_1)) << 56;
+        wuffs_base__status t_0 =
+            wuffs_gif__decoder__decode_frame_config(self, NULL, a_src);
+        if (a_src) {
+          iop_a_src = a_src->data.ptr + a_src->meta.ri;
         }
+        v_status = t_0;
       }
-      self->private_impl.f_height = t_1;
-    }
-    {
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(5);
-      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-        goto suspend;
-      }
-      uint8_t t_2 = *iop_a_src++;
-      v_flags = t_2;
-    }
-    {
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(6);
-      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+      if (v_status.repr ==
+          wuffs_base__make_status(wuffs_base__suspension__short_read).repr) {
         status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-        goto suspend;
-      }
-      uint8_t t_3 = *iop_a_src++;
-      v_background_color_index = t_3;
-    }
-    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(7);
-    if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-      status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-      goto suspend;
-    }
-    iop_a_src++;
-    v_i = 0;
-    self->private_impl.f_has_global_palette = ((v_flags & 128) != 0);
-    if (self->private_impl.f_has_global_palette) {
-      v_num_palette_entries = (((uint32_t)(1)) << (1 + (v_flags & 7)));
-      while (v_i < v_num_palette_entries) {
-        {
-          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(8);
-          uint32_t t_4;
-          if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 3)) {
-            t_4 = ((uint32_t)(
-                wuffs_base__load_u24be__no_bounds_check(iop_a_src)));
-            iop_a_src += 3;
-          } else {
-            self->private_data.s_decode_lsd[0].scratch = 0;
-            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(9);
-            while (true) {
-              if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-                status =
-                    wuffs_base__make_status(wuffs_base__suspension__short_read);
-                goto suspend;
-              }
-              uint64_t* scratch = &self->private_data.s_decode_lsd[0].scratch;
-              uint32_t num_bits_4 = ((uint32_t)(*scratch & 0xFF));
-              *scratch >>= 8;
-              *scratch <<= 8;
-              *scratch |= ((uint64_t)(*iop_a_src++)) << (56 - num_bits_4);
-              if (num_bits_4 == 16) {
-                t_4 = ((uint32_t)(*scratch >> 40));
-                break;
-              }
-              num_bits_4 += 8;
-              *scratch |= ((uint64_t)(num_bits_4));
-            }
-          }
-          v_argb = t_4;
-        }
-        v_argb |= 4278190080;
-        self->private_data.f_palettes[0][((4 * v_i) + 0)] =
-            ((uint8_t)(((v_argb >> 0) & 255)));
-        self->private_data.f_palettes[0][((4 * v_i) + 1)] =
-            ((uint8_t)(((v_argb >> 8) & 255)));
-        self->private_data.f_palettes[0][((4 * v_i) + 2)] =
-            ((uint8_t)(((v_argb >> 16) & 255)));
-        self->private_data.f_palettes[0][((4 * v_i) + 3)] =
-            ((uint8_t)(((v_argb >> 24) & 255)));
-        v_i += 1;
-      }
-      if (self->private_impl.f_quirk_enabled_honor_background_color) {
-        if ((v_background_color_index != 0) &&
-            (((uint32_t)(v_background_color_index)) < v_num_palette_entries)) {
-          v_j = (4 * ((uint32_t)(v_background_color_index)));
-          self->private_impl.f_background_color_u32_argb_premul =
-              ((((uint32_t)(self->private_data.f_palettes[0][(v_j + 0)]))
-                << 0) |
-               (((uint32_t)(self->private_data.f_palettes[0][(v_j + 1)]))
-                << 8) |
-               (((uint32_t)(self->private_data.f_palettes[0][(v_j + 2)]))
-                << 16) |
-               (((uint32_t)(self->private_data.f_palettes[0][(v_j + 3)]))
-                << 24));
-        } else {
-          self->private_impl.f_background_color_u32_argb_premul = 77;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(1);
+        goto label__0__continue;
+      } else if (v_status.repr ==
+                 wuffs_base__make_status(wuffs_base__note__end_of_data).repr) {
+        goto label__0__break;
+      } else if (!wuffs_base__status__is_ok(&v_status)) {
+        status = v_status;
+        if (wuffs_base__status__is_error(&status)) {
+          goto exit;
+        } else if (wuffs_base__status__is_suspension(&status)) {
+          status = wuffs_base__make_status(
+              wuffs_base__error__cannot_return_a_suspension);
+          goto exit;
         }
+        goto ok;
       }
+      while (((uint64_t)(io2_a_src - iop_a_src)) <= 0) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(2);
+      }
+      v_flags = 0;
+      if ((wuffs_base__load_u8be__no_bounds_check(iop_a_src) & 128) != 0) {
+        v_flags = 1;
+      }
+      if (!self->private_impl.f_gc_has_transparent_index) {
+        v_flags |= 2;
+      }
+      v_x = ((uint64_t)(wuffs_base__u32__min(self->private_impl.f_frame_rect_x0,
+                                             self->private_impl.f_width)));
+      v_entry = wuffs_base__u64__min(v_x, 65535);
+      v_x = ((uint64_t)(wuffs_base__u32__min(self->private_impl.f_frame_rect_y0,
+                                             self->private_impl.f_height)));
+      v_x = wuffs_base__u64__min(v_x, 65535);
+      v_entry |= (v_x << 16);
+      v_x = ((uint64_t)(wuffs_base__u32__min(self->private_impl.f_frame_rect_x1,
+                                             self->private_impl.f_width)));
+      v_x = wuffs_base__u64__min(v_x, 65535);
+      v_entry |= (v_x << 32);
+      v_x = ((uint64_t)(wuffs_base__u32__min(self->private_impl.f_frame_rect_y1,
+                                             self->private_impl.f_height)));
+      v_x = wuffs_base__u64__min(v_x, 65535);
+      v_entry |= (v_x << 48);
+      v_duration = (self->private_impl.f_gc_duration / 7056000);
+      while (((uint64_t)(io2_a_dst - iop_a_dst)) < 20) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(3);
+      }
+      (wuffs_base__store_u64le__no_bounds_check(
+           iop_a_dst, self->private_impl.f_frame_config_io_position),
+       iop_a_dst += 8, wuffs_base__make_empty_struct());
+      (wuffs_base__store_u64le__no_bounds_check(iop_a_dst, v_entry),
+       iop_a_dst += 8, wuffs_base__make_empty_struct());
+      (wuffs_base__store_u32le__no_bounds_check(
+           iop_a_dst, (((uint32_t)(v_duration)) |
+                       (((uint32_t)(self->private_impl.f_gc_disposal)) << 16) |
+                       (((uint32_t)(v_flags)) << 24))),
+       iop_a_dst += 4, wuffs_base__make_empty_struct());
     }
-    while (v_i < 256) {
-      self->private_data.f_palettes[0][((4 * v_i) + 0)] = 0;
-      self->private_data.f_palettes[0][((4 * v_i) + 1)] = 0;
-      self->private_data.f_palettes[0][((4 * v_i) + 2)] = 0;
-      self->private_data.f_palettes[0][((4 * v_i) + 3)] = 255;
-      v_i += 1;
-    }
+  label__0__break:;
 
     goto ok;
   ok:
-    self->private_impl.p_decode_lsd[0] = 0;
+    self->private_impl.p_decode_frame_index[0] = 0;
     goto exit;
   }
 
   goto suspend;
 suspend:
-  self->private_impl.p_decode_lsd[0] =
+  self->private_impl.p_decode_frame_index[0] =
       wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
-  self->private_data.s_decode_lsd[0].v_flags = v_flags;
-  self->private_data.s_decode_lsd[0].v_background_color_index =
-      v_background_color_index;
-  self->private_data.s_decode_lsd[0].v_num_palette_entries =
-      v_num_palette_entries;
-  self->private_data.s_decode_lsd[0].v_i = v_i;
+  self->private_impl.active_coroutine =
+      wuffs_base__status__is_suspension(&status) ? 3 : 0;
+  self->private_data.s_decode_frame_index[0].v_entry = v_entry;
+  self->private_data.s_decode_frame_index[0].v_flags = v_flags;
+  self->private_data.s_decode_frame_index[0].v_duration = v_duration;
 
   goto exit;
 exit:
+  if (a_dst) {
+    a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+  }
   if (a_src) {
     a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
   }
 
+  if (wuffs_base__status__is_error(&status)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+  }
   return status;
 }
 
-// -------- func gif.config_decoder.decode_extension
+// -------- func gif.decoder.decode_frame_config
 
-static wuffs_base__status  //
-wuffs_gif__config_decoder__decode_extension(wuffs_gif__config_decoder* self,
-                                            wuffs_base__io_buffer* a_src) {
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_gif__decoder__decode_frame_config(wuffs_gif__decoder* self,
+                                        wuffs_base__frame_config* a_dst,
+                                        wuffs_base__io_buffer* a_src) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_status(
+        (self->private_impl.magic == WUFFS_BASE__DISABLED)
+            ? wuffs_base__error__disabled_by_previous_error
+            : wuffs_base__error__initialize_not_called);
+  }
+  if (!a_src) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+  }
+  if ((self->private_impl.active_coroutine != 0) &&
+      (self->private_impl.active_coroutine != 4)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(
+        wuffs_base__error__interleaved_coroutine_calls);
+  }
+  self->private_impl.active_coroutine = 0;
   wuffs_base__status status = wuffs_base__make_status(NULL);
 
-  uint8_t v_label = 0;
+  uint32_t v_background_color = 0;
+  uint8_t v_flags = 0;
 
   uint8_t* iop_a_src = NULL;
   uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
@@ -16526,70 +23756,114 @@ wuffs_gif__config_decoder__decode_extension(wuffs_gif__config_decoder* self,
     io2_a_src = io0_a_src + a_src->meta.wi;
   }
 
-  uint32_t coro_susp_point = self->private_impl.p_decode_extension[0];
+  uint32_t coro_susp_point = self->private_impl.p_decode_frame_config[0];
+  if (coro_susp_point) {
+    v_background_color =
+        self->private_data.s_decode_frame_config[0].v_background_color;
+  }
   switch (coro_susp_point) {
     WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
 
-    {
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
-      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-        goto suspend;
+    self->private_impl.f_ignore_metadata = true;
+    self->private_impl.f_dirty_max_excl_y = 0;
+    if (!self->private_impl.f_end_of_data) {
+      if (self->private_impl.f_call_sequence == 0) {
+        if (a_src) {
+          a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+        }
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+        status = wuffs_gif__decoder__decode_image_config(self, NULL, a_src);
+        if (a_src) {
+          iop_a_src = a_src->data.ptr + a_src->meta.ri;
+        }
+        if (status.repr) {
+          goto suspend;
+        }
+      } else if (self->private_impl.f_call_sequence != 3) {
+        if (self->private_impl.f_call_sequence == 4) {
+          if (a_src) {
+            a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+          }
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+          status = wuffs_gif__decoder__skip_frame(self, a_src);
+          if (a_src) {
+            iop_a_src = a_src->data.ptr + a_src->meta.ri;
+          }
+          if (status.repr) {
+            goto suspend;
+          }
+        }
+        if (a_src) {
+          a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+        }
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+        status = wuffs_gif__decoder__decode_up_to_id_part1(self, a_src);
+        if (a_src) {
+          iop_a_src = a_src->data.ptr + a_src->meta.ri;
+        }
+        if (status.repr) {
+          goto suspend;
+        }
       }
-      uint8_t t_0 = *iop_a_src++;
-      v_label = t_0;
     }
-    if (v_label == 249) {
-      if (a_src) {
-        a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
-      }
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
-      status = wuffs_gif__config_decoder__decode_gc(self, a_src);
-      if (a_src) {
-        iop_a_src = a_src->data.ptr + a_src->meta.ri;
-      }
-      if (status.repr) {
-        goto suspend;
-      }
-      status = wuffs_base__make_status(NULL);
-      goto ok;
-    } else if (v_label == 255) {
-      if (a_src) {
-        a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
-      }
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
-      status = wuffs_gif__config_decoder__decode_ae(self, a_src);
-      if (a_src) {
-        iop_a_src = a_src->data.ptr + a_src->meta.ri;
-      }
-      if (status.repr) {
-        goto suspend;
-      }
-      status = wuffs_base__make_status(NULL);
+    if (self->private_impl.f_end_of_data) {
+      status = wuffs_base__make_status(wuffs_base__note__end_of_data);
       goto ok;
     }
-    if (a_src) {
-      a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
-    }
-    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
-    status = wuffs_gif__config_decoder__skip_blocks(self, a_src);
-    if (a_src) {
-      iop_a_src = a_src->data.ptr + a_src->meta.ri;
+    v_background_color = self->private_impl.f_black_color_u32_argb_premul;
+    if (!self->private_impl.f_gc_has_transparent_index) {
+      v_background_color =
+          self->private_impl.f_background_color_u32_argb_premul;
+      if (self->private_impl
+              .f_quirk_enabled_first_frame_local_palette_means_black_background &&
+          (self->private_impl.f_num_decoded_frame_configs_value == 0)) {
+        while (((uint64_t)(io2_a_src - iop_a_src)) <= 0) {
+          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(4);
+        }
+        v_flags = wuffs_base__load_u8be__no_bounds_check(iop_a_src);
+        if ((v_flags & 128) != 0) {
+          v_background_color = self->private_impl.f_black_color_u32_argb_premul;
+        }
+      }
     }
-    if (status.repr) {
-      goto suspend;
+    if (a_dst != NULL) {
+      wuffs_base__frame_config__update(
+          a_dst,
+          wuffs_base__utility__make_rect_ie_u32(
+              wuffs_base__u32__min(self->private_impl.f_frame_rect_x0,
+                                   self->private_impl.f_width),
+              wuffs_base__u32__min(self->private_impl.f_frame_rect_y0,
+                                   self->private_impl.f_height),
+              wuffs_base__u32__min(self->private_impl.f_frame_rect_x1,
+                                   self->private_impl.f_width),
+              wuffs_base__u32__min(self->private_impl.f_frame_rect_y1,
+                                   self->private_impl.f_height)),
+          ((wuffs_base__flicks)(self->private_impl.f_gc_duration)),
+          self->private_impl.f_num_decoded_frame_configs_value,
+          self->private_impl.f_frame_config_io_position,
+          self->private_impl.f_gc_disposal,
+          !self->private_impl.f_gc_has_transparent_index, false,
+          v_background_color);
     }
+    wuffs_base__u64__sat_add_indirect(
+        &self->private_impl.f_num_decoded_frame_configs_value, 1);
+    self->private_impl.f_call_sequence = 4;
 
     goto ok;
   ok:
-    self->private_impl.p_decode_extension[0] = 0;
+    self->private_impl.p_decode_frame_config[0] = 0;
     goto exit;
   }
 
   goto suspend;
 suspend:
-  self->private_impl.p_decode_extension[0] =
+  self->private_impl.p_decode_frame_config[0] =
       wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_impl.active_coroutine =
+      wuffs_base__status__is_suspension(&status) ? 4 : 0;
+  self->private_data.s_decode_frame_config[0].v_background_color =
+      v_background_color;
 
   goto exit;
 exit:
@@ -16597,17 +23871,21 @@ exit:
     a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
   }
 
+  if (wuffs_base__status__is_error(&status)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+  }
   return status;
 }
 
-// -------- func gif.config_decoder.skip_blocks
+// -------- func gif.decoder.skip_frame
 
 static wuffs_base__status  //
-wuffs_gif__config_decoder__skip_blocks(wuffs_gif__config_decoder* self,
-                                       wuffs_base__io_buffer* a_src) {
+wuffs_gif__decoder__skip_frame(wuffs_gif__decoder* self,
+                               wuffs_base__io_buffer* a_src) {
   wuffs_base__status status = wuffs_base__make_status(NULL);
 
-  uint8_t v_block_size = 0;
+  uint8_t v_flags = 0;
+  uint8_t v_lw = 0;
 
   uint8_t* iop_a_src = NULL;
   uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
@@ -16620,46 +23898,74 @@ wuffs_gif__config_decoder__skip_blocks(wuffs_gif__config_decoder* self,
     io2_a_src = io0_a_src + a_src->meta.wi;
   }
 
-  uint32_t coro_susp_point = self->private_impl.p_skip_blocks[0];
+  uint32_t coro_susp_point = self->private_impl.p_skip_frame[0];
   switch (coro_susp_point) {
     WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
 
-    while (true) {
-      {
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
-        if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-          goto suspend;
-        }
-        uint8_t t_0 = *iop_a_src++;
-        v_block_size = t_0;
-      }
-      if (v_block_size == 0) {
-        status = wuffs_base__make_status(NULL);
-        goto ok;
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        goto suspend;
       }
-      self->private_data.s_skip_blocks[0].scratch = ((uint32_t)(v_block_size));
+      uint8_t t_0 = *iop_a_src++;
+      v_flags = t_0;
+    }
+    if ((v_flags & 128) != 0) {
+      self->private_data.s_skip_frame[0].scratch =
+          (((uint32_t)(3)) << (1 + (v_flags & 7)));
       WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
-      if (self->private_data.s_skip_blocks[0].scratch >
+      if (self->private_data.s_skip_frame[0].scratch >
           ((uint64_t)(io2_a_src - iop_a_src))) {
-        self->private_data.s_skip_blocks[0].scratch -=
+        self->private_data.s_skip_frame[0].scratch -=
             ((uint64_t)(io2_a_src - iop_a_src));
         iop_a_src = io2_a_src;
         status = wuffs_base__make_status(wuffs_base__suspension__short_read);
         goto suspend;
       }
-      iop_a_src += self->private_data.s_skip_blocks[0].scratch;
+      iop_a_src += self->private_data.s_skip_frame[0].scratch;
+    }
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        goto suspend;
+      }
+      uint8_t t_1 = *iop_a_src++;
+      v_lw = t_1;
+    }
+    if (v_lw > 8) {
+      status = wuffs_base__make_status(wuffs_gif__error__bad_literal_width);
+      goto exit;
+    }
+    if (a_src) {
+      a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+    }
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+    status = wuffs_gif__decoder__skip_blocks(self, a_src);
+    if (a_src) {
+      iop_a_src = a_src->data.ptr + a_src->meta.ri;
+    }
+    if (status.repr) {
+      goto suspend;
+    }
+    if (self->private_impl.f_quirk_enabled_delay_num_decoded_frames) {
+      self->private_impl.f_delayed_num_decoded_frames = true;
+    } else {
+      wuffs_base__u64__sat_add_indirect(
+          &self->private_impl.f_num_decoded_frames_value, 1);
     }
+    wuffs_gif__decoder__reset_gc(self);
 
     goto ok;
   ok:
-    self->private_impl.p_skip_blocks[0] = 0;
+    self->private_impl.p_skip_frame[0] = 0;
     goto exit;
   }
 
   goto suspend;
 suspend:
-  self->private_impl.p_skip_blocks[0] =
+  self->private_impl.p_skip_frame[0] =
       wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
 
   goto exit;
@@ -16671,278 +23977,112 @@ exit:
   return status;
 }
 
-// -------- func gif.config_decoder.decode_ae
-
-static wuffs_base__status  //
-wuffs_gif__config_decoder__decode_ae(wuffs_gif__config_decoder* self,
-                                     wuffs_base__io_buffer* a_src) {
-  wuffs_base__status status = wuffs_base__make_status(NULL);
-
-  uint8_t v_c = 0;
-  uint8_t v_block_size = 0;
-  bool v_is_animexts = false;
-  bool v_is_netscape = false;
-  bool v_is_iccp = false;
-  bool v_is_xmp = false;
-
-  uint8_t* iop_a_src = NULL;
-  uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
-  uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
-  uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
-  if (a_src) {
-    io0_a_src = a_src->data.ptr;
-    io1_a_src = io0_a_src + a_src->meta.ri;
-    iop_a_src = io1_a_src;
-    io2_a_src = io0_a_src + a_src->meta.wi;
-  }
+// -------- func gif.decoder.decode_frame
 
-  uint32_t coro_susp_point = self->private_impl.p_decode_ae[0];
-  if (coro_susp_point) {
-    v_block_size = self->private_data.s_decode_ae[0].v_block_size;
-    v_is_animexts = self->private_data.s_decode_ae[0].v_is_animexts;
-    v_is_netscape = self->private_data.s_decode_ae[0].v_is_netscape;
-    v_is_iccp = self->private_data.s_decode_ae[0].v_is_iccp;
-    v_is_xmp = self->private_data.s_decode_ae[0].v_is_xmp;
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_gif__decoder__decode_frame(wuffs_gif__decoder* self,
+                                 wuffs_base__pixel_buffer* a_dst,
+                                 wuffs_base__io_buffer* a_src,
+                                 wuffs_base__pixel_blend a_blend,
+                                 wuffs_base__slice_u8 a_workbuf,
+                                 wuffs_base__decode_frame_options* a_opts) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
   }
-  switch (coro_susp_point) {
-    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
-
-    while (true) {
-      {
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
-        if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-          goto suspend;
-        }
-        uint8_t t_0 = *iop_a_src++;
-        v_block_size = t_0;
-      }
-      if (v_block_size == 0) {
-        status = wuffs_base__make_status(NULL);
-        goto ok;
-      }
-      if (v_block_size != 11) {
-        self->private_data.s_decode_ae[0].scratch = ((uint32_t)(v_block_size));
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
-        if (self->private_data.s_decode_ae[0].scratch >
-            ((uint64_t)(io2_a_src - iop_a_src))) {
-          self->private_data.s_decode_ae[0].scratch -=
-              ((uint64_t)(io2_a_src - iop_a_src));
-          iop_a_src = io2_a_src;
-          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-          goto suspend;
-        }
-        iop_a_src += self->private_data.s_decode_ae[0].scratch;
-        goto label__goto_done__break;
-      }
-      v_is_animexts = true;
-      v_is_netscape = true;
-      v_is_iccp = true;
-      v_is_xmp = true;
-      v_block_size = 0;
-      while (v_block_size < 11) {
-        {
-          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
-          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-            status =
-                wuffs_base__make_status(wuffs_base__suspension__short_read);
-            goto suspend;
-          }
-          uint8_t t_1 = *iop_a_src++;
-          v_c = t_1;
-        }
-        v_is_animexts =
-            (v_is_animexts && (v_c == wuffs_gif__animexts1dot0[v_block_size]));
-        v_is_netscape =
-            (v_is_netscape && (v_c == wuffs_gif__netscape2dot0[v_block_size]));
-        v_is_iccp =
-            (v_is_iccp && (v_c == wuffs_gif__iccrgbg1012[v_block_size]));
-        v_is_xmp = (v_is_xmp && (v_c == wuffs_gif__xmpdataxmp[v_block_size]));
-#if defined(__GNUC__)
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wconversion"
-#endif
-        v_block_size += 1;
-#if defined(__GNUC__)
-#pragma GCC diagnostic pop
-#endif
-      }
-      if (v_is_animexts || v_is_netscape) {
-        {
-          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
-          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-            status =
-                wuffs_base__make_status(wuffs_base__suspension__short_read);
-            goto suspend;
-          }
-          uint8_t t_2 = *iop_a_src++;
-          v_block_size = t_2;
-        }
-        if (v_block_size != 3) {
-          self->private_data.s_decode_ae[0].scratch =
-              ((uint32_t)(v_block_size));
-          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(5);
-          if (self->private_data.s_decode_ae[0].scratch >
-              ((uint64_t)(io2_a_src - iop_a_src))) {
-            self->private_data.s_decode_ae[0].scratch -=
-                ((uint64_t)(io2_a_src - iop_a_src));
-            iop_a_src = io2_a_src;
-            status =
-                wuffs_base__make_status(wuffs_base__suspension__short_read);
-            goto suspend;
-          }
-          iop_a_src += self->private_data.s_decode_ae[0].scratch;
-          goto label__goto_done__break;
-        }
-        {
-          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(6);
-          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-            status =
-                wuffs_base__make_status(wuffs_base__suspension__short_read);
-            goto suspend;
-          }
-          uint8_t t_3 = *iop_a_src++;
-          v_c = t_3;
-        }
-        if (v_c != 1) {
-          self->private_data.s_decode_ae[0].scratch = 2;
-          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(7);
-          if (self->private_data.s_decode_ae[0].scratch >
-              ((uint64_t)(io2_a_src - iop_a_src))) {
-            self->private_data.s_decode_ae[0].scratch -=
-                ((uint64_t)(io2_a_src - iop_a_src));
-            iop_a_src = io2_a_src;
-            status =
-                wuffs_base__make_status(wuffs_base__suspension__short_read);
-            goto suspend;
-          }
-          iop_a_src += self->private_data.s_decode_ae[0].scratch;
-          goto label__goto_done__break;
-        }
-        {
-          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(8);
-          uint32_t t_4;
-          if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
-            t_4 = ((uint32_t)(
-                wuffs_base__load_u16le__no_bounds_check(iop_a_src)));
-            iop_a_src += 2;
-          } else {
-            self->private_data.s_decode_ae[0].scratch = 0;
-            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(9);
-            while (true) {
-              if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-                status =
-                    wuffs_base__make_status(wuffs_base__suspension__short_read);
-                goto suspend;
-              }
-              uint64_t* scratch = &self->private_data.s_decode_ae[0].scratch;
-              uint32_t num_bits_4 = ((uint32_t)(*scratch >> 56));
-              *scratch <<= 8;
-              *scratch >>= 8;
-              *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_4;
-              if (num_bits_4 == 8) {
-                t_4 = ((uint32_t)(*scratch));
-                break;
-              }
-              num_bits_4 += 8;
-              *scratch |= ((uint64_t)(num_bits_4)) << 56;
-            }
-          }
-          self->private_impl.f_num_loops = t_4;
-        }
-        self->private_impl.f_seen_num_loops = true;
-        if ((0 < self->private_impl.f_num_loops) &&
-            (self->private_impl.f_num_loops <= 65535)) {
-          self->private_impl.f_num_loops += 1;
-        }
-      } else if (self->private_impl.f_ignore_metadata) {
-      } else if (v_is_iccp && self->private_impl.f_report_metadata_iccp) {
-        while (((uint64_t)(io2_a_src - iop_a_src)) <= 0) {
-          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-          WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(10);
-        }
-        self->private_impl.f_metadata_chunk_length_value =
-            ((uint64_t)(wuffs_base__load_u8be__no_bounds_check(iop_a_src)));
-        (iop_a_src += 1, wuffs_base__make_empty_struct());
-        self->private_impl.f_metadata_fourcc_value = 1229144912;
-        self->private_impl.f_metadata_io_position = wuffs_base__u64__sat_add(
-            wuffs_base__u64__sat_add(a_src->meta.pos,
-                                     ((uint64_t)(iop_a_src - io0_a_src))),
-            self->private_impl.f_metadata_chunk_length_value);
-        self->private_impl.f_call_sequence = 1;
-        status = wuffs_base__make_status(wuffs_base__note__metadata_reported);
-        goto ok;
-      } else if (v_is_xmp && self->private_impl.f_report_metadata_xmp) {
-        while (((uint64_t)(io2_a_src - iop_a_src)) <= 0) {
-          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-          WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(11);
-        }
-        self->private_impl.f_metadata_chunk_length_value =
-            ((uint64_t)(wuffs_base__load_u8be__no_bounds_check(iop_a_src)));
-        if (self->private_impl.f_metadata_chunk_length_value > 0) {
-          self->private_impl.f_metadata_chunk_length_value += 1;
-        } else {
-          (iop_a_src += 1, wuffs_base__make_empty_struct());
-        }
-        self->private_impl.f_metadata_fourcc_value = 1481461792;
-        self->private_impl.f_metadata_io_position = wuffs_base__u64__sat_add(
-            wuffs_base__u64__sat_add(a_src->meta.pos,
-                                     ((uint64_t)(iop_a_src - io0_a_src))),
-            self->private_impl.f_metadata_chunk_length_value);
-        self->private_impl.f_call_sequence = 1;
-        status = wuffs_base__make_status(wuffs_base__note__metadata_reported);
-        goto ok;
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_status(
+        (self->private_impl.magic == WUFFS_BASE__DISABLED)
+            ? wuffs_base__error__disabled_by_previous_error
+            : wuffs_base__error__initialize_not_called);
+  }
+  if (!a_dst || !a_src) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+  }
+  if ((self->private_impl.active_coroutine != 0) &&
+      (self->private_impl.active_coroutine != 5)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(
+        wuffs_base__error__interleaved_coroutine_calls);
+  }
+  self->private_impl.active_coroutine = 0;
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint32_t coro_susp_point = self->private_impl.p_decode_frame[0];
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    self->private_impl.f_ignore_metadata = true;
+    if (self->private_impl.f_call_sequence != 4) {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+      status = wuffs_gif__decoder__decode_frame_config(self, NULL, a_src);
+      if (status.repr) {
+        goto suspend;
       }
-      goto label__goto_done__break;
     }
-  label__goto_done__break:;
-    if (a_src) {
-      a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+    if (self->private_impl.f_quirk_enabled_reject_empty_frame &&
+        ((self->private_impl.f_frame_rect_x0 ==
+          self->private_impl.f_frame_rect_x1) ||
+         (self->private_impl.f_frame_rect_y0 ==
+          self->private_impl.f_frame_rect_y1))) {
+      status = wuffs_base__make_status(wuffs_gif__error__bad_frame_size);
+      goto exit;
     }
-    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(12);
-    status = wuffs_gif__config_decoder__skip_blocks(self, a_src);
-    if (a_src) {
-      iop_a_src = a_src->data.ptr + a_src->meta.ri;
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+    status = wuffs_gif__decoder__decode_id_part1(self, a_dst, a_src, a_blend);
+    if (status.repr) {
+      goto suspend;
     }
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+    status = wuffs_gif__decoder__decode_id_part2(self, a_dst, a_src, a_workbuf);
     if (status.repr) {
       goto suspend;
     }
+    wuffs_base__u64__sat_add_indirect(
+        &self->private_impl.f_num_decoded_frames_value, 1);
+    wuffs_gif__decoder__reset_gc(self);
 
     goto ok;
   ok:
-    self->private_impl.p_decode_ae[0] = 0;
+    self->private_impl.p_decode_frame[0] = 0;
     goto exit;
   }
 
   goto suspend;
 suspend:
-  self->private_impl.p_decode_ae[0] =
+  self->private_impl.p_decode_frame[0] =
       wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
-  self->private_data.s_decode_ae[0].v_block_size = v_block_size;
-  self->private_data.s_decode_ae[0].v_is_animexts = v_is_animexts;
-  self->private_data.s_decode_ae[0].v_is_netscape = v_is_netscape;
-  self->private_data.s_decode_ae[0].v_is_iccp = v_is_iccp;
-  self->private_data.s_decode_ae[0].v_is_xmp = v_is_xmp;
+  self->private_impl.active_coroutine =
+      wuffs_base__status__is_suspension(&status) ? 5 : 0;
 
   goto exit;
 exit:
-  if (a_src) {
-    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  if (wuffs_base__status__is_error(&status)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
   }
-
   return status;
 }
 
-// -------- func gif.config_decoder.decode_gc
+// -------- func gif.decoder.reset_gc
+
+static wuffs_base__empty_struct  //
+wuffs_gif__decoder__reset_gc(wuffs_gif__decoder* self) {
+  self->private_impl.f_call_sequence = 5;
+  self->private_impl.f_gc_has_transparent_index = false;
+  self->private_impl.f_gc_transparent_index = 0;
+  self->private_impl.f_gc_disposal = 0;
+  self->private_impl.f_gc_duration = 0;
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func gif.decoder.decode_up_to_id_part1
 
 static wuffs_base__status  //
-wuffs_gif__config_decoder__decode_gc(wuffs_gif__config_decoder* self,
-                                     wuffs_base__io_buffer* a_src) {
+wuffs_gif__decoder__decode_up_to_id_part1(wuffs_gif__decoder* self,
+                                          wuffs_base__io_buffer* a_src) {
   wuffs_base__status status = wuffs_base__make_status(NULL);
 
-  uint8_t v_c = 0;
-  uint8_t v_flags = 0;
-  uint16_t v_gc_duration_centiseconds = 0;
+  uint8_t v_block_type = 0;
 
   uint8_t* iop_a_src = NULL;
   uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
@@ -16955,106 +24095,158 @@ wuffs_gif__config_decoder__decode_gc(wuffs_gif__config_decoder* self,
     io2_a_src = io0_a_src + a_src->meta.wi;
   }
 
-  uint32_t coro_susp_point = self->private_impl.p_decode_gc[0];
+  uint32_t coro_susp_point = self->private_impl.p_decode_up_to_id_part1[0];
   switch (coro_susp_point) {
     WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
 
-    {
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
-      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-        goto suspend;
+    if (!self->private_impl.f_restarted) {
+      if (self->private_impl.f_call_sequence != 2) {
+        self->private_impl.f_frame_config_io_position =
+            wuffs_base__u64__sat_add(a_src->meta.pos,
+                                     ((uint64_t)(iop_a_src - io0_a_src)));
       }
-      uint8_t t_0 = *iop_a_src++;
-      v_c = t_0;
-    }
-    if (v_c != 4) {
-      status = wuffs_base__make_status(wuffs_gif__error__bad_graphic_control);
+    } else if (self->private_impl.f_frame_config_io_position !=
+               wuffs_base__u64__sat_add(a_src->meta.pos,
+                                        ((uint64_t)(iop_a_src - io0_a_src)))) {
+      status = wuffs_base__make_status(wuffs_base__error__bad_restart);
       goto exit;
-    }
-    {
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
-      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-        goto suspend;
-      }
-      uint8_t t_1 = *iop_a_src++;
-      v_flags = t_1;
-    }
-    self->private_impl.f_gc_has_transparent_index = ((v_flags & 1) != 0);
-    v_flags = ((v_flags >> 2) & 7);
-    if (v_flags == 2) {
-      self->private_impl.f_gc_disposal = 1;
-    } else if ((v_flags == 3) || (v_flags == 4)) {
-      self->private_impl.f_gc_disposal = 2;
     } else {
-      self->private_impl.f_gc_disposal = 0;
+      self->private_impl.f_restarted = false;
     }
-    {
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
-      uint16_t t_2;
-      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
-        t_2 = wuffs_base__load_u16le__no_bounds_check(iop_a_src);
-        iop_a_src += 2;
-      } else {
-        self->private_data.s_decode_gc[0].scratch = 0;
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
-        while (true) {
-          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-            status =
-                wuffs_base__make_status(wuffs_base__suspension__short_read);
-            goto suspend;
-          }
-          uint64_t* scratch = &self->private_data.s_decode_gc[0].scratch;
-          uint32_t num_bits_2 = ((uint32_t)(*scratch >> 56));
-          *scratch <<= 8;
-          *scratch >>= 8;
-          *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_2;
-          if (num_bits_2 == 8) {
-            t_2 = ((uint16_t)(*scratch));
-            break;
-          }
-          num_bits_2 += 8;
-          *scratch |= ((uint64_t)(num_bits_2)) << 56;
+    while (true) {
+      {
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+        if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+          goto suspend;
         }
+        uint8_t t_0 = *iop_a_src++;
+        v_block_type = t_0;
       }
-      v_gc_duration_centiseconds = t_2;
-    }
-    self->private_impl.f_gc_duration =
-        (((uint64_t)(v_gc_duration_centiseconds)) * 7056000);
-    {
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(5);
-      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-        goto suspend;
+      if (v_block_type == 33) {
+        if (a_src) {
+          a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+        }
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+        status = wuffs_gif__decoder__decode_extension(self, a_src);
+        if (a_src) {
+          iop_a_src = a_src->data.ptr + a_src->meta.ri;
+        }
+        if (status.repr) {
+          goto suspend;
+        }
+      } else if (v_block_type == 44) {
+        if (self->private_impl.f_delayed_num_decoded_frames) {
+          self->private_impl.f_delayed_num_decoded_frames = false;
+          wuffs_base__u64__sat_add_indirect(
+              &self->private_impl.f_num_decoded_frames_value, 1);
+        }
+        if (a_src) {
+          a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+        }
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+        status = wuffs_gif__decoder__decode_id_part0(self, a_src);
+        if (a_src) {
+          iop_a_src = a_src->data.ptr + a_src->meta.ri;
+        }
+        if (status.repr) {
+          goto suspend;
+        }
+        goto label__0__break;
+      } else if (v_block_type == 59) {
+        if (self->private_impl.f_delayed_num_decoded_frames) {
+          self->private_impl.f_delayed_num_decoded_frames = false;
+          wuffs_base__u64__sat_add_indirect(
+              &self->private_impl.f_num_decoded_frames_value, 1);
+        }
+        self->private_impl.f_end_of_data = true;
+        goto label__0__break;
+      } else {
+        status = wuffs_base__make_status(wuffs_gif__error__bad_block);
+        goto exit;
       }
-      uint8_t t_3 = *iop_a_src++;
-      self->private_impl.f_gc_transparent_index = t_3;
     }
-    {
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(6);
-      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-        goto suspend;
+  label__0__break:;
+
+    goto ok;
+  ok:
+    self->private_impl.p_decode_up_to_id_part1[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+suspend:
+  self->private_impl.p_decode_up_to_id_part1[0] =
+      wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+
+  goto exit;
+exit:
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  return status;
+}
+
+// -------- func gif.decoder.decode_header
+
+static wuffs_base__status  //
+wuffs_gif__decoder__decode_header(wuffs_gif__decoder* self,
+                                  wuffs_base__io_buffer* a_src) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint8_t v_c[6] = {0};
+  uint32_t v_i = 0;
+
+  uint8_t* iop_a_src = NULL;
+  uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_decode_header[0];
+  if (coro_susp_point) {
+    memcpy(v_c, self->private_data.s_decode_header[0].v_c, sizeof(v_c));
+    v_i = self->private_data.s_decode_header[0].v_i;
+  }
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    while (v_i < 6) {
+      {
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+        if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+          goto suspend;
+        }
+        uint8_t t_0 = *iop_a_src++;
+        v_c[v_i] = t_0;
       }
-      uint8_t t_4 = *iop_a_src++;
-      v_c = t_4;
+      v_i += 1;
     }
-    if (v_c != 0) {
-      status = wuffs_base__make_status(wuffs_gif__error__bad_graphic_control);
+    if ((v_c[0] != 71) || (v_c[1] != 73) || (v_c[2] != 70) || (v_c[3] != 56) ||
+        ((v_c[4] != 55) && (v_c[4] != 57)) || (v_c[5] != 97)) {
+      status = wuffs_base__make_status(wuffs_gif__error__bad_header);
       goto exit;
     }
 
     goto ok;
   ok:
-    self->private_impl.p_decode_gc[0] = 0;
+    self->private_impl.p_decode_header[0] = 0;
     goto exit;
   }
 
   goto suspend;
 suspend:
-  self->private_impl.p_decode_gc[0] =
+  self->private_impl.p_decode_header[0] =
       wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  memcpy(self->private_data.s_decode_header[0].v_c, v_c, sizeof(v_c));
+  self->private_data.s_decode_header[0].v_i = v_i;
 
   goto exit;
 exit:
@@ -17065,13 +24257,20 @@ exit:
   return status;
 }
 
-// -------- func gif.config_decoder.decode_id_part0
+// -------- func gif.decoder.decode_lsd
 
 static wuffs_base__status  //
-wuffs_gif__config_decoder__decode_id_part0(wuffs_gif__config_decoder* self,
-                                           wuffs_base__io_buffer* a_src) {
+wuffs_gif__decoder__decode_lsd(wuffs_gif__decoder* self,
+                               wuffs_base__io_buffer* a_src) {
   wuffs_base__status status = wuffs_base__make_status(NULL);
 
+  uint8_t v_flags = 0;
+  uint8_t v_background_color_index = 0;
+  uint32_t v_num_palette_entries = 0;
+  uint32_t v_i = 0;
+  uint32_t v_j = 0;
+  uint32_t v_argb = 0;
+
   uint8_t* iop_a_src = NULL;
   uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
   uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
@@ -17083,7 +24282,15 @@ wuffs_gif__config_decoder__decode_id_part0(wuffs_gif__config_decoder* self,
     io2_a_src = io0_a_src + a_src->meta.wi;
   }
 
-  uint32_t coro_susp_point = self->private_impl.p_decode_id_part0[0];
+  uint32_t coro_susp_point = self->private_impl.p_decode_lsd[0];
+  if (coro_susp_point) {
+    v_flags = self->private_data.s_decode_lsd[0].v_flags;
+    v_background_color_index =
+        self->private_data.s_decode_lsd[0].v_background_color_index;
+    v_num_palette_entries =
+        self->private_data.s_decode_lsd[0].v_num_palette_entries;
+    v_i = self->private_data.s_decode_lsd[0].v_i;
+  }
   switch (coro_susp_point) {
     WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
 
@@ -17094,7 +24301,7 @@ wuffs_gif__config_decoder__decode_id_part0(wuffs_gif__config_decoder* self,
         t_0 = ((uint32_t)(wuffs_base__load_u16le__no_bounds_check(iop_a_src)));
         iop_a_src += 2;
       } else {
-        self->private_data.s_decode_id_part0[0].scratch = 0;
+        self->private_data.s_decode_lsd[0].scratch = 0;
         WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
         while (true) {
           if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
@@ -17102,7 +24309,7 @@ wuffs_gif__config_decoder__decode_id_part0(wuffs_gif__config_decoder* self,
                 wuffs_base__make_status(wuffs_base__suspension__short_read);
             goto suspend;
           }
-          uint64_t* scratch = &self->private_data.s_decode_id_part0[0].scratch;
+          uint64_t* scratch = &self->private_data.s_decode_lsd[0].scratch;
           uint32_t num_bits_0 = ((uint32_t)(*scratch >> 56));
           *scratch <<= 8;
           *scratch >>= 8;
@@ -17115,308 +24322,170 @@ wuffs_gif__config_decoder__decode_id_part0(wuffs_gif__config_decoder* self,
           *scratch |= ((uint64_t)(num_bits_0)) << 56;
         }
       }
-      self->private_impl.f_frame_rect_x0 = t_0;
-    }
-    {
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
-      uint32_t t_1;
-      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
-        t_1 = ((uint32_t)(wuffs_base__load_u16le__no_bounds_check(iop_a_src)));
-        iop_a_src += 2;
-      } else {
-        self->private_data.s_decode_id_part0[0].scratch = 0;
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
-        while (true) {
-          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-            status =
-                wuffs_base__make_status(wuffs_base__suspension__short_read);
-            goto suspend;
-          }
-          uint64_t* scratch = &self->private_data.s_decode_id_part0[0].scratch;
-          uint32_t num_bits_1 = ((uint32_t)(*scratch >> 56));
-          *scratch <<= 8;
-          *scratch >>= 8;
-          *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_1;
-          if (num_bits_1 == 8) {
-            t_1 = ((uint32_t)(*scratch));
-            break;
-          }
-          num_bits_1 += 8;
-          *scratch |= ((uint64_t)(num_bits_1)) << 56;
-        }
-      }
-      self->private_impl.f_frame_rect_y0 = t_1;
-    }
-    {
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(5);
-      uint32_t t_2;
-      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
-        t_2 = ((uint32_t)(wuffs_base__load_u16le__no_bounds_check(iop_a_src)));
-        iop_a_src += 2;
-      } else {
-        self->private_data.s_decode_id_part0[0].scratch = 0;
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(6);
-        while (true) {
-          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-            status =
-                wuffs_base__make_status(wuffs_base__suspension__short_read);
-            goto suspend;
-          }
-          uint64_t* scratch = &self->private_data.s_decode_id_part0[0].scratch;
-          uint32_t num_bits_2 = ((uint32_t)(*scratch >> 56));
-          *scratch <<= 8;
-          *scratch >>= 8;
-          *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_2;
-          if (num_bits_2 == 8) {
-            t_2 = ((uint32_t)(*scratch));
-            break;
-          }
-          num_bits_2 += 8;
-          *scratch |= ((uint64_t)(num_bits_2)) << 56;
-        }
-      }
-      self->private_impl.f_frame_rect_x1 = t_2;
-    }
-    self->private_impl.f_frame_rect_x1 += self->private_impl.f_frame_rect_x0;
-    {
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(7);
-      uint32_t t_3;
-      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
-        t_3 = ((uint32_t)(wuffs_base__load_u16le__no_bounds_check(iop_a_src)));
-        iop_a_src += 2;
-      } else {
-        self->private_data.s_decode_id_part0[0].scratch = 0;
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(8);
-        while (true) {
-          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-            status =
-                wuffs_base__make_status(wuffs_base__suspension__short_read);
-            goto suspend;
-          }
-          uint64_t* scratch = &self->private_data.s_decode_id_part0[0].scratch;
-          uint32_t num_bits_3 = ((uint32_t)(*scratch >> 56));
-          *scratch <<= 8;
-          *scratch >>= 8;
-          *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_3;
-          if (num_bits_3 == 8) {
-            t_3 = ((uint32_t)(*scratch));
-            break;
-          }
-          num_bits_3 += 8;
-          *scratch |= ((uint64_t)(num_bits_3)) << 56;
-        }
-      }
-      self->private_impl.f_frame_rect_y1 = t_3;
-    }
-    self->private_impl.f_frame_rect_y1 += self->private_impl.f_frame_rect_y0;
-    if ((self->private_impl.f_call_sequence == 0) &&
-        !self->private_impl.f_quirk_enabled_image_bounds_are_strict) {
-      self->private_impl.f_width = wuffs_base__u32__max(
-          self->private_impl.f_width, self->private_impl.f_frame_rect_x1);
-      self->private_impl.f_height = wuffs_base__u32__max(
-          self->private_impl.f_height, self->private_impl.f_frame_rect_y1);
-    }
-
-    goto ok;
-  ok:
-    self->private_impl.p_decode_id_part0[0] = 0;
-    goto exit;
-  }
-
-  goto suspend;
-suspend:
-  self->private_impl.p_decode_id_part0[0] =
-      wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
-
-  goto exit;
-exit:
-  if (a_src) {
-    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
-  }
-
-  return status;
-}
-
-// -------- func gif.decoder.set_quirk_enabled
-
-WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
-wuffs_gif__decoder__set_quirk_enabled(wuffs_gif__decoder* self,
-                                      uint32_t a_quirk,
-                                      bool a_enabled) {
-  if (!self) {
-    return wuffs_base__make_empty_struct();
-  }
-  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
-    return wuffs_base__make_empty_struct();
-  }
-
-  if (self->private_impl.f_call_sequence == 0) {
-    if (a_quirk == 1041635328) {
-      self->private_impl.f_quirk_enabled_delay_num_decoded_frames = a_enabled;
-    } else if (a_quirk == 1041635329) {
-      self->private_impl
-          .f_quirk_enabled_first_frame_local_palette_means_black_background =
-          a_enabled;
-    } else if (a_quirk == 1041635330) {
-      self->private_impl.f_quirk_enabled_honor_background_color = a_enabled;
-    } else if (a_quirk == 1041635331) {
-      self->private_impl.f_quirk_enabled_ignore_too_much_pixel_data = a_enabled;
-    } else if (a_quirk == 1041635332) {
-      self->private_impl.f_quirk_enabled_image_bounds_are_strict = a_enabled;
-    } else if (a_quirk == 1041635333) {
-      self->private_impl.f_quirk_enabled_reject_empty_frame = a_enabled;
-    } else if (a_quirk == 1041635334) {
-      self->private_impl.f_quirk_enabled_reject_empty_palette = a_enabled;
+      self->private_impl.f_width = t_0;
     }
-  }
-  return wuffs_base__make_empty_struct();
-}
-
-// -------- func gif.decoder.decode_image_config
-
-WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
-wuffs_gif__decoder__decode_image_config(wuffs_gif__decoder* self,
-                                        wuffs_base__image_config* a_dst,
-                                        wuffs_base__io_buffer* a_src) {
-  if (!self) {
-    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
-  }
-  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
-    return wuffs_base__make_status(
-        (self->private_impl.magic == WUFFS_BASE__DISABLED)
-            ? wuffs_base__error__disabled_by_previous_error
-            : wuffs_base__error__initialize_not_called);
-  }
-  if (!a_src) {
-    self->private_impl.magic = WUFFS_BASE__DISABLED;
-    return wuffs_base__make_status(wuffs_base__error__bad_argument);
-  }
-  if ((self->private_impl.active_coroutine != 0) &&
-      (self->private_impl.active_coroutine != 1)) {
-    self->private_impl.magic = WUFFS_BASE__DISABLED;
-    return wuffs_base__make_status(
-        wuffs_base__error__interleaved_coroutine_calls);
-  }
-  self->private_impl.active_coroutine = 0;
-  wuffs_base__status status = wuffs_base__make_status(NULL);
-
-  bool v_ffio = false;
-
-  uint32_t coro_susp_point = self->private_impl.p_decode_image_config[0];
-  switch (coro_susp_point) {
-    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
-
-    if (self->private_impl.f_call_sequence == 0) {
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
-      status = wuffs_gif__decoder__decode_header(self, a_src);
-      if (status.repr) {
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+      uint32_t t_1;
+      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
+        t_1 = ((uint32_t)(wuffs_base__load_u16le__no_bounds_check(iop_a_src)));
+        iop_a_src += 2;
+      } else {
+        self->private_data.s_decode_lsd[0].scratch = 0;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+        while (true) {
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status =
+                wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint64_t* scratch = &self->private_data.s_decode_lsd[0].scratch;
+          uint32_t num_bits_1 = ((uint32_t)(*scratch >> 56));
+          *scratch <<= 8;
+          *scratch >>= 8;
+          *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_1;
+          if (num_bits_1 == 8) {
+            t_1 = ((uint32_t)(*scratch));
+            break;
+          }
+          num_bits_1 += 8;
+          *scratch |= ((uint64_t)(num_bits_1)) << 56;
+        }
+      }
+      self->private_impl.f_height = t_1;
+    }
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(5);
+      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
         goto suspend;
       }
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
-      status = wuffs_gif__decoder__decode_lsd(self, a_src);
-      if (status.repr) {
+      uint8_t t_2 = *iop_a_src++;
+      v_flags = t_2;
+    }
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(6);
+      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
         goto suspend;
       }
-    } else if (self->private_impl.f_call_sequence != 2) {
-      status = wuffs_base__make_status(wuffs_base__error__bad_call_sequence);
-      goto exit;
+      uint8_t t_3 = *iop_a_src++;
+      v_background_color_index = t_3;
     }
-    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
-    status = wuffs_gif__decoder__decode_up_to_id_part1(self, a_src);
-    if (status.repr) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(7);
+    if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+      status = wuffs_base__make_status(wuffs_base__suspension__short_read);
       goto suspend;
     }
-    v_ffio = !self->private_impl.f_gc_has_transparent_index;
-    if (!self->private_impl.f_quirk_enabled_honor_background_color) {
-      v_ffio =
-          (v_ffio && (self->private_impl.f_frame_rect_x0 == 0) &&
-           (self->private_impl.f_frame_rect_y0 == 0) &&
-           (self->private_impl.f_frame_rect_x1 == self->private_impl.f_width) &&
-           (self->private_impl.f_frame_rect_y1 == self->private_impl.f_height));
-    } else if (v_ffio) {
-      self->private_impl.f_black_color_u32_argb_premul = 4278190080;
-    }
-    if (self->private_impl.f_background_color_u32_argb_premul == 77) {
-      self->private_impl.f_background_color_u32_argb_premul =
-          self->private_impl.f_black_color_u32_argb_premul;
+    iop_a_src++;
+    v_i = 0;
+    self->private_impl.f_has_global_palette = ((v_flags & 128) != 0);
+    if (self->private_impl.f_has_global_palette) {
+      v_num_palette_entries = (((uint32_t)(1)) << (1 + (v_flags & 7)));
+      while (v_i < v_num_palette_entries) {
+        {
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(8);
+          uint32_t t_4;
+          if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 3)) {
+            t_4 = ((uint32_t)(
+                wuffs_base__load_u24be__no_bounds_check(iop_a_src)));
+            iop_a_src += 3;
+          } else {
+            self->private_data.s_decode_lsd[0].scratch = 0;
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(9);
+            while (true) {
+              if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+                status =
+                    wuffs_base__make_status(wuffs_base__suspension__short_read);
+                goto suspend;
+              }
+              uint64_t* scratch = &self->private_data.s_decode_lsd[0].scratch;
+              uint32_t num_bits_4 = ((uint32_t)(*scratch & 0xFF));
+              *scratch >>= 8;
+              *scratch <<= 8;
+              *scratch |= ((uint64_t)(*iop_a_src++)) << (56 - num_bits_4);
+              if (num_bits_4 == 16) {
+                t_4 = ((uint32_t)(*scratch >> 40));
+                break;
+              }
+              num_bits_4 += 8;
+              *scratch |= ((uint64_t)(num_bits_4));
+            }
+          }
+          v_argb = t_4;
+        }
+        v_argb |= 4278190080;
+        self->private_data.f_palettes[0][((4 * v_i) + 0)] =
+            ((uint8_t)(((v_argb >> 0) & 255)));
+        self->private_data.f_palettes[0][((4 * v_i) + 1)] =
+            ((uint8_t)(((v_argb >> 8) & 255)));
+        self->private_data.f_palettes[0][((4 * v_i) + 2)] =
+            ((uint8_t)(((v_argb >> 16) & 255)));
+        self->private_data.f_palettes[0][((4 * v_i) + 3)] =
+            ((uint8_t)(((v_argb >> 24) & 255)));
+        v_i += 1;
+      }
+      if (self->private_impl.f_quirk_enabled_honor_background_color) {
+        if ((v_background_color_index != 0) &&
+            (((uint32_t)(v_background_color_index)) < v_num_palette_entries)) {
+          v_j = (4 * ((uint32_t)(v_background_color_index)));
+          self->private_impl.f_background_color_u32_argb_premul =
+              ((((uint32_t)(self->private_data.f_palettes[0][(v_j + 0)]))
+                << 0) |
+               (((uint32_t)(self->private_data.f_palettes[0][(v_j + 1)]))
+                << 8) |
+               (((uint32_t)(self->private_data.f_palettes[0][(v_j + 2)]))
+                << 16) |
+               (((uint32_t)(self->private_data.f_palettes[0][(v_j + 3)]))
+                << 24));
+        } else {
+          self->private_impl.f_background_color_u32_argb_premul = 77;
+        }
+      }
     }
-    if (a_dst != NULL) {
-      wuffs_base__image_config__set(
-          a_dst, 1191444488, 0, self->private_impl.f_width,
-          self->private_impl.f_height,
-          self->private_impl.f_frame_config_io_position, v_ffio);
+    while (v_i < 256) {
+      self->private_data.f_palettes[0][((4 * v_i) + 0)] = 0;
+      self->private_data.f_palettes[0][((4 * v_i) + 1)] = 0;
+      self->private_data.f_palettes[0][((4 * v_i) + 2)] = 0;
+      self->private_data.f_palettes[0][((4 * v_i) + 3)] = 255;
+      v_i += 1;
     }
-    self->private_impl.f_call_sequence = 3;
 
     goto ok;
   ok:
-    self->private_impl.p_decode_image_config[0] = 0;
+    self->private_impl.p_decode_lsd[0] = 0;
     goto exit;
   }
 
   goto suspend;
 suspend:
-  self->private_impl.p_decode_image_config[0] =
+  self->private_impl.p_decode_lsd[0] =
       wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
-  self->private_impl.active_coroutine =
-      wuffs_base__status__is_suspension(&status) ? 1 : 0;
+  self->private_data.s_decode_lsd[0].v_flags = v_flags;
+  self->private_data.s_decode_lsd[0].v_background_color_index =
+      v_background_color_index;
+  self->private_data.s_decode_lsd[0].v_num_palette_entries =
+      v_num_palette_entries;
+  self->private_data.s_decode_lsd[0].v_i = v_i;
 
   goto exit;
 exit:
-  if (wuffs_base__status__is_error(&status)) {
-    self->private_impl.magic = WUFFS_BASE__DISABLED;
-  }
-  return status;
-}
-
-// -------- func gif.decoder.set_report_metadata
-
-WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
-wuffs_gif__decoder__set_report_metadata(wuffs_gif__decoder* self,
-                                        uint32_t a_fourcc,
-                                        bool a_report) {
-  if (!self) {
-    return wuffs_base__make_empty_struct();
-  }
-  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
-    return wuffs_base__make_empty_struct();
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
   }
 
-  if (a_fourcc == 1229144912) {
-    self->private_impl.f_report_metadata_iccp = a_report;
-  } else if (a_fourcc == 1481461792) {
-    self->private_impl.f_report_metadata_xmp = a_report;
-  }
-  return wuffs_base__make_empty_struct();
+  return status;
 }
 
-// -------- func gif.decoder.ack_metadata_chunk
+// -------- func gif.decoder.decode_extension
 
-WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
-wuffs_gif__decoder__ack_metadata_chunk(wuffs_gif__decoder* self,
-                                       wuffs_base__io_buffer* a_src) {
-  if (!self) {
-    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
-  }
-  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
-    return wuffs_base__make_status(
-        (self->private_impl.magic == WUFFS_BASE__DISABLED)
-            ? wuffs_base__error__disabled_by_previous_error
-            : wuffs_base__error__initialize_not_called);
-  }
-  if (!a_src) {
-    self->private_impl.magic = WUFFS_BASE__DISABLED;
-    return wuffs_base__make_status(wuffs_base__error__bad_argument);
-  }
-  if ((self->private_impl.active_coroutine != 0) &&
-      (self->private_impl.active_coroutine != 2)) {
-    self->private_impl.magic = WUFFS_BASE__DISABLED;
-    return wuffs_base__make_status(
-        wuffs_base__error__interleaved_coroutine_calls);
-  }
-  self->private_impl.active_coroutine = 0;
+static wuffs_base__status  //
+wuffs_gif__decoder__decode_extension(wuffs_gif__decoder* self,
+                                     wuffs_base__io_buffer* a_src) {
   wuffs_base__status status = wuffs_base__make_status(NULL);
 
+  uint8_t v_label = 0;
+
   uint8_t* iop_a_src = NULL;
   uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
   uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
@@ -17428,59 +24497,70 @@ wuffs_gif__decoder__ack_metadata_chunk(wuffs_gif__decoder* self,
     io2_a_src = io0_a_src + a_src->meta.wi;
   }
 
-  uint32_t coro_susp_point = self->private_impl.p_ack_metadata_chunk[0];
+  uint32_t coro_susp_point = self->private_impl.p_decode_extension[0];
   switch (coro_susp_point) {
     WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
 
-    if (self->private_impl.f_call_sequence != 1) {
-      status = wuffs_base__make_status(wuffs_base__error__bad_call_sequence);
-      goto exit;
-    }
-    if (wuffs_base__u64__sat_add(a_src->meta.pos,
-                                 ((uint64_t)(iop_a_src - io0_a_src))) !=
-        self->private_impl.f_metadata_io_position) {
-      status = wuffs_base__make_status(wuffs_base__error__bad_i_o_position);
-      goto exit;
-    }
-    if (self->private_impl.f_metadata_chunk_length_value > 0) {
-      while (((uint64_t)(io2_a_src - iop_a_src)) <= 0) {
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
         status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(1);
+        goto suspend;
+      }
+      uint8_t t_0 = *iop_a_src++;
+      v_label = t_0;
+    }
+    if (v_label == 249) {
+      if (a_src) {
+        a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+      }
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+      status = wuffs_gif__decoder__decode_gc(self, a_src);
+      if (a_src) {
+        iop_a_src = a_src->data.ptr + a_src->meta.ri;
+      }
+      if (status.repr) {
+        goto suspend;
+      }
+      status = wuffs_base__make_status(NULL);
+      goto ok;
+    } else if (v_label == 255) {
+      if (a_src) {
+        a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+      }
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+      status = wuffs_gif__decoder__decode_ae(self, a_src);
+      if (a_src) {
+        iop_a_src = a_src->data.ptr + a_src->meta.ri;
       }
-      self->private_impl.f_metadata_chunk_length_value =
-          ((uint64_t)(wuffs_base__load_u8be__no_bounds_check(iop_a_src)));
-      if (self->private_impl.f_metadata_chunk_length_value > 0) {
-        if (self->private_impl.f_metadata_fourcc_value == 1481461792) {
-          self->private_impl.f_metadata_chunk_length_value += 1;
-        } else {
-          (iop_a_src += 1, wuffs_base__make_empty_struct());
-        }
-        self->private_impl.f_metadata_io_position = wuffs_base__u64__sat_add(
-            wuffs_base__u64__sat_add(a_src->meta.pos,
-                                     ((uint64_t)(iop_a_src - io0_a_src))),
-            self->private_impl.f_metadata_chunk_length_value);
-        status = wuffs_base__make_status(wuffs_base__note__metadata_reported);
-        goto ok;
+      if (status.repr) {
+        goto suspend;
       }
-      (iop_a_src += 1, wuffs_base__make_empty_struct());
+      status = wuffs_base__make_status(NULL);
+      goto ok;
     }
-    self->private_impl.f_call_sequence = 2;
-    self->private_impl.f_metadata_fourcc_value = 0;
-    self->private_impl.f_metadata_io_position = 0;
-    status = wuffs_base__make_status(NULL);
-    goto ok;
+    if (a_src) {
+      a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+    }
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+    status = wuffs_gif__decoder__skip_blocks(self, a_src);
+    if (a_src) {
+      iop_a_src = a_src->data.ptr + a_src->meta.ri;
+    }
+    if (status.repr) {
+      goto suspend;
+    }
+
     goto ok;
   ok:
-    self->private_impl.p_ack_metadata_chunk[0] = 0;
+    self->private_impl.p_decode_extension[0] = 0;
     goto exit;
   }
 
   goto suspend;
 suspend:
-  self->private_impl.p_ack_metadata_chunk[0] =
+  self->private_impl.p_decode_extension[0] =
       wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
-  self->private_impl.active_coroutine =
-      wuffs_base__status__is_suspension(&status) ? 2 : 0;
 
   goto exit;
 exit:
@@ -17488,187 +24568,93 @@ exit:
     a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
   }
 
-  if (wuffs_base__status__is_error(&status)) {
-    self->private_impl.magic = WUFFS_BASE__DISABLED;
-  }
   return status;
 }
 
-// -------- func gif.decoder.metadata_fourcc
-
-WUFFS_BASE__MAYBE_STATIC uint32_t  //
-wuffs_gif__decoder__metadata_fourcc(const wuffs_gif__decoder* self) {
-  if (!self) {
-    return 0;
-  }
-  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
-      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
-    return 0;
-  }
-
-  return self->private_impl.f_metadata_fourcc_value;
-}
-
-// -------- func gif.decoder.metadata_chunk_length
-
-WUFFS_BASE__MAYBE_STATIC uint64_t  //
-wuffs_gif__decoder__metadata_chunk_length(const wuffs_gif__decoder* self) {
-  if (!self) {
-    return 0;
-  }
-  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
-      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
-    return 0;
-  }
-
-  return self->private_impl.f_metadata_chunk_length_value;
-}
-
-// -------- func gif.decoder.num_animation_loops
-
-WUFFS_BASE__MAYBE_STATIC uint32_t  //
-wuffs_gif__decoder__num_animation_loops(const wuffs_gif__decoder* self) {
-  if (!self) {
-    return 0;
-  }
-  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
-      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
-    return 0;
-  }
-
-  if (self->private_impl.f_seen_num_loops) {
-    return self->private_impl.f_num_loops;
-  }
-  return 1;
-}
-
-// -------- func gif.decoder.num_decoded_frame_configs
-
-WUFFS_BASE__MAYBE_STATIC uint64_t  //
-wuffs_gif__decoder__num_decoded_frame_configs(const wuffs_gif__decoder* self) {
-  if (!self) {
-    return 0;
-  }
-  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
-      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
-    return 0;
-  }
-
-  return self->private_impl.f_num_decoded_frame_configs_value;
-}
-
-// -------- func gif.decoder.num_decoded_frames
-
-WUFFS_BASE__MAYBE_STATIC uint64_t  //
-wuffs_gif__decoder__num_decoded_frames(const wuffs_gif__decoder* self) {
-  if (!self) {
-    return 0;
-  }
-  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
-      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
-    return 0;
-  }
-
-  return self->private_impl.f_num_decoded_frames_value;
-}
-
-// -------- func gif.decoder.frame_dirty_rect
-
-WUFFS_BASE__MAYBE_STATIC wuffs_base__rect_ie_u32  //
-wuffs_gif__decoder__frame_dirty_rect(const wuffs_gif__decoder* self) {
-  if (!self) {
-    return wuffs_base__utility__empty_rect_ie_u32();
-  }
-  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
-      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
-    return wuffs_base__utility__empty_rect_ie_u32();
-  }
+// -------- func gif.decoder.skip_blocks
 
-  return wuffs_base__utility__make_rect_ie_u32(
-      wuffs_base__u32__min(self->private_impl.f_frame_rect_x0,
-                           self->private_impl.f_width),
-      wuffs_base__u32__min(self->private_impl.f_frame_rect_y0,
-                           self->private_impl.f_height),
-      wuffs_base__u32__min(self->private_impl.f_frame_rect_x1,
-                           self->private_impl.f_width),
-      wuffs_base__u32__min(self->private_impl.f_dirty_max_excl_y,
-                           self->private_impl.f_height));
-}
+static wuffs_base__status  //
+wuffs_gif__decoder__skip_blocks(wuffs_gif__decoder* self,
+                                wuffs_base__io_buffer* a_src) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
 
-// -------- func gif.decoder.workbuf_len
+  uint8_t v_block_size = 0;
 
-WUFFS_BASE__MAYBE_STATIC wuffs_base__range_ii_u64  //
-wuffs_gif__decoder__workbuf_len(const wuffs_gif__decoder* self) {
-  if (!self) {
-    return wuffs_base__utility__empty_range_ii_u64();
-  }
-  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
-      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
-    return wuffs_base__utility__empty_range_ii_u64();
+  uint8_t* iop_a_src = NULL;
+  uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
   }
 
-  return wuffs_base__utility__make_range_ii_u64(0, 0);
-}
-
-// -------- func gif.decoder.restart_frame
+  uint32_t coro_susp_point = self->private_impl.p_skip_blocks[0];
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
 
-WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
-wuffs_gif__decoder__restart_frame(wuffs_gif__decoder* self,
-                                  uint64_t a_index,
-                                  uint64_t a_io_position) {
-  if (!self) {
-    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
-  }
-  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
-    return wuffs_base__make_status(
-        (self->private_impl.magic == WUFFS_BASE__DISABLED)
-            ? wuffs_base__error__disabled_by_previous_error
-            : wuffs_base__error__initialize_not_called);
-  }
+    while (true) {
+      {
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+        if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+          goto suspend;
+        }
+        uint8_t t_0 = *iop_a_src++;
+        v_block_size = t_0;
+      }
+      if (v_block_size == 0) {
+        status = wuffs_base__make_status(NULL);
+        goto ok;
+      }
+      self->private_data.s_skip_blocks[0].scratch = ((uint32_t)(v_block_size));
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+      if (self->private_data.s_skip_blocks[0].scratch >
+          ((uint64_t)(io2_a_src - iop_a_src))) {
+        self->private_data.s_skip_blocks[0].scratch -=
+            ((uint64_t)(io2_a_src - iop_a_src));
+        iop_a_src = io2_a_src;
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        goto suspend;
+      }
+      iop_a_src += self->private_data.s_skip_blocks[0].scratch;
+    }
 
-  if (self->private_impl.f_call_sequence == 0) {
-    return wuffs_base__make_status(wuffs_base__error__bad_call_sequence);
+    goto ok;
+  ok:
+    self->private_impl.p_skip_blocks[0] = 0;
+    goto exit;
   }
-  self->private_impl.f_delayed_num_decoded_frames = false;
-  self->private_impl.f_end_of_data = false;
-  self->private_impl.f_restarted = true;
-  self->private_impl.f_frame_config_io_position = a_io_position;
-  self->private_impl.f_num_decoded_frame_configs_value = a_index;
-  self->private_impl.f_num_decoded_frames_value = a_index;
-  wuffs_gif__decoder__reset_gc(self);
-  return wuffs_base__make_status(NULL);
-}
-
-// -------- func gif.decoder.decode_frame_config
 
-WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
-wuffs_gif__decoder__decode_frame_config(wuffs_gif__decoder* self,
-                                        wuffs_base__frame_config* a_dst,
-                                        wuffs_base__io_buffer* a_src) {
-  if (!self) {
-    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
-  }
-  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
-    return wuffs_base__make_status(
-        (self->private_impl.magic == WUFFS_BASE__DISABLED)
-            ? wuffs_base__error__disabled_by_previous_error
-            : wuffs_base__error__initialize_not_called);
-  }
-  if (!a_src) {
-    self->private_impl.magic = WUFFS_BASE__DISABLED;
-    return wuffs_base__make_status(wuffs_base__error__bad_argument);
-  }
-  if ((self->private_impl.active_coroutine != 0) &&
-      (self->private_impl.active_coroutine != 3)) {
-    self->private_impl.magic = WUFFS_BASE__DISABLED;
-    return wuffs_base__make_status(
-        wuffs_base__error__interleaved_coroutine_calls);
+  goto suspend;
+suspend:
+  self->private_impl.p_skip_blocks[0] =
+      wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+
+  goto exit;
+exit:
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
   }
-  self->private_impl.active_coroutine = 0;
+
+  return status;
+}
+
+// -------- func gif.decoder.decode_ae
+
+static wuffs_base__status  //
+wuffs_gif__decoder__decode_ae(wuffs_gif__decoder* self,
+                              wuffs_base__io_buffer* a_src) {
   wuffs_base__status status = wuffs_base__make_status(NULL);
 
-  uint32_t v_background_color = 0;
-  uint8_t v_flags = 0;
+  uint8_t v_c = 0;
+  uint8_t v_block_size = 0;
+  bool v_is_animexts = false;
+  bool v_is_netscape = false;
+  bool v_is_iccp = false;
+  bool v_is_xmp = false;
 
   uint8_t* iop_a_src = NULL;
   uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
@@ -17681,114 +24667,233 @@ wuffs_gif__decoder__decode_frame_config(wuffs_gif__decoder* self,
     io2_a_src = io0_a_src + a_src->meta.wi;
   }
 
-  uint32_t coro_susp_point = self->private_impl.p_decode_frame_config[0];
+  uint32_t coro_susp_point = self->private_impl.p_decode_ae[0];
   if (coro_susp_point) {
-    v_background_color =
-        self->private_data.s_decode_frame_config[0].v_background_color;
+    v_block_size = self->private_data.s_decode_ae[0].v_block_size;
+    v_is_animexts = self->private_data.s_decode_ae[0].v_is_animexts;
+    v_is_netscape = self->private_data.s_decode_ae[0].v_is_netscape;
+    v_is_iccp = self->private_data.s_decode_ae[0].v_is_iccp;
+    v_is_xmp = self->private_data.s_decode_ae[0].v_is_xmp;
   }
   switch (coro_susp_point) {
     WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
 
-    self->private_impl.f_ignore_metadata = true;
-    self->private_impl.f_dirty_max_excl_y = 0;
-    if (!self->private_impl.f_end_of_data) {
-      if (self->private_impl.f_call_sequence == 0) {
-        if (a_src) {
-          a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
-        }
+    while (true) {
+      {
         WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
-        status = wuffs_gif__decoder__decode_image_config(self, NULL, a_src);
-        if (a_src) {
-          iop_a_src = a_src->data.ptr + a_src->meta.ri;
+        if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+          goto suspend;
         }
-        if (status.repr) {
+        uint8_t t_0 = *iop_a_src++;
+        v_block_size = t_0;
+      }
+      if (v_block_size == 0) {
+        status = wuffs_base__make_status(NULL);
+        goto ok;
+      }
+      if (v_block_size != 11) {
+        self->private_data.s_decode_ae[0].scratch = ((uint32_t)(v_block_size));
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+        if (self->private_data.s_decode_ae[0].scratch >
+            ((uint64_t)(io2_a_src - iop_a_src))) {
+          self->private_data.s_decode_ae[0].scratch -=
+              ((uint64_t)(io2_a_src - iop_a_src));
+          iop_a_src = io2_a_src;
+          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
           goto suspend;
         }
-      } else if (self->private_impl.f_call_sequence != 3) {
-        if (self->private_impl.f_call_sequence == 4) {
-          if (a_src) {
-            a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+        iop_a_src += self->private_data.s_decode_ae[0].scratch;
+        goto label__goto_done__break;
+      }
+      v_is_animexts = true;
+      v_is_netscape = true;
+      v_is_iccp = true;
+      v_is_xmp = true;
+      v_block_size = 0;
+      while (v_block_size < 11) {
+        {
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status =
+                wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
           }
-          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
-          status = wuffs_gif__decoder__skip_frame(self, a_src);
-          if (a_src) {
-            iop_a_src = a_src->data.ptr + a_src->meta.ri;
+          uint8_t t_1 = *iop_a_src++;
+          v_c = t_1;
+        }
+        v_is_animexts =
+            (v_is_animexts && (v_c == wuffs_gif__animexts1dot0[v_block_size]));
+        v_is_netscape =
+            (v_is_netscape && (v_c == wuffs_gif__netscape2dot0[v_block_size]));
+        v_is_iccp =
+            (v_is_iccp && (v_c == wuffs_gif__iccrgbg1012[v_block_size]));
+        v_is_xmp = (v_is_xmp && (v_c == wuffs_gif__xmpdataxmp[v_block_size]));
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wconversion"
+#endif
+        v_block_size += 1;
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+      }
+      if (v_is_animexts || v_is_netscape) {
+        {
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status =
+                wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
           }
-          if (status.repr) {
+          uint8_t t_2 = *iop_a_src++;
+          v_block_size = t_2;
+        }
+        if (v_block_size != 3) {
+          self->private_data.s_decode_ae[0].scratch =
+              ((uint32_t)(v_block_size));
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(5);
+          if (self->private_data.s_decode_ae[0].scratch >
+              ((uint64_t)(io2_a_src - iop_a_src))) {
+            self->private_data.s_decode_ae[0].scratch -=
+                ((uint64_t)(io2_a_src - iop_a_src));
+            iop_a_src = io2_a_src;
+            status =
+                wuffs_base__make_status(wuffs_base__suspension__short_read);
             goto suspend;
           }
+          iop_a_src += self->private_data.s_decode_ae[0].scratch;
+          goto label__goto_done__break;
         }
-        if (a_src) {
-          a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+        {
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(6);
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status =
+                wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint8_t t_3 = *iop_a_src++;
+          v_c = t_3;
         }
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
-        status = wuffs_gif__decoder__decode_up_to_id_part1(self, a_src);
-        if (a_src) {
-          iop_a_src = a_src->data.ptr + a_src->meta.ri;
+        if (v_c != 1) {
+          self->private_data.s_decode_ae[0].scratch = 2;
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(7);
+          if (self->private_data.s_decode_ae[0].scratch >
+              ((uint64_t)(io2_a_src - iop_a_src))) {
+            self->private_data.s_decode_ae[0].scratch -=
+                ((uint64_t)(io2_a_src - iop_a_src));
+            iop_a_src = io2_a_src;
+            status =
+                wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          iop_a_src += self->private_data.s_decode_ae[0].scratch;
+          goto label__goto_done__break;
         }
-        if (status.repr) {
-          goto suspend;
+        {
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(8);
+          uint32_t t_4;
+          if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
+            t_4 = ((uint32_t)(
+                wuffs_base__load_u16le__no_bounds_check(iop_a_src)));
+            iop_a_src += 2;
+          } else {
+            self->private_data.s_decode_ae[0].scratch = 0;
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(9);
+            while (true) {
+              if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+                status =
+                    wuffs_base__make_status(wuffs_base__suspension__short_read);
+                goto suspend;
+              }
+              uint64_t* scratch = &self->private_data.s_decode_ae[0].scratch;
+              uint32_t num_bits_4 = ((uint32_t)(*scratch >> 56));
+              *scratch <<= 8;
+              *scratch >>= 8;
+              *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_4;
+              if (num_bits_4 == 8) {
+                t_4 = ((uint32_t)(*scratch));
+                break;
+              }
+              num_bits_4 += 8;
+              *scratch |= ((uint64_t)(num_bits_4)) << 56;
+            }
+          }
+          self->private_impl.f_num_loops = t_4;
         }
-      }
-    }
-    if (self->private_impl.f_end_of_data) {
-      status = wuffs_base__make_status(wuffs_base__note__end_of_data);
-      goto ok;
-    }
-    v_background_color = self->private_impl.f_black_color_u32_argb_premul;
-    if (!self->private_impl.f_gc_has_transparent_index) {
-      v_background_color =
-          self->private_impl.f_background_color_u32_argb_premul;
-      if (self->private_impl
-              .f_quirk_enabled_first_frame_local_palette_means_black_background &&
-          (self->private_impl.f_num_decoded_frame_configs_value == 0)) {
+        self->private_impl.f_seen_num_loops = true;
+        if ((0 < self->private_impl.f_num_loops) &&
+            (self->private_impl.f_num_loops <= 65535)) {
+          self->private_impl.f_num_loops += 1;
+        }
+      } else if (self->private_impl.f_ignore_metadata) {
+      } else if (v_is_iccp && self->private_impl.f_report_metadata_iccp) {
         while (((uint64_t)(io2_a_src - iop_a_src)) <= 0) {
           status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-          WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(4);
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(10);
         }
-        v_flags = wuffs_base__load_u8be__no_bounds_check(iop_a_src);
-        if ((v_flags & 128) != 0) {
-          v_background_color = self->private_impl.f_black_color_u32_argb_premul;
+        self->private_impl.f_metadata_chunk_length_value =
+            ((uint64_t)(wuffs_base__load_u8be__no_bounds_check(iop_a_src)));
+        (iop_a_src += 1, wuffs_base__make_empty_struct());
+        self->private_impl.f_metadata_fourcc_value = 1229144912;
+        self->private_impl.f_metadata_io_position = wuffs_base__u64__sat_add(
+            wuffs_base__u64__sat_add(a_src->meta.pos,
+                                     ((uint64_t)(iop_a_src - io0_a_src))),
+            self->private_impl.f_metadata_chunk_length_value);
+        self->private_impl.f_call_sequence = 1;
+        status = wuffs_base__make_status(wuffs_base__note__metadata_reported);
+        goto ok;
+      } else if (v_is_xmp && self->private_impl.f_report_metadata_xmp) {
+        while (((uint64_t)(io2_a_src - iop_a_src)) <= 0) {
+          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(11);
+        }
+        self->private_impl.f_metadata_chunk_length_value =
+            ((uint64_t)(wuffs_base__load_u8be__no_bounds_check(iop_a_src)));
+        if (self->private_impl.f_metadata_chunk_length_value > 0) {
+          self->private_impl.f_metadata_chunk_length_value += 1;
+        } else {
+          (iop_a_src += 1, wuffs_base__make_empty_struct());
         }
+        self->private_impl.f_metadata_fourcc_value = 1481461792;
+        self->private_impl.f_metadata_io_position = wuffs_base__u64__sat_add(
+            wuffs_base__u64__sat_add(a_src->meta.pos,
+                                     ((uint64_t)(iop_a_src - io0_a_src))),
+            self->private_impl.f_metadata_chunk_length_value);
+        self->private_impl.f_call_sequence = 1;
+        status = wuffs_base__make_status(wuffs_base__note__metadata_reported);
+        goto ok;
       }
+      goto label__goto_done__break;
+    }
+  label__goto_done__break:;
+    if (a_src) {
+      a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+    }
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(12);
+    status = wuffs_gif__decoder__skip_blocks(self, a_src);
+    if (a_src) {
+      iop_a_src = a_src->data.ptr + a_src->meta.ri;
     }
-    if (a_dst != NULL) {
-      wuffs_base__frame_config__update(
-          a_dst,
-          wuffs_base__utility__make_rect_ie_u32(
-              wuffs_base__u32__min(self->private_impl.f_frame_rect_x0,
-                                   self->private_impl.f_width),
-              wuffs_base__u32__min(self->private_impl.f_frame_rect_y0,
-                                   self->private_impl.f_height),
-              wuffs_base__u32__min(self->private_impl.f_frame_rect_x1,
-                                   self->private_impl.f_width),
-              wuffs_base__u32__min(self->private_impl.f_frame_rect_y1,
-                                   self->private_impl.f_height)),
-          ((wuffs_base__flicks)(self->private_impl.f_gc_duration)),
-          self->private_impl.f_num_decoded_frame_configs_value,
-          self->private_impl.f_frame_config_io_position,
-          self->private_impl.f_gc_disposal,
-          !self->private_impl.f_gc_has_transparent_index, false,
-          v_background_color);
+    if (status.repr) {
+      goto suspend;
     }
-    wuffs_base__u64__sat_add_indirect(
-        &self->private_impl.f_num_decoded_frame_configs_value, 1);
-    self->private_impl.f_call_sequence = 4;
 
     goto ok;
   ok:
-    self->private_impl.p_decode_frame_config[0] = 0;
+    self->private_impl.p_decode_ae[0] = 0;
     goto exit;
   }
 
   goto suspend;
 suspend:
-  self->private_impl.p_decode_frame_config[0] =
+  self->private_impl.p_decode_ae[0] =
       wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
-  self->private_impl.active_coroutine =
-      wuffs_base__status__is_suspension(&status) ? 3 : 0;
-  self->private_data.s_decode_frame_config[0].v_background_color =
-      v_background_color;
+  self->private_data.s_decode_ae[0].v_block_size = v_block_size;
+  self->private_data.s_decode_ae[0].v_is_animexts = v_is_animexts;
+  self->private_data.s_decode_ae[0].v_is_netscape = v_is_netscape;
+  self->private_data.s_decode_ae[0].v_is_iccp = v_is_iccp;
+  self->private_data.s_decode_ae[0].v_is_xmp = v_is_xmp;
 
   goto exit;
 exit:
@@ -17796,21 +24901,19 @@ exit:
     a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
   }
 
-  if (wuffs_base__status__is_error(&status)) {
-    self->private_impl.magic = WUFFS_BASE__DISABLED;
-  }
   return status;
 }
 
-// -------- func gif.decoder.skip_frame
+// -------- func gif.decoder.decode_gc
 
 static wuffs_base__status  //
-wuffs_gif__decoder__skip_frame(wuffs_gif__decoder* self,
-                               wuffs_base__io_buffer* a_src) {
+wuffs_gif__decoder__decode_gc(wuffs_gif__decoder* self,
+                              wuffs_base__io_buffer* a_src) {
   wuffs_base__status status = wuffs_base__make_status(NULL);
 
+  uint8_t v_c = 0;
   uint8_t v_flags = 0;
-  uint8_t v_lw = 0;
+  uint16_t v_gc_duration_centiseconds = 0;
 
   uint8_t* iop_a_src = NULL;
   uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
@@ -17823,7 +24926,7 @@ wuffs_gif__decoder__skip_frame(wuffs_gif__decoder* self,
     io2_a_src = io0_a_src + a_src->meta.wi;
   }
 
-  uint32_t coro_susp_point = self->private_impl.p_skip_frame[0];
+  uint32_t coro_susp_point = self->private_impl.p_decode_gc[0];
   switch (coro_susp_point) {
     WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
 
@@ -17834,63 +24937,94 @@ wuffs_gif__decoder__skip_frame(wuffs_gif__decoder* self,
         goto suspend;
       }
       uint8_t t_0 = *iop_a_src++;
-      v_flags = t_0;
+      v_c = t_0;
     }
-    if ((v_flags & 128) != 0) {
-      self->private_data.s_skip_frame[0].scratch =
-          (((uint32_t)(3)) << (1 + (v_flags & 7)));
+    if (v_c != 4) {
+      status = wuffs_base__make_status(wuffs_gif__error__bad_graphic_control);
+      goto exit;
+    }
+    {
       WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
-      if (self->private_data.s_skip_frame[0].scratch >
-          ((uint64_t)(io2_a_src - iop_a_src))) {
-        self->private_data.s_skip_frame[0].scratch -=
-            ((uint64_t)(io2_a_src - iop_a_src));
-        iop_a_src = io2_a_src;
+      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
         status = wuffs_base__make_status(wuffs_base__suspension__short_read);
         goto suspend;
       }
-      iop_a_src += self->private_data.s_skip_frame[0].scratch;
+      uint8_t t_1 = *iop_a_src++;
+      v_flags = t_1;
+    }
+    self->private_impl.f_gc_has_transparent_index = ((v_flags & 1) != 0);
+    v_flags = ((v_flags >> 2) & 7);
+    if (v_flags == 2) {
+      self->private_impl.f_gc_disposal = 1;
+    } else if ((v_flags == 3) || (v_flags == 4)) {
+      self->private_impl.f_gc_disposal = 2;
+    } else {
+      self->private_impl.f_gc_disposal = 0;
     }
     {
       WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+      uint16_t t_2;
+      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
+        t_2 = wuffs_base__load_u16le__no_bounds_check(iop_a_src);
+        iop_a_src += 2;
+      } else {
+        self->private_data.s_decode_gc[0].scratch = 0;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+        while (true) {
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status =
+                wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint64_t* scratch = &self->private_data.s_decode_gc[0].scratch;
+          uint32_t num_bits_2 = ((uint32_t)(*scratch >> 56));
+          *scratch <<= 8;
+          *scratch >>= 8;
+          *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_2;
+          if (num_bits_2 == 8) {
+            t_2 = ((uint16_t)(*scratch));
+            break;
+          }
+          num_bits_2 += 8;
+          *scratch |= ((uint64_t)(num_bits_2)) << 56;
+        }
+      }
+      v_gc_duration_centiseconds = t_2;
+    }
+    self->private_impl.f_gc_duration =
+        (((uint64_t)(v_gc_duration_centiseconds)) * 7056000);
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(5);
       if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
         status = wuffs_base__make_status(wuffs_base__suspension__short_read);
         goto suspend;
       }
-      uint8_t t_1 = *iop_a_src++;
-      v_lw = t_1;
-    }
-    if (v_lw > 8) {
-      status = wuffs_base__make_status(wuffs_gif__error__bad_literal_width);
-      goto exit;
-    }
-    if (a_src) {
-      a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
-    }
-    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
-    status = wuffs_gif__decoder__skip_blocks(self, a_src);
-    if (a_src) {
-      iop_a_src = a_src->data.ptr + a_src->meta.ri;
+      uint8_t t_3 = *iop_a_src++;
+      self->private_impl.f_gc_transparent_index = t_3;
     }
-    if (status.repr) {
-      goto suspend;
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(6);
+      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        goto suspend;
+      }
+      uint8_t t_4 = *iop_a_src++;
+      v_c = t_4;
     }
-    if (self->private_impl.f_quirk_enabled_delay_num_decoded_frames) {
-      self->private_impl.f_delayed_num_decoded_frames = true;
-    } else {
-      wuffs_base__u64__sat_add_indirect(
-          &self->private_impl.f_num_decoded_frames_value, 1);
+    if (v_c != 0) {
+      status = wuffs_base__make_status(wuffs_gif__error__bad_graphic_control);
+      goto exit;
     }
-    wuffs_gif__decoder__reset_gc(self);
 
     goto ok;
   ok:
-    self->private_impl.p_skip_frame[0] = 0;
+    self->private_impl.p_decode_gc[0] = 0;
     goto exit;
   }
 
   goto suspend;
 suspend:
-  self->private_impl.p_skip_frame[0] =
+  self->private_impl.p_decode_gc[0] =
       wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
 
   goto exit;
@@ -17902,112 +25036,197 @@ exit:
   return status;
 }
 
-// -------- func gif.decoder.decode_frame
+// -------- func gif.decoder.decode_id_part0
 
-WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
-wuffs_gif__decoder__decode_frame(wuffs_gif__decoder* self,
-                                 wuffs_base__pixel_buffer* a_dst,
-                                 wuffs_base__io_buffer* a_src,
-                                 wuffs_base__pixel_blend a_blend,
-                                 wuffs_base__slice_u8 a_workbuf,
-                                 wuffs_base__decode_frame_options* a_opts) {
-  if (!self) {
-    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
-  }
-  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
-    return wuffs_base__make_status(
-        (self->private_impl.magic == WUFFS_BASE__DISABLED)
-            ? wuffs_base__error__disabled_by_previous_error
-            : wuffs_base__error__initialize_not_called);
-  }
-  if (!a_dst || !a_src) {
-    self->private_impl.magic = WUFFS_BASE__DISABLED;
-    return wuffs_base__make_status(wuffs_base__error__bad_argument);
-  }
-  if ((self->private_impl.active_coroutine != 0) &&
-      (self->private_impl.active_coroutine != 4)) {
-    self->private_impl.magic = WUFFS_BASE__DISABLED;
-    return wuffs_base__make_status(
-        wuffs_base__error__interleaved_coroutine_calls);
-  }
-  self->private_impl.active_coroutine = 0;
+static wuffs_base__status  //
+wuffs_gif__decoder__decode_id_part0(wuffs_gif__decoder* self,
+                                    wuffs_base__io_buffer* a_src) {
   wuffs_base__status status = wuffs_base__make_status(NULL);
 
-  uint32_t coro_susp_point = self->private_impl.p_decode_frame[0];
+  uint8_t* iop_a_src = NULL;
+  uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_decode_id_part0[0];
   switch (coro_susp_point) {
     WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
 
-    self->private_impl.f_ignore_metadata = true;
-    if (self->private_impl.f_call_sequence != 4) {
+    {
       WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
-      status = wuffs_gif__decoder__decode_frame_config(self, NULL, a_src);
-      if (status.repr) {
-        goto suspend;
+      uint32_t t_0;
+      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
+        t_0 = ((uint32_t)(wuffs_base__load_u16le__no_bounds_check(iop_a_src)));
+        iop_a_src += 2;
+      } else {
+        self->private_data.s_decode_id_part0[0].scratch = 0;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+        while (true) {
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status =
+                wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint64_t* scratch = &self->private_data.s_decode_id_part0[0].scratch;
+          uint32_t num_bits_0 = ((uint32_t)(*scratch >> 56));
+          *scratch <<= 8;
+          *scratch >>= 8;
+          *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_0;
+          if (num_bits_0 == 8) {
+            t_0 = ((uint32_t)(*scratch));
+            break;
+          }
+          num_bits_0 += 8;
+          *scratch |= ((uint64_t)(num_bits_0)) << 56;
+        }
+      }
+      self->private_impl.f_frame_rect_x0 = t_0;
+    }
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+      uint32_t t_1;
+      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
+        t_1 = ((uint32_t)(wuffs_base__load_u16le__no_bounds_check(iop_a_src)));
+        iop_a_src += 2;
+      } else {
+        self->private_data.s_decode_id_part0[0].scratch = 0;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+        while (true) {
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status =
+                wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint64_t* scratch = &self->private_data.s_decode_id_part0[0].scratch;
+          uint32_t num_bits_1 = ((uint32_t)(*scratch >> 56));
+          *scratch <<= 8;
+          *scratch >>= 8;
+          *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_1;
+          if (num_bits_1 == 8) {
+            t_1 = ((uint32_t)(*scratch));
+            break;
+          }
+          num_bits_1 += 8;
+          *scratch |= ((uint64_t)(num_bits_1)) << 56;
+        }
       }
+      self->private_impl.f_frame_rect_y0 = t_1;
     }
-    if (self->private_impl.f_quirk_enabled_reject_empty_frame &&
-        ((self->private_impl.f_frame_rect_x0 ==
-          self->private_impl.f_frame_rect_x1) ||
-         (self->private_impl.f_frame_rect_y0 ==
-          self->private_impl.f_frame_rect_y1))) {
-      status = wuffs_base__make_status(wuffs_gif__error__bad_frame_size);
-      goto exit;
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(5);
+      uint32_t t_2;
+      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
+        t_2 = ((uint32_t)(wuffs_base__load_u16le__no_bounds_check(iop_a_src)));
+        iop_a_src += 2;
+      } else {
+        self->private_data.s_decode_id_part0[0].scratch = 0;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(6);
+        while (true) {
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status =
+                wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint64_t* scratch = &self->private_data.s_decode_id_part0[0].scratch;
+          uint32_t num_bits_2 = ((uint32_t)(*scratch >> 56));
+          *scratch <<= 8;
+          *scratch >>= 8;
+          *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_2;
+          if (num_bits_2 == 8) {
+            t_2 = ((uint32_t)(*scratch));
+            break;
+          }
+          num_bits_2 += 8;
+          *scratch |= ((uint64_t)(num_bits_2)) << 56;
+        }
+      }
+      self->private_impl.f_frame_rect_x1 = t_2;
     }
-    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
-    status = wuffs_gif__decoder__decode_id_part1(self, a_dst, a_src, a_blend);
-    if (status.repr) {
-      goto suspend;
+    self->private_impl.f_frame_rect_x1 += self->private_impl.f_frame_rect_x0;
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(7);
+      uint32_t t_3;
+      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
+        t_3 = ((uint32_t)(wuffs_base__load_u16le__no_bounds_check(iop_a_src)));
+        iop_a_src += 2;
+      } else {
+        self->private_data.s_decode_id_part0[0].scratch = 0;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(8);
+        while (true) {
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status =
+                wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint64_t* scratch = &self->private_data.s_decode_id_part0[0].scratch;
+          uint32_t num_bits_3 = ((uint32_t)(*scratch >> 56));
+          *scratch <<= 8;
+          *scratch >>= 8;
+          *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_3;
+          if (num_bits_3 == 8) {
+            t_3 = ((uint32_t)(*scratch));
+            break;
+          }
+          num_bits_3 += 8;
+          *scratch |= ((uint64_t)(num_bits_3)) << 56;
+        }
+      }
+      self->private_impl.f_frame_rect_y1 = t_3;
     }
-    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
-    status = wuffs_gif__decoder__decode_id_part2(self, a_dst, a_src, a_workbuf);
-    if (status.repr) {
-      goto suspend;
+    self->private_impl.f_frame_rect_y1 += self->private_impl.f_frame_rect_y0;
+    self->private_impl.f_dst_x = self->private_impl.f_frame_rect_x0;
+    self->private_impl.f_dst_y = self->private_impl.f_frame_rect_y0;
+    if ((self->private_impl.f_call_sequence == 0) &&
+        !self->private_impl.f_quirk_enabled_image_bounds_are_strict) {
+      self->private_impl.f_width = wuffs_base__u32__max(
+          self->private_impl.f_width, self->private_impl.f_frame_rect_x1);
+      self->private_impl.f_height = wuffs_base__u32__max(
+          self->private_impl.f_height, self->private_impl.f_frame_rect_y1);
     }
-    wuffs_base__u64__sat_add_indirect(
-        &self->private_impl.f_num_decoded_frames_value, 1);
-    wuffs_gif__decoder__reset_gc(self);
 
     goto ok;
   ok:
-    self->private_impl.p_decode_frame[0] = 0;
+    self->private_impl.p_decode_id_part0[0] = 0;
     goto exit;
   }
 
   goto suspend;
 suspend:
-  self->private_impl.p_decode_frame[0] =
+  self->private_impl.p_decode_id_part0[0] =
       wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
-  self->private_impl.active_coroutine =
-      wuffs_base__status__is_suspension(&status) ? 4 : 0;
 
   goto exit;
 exit:
-  if (wuffs_base__status__is_error(&status)) {
-    self->private_impl.magic = WUFFS_BASE__DISABLED;
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
   }
-  return status;
-}
-
-// -------- func gif.decoder.reset_gc
 
-static wuffs_base__empty_struct  //
-wuffs_gif__decoder__reset_gc(wuffs_gif__decoder* self) {
-  self->private_impl.f_call_sequence = 5;
-  self->private_impl.f_gc_has_transparent_index = false;
-  self->private_impl.f_gc_transparent_index = 0;
-  self->private_impl.f_gc_disposal = 0;
-  self->private_impl.f_gc_duration = 0;
-  return wuffs_base__make_empty_struct();
+  return status;
 }
 
-// -------- func gif.decoder.decode_up_to_id_part1
+// -------- func gif.decoder.decode_id_part1
 
 static wuffs_base__status  //
-wuffs_gif__decoder__decode_up_to_id_part1(wuffs_gif__decoder* self,
-                                          wuffs_base__io_buffer* a_src) {
+wuffs_gif__decoder__decode_id_part1(wuffs_gif__decoder* self,
+                                    wuffs_base__pixel_buffer* a_dst,
+                                    wuffs_base__io_buffer* a_src,
+                                    wuffs_base__pixel_blend a_blend) {
   wuffs_base__status status = wuffs_base__make_status(NULL);
 
-  uint8_t v_block_type = 0;
+  uint8_t v_flags = 0;
+  uint8_t v_which_palette = 0;
+  uint32_t v_num_palette_entries = 0;
+  uint32_t v_i = 0;
+  uint32_t v_argb = 0;
+  wuffs_base__slice_u8 v_dst_palette = {0};
+  wuffs_base__status v_status = wuffs_base__make_status(NULL);
+  uint8_t v_lw = 0;
 
   uint8_t* iop_a_src = NULL;
   uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
@@ -18020,89 +25239,169 @@ wuffs_gif__decoder__decode_up_to_id_part1(wuffs_gif__decoder* self,
     io2_a_src = io0_a_src + a_src->meta.wi;
   }
 
-  uint32_t coro_susp_point = self->private_impl.p_decode_up_to_id_part1[0];
+  uint32_t coro_susp_point = self->private_impl.p_decode_id_part1[0];
+  if (coro_susp_point) {
+    v_which_palette = self->private_data.s_decode_id_part1[0].v_which_palette;
+    v_num_palette_entries =
+        self->private_data.s_decode_id_part1[0].v_num_palette_entries;
+    v_i = self->private_data.s_decode_id_part1[0].v_i;
+  }
   switch (coro_susp_point) {
     WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
 
-    if (!self->private_impl.f_restarted) {
-      if (self->private_impl.f_call_sequence != 2) {
-        self->private_impl.f_frame_config_io_position =
-            wuffs_base__u64__sat_add(a_src->meta.pos,
-                                     ((uint64_t)(iop_a_src - io0_a_src)));
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        goto suspend;
+      }
+      uint8_t t_0 = *iop_a_src++;
+      v_flags = t_0;
+    }
+    if ((v_flags & 64) != 0) {
+      self->private_impl.f_interlace = 4;
+    } else {
+      self->private_impl.f_interlace = 0;
+    }
+    v_which_palette = 1;
+    if ((v_flags & 128) != 0) {
+      v_num_palette_entries = (((uint32_t)(1)) << (1 + (v_flags & 7)));
+      v_i = 0;
+      while (v_i < v_num_palette_entries) {
+        {
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+          uint32_t t_1;
+          if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 3)) {
+            t_1 = ((uint32_t)(
+                wuffs_base__load_u24be__no_bounds_check(iop_a_src)));
+            iop_a_src += 3;
+          } else {
+            self->private_data.s_decode_id_part1[0].scratch = 0;
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+            while (true) {
+              if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+                status =
+                    wuffs_base__make_status(wuffs_base__suspension__short_read);
+                goto suspend;
+              }
+              uint64_t* scratch =
+                  &self->private_data.s_decode_id_part1[0].scratch;
+              uint32_t num_bits_1 = ((uint32_t)(*scratch & 0xFF));
+              *scratch >>= 8;
+              *scratch <<= 8;
+              *scratch |= ((uint64_t)(*iop_a_src++)) << (56 - num_bits_1);
+              if (num_bits_1 == 16) {
+                t_1 = ((uint32_t)(*scratch >> 40));
+                break;
+              }
+              num_bits_1 += 8;
+              *scratch |= ((uint64_t)(num_bits_1));
+            }
+          }
+          v_argb = t_1;
+        }
+        v_argb |= 4278190080;
+        self->private_data.f_palettes[1][((4 * v_i) + 0)] =
+            ((uint8_t)(((v_argb >> 0) & 255)));
+        self->private_data.f_palettes[1][((4 * v_i) + 1)] =
+            ((uint8_t)(((v_argb >> 8) & 255)));
+        self->private_data.f_palettes[1][((4 * v_i) + 2)] =
+            ((uint8_t)(((v_argb >> 16) & 255)));
+        self->private_data.f_palettes[1][((4 * v_i) + 3)] =
+            ((uint8_t)(((v_argb >> 24) & 255)));
+        v_i += 1;
+      }
+      while (v_i < 256) {
+        self->private_data.f_palettes[1][((4 * v_i) + 0)] = 0;
+        self->private_data.f_palettes[1][((4 * v_i) + 1)] = 0;
+        self->private_data.f_palettes[1][((4 * v_i) + 2)] = 0;
+        self->private_data.f_palettes[1][((4 * v_i) + 3)] = 255;
+        v_i += 1;
+      }
+    } else if (self->private_impl.f_quirk_enabled_reject_empty_palette &&
+               !self->private_impl.f_has_global_palette) {
+      status = wuffs_base__make_status(wuffs_gif__error__bad_palette);
+      goto exit;
+    } else if (self->private_impl.f_gc_has_transparent_index) {
+      wuffs_base__slice_u8__copy_from_slice(
+          wuffs_base__make_slice_u8(self->private_data.f_palettes[1], 1024),
+          wuffs_base__make_slice_u8(self->private_data.f_palettes[0], 1024));
+    } else {
+      v_which_palette = 0;
+    }
+    if (self->private_impl.f_gc_has_transparent_index) {
+      self->private_data.f_palettes[1][(
+          (4 * ((uint32_t)(self->private_impl.f_gc_transparent_index))) + 0)] =
+          0;
+      self->private_data.f_palettes[1][(
+          (4 * ((uint32_t)(self->private_impl.f_gc_transparent_index))) + 1)] =
+          0;
+      self->private_data.f_palettes[1][(
+          (4 * ((uint32_t)(self->private_impl.f_gc_transparent_index))) + 2)] =
+          0;
+      self->private_data.f_palettes[1][(
+          (4 * ((uint32_t)(self->private_impl.f_gc_transparent_index))) + 3)] =
+          0;
+    }
+    v_dst_palette = wuffs_base__pixel_buffer__palette(a_dst);
+    if (((uint64_t)(v_dst_palette.len)) == 0) {
+      v_dst_palette =
+          wuffs_base__make_slice_u8(self->private_data.f_dst_palette, 1024);
+    }
+    v_status = wuffs_base__pixel_swizzler__prepare(
+        &self->private_impl.f_swizzler,
+        wuffs_base__pixel_buffer__pixel_format(a_dst), v_dst_palette,
+        wuffs_base__utility__make_pixel_format(1191444488),
+        wuffs_base__make_slice_u8(
+            self->private_data.f_palettes[v_which_palette], 1024),
+        a_blend);
+    if (!wuffs_base__status__is_ok(&v_status)) {
+      status = v_status;
+      if (wuffs_base__status__is_error(&status)) {
+        goto exit;
+      } else if (wuffs_base__status__is_suspension(&status)) {
+        status = wuffs_base__make_status(
+            wuffs_base__error__cannot_return_a_suspension);
+        goto exit;
       }
-    } else if (self->private_impl.f_frame_config_io_position !=
-               wuffs_base__u64__sat_add(a_src->meta.pos,
-                                        ((uint64_t)(iop_a_src - io0_a_src)))) {
-      status = wuffs_base__make_status(wuffs_base__error__bad_restart);
-      goto exit;
-    } else {
-      self->private_impl.f_restarted = false;
+      goto ok;
     }
-    while (true) {
-      {
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
-        if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-          goto suspend;
-        }
-        uint8_t t_0 = *iop_a_src++;
-        v_block_type = t_0;
-      }
-      if (v_block_type == 33) {
-        if (a_src) {
-          a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
-        }
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
-        status = wuffs_gif__decoder__decode_extension(self, a_src);
-        if (a_src) {
-          iop_a_src = a_src->data.ptr + a_src->meta.ri;
-        }
-        if (status.repr) {
-          goto suspend;
-        }
-      } else if (v_block_type == 44) {
-        if (self->private_impl.f_delayed_num_decoded_frames) {
-          self->private_impl.f_delayed_num_decoded_frames = false;
-          wuffs_base__u64__sat_add_indirect(
-              &self->private_impl.f_num_decoded_frames_value, 1);
-        }
-        if (a_src) {
-          a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
-        }
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
-        status = wuffs_gif__decoder__decode_id_part0(self, a_src);
-        if (a_src) {
-          iop_a_src = a_src->data.ptr + a_src->meta.ri;
-        }
-        if (status.repr) {
-          goto suspend;
-        }
-        goto label__0__break;
-      } else if (v_block_type == 59) {
-        if (self->private_impl.f_delayed_num_decoded_frames) {
-          self->private_impl.f_delayed_num_decoded_frames = false;
-          wuffs_base__u64__sat_add_indirect(
-              &self->private_impl.f_num_decoded_frames_value, 1);
-        }
-        self->private_impl.f_end_of_data = true;
-        goto label__0__break;
-      } else {
-        status = wuffs_base__make_status(wuffs_gif__error__bad_block);
-        goto exit;
+    if (self->private_impl.f_previous_lzw_decode_ended_abruptly) {
+      wuffs_base__ignore_status(wuffs_lzw__decoder__initialize(
+          &self->private_data.f_lzw, sizeof(wuffs_lzw__decoder), WUFFS_VERSION,
+          0));
+    }
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        goto suspend;
       }
+      uint8_t t_2 = *iop_a_src++;
+      v_lw = t_2;
     }
-  label__0__break:;
+    if (v_lw > 8) {
+      status = wuffs_base__make_status(wuffs_gif__error__bad_literal_width);
+      goto exit;
+    }
+    wuffs_lzw__decoder__set_literal_width(&self->private_data.f_lzw,
+                                          ((uint32_t)(v_lw)));
+    self->private_impl.f_previous_lzw_decode_ended_abruptly = true;
 
     goto ok;
   ok:
-    self->private_impl.p_decode_up_to_id_part1[0] = 0;
+    self->private_impl.p_decode_id_part1[0] = 0;
     goto exit;
   }
 
   goto suspend;
 suspend:
-  self->private_impl.p_decode_up_to_id_part1[0] =
+  self->private_impl.p_decode_id_part1[0] =
       wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_data.s_decode_id_part1[0].v_which_palette = v_which_palette;
+  self->private_data.s_decode_id_part1[0].v_num_palette_entries =
+      v_num_palette_entries;
+  self->private_data.s_decode_id_part1[0].v_i = v_i;
 
   goto exit;
 exit:
@@ -18113,15 +25412,32 @@ exit:
   return status;
 }
 
-// -------- func gif.decoder.decode_header
+// -------- func gif.decoder.decode_id_part2
 
 static wuffs_base__status  //
-wuffs_gif__decoder__decode_header(wuffs_gif__decoder* self,
-                                  wuffs_base__io_buffer* a_src) {
+wuffs_gif__decoder__decode_id_part2(wuffs_gif__decoder* self,
+                                    wuffs_base__pixel_buffer* a_dst,
+                                    wuffs_base__io_buffer* a_src,
+                                    wuffs_base__slice_u8 a_workbuf) {
+  wuffs_base__io_buffer empty_io_buffer = wuffs_base__empty_io_buffer();
+
   wuffs_base__status status = wuffs_base__make_status(NULL);
 
-  uint8_t v_c[6] = {0};
-  uint32_t v_i = 0;
+  uint64_t v_block_size = 0;
+  bool v_need_block_size = false;
+  uint64_t v_n_compressed = 0;
+  wuffs_base__slice_u8 v_compressed = {0};
+  bool v_direct = false;
+  wuffs_base__io_buffer u_r = wuffs_base__empty_io_buffer();
+  wuffs_base__io_buffer* v_r = &u_r;
+  uint8_t* iop_v_r WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io0_v_r WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_v_r WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_v_r WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint64_t v_mark = 0;
+  wuffs_base__status v_lzw_status = wuffs_base__make_status(NULL);
+  wuffs_base__status v_copy_status = wuffs_base__make_status(NULL);
+  wuffs_base__slice_u8 v_uncompressed = {0};
 
   uint8_t* iop_a_src = NULL;
   uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
@@ -18134,44 +25450,224 @@ wuffs_gif__decoder__decode_header(wuffs_gif__decoder* self,
     io2_a_src = io0_a_src + a_src->meta.wi;
   }
 
-  uint32_t coro_susp_point = self->private_impl.p_decode_header[0];
+  uint32_t coro_susp_point = self->private_impl.p_decode_id_part2[0];
   if (coro_susp_point) {
-    memcpy(v_c, self->private_data.s_decode_header[0].v_c, sizeof(v_c));
-    v_i = self->private_data.s_decode_header[0].v_i;
+    v_block_size = self->private_data.s_decode_id_part2[0].v_block_size;
+    v_need_block_size =
+        self->private_data.s_decode_id_part2[0].v_need_block_size;
+    v_direct = self->private_data.s_decode_id_part2[0].v_direct;
+    v_lzw_status = self->private_data.s_decode_id_part2[0].v_lzw_status;
   }
   switch (coro_susp_point) {
     WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
 
-    while (v_i < 6) {
-      {
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
-        if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-          goto suspend;
+    v_need_block_size = true;
+  label__outer__continue:;
+    while (true) {
+      if (v_need_block_size) {
+        v_need_block_size = false;
+        {
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status =
+                wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint64_t t_0 = *iop_a_src++;
+          v_block_size = t_0;
+        }
+      }
+      if (v_block_size == 0) {
+        goto label__outer__break;
+      }
+      while (((uint64_t)(io2_a_src - iop_a_src)) == 0) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(2);
+      }
+      if (self->private_impl.f_compressed_ri ==
+          self->private_impl.f_compressed_wi) {
+        self->private_impl.f_compressed_ri = 0;
+        self->private_impl.f_compressed_wi = 0;
+      }
+      v_direct = ((self->private_impl.f_compressed_ri ==
+                   self->private_impl.f_compressed_wi) &&
+                  (v_block_size <= ((uint64_t)(io2_a_src - iop_a_src))));
+      if (v_direct) {
+        v_compressed =
+            wuffs_base__io_reader__take(&iop_a_src, io2_a_src, v_block_size);
+        v_need_block_size = true;
+        v_block_size = 0;
+      }
+      while (!v_direct && (self->private_impl.f_compressed_wi <= 3841)) {
+        v_n_compressed = wuffs_base__u64__min(
+            v_block_size, ((uint64_t)(io2_a_src - iop_a_src)));
+        if (v_n_compressed <= 0) {
+          goto label__0__break;
+        }
+        v_compressed =
+            wuffs_base__io_reader__take(&iop_a_src, io2_a_src, v_n_compressed);
+        wuffs_base__slice_u8__copy_from_slice(
+            wuffs_base__slice_u8__subslice_i(
+                wuffs_base__make_slice_u8(self->private_data.f_compressed,
+                                          4096),
+                self->private_impl.f_compressed_wi),
+            v_compressed);
+        wuffs_base__u64__sat_add_indirect(&self->private_impl.f_compressed_wi,
+                                          v_n_compressed);
+        wuffs_base__u64__sat_sub_indirect(&v_block_size, v_n_compressed);
+        if (v_block_size > 0) {
+          goto label__0__break;
+        }
+        if (((uint64_t)(io2_a_src - iop_a_src)) <= 0) {
+          v_need_block_size = true;
+          goto label__0__break;
+        }
+        v_block_size =
+            ((uint64_t)(wuffs_base__load_u8be__no_bounds_check(iop_a_src)));
+        (iop_a_src += 1, wuffs_base__make_empty_struct());
+      }
+    label__0__break:;
+    label__inner__continue:;
+      while (true) {
+        if (!v_direct) {
+          if ((self->private_impl.f_compressed_ri >
+               self->private_impl.f_compressed_wi) ||
+              (self->private_impl.f_compressed_wi > 4096)) {
+            status = wuffs_base__make_status(
+                wuffs_gif__error__internal_error_inconsistent_ri_wi);
+            goto exit;
+          }
+          v_compressed = wuffs_base__slice_u8__subslice_ij(
+              wuffs_base__make_slice_u8(self->private_data.f_compressed, 4096),
+              self->private_impl.f_compressed_ri,
+              self->private_impl.f_compressed_wi);
+        }
+        {
+          wuffs_base__io_buffer* o_0_v_r = v_r;
+          uint8_t* o_0_iop_v_r = iop_v_r;
+          uint8_t* o_0_io0_v_r = io0_v_r;
+          uint8_t* o_0_io1_v_r = io1_v_r;
+          uint8_t* o_0_io2_v_r = io2_v_r;
+          v_r = wuffs_base__io_reader__set(&u_r, &iop_v_r, &io0_v_r, &io1_v_r,
+                                           &io2_v_r, v_compressed);
+          v_mark = ((uint64_t)(iop_v_r - io0_v_r));
+          {
+            u_r.meta.ri = ((size_t)(iop_v_r - u_r.data.ptr));
+            wuffs_base__status t_1 = wuffs_lzw__decoder__transform_io(
+                &self->private_data.f_lzw, &empty_io_buffer, v_r,
+                wuffs_base__utility__empty_slice_u8());
+            iop_v_r = u_r.data.ptr + u_r.meta.ri;
+            v_lzw_status = t_1;
+          }
+          v_n_compressed = wuffs_base__io__count_since(
+              v_mark, ((uint64_t)(iop_v_r - io0_v_r)));
+          v_r = o_0_v_r;
+          iop_v_r = o_0_iop_v_r;
+          io0_v_r = o_0_io0_v_r;
+          io1_v_r = o_0_io1_v_r;
+          io2_v_r = o_0_io2_v_r;
+        }
+        if (v_direct) {
+          if (v_n_compressed > ((uint64_t)(v_compressed.len))) {
+            status = wuffs_base__make_status(
+                wuffs_gif__error__internal_error_inconsistent_ri_wi);
+            goto exit;
+          }
+          v_compressed =
+              wuffs_base__slice_u8__subslice_i(v_compressed, v_n_compressed);
+        } else {
+          wuffs_base__u64__sat_add_indirect(&self->private_impl.f_compressed_ri,
+                                            v_n_compressed);
+        }
+        v_uncompressed = wuffs_lzw__decoder__flush(&self->private_data.f_lzw);
+        if (((uint64_t)(v_uncompressed.len)) > 0) {
+          v_copy_status = wuffs_gif__decoder__copy_to_image_buffer(
+              self, a_dst, v_uncompressed);
+          if (wuffs_base__status__is_error(&v_copy_status)) {
+            status = v_copy_status;
+            goto exit;
+          }
+        }
+        if (wuffs_base__status__is_ok(&v_lzw_status)) {
+          self->private_impl.f_previous_lzw_decode_ended_abruptly = false;
+          if (v_need_block_size || (v_block_size > 0)) {
+            self->private_data.s_decode_id_part2[0].scratch =
+                ((uint32_t)(v_block_size));
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+            if (self->private_data.s_decode_id_part2[0].scratch >
+                ((uint64_t)(io2_a_src - iop_a_src))) {
+              self->private_data.s_decode_id_part2[0].scratch -=
+                  ((uint64_t)(io2_a_src - iop_a_src));
+              iop_a_src = io2_a_src;
+              status =
+                  wuffs_base__make_status(wuffs_base__suspension__short_read);
+              goto suspend;
+            }
+            iop_a_src += self->private_data.s_decode_id_part2[0].scratch;
+            if (a_src) {
+              a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+            }
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+            status = wuffs_gif__decoder__skip_blocks(self, a_src);
+            if (a_src) {
+              iop_a_src = a_src->data.ptr + a_src->meta.ri;
+            }
+            if (status.repr) {
+              goto suspend;
+            }
+          }
+          goto label__outer__break;
+        } else if (v_lzw_status.repr ==
+                   wuffs_base__make_status(wuffs_base__suspension__short_read)
+                       .repr) {
+          if (v_direct && (((uint64_t)(v_compressed.len)) > 0)) {
+            status = wuffs_base__make_status(
+                wuffs_gif__error__internal_error_inconsistent_ri_wi);
+            goto exit;
+          }
+          goto label__outer__continue;
+        } else if (v_lzw_status.repr ==
+                   wuffs_base__make_status(wuffs_base__suspension__short_write)
+                       .repr) {
+          goto label__inner__continue;
         }
-        uint8_t t_0 = *iop_a_src++;
-        v_c[v_i] = t_0;
+        status = v_lzw_status;
+        if (wuffs_base__status__is_error(&status)) {
+          goto exit;
+        } else if (wuffs_base__status__is_suspension(&status)) {
+          status = wuffs_base__make_status(
+              wuffs_base__error__cannot_return_a_suspension);
+          goto exit;
+        }
+        goto ok;
       }
-      v_i += 1;
     }
-    if ((v_c[0] != 71) || (v_c[1] != 73) || (v_c[2] != 70) || (v_c[3] != 56) ||
-        ((v_c[4] != 55) && (v_c[4] != 57)) || (v_c[5] != 97)) {
-      status = wuffs_base__make_status(wuffs_gif__error__bad_header);
+  label__outer__break:;
+    self->private_impl.f_compressed_ri = 0;
+    self->private_impl.f_compressed_wi = 0;
+    if ((self->private_impl.f_dst_y < self->private_impl.f_frame_rect_y1) &&
+        (self->private_impl.f_frame_rect_x0 !=
+         self->private_impl.f_frame_rect_x1) &&
+        (self->private_impl.f_frame_rect_y0 !=
+         self->private_impl.f_frame_rect_y1)) {
+      status = wuffs_base__make_status(wuffs_base__error__not_enough_data);
       goto exit;
     }
 
     goto ok;
   ok:
-    self->private_impl.p_decode_header[0] = 0;
+    self->private_impl.p_decode_id_part2[0] = 0;
     goto exit;
   }
 
   goto suspend;
 suspend:
-  self->private_impl.p_decode_header[0] =
+  self->private_impl.p_decode_id_part2[0] =
       wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
-  memcpy(self->private_data.s_decode_header[0].v_c, v_c, sizeof(v_c));
-  self->private_data.s_decode_header[0].v_i = v_i;
+  self->private_data.s_decode_id_part2[0].v_block_size = v_block_size;
+  self->private_data.s_decode_id_part2[0].v_need_block_size = v_need_block_size;
+  self->private_data.s_decode_id_part2[0].v_direct = v_direct;
+  self->private_data.s_decode_id_part2[0].v_lzw_status = v_lzw_status;
 
   goto exit;
 exit:
@@ -18182,1187 +25678,1465 @@ exit:
   return status;
 }
 
-// -------- func gif.decoder.decode_lsd
+// -------- func gif.decoder.copy_to_image_buffer
 
 static wuffs_base__status  //
-wuffs_gif__decoder__decode_lsd(wuffs_gif__decoder* self,
-                               wuffs_base__io_buffer* a_src) {
+wuffs_gif__decoder__copy_to_image_buffer(wuffs_gif__decoder* self,
+                                         wuffs_base__pixel_buffer* a_pb,
+                                         wuffs_base__slice_u8 a_src) {
+  wuffs_base__slice_u8 v_dst = {0};
+  wuffs_base__slice_u8 v_src = {0};
+  uint64_t v_width_in_bytes = 0;
+  uint64_t v_n = 0;
+  uint64_t v_src_ri = 0;
+  wuffs_base__pixel_format v_pixfmt = {0};
+  uint32_t v_bytes_per_pixel = 0;
+  uint32_t v_bits_per_pixel = 0;
+  wuffs_base__table_u8 v_tab = {0};
+  uint64_t v_i = 0;
+  uint64_t v_j = 0;
+  uint32_t v_replicate_y0 = 0;
+  uint32_t v_replicate_y1 = 0;
+  wuffs_base__slice_u8 v_replicate_dst = {0};
+  wuffs_base__slice_u8 v_replicate_src = {0};
+
+  v_pixfmt = wuffs_base__pixel_buffer__pixel_format(a_pb);
+  v_bits_per_pixel = wuffs_base__pixel_format__bits_per_pixel(&v_pixfmt);
+  if ((v_bits_per_pixel & 7) != 0) {
+    return wuffs_base__make_status(wuffs_base__error__unsupported_option);
+  }
+  v_bytes_per_pixel = (v_bits_per_pixel >> 3);
+  v_width_in_bytes = (((uint64_t)(self->private_impl.f_width)) *
+                      ((uint64_t)(v_bytes_per_pixel)));
+  v_tab = wuffs_base__pixel_buffer__plane(a_pb, 0);
+label__0__continue:;
+  while (v_src_ri < ((uint64_t)(a_src.len))) {
+    v_src = wuffs_base__slice_u8__subslice_i(a_src, v_src_ri);
+    if (self->private_impl.f_dst_y >= self->private_impl.f_frame_rect_y1) {
+      if (self->private_impl.f_quirk_enabled_ignore_too_much_pixel_data) {
+        return wuffs_base__make_status(NULL);
+      }
+      return wuffs_base__make_status(wuffs_base__error__too_much_data);
+    }
+    v_dst = wuffs_base__table_u8__row(v_tab, self->private_impl.f_dst_y);
+    if (self->private_impl.f_dst_y >= self->private_impl.f_height) {
+      v_dst = wuffs_base__slice_u8__subslice_j(v_dst, 0);
+    } else if (v_width_in_bytes < ((uint64_t)(v_dst.len))) {
+      v_dst = wuffs_base__slice_u8__subslice_j(v_dst, v_width_in_bytes);
+    }
+    v_i = (((uint64_t)(self->private_impl.f_dst_x)) *
+           ((uint64_t)(v_bytes_per_pixel)));
+    if (v_i < ((uint64_t)(v_dst.len))) {
+      v_j = (((uint64_t)(self->private_impl.f_frame_rect_x1)) *
+             ((uint64_t)(v_bytes_per_pixel)));
+      if ((v_i <= v_j) && (v_j <= ((uint64_t)(v_dst.len)))) {
+        v_dst = wuffs_base__slice_u8__subslice_ij(v_dst, v_i, v_j);
+      } else {
+        v_dst = wuffs_base__slice_u8__subslice_i(v_dst, v_i);
+      }
+      v_n = wuffs_base__pixel_swizzler__swizzle_interleaved(
+          &self->private_impl.f_swizzler, v_dst,
+          wuffs_base__make_slice_u8(self->private_data.f_dst_palette, 1024),
+          v_src);
+      wuffs_base__u64__sat_add_indirect(&v_src_ri, v_n);
+      wuffs_base__u32__sat_add_indirect(&self->private_impl.f_dst_x,
+                                        ((uint32_t)((v_n & 4294967295))));
+      self->private_impl.f_dirty_max_excl_y = wuffs_base__u32__max(
+          self->private_impl.f_dirty_max_excl_y,
+          wuffs_base__u32__sat_add(self->private_impl.f_dst_y, 1));
+    }
+    if (self->private_impl.f_frame_rect_x1 <= self->private_impl.f_dst_x) {
+      self->private_impl.f_dst_x = self->private_impl.f_frame_rect_x0;
+      if (self->private_impl.f_interlace == 0) {
+        wuffs_base__u32__sat_add_indirect(&self->private_impl.f_dst_y, 1);
+        goto label__0__continue;
+      }
+      if ((self->private_impl.f_num_decoded_frames_value == 0) &&
+          !self->private_impl.f_gc_has_transparent_index &&
+          (self->private_impl.f_interlace > 1)) {
+        v_replicate_src =
+            wuffs_base__table_u8__row(v_tab, self->private_impl.f_dst_y);
+        v_replicate_y0 =
+            wuffs_base__u32__sat_add(self->private_impl.f_dst_y, 1);
+        v_replicate_y1 = wuffs_base__u32__sat_add(
+            self->private_impl.f_dst_y,
+            ((uint32_t)(
+                wuffs_gif__interlace_count[self->private_impl.f_interlace])));
+        v_replicate_y1 = wuffs_base__u32__min(
+            v_replicate_y1, self->private_impl.f_frame_rect_y1);
+        while (v_replicate_y0 < v_replicate_y1) {
+          v_replicate_dst = wuffs_base__table_u8__row(v_tab, v_replicate_y0);
+          wuffs_base__slice_u8__copy_from_slice(v_replicate_dst,
+                                                v_replicate_src);
+          v_replicate_y0 += 1;
+        }
+        self->private_impl.f_dirty_max_excl_y = wuffs_base__u32__max(
+            self->private_impl.f_dirty_max_excl_y, v_replicate_y1);
+      }
+      wuffs_base__u32__sat_add_indirect(
+          &self->private_impl.f_dst_y,
+          ((uint32_t)(
+              wuffs_gif__interlace_delta[self->private_impl.f_interlace])));
+      while (
+          (self->private_impl.f_interlace > 0) &&
+          (self->private_impl.f_dst_y >= self->private_impl.f_frame_rect_y1)) {
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wconversion"
+#endif
+        self->private_impl.f_interlace -= 1;
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+        self->private_impl.f_dst_y = wuffs_base__u32__sat_add(
+            self->private_impl.f_frame_rect_y0,
+            wuffs_gif__interlace_start[self->private_impl.f_interlace]);
+      }
+      goto label__0__continue;
+    }
+    if (((uint64_t)(a_src.len)) == v_src_ri) {
+      goto label__0__break;
+    } else if (((uint64_t)(a_src.len)) < v_src_ri) {
+      return wuffs_base__make_status(
+          wuffs_gif__error__internal_error_inconsistent_ri_wi);
+    }
+    v_n = ((uint64_t)(
+        (self->private_impl.f_frame_rect_x1 - self->private_impl.f_dst_x)));
+    v_n = wuffs_base__u64__min(v_n, (((uint64_t)(a_src.len)) - v_src_ri));
+    wuffs_base__u64__sat_add_indirect(&v_src_ri, v_n);
+    wuffs_base__u32__sat_add_indirect(&self->private_impl.f_dst_x,
+                                      ((uint32_t)((v_n & 4294967295))));
+    if (self->private_impl.f_frame_rect_x1 <= self->private_impl.f_dst_x) {
+      self->private_impl.f_dst_x = self->private_impl.f_frame_rect_x0;
+      wuffs_base__u32__sat_add_indirect(
+          &self->private_impl.f_dst_y,
+          ((uint32_t)(
+              wuffs_gif__interlace_delta[self->private_impl.f_interlace])));
+      while (
+          (self->private_impl.f_interlace > 0) &&
+          (self->private_impl.f_dst_y >= self->private_impl.f_frame_rect_y1)) {
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wconversion"
+#endif
+        self->private_impl.f_interlace -= 1;
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+        self->private_impl.f_dst_y = wuffs_base__u32__sat_add(
+            self->private_impl.f_frame_rect_y0,
+            wuffs_gif__interlace_start[self->private_impl.f_interlace]);
+      }
+      goto label__0__continue;
+    }
+    if (v_src_ri != ((uint64_t)(a_src.len))) {
+      return wuffs_base__make_status(
+          wuffs_gif__error__internal_error_inconsistent_ri_wi);
+    }
+    goto label__0__break;
+  }
+label__0__break:;
+  return wuffs_base__make_status(NULL);
+}
+
+// -------- func gif.encoder.set_num_animation_loops
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_gif__encoder__set_num_animation_loops(wuffs_gif__encoder* self,
+                                            uint32_t a_n) {
+  if (!self) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_empty_struct();
+  }
+
+  self->private_impl.f_num_loops_plus_1 = wuffs_base__u32__sat_add(a_n, 1);
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func gif.encoder.encode_frame
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_gif__encoder__encode_frame(wuffs_gif__encoder* self,
+                                 wuffs_base__io_buffer* a_dst,
+                                 wuffs_base__pixel_buffer* a_src,
+                                 uint64_t a_duration) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_status(
+        (self->private_impl.magic == WUFFS_BASE__DISABLED)
+            ? wuffs_base__error__disabled_by_previous_error
+            : wuffs_base__error__initialize_not_called);
+  }
+  if (!a_dst || !a_src) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+  }
+  if ((self->private_impl.active_coroutine != 0) &&
+      (self->private_impl.active_coroutine != 1)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(
+        wuffs_base__error__interleaved_coroutine_calls);
+  }
+  self->private_impl.active_coroutine = 0;
   wuffs_base__status status = wuffs_base__make_status(NULL);
 
-  uint8_t v_flags = 0;
-  uint8_t v_background_color_index = 0;
-  uint32_t v_num_palette_entries = 0;
+  wuffs_base__pixel_format v_pixfmt = {0};
+  uint64_t v_width = 0;
+  uint64_t v_height = 0;
+  wuffs_base__slice_u8 v_palette = {0};
   uint32_t v_i = 0;
-  uint32_t v_j = 0;
-  uint32_t v_argb = 0;
+  uint64_t v_x = 0;
+  uint64_t v_delay = 0;
+  bool v_has_lct = false;
 
-  uint8_t* iop_a_src = NULL;
-  uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
-  uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
-  uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
-  if (a_src) {
-    io0_a_src = a_src->data.ptr;
-    io1_a_src = io0_a_src + a_src->meta.ri;
-    iop_a_src = io1_a_src;
-    io2_a_src = io0_a_src + a_src->meta.wi;
+  uint8_t* iop_a_dst = NULL;
+  uint8_t* io0_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_dst) {
+    io0_a_dst = a_dst->data.ptr;
+    io1_a_dst = io0_a_dst + a_dst->meta.wi;
+    iop_a_dst = io1_a_dst;
+    io2_a_dst = io0_a_dst + a_dst->data.len;
+    if (a_dst->meta.closed) {
+      io2_a_dst = iop_a_dst;
+    }
   }
 
-  uint32_t coro_susp_point = self->private_impl.p_decode_lsd[0];
+  uint32_t coro_susp_point = self->private_impl.p_encode_frame[0];
   if (coro_susp_point) {
-    v_flags = self->private_data.s_decode_lsd[0].v_flags;
-    v_background_color_index =
-        self->private_data.s_decode_lsd[0].v_background_color_index;
-    v_num_palette_entries =
-        self->private_data.s_decode_lsd[0].v_num_palette_entries;
-    v_i = self->private_data.s_decode_lsd[0].v_i;
+    v_i = self->private_data.s_encode_frame[0].v_i;
+    v_x = self->private_data.s_encode_frame[0].v_x;
+    v_delay = self->private_data.s_encode_frame[0].v_delay;
+    v_has_lct = self->private_data.s_encode_frame[0].v_has_lct;
   }
   switch (coro_susp_point) {
     WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
 
-    {
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
-      uint32_t t_0;
-      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
-        t_0 = ((uint32_t)(wuffs_base__load_u16le__no_bounds_check(iop_a_src)));
-        iop_a_src += 2;
-      } else {
-        self->private_data.s_decode_lsd[0].scratch = 0;
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
-        while (true) {
-          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-            status =
-                wuffs_base__make_status(wuffs_base__suspension__short_read);
-            goto suspend;
-          }
-          uint64_t* scratch = &self->private_data.s_decode_lsd[0].scratch;
-          uint32_t num_bits_0 = ((uint32_t)(*scratch >> 56));
-          *scratch <<= 8;
-          *scratch >>= 8;
-          *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_0;
-          if (num_bits_0 == 8) {
-            t_0 = ((uint32_t)(*scratch));
-            break;
-          }
-          num_bits_0 += 8;
-          *scratch |= ((uint64_t)(num_bits_0)) << 56;
+    v_pixfmt = wuffs_base__pixel_buffer__pixel_format(a_src);
+    if (wuffs_base__pixel_format__bits_per_pixel(&v_pixfmt) != 8) {
+      status =
+          wuffs_base__make_status(wuffs_gif__error__unsupported_pixel_format);
+      goto exit;
+    }
+    v_palette = wuffs_base__pixel_buffer__palette(a_src);
+    if (((uint64_t)(v_palette.len)) != 1024) {
+      status =
+          wuffs_base__make_status(wuffs_gif__error__unsupported_pixel_format);
+      goto exit;
+    }
+    v_width = ((uint64_t)(wuffs_base__pixel_buffer__plane(a_src, 0).width));
+    v_height = ((uint64_t)(wuffs_base__pixel_buffer__plane(a_src, 0).height));
+    if ((v_width > 65535) || (v_height > 65535)) {
+      status = wuffs_base__make_status(wuffs_gif__error__bad_frame_size);
+      goto exit;
+    }
+    if (self->private_impl.f_header_written) {
+      if ((v_width != ((uint64_t)(self->private_impl.f_width))) ||
+          (v_height != ((uint64_t)(self->private_impl.f_height)))) {
+        status = wuffs_base__make_status(wuffs_gif__error__bad_frame_size);
+        goto exit;
+      }
+      wuffs_base__slice_u8__copy_from_slice(
+          wuffs_base__make_slice_u8(self->private_data.f_palettes[1], 1024),
+          v_palette);
+      v_i = 0;
+      while (v_i < 1024) {
+        if (self->private_data.f_palettes[0][v_i] !=
+            self->private_data.f_palettes[1][v_i]) {
+          v_has_lct = true;
+          goto label__0__break;
         }
+        v_i += 1;
+      }
+    label__0__break:;
+    } else {
+      self->private_impl.f_width = ((uint32_t)(v_width));
+      self->private_impl.f_height = ((uint32_t)(v_height));
+      wuffs_base__slice_u8__copy_from_slice(
+          wuffs_base__make_slice_u8(self->private_data.f_palettes[0], 1024),
+          v_palette);
+      v_x = 106898385160519;
+      v_i = 0;
+      while (v_i < 6) {
+        self->private_data.s_encode_frame[0].scratch = ((uint8_t)((v_x & 255)));
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+        if (iop_a_dst == io2_a_dst) {
+          status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+          goto suspend;
+        }
+        *iop_a_dst++ =
+            ((uint8_t)(self->private_data.s_encode_frame[0].scratch));
+        v_x >>= 8;
+        v_i += 1;
+      }
+      if (a_dst) {
+        a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+      }
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+      status = wuffs_gif__encoder__write_u16le(self, a_dst,
+                                               self->private_impl.f_width);
+      if (a_dst) {
+        iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+      }
+      if (status.repr) {
+        goto suspend;
+      }
+      if (a_dst) {
+        a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
       }
-      self->private_impl.f_width = t_0;
-    }
-    {
       WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
-      uint32_t t_1;
-      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
-        t_1 = ((uint32_t)(wuffs_base__load_u16le__no_bounds_check(iop_a_src)));
-        iop_a_src += 2;
-      } else {
-        self->private_data.s_decode_lsd[0].scratch = 0;
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
-        while (true) {
-          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+      status = wuffs_gif__encoder__write_u16le(self, a_dst,
+                                               self->private_impl.f_height);
+      if (a_dst) {
+        iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+      }
+      if (status.repr) {
+        goto suspend;
+      }
+      self->private_data.s_encode_frame[0].scratch = 247;
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+      if (iop_a_dst == io2_a_dst) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+        goto suspend;
+      }
+      *iop_a_dst++ = ((uint8_t)(self->private_data.s_encode_frame[0].scratch));
+      self->private_data.s_encode_frame[0].scratch = 0;
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(5);
+      if (iop_a_dst == io2_a_dst) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+        goto suspend;
+      }
+      *iop_a_dst++ = ((uint8_t)(self->private_data.s_encode_frame[0].scratch));
+      self->private_data.s_encode_frame[0].scratch = 0;
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(6);
+      if (iop_a_dst == io2_a_dst) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+        goto suspend;
+      }
+      *iop_a_dst++ = ((uint8_t)(self->private_data.s_encode_frame[0].scratch));
+      if (a_dst) {
+        a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+      }
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(7);
+      status = wuffs_gif__encoder__write_color_table(self, a_dst, 0);
+      if (a_dst) {
+        iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+      }
+      if (status.repr) {
+        goto suspend;
+      }
+      if ((self->private_impl.f_num_loops_plus_1 != 0) &&
+          (self->private_impl.f_num_loops_plus_1 != 2)) {
+        self->private_data.s_encode_frame[0].scratch = 33;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(8);
+        if (iop_a_dst == io2_a_dst) {
+          status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+          goto suspend;
+        }
+        *iop_a_dst++ =
+            ((uint8_t)(self->private_data.s_encode_frame[0].scratch));
+        self->private_data.s_encode_frame[0].scratch = 255;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(9);
+        if (iop_a_dst == io2_a_dst) {
+          status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+          goto suspend;
+        }
+        *iop_a_dst++ =
+            ((uint8_t)(self->private_data.s_encode_frame[0].scratch));
+        self->private_data.s_encode_frame[0].scratch = 11;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(10);
+        if (iop_a_dst == io2_a_dst) {
+          status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+          goto suspend;
+        }
+        *iop_a_dst++ =
+            ((uint8_t)(self->private_data.s_encode_frame[0].scratch));
+        v_i = 0;
+        while (v_i < 11) {
+          self->private_data.s_encode_frame[0].scratch =
+              wuffs_gif__netscape2dot0[v_i];
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(11);
+          if (iop_a_dst == io2_a_dst) {
             status =
-                wuffs_base__make_status(wuffs_base__suspension__short_read);
+                wuffs_base__make_status(wuffs_base__suspension__short_write);
             goto suspend;
           }
-          uint64_t* scratch = &self->private_data.s_decode_lsd[0].scratch;
-          uint32_t num_bits_1 = ((uint32_t)(*scratch >> 56));
-          *scratch <<= 8;
-          *scratch >>= 8;
-          *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_1;
-          if (num_bits_1 == 8) {
-            t_1 = ((uint32_t)(*scratch));
-            break;
+          *iop_a_dst++ =
+              ((uint8_t)(self->private_data.s_encode_frame[0].scratch));
+          v_i += 1;
+        }
+        self->private_data.s_encode_frame[0].scratch = 3;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(12);
+        if (iop_a_dst == io2_a_dst) {
+          status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+          goto suspend;
+        }
+        *iop_a_dst++ =
+            ((uint8_t)(self->private_data.s_encode_frame[0].scratch));
+        self->private_data.s_encode_frame[0].scratch = 1;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(13);
+        if (iop_a_dst == io2_a_dst) {
+          status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+          goto suspend;
+        }
+        *iop_a_dst++ =
+            ((uint8_t)(self->private_data.s_encode_frame[0].scratch));
+        if (self->private_impl.f_num_loops_plus_1 == 1) {
+          if (a_dst) {
+            a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
           }
-          num_bits_1 += 8;
-          *scratch |= ((uint64_t)(num_bits_1)) << 56;
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(14);
+          status = wuffs_gif__encoder__write_u16le(self, a_dst, 0);
+          if (a_dst) {
+            iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+          }
+          if (status.repr) {
+            goto suspend;
+          }
+        } else {
+          v_x = ((uint64_t)(wuffs_base__u32__sat_sub(
+              self->private_impl.f_num_loops_plus_1, 2)));
+          v_x = wuffs_base__u64__min(v_x, 65535);
+          if (a_dst) {
+            a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+          }
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(15);
+          status =
+              wuffs_gif__encoder__write_u16le(self, a_dst, ((uint32_t)(v_x)));
+          if (a_dst) {
+            iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+          }
+          if (status.repr) {
+            goto suspend;
+          }
+        }
+        self->private_data.s_encode_frame[0].scratch = 0;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(16);
+        if (iop_a_dst == io2_a_dst) {
+          status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+          goto suspend;
         }
+        *iop_a_dst++ =
+            ((uint8_t)(self->private_data.s_encode_frame[0].scratch));
       }
-      self->private_impl.f_height = t_1;
+      self->private_impl.f_header_written = true;
     }
-    {
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(5);
-      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+    v_delay = (a_duration / 7056000);
+    v_delay = wuffs_base__u64__min(v_delay, 65535);
+    self->private_data.s_encode_frame[0].scratch = 33;
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(17);
+    if (iop_a_dst == io2_a_dst) {
+      status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+      goto suspend;
+    }
+    *iop_a_dst++ = ((uint8_t)(self->private_data.s_encode_frame[0].scratch));
+    self->private_data.s_encode_frame[0].scratch = 249;
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(18);
+    if (iop_a_dst == io2_a_dst) {
+      status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+      goto suspend;
+    }
+    *iop_a_dst++ = ((uint8_t)(self->private_data.s_encode_frame[0].scratch));
+    self->private_data.s_encode_frame[0].scratch = 4;
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(19);
+    if (iop_a_dst == io2_a_dst) {
+      status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+      goto suspend;
+    }
+    *iop_a_dst++ = ((uint8_t)(self->private_data.s_encode_frame[0].scratch));
+    self->private_data.s_encode_frame[0].scratch = 0;
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(20);
+    if (iop_a_dst == io2_a_dst) {
+      status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+      goto suspend;
+    }
+    *iop_a_dst++ = ((uint8_t)(self->private_data.s_encode_frame[0].scratch));
+    if (a_dst) {
+      a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+    }
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(21);
+    status =
+        wuffs_gif__encoder__write_u16le(self, a_dst, ((uint32_t)(v_delay)));
+    if (a_dst) {
+      iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+    }
+    if (status.repr) {
+      goto suspend;
+    }
+    self->private_data.s_encode_frame[0].scratch = 0;
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(22);
+    if (iop_a_dst == io2_a_dst) {
+      status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+      goto suspend;
+    }
+    *iop_a_dst++ = ((uint8_t)(self->private_data.s_encode_frame[0].scratch));
+    self->private_data.s_encode_frame[0].scratch = 0;
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(23);
+    if (iop_a_dst == io2_a_dst) {
+      status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+      goto suspend;
+    }
+    *iop_a_dst++ = ((uint8_t)(self->private_data.s_encode_frame[0].scratch));
+    self->private_data.s_encode_frame[0].scratch = 44;
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(24);
+    if (iop_a_dst == io2_a_dst) {
+      status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+      goto suspend;
+    }
+    *iop_a_dst++ = ((uint8_t)(self->private_data.s_encode_frame[0].scratch));
+    if (a_dst) {
+      a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+    }
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(25);
+    status = wuffs_gif__encoder__write_u16le(self, a_dst, 0);
+    if (a_dst) {
+      iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+    }
+    if (status.repr) {
+      goto suspend;
+    }
+    if (a_dst) {
+      a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+    }
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(26);
+    status = wuffs_gif__encoder__write_u16le(self, a_dst, 0);
+    if (a_dst) {
+      iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+    }
+    if (status.repr) {
+      goto suspend;
+    }
+    if (a_dst) {
+      a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+    }
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(27);
+    status = wuffs_gif__encoder__write_u16le(self, a_dst,
+                                             self->private_impl.f_width);
+    if (a_dst) {
+      iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+    }
+    if (status.repr) {
+      goto suspend;
+    }
+    if (a_dst) {
+      a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+    }
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(28);
+    status = wuffs_gif__encoder__write_u16le(self, a_dst,
+                                             self->private_impl.f_height);
+    if (a_dst) {
+      iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+    }
+    if (status.repr) {
+      goto suspend;
+    }
+    if (v_has_lct) {
+      self->private_data.s_encode_frame[0].scratch = 135;
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(29);
+      if (iop_a_dst == io2_a_dst) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_write);
         goto suspend;
       }
-      uint8_t t_2 = *iop_a_src++;
-      v_flags = t_2;
-    }
-    {
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(6);
-      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+      *iop_a_dst++ = ((uint8_t)(self->private_data.s_encode_frame[0].scratch));
+      if (a_dst) {
+        a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+      }
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(30);
+      status = wuffs_gif__encoder__write_color_table(self, a_dst, 1);
+      if (a_dst) {
+        iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+      }
+      if (status.repr) {
+        goto suspend;
+      }
+    } else {
+      self->private_data.s_encode_frame[0].scratch = 0;
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(31);
+      if (iop_a_dst == io2_a_dst) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_write);
         goto suspend;
       }
-      uint8_t t_3 = *iop_a_src++;
-      v_background_color_index = t_3;
+      *iop_a_dst++ = ((uint8_t)(self->private_data.s_encode_frame[0].scratch));
     }
-    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(7);
-    if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-      status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+    self->private_data.s_encode_frame[0].scratch = 8;
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(32);
+    if (iop_a_dst == io2_a_dst) {
+      status = wuffs_base__make_status(wuffs_base__suspension__short_write);
       goto suspend;
     }
-    iop_a_src++;
-    v_i = 0;
-    self->private_impl.f_has_global_palette = ((v_flags & 128) != 0);
-    if (self->private_impl.f_has_global_palette) {
-      v_num_palette_entries = (((uint32_t)(1)) << (1 + (v_flags & 7)));
-      while (v_i < v_num_palette_entries) {
-        {
-          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(8);
-          uint32_t t_4;
-          if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 3)) {
-            t_4 = ((uint32_t)(
-                wuffs_base__load_u24be__no_bounds_check(iop_a_src)));
-            iop_a_src += 3;
-          } else {
-            self->private_data.s_decode_lsd[0].scratch = 0;
-            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(9);
-            while (true) {
-              if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-                status =
-                    wuffs_base__make_status(wuffs_base__suspension__short_read);
-                goto suspend;
-              }
-              uint64_t* scratch = &self->private_data.s_decode_lsd[0].scratch;
-              uint32_t num_bits_4 = ((uint32_t)(*scratch & 0xFF));
-              *scratch >>= 8;
-              *scratch <<= 8;
-              *scratch |= ((uint64_t)(*iop_a_src++)) << (56 - num_bits_4);
-              if (num_bits_4 == 16) {
-                t_4 = ((uint32_t)(*scratch >> 40));
-                break;
-              }
-              num_bits_4 += 8;
-              *scratch |= ((uint64_t)(num_bits_4));
-            }
-          }
-          v_argb = t_4;
-        }
-        v_argb |= 4278190080;
-        self->private_data.f_palettes[0][((4 * v_i) + 0)] =
-            ((uint8_t)(((v_argb >> 0) & 255)));
-        self->private_data.f_palettes[0][((4 * v_i) + 1)] =
-            ((uint8_t)(((v_argb >> 8) & 255)));
-        self->private_data.f_palettes[0][((4 * v_i) + 2)] =
-            ((uint8_t)(((v_argb >> 16) & 255)));
-        self->private_data.f_palettes[0][((4 * v_i) + 3)] =
-            ((uint8_t)(((v_argb >> 24) & 255)));
-        v_i += 1;
-      }
-      if (self->private_impl.f_quirk_enabled_honor_background_color) {
-        if ((v_background_color_index != 0) &&
-            (((uint32_t)(v_background_color_index)) < v_num_palette_entries)) {
-          v_j = (4 * ((uint32_t)(v_background_color_index)));
-          self->private_impl.f_background_color_u32_argb_premul =
-              ((((uint32_t)(self->private_data.f_palettes[0][(v_j + 0)]))
-                << 0) |
-               (((uint32_t)(self->private_data.f_palettes[0][(v_j + 1)]))
-                << 8) |
-               (((uint32_t)(self->private_data.f_palettes[0][(v_j + 2)]))
-                << 16) |
-               (((uint32_t)(self->private_data.f_palettes[0][(v_j + 3)]))
-                << 24));
-        } else {
-          self->private_impl.f_background_color_u32_argb_premul = 77;
-        }
-      }
+    *iop_a_dst++ = ((uint8_t)(self->private_data.s_encode_frame[0].scratch));
+    wuffs_lzw__encoder__set_literal_width(&self->private_data.f_lzw, 8);
+    if (a_dst) {
+      a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
     }
-    while (v_i < 256) {
-      self->private_data.f_palettes[0][((4 * v_i) + 0)] = 0;
-      self->private_data.f_palettes[0][((4 * v_i) + 1)] = 0;
-      self->private_data.f_palettes[0][((4 * v_i) + 2)] = 0;
-      self->private_data.f_palettes[0][((4 * v_i) + 3)] = 255;
-      v_i += 1;
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(33);
+    status = wuffs_gif__encoder__write_image_data(self, a_dst, a_src);
+    if (a_dst) {
+      iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+    }
+    if (status.repr) {
+      goto suspend;
     }
 
     goto ok;
   ok:
-    self->private_impl.p_decode_lsd[0] = 0;
+    self->private_impl.p_encode_frame[0] = 0;
     goto exit;
   }
 
   goto suspend;
 suspend:
-  self->private_impl.p_decode_lsd[0] =
+  self->private_impl.p_encode_frame[0] =
       wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
-  self->private_data.s_decode_lsd[0].v_flags = v_flags;
-  self->private_data.s_decode_lsd[0].v_background_color_index =
-      v_background_color_index;
-  self->private_data.s_decode_lsd[0].v_num_palette_entries =
-      v_num_palette_entries;
-  self->private_data.s_decode_lsd[0].v_i = v_i;
+  self->private_impl.active_coroutine =
+      wuffs_base__status__is_suspension(&status) ? 1 : 0;
+  self->private_data.s_encode_frame[0].v_i = v_i;
+  self->private_data.s_encode_frame[0].v_x = v_x;
+  self->private_data.s_encode_frame[0].v_delay = v_delay;
+  self->private_data.s_encode_frame[0].v_has_lct = v_has_lct;
 
   goto exit;
 exit:
-  if (a_src) {
-    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  if (a_dst) {
+    a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
   }
 
+  if (wuffs_base__status__is_error(&status)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+  }
   return status;
 }
 
-// -------- func gif.decoder.decode_extension
+// -------- func gif.encoder.encode_trailer
 
-static wuffs_base__status  //
-wuffs_gif__decoder__decode_extension(wuffs_gif__decoder* self,
-                                     wuffs_base__io_buffer* a_src) {
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_gif__encoder__encode_trailer(wuffs_gif__encoder* self,
+                                   wuffs_base__io_buffer* a_dst) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_status(
+        (self->private_impl.magic == WUFFS_BASE__DISABLED)
+            ? wuffs_base__error__disabled_by_previous_error
+            : wuffs_base__error__initialize_not_called);
+  }
+  if (!a_dst) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+  }
+  if ((self->private_impl.active_coroutine != 0) &&
+      (self->private_impl.active_coroutine != 2)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(
+        wuffs_base__error__interleaved_coroutine_calls);
+  }
+  self->private_impl.active_coroutine = 0;
   wuffs_base__status status = wuffs_base__make_status(NULL);
 
-  uint8_t v_label = 0;
-
-  uint8_t* iop_a_src = NULL;
-  uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
-  uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
-  uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
-  if (a_src) {
-    io0_a_src = a_src->data.ptr;
-    io1_a_src = io0_a_src + a_src->meta.ri;
-    iop_a_src = io1_a_src;
-    io2_a_src = io0_a_src + a_src->meta.wi;
+  uint8_t* iop_a_dst = NULL;
+  uint8_t* io0_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_dst) {
+    io0_a_dst = a_dst->data.ptr;
+    io1_a_dst = io0_a_dst + a_dst->meta.wi;
+    iop_a_dst = io1_a_dst;
+    io2_a_dst = io0_a_dst + a_dst->data.len;
+    if (a_dst->meta.closed) {
+      io2_a_dst = iop_a_dst;
+    }
   }
 
-  uint32_t coro_susp_point = self->private_impl.p_decode_extension[0];
+  uint32_t coro_susp_point = self->private_impl.p_encode_trailer[0];
   switch (coro_susp_point) {
     WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
 
-    {
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
-      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-        goto suspend;
-      }
-      uint8_t t_0 = *iop_a_src++;
-      v_label = t_0;
-    }
-    if (v_label == 249) {
-      if (a_src) {
-        a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
-      }
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
-      status = wuffs_gif__decoder__decode_gc(self, a_src);
-      if (a_src) {
-        iop_a_src = a_src->data.ptr + a_src->meta.ri;
-      }
-      if (status.repr) {
-        goto suspend;
-      }
-      status = wuffs_base__make_status(NULL);
-      goto ok;
-    } else if (v_label == 255) {
-      if (a_src) {
-        a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
-      }
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
-      status = wuffs_gif__decoder__decode_ae(self, a_src);
-      if (a_src) {
-        iop_a_src = a_src->data.ptr + a_src->meta.ri;
-      }
-      if (status.repr) {
-        goto suspend;
-      }
-      status = wuffs_base__make_status(NULL);
-      goto ok;
-    }
-    if (a_src) {
-      a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
-    }
-    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
-    status = wuffs_gif__decoder__skip_blocks(self, a_src);
-    if (a_src) {
-      iop_a_src = a_src->data.ptr + a_src->meta.ri;
+    if (!self->private_impl.f_header_written) {
+      status = wuffs_base__make_status(wuffs_base__error__bad_call_sequence);
+      goto exit;
     }
-    if (status.repr) {
+    self->private_data.s_encode_trailer[0].scratch = 59;
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+    if (iop_a_dst == io2_a_dst) {
+      status = wuffs_base__make_status(wuffs_base__suspension__short_write);
       goto suspend;
     }
+    *iop_a_dst++ = ((uint8_t)(self->private_data.s_encode_trailer[0].scratch));
+    self->private_impl.f_header_written = false;
 
     goto ok;
   ok:
-    self->private_impl.p_decode_extension[0] = 0;
+    self->private_impl.p_encode_trailer[0] = 0;
     goto exit;
   }
 
   goto suspend;
 suspend:
-  self->private_impl.p_decode_extension[0] =
+  self->private_impl.p_encode_trailer[0] =
       wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_impl.active_coroutine =
+      wuffs_base__status__is_suspension(&status) ? 2 : 0;
 
   goto exit;
 exit:
-  if (a_src) {
-    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  if (a_dst) {
+    a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
   }
 
+  if (wuffs_base__status__is_error(&status)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+  }
   return status;
 }
 
-// -------- func gif.decoder.skip_blocks
+// -------- func gif.encoder.write_u16le
 
 static wuffs_base__status  //
-wuffs_gif__decoder__skip_blocks(wuffs_gif__decoder* self,
-                                wuffs_base__io_buffer* a_src) {
+wuffs_gif__encoder__write_u16le(wuffs_gif__encoder* self,
+                                wuffs_base__io_buffer* a_dst,
+                                uint32_t a_a) {
   wuffs_base__status status = wuffs_base__make_status(NULL);
 
-  uint8_t v_block_size = 0;
-
-  uint8_t* iop_a_src = NULL;
-  uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
-  uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
-  uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
-  if (a_src) {
-    io0_a_src = a_src->data.ptr;
-    io1_a_src = io0_a_src + a_src->meta.ri;
-    iop_a_src = io1_a_src;
-    io2_a_src = io0_a_src + a_src->meta.wi;
-  }
-
-  uint32_t coro_susp_point = self->private_impl.p_skip_blocks[0];
-  switch (coro_susp_point) {
-    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
-
-    while (true) {
-      {
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
-        if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-          goto suspend;
-        }
-        uint8_t t_0 = *iop_a_src++;
-        v_block_size = t_0;
-      }
-      if (v_block_size == 0) {
-        status = wuffs_base__make_status(NULL);
-        goto ok;
-      }
-      self->private_data.s_skip_blocks[0].scratch = ((uint32_t)(v_block_size));
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
-      if (self->private_data.s_skip_blocks[0].scratch >
-          ((uint64_t)(io2_a_src - iop_a_src))) {
-        self->private_data.s_skip_blocks[0].scratch -=
-            ((uint64_t)(io2_a_src - iop_a_src));
-        iop_a_src = io2_a_src;
-        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-        goto suspend;
-      }
-      iop_a_src += self->private_data.s_skip_blocks[0].scratch;
+  uint8_t* iop_a_dst = NULL;
+  uint8_t* io0_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_dst) {
+    io0_a_dst = a_dst->data.ptr;
+    io1_a_dst = io0_a_dst + a_dst->meta.wi;
+    iop_a_dst = io1_a_dst;
+    io2_a_dst = io0_a_dst + a_dst->data.len;
+    if (a_dst->meta.closed) {
+      io2_a_dst = iop_a_dst;
+    }
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_write_u16le[0];
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    self->private_data.s_write_u16le[0].scratch = ((uint8_t)((a_a & 255)));
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+    if (iop_a_dst == io2_a_dst) {
+      status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+      goto suspend;
     }
+    *iop_a_dst++ = ((uint8_t)(self->private_data.s_write_u16le[0].scratch));
+    self->private_data.s_write_u16le[0].scratch = ((uint8_t)((a_a >> 8)));
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+    if (iop_a_dst == io2_a_dst) {
+      status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+      goto suspend;
+    }
+    *iop_a_dst++ = ((uint8_t)(self->private_data.s_write_u16le[0].scratch));
 
     goto ok;
   ok:
-    self->private_impl.p_skip_blocks[0] = 0;
+    self->private_impl.p_write_u16le[0] = 0;
     goto exit;
   }
 
   goto suspend;
 suspend:
-  self->private_impl.p_skip_blocks[0] =
+  self->private_impl.p_write_u16le[0] =
       wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
 
   goto exit;
 exit:
-  if (a_src) {
-    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  if (a_dst) {
+    a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
   }
 
   return status;
 }
 
-// -------- func gif.decoder.decode_ae
+// -------- func gif.encoder.write_color_table
 
 static wuffs_base__status  //
-wuffs_gif__decoder__decode_ae(wuffs_gif__decoder* self,
-                              wuffs_base__io_buffer* a_src) {
+wuffs_gif__encoder__write_color_table(wuffs_gif__encoder* self,
+                                      wuffs_base__io_buffer* a_dst,
+                                      uint32_t a_which) {
   wuffs_base__status status = wuffs_base__make_status(NULL);
 
-  uint8_t v_c = 0;
-  uint8_t v_block_size = 0;
-  bool v_is_animexts = false;
-  bool v_is_netscape = false;
-  bool v_is_iccp = false;
-  bool v_is_xmp = false;
+  uint32_t v_i = 0;
 
-  uint8_t* iop_a_src = NULL;
-  uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
-  uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
-  uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
-  if (a_src) {
-    io0_a_src = a_src->data.ptr;
-    io1_a_src = io0_a_src + a_src->meta.ri;
-    iop_a_src = io1_a_src;
-    io2_a_src = io0_a_src + a_src->meta.wi;
+  uint8_t* iop_a_dst = NULL;
+  uint8_t* io0_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_dst) {
+    io0_a_dst = a_dst->data.ptr;
+    io1_a_dst = io0_a_dst + a_dst->meta.wi;
+    iop_a_dst = io1_a_dst;
+    io2_a_dst = io0_a_dst + a_dst->data.len;
+    if (a_dst->meta.closed) {
+      io2_a_dst = iop_a_dst;
+    }
   }
 
-  uint32_t coro_susp_point = self->private_impl.p_decode_ae[0];
+  uint32_t coro_susp_point = self->private_impl.p_write_color_table[0];
   if (coro_susp_point) {
-    v_block_size = self->private_data.s_decode_ae[0].v_block_size;
-    v_is_animexts = self->private_data.s_decode_ae[0].v_is_animexts;
-    v_is_netscape = self->private_data.s_decode_ae[0].v_is_netscape;
-    v_is_iccp = self->private_data.s_decode_ae[0].v_is_iccp;
-    v_is_xmp = self->private_data.s_decode_ae[0].v_is_xmp;
+    v_i = self->private_data.s_write_color_table[0].v_i;
   }
   switch (coro_susp_point) {
     WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
 
-    while (true) {
-      {
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
-        if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-          goto suspend;
-        }
-        uint8_t t_0 = *iop_a_src++;
-        v_block_size = t_0;
-      }
-      if (v_block_size == 0) {
-        status = wuffs_base__make_status(NULL);
-        goto ok;
-      }
-      if (v_block_size != 11) {
-        self->private_data.s_decode_ae[0].scratch = ((uint32_t)(v_block_size));
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
-        if (self->private_data.s_decode_ae[0].scratch >
-            ((uint64_t)(io2_a_src - iop_a_src))) {
-          self->private_data.s_decode_ae[0].scratch -=
-              ((uint64_t)(io2_a_src - iop_a_src));
-          iop_a_src = io2_a_src;
-          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-          goto suspend;
-        }
-        iop_a_src += self->private_data.s_decode_ae[0].scratch;
-        goto label__goto_done__break;
-      }
-      v_is_animexts = true;
-      v_is_netscape = true;
-      v_is_iccp = true;
-      v_is_xmp = true;
-      v_block_size = 0;
-      while (v_block_size < 11) {
-        {
-          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
-          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-            status =
-                wuffs_base__make_status(wuffs_base__suspension__short_read);
-            goto suspend;
-          }
-          uint8_t t_1 = *iop_a_src++;
-          v_c = t_1;
-        }
-        v_is_animexts =
-            (v_is_animexts && (v_c == wuffs_gif__animexts1dot0[v_block_size]));
-        v_is_netscape =
-            (v_is_netscape && (v_c == wuffs_gif__netscape2dot0[v_block_size]));
-        v_is_iccp =
-            (v_is_iccp && (v_c == wuffs_gif__iccrgbg1012[v_block_size]));
-        v_is_xmp = (v_is_xmp && (v_c == wuffs_gif__xmpdataxmp[v_block_size]));
-#if defined(__GNUC__)
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wconversion"
-#endif
-        v_block_size += 1;
-#if defined(__GNUC__)
-#pragma GCC diagnostic pop
-#endif
+    v_i = 0;
+    while (v_i < 256) {
+      self->private_data.s_write_color_table[0].scratch =
+          self->private_data.f_palettes[a_which][((4 * v_i) + 2)];
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+      if (iop_a_dst == io2_a_dst) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+        goto suspend;
       }
-      if (v_is_animexts || v_is_netscape) {
-        {
-          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
-          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-            status =
-                wuffs_base__make_status(wuffs_base__suspension__short_read);
-            goto suspend;
-          }
-          uint8_t t_2 = *iop_a_src++;
-          v_block_size = t_2;
-        }
-        if (v_block_size != 3) {
-          self->private_data.s_decode_ae[0].scratch =
-              ((uint32_t)(v_block_size));
-          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(5);
-          if (self->private_data.s_decode_ae[0].scratch >
-              ((uint64_t)(io2_a_src - iop_a_src))) {
-            self->private_data.s_decode_ae[0].scratch -=
-                ((uint64_t)(io2_a_src - iop_a_src));
-            iop_a_src = io2_a_src;
-            status =
-                wuffs_base__make_status(wuffs_base__suspension__short_read);
-            goto suspend;
-          }
-          iop_a_src += self->private_data.s_decode_ae[0].scratch;
-          goto label__goto_done__break;
-        }
-        {
-          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(6);
-          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-            status =
-                wuffs_base__make_status(wuffs_base__suspension__short_read);
-            goto suspend;
-          }
-          uint8_t t_3 = *iop_a_src++;
-          v_c = t_3;
-        }
-        if (v_c != 1) {
-          self->private_data.s_decode_ae[0].scratch = 2;
-          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(7);
-          if (self->private_data.s_decode_ae[0].scratch >
-              ((uint64_t)(io2_a_src - iop_a_src))) {
-            self->private_data.s_decode_ae[0].scratch -=
-                ((uint64_t)(io2_a_src - iop_a_src));
-            iop_a_src = io2_a_src;
-            status =
-                wuffs_base__make_status(wuffs_base__suspension__short_read);
-            goto suspend;
-          }
-          iop_a_src += self->private_data.s_decode_ae[0].scratch;
-          goto label__goto_done__break;
-        }
-        {
-          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(8);
-          uint32_t t_4;
-          if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
-            t_4 = ((uint32_t)(
-                wuffs_base__load_u16le__no_bounds_check(iop_a_src)));
-            iop_a_src += 2;
-          } else {
-            self->private_data.s_decode_ae[0].scratch = 0;
-            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(9);
-            while (true) {
-              if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-                status =
-                    wuffs_base__make_status(wuffs_base__suspension__short_read);
-                goto suspend;
-              }
-              uint64_t* scratch = &self->private_data.s_decode_ae[0].scratch;
-              uint32_t num_bits_4 = ((uint32_t)(*scratch >> 56));
-              *scratch <<= 8;
-              *scratch >>= 8;
-              *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_4;
-              if (num_bits_4 == 8) {
-                t_4 = ((uint32_t)(*scratch));
-                break;
-              }
-              num_bits_4 += 8;
-              *scratch |= ((uint64_t)(num_bits_4)) << 56;
-            }
-          }
-          self->private_impl.f_num_loops = t_4;
-        }
-        self->private_impl.f_seen_num_loops = true;
-        if ((0 < self->private_impl.f_num_loops) &&
-            (self->private_impl.f_num_loops <= 65535)) {
-          self->private_impl.f_num_loops += 1;
-        }
-      } else if (self->private_impl.f_ignore_metadata) {
-      } else if (v_is_iccp && self->private_impl.f_report_metadata_iccp) {
-        while (((uint64_t)(io2_a_src - iop_a_src)) <= 0) {
-          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-          WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(10);
-        }
-        self->private_impl.f_metadata_chunk_length_value =
-            ((uint64_t)(wuffs_base__load_u8be__no_bounds_check(iop_a_src)));
-        (iop_a_src += 1, wuffs_base__make_empty_struct());
-        self->private_impl.f_metadata_fourcc_value = 1229144912;
-        self->private_impl.f_metadata_io_position = wuffs_base__u64__sat_add(
-            wuffs_base__u64__sat_add(a_src->meta.pos,
-                                     ((uint64_t)(iop_a_src - io0_a_src))),
-            self->private_impl.f_metadata_chunk_length_value);
-        self->private_impl.f_call_sequence = 1;
-        status = wuffs_base__make_status(wuffs_base__note__metadata_reported);
-        goto ok;
-      } else if (v_is_xmp && self->private_impl.f_report_metadata_xmp) {
-        while (((uint64_t)(io2_a_src - iop_a_src)) <= 0) {
-          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-          WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(11);
-        }
-        self->private_impl.f_metadata_chunk_length_value =
-            ((uint64_t)(wuffs_base__load_u8be__no_bounds_check(iop_a_src)));
-        if (self->private_impl.f_metadata_chunk_length_value > 0) {
-          self->private_impl.f_metadata_chunk_length_value += 1;
-        } else {
-          (iop_a_src += 1, wuffs_base__make_empty_struct());
-        }
-        self->private_impl.f_metadata_fourcc_value = 1481461792;
-        self->private_impl.f_metadata_io_position = wuffs_base__u64__sat_add(
-            wuffs_base__u64__sat_add(a_src->meta.pos,
-                                     ((uint64_t)(iop_a_src - io0_a_src))),
-            self->private_impl.f_metadata_chunk_length_value);
-        self->private_impl.f_call_sequence = 1;
-        status = wuffs_base__make_status(wuffs_base__note__metadata_reported);
-        goto ok;
+      *iop_a_dst++ =
+          ((uint8_t)(self->private_data.s_write_color_table[0].scratch));
+      self->private_data.s_write_color_table[0].scratch =
+          self->private_data.f_palettes[a_which][((4 * v_i) + 1)];
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+      if (iop_a_dst == io2_a_dst) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+        goto suspend;
       }
-      goto label__goto_done__break;
-    }
-  label__goto_done__break:;
-    if (a_src) {
-      a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
-    }
-    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(12);
-    status = wuffs_gif__decoder__skip_blocks(self, a_src);
-    if (a_src) {
-      iop_a_src = a_src->data.ptr + a_src->meta.ri;
-    }
-    if (status.repr) {
-      goto suspend;
+      *iop_a_dst++ =
+          ((uint8_t)(self->private_data.s_write_color_table[0].scratch));
+      self->private_data.s_write_color_table[0].scratch =
+          self->private_data.f_palettes[a_which][((4 * v_i) + 0)];
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+      if (iop_a_dst == io2_a_dst) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+        goto suspend;
+      }
+      *iop_a_dst++ =
+          ((uint8_t)(self->private_data.s_write_color_table[0].scratch));
+      v_i += 1;
     }
 
     goto ok;
   ok:
-    self->private_impl.p_decode_ae[0] = 0;
+    self->private_impl.p_write_color_table[0] = 0;
     goto exit;
   }
 
   goto suspend;
 suspend:
-  self->private_impl.p_decode_ae[0] =
+  self->private_impl.p_write_color_table[0] =
       wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
-  self->private_data.s_decode_ae[0].v_block_size = v_block_size;
-  self->private_data.s_decode_ae[0].v_is_animexts = v_is_animexts;
-  self->private_data.s_decode_ae[0].v_is_netscape = v_is_netscape;
-  self->private_data.s_decode_ae[0].v_is_iccp = v_is_iccp;
-  self->private_data.s_decode_ae[0].v_is_xmp = v_is_xmp;
+  self->private_data.s_write_color_table[0].v_i = v_i;
 
   goto exit;
 exit:
-  if (a_src) {
-    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  if (a_dst) {
+    a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
   }
 
   return status;
 }
 
-// -------- func gif.decoder.decode_gc
+// -------- func gif.encoder.write_image_data
 
 static wuffs_base__status  //
-wuffs_gif__decoder__decode_gc(wuffs_gif__decoder* self,
-                              wuffs_base__io_buffer* a_src) {
+wuffs_gif__encoder__write_image_data(wuffs_gif__encoder* self,
+                                     wuffs_base__io_buffer* a_dst,
+                                     wuffs_base__pixel_buffer* a_src) {
   wuffs_base__status status = wuffs_base__make_status(NULL);
 
-  uint8_t v_c = 0;
-  uint8_t v_flags = 0;
-  uint16_t v_gc_duration_centiseconds = 0;
+  uint32_t v_height = 0;
+  uint32_t v_y = 0;
+  wuffs_base__slice_u8 v_row = {0};
+  uint64_t v_row_ri = 0;
+  uint64_t v_block_wi = 0;
+  wuffs_base__io_buffer u_r = wuffs_base__empty_io_buffer();
+  wuffs_base__io_buffer* v_r = &u_r;
+  uint8_t* iop_v_r WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io0_v_r WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_v_r WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_v_r WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  wuffs_base__io_buffer u_w = wuffs_base__empty_io_buffer();
+  wuffs_base__io_buffer* v_w = &u_w;
+  uint8_t* iop_v_w WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io0_v_w WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_v_w WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_v_w WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint64_t v_r_mark = 0;
+  uint64_t v_w_mark = 0;
+  wuffs_base__status v_lzw_status = wuffs_base__make_status(NULL);
+  uint64_t v_i = 0;
 
-  uint8_t* iop_a_src = NULL;
-  uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
-  uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
-  uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
-  if (a_src) {
-    io0_a_src = a_src->data.ptr;
-    io1_a_src = io0_a_src + a_src->meta.ri;
-    iop_a_src = io1_a_src;
-    io2_a_src = io0_a_src + a_src->meta.wi;
+  uint8_t* iop_a_dst = NULL;
+  uint8_t* io0_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_dst) {
+    io0_a_dst = a_dst->data.ptr;
+    io1_a_dst = io0_a_dst + a_dst->meta.wi;
+    iop_a_dst = io1_a_dst;
+    io2_a_dst = io0_a_dst + a_dst->data.len;
+    if (a_dst->meta.closed) {
+      io2_a_dst = iop_a_dst;
+    }
   }
 
-  uint32_t coro_susp_point = self->private_impl.p_decode_gc[0];
+  uint32_t coro_susp_point = self->private_impl.p_write_image_data[0];
+  if (coro_susp_point) {
+    v_height = self->private_data.s_write_image_data[0].v_height;
+    v_y = self->private_data.s_write_image_data[0].v_y;
+    v_row_ri = self->private_data.s_write_image_data[0].v_row_ri;
+    v_block_wi = self->private_data.s_write_image_data[0].v_block_wi;
+    v_lzw_status = self->private_data.s_write_image_data[0].v_lzw_status;
+    v_i = self->private_data.s_write_image_data[0].v_i;
+  }
   switch (coro_susp_point) {
     WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
 
-    {
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
-      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-        goto suspend;
+    v_height = self->private_impl.f_height;
+    while (true) {
+      if (v_y < v_height) {
+        v_row = wuffs_base__table_u8__row(
+            wuffs_base__pixel_buffer__plane(a_src, 0), v_y);
+        if (v_row_ri > ((uint64_t)(v_row.len))) {
+          status = wuffs_base__make_status(
+              wuffs_gif__error__internal_error_inconsistent_encoder_state);
+          goto exit;
+        }
+        v_row = wuffs_base__slice_u8__subslice_i(v_row, v_row_ri);
+      } else {
+        v_row = wuffs_base__utility__empty_slice_u8();
+        wuffs_lzw__encoder__close_input(&self->private_data.f_lzw);
       }
-      uint8_t t_0 = *iop_a_src++;
-      v_c = t_0;
-    }
-    if (v_c != 4) {
-      status = wuffs_base__make_status(wuffs_gif__error__bad_graphic_control);
-      goto exit;
-    }
-    {
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
-      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-        goto suspend;
+      {
+        wuffs_base__io_buffer* o_0_v_r = v_r;
+        uint8_t* o_0_iop_v_r = iop_v_r;
+        uint8_t* o_0_io0_v_r = io0_v_r;
+        uint8_t* o_0_io1_v_r = io1_v_r;
+        uint8_t* o_0_io2_v_r = io2_v_r;
+        v_r = wuffs_base__io_reader__set(&u_r, &iop_v_r, &io0_v_r, &io1_v_r,
+                                         &io2_v_r, v_row);
+        {
+          wuffs_base__io_buffer* o_1_v_w = v_w;
+          uint8_t* o_1_iop_v_w = iop_v_w;
+          uint8_t* o_1_io0_v_w = io0_v_w;
+          uint8_t* o_1_io1_v_w = io1_v_w;
+          uint8_t* o_1_io2_v_w = io2_v_w;
+          v_w = wuffs_base__io_writer__set(
+              &u_w, &iop_v_w, &io0_v_w, &io1_v_w, &io2_v_w,
+              wuffs_base__slice_u8__subslice_i(
+                  wuffs_base__make_slice_u8(self->private_data.f_block, 255),
+                  v_block_wi));
+          v_r_mark = ((uint64_t)(iop_v_r - io0_v_r));
+          v_w_mark = ((uint64_t)(iop_v_w - io0_v_w));
+          {
+            u_w.meta.wi = ((size_t)(iop_v_w - u_w.data.ptr));
+            u_r.meta.ri = ((size_t)(iop_v_r - u_r.data.ptr));
+            wuffs_base__status t_0 = wuffs_lzw__encoder__transform_io(
+                &self->private_data.f_lzw, v_w, v_r,
+                wuffs_base__utility__empty_slice_u8());
+            iop_v_w = u_w.data.ptr + u_w.meta.wi;
+            iop_v_r = u_r.data.ptr + u_r.meta.ri;
+            v_lzw_status = t_0;
+          }
+          wuffs_base__u64__sat_add_indirect(
+              &v_row_ri, wuffs_base__io__count_since(
+                             v_r_mark, ((uint64_t)(iop_v_r - io0_v_r))));
+          v_i = wuffs_base__u64__sat_add(
+              v_block_wi, wuffs_base__io__count_since(
+                              v_w_mark, ((uint64_t)(iop_v_w - io0_v_w))));
+          v_block_wi = wuffs_base__u64__min(v_i, 255);
+          v_w = o_1_v_w;
+          iop_v_w = o_1_iop_v_w;
+          io0_v_w = o_1_io0_v_w;
+          io1_v_w = o_1_io1_v_w;
+          io2_v_w = o_1_io2_v_w;
+        }
+        v_r = o_0_v_r;
+        iop_v_r = o_0_iop_v_r;
+        io0_v_r = o_0_io0_v_r;
+        io1_v_r = o_0_io1_v_r;
+        io2_v_r = o_0_io2_v_r;
+      }
+      if ((v_block_wi >= 255) ||
+          (wuffs_base__status__is_ok(&v_lzw_status) && (v_block_wi > 0))) {
+        if ((((uint64_t)(io2_a_dst - iop_a_dst)) >= 1) &&
+            (((uint64_t)(io2_a_dst - iop_a_dst)) > v_block_wi)) {
+          (wuffs_base__store_u8be__no_bounds_check(iop_a_dst,
+                                                   ((uint8_t)(v_block_wi))),
+           iop_a_dst += 1, wuffs_base__make_empty_struct());
+          wuffs_base__io_writer__copy_from_slice(
+              &iop_a_dst, io2_a_dst,
+              wuffs_base__slice_u8__subslice_j(
+                  wuffs_base__make_slice_u8(self->private_data.f_block, 255),
+                  v_block_wi));
+          v_block_wi = 0;
+        }
       }
-      uint8_t t_1 = *iop_a_src++;
-      v_flags = t_1;
-    }
-    self->private_impl.f_gc_has_transparent_index = ((v_flags & 1) != 0);
-    v_flags = ((v_flags >> 2) & 7);
-    if (v_flags == 2) {
-      self->private_impl.f_gc_disposal = 1;
-    } else if ((v_flags == 3) || (v_flags == 4)) {
-      self->private_impl.f_gc_disposal = 2;
-    } else {
-      self->private_impl.f_gc_disposal = 0;
-    }
-    {
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
-      uint16_t t_2;
-      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
-        t_2 = wuffs_base__load_u16le__no_bounds_check(iop_a_src);
-        iop_a_src += 2;
-      } else {
-        self->private_data.s_decode_gc[0].scratch = 0;
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
-        while (true) {
-          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+      if ((v_block_wi >= 255) ||
+          (wuffs_base__status__is_ok(&v_lzw_status) && (v_block_wi > 0))) {
+        self->private_data.s_write_image_data[0].scratch =
+            ((uint8_t)(v_block_wi));
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+        if (iop_a_dst == io2_a_dst) {
+          status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+          goto suspend;
+        }
+        *iop_a_dst++ =
+            ((uint8_t)(self->private_data.s_write_image_data[0].scratch));
+        v_i = 0;
+        while (v_i < v_block_wi) {
+          self->private_data.s_write_image_data[0].scratch =
+              self->private_data.f_block[v_i];
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+          if (iop_a_dst == io2_a_dst) {
             status =
-                wuffs_base__make_status(wuffs_base__suspension__short_read);
+                wuffs_base__make_status(wuffs_base__suspension__short_write);
             goto suspend;
           }
-          uint64_t* scratch = &self->private_data.s_decode_gc[0].scratch;
-          uint32_t num_bits_2 = ((uint32_t)(*scratch >> 56));
-          *scratch <<= 8;
-          *scratch >>= 8;
-          *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_2;
-          if (num_bits_2 == 8) {
-            t_2 = ((uint16_t)(*scratch));
-            break;
-          }
-          num_bits_2 += 8;
-          *scratch |= ((uint64_t)(num_bits_2)) << 56;
+          *iop_a_dst++ =
+              ((uint8_t)(self->private_data.s_write_image_data[0].scratch));
+          v_i += 1;
         }
+        v_block_wi = 0;
       }
-      v_gc_duration_centiseconds = t_2;
-    }
-    self->private_impl.f_gc_duration =
-        (((uint64_t)(v_gc_duration_centiseconds)) * 7056000);
-    {
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(5);
-      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-        goto suspend;
+      if (wuffs_base__status__is_ok(&v_lzw_status)) {
+        goto label__0__break;
+      } else if (v_lzw_status.repr ==
+                 wuffs_base__make_status(wuffs_base__suspension__short_read)
+                     .repr) {
+        if (v_y >= v_height) {
+          status = wuffs_base__make_status(
+              wuffs_gif__error__internal_error_inconsistent_encoder_state);
+          goto exit;
+        }
+        v_y += 1;
+        v_row_ri = 0;
+      } else if (v_lzw_status.repr !=
+                 wuffs_base__make_status(wuffs_base__suspension__short_write)
+                     .repr) {
+        status = v_lzw_status;
+        if (wuffs_base__status__is_error(&status)) {
+          goto exit;
+        } else if (wuffs_base__status__is_suspension(&status)) {
+          status = wuffs_base__make_status(
+              wuffs_base__error__cannot_return_a_suspension);
+          goto exit;
+        }
+        goto ok;
       }
-      uint8_t t_3 = *iop_a_src++;
-      self->private_impl.f_gc_transparent_index = t_3;
     }
-    {
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(6);
-      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-        goto suspend;
-      }
-      uint8_t t_4 = *iop_a_src++;
-      v_c = t_4;
+  label__0__break:;
+    self->private_data.s_write_image_data[0].scratch = 0;
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+    if (iop_a_dst == io2_a_dst) {
+      status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+      goto suspend;
+    }
+    *iop_a_dst++ =
+        ((uint8_t)(self->private_data.s_write_image_data[0].scratch));
+
+    goto ok;
+  ok:
+    self->private_impl.p_write_image_data[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+suspend:
+  self->private_impl.p_write_image_data[0] =
+      wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_data.s_write_image_data[0].v_height = v_height;
+  self->private_data.s_write_image_data[0].v_y = v_y;
+  self->private_data.s_write_image_data[0].v_row_ri = v_row_ri;
+  self->private_data.s_write_image_data[0].v_block_wi = v_block_wi;
+  self->private_data.s_write_image_data[0].v_lzw_status = v_lzw_status;
+  self->private_data.s_write_image_data[0].v_i = v_i;
+
+  goto exit;
+exit:
+  if (a_dst) {
+    a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+  }
+
+  return status;
+}
+
+#endif  // !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__GIF)
+
+#if !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__GZIP)
+
+// ---------------- Status Codes Implementations
+
+const char* wuffs_gzip__error__bad_checksum = "#gzip: bad checksum";
+const char* wuffs_gzip__error__bad_compression_method =
+    "#gzip: bad compression method";
+const char* wuffs_gzip__error__bad_encoding_flags = "#gzip: bad encoding flags";
+const char* wuffs_gzip__error__bad_header = "#gzip: bad header";
+
+// ---------------- Private Consts
+
+// ---------------- Private Initializer Prototypes
+
+// ---------------- Private Function Prototypes
+
+// ---------------- VTables
+
+const wuffs_base__io_transformer__func_ptrs
+    wuffs_gzip__decoder__func_ptrs_for__wuffs_base__io_transformer = {
+        (wuffs_base__status(*)(void*,
+                               wuffs_base__io_buffer*,
+                               wuffs_base__io_buffer*,
+                               wuffs_base__slice_u8))(
+            &wuffs_gzip__decoder__transform_io),
+        (wuffs_base__range_ii_u64(*)(const void*))(
+            &wuffs_gzip__decoder__workbuf_len),
+};
+
+const wuffs_base__io_transformer__func_ptrs
+    wuffs_gzip__encoder__func_ptrs_for__wuffs_base__io_transformer = {
+        (wuffs_base__status(*)(void*,
+                               wuffs_base__io_buffer*,
+                               wuffs_base__io_buffer*,
+                               wuffs_base__slice_u8))(
+            &wuffs_gzip__encoder__transform_io),
+        (wuffs_base__range_ii_u64(*)(const void*))(
+            &wuffs_gzip__encoder__workbuf_len),
+};
+
+// ---------------- Initializer Implementations
+
+wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT  //
+wuffs_gzip__decoder__initialize(wuffs_gzip__decoder* self,
+                                size_t sizeof_star_self,
+                                uint64_t wuffs_version,
+                                uint32_t initialize_flags) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (sizeof(*self) != sizeof_star_self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_sizeof_receiver);
+  }
+  if (((wuffs_version >> 32) != WUFFS_VERSION_MAJOR) ||
+      (((wuffs_version >> 16) & 0xFFFF) > WUFFS_VERSION_MINOR)) {
+    return wuffs_base__make_status(wuffs_base__error__bad_wuffs_version);
+  }
+
+  if ((initialize_flags & WUFFS_INITIALIZE__ALREADY_ZEROED) != 0) {
+// The whole point of this if-check is to detect an uninitialized *self.
+// We disable the warning on GCC. Clang-5.0 does not have this warning.
+#if !defined(__clang__) && defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+    if (self->private_impl.magic != 0) {
+      return wuffs_base__make_status(
+          wuffs_base__error__initialize_falsely_claimed_already_zeroed);
     }
-    if (v_c != 0) {
-      status = wuffs_base__make_status(wuffs_gif__error__bad_graphic_control);
-      goto exit;
+#if !defined(__clang__) && defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+  } else {
+    if ((initialize_flags &
+         WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED) == 0) {
+      memset(self, 0, sizeof(*self));
+      initialize_flags |= WUFFS_INITIALIZE__ALREADY_ZEROED;
+    } else {
+      memset(&(self->private_impl), 0, sizeof(self->private_impl));
     }
-
-    goto ok;
-  ok:
-    self->private_impl.p_decode_gc[0] = 0;
-    goto exit;
   }
 
-  goto suspend;
-suspend:
-  self->private_impl.p_decode_gc[0] =
-      wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
-
-  goto exit;
-exit:
-  if (a_src) {
-    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  {
+    wuffs_base__status z = wuffs_crc32__ieee_hasher__initialize(
+        &self->private_data.f_checksum, sizeof(self->private_data.f_checksum),
+        WUFFS_VERSION, initialize_flags);
+    if (z.repr) {
+      return z;
+    }
   }
-
-  return status;
+  {
+    wuffs_base__status z = wuffs_deflate__decoder__initialize(
+        &self->private_data.f_flate, sizeof(self->private_data.f_flate),
+        WUFFS_VERSION, initialize_flags);
+    if (z.repr) {
+      return z;
+    }
+  }
+  self->private_impl.magic = WUFFS_BASE__MAGIC;
+  self->private_impl.vtable_for__wuffs_base__io_transformer.vtable_name =
+      wuffs_base__io_transformer__vtable_name;
+  self->private_impl.vtable_for__wuffs_base__io_transformer.function_pointers =
+      (const void*)(&wuffs_gzip__decoder__func_ptrs_for__wuffs_base__io_transformer);
+  return wuffs_base__make_status(NULL);
 }
 
-// -------- func gif.decoder.decode_id_part0
-
-static wuffs_base__status  //
-wuffs_gif__decoder__decode_id_part0(wuffs_gif__decoder* self,
-                                    wuffs_base__io_buffer* a_src) {
-  wuffs_base__status status = wuffs_base__make_status(NULL);
+size_t  //
+sizeof__wuffs_gzip__decoder() {
+  return sizeof(wuffs_gzip__decoder);
+}
 
-  uint8_t* iop_a_src = NULL;
-  uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
-  uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
-  uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
-  if (a_src) {
-    io0_a_src = a_src->data.ptr;
-    io1_a_src = io0_a_src + a_src->meta.ri;
-    iop_a_src = io1_a_src;
-    io2_a_src = io0_a_src + a_src->meta.wi;
+wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT  //
+wuffs_gzip__encoder__initialize(wuffs_gzip__encoder* self,
+                                size_t sizeof_star_self,
+                                uint64_t wuffs_version,
+                                uint32_t initialize_flags) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (sizeof(*self) != sizeof_star_self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_sizeof_receiver);
+  }
+  if (((wuffs_version >> 32) != WUFFS_VERSION_MAJOR) ||
+      (((wuffs_version >> 16) & 0xFFFF) > WUFFS_VERSION_MINOR)) {
+    return wuffs_base__make_status(wuffs_base__error__bad_wuffs_version);
   }
 
-  uint32_t coro_susp_point = self->private_impl.p_decode_id_part0[0];
-  switch (coro_susp_point) {
-    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
-
-    {
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
-      uint32_t t_0;
-      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
-        t_0 = ((uint32_t)(wuffs_base__load_u16le__no_bounds_check(iop_a_src)));
-        iop_a_src += 2;
-      } else {
-        self->private_data.s_decode_id_part0[0].scratch = 0;
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
-        while (true) {
-          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-            status =
-                wuffs_base__make_status(wuffs_base__suspension__short_read);
-            goto suspend;
-          }
-          uint64_t* scratch = &self->private_data.s_decode_id_part0[0].scratch;
-          uint32_t num_bits_0 = ((uint32_t)(*scratch >> 56));
-          *scratch <<= 8;
-          *scratch >>= 8;
-          *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_0;
-          if (num_bits_0 == 8) {
-            t_0 = ((uint32_t)(*scratch));
-            break;
-          }
-          num_bits_0 += 8;
-          *scratch |= ((uint64_t)(num_bits_0)) << 56;
-        }
-      }
-      self->private_impl.f_frame_rect_x0 = t_0;
-    }
-    {
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
-      uint32_t t_1;
-      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
-        t_1 = ((uint32_t)(wuffs_base__load_u16le__no_bounds_check(iop_a_src)));
-        iop_a_src += 2;
-      } else {
-        self->private_data.s_decode_id_part0[0].scratch = 0;
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
-        while (true) {
-          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-            status =
-                wuffs_base__make_status(wuffs_base__suspension__short_read);
-            goto suspend;
-          }
-          uint64_t* scratch = &self->private_data.s_decode_id_part0[0].scratch;
-          uint32_t num_bits_1 = ((uint32_t)(*scratch >> 56));
-          *scratch <<= 8;
-          *scratch >>= 8;
-          *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_1;
-          if (num_bits_1 == 8) {
-            t_1 = ((uint32_t)(*scratch));
-            break;
-          }
-          num_bits_1 += 8;
-          *scratch |= ((uint64_t)(num_bits_1)) << 56;
-        }
-      }
-      self->private_impl.f_frame_rect_y0 = t_1;
+  if ((initialize_flags & WUFFS_INITIALIZE__ALREADY_ZEROED) != 0) {
+// The whole point of this if-check is to detect an uninitialized *self.
+// We disable the warning on GCC. Clang-5.0 does not have this warning.
+#if !defined(__clang__) && defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+    if (self->private_impl.magic != 0) {
+      return wuffs_base__make_status(
+          wuffs_base__error__initialize_falsely_claimed_already_zeroed);
     }
-    {
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(5);
-      uint32_t t_2;
-      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
-        t_2 = ((uint32_t)(wuffs_base__load_u16le__no_bounds_check(iop_a_src)));
-        iop_a_src += 2;
-      } else {
-        self->private_data.s_decode_id_part0[0].scratch = 0;
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(6);
-        while (true) {
-          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-            status =
-                wuffs_base__make_status(wuffs_base__suspension__short_read);
-            goto suspend;
-          }
-          uint64_t* scratch = &self->private_data.s_decode_id_part0[0].scratch;
-          uint32_t num_bits_2 = ((uint32_t)(*scratch >> 56));
-          *scratch <<= 8;
-          *scratch >>= 8;
-          *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_2;
-          if (num_bits_2 == 8) {
-            t_2 = ((uint32_t)(*scratch));
-            break;
-          }
-          num_bits_2 += 8;
-          *scratch |= ((uint64_t)(num_bits_2)) << 56;
-        }
-      }
-      self->private_impl.f_frame_rect_x1 = t_2;
+#if !defined(__clang__) && defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+  } else {
+    if ((initialize_flags &
+         WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED) == 0) {
+      memset(self, 0, sizeof(*self));
+      initialize_flags |= WUFFS_INITIALIZE__ALREADY_ZEROED;
+    } else {
+      memset(&(self->private_impl), 0, sizeof(self->private_impl));
     }
-    self->private_impl.f_frame_rect_x1 += self->private_impl.f_frame_rect_x0;
-    {
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(7);
-      uint32_t t_3;
-      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
-        t_3 = ((uint32_t)(wuffs_base__load_u16le__no_bounds_check(iop_a_src)));
-        iop_a_src += 2;
-      } else {
-        self->private_data.s_decode_id_part0[0].scratch = 0;
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(8);
-        while (true) {
-          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-            status =
-                wuffs_base__make_status(wuffs_base__suspension__short_read);
-            goto suspend;
-          }
-          uint64_t* scratch = &self->private_data.s_decode_id_part0[0].scratch;
-          uint32_t num_bits_3 = ((uint32_t)(*scratch >> 56));
-          *scratch <<= 8;
-          *scratch >>= 8;
-          *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_3;
-          if (num_bits_3 == 8) {
-            t_3 = ((uint32_t)(*scratch));
-            break;
-          }
-          num_bits_3 += 8;
-          *scratch |= ((uint64_t)(num_bits_3)) << 56;
-        }
-      }
-      self->private_impl.f_frame_rect_y1 = t_3;
+  }
+
+  {
+    wuffs_base__status z = wuffs_crc32__ieee_hasher__initialize(
+        &self->private_data.f_checksum, sizeof(self->private_data.f_checksum),
+        WUFFS_VERSION, initialize_flags);
+    if (z.repr) {
+      return z;
     }
-    self->private_impl.f_frame_rect_y1 += self->private_impl.f_frame_rect_y0;
-    self->private_impl.f_dst_x = self->private_impl.f_frame_rect_x0;
-    self->private_impl.f_dst_y = self->private_impl.f_frame_rect_y0;
-    if ((self->private_impl.f_call_sequence == 0) &&
-        !self->private_impl.f_quirk_enabled_image_bounds_are_strict) {
-      self->private_impl.f_width = wuffs_base__u32__max(
-          self->private_impl.f_width, self->private_impl.f_frame_rect_x1);
-      self->private_impl.f_height = wuffs_base__u32__max(
-          self->private_impl.f_height, self->private_impl.f_frame_rect_y1);
+  }
+  {
+    wuffs_base__status z = wuffs_deflate__encoder__initialize(
+        &self->private_data.f_flate, sizeof(self->private_data.f_flate),
+        WUFFS_VERSION, initialize_flags);
+    if (z.repr) {
+      return z;
     }
+  }
+  self->private_impl.magic = WUFFS_BASE__MAGIC;
+  self->private_impl.vtable_for__wuffs_base__io_transformer.vtable_name =
+      wuffs_base__io_transformer__vtable_name;
+  self->private_impl.vtable_for__wuffs_base__io_transformer.function_pointers =
+      (const void*)(&wuffs_gzip__encoder__func_ptrs_for__wuffs_base__io_transformer);
+  return wuffs_base__make_status(NULL);
+}
 
-    goto ok;
-  ok:
-    self->private_impl.p_decode_id_part0[0] = 0;
-    goto exit;
+size_t  //
+sizeof__wuffs_gzip__encoder() {
+  return sizeof(wuffs_gzip__encoder);
+}
+
+// ---------------- Function Implementations
+
+// -------- func gzip.decoder.reset
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_gzip__decoder__reset(wuffs_gzip__decoder* self) {
+  if (!self) {
+    return wuffs_base__make_empty_struct();
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return wuffs_base__make_empty_struct();
   }
 
-  goto suspend;
-suspend:
-  self->private_impl.p_decode_id_part0[0] =
-      wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_impl.magic = WUFFS_BASE__MAGIC;
+  self->private_impl.active_coroutine = 0;
+  memset(self->private_impl.p_transform_io, 0,
+         sizeof(self->private_impl.p_transform_io));
+
+  wuffs_base__ignore_status(wuffs_crc32__ieee_hasher__initialize(
+      &self->private_data.f_checksum, sizeof(wuffs_crc32__ieee_hasher),
+      WUFFS_VERSION, 0));
+  self->private_impl.f_bgzf_size = 0;
+  wuffs_deflate__decoder__reset(&self->private_data.f_flate);
+  return wuffs_base__make_empty_struct();
+}
 
-  goto exit;
-exit:
-  if (a_src) {
-    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+// -------- func gzip.decoder.set_ignore_checksum
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_gzip__decoder__set_ignore_checksum(wuffs_gzip__decoder* self, bool a_ic) {
+  if (!self) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_empty_struct();
   }
 
-  return status;
+  self->private_impl.f_ignore_checksum = a_ic;
+  return wuffs_base__make_empty_struct();
 }
 
-// -------- func gif.decoder.decode_id_part1
+// -------- func gzip.decoder.set_decode_concatenated_members
 
-static wuffs_base__status  //
-wuffs_gif__decoder__decode_id_part1(wuffs_gif__decoder* self,
-                                    wuffs_base__pixel_buffer* a_dst,
-                                    wuffs_base__io_buffer* a_src,
-                                    wuffs_base__pixel_blend a_blend) {
-  wuffs_base__status status = wuffs_base__make_status(NULL);
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_gzip__decoder__set_decode_concatenated_members(wuffs_gzip__decoder* self,
+                                                     bool a_d) {
+  if (!self) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_empty_struct();
+  }
 
-  uint8_t v_flags = 0;
-  uint8_t v_which_palette = 0;
-  uint32_t v_num_palette_entries = 0;
-  uint32_t v_i = 0;
-  uint32_t v_argb = 0;
-  wuffs_base__slice_u8 v_dst_palette = {0};
-  wuffs_base__status v_status = wuffs_base__make_status(NULL);
-  uint8_t v_lw = 0;
+  self->private_impl.f_decode_concatenated_members = a_d;
+  return wuffs_base__make_empty_struct();
+}
 
-  uint8_t* iop_a_src = NULL;
-  uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
-  uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
-  uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
-  if (a_src) {
-    io0_a_src = a_src->data.ptr;
-    io1_a_src = io0_a_src + a_src->meta.ri;
-    iop_a_src = io1_a_src;
-    io2_a_src = io0_a_src + a_src->meta.wi;
+// -------- func gzip.decoder.bgzf_block_size
+
+WUFFS_BASE__MAYBE_STATIC uint32_t  //
+wuffs_gzip__decoder__bgzf_block_size(const wuffs_gzip__decoder* self) {
+  if (!self) {
+    return 0;
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return 0;
   }
 
-  uint32_t coro_susp_point = self->private_impl.p_decode_id_part1[0];
-  if (coro_susp_point) {
-    v_which_palette = self->private_data.s_decode_id_part1[0].v_which_palette;
-    v_num_palette_entries =
-        self->private_data.s_decode_id_part1[0].v_num_palette_entries;
-    v_i = self->private_data.s_decode_id_part1[0].v_i;
+  return self->private_impl.f_bgzf_size;
+}
+
+// -------- func gzip.decoder.set_whole_output_in_dst
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_gzip__decoder__set_whole_output_in_dst(wuffs_gzip__decoder* self,
+                                             bool a_w) {
+  if (!self) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_empty_struct();
   }
-  switch (coro_susp_point) {
-    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
 
-    {
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
-      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-        goto suspend;
-      }
-      uint8_t t_0 = *iop_a_src++;
-      v_flags = t_0;
-    }
-    if ((v_flags & 64) != 0) {
-      self->private_impl.f_interlace = 4;
-    } else {
-      self->private_impl.f_interlace = 0;
-    }
-    v_which_palette = 1;
-    if ((v_flags & 128) != 0) {
-      v_num_palette_entries = (((uint32_t)(1)) << (1 + (v_flags & 7)));
-      v_i = 0;
-      while (v_i < v_num_palette_entries) {
-        {
-          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
-          uint32_t t_1;
-          if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 3)) {
-            t_1 = ((uint32_t)(
-                wuffs_base__load_u24be__no_bounds_check(iop_a_src)));
-            iop_a_src += 3;
-          } else {
-            self->private_data.s_decode_id_part1[0].scratch = 0;
-            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
-            while (true) {
-              if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-                status =
-                    wuffs_base__make_status(wuffs_base__suspension__short_read);
-                goto suspend;
-              }
-              uint64_t* scratch =
-                  &self->private_data.s_decode_id_part1[0].scratch;
-              uint32_t num_bits_1 = ((uint32_t)(*scratch & 0xFF));
-              *scratch >>= 8;
-              *scratch <<= 8;
-              *scratch |= ((uint64_t)(*iop_a_src++)) << (56 - num_bits_1);
-              if (num_bits_1 == 16) {
-                t_1 = ((uint32_t)(*scratch >> 40));
-                break;
-              }
-              num_bits_1 += 8;
-              *scratch |= ((uint64_t)(num_bits_1));
-            }
-          }
-          v_argb = t_1;
-        }
-        v_argb |= 4278190080;
-        self->private_data.f_palettes[1][((4 * v_i) + 0)] =
-            ((uint8_t)(((v_argb >> 0) & 255)));
-        self->private_data.f_palettes[1][((4 * v_i) + 1)] =
-            ((uint8_t)(((v_argb >> 8) & 255)));
-        self->private_data.f_palettes[1][((4 * v_i) + 2)] =
-            ((uint8_t)(((v_argb >> 16) & 255)));
-        self->private_data.f_palettes[1][((4 * v_i) + 3)] =
-            ((uint8_t)(((v_argb >> 24) & 255)));
-        v_i += 1;
-      }
-      while (v_i < 256) {
-        self->private_data.f_palettes[1][((4 * v_i) + 0)] = 0;
-        self->private_data.f_palettes[1][((4 * v_i) + 1)] = 0;
-        self->private_data.f_palettes[1][((4 * v_i) + 2)] = 0;
-        self->private_data.f_palettes[1][((4 * v_i) + 3)] = 255;
-        v_i += 1;
-      }
-    } else if (self->private_impl.f_quirk_enabled_reject_empty_palette &&
-               !self->private_impl.f_has_global_palette) {
-      status = wuffs_base__make_status(wuffs_gif__error__bad_palette);
-      goto exit;
-    } else if (self->private_impl.f_gc_has_transparent_index) {
-      wuffs_base__slice_u8__copy_from_slice(
-          wuffs_base__make_slice_u8(self->private_data.f_palettes[1], 1024),
-          wuffs_base__make_slice_u8(self->private_data.f_palettes[0], 1024));
-    } else {
-      v_which_palette = 0;
-    }
-    if (self->private_impl.f_gc_has_transparent_index) {
-      self->private_data.f_palettes[1][(
-          (4 * ((uint32_t)(self->private_impl.f_gc_transparent_index))) + 0)] =
-          0;
-      self->private_data.f_palettes[1][(
-          (4 * ((uint32_t)(self->private_impl.f_gc_transparent_index))) + 1)] =
-          0;
-      self->private_data.f_palettes[1][(
-          (4 * ((uint32_t)(self->private_impl.f_gc_transparent_index))) + 2)] =
-          0;
-      self->private_data.f_palettes[1][(
-          (4 * ((uint32_t)(self->private_impl.f_gc_transparent_index))) + 3)] =
-          0;
-    }
-    v_dst_palette = wuffs_base__pixel_buffer__palette(a_dst);
-    if (((uint64_t)(v_dst_palette.len)) == 0) {
-      v_dst_palette =
-          wuffs_base__make_slice_u8(self->private_data.f_dst_palette, 1024);
-    }
-    v_status = wuffs_base__pixel_swizzler__prepare(
-        &self->private_impl.f_swizzler,
-        wuffs_base__pixel_buffer__pixel_format(a_dst), v_dst_palette,
-        wuffs_base__utility__make_pixel_format(1191444488),
-        wuffs_base__make_slice_u8(
-            self->private_data.f_palettes[v_which_palette], 1024),
-        a_blend);
-    if (!wuffs_base__status__is_ok(&v_status)) {
-      status = v_status;
-      if (wuffs_base__status__is_error(&status)) {
-        goto exit;
-      } else if (wuffs_base__status__is_suspension(&status)) {
-        status = wuffs_base__make_status(
-            wuffs_base__error__cannot_return_a_suspension);
-        goto exit;
-      }
-      goto ok;
-    }
-    if (self->private_impl.f_previous_lzw_decode_ended_abruptly) {
-      wuffs_base__ignore_status(wuffs_lzw__decoder__initialize(
-          &self->private_data.f_lzw, sizeof(wuffs_lzw__decoder), WUFFS_VERSION,
-          0));
-    }
-    {
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
-      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-        goto suspend;
-      }
-      uint8_t t_2 = *iop_a_src++;
-      v_lw = t_2;
-    }
-    if (v_lw > 8) {
-      status = wuffs_base__make_status(wuffs_gif__error__bad_literal_width);
-      goto exit;
-    }
-    wuffs_lzw__decoder__set_literal_width(&self->private_data.f_lzw,
-                                          ((uint32_t)(v_lw)));
-    self->private_impl.f_previous_lzw_decode_ended_abruptly = true;
+  wuffs_deflate__decoder__set_whole_output_in_dst(&self->private_data.f_flate,
+                                                  a_w);
+  return wuffs_base__make_empty_struct();
+}
 
-    goto ok;
-  ok:
-    self->private_impl.p_decode_id_part1[0] = 0;
-    goto exit;
+// -------- func gzip.decoder.set_collect_stats
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_gzip__decoder__set_collect_stats(wuffs_gzip__decoder* self, bool a_c) {
+  if (!self) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_empty_struct();
   }
 
-  goto suspend;
-suspend:
-  self->private_impl.p_decode_id_part1[0] =
-      wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
-  self->private_data.s_decode_id_part1[0].v_which_palette = v_which_palette;
-  self->private_data.s_decode_id_part1[0].v_num_palette_entries =
-      v_num_palette_entries;
-  self->private_data.s_decode_id_part1[0].v_i = v_i;
+  wuffs_deflate__decoder__set_collect_stats(&self->private_data.f_flate, a_c);
+  return wuffs_base__make_empty_struct();
+}
 
-  goto exit;
-exit:
-  if (a_src) {
-    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+// -------- func gzip.decoder.stats
+
+WUFFS_BASE__MAYBE_STATIC uint64_t  //
+wuffs_gzip__decoder__stats(const wuffs_gzip__decoder* self, uint32_t a_key) {
+  if (!self) {
+    return 0;
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return 0;
   }
 
-  return status;
+  return wuffs_deflate__decoder__stats(&self->private_data.f_flate, a_key);
 }
 
-// -------- func gif.decoder.decode_id_part2
+// -------- func gzip.decoder.workbuf_len
 
-static wuffs_base__status  //
-wuffs_gif__decoder__decode_id_part2(wuffs_gif__decoder* self,
-                                    wuffs_base__pixel_buffer* a_dst,
-                                    wuffs_base__io_buffer* a_src,
-                                    wuffs_base__slice_u8 a_workbuf) {
-  wuffs_base__io_buffer empty_io_buffer = wuffs_base__empty_io_buffer();
+WUFFS_BASE__MAYBE_STATIC wuffs_base__range_ii_u64  //
+wuffs_gzip__decoder__workbuf_len(const wuffs_gzip__decoder* self) {
+  if (!self) {
+    return wuffs_base__utility__empty_range_ii_u64();
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return wuffs_base__utility__empty_range_ii_u64();
+  }
+
+  return wuffs_base__utility__make_range_ii_u64(33025, 33025);
+}
+
+// -------- func gzip.decoder.transform_io
 
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_gzip__decoder__transform_io(wuffs_gzip__decoder* self,
+                                  wuffs_base__io_buffer* a_dst,
+                                  wuffs_base__io_buffer* a_src,
+                                  wuffs_base__slice_u8 a_workbuf) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_status(
+        (self->private_impl.magic == WUFFS_BASE__DISABLED)
+            ? wuffs_base__error__disabled_by_previous_error
+            : wuffs_base__error__initialize_not_called);
+  }
+  if (!a_dst || !a_src) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+  }
+  if ((self->private_impl.active_coroutine != 0) &&
+      (self->private_impl.active_coroutine != 1)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(
+        wuffs_base__error__interleaved_coroutine_calls);
+  }
+  self->private_impl.active_coroutine = 0;
   wuffs_base__status status = wuffs_base__make_status(NULL);
 
-  uint64_t v_block_size = 0;
-  bool v_need_block_size = false;
-  uint64_t v_n_compressed = 0;
-  wuffs_base__slice_u8 v_compressed = {0};
-  wuffs_base__io_buffer u_r = wuffs_base__empty_io_buffer();
-  wuffs_base__io_buffer* v_r = &u_r;
-  uint8_t* iop_v_r WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
-  uint8_t* io0_v_r WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
-  uint8_t* io1_v_r WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
-  uint8_t* io2_v_r WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t v_c = 0;
+  uint8_t v_flags = 0;
+  uint16_t v_xlen = 0;
+  uint16_t v_si = 0;
+  uint16_t v_slen = 0;
+  uint16_t v_bsize = 0;
   uint64_t v_mark = 0;
-  wuffs_base__status v_lzw_status = wuffs_base__make_status(NULL);
-  wuffs_base__status v_copy_status = wuffs_base__make_status(NULL);
-  wuffs_base__slice_u8 v_uncompressed = {0};
+  uint32_t v_checksum_got = 0;
+  uint32_t v_decoded_length_got = 0;
+  wuffs_base__status v_status = wuffs_base__make_status(NULL);
+  uint32_t v_checksum_want = 0;
+  uint32_t v_decoded_length_want = 0;
 
+  uint8_t* iop_a_dst = NULL;
+  uint8_t* io0_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_dst) {
+    io0_a_dst = a_dst->data.ptr;
+    io1_a_dst = io0_a_dst + a_dst->meta.wi;
+    iop_a_dst = io1_a_dst;
+    io2_a_dst = io0_a_dst + a_dst->data.len;
+    if (a_dst->meta.closed) {
+      io2_a_dst = iop_a_dst;
+    }
+  }
   uint8_t* iop_a_src = NULL;
   uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
   uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
@@ -19374,476 +27148,467 @@ wuffs_gif__decoder__decode_id_part2(wuffs_gif__decoder* self,
     io2_a_src = io0_a_src + a_src->meta.wi;
   }
 
-  uint32_t coro_susp_point = self->private_impl.p_decode_id_part2[0];
+  uint32_t coro_susp_point = self->private_impl.p_transform_io[0];
   if (coro_susp_point) {
-    v_block_size = self->private_data.s_decode_id_part2[0].v_block_size;
-    v_need_block_size =
-        self->private_data.s_decode_id_part2[0].v_need_block_size;
-    v_lzw_status = self->private_data.s_decode_id_part2[0].v_lzw_status;
+    v_flags = self->private_data.s_transform_io[0].v_flags;
+    v_xlen = self->private_data.s_transform_io[0].v_xlen;
+    v_si = self->private_data.s_transform_io[0].v_si;
+    v_checksum_got = self->private_data.s_transform_io[0].v_checksum_got;
+    v_decoded_length_got =
+        self->private_data.s_transform_io[0].v_decoded_length_got;
+    v_checksum_want = self->private_data.s_transform_io[0].v_checksum_want;
   }
   switch (coro_susp_point) {
     WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
 
-    v_need_block_size = true;
-  label__outer__continue:;
     while (true) {
-      if (v_need_block_size) {
-        v_need_block_size = false;
-        {
-          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
-          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-            status =
-                wuffs_base__make_status(wuffs_base__suspension__short_read);
-            goto suspend;
-          }
-          uint64_t t_0 = *iop_a_src++;
-          v_block_size = t_0;
+      {
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+        if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+          goto suspend;
         }
+        uint8_t t_0 = *iop_a_src++;
+        v_c = t_0;
       }
-      if (v_block_size == 0) {
-        goto label__outer__break;
+      if (v_c != 31) {
+        status = wuffs_base__make_status(wuffs_gzip__error__bad_header);
+        goto exit;
       }
-      while (((uint64_t)(io2_a_src - iop_a_src)) == 0) {
-        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(2);
+      {
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+        if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+          goto suspend;
+        }
+        uint8_t t_1 = *iop_a_src++;
+        v_c = t_1;
       }
-      if (self->private_impl.f_compressed_ri ==
-          self->private_impl.f_compressed_wi) {
-        self->private_impl.f_compressed_ri = 0;
-        self->private_impl.f_compressed_wi = 0;
+      if (v_c != 139) {
+        status = wuffs_base__make_status(wuffs_gzip__error__bad_header);
+        goto exit;
       }
-      while (self->private_impl.f_compressed_wi <= 3841) {
-        v_n_compressed = wuffs_base__u64__min(
-            v_block_size, ((uint64_t)(io2_a_src - iop_a_src)));
-        if (v_n_compressed <= 0) {
-          goto label__0__break;
-        }
-        v_compressed =
-            wuffs_base__io_reader__take(&iop_a_src, io2_a_src, v_n_compressed);
-        wuffs_base__slice_u8__copy_from_slice(
-            wuffs_base__slice_u8__subslice_i(
-                wuffs_base__make_slice_u8(self->private_data.f_compressed,
-                                          4096),
-                self->private_impl.f_compressed_wi),
-            v_compressed);
-        wuffs_base__u64__sat_add_indirect(&self->private_impl.f_compressed_wi,
-                                          v_n_compressed);
-        wuffs_base__u64__sat_sub_indirect(&v_block_size, v_n_compressed);
-        if (v_block_size > 0) {
-          goto label__0__break;
-        }
-        if (((uint64_t)(io2_a_src - iop_a_src)) <= 0) {
-          v_need_block_size = true;
-          goto label__0__break;
+      {
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+        if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+          goto suspend;
         }
-        v_block_size =
-            ((uint64_t)(wuffs_base__load_u8be__no_bounds_check(iop_a_src)));
-        (iop_a_src += 1, wuffs_base__make_empty_struct());
+        uint8_t t_2 = *iop_a_src++;
+        v_c = t_2;
       }
-    label__0__break:;
-    label__inner__continue:;
-      while (true) {
-        if ((self->private_impl.f_compressed_ri >
-             self->private_impl.f_compressed_wi) ||
-            (self->private_impl.f_compressed_wi > 4096)) {
-          status = wuffs_base__make_status(
-              wuffs_gif__error__internal_error_inconsistent_ri_wi);
-          goto exit;
+      if (v_c != 8) {
+        status =
+            wuffs_base__make_status(wuffs_gzip__error__bad_compression_method);
+        goto exit;
+      }
+      {
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+        if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+          goto suspend;
         }
+        uint8_t t_3 = *iop_a_src++;
+        v_flags = t_3;
+      }
+      self->private_data.s_transform_io[0].scratch = 6;
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(5);
+      if (self->private_data.s_transform_io[0].scratch >
+          ((uint64_t)(io2_a_src - iop_a_src))) {
+        self->private_data.s_transform_io[0].scratch -=
+            ((uint64_t)(io2_a_src - iop_a_src));
+        iop_a_src = io2_a_src;
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        goto suspend;
+      }
+      iop_a_src += self->private_data.s_transform_io[0].scratch;
+      self->private_impl.f_bgzf_size = 0;
+      if ((v_flags & 4) != 0) {
         {
-          wuffs_base__io_buffer* o_0_v_r = v_r;
-          uint8_t* o_0_iop_v_r = iop_v_r;
-          uint8_t* o_0_io0_v_r = io0_v_r;
-          uint8_t* o_0_io1_v_r = io1_v_r;
-          uint8_t* o_0_io2_v_r = io2_v_r;
-          v_r = wuffs_base__io_reader__set(
-              &u_r, &iop_v_r, &io0_v_r, &io1_v_r, &io2_v_r,
-              wuffs_base__slice_u8__subslice_ij(
-                  wuffs_base__make_slice_u8(self->private_data.f_compressed,
-                                            4096),
-                  self->private_impl.f_compressed_ri,
-                  self->private_impl.f_compressed_wi));
-          v_mark = ((uint64_t)(iop_v_r - io0_v_r));
-          {
-            u_r.meta.ri = ((size_t)(iop_v_r - u_r.data.ptr));
-            wuffs_base__status t_1 = wuffs_lzw__decoder__transform_io(
-                &self->private_data.f_lzw, &empty_io_buffer, v_r,
-                wuffs_base__utility__empty_slice_u8());
-            iop_v_r = u_r.data.ptr + u_r.meta.ri;
-            v_lzw_status = t_1;
-          }
-          wuffs_base__u64__sat_add_indirect(
-              &self->private_impl.f_compressed_ri,
-              wuffs_base__io__count_since(v_mark,
-                                          ((uint64_t)(iop_v_r - io0_v_r))));
-          v_r = o_0_v_r;
-          iop_v_r = o_0_iop_v_r;
-          io0_v_r = o_0_io0_v_r;
-          io1_v_r = o_0_io1_v_r;
-          io2_v_r = o_0_io2_v_r;
-        }
-        v_uncompressed = wuffs_lzw__decoder__flush(&self->private_data.f_lzw);
-        if (((uint64_t)(v_uncompressed.len)) > 0) {
-          v_copy_status = wuffs_gif__decoder__copy_to_image_buffer(
-              self, a_dst, v_uncompressed);
-          if (wuffs_base__status__is_error(&v_copy_status)) {
-            status = v_copy_status;
-            goto exit;
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(6);
+          uint16_t t_4;
+          if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
+            t_4 = wuffs_base__load_u16le__no_bounds_check(iop_a_src);
+            iop_a_src += 2;
+          } else {
+            self->private_data.s_transform_io[0].scratch = 0;
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(7);
+            while (true) {
+              if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+                status =
+                    wuffs_base__make_status(wuffs_base__suspension__short_read);
+                goto suspend;
+              }
+              uint64_t* scratch = &self->private_data.s_transform_io[0].scratch;
+              uint32_t num_bits_4 = ((uint32_t)(*scratch >> 56));
+              *scratch <<= 8;
+              *scratch >>= 8;
+              *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_4;
+              if (num_bits_4 == 8) {
+                t_4 = ((uint16_t)(*scratch));
+                break;
+              }
+              num_bits_4 += 8;
+              *scratch |= ((uint64_t)(num_bits_4)) << 56;
+            }
           }
+          v_xlen = t_4;
         }
-        if (wuffs_base__status__is_ok(&v_lzw_status)) {
-          self->private_impl.f_previous_lzw_decode_ended_abruptly = false;
-          if (v_need_block_size || (v_block_size > 0)) {
-            self->private_data.s_decode_id_part2[0].scratch =
-                ((uint32_t)(v_block_size));
-            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
-            if (self->private_data.s_decode_id_part2[0].scratch >
+        while (v_xlen >= 4) {
+          {
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(8);
+            uint16_t t_5;
+            if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
+              t_5 = wuffs_base__load_u16le__no_bounds_check(iop_a_src);
+              iop_a_src += 2;
+            } else {
+              self->private_data.s_transform_io[0].scratch = 0;
+              WUFFS_BASE__COROUTINE_SUSPENSION_POINT(9);
+              while (true) {
+                if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+                  status = wuffs_base__make_status(
+                      wuffs_base__suspension__short_read);
+                  goto suspend;
+                }
+                uint64_t* scratch =
+                    &self->private_data.s_transform_io[0].scratch;
+                uint32_t num_bits_5 = ((uint32_t)(*scratch >> 56));
+                *scratch <<= 8;
+                *scratch >>= 8;
+                *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_5;
+                if (num_bits_5 == 8) {
+                  t_5 = ((uint16_t)(*scratch));
+                  break;
+                }
+                num_bits_5 += 8;
+                *scratch |= ((uint64_t)(num_bits_5)) << 56;
+              }
+            }
+            v_si = t_5;
+          }
+          {
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(10);
+            uint16_t t_6;
+            if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
+              t_6 = wuffs_base__load_u16le__no_bounds_check(iop_a_src);
+              iop_a_src += 2;
+            } else {
+              self->private_data.s_transform_io[0].scratch = 0;
+              WUFFS_BASE__COROUTINE_SUSPENSION_POINT(11);
+              while (true) {
+                if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+                  status = wuffs_base__make_status(
+                      wuffs_base__suspension__short_read);
+                  goto suspend;
+                }
+                uint64_t* scratch =
+                    &self->private_data.s_transform_io[0].scratch;
+                uint32_t num_bits_6 = ((uint32_t)(*scratch >> 56));
+                *scratch <<= 8;
+                *scratch >>= 8;
+                *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_6;
+                if (num_bits_6 == 8) {
+                  t_6 = ((uint16_t)(*scratch));
+                  break;
+                }
+                num_bits_6 += 8;
+                *scratch |= ((uint64_t)(num_bits_6)) << 56;
+              }
+            }
+            v_slen = t_6;
+          }
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wconversion"
+#endif
+          v_xlen -= 4;
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+          if (v_xlen < v_slen) {
+            goto label__0__break;
+          }
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wconversion"
+#endif
+          v_xlen -= v_slen;
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+          if ((v_si == 17218) && (v_slen == 2)) {
+            {
+              WUFFS_BASE__COROUTINE_SUSPENSION_POINT(12);
+              uint16_t t_7;
+              if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
+                t_7 = wuffs_base__load_u16le__no_bounds_check(iop_a_src);
+                iop_a_src += 2;
+              } else {
+                self->private_data.s_transform_io[0].scratch = 0;
+                WUFFS_BASE__COROUTINE_SUSPENSION_POINT(13);
+                while (true) {
+                  if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+                    status = wuffs_base__make_status(
+                        wuffs_base__suspension__short_read);
+                    goto suspend;
+                  }
+                  uint64_t* scratch =
+                      &self->private_data.s_transform_io[0].scratch;
+                  uint32_t num_bits_7 = ((uint32_t)(*scratch >> 56));
+                  *scratch <<= 8;
+                  *scratch >>= 8;
+                  *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_7;
+                  if (num_bits_7 == 8) {
+                    t_7 = ((uint16_t)(*scratch));
+                    break;
+                  }
+                  num_bits_7 += 8;
+                  *scratch |= ((uint64_t)(num_bits_7)) << 56;
+                }
+              }
+              v_bsize = t_7;
+            }
+            self->private_impl.f_bgzf_size = (((uint32_t)(v_bsize)) + 1);
+          } else {
+            self->private_data.s_transform_io[0].scratch = ((uint32_t)(v_slen));
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(14);
+            if (self->private_data.s_transform_io[0].scratch >
                 ((uint64_t)(io2_a_src - iop_a_src))) {
-              self->private_data.s_decode_id_part2[0].scratch -=
+              self->private_data.s_transform_io[0].scratch -=
                   ((uint64_t)(io2_a_src - iop_a_src));
               iop_a_src = io2_a_src;
               status =
                   wuffs_base__make_status(wuffs_base__suspension__short_read);
               goto suspend;
             }
-            iop_a_src += self->private_data.s_decode_id_part2[0].scratch;
-            if (a_src) {
-              a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
-            }
-            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
-            status = wuffs_gif__decoder__skip_blocks(self, a_src);
-            if (a_src) {
-              iop_a_src = a_src->data.ptr + a_src->meta.ri;
+            iop_a_src += self->private_data.s_transform_io[0].scratch;
+          }
+        }
+      label__0__break:;
+        self->private_data.s_transform_io[0].scratch = ((uint32_t)(v_xlen));
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(15);
+        if (self->private_data.s_transform_io[0].scratch >
+            ((uint64_t)(io2_a_src - iop_a_src))) {
+          self->private_data.s_transform_io[0].scratch -=
+              ((uint64_t)(io2_a_src - iop_a_src));
+          iop_a_src = io2_a_src;
+          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+          goto suspend;
+        }
+        iop_a_src += self->private_data.s_transform_io[0].scratch;
+      }
+      if ((v_flags & 8) != 0) {
+        while (true) {
+          {
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(16);
+            if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+              status =
+                  wuffs_base__make_status(wuffs_base__suspension__short_read);
+              goto suspend;
             }
-            if (status.repr) {
+            uint8_t t_8 = *iop_a_src++;
+            v_c = t_8;
+          }
+          if (v_c == 0) {
+            goto label__1__break;
+          }
+        }
+      label__1__break:;
+      }
+      if ((v_flags & 16) != 0) {
+        while (true) {
+          {
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(17);
+            if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+              status =
+                  wuffs_base__make_status(wuffs_base__suspension__short_read);
               goto suspend;
             }
+            uint8_t t_9 = *iop_a_src++;
+            v_c = t_9;
+          }
+          if (v_c == 0) {
+            goto label__2__break;
           }
-          goto label__outer__break;
-        } else if (v_lzw_status.repr ==
-                   wuffs_base__make_status(wuffs_base__suspension__short_read)
-                       .repr) {
-          goto label__outer__continue;
-        } else if (v_lzw_status.repr ==
-                   wuffs_base__make_status(wuffs_base__suspension__short_write)
-                       .repr) {
-          goto label__inner__continue;
         }
-        status = v_lzw_status;
-        if (wuffs_base__status__is_error(&status)) {
-          goto exit;
-        } else if (wuffs_base__status__is_suspension(&status)) {
-          status = wuffs_base__make_status(
-              wuffs_base__error__cannot_return_a_suspension);
-          goto exit;
+      label__2__break:;
+      }
+      if ((v_flags & 2) != 0) {
+        self->private_data.s_transform_io[0].scratch = 2;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(18);
+        if (self->private_data.s_transform_io[0].scratch >
+            ((uint64_t)(io2_a_src - iop_a_src))) {
+          self->private_data.s_transform_io[0].scratch -=
+              ((uint64_t)(io2_a_src - iop_a_src));
+          iop_a_src = io2_a_src;
+          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+          goto suspend;
         }
-        goto ok;
+        iop_a_src += self->private_data.s_transform_io[0].scratch;
       }
-    }
-  label__outer__break:;
-    self->private_impl.f_compressed_ri = 0;
-    self->private_impl.f_compressed_wi = 0;
-    if ((self->private_impl.f_dst_y < self->private_impl.f_frame_rect_y1) &&
-        (self->private_impl.f_frame_rect_x0 !=
-         self->private_impl.f_frame_rect_x1) &&
-        (self->private_impl.f_frame_rect_y0 !=
-         self->private_impl.f_frame_rect_y1)) {
-      status = wuffs_base__make_status(wuffs_base__error__not_enough_data);
-      goto exit;
-    }
-
-    goto ok;
-  ok:
-    self->private_impl.p_decode_id_part2[0] = 0;
-    goto exit;
-  }
-
-  goto suspend;
-suspend:
-  self->private_impl.p_decode_id_part2[0] =
-      wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
-  self->private_data.s_decode_id_part2[0].v_block_size = v_block_size;
-  self->private_data.s_decode_id_part2[0].v_need_block_size = v_need_block_size;
-  self->private_data.s_decode_id_part2[0].v_lzw_status = v_lzw_status;
-
-  goto exit;
-exit:
-  if (a_src) {
-    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
-  }
-
-  return status;
-}
-
-// -------- func gif.decoder.copy_to_image_buffer
-
-static wuffs_base__status  //
-wuffs_gif__decoder__copy_to_image_buffer(wuffs_gif__decoder* self,
-                                         wuffs_base__pixel_buffer* a_pb,
-                                         wuffs_base__slice_u8 a_src) {
-  wuffs_base__slice_u8 v_dst = {0};
-  wuffs_base__slice_u8 v_src = {0};
-  uint64_t v_width_in_bytes = 0;
-  uint64_t v_n = 0;
-  uint64_t v_src_ri = 0;
-  wuffs_base__pixel_format v_pixfmt = {0};
-  uint32_t v_bytes_per_pixel = 0;
-  uint32_t v_bits_per_pixel = 0;
-  wuffs_base__table_u8 v_tab = {0};
-  uint64_t v_i = 0;
-  uint64_t v_j = 0;
-  uint32_t v_replicate_y0 = 0;
-  uint32_t v_replicate_y1 = 0;
-  wuffs_base__slice_u8 v_replicate_dst = {0};
-  wuffs_base__slice_u8 v_replicate_src = {0};
-
-  v_pixfmt = wuffs_base__pixel_buffer__pixel_format(a_pb);
-  v_bits_per_pixel = wuffs_base__pixel_format__bits_per_pixel(&v_pixfmt);
-  if ((v_bits_per_pixel & 7) != 0) {
-    return wuffs_base__make_status(wuffs_base__error__unsupported_option);
-  }
-  v_bytes_per_pixel = (v_bits_per_pixel >> 3);
-  v_width_in_bytes = (((uint64_t)(self->private_impl.f_width)) *
-                      ((uint64_t)(v_bytes_per_pixel)));
-  v_tab = wuffs_base__pixel_buffer__plane(a_pb, 0);
-label__0__continue:;
-  while (v_src_ri < ((uint64_t)(a_src.len))) {
-    v_src = wuffs_base__slice_u8__subslice_i(a_src, v_src_ri);
-    if (self->private_impl.f_dst_y >= self->private_impl.f_frame_rect_y1) {
-      if (self->private_impl.f_quirk_enabled_ignore_too_much_pixel_data) {
-        return wuffs_base__make_status(NULL);
+      if ((v_flags & 224) != 0) {
+        status = wuffs_base__make_status(wuffs_gzip__error__bad_encoding_flags);
+        goto exit;
       }
-      return wuffs_base__make_status(wuffs_base__error__too_much_data);
-    }
-    v_dst = wuffs_base__table_u8__row(v_tab, self->private_impl.f_dst_y);
-    if (self->private_impl.f_dst_y >= self->private_impl.f_height) {
-      v_dst = wuffs_base__slice_u8__subslice_j(v_dst, 0);
-    } else if (v_width_in_bytes < ((uint64_t)(v_dst.len))) {
-      v_dst = wuffs_base__slice_u8__subslice_j(v_dst, v_width_in_bytes);
-    }
-    v_i = (((uint64_t)(self->private_impl.f_dst_x)) *
-           ((uint64_t)(v_bytes_per_pixel)));
-    if (v_i < ((uint64_t)(v_dst.len))) {
-      v_j = (((uint64_t)(self->private_impl.f_frame_rect_x1)) *
-             ((uint64_t)(v_bytes_per_pixel)));
-      if ((v_i <= v_j) && (v_j <= ((uint64_t)(v_dst.len)))) {
-        v_dst = wuffs_base__slice_u8__subslice_ij(v_dst, v_i, v_j);
-      } else {
-        v_dst = wuffs_base__slice_u8__subslice_i(v_dst, v_i);
+      v_decoded_length_got = 0;
+      while (true) {
+        v_mark = ((uint64_t)(iop_a_dst - io0_a_dst));
+        {
+          if (a_dst) {
+            a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+          }
+          if (a_src) {
+            a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+          }
+          wuffs_base__status t_10 = wuffs_deflate__decoder__transform_io(
+              &self->private_data.f_flate, a_dst, a_src, a_workbuf);
+          if (a_dst) {
+            iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+          }
+          if (a_src) {
+            iop_a_src = a_src->data.ptr + a_src->meta.ri;
+          }
+          v_status = t_10;
+        }
+        if (!self->private_impl.f_ignore_checksum) {
+          v_checksum_got = wuffs_crc32__ieee_hasher__update_u32(
+              &self->private_data.f_checksum,
+              wuffs_base__io__since(v_mark, ((uint64_t)(iop_a_dst - io0_a_dst)),
+                                    io0_a_dst));
+          v_decoded_length_got +=
+              ((uint32_t)((wuffs_base__io__count_since(
+                               v_mark, ((uint64_t)(iop_a_dst - io0_a_dst))) &
+                           4294967295)));
+        }
+        if (wuffs_base__status__is_ok(&v_status)) {
+          goto label__3__break;
+        }
+        status = v_status;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(19);
       }
-      v_n = wuffs_base__pixel_swizzler__swizzle_interleaved(
-          &self->private_impl.f_swizzler, v_dst,
-          wuffs_base__make_slice_u8(self->private_data.f_dst_palette, 1024),
-          v_src);
-      wuffs_base__u64__sat_add_indirect(&v_src_ri, v_n);
-      wuffs_base__u32__sat_add_indirect(&self->private_impl.f_dst_x,
-                                        ((uint32_t)((v_n & 4294967295))));
-      self->private_impl.f_dirty_max_excl_y = wuffs_base__u32__max(
-          self->private_impl.f_dirty_max_excl_y,
-          wuffs_base__u32__sat_add(self->private_impl.f_dst_y, 1));
-    }
-    if (self->private_impl.f_frame_rect_x1 <= self->private_impl.f_dst_x) {
-      self->private_impl.f_dst_x = self->private_impl.f_frame_rect_x0;
-      if (self->private_impl.f_interlace == 0) {
-        wuffs_base__u32__sat_add_indirect(&self->private_impl.f_dst_y, 1);
-        goto label__0__continue;
+    label__3__break:;
+      {
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(20);
+        uint32_t t_11;
+        if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 4)) {
+          t_11 = wuffs_base__load_u32le__no_bounds_check(iop_a_src);
+          iop_a_src += 4;
+        } else {
+          self->private_data.s_transform_io[0].scratch = 0;
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(21);
+          while (true) {
+            if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+              status =
+                  wuffs_base__make_status(wuffs_base__suspension__short_read);
+              goto suspend;
+            }
+            uint64_t* scratch = &self->private_data.s_transform_io[0].scratch;
+            uint32_t num_bits_11 = ((uint32_t)(*scratch >> 56));
+            *scratch <<= 8;
+            *scratch >>= 8;
+            *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_11;
+            if (num_bits_11 == 24) {
+              t_11 = ((uint32_t)(*scratch));
+              break;
+            }
+            num_bits_11 += 8;
+            *scratch |= ((uint64_t)(num_bits_11)) << 56;
+          }
+        }
+        v_checksum_want = t_11;
       }
-      if ((self->private_impl.f_num_decoded_frames_value == 0) &&
-          !self->private_impl.f_gc_has_transparent_index &&
-          (self->private_impl.f_interlace > 1)) {
-        v_replicate_src =
-            wuffs_base__table_u8__row(v_tab, self->private_impl.f_dst_y);
-        v_replicate_y0 =
-            wuffs_base__u32__sat_add(self->private_impl.f_dst_y, 1);
-        v_replicate_y1 = wuffs_base__u32__sat_add(
-            self->private_impl.f_dst_y,
-            ((uint32_t)(
-                wuffs_gif__interlace_count[self->private_impl.f_interlace])));
-        v_replicate_y1 = wuffs_base__u32__min(
-            v_replicate_y1, self->private_impl.f_frame_rect_y1);
-        while (v_replicate_y0 < v_replicate_y1) {
-          v_replicate_dst = wuffs_base__table_u8__row(v_tab, v_replicate_y0);
-          wuffs_base__slice_u8__copy_from_slice(v_replicate_dst,
-                                                v_replicate_src);
-          v_replicate_y0 += 1;
+      {
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(22);
+        uint32_t t_12;
+        if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 4)) {
+          t_12 = wuffs_base__load_u32le__no_bounds_check(iop_a_src);
+          iop_a_src += 4;
+        } else {
+          self->private_data.s_transform_io[0].scratch = 0;
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(23);
+          while (true) {
+            if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+              status =
+                  wuffs_base__make_status(wuffs_base__suspension__short_read);
+              goto suspend;
+            }
+            uint64_t* scratch = &self->private_data.s_transform_io[0].scratch;
+            uint32_t num_bits_12 = ((uint32_t)(*scratch >> 56));
+            *scratch <<= 8;
+            *scratch >>= 8;
+            *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_12;
+            if (num_bits_12 == 24) {
+              t_12 = ((uint32_t)(*scratch));
+              break;
+            }
+            num_bits_12 += 8;
+            *scratch |= ((uint64_t)(num_bits_12)) << 56;
+          }
         }
-        self->private_impl.f_dirty_max_excl_y = wuffs_base__u32__max(
-            self->private_impl.f_dirty_max_excl_y, v_replicate_y1);
+        v_decoded_length_want = t_12;
       }
-      wuffs_base__u32__sat_add_indirect(
-          &self->private_impl.f_dst_y,
-          ((uint32_t)(
-              wuffs_gif__interlace_delta[self->private_impl.f_interlace])));
-      while (
-          (self->private_impl.f_interlace > 0) &&
-          (self->private_impl.f_dst_y >= self->private_impl.f_frame_rect_y1)) {
-#if defined(__GNUC__)
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wconversion"
-#endif
-        self->private_impl.f_interlace -= 1;
-#if defined(__GNUC__)
-#pragma GCC diagnostic pop
-#endif
-        self->private_impl.f_dst_y = wuffs_base__u32__sat_add(
-            self->private_impl.f_frame_rect_y0,
-            wuffs_gif__interlace_start[self->private_impl.f_interlace]);
+      if (!self->private_impl.f_ignore_checksum &&
+          ((v_checksum_got != v_checksum_want) ||
+           (v_decoded_length_got != v_decoded_length_want))) {
+        status = wuffs_base__make_status(wuffs_gzip__error__bad_checksum);
+        goto exit;
       }
-      goto label__0__continue;
-    }
-    if (((uint64_t)(a_src.len)) == v_src_ri) {
-      goto label__0__break;
-    } else if (((uint64_t)(a_src.len)) < v_src_ri) {
-      return wuffs_base__make_status(
-          wuffs_gif__error__internal_error_inconsistent_ri_wi);
-    }
-    v_n = ((uint64_t)(
-        (self->private_impl.f_frame_rect_x1 - self->private_impl.f_dst_x)));
-    v_n = wuffs_base__u64__min(v_n, (((uint64_t)(a_src.len)) - v_src_ri));
-    wuffs_base__u64__sat_add_indirect(&v_src_ri, v_n);
-    wuffs_base__u32__sat_add_indirect(&self->private_impl.f_dst_x,
-                                      ((uint32_t)((v_n & 4294967295))));
-    if (self->private_impl.f_frame_rect_x1 <= self->private_impl.f_dst_x) {
-      self->private_impl.f_dst_x = self->private_impl.f_frame_rect_x0;
-      wuffs_base__u32__sat_add_indirect(
-          &self->private_impl.f_dst_y,
-          ((uint32_t)(
-              wuffs_gif__interlace_delta[self->private_impl.f_interlace])));
-      while (
-          (self->private_impl.f_interlace > 0) &&
-          (self->private_impl.f_dst_y >= self->private_impl.f_frame_rect_y1)) {
-#if defined(__GNUC__)
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wconversion"
-#endif
-        self->private_impl.f_interlace -= 1;
-#if defined(__GNUC__)
-#pragma GCC diagnostic pop
-#endif
-        self->private_impl.f_dst_y = wuffs_base__u32__sat_add(
-            self->private_impl.f_frame_rect_y0,
-            wuffs_gif__interlace_start[self->private_impl.f_interlace]);
+      if (!self->private_impl.f_decode_concatenated_members) {
+        goto label__members__break;
       }
-      goto label__0__continue;
-    }
-    if (v_src_ri != ((uint64_t)(a_src.len))) {
-      return wuffs_base__make_status(
-          wuffs_gif__error__internal_error_inconsistent_ri_wi);
+      while (((uint64_t)(io2_a_src - iop_a_src)) <= 0) {
+        if (a_src && a_src->meta.closed) {
+          goto label__members__break;
+        }
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(24);
+      }
+      wuffs_base__ignore_status(wuffs_crc32__ieee_hasher__initialize(
+          &self->private_data.f_checksum, sizeof(wuffs_crc32__ieee_hasher),
+          WUFFS_VERSION, 0));
+      wuffs_deflate__decoder__reset(&self->private_data.f_flate);
     }
-    goto label__0__break;
-  }
-label__0__break:;
-  return wuffs_base__make_status(NULL);
-}
-
-#endif  // !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__GIF)
-
-#if !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__GZIP)
-
-// ---------------- Status Codes Implementations
-
-const char* wuffs_gzip__error__bad_checksum = "#gzip: bad checksum";
-const char* wuffs_gzip__error__bad_compression_method =
-    "#gzip: bad compression method";
-const char* wuffs_gzip__error__bad_encoding_flags = "#gzip: bad encoding flags";
-const char* wuffs_gzip__error__bad_header = "#gzip: bad header";
-
-// ---------------- Private Consts
-
-// ---------------- Private Initializer Prototypes
-
-// ---------------- Private Function Prototypes
-
-// ---------------- VTables
-
-const wuffs_base__io_transformer__func_ptrs
-    wuffs_gzip__decoder__func_ptrs_for__wuffs_base__io_transformer = {
-        (wuffs_base__status(*)(void*,
-                               wuffs_base__io_buffer*,
-                               wuffs_base__io_buffer*,
-                               wuffs_base__slice_u8))(
-            &wuffs_gzip__decoder__transform_io),
-        (wuffs_base__range_ii_u64(*)(const void*))(
-            &wuffs_gzip__decoder__workbuf_len),
-};
-
-// ---------------- Initializer Implementations
+  label__members__break:;
 
-wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT  //
-wuffs_gzip__decoder__initialize(wuffs_gzip__decoder* self,
-                                size_t sizeof_star_self,
-                                uint64_t wuffs_version,
-                                uint32_t initialize_flags) {
-  if (!self) {
-    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
-  }
-  if (sizeof(*self) != sizeof_star_self) {
-    return wuffs_base__make_status(wuffs_base__error__bad_sizeof_receiver);
-  }
-  if (((wuffs_version >> 32) != WUFFS_VERSION_MAJOR) ||
-      (((wuffs_version >> 16) & 0xFFFF) > WUFFS_VERSION_MINOR)) {
-    return wuffs_base__make_status(wuffs_base__error__bad_wuffs_version);
+    goto ok;
+  ok:
+    self->private_impl.p_transform_io[0] = 0;
+    goto exit;
   }
 
-  if ((initialize_flags & WUFFS_INITIALIZE__ALREADY_ZEROED) != 0) {
-// The whole point of this if-check is to detect an uninitialized *self.
-// We disable the warning on GCC. Clang-5.0 does not have this warning.
-#if !defined(__clang__) && defined(__GNUC__)
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
-#endif
-    if (self->private_impl.magic != 0) {
-      return wuffs_base__make_status(
-          wuffs_base__error__initialize_falsely_claimed_already_zeroed);
-    }
-#if !defined(__clang__) && defined(__GNUC__)
-#pragma GCC diagnostic pop
-#endif
-  } else {
-    if ((initialize_flags &
-         WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED) == 0) {
-      memset(self, 0, sizeof(*self));
-      initialize_flags |= WUFFS_INITIALIZE__ALREADY_ZEROED;
-    } else {
-      memset(&(self->private_impl), 0, sizeof(self->private_impl));
-    }
-  }
+  goto suspend;
+suspend:
+  self->private_impl.p_transform_io[0] =
+      wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_impl.active_coroutine =
+      wuffs_base__status__is_suspension(&status) ? 1 : 0;
+  self->private_data.s_transform_io[0].v_flags = v_flags;
+  self->private_data.s_transform_io[0].v_xlen = v_xlen;
+  self->private_data.s_transform_io[0].v_si = v_si;
+  self->private_data.s_transform_io[0].v_checksum_got = v_checksum_got;
+  self->private_data.s_transform_io[0].v_decoded_length_got =
+      v_decoded_length_got;
+  self->private_data.s_transform_io[0].v_checksum_want = v_checksum_want;
 
-  {
-    wuffs_base__status z = wuffs_crc32__ieee_hasher__initialize(
-        &self->private_data.f_checksum, sizeof(self->private_data.f_checksum),
-        WUFFS_VERSION, initialize_flags);
-    if (z.repr) {
-      return z;
-    }
+  goto exit;
+exit:
+  if (a_dst) {
+    a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
   }
-  {
-    wuffs_base__status z = wuffs_deflate__decoder__initialize(
-        &self->private_data.f_flate, sizeof(self->private_data.f_flate),
-        WUFFS_VERSION, initialize_flags);
-    if (z.repr) {
-      return z;
-    }
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
   }
-  self->private_impl.magic = WUFFS_BASE__MAGIC;
-  self->private_impl.vtable_for__wuffs_base__io_transformer.vtable_name =
-      wuffs_base__io_transformer__vtable_name;
-  self->private_impl.vtable_for__wuffs_base__io_transformer.function_pointers =
-      (const void*)(&wuffs_gzip__decoder__func_ptrs_for__wuffs_base__io_transformer);
-  return wuffs_base__make_status(NULL);
-}
 
-size_t  //
-sizeof__wuffs_gzip__decoder() {
-  return sizeof(wuffs_gzip__decoder);
+  if (wuffs_base__status__is_error(&status)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+  }
+  return status;
 }
 
-// ---------------- Function Implementations
-
-// -------- func gzip.decoder.set_ignore_checksum
+// -------- func gzip.encoder.set_level
 
 WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
-wuffs_gzip__decoder__set_ignore_checksum(wuffs_gzip__decoder* self, bool a_ic) {
+wuffs_gzip__encoder__set_level(wuffs_gzip__encoder* self, uint32_t a_l) {
   if (!self) {
     return wuffs_base__make_empty_struct();
   }
@@ -19851,14 +27616,19 @@ wuffs_gzip__decoder__set_ignore_checksum(wuffs_gzip__decoder* self, bool a_ic) {
     return wuffs_base__make_empty_struct();
   }
 
-  self->private_impl.f_ignore_checksum = a_ic;
+  if (a_l >= 9) {
+    self->private_impl.f_level_plus_1 = 10;
+  } else {
+    self->private_impl.f_level_plus_1 = (a_l + 1);
+  }
+  wuffs_deflate__encoder__set_level(&self->private_data.f_flate, a_l);
   return wuffs_base__make_empty_struct();
 }
 
-// -------- func gzip.decoder.workbuf_len
+// -------- func gzip.encoder.workbuf_len
 
 WUFFS_BASE__MAYBE_STATIC wuffs_base__range_ii_u64  //
-wuffs_gzip__decoder__workbuf_len(const wuffs_gzip__decoder* self) {
+wuffs_gzip__encoder__workbuf_len(const wuffs_gzip__encoder* self) {
   if (!self) {
     return wuffs_base__utility__empty_range_ii_u64();
   }
@@ -19867,13 +27637,13 @@ wuffs_gzip__decoder__workbuf_len(const wuffs_gzip__decoder* self) {
     return wuffs_base__utility__empty_range_ii_u64();
   }
 
-  return wuffs_base__utility__make_range_ii_u64(1, 1);
+  return wuffs_base__utility__make_range_ii_u64(0, 0);
 }
 
-// -------- func gzip.decoder.transform_io
+// -------- func gzip.encoder.transform_io
 
 WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
-wuffs_gzip__decoder__transform_io(wuffs_gzip__decoder* self,
+wuffs_gzip__encoder__transform_io(wuffs_gzip__encoder* self,
                                   wuffs_base__io_buffer* a_dst,
                                   wuffs_base__io_buffer* a_src,
                                   wuffs_base__slice_u8 a_workbuf) {
@@ -19899,15 +27669,13 @@ wuffs_gzip__decoder__transform_io(wuffs_gzip__decoder* self,
   self->private_impl.active_coroutine = 0;
   wuffs_base__status status = wuffs_base__make_status(NULL);
 
-  uint8_t v_c = 0;
-  uint8_t v_flags = 0;
-  uint16_t v_xlen = 0;
+  uint8_t v_xfl = 0;
+  uint64_t v_x = 0;
+  uint32_t v_i = 0;
   uint64_t v_mark = 0;
   uint32_t v_checksum_got = 0;
-  uint32_t v_decoded_length_got = 0;
+  uint32_t v_decoded_length = 0;
   wuffs_base__status v_status = wuffs_base__make_status(NULL);
-  uint32_t v_checksum_want = 0;
-  uint32_t v_decoded_length_want = 0;
 
   uint8_t* iop_a_dst = NULL;
   uint8_t* io0_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
@@ -19935,173 +27703,53 @@ wuffs_gzip__decoder__transform_io(wuffs_gzip__decoder* self,
 
   uint32_t coro_susp_point = self->private_impl.p_transform_io[0];
   if (coro_susp_point) {
-    v_flags = self->private_data.s_transform_io[0].v_flags;
+    v_xfl = self->private_data.s_transform_io[0].v_xfl;
+    v_x = self->private_data.s_transform_io[0].v_x;
+    v_i = self->private_data.s_transform_io[0].v_i;
     v_checksum_got = self->private_data.s_transform_io[0].v_checksum_got;
-    v_decoded_length_got =
-        self->private_data.s_transform_io[0].v_decoded_length_got;
-    v_checksum_want = self->private_data.s_transform_io[0].v_checksum_want;
+    v_decoded_length = self->private_data.s_transform_io[0].v_decoded_length;
   }
   switch (coro_susp_point) {
     WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
 
-    {
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
-      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-        goto suspend;
-      }
-      uint8_t t_0 = *iop_a_src++;
-      v_c = t_0;
-    }
-    if (v_c != 31) {
-      status = wuffs_base__make_status(wuffs_gzip__error__bad_header);
-      goto exit;
-    }
-    {
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
-      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-        goto suspend;
-      }
-      uint8_t t_1 = *iop_a_src++;
-      v_c = t_1;
-    }
-    if (v_c != 139) {
-      status = wuffs_base__make_status(wuffs_gzip__error__bad_header);
-      goto exit;
-    }
-    {
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
-      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-        goto suspend;
-      }
-      uint8_t t_2 = *iop_a_src++;
-      v_c = t_2;
-    }
-    if (v_c != 8) {
-      status =
-          wuffs_base__make_status(wuffs_gzip__error__bad_compression_method);
-      goto exit;
+    if (self->private_impl.f_level_plus_1 == 10) {
+      v_xfl = 2;
+    } else if (self->private_impl.f_level_plus_1 == 2) {
+      v_xfl = 4;
     }
-    {
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
-      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+    v_x = 559903;
+    v_i = 0;
+    while (v_i < 8) {
+      self->private_data.s_transform_io[0].scratch = ((uint8_t)((v_x & 255)));
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+      if (iop_a_dst == io2_a_dst) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_write);
         goto suspend;
       }
-      uint8_t t_3 = *iop_a_src++;
-      v_flags = t_3;
+      *iop_a_dst++ = ((uint8_t)(self->private_data.s_transform_io[0].scratch));
+      v_x >>= 8;
+      v_i += 1;
     }
-    self->private_data.s_transform_io[0].scratch = 6;
-    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(5);
-    if (self->private_data.s_transform_io[0].scratch >
-        ((uint64_t)(io2_a_src - iop_a_src))) {
-      self->private_data.s_transform_io[0].scratch -=
-          ((uint64_t)(io2_a_src - iop_a_src));
-      iop_a_src = io2_a_src;
-      status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+    self->private_data.s_transform_io[0].scratch = v_xfl;
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+    if (iop_a_dst == io2_a_dst) {
+      status = wuffs_base__make_status(wuffs_base__suspension__short_write);
       goto suspend;
     }
-    iop_a_src += self->private_data.s_transform_io[0].scratch;
-    if ((v_flags & 4) != 0) {
-      {
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(6);
-        uint16_t t_4;
-        if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
-          t_4 = wuffs_base__load_u16le__no_bounds_check(iop_a_src);
-          iop_a_src += 2;
-        } else {
-          self->private_data.s_transform_io[0].scratch = 0;
-          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(7);
-          while (true) {
-            if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-              status =
-                  wuffs_base__make_status(wuffs_base__suspension__short_read);
-              goto suspend;
-            }
-            uint64_t* scratch = &self->private_data.s_transform_io[0].scratch;
-            uint32_t num_bits_4 = ((uint32_t)(*scratch >> 56));
-            *scratch <<= 8;
-            *scratch >>= 8;
-            *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_4;
-            if (num_bits_4 == 8) {
-              t_4 = ((uint16_t)(*scratch));
-              break;
-            }
-            num_bits_4 += 8;
-            *scratch |= ((uint64_t)(num_bits_4)) << 56;
-          }
-        }
-        v_xlen = t_4;
-      }
-      self->private_data.s_transform_io[0].scratch = ((uint32_t)(v_xlen));
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(8);
-      if (self->private_data.s_transform_io[0].scratch >
-          ((uint64_t)(io2_a_src - iop_a_src))) {
-        self->private_data.s_transform_io[0].scratch -=
-            ((uint64_t)(io2_a_src - iop_a_src));
-        iop_a_src = io2_a_src;
-        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-        goto suspend;
-      }
-      iop_a_src += self->private_data.s_transform_io[0].scratch;
-    }
-    if ((v_flags & 8) != 0) {
-      while (true) {
-        {
-          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(9);
-          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-            status =
-                wuffs_base__make_status(wuffs_base__suspension__short_read);
-            goto suspend;
-          }
-          uint8_t t_5 = *iop_a_src++;
-          v_c = t_5;
-        }
-        if (v_c == 0) {
-          goto label__0__break;
-        }
-      }
-    label__0__break:;
-    }
-    if ((v_flags & 16) != 0) {
-      while (true) {
-        {
-          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(10);
-          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-            status =
-                wuffs_base__make_status(wuffs_base__suspension__short_read);
-            goto suspend;
-          }
-          uint8_t t_6 = *iop_a_src++;
-          v_c = t_6;
-        }
-        if (v_c == 0) {
-          goto label__1__break;
-        }
-      }
-    label__1__break:;
-    }
-    if ((v_flags & 2) != 0) {
-      self->private_data.s_transform_io[0].scratch = 2;
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(11);
-      if (self->private_data.s_transform_io[0].scratch >
-          ((uint64_t)(io2_a_src - iop_a_src))) {
-        self->private_data.s_transform_io[0].scratch -=
-            ((uint64_t)(io2_a_src - iop_a_src));
-        iop_a_src = io2_a_src;
-        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-        goto suspend;
-      }
-      iop_a_src += self->private_data.s_transform_io[0].scratch;
-    }
-    if ((v_flags & 224) != 0) {
-      status = wuffs_base__make_status(wuffs_gzip__error__bad_encoding_flags);
-      goto exit;
+    *iop_a_dst++ = ((uint8_t)(self->private_data.s_transform_io[0].scratch));
+    self->private_data.s_transform_io[0].scratch = 255;
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+    if (iop_a_dst == io2_a_dst) {
+      status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+      goto suspend;
     }
+    *iop_a_dst++ = ((uint8_t)(self->private_data.s_transform_io[0].scratch));
+    wuffs_base__ignore_status(wuffs_crc32__ieee_hasher__initialize(
+        &self->private_data.f_checksum, sizeof(wuffs_crc32__ieee_hasher),
+        WUFFS_VERSION, 0));
+    v_decoded_length = 0;
     while (true) {
-      v_mark = ((uint64_t)(iop_a_dst - io0_a_dst));
+      v_mark = ((uint64_t)(iop_a_src - io0_a_src));
       {
         if (a_dst) {
           a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
@@ -20109,7 +27757,7 @@ wuffs_gzip__decoder__transform_io(wuffs_gzip__decoder* self,
         if (a_src) {
           a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
         }
-        wuffs_base__status t_7 = wuffs_deflate__decoder__transform_io(
+        wuffs_base__status t_0 = wuffs_deflate__encoder__transform_io(
             &self->private_data.f_flate, a_dst, a_src, a_workbuf);
         if (a_dst) {
           iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
@@ -20117,90 +27765,36 @@ wuffs_gzip__decoder__transform_io(wuffs_gzip__decoder* self,
         if (a_src) {
           iop_a_src = a_src->data.ptr + a_src->meta.ri;
         }
-        v_status = t_7;
-      }
-      if (!self->private_impl.f_ignore_checksum) {
-        v_checksum_got = wuffs_crc32__ieee_hasher__update_u32(
-            &self->private_data.f_checksum,
-            wuffs_base__io__since(v_mark, ((uint64_t)(iop_a_dst - io0_a_dst)),
-                                  io0_a_dst));
-        v_decoded_length_got +=
-            ((uint32_t)((wuffs_base__io__count_since(
-                             v_mark, ((uint64_t)(iop_a_dst - io0_a_dst))) &
-                         4294967295)));
+        v_status = t_0;
       }
+      v_checksum_got = wuffs_crc32__ieee_hasher__update_u32(
+          &self->private_data.f_checksum,
+          wuffs_base__io__since(v_mark, ((uint64_t)(iop_a_src - io0_a_src)),
+                                io0_a_src));
+      v_decoded_length +=
+          ((uint32_t)((wuffs_base__io__count_since(
+                           v_mark, ((uint64_t)(iop_a_src - io0_a_src))) &
+                       4294967295)));
       if (wuffs_base__status__is_ok(&v_status)) {
-        goto label__2__break;
+        goto label__0__break;
       }
       status = v_status;
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(12);
-    }
-  label__2__break:;
-    {
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(13);
-      uint32_t t_8;
-      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 4)) {
-        t_8 = wuffs_base__load_u32le__no_bounds_check(iop_a_src);
-        iop_a_src += 4;
-      } else {
-        self->private_data.s_transform_io[0].scratch = 0;
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(14);
-        while (true) {
-          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-            status =
-                wuffs_base__make_status(wuffs_base__suspension__short_read);
-            goto suspend;
-          }
-          uint64_t* scratch = &self->private_data.s_transform_io[0].scratch;
-          uint32_t num_bits_8 = ((uint32_t)(*scratch >> 56));
-          *scratch <<= 8;
-          *scratch >>= 8;
-          *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_8;
-          if (num_bits_8 == 24) {
-            t_8 = ((uint32_t)(*scratch));
-            break;
-          }
-          num_bits_8 += 8;
-          *scratch |= ((uint64_t)(num_bits_8)) << 56;
-        }
-      }
-      v_checksum_want = t_8;
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(4);
     }
-    {
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(15);
-      uint32_t t_9;
-      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 4)) {
-        t_9 = wuffs_base__load_u32le__no_bounds_check(iop_a_src);
-        iop_a_src += 4;
-      } else {
-        self->private_data.s_transform_io[0].scratch = 0;
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(16);
-        while (true) {
-          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-            status =
-                wuffs_base__make_status(wuffs_base__suspension__short_read);
-            goto suspend;
-          }
-          uint64_t* scratch = &self->private_data.s_transform_io[0].scratch;
-          uint32_t num_bits_9 = ((uint32_t)(*scratch >> 56));
-          *scratch <<= 8;
-          *scratch >>= 8;
-          *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_9;
-          if (num_bits_9 == 24) {
-            t_9 = ((uint32_t)(*scratch));
-            break;
-          }
-          num_bits_9 += 8;
-          *scratch |= ((uint64_t)(num_bits_9)) << 56;
-        }
+  label__0__break:;
+    v_x =
+        (((uint64_t)(v_checksum_got)) | (((uint64_t)(v_decoded_length)) << 32));
+    v_i = 0;
+    while (v_i < 8) {
+      self->private_data.s_transform_io[0].scratch = ((uint8_t)((v_x & 255)));
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(5);
+      if (iop_a_dst == io2_a_dst) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+        goto suspend;
       }
-      v_decoded_length_want = t_9;
-    }
-    if (!self->private_impl.f_ignore_checksum &&
-        ((v_checksum_got != v_checksum_want) ||
-         (v_decoded_length_got != v_decoded_length_want))) {
-      status = wuffs_base__make_status(wuffs_gzip__error__bad_checksum);
-      goto exit;
+      *iop_a_dst++ = ((uint8_t)(self->private_data.s_transform_io[0].scratch));
+      v_x >>= 8;
+      v_i += 1;
     }
 
     goto ok;
@@ -20215,11 +27809,11 @@ suspend:
       wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
   self->private_impl.active_coroutine =
       wuffs_base__status__is_suspension(&status) ? 1 : 0;
-  self->private_data.s_transform_io[0].v_flags = v_flags;
+  self->private_data.s_transform_io[0].v_xfl = v_xfl;
+  self->private_data.s_transform_io[0].v_x = v_x;
+  self->private_data.s_transform_io[0].v_i = v_i;
   self->private_data.s_transform_io[0].v_checksum_got = v_checksum_got;
-  self->private_data.s_transform_io[0].v_decoded_length_got =
-      v_decoded_length_got;
-  self->private_data.s_transform_io[0].v_checksum_want = v_checksum_want;
+  self->private_data.s_transform_io[0].v_decoded_length = v_decoded_length;
 
   goto exit;
 exit:
@@ -21271,7 +28865,7 @@ wuffs_json__decoder__decode_tokens(wuffs_json__decoder* self,
                 }
                 v_multi_byte_utf8 =
                     wuffs_base__load_u32le__no_bounds_check(iop_a_src);
-                if ((v_multi_byte_utf8 & 3233857536) == 2155905024) {
+                if ((v_multi_byte_utf8 & 3233857536u) == 2155905024) {
                   v_multi_byte_utf8 = ((1835008 & (v_multi_byte_utf8 << 18)) |
                                        (258048 & (v_multi_byte_utf8 << 4)) |
                                        (4032 & (v_multi_byte_utf8 >> 10)) |
@@ -21528,7 +29122,7 @@ wuffs_json__decoder__decode_tokens(wuffs_json__decoder* self,
           v_stack_byte = (v_depth / 32);
           v_stack_bit = (v_depth & 31);
           self->private_data.f_stack[v_stack_byte] &=
-              (4294967295 ^ (((uint32_t)(1)) << v_stack_bit));
+              (4294967295u ^ (((uint32_t)(1)) << v_stack_bit));
           v_depth += 1;
           (iop_a_src += 1, wuffs_base__make_empty_struct());
           *iop_a_dst++ = wuffs_base__make_token(
@@ -23347,10 +30941,99 @@ const wuffs_base__io_transformer__func_ptrs
             &wuffs_zlib__decoder__workbuf_len),
 };
 
-// ---------------- Initializer Implementations
+const wuffs_base__io_transformer__func_ptrs
+    wuffs_zlib__encoder__func_ptrs_for__wuffs_base__io_transformer = {
+        (wuffs_base__status(*)(void*,
+                               wuffs_base__io_buffer*,
+                               wuffs_base__io_buffer*,
+                               wuffs_base__slice_u8))(
+            &wuffs_zlib__encoder__transform_io),
+        (wuffs_base__range_ii_u64(*)(const void*))(
+            &wuffs_zlib__encoder__workbuf_len),
+};
+
+// ---------------- Initializer Implementations
+
+wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT  //
+wuffs_zlib__decoder__initialize(wuffs_zlib__decoder* self,
+                                size_t sizeof_star_self,
+                                uint64_t wuffs_version,
+                                uint32_t initialize_flags) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (sizeof(*self) != sizeof_star_self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_sizeof_receiver);
+  }
+  if (((wuffs_version >> 32) != WUFFS_VERSION_MAJOR) ||
+      (((wuffs_version >> 16) & 0xFFFF) > WUFFS_VERSION_MINOR)) {
+    return wuffs_base__make_status(wuffs_base__error__bad_wuffs_version);
+  }
+
+  if ((initialize_flags & WUFFS_INITIALIZE__ALREADY_ZEROED) != 0) {
+// The whole point of this if-check is to detect an uninitialized *self.
+// We disable the warning on GCC. Clang-5.0 does not have this warning.
+#if !defined(__clang__) && defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+    if (self->private_impl.magic != 0) {
+      return wuffs_base__make_status(
+          wuffs_base__error__initialize_falsely_claimed_already_zeroed);
+    }
+#if !defined(__clang__) && defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+  } else {
+    if ((initialize_flags &
+         WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED) == 0) {
+      memset(self, 0, sizeof(*self));
+      initialize_flags |= WUFFS_INITIALIZE__ALREADY_ZEROED;
+    } else {
+      memset(&(self->private_impl), 0, sizeof(self->private_impl));
+    }
+  }
+
+  {
+    wuffs_base__status z = wuffs_adler32__hasher__initialize(
+        &self->private_data.f_checksum, sizeof(self->private_data.f_checksum),
+        WUFFS_VERSION, initialize_flags);
+    if (z.repr) {
+      return z;
+    }
+  }
+  {
+    wuffs_base__status z = wuffs_adler32__hasher__initialize(
+        &self->private_data.f_dict_id_hasher,
+        sizeof(self->private_data.f_dict_id_hasher), WUFFS_VERSION,
+        initialize_flags);
+    if (z.repr) {
+      return z;
+    }
+  }
+  {
+    wuffs_base__status z = wuffs_deflate__decoder__initialize(
+        &self->private_data.f_flate, sizeof(self->private_data.f_flate),
+        WUFFS_VERSION, initialize_flags);
+    if (z.repr) {
+      return z;
+    }
+  }
+  self->private_impl.magic = WUFFS_BASE__MAGIC;
+  self->private_impl.vtable_for__wuffs_base__io_transformer.vtable_name =
+      wuffs_base__io_transformer__vtable_name;
+  self->private_impl.vtable_for__wuffs_base__io_transformer.function_pointers =
+      (const void*)(&wuffs_zlib__decoder__func_ptrs_for__wuffs_base__io_transformer);
+  return wuffs_base__make_status(NULL);
+}
+
+size_t  //
+sizeof__wuffs_zlib__decoder() {
+  return sizeof(wuffs_zlib__decoder);
+}
 
 wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT  //
-wuffs_zlib__decoder__initialize(wuffs_zlib__decoder* self,
+wuffs_zlib__encoder__initialize(wuffs_zlib__encoder* self,
                                 size_t sizeof_star_self,
                                 uint64_t wuffs_version,
                                 uint32_t initialize_flags) {
@@ -23398,16 +31081,7 @@ wuffs_zlib__decoder__initialize(wuffs_zlib__decoder* self,
     }
   }
   {
-    wuffs_base__status z = wuffs_adler32__hasher__initialize(
-        &self->private_data.f_dict_id_hasher,
-        sizeof(self->private_data.f_dict_id_hasher), WUFFS_VERSION,
-        initialize_flags);
-    if (z.repr) {
-      return z;
-    }
-  }
-  {
-    wuffs_base__status z = wuffs_deflate__decoder__initialize(
+    wuffs_base__status z = wuffs_deflate__encoder__initialize(
         &self->private_data.f_flate, sizeof(self->private_data.f_flate),
         WUFFS_VERSION, initialize_flags);
     if (z.repr) {
@@ -23418,17 +31092,50 @@ wuffs_zlib__decoder__initialize(wuffs_zlib__decoder* self,
   self->private_impl.vtable_for__wuffs_base__io_transformer.vtable_name =
       wuffs_base__io_transformer__vtable_name;
   self->private_impl.vtable_for__wuffs_base__io_transformer.function_pointers =
-      (const void*)(&wuffs_zlib__decoder__func_ptrs_for__wuffs_base__io_transformer);
+      (const void*)(&wuffs_zlib__encoder__func_ptrs_for__wuffs_base__io_transformer);
   return wuffs_base__make_status(NULL);
 }
 
 size_t  //
-sizeof__wuffs_zlib__decoder() {
-  return sizeof(wuffs_zlib__decoder);
+sizeof__wuffs_zlib__encoder() {
+  return sizeof(wuffs_zlib__encoder);
 }
 
 // ---------------- Function Implementations
 
+// -------- func zlib.decoder.reset
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_zlib__decoder__reset(wuffs_zlib__decoder* self) {
+  if (!self) {
+    return wuffs_base__make_empty_struct();
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return wuffs_base__make_empty_struct();
+  }
+
+  self->private_impl.magic = WUFFS_BASE__MAGIC;
+  self->private_impl.active_coroutine = 0;
+  memset(self->private_impl.p_transform_io, 0,
+         sizeof(self->private_impl.p_transform_io));
+
+  self->private_impl.f_bad_call_sequence = false;
+  self->private_impl.f_header_complete = false;
+  self->private_impl.f_got_dictionary = false;
+  self->private_impl.f_want_dictionary = false;
+  wuffs_base__ignore_status(wuffs_adler32__hasher__initialize(
+      &self->private_data.f_checksum, sizeof(wuffs_adler32__hasher),
+      WUFFS_VERSION, 0));
+  wuffs_base__ignore_status(wuffs_adler32__hasher__initialize(
+      &self->private_data.f_dict_id_hasher, sizeof(wuffs_adler32__hasher),
+      WUFFS_VERSION, 0));
+  self->private_impl.f_dict_id_got = 0;
+  self->private_impl.f_dict_id_want = 0;
+  wuffs_deflate__decoder__reset(&self->private_data.f_flate);
+  return wuffs_base__make_empty_struct();
+}
+
 // -------- func zlib.decoder.dictionary_id
 
 WUFFS_BASE__MAYBE_STATIC uint32_t  //
@@ -23446,25 +31153,35 @@ wuffs_zlib__decoder__dictionary_id(const wuffs_zlib__decoder* self) {
 
 // -------- func zlib.decoder.add_dictionary
 
-WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
 wuffs_zlib__decoder__add_dictionary(wuffs_zlib__decoder* self,
-                                    wuffs_base__slice_u8 a_dict) {
+                                    wuffs_base__slice_u8 a_dict,
+                                    wuffs_base__slice_u8 a_workbuf) {
   if (!self) {
-    return wuffs_base__make_empty_struct();
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
   }
   if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
-    return wuffs_base__make_empty_struct();
+    return wuffs_base__make_status(
+        (self->private_impl.magic == WUFFS_BASE__DISABLED)
+            ? wuffs_base__error__disabled_by_previous_error
+            : wuffs_base__error__initialize_not_called);
   }
 
+  wuffs_base__status v_status = wuffs_base__make_status(NULL);
+
   if (self->private_impl.f_header_complete) {
     self->private_impl.f_bad_call_sequence = true;
   } else {
+    v_status = wuffs_deflate__decoder__add_history(&self->private_data.f_flate,
+                                                   a_dict, a_workbuf);
+    if (wuffs_base__status__is_error(&v_status)) {
+      return v_status;
+    }
     self->private_impl.f_dict_id_got = wuffs_adler32__hasher__update_u32(
         &self->private_data.f_dict_id_hasher, a_dict);
-    wuffs_deflate__decoder__add_history(&self->private_data.f_flate, a_dict);
   }
   self->private_impl.f_got_dictionary = true;
-  return wuffs_base__make_empty_struct();
+  return wuffs_base__make_status(NULL);
 }
 
 // -------- func zlib.decoder.set_ignore_checksum
@@ -23482,6 +31199,53 @@ wuffs_zlib__decoder__set_ignore_checksum(wuffs_zlib__decoder* self, bool a_ic) {
   return wuffs_base__make_empty_struct();
 }
 
+// -------- func zlib.decoder.set_whole_output_in_dst
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_zlib__decoder__set_whole_output_in_dst(wuffs_zlib__decoder* self,
+                                             bool a_w) {
+  if (!self) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_empty_struct();
+  }
+
+  wuffs_deflate__decoder__set_whole_output_in_dst(&self->private_data.f_flate,
+                                                  a_w);
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func zlib.decoder.set_collect_stats
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_zlib__decoder__set_collect_stats(wuffs_zlib__decoder* self, bool a_c) {
+  if (!self) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_empty_struct();
+  }
+
+  wuffs_deflate__decoder__set_collect_stats(&self->private_data.f_flate, a_c);
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func zlib.decoder.stats
+
+WUFFS_BASE__MAYBE_STATIC uint64_t  //
+wuffs_zlib__decoder__stats(const wuffs_zlib__decoder* self, uint32_t a_key) {
+  if (!self) {
+    return 0;
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return 0;
+  }
+
+  return wuffs_deflate__decoder__stats(&self->private_data.f_flate, a_key);
+}
+
 // -------- func zlib.decoder.workbuf_len
 
 WUFFS_BASE__MAYBE_STATIC wuffs_base__range_ii_u64  //
@@ -23494,7 +31258,7 @@ wuffs_zlib__decoder__workbuf_len(const wuffs_zlib__decoder* self) {
     return wuffs_base__utility__empty_range_ii_u64();
   }
 
-  return wuffs_base__utility__make_range_ii_u64(1, 1);
+  return wuffs_base__utility__make_range_ii_u64(33025, 33025);
 }
 
 // -------- func zlib.decoder.transform_io
@@ -23759,6 +31523,211 @@ exit:
   return status;
 }
 
+// -------- func zlib.encoder.set_level
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_zlib__encoder__set_level(wuffs_zlib__encoder* self, uint32_t a_l) {
+  if (!self) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_empty_struct();
+  }
+
+  if (a_l >= 9) {
+    self->private_impl.f_level_plus_1 = 10;
+  } else {
+    self->private_impl.f_level_plus_1 = (a_l + 1);
+  }
+  wuffs_deflate__encoder__set_level(&self->private_data.f_flate, a_l);
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func zlib.encoder.workbuf_len
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__range_ii_u64  //
+wuffs_zlib__encoder__workbuf_len(const wuffs_zlib__encoder* self) {
+  if (!self) {
+    return wuffs_base__utility__empty_range_ii_u64();
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return wuffs_base__utility__empty_range_ii_u64();
+  }
+
+  return wuffs_base__utility__make_range_ii_u64(0, 0);
+}
+
+// -------- func zlib.encoder.transform_io
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_zlib__encoder__transform_io(wuffs_zlib__encoder* self,
+                                  wuffs_base__io_buffer* a_dst,
+                                  wuffs_base__io_buffer* a_src,
+                                  wuffs_base__slice_u8 a_workbuf) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_status(
+        (self->private_impl.magic == WUFFS_BASE__DISABLED)
+            ? wuffs_base__error__disabled_by_previous_error
+            : wuffs_base__error__initialize_not_called);
+  }
+  if (!a_dst || !a_src) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+  }
+  if ((self->private_impl.active_coroutine != 0) &&
+      (self->private_impl.active_coroutine != 1)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(
+        wuffs_base__error__interleaved_coroutine_calls);
+  }
+  self->private_impl.active_coroutine = 0;
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint16_t v_x = 0;
+  uint32_t v_i = 0;
+  uint32_t v_checksum_got = 0;
+  wuffs_base__status v_status = wuffs_base__make_status(NULL);
+  uint64_t v_mark = 0;
+
+  uint8_t* iop_a_dst = NULL;
+  uint8_t* io0_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_dst) {
+    io0_a_dst = a_dst->data.ptr;
+    io1_a_dst = io0_a_dst + a_dst->meta.wi;
+    iop_a_dst = io1_a_dst;
+    io2_a_dst = io0_a_dst + a_dst->data.len;
+    if (a_dst->meta.closed) {
+      io2_a_dst = iop_a_dst;
+    }
+  }
+  uint8_t* iop_a_src = NULL;
+  uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_transform_io[0];
+  if (coro_susp_point) {
+    v_x = self->private_data.s_transform_io[0].v_x;
+    v_i = self->private_data.s_transform_io[0].v_i;
+    v_checksum_got = self->private_data.s_transform_io[0].v_checksum_got;
+  }
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    v_x = 30721;
+    if (self->private_impl.f_level_plus_1 == 0) {
+      v_x = 30876;
+    } else if (self->private_impl.f_level_plus_1 >= 8) {
+      v_x = 30938;
+    } else if (self->private_impl.f_level_plus_1 == 7) {
+      v_x = 30876;
+    } else if (self->private_impl.f_level_plus_1 >= 3) {
+      v_x = 30814;
+    }
+    self->private_data.s_transform_io[0].scratch = ((uint8_t)((v_x >> 8)));
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+    if (iop_a_dst == io2_a_dst) {
+      status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+      goto suspend;
+    }
+    *iop_a_dst++ = ((uint8_t)(self->private_data.s_transform_io[0].scratch));
+    self->private_data.s_transform_io[0].scratch = ((uint8_t)((v_x & 255)));
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+    if (iop_a_dst == io2_a_dst) {
+      status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+      goto suspend;
+    }
+    *iop_a_dst++ = ((uint8_t)(self->private_data.s_transform_io[0].scratch));
+    wuffs_base__ignore_status(wuffs_adler32__hasher__initialize(
+        &self->private_data.f_checksum, sizeof(wuffs_adler32__hasher),
+        WUFFS_VERSION, 0));
+    while (true) {
+      v_mark = ((uint64_t)(iop_a_src - io0_a_src));
+      {
+        if (a_dst) {
+          a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+        }
+        if (a_src) {
+          a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+        }
+        wuffs_base__status t_0 = wuffs_deflate__encoder__transform_io(
+            &self->private_data.f_flate, a_dst, a_src, a_workbuf);
+        if (a_dst) {
+          iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+        }
+        if (a_src) {
+          iop_a_src = a_src->data.ptr + a_src->meta.ri;
+        }
+        v_status = t_0;
+      }
+      v_checksum_got = wuffs_adler32__hasher__update_u32(
+          &self->private_data.f_checksum,
+          wuffs_base__io__since(v_mark, ((uint64_t)(iop_a_src - io0_a_src)),
+                                io0_a_src));
+      if (wuffs_base__status__is_ok(&v_status)) {
+        goto label__0__break;
+      }
+      status = v_status;
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(3);
+    }
+  label__0__break:;
+    v_i = 0;
+    while (v_i < 4) {
+      self->private_data.s_transform_io[0].scratch =
+          ((uint8_t)((v_checksum_got >> 24)));
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+      if (iop_a_dst == io2_a_dst) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+        goto suspend;
+      }
+      *iop_a_dst++ = ((uint8_t)(self->private_data.s_transform_io[0].scratch));
+      v_checksum_got <<= 8;
+      v_i += 1;
+    }
+
+    goto ok;
+  ok:
+    self->private_impl.p_transform_io[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+suspend:
+  self->private_impl.p_transform_io[0] =
+      wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_impl.active_coroutine =
+      wuffs_base__status__is_suspension(&status) ? 1 : 0;
+  self->private_data.s_transform_io[0].v_x = v_x;
+  self->private_data.s_transform_io[0].v_i = v_i;
+  self->private_data.s_transform_io[0].v_checksum_got = v_checksum_got;
+
+  goto exit;
+exit:
+  if (a_dst) {
+    a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+  }
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  if (wuffs_base__status__is_error(&status)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+  }
+  return status;
+}
+
 #endif  // !defined(WUFFS_CONFIG__MODULES) ||
         // defined(WUFFS_CONFIG__MODULE__ZLIB)
 
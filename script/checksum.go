@@ -17,7 +17,8 @@
 package main
 
 // checksum.go prints a checksum of stdin's bytes, or of the opening digits of
-// π. Checksum algorithms include "adler32" and "crc32/ieee".
+// π. Checksum algorithms include "adler32", "crc32/castagnoli" and
+// "crc32/ieee".
 //
 // Usage: go run checksum.go -algorithm=crc32/ieee < foo.bar
 
@@ -75,6 +76,8 @@ func do(r io.Reader) error {
 	switch *algorithm {
 	case "adler32":
 		h = adler32.New()
+	case "crc32/castagnoli":
+		h = crc32.New(crc32.MakeTable(crc32.Castagnoli))
 	case "crc32/ieee":
 		h = crc32.NewIEEE()
 	default:
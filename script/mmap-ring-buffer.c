@@ -32,6 +32,9 @@
 // reads or writes. Backwards reads are useful when decoding a Lempel-Ziv style
 // compression format, copying from history (recently decoded bytes).
 //
+// example/zcat uses this technique for its dst buffer, so that the DEFLATE
+// decoder can copy from history without a separate history ringbuffer.
+//
 // Its output should be:
 //
 // middle[-8]  ==  0x00  ==  0x00  ==  middle[131064]
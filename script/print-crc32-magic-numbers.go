@@ -34,8 +34,29 @@ func main() {
 }
 
 func main1() error {
+	printTables("ieee_table", crc32.IEEE)
+	printTables("castagnoli_table", crc32.Castagnoli)
+
+	// x2n[n] is x**(2**n) modulo the CRC polynomial, in the same reflected bit
+	// order as the tables above: the high bit represents x**0.
+	fmt.Println("// ieee_x2n_table")
+	x2n := [32]uint32{}
+	x2n[0] = 1 << 30 // x**1.
+	for n := 1; n < 32; n++ {
+		x2n[n] = multiplyModPoly(x2n[n-1], x2n[n-1])
+	}
+	for j, x := range x2n {
+		fmt.Printf("0x%08X,", x)
+		if j&7 == 7 {
+			fmt.Println()
+		}
+	}
+	return nil
+}
+
+func printTables(name string, poly uint32) {
 	tables := [16]crc32.Table{}
-	tables[0] = *crc32.MakeTable(crc32.IEEE)
+	tables[0] = *crc32.MakeTable(poly)
 
 	// See "Multi-Byte Lookup Tables" in std/crc32/README.md for more detail on
 	// the slicing-by-M algorithm. We use an M of 16.
@@ -47,6 +68,7 @@ func main1() error {
 		}
 	}
 
+	fmt.Printf("// %s\n", name)
 	for i, t := range tables {
 		if i != 0 {
 			fmt.Println("],[")
@@ -58,5 +80,18 @@ func main1() error {
 			}
 		}
 	}
-	return nil
+}
+
+func multiplyModPoly(a uint32, b uint32) (p uint32) {
+	for m := uint32(1 << 31); m != 0; m >>= 1 {
+		if a&m != 0 {
+			p ^= b
+		}
+		if b&1 != 0 {
+			b = (b >> 1) ^ crc32.IEEE
+		} else {
+			b >>= 1
+		}
+	}
+	return p
 }
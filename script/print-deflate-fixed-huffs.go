@@ -0,0 +1,160 @@
+// Copyright 2020 The Wuffs Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// +build ignore
+
+package main
+
+// print-deflate-fixed-huffs.go prints the std/deflate fixed_lcode_huffs and
+// fixed_dcode_huffs values: the decoder.huffs tables for the fixed Huffman
+// codes given in RFC 1951 section 3.2.6.
+//
+// Every fixed code is at most 9 bits long, so these tables never need a
+// second (redirected) lookup, for any huffs_primary_bits of 9 or more. The
+// lcode table has 1<<9 entries and the dcode table has 1<<5 entries.
+//
+// Usage: go run print-deflate-fixed-huffs.go
+
+import (
+	"fmt"
+	"os"
+)
+
+func main() {
+	if err := main1(); err != nil {
+		os.Stderr.WriteString(err.Error() + "\n")
+		os.Exit(1)
+	}
+}
+
+func main1() error {
+	lcodeLengths := make([]uint32, 288)
+	for i := range lcodeLengths {
+		switch {
+		case i < 144:
+			lcodeLengths[i] = 8
+		case i < 256:
+			lcodeLengths[i] = 9
+		case i < 280:
+			lcodeLengths[i] = 7
+		default:
+			lcodeLengths[i] = 8
+		}
+	}
+	dcodeLengths := make([]uint32, 32)
+	for i := range dcodeLengths {
+		dcodeLengths[i] = 5
+	}
+
+	printTable(build(lcodeLengths, 9, lcodeValue))
+	fmt.Println()
+	printTable(build(dcodeLengths, 5, dcodeValue))
+	return nil
+}
+
+func printTable(table []uint32) {
+	for i, x := range table {
+		fmt.Printf("0x%04X_%04X,", x>>16, x&0xFFFF)
+		if i&7 == 7 {
+			fmt.Println()
+		} else {
+			fmt.Print(" ")
+		}
+	}
+}
+
+// build returns a table, indexed by the low nBits of the (LSB-first) input
+// bits, as per the canonical Huffman code construction in RFC 1951 section
+// 3.2.2.
+func build(codeLengths []uint32, nBits uint32, value func(symbol uint32) uint32) []uint32 {
+	counts := [16]uint32{}
+	for _, cl := range codeLengths {
+		counts[cl]++
+	}
+	nextCode := [16]uint32{}
+	code := uint32(0)
+	for cl := 1; cl < 16; cl++ {
+		code = (code + counts[cl-1]) << 1
+		nextCode[cl] = code
+	}
+
+	table := make([]uint32, 1<<nBits)
+	for symbol, cl := range codeLengths {
+		c := nextCode[cl]
+		nextCode[cl]++
+		// Huffman codes are packed MSB-first, but read LSB-first.
+		key := reverse(c, cl)
+		for k := key; k < uint32(len(table)); k += 1 << cl {
+			table[k] = value(uint32(symbol)) | cl
+		}
+	}
+	return table
+}
+
+func reverse(x uint32, n uint32) (y uint32) {
+	for i := uint32(0); i < n; i++ {
+		y = (y << 1) | ((x >> i) & 1)
+	}
+	return y
+}
+
+func lcodeValue(symbol uint32) uint32 {
+	if symbol < 256 {
+		return 0x80000000 | (symbol << 8)
+	} else if symbol == 256 {
+		return 0x20000000
+	}
+	return magicNumber(0, symbol-257)
+}
+
+func dcodeValue(symbol uint32) uint32 {
+	return magicNumber(1, symbol)
+}
+
+// magicNumber matches script/print-deflate-magic-numbers.go.
+func magicNumber(i int, j uint32) uint32 {
+	biases := [2]uint32{3, 1}
+	if (j >= 32) || (baseNumbers[i][j] == bad) {
+		return 0x08000000
+	}
+	return 0x40000000 | ((baseNumbers[i][j] - biases[i]) << 8) | (extraBits[i][j] << 4)
+}
+
+const bad = 0xFFFFFFFF
+
+var (
+	baseNumbers = [2][32]uint32{{
+		3, 4, 5, 6, 7, 8, 9, 10,
+		11, 13, 15, 17, 19, 23, 27, 31,
+		35, 43, 51, 59, 67, 83, 99, 115,
+		131, 163, 195, 227, 258, bad, bad, bad,
+	}, {
+		1, 2, 3, 4, 5, 7, 9, 13,
+		17, 25, 33, 49, 65, 97, 129, 193,
+		257, 385, 513, 769, 1025, 1537, 2049, 3073,
+		4097, 6145, 8193, 12289, 16385, 24577, bad, bad,
+	}}
+
+	extraBits = [2][32]uint32{{
+		0, 0, 0, 0, 0, 0, 0, 0,
+		1, 1, 1, 1, 2, 2, 2, 2,
+		3, 3, 3, 3, 4, 4, 4, 4,
+		5, 5, 5, 5, 0, bad, bad, bad,
+	}, {
+		0, 0, 0, 0, 1, 1, 2, 2,
+		3, 3, 4, 4, 5, 5, 6, 6,
+		7, 7, 8, 8, 9, 9, 10, 10,
+		11, 11, 12, 12, 13, 13, bad, bad,
+	}}
+)
@@ -43,8 +43,8 @@
 // be inside the wuffs_deflate__decoder__decode_blocks function body, and the
 // lines of code should look something like
 //
-// v_status =
-//     wuffs_deflate__decoder__decode_huffman_fast(self, a_dst, a_src);
+// v_status = wuffs_deflate__decoder__decode_huffman_fast(
+//     self, a_dst, a_src, a_workbuf);
 //
 // Change the "wuffs" to "c_wuffs", i.e. add a "c_" prefix. The net result
 // should look something like:
@@ -70,8 +70,9 @@ index c570e34..0d080d8 100644
              iop_a_src - a_src.private_impl.buf->data.ptr;
        }
        v_status =
--          wuffs_deflate__decoder__decode_huffman_fast(self, a_dst, a_src);
-+          c_wuffs_deflate__decoder__decode_huffman_fast(self, a_dst, a_src);
+-          v_status = wuffs_deflate__decoder__decode_huffman_fast(
++          v_status = c_wuffs_deflate__decoder__decode_huffman_fast(
+               self, a_dst, a_src, a_workbuf);
        if (a_src.private_impl.buf) {
          iop_a_src =
              a_src.private_impl.buf->data.ptr + a_src.private_impl.buf->meta.ri;
@@ -152,12 +153,13 @@ typedef struct wuffs_deflate__decoder__struct {
   struct {
     // 1024 is huffs_table_size in std/deflate/decode_deflate.wuffs.
     uint32_t f_huffs[2][1024];
-    uint8_t f_history[32768];
     uint8_t f_code_lengths[320];
   } private_data;
 } wuffs_deflate__decoder;
 
 const char* wuffs_base__error__bad_argument = "?base: bad argument";
+const char* wuffs_base__error__bad_workbuf_length =
+    "?base: bad workbuf length";
 const char* wuffs_deflate__error__bad_distance = "?deflate: bad distance";
 const char* wuffs_deflate__error__internal_error_inconsistent_distance =
     "?deflate: internal error: inconsistent distance";
@@ -168,7 +170,8 @@ const char*
 static wuffs_base__status  //
 wuffs_deflate__decoder__decode_huffman_fast(wuffs_deflate__decoder* self,
                                             wuffs_base__io_buffer* a_dst,
-                                            wuffs_base__io_buffer* a_src) {
+                                            wuffs_base__io_buffer* a_src,
+                                            wuffs_base__slice_u8 a_workbuf) {
   return wuffs_base__make_status(NULL);
 }
 
@@ -220,13 +223,15 @@ static const uint32_t wuffs_base__width_to_mask_table[33] = {
 static wuffs_base__status  //
 wuffs_deflate__decoder__decode_huffman_fast(wuffs_deflate__decoder* self,
                                             wuffs_base__io_buffer* a_dst,
-                                            wuffs_base__io_buffer* a_src);
+                                            wuffs_base__io_buffer* a_src,
+                                            wuffs_base__slice_u8 a_workbuf);
 
 // This is the overriding implementation.
 wuffs_base__status  //
 c_wuffs_deflate__decoder__decode_huffman_fast(wuffs_deflate__decoder* self,
                                               wuffs_base__io_buffer* a_dst,
-                                              wuffs_base__io_buffer* a_src) {
+                                              wuffs_base__io_buffer* a_src,
+                                              wuffs_base__slice_u8 a_workbuf) {
   // Avoid the -Werror=unused-function warning for the now-unused
   // overridden wuffs_deflate__decoder__decode_huffman_fast.
   (void)(wuffs_deflate__decoder__decode_huffman_fast);
@@ -236,6 +241,12 @@ c_wuffs_deflate__decoder__decode_huffman_fast(wuffs_deflate__decoder* self,
   }
   wuffs_base__status status = wuffs_base__make_status(NULL);
 
+  // The history ringbuffer lives in a_workbuf. See the add_history comment
+  // in std/deflate/decode_deflate.wuffs for its layout.
+  if (a_workbuf.len < WUFFS_DEFLATE__DECODER_WORKBUF_LEN_MAX_INCL_WORST_CASE) {
+    return wuffs_base__make_status(wuffs_base__error__bad_workbuf_length);
+  }
+
   // Load contextual state. Prepare to check that pdst and psrc remain within
   // a_dst's and a_src's bounds.
 
@@ -394,11 +405,11 @@ outer_loop:
       n_bits -= n;
     }
 
-    // Copy from the history buffer, if necessary.
+    // Copy from the history ringbuffer, if necessary.
     if ((ptrdiff_t)(dist_minus_1 + 1) > (pdst - pdst_mark)) {
-      // Set (hlen, hdist) to be the length-distance pair to copy from
-      // this.history, and (length, distance) to be the remaining
-      // length-distance pair to copy from args.dst.
+      // Set (hlen, hdist) to be the length-distance pair to copy from the
+      // history, and (length, distance) to be the remaining length-distance
+      // pair to copy from args.dst.
       uint32_t hlen = 0;
       uint32_t hdist = ((dist_minus_1 + 1) - (pdst - pdst_mark));
       if (length > hdist) {
@@ -413,20 +424,12 @@ outer_loop:
         goto end;
       }
 
-      // Copy up to the right edge of the f_history array.
+      // a_workbuf.ptr[0x8000 .. 0x8101] duplicates a_workbuf.ptr[.. 0x101],
+      // so there is no need to split the copy around the 0x8000 index.
       uint32_t history_index =
           (self->private_impl.f_history_index - hdist) & 0x7FFF;
-      uint32_t available = 0x8000 - history_index;
-      uint32_t n_copied = (hlen < available) ? hlen : available;
-      memmove(pdst, self->private_data.f_history + history_index, n_copied);
-      pdst += n_copied;
-
-      // Copy from the left edge of the f_history array.
-      if (hlen > n_copied) {
-        hlen -= n_copied;
-        memmove(pdst, self->private_data.f_history, hlen);
-        pdst += hlen;
-      }
+      memmove(pdst, a_workbuf.ptr + history_index, hlen);
+      pdst += hlen;
 
       if (length == 0) {
         goto outer_loop;
@@ -101,6 +101,33 @@ mimic_zlib_decode_with_dictionary(wuffs_base__io_buffer* dst,
   return "miniz does not implement zlib dictionaries";
 }
 
+const char*  //
+mimic_deflate_encode(wuffs_base__io_buffer* dst,
+                     wuffs_base__io_buffer* src,
+                     uint32_t level,
+                     uint64_t wlimit,
+                     uint64_t rlimit) {
+  return "miniz encoding is not implemented by this mimic library";
+}
+
+const char*  //
+mimic_gzip_encode(wuffs_base__io_buffer* dst,
+                  wuffs_base__io_buffer* src,
+                  uint32_t level,
+                  uint64_t wlimit,
+                  uint64_t rlimit) {
+  return "miniz does not implement gzip";
+}
+
+const char*  //
+mimic_zlib_encode(wuffs_base__io_buffer* dst,
+                  wuffs_base__io_buffer* src,
+                  uint32_t level,
+                  uint64_t wlimit,
+                  uint64_t rlimit) {
+  return "miniz encoding is not implemented by this mimic library";
+}
+
 #else  // WUFFS_MIMICLIB_USE_MINIZ_INSTEAD_OF_ZLIB
 #include "zlib.h"
 
@@ -299,4 +326,127 @@ mimic_zlib_decode_with_dictionary(wuffs_base__io_buffer* dst,
                                         UINT64_MAX, zlib_flavor_zlib);
 }
 
+const char*  //
+mimic_deflate_gzip_zlib_encode(wuffs_base__io_buffer* dst,
+                               wuffs_base__io_buffer* src,
+                               uint32_t level,
+                               uint64_t wlimit,
+                               uint64_t rlimit,
+                               zlib_flavor flavor) {
+  const char* ret = NULL;
+  if (dst->data.len > UINT_MAX) {
+    ret = "dst length is too large";
+    goto cleanup0;
+  }
+  if (src->data.len > UINT_MAX) {
+    ret = "src length is too large";
+    goto cleanup0;
+  }
+
+  // See deflateInit2 in the zlib manual, or in zlib.h, for details about how
+  // the window_bits int also encodes the wire format wrapper.
+  int window_bits = 0;
+  switch (flavor) {
+    case zlib_flavor_raw:
+      window_bits = -15;
+      break;
+    case zlib_flavor_gzip:
+      window_bits = +15 | 16;
+      break;
+    case zlib_flavor_zlib:
+      window_bits = +15;
+      break;
+    default:
+      ret = "invalid zlib_flavor";
+      goto cleanup0;
+  }
+  z_stream z = {0};
+  int di2_err = deflateInit2(&z, (level < 9) ? ((int)level) : 9, Z_DEFLATED,
+                             window_bits, 8, Z_DEFAULT_STRATEGY);
+  if (di2_err != Z_OK) {
+    ret = "deflateInit2 failed";
+    goto cleanup0;
+  }
+
+  while (true) {
+    z.next_in = src->data.ptr + src->meta.ri;
+    z.avail_in = src->meta.wi - src->meta.ri;
+    if (z.avail_in > rlimit) {
+      z.avail_in = rlimit;
+    }
+    uInt initial_avail_in = z.avail_in;
+    int flush = Z_NO_FLUSH;
+    if (src->meta.closed && ((src->meta.ri + z.avail_in) == src->meta.wi)) {
+      flush = Z_FINISH;
+    }
+
+    z.next_out = dst->data.ptr + dst->meta.wi;
+    z.avail_out = dst->data.len - dst->meta.wi;
+    if (z.avail_out > wlimit) {
+      z.avail_out = wlimit;
+    }
+    uInt initial_avail_out = z.avail_out;
+
+    int d_err = deflate(&z, flush);
+
+    if (initial_avail_in < z.avail_in) {
+      ret = "inconsistent avail_in";
+      goto cleanup1;
+    }
+    src->meta.ri += initial_avail_in - z.avail_in;
+
+    if (initial_avail_out < z.avail_out) {
+      ret = "inconsistent avail_out";
+      goto cleanup1;
+    }
+    dst->meta.wi += initial_avail_out - z.avail_out;
+
+    if (d_err == Z_STREAM_END) {
+      break;
+    } else if ((d_err != Z_OK) && (d_err != Z_BUF_ERROR)) {
+      ret = "deflate failed";
+      goto cleanup1;
+    }
+  }
+
+cleanup1:;
+  int de_err = deflateEnd(&z);
+  if ((de_err != Z_OK) && !ret) {
+    ret = "deflateEnd failed";
+  }
+
+cleanup0:;
+  return ret;
+}
+
+const char*  //
+mimic_deflate_encode(wuffs_base__io_buffer* dst,
+                     wuffs_base__io_buffer* src,
+                     uint32_t level,
+                     uint64_t wlimit,
+                     uint64_t rlimit) {
+  return mimic_deflate_gzip_zlib_encode(dst, src, level, wlimit, rlimit,
+                                        zlib_flavor_raw);
+}
+
+const char*  //
+mimic_gzip_encode(wuffs_base__io_buffer* dst,
+                  wuffs_base__io_buffer* src,
+                  uint32_t level,
+                  uint64_t wlimit,
+                  uint64_t rlimit) {
+  return mimic_deflate_gzip_zlib_encode(dst, src, level, wlimit, rlimit,
+                                        zlib_flavor_gzip);
+}
+
+const char*  //
+mimic_zlib_encode(wuffs_base__io_buffer* dst,
+                  wuffs_base__io_buffer* src,
+                  uint32_t level,
+                  uint64_t wlimit,
+                  uint64_t rlimit) {
+  return mimic_deflate_gzip_zlib_encode(dst, src, level, wlimit, rlimit,
+                                        zlib_flavor_zlib);
+}
+
 #endif  // WUFFS_MIMICLIB_USE_MINIZ_INSTEAD_OF_ZLIB
@@ -92,6 +92,67 @@ test_wuffs_adler32_interface() {
       "test/data/hat.lossy.webp", 0, SIZE_MAX, 0xF1BB258D);
 }
 
+const char*  //
+test_wuffs_adler32_combine() {
+  CHECK_FOCUS(__func__);
+
+  struct {
+    const char* filename;
+    // The want values are determined by script/checksum.go.
+    uint32_t want;
+  } test_cases[] = {
+      {
+          .filename = "test/data/hat.bmp",
+          .want = 0x3D26D034,
+      },
+      {
+          .filename = "test/data/hat.png",
+          .want = 0xDFC6C9C6,
+      },
+  };
+
+  int tc;
+  for (tc = 0; tc < WUFFS_TESTLIB_ARRAY_SIZE(test_cases); tc++) {
+    wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+        .data = global_src_slice,
+    });
+    CHECK_STRING(read_file(&src, test_cases[tc].filename));
+
+    // Split the file into two parts, A and B, at a variety of positions.
+    size_t n = src.meta.wi;
+    size_t splits[] = {0, 1, 15, 16, 17, 100, n / 3, n / 2, n - 64, n - 1, n};
+
+    int i;
+    for (i = 0; i < WUFFS_TESTLIB_ARRAY_SIZE(splits); i++) {
+      uint32_t checksums[2];
+      wuffs_base__slice_u8 parts[2];
+      parts[0] = wuffs_base__make_slice_u8(src.data.ptr, splits[i]);
+      parts[1] =
+          wuffs_base__make_slice_u8(src.data.ptr + splits[i], n - splits[i]);
+
+      int j;
+      for (j = 0; j < 2; j++) {
+        wuffs_adler32__hasher checksum;
+        CHECK_STATUS(
+            "initialize",
+            wuffs_adler32__hasher__initialize(
+                &checksum, sizeof checksum, WUFFS_VERSION,
+                WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+        checksums[j] = wuffs_adler32__hasher__update_u32(&checksum, parts[j]);
+      }
+
+      uint32_t have =
+          wuffs_adler32__combine(checksums[0], checksums[1], parts[1].len);
+      if (have != test_cases[tc].want) {
+        RETURN_FAIL("tc=%d, split=%zu: have 0x%08" PRIX32
+                    ", want 0x%08" PRIX32,
+                    tc, splits[i], have, test_cases[tc].want);
+      }
+    }
+  }
+  return NULL;
+}
+
 const char*  //
 test_wuffs_adler32_golden() {
   CHECK_FOCUS(__func__);
@@ -242,7 +303,7 @@ wuffs_bench_adler32(wuffs_base__io_buffer* dst,
   if (rlimit) {
     len = wuffs_base__u64__min(len, rlimit);
   }
-  wuffs_adler32__hasher checksum;
+  wuffs_adler32__hasher checksum = {0};
   CHECK_STATUS("initialize", wuffs_adler32__hasher__initialize(
                                  &checksum, sizeof checksum, WUFFS_VERSION,
                                  wuffs_initialize_flags));
@@ -255,6 +316,27 @@ wuffs_bench_adler32(wuffs_base__io_buffer* dst,
   return NULL;
 }
 
+// wuffs_bench_adler32_fallback is like wuffs_bench_adler32 but always uses
+// the portable (scalar) implementation, even if the CPU supports a SIMD
+// implementation.
+const char*  //
+wuffs_bench_adler32_fallback(wuffs_base__io_buffer* dst,
+                             wuffs_base__io_buffer* src,
+                             uint32_t wuffs_initialize_flags,
+                             uint64_t wlimit,
+                             uint64_t rlimit) {
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+  bool have_x86_sse42 = wuffs_base__cpu_arch__have_x86_sse42();
+  wuffs_base__cpu_arch__override_x86_sse42(false);
+  const char* status =
+      wuffs_bench_adler32(dst, src, wuffs_initialize_flags, wlimit, rlimit);
+  wuffs_base__cpu_arch__override_x86_sse42(have_x86_sse42);
+  return status;
+#else
+  return wuffs_bench_adler32(dst, src, wuffs_initialize_flags, wlimit, rlimit);
+#endif
+}
+
 const char*  //
 bench_wuffs_adler32_10k() {
   CHECK_FOCUS(__func__);
@@ -273,6 +355,24 @@ bench_wuffs_adler32_100k() {
       &adler32_pi_gt, UINT64_MAX, UINT64_MAX, 150);
 }
 
+const char*  //
+bench_wuffs_adler32_fallback_10k() {
+  CHECK_FOCUS(__func__);
+  return do_bench_io_buffers(
+      wuffs_bench_adler32_fallback,
+      WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED, tcounter_src,
+      &adler32_midsummer_gt, UINT64_MAX, UINT64_MAX, 1500);
+}
+
+const char*  //
+bench_wuffs_adler32_fallback_100k() {
+  CHECK_FOCUS(__func__);
+  return do_bench_io_buffers(
+      wuffs_bench_adler32_fallback,
+      WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED, tcounter_src,
+      &adler32_pi_gt, UINT64_MAX, UINT64_MAX, 150);
+}
+
   // ---------------- Mimic Benches
 
 #ifdef WUFFS_MIMIC
@@ -301,6 +401,7 @@ bench_mimic_adler32_100k() {
 
 proc tests[] = {
 
+    test_wuffs_adler32_combine,
     test_wuffs_adler32_golden,
     test_wuffs_adler32_interface,
     test_wuffs_adler32_pi,
@@ -312,6 +413,8 @@ proc benches[] = {
 
     bench_wuffs_adler32_10k,
     bench_wuffs_adler32_100k,
+    bench_wuffs_adler32_fallback_10k,
+    bench_wuffs_adler32_fallback_100k,
 
 #ifdef WUFFS_MIMIC
 
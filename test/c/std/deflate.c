@@ -80,6 +80,13 @@ golden_test deflate_256_bytes_gt = {
     .src_offset1 = 281,
 };
 
+golden_test deflate_australian_abc_gt = {
+    .want_filename = "test/data/australian-abc-local-stations.json",
+    .src_filename = "test/data/australian-abc-local-stations.json.gz",
+    .src_offset0 = 45,
+    .src_offset1 = 4308,
+};
+
 golden_test deflate_deflate_backref_crosses_blocks_gt = {
     .want_filename =
         "test/data/artificial/"
@@ -125,6 +132,15 @@ golden_test deflate_deflate_huffman_primlen_9_gt = {
         "deflate-huffman-primlen-9.deflate",
 };
 
+golden_test deflate_deflate_overlapping_copies_gt = {
+    .want_filename =
+        "test/data/artificial/"
+        "deflate-overlapping-copies.deflate.decompressed",
+    .src_filename =
+        "test/data/artificial/"
+        "deflate-overlapping-copies.deflate",
+};
+
 golden_test deflate_midsummer_gt = {
     .want_filename = "test/data/midsummer.txt",
     .src_filename = "test/data/midsummer.txt.gz",
@@ -151,6 +167,32 @@ golden_test deflate_romeo_fixed_gt = {
     .src_filename = "test/data/romeo.txt.fixed-huff.deflate",
 };
 
+// The deflate_encode_etc_gt golden tests have no want_filename, as there is
+// more than one valid DEFLATE encoding of any given src. They are used to
+// benchmark the encoders.
+
+golden_test deflate_encode_midsummer_gt = {
+    .src_filename = "test/data/midsummer.txt",
+};
+
+golden_test deflate_encode_pi_gt = {
+    .src_filename = "test/data/pi.txt",
+};
+
+// This is a short message, like those sent by an RPC (Remote Procedure Call)
+// system, DEFLATE-encoded as a dynamic Huffman block.
+const char* deflate_rpc_src_ptr =
+    "\x1d\xca\x3b\x0e\x80\x20\x10\x04\xd0\xde\x63\x4c\x4d\x0c\x18\x2d\xe4\x2a"
+    "\xc6\x62\x23\xab\x90\xf0\x31\x8a\x95\xf1\xee\xae\x4e\x37\xf3\xe6\x46\x70"
+    "\xb0\x46\xf7\x9d\x42\xe2\xea\x8b\x34\x5c\x27\x1f\xed\xc6\x15\x0a\x3b\x1d"
+    "\x94\x4e\xd8\x1b\x99\x12\x8b\x51\x0c\x0b\x0b\xac\x81\xa3\x13\x98\xc0\x89"
+    "\x42\xfc\xae\xbe\x64\xc6\xfc\x28\x54\xd9\xcd\x30\x76\xfa\x4f\xf3\x02";
+const size_t deflate_rpc_src_len = 89;
+const char* deflate_rpc_want_ptr =
+    "{\"id\":1042,\"method\":\"user.get\",\"params\":{\"name\":\"alice\","
+    "\"fields\":[\"email\",\"phone\"]},\"ts\":1592000000\n";
+const size_t deflate_rpc_want_len = 100;
+
 // ---------------- Deflate Tests
 
 const char*  //
@@ -204,6 +246,135 @@ test_wuffs_deflate_decode_256_bytes() {
                             UINT64_MAX, UINT64_MAX);
 }
 
+const char*  //
+test_wuffs_deflate_decode_australian_abc() {
+  CHECK_FOCUS(__func__);
+  return do_test_io_buffers(wuffs_deflate_decode, &deflate_australian_abc_gt,
+                            UINT64_MAX, UINT64_MAX);
+}
+
+const char*  //
+test_wuffs_deflate_decode_bad_workbuf_length() {
+  CHECK_FOCUS(__func__);
+
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = global_src_slice,
+  });
+  wuffs_base__io_buffer have = ((wuffs_base__io_buffer){
+      .data = global_have_slice,
+  });
+  CHECK_STRING(read_file(&src, deflate_romeo_gt.src_filename));
+
+  wuffs_deflate__decoder dec;
+  CHECK_STATUS("initialize",
+               wuffs_deflate__decoder__initialize(
+                   &dec, sizeof dec, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+
+  wuffs_base__range_ii_u64 workbuf_len =
+      wuffs_deflate__decoder__workbuf_len(&dec);
+  if ((workbuf_len.min_incl != 0x8101) || (workbuf_len.max_incl != 0x8101)) {
+    RETURN_FAIL("workbuf_len: have [%" PRIu64 " ..= %" PRIu64
+                "], want [33025 ..= 33025]",
+                workbuf_len.min_incl, workbuf_len.max_incl);
+  }
+
+  wuffs_base__status status = wuffs_deflate__decoder__transform_io(
+      &dec, &have, &src,
+      wuffs_base__make_slice_u8(global_work_array, 0x8100));
+  if (status.repr != wuffs_base__error__bad_workbuf_length) {
+    RETURN_FAIL("transform_io: have \"%s\", want \"%s\"", status.repr,
+                wuffs_base__error__bad_workbuf_length);
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_deflate_decode_block_boundaries() {
+  CHECK_FOCUS(__func__);
+
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = global_src_slice,
+  });
+  wuffs_base__io_buffer have = ((wuffs_base__io_buffer){
+      .data = global_have_slice,
+  });
+  wuffs_base__io_buffer want = ((wuffs_base__io_buffer){
+      .data = global_want_slice,
+  });
+
+  // This test data has two blocks. The second one has a back-reference into
+  // the first one's output.
+  golden_test* gt = &deflate_deflate_backref_crosses_blocks_gt;
+  CHECK_STRING(read_file(&src, gt->src_filename));
+  CHECK_STRING(read_file(&want, gt->want_filename));
+
+  // Decode once, recording each block boundary's (compressed) bit position
+  // and (uncompressed) position.
+  uint64_t bit_positions[64];
+  size_t dst_positions[64];
+  int n = 0;
+  {
+    wuffs_deflate__decoder dec;
+    CHECK_STATUS("initialize",
+                 wuffs_deflate__decoder__initialize(
+                     &dec, sizeof dec, WUFFS_VERSION,
+                     WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+    wuffs_deflate__decoder__set_report_block_boundaries(&dec, true);
+    while (true) {
+      wuffs_base__status status = wuffs_deflate__decoder__transform_io(
+          &dec, &have, &src, global_work_slice);
+      if (status.repr != wuffs_deflate__note__block_boundary) {
+        CHECK_STATUS("transform_io", status);
+        break;
+      } else if (n >= 64) {
+        RETURN_FAIL("too many block boundaries");
+      }
+      bit_positions[n] =
+          wuffs_deflate__decoder__block_boundary_bit_position(&dec);
+      dst_positions[n] = have.meta.wi;
+      n++;
+    }
+    CHECK_STRING(check_io_buffers_equal("", &have, &want));
+  }
+
+  if (n == 0) {
+    RETURN_FAIL("n: have 0, want > 0");
+  }
+
+  // Resume from each block boundary, with a new decoder primed with the
+  // (up to) 32 KiB of history and the bit offset.
+  int i;
+  for (i = 0; i < n; i++) {
+    size_t d = dst_positions[i];
+    size_t h = (d < 32768) ? d : 32768;
+    have.meta.wi = 0;
+
+    wuffs_deflate__decoder dec;
+    CHECK_STATUS("initialize",
+                 wuffs_deflate__decoder__initialize(
+                     &dec, sizeof dec, WUFFS_VERSION,
+                     WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+    CHECK_STATUS("add_history",
+                 wuffs_deflate__decoder__add_history(
+                     &dec, wuffs_base__make_slice_u8(want.data.ptr + d - h, h),
+                     global_work_slice));
+    wuffs_deflate__decoder__set_initial_bit_offset(
+        &dec, (uint32_t)(bit_positions[i] & 7));
+    src.meta.ri = (size_t)(bit_positions[i] >> 3);
+    CHECK_STATUS("transform_io", wuffs_deflate__decoder__transform_io(
+                                     &dec, &have, &src, global_work_slice));
+
+    wuffs_base__io_buffer want_suffix = wuffs_base__make_io_buffer(
+        wuffs_base__make_slice_u8(want.data.ptr + d, want.meta.wi - d),
+        wuffs_base__make_io_buffer_meta(want.meta.wi - d, 0, 0, true));
+    char prefix[64];
+    snprintf(prefix, 64, "i=%d: ", i);
+    CHECK_STRING(check_io_buffers_equal(prefix, &have, &want_suffix));
+  }
+  return NULL;
+}
+
 const char*  //
 test_wuffs_deflate_decode_deflate_backref_crosses_blocks() {
   CHECK_FOCUS(__func__);
@@ -288,6 +459,14 @@ test_wuffs_deflate_decode_deflate_huffman_primlen_9() {
   return NULL;
 }
 
+const char*  //
+test_wuffs_deflate_decode_deflate_overlapping_copies() {
+  CHECK_FOCUS(__func__);
+  return do_test_io_buffers(wuffs_deflate_decode,
+                            &deflate_deflate_overlapping_copies_gt, UINT64_MAX,
+                            UINT64_MAX);
+}
+
 const char*  //
 test_wuffs_deflate_decode_midsummer() {
   CHECK_FOCUS(__func__);
@@ -322,6 +501,91 @@ test_wuffs_deflate_decode_pi_many_small_writes_reads() {
   return do_test_io_buffers(wuffs_deflate_decode, &deflate_pi_gt, 59, 61);
 }
 
+const char*  //
+test_wuffs_deflate_decode_reset() {
+  CHECK_FOCUS(__func__);
+  wuffs_base__io_buffer want =
+      make_io_buffer_from_string(deflate_rpc_want_ptr, deflate_rpc_want_len);
+
+  wuffs_deflate__decoder dec;
+  CHECK_STATUS("initialize", wuffs_deflate__decoder__initialize(
+                                 &dec, sizeof dec, WUFFS_VERSION,
+                                 WUFFS_INITIALIZE__DEFAULT_OPTIONS));
+
+  // For i == 0, decode the message from a fresh decoder. For i == 1, reset a
+  // decoder that was suspended mid-stream. For i == 2, reset a decoder that
+  // was disabled by an error.
+  int i;
+  for (i = 0; i < 3; i++) {
+    wuffs_base__io_buffer have = ((wuffs_base__io_buffer){
+        .data = global_have_slice,
+    });
+    wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+        .data = global_src_slice,
+    });
+    memcpy(src.data.ptr, deflate_rpc_src_ptr, deflate_rpc_src_len);
+    src.meta.wi = deflate_rpc_src_len;
+    src.meta.closed = true;
+
+    if (i == 1) {
+      src.meta.wi = 40;
+      src.meta.closed = false;
+      wuffs_base__status status = wuffs_deflate__decoder__transform_io(
+          &dec, &have, &src, global_work_slice);
+      if (status.repr != wuffs_base__suspension__short_read) {
+        RETURN_FAIL("i=%d: transform_io (partial): have \"%s\", want \"%s\"",
+                    i, status.repr, wuffs_base__suspension__short_read);
+      }
+      wuffs_deflate__decoder__reset(&dec);
+      have.meta.wi = 0;
+      src.meta.ri = 0;
+      src.meta.wi = deflate_rpc_src_len;
+      src.meta.closed = true;
+
+    } else if (i == 2) {
+      // Change the block type from 2 (dynamic Huffman) to 3 (invalid).
+      src.data.ptr[0] ^= 0x02;
+      int j;
+      for (j = 0; j < 2; j++) {
+        const char* want_status =
+            (j == 0) ? wuffs_deflate__error__bad_block
+                     : wuffs_base__error__disabled_by_previous_error;
+        wuffs_base__status status = wuffs_deflate__decoder__transform_io(
+            &dec, &have, &src, global_work_slice);
+        if (status.repr != want_status) {
+          RETURN_FAIL("i=%d, j=%d: transform_io: have \"%s\", want \"%s\"", i,
+                      j, status.repr, want_status);
+        }
+      }
+      wuffs_deflate__decoder__reset(&dec);
+      src.data.ptr[0] ^= 0x02;
+      src.meta.ri = 0;
+    }
+
+    wuffs_base__status status = wuffs_deflate__decoder__transform_io(
+        &dec, &have, &src, global_work_slice);
+    if (!wuffs_base__status__is_ok(&status)) {
+      RETURN_FAIL("i=%d: transform_io: \"%s\"", i, status.repr);
+    }
+    char prefix[16];
+    snprintf(prefix, 16, "i=%d: ", i);
+    CHECK_STRING(check_io_buffers_equal(prefix, &have, &want));
+
+    // After a reset, the lcode table built for the same message (by an
+    // earlier decoding) is re-used.
+    uint64_t have_reused =
+        wuffs_deflate__decoder__num_reused_lcode_tables(&dec);
+    uint64_t want_reused = (i == 0) ? 0 : 1;
+    if (have_reused != want_reused) {
+      RETURN_FAIL("i=%d: num_reused_lcode_tables: have %" PRIu64
+                  ", want %" PRIu64,
+                  i, have_reused, want_reused);
+    }
+    wuffs_deflate__decoder__reset(&dec);
+  }
+  return NULL;
+}
+
 const char*  //
 test_wuffs_deflate_decode_romeo() {
   CHECK_FOCUS(__func__);
@@ -336,6 +600,53 @@ test_wuffs_deflate_decode_romeo_fixed() {
                             UINT64_MAX, UINT64_MAX);
 }
 
+// make_stored_deflate sets dst to a DEFLATE encoding of src as a sequence of
+// stored (uncompressed) blocks, each holding up to block_size bytes. This is
+// what compressors emit for incompressible data, such as a JPEG image inside
+// a gzip or zip file. Like zlib's Z_SYNC_FLUSH, an empty non-final block also
+// follows the first block.
+const char*  //
+make_stored_deflate(wuffs_base__io_buffer* dst,
+                    wuffs_base__io_buffer* src,
+                    size_t block_size) {
+  if ((block_size == 0) || (block_size > 0xFFFF)) {
+    RETURN_FAIL("bad block_size");
+  }
+  dst->meta.wi = 0;
+  dst->meta.ri = 0;
+  size_t i = 0;
+  bool first = true;
+  while (true) {
+    size_t n = src->meta.wi - i;
+    if (n > block_size) {
+      n = block_size;
+    }
+    bool final = (i + n) == src->meta.wi;
+    if ((dst->data.len - dst->meta.wi) < (n + 10)) {
+      RETURN_FAIL("dst is too short");
+    }
+    uint8_t* p = dst->data.ptr + dst->meta.wi;
+    p[0] = final ? 0x01 : 0x00;
+    wuffs_base__store_u16le__no_bounds_check(p + 1, (uint16_t)n);
+    wuffs_base__store_u16le__no_bounds_check(p + 3, (uint16_t)(0xFFFF ^ n));
+    memcpy(p + 5, src->data.ptr + i, n);
+    dst->meta.wi += 5 + n;
+    i += n;
+    if (final) {
+      break;
+    } else if (first) {
+      first = false;
+      p = dst->data.ptr + dst->meta.wi;
+      p[0] = 0x00;
+      wuffs_base__store_u16le__no_bounds_check(p + 1, 0x0000);
+      wuffs_base__store_u16le__no_bounds_check(p + 3, 0xFFFF);
+      dst->meta.wi += 5;
+    }
+  }
+  dst->meta.closed = true;
+  return NULL;
+}
+
 const char*  //
 test_wuffs_deflate_decode_split_src() {
   CHECK_FOCUS(__func__);
@@ -396,6 +707,335 @@ test_wuffs_deflate_decode_split_src() {
   return NULL;
 }
 
+// check_wuffs_deflate_decode_stats decodes src with a stats-collecting
+// decoder and checks that the stats are consistent with each other and with
+// want, the decoded output.
+const char*  //
+check_wuffs_deflate_decode_stats(const char* prefix,
+                                 wuffs_base__io_buffer* src,
+                                 wuffs_base__io_buffer* want,
+                                 uint64_t wlimit,
+                                 uint64_t rlimit) {
+  wuffs_base__io_buffer have = ((wuffs_base__io_buffer){
+      .data = global_have_slice,
+  });
+  wuffs_deflate__decoder dec;
+  CHECK_STATUS("initialize",
+               wuffs_deflate__decoder__initialize(
+                   &dec, sizeof dec, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  wuffs_deflate__decoder__set_collect_stats(&dec, true);
+
+  while (true) {
+    wuffs_base__io_buffer limited_dst = make_limited_writer(have, wlimit);
+    wuffs_base__io_buffer limited_src = make_limited_reader(*src, rlimit);
+    wuffs_base__status status = wuffs_deflate__decoder__transform_io(
+        &dec, &limited_dst, &limited_src, global_work_slice);
+    have.meta.wi += limited_dst.meta.wi;
+    src->meta.ri += limited_src.meta.ri;
+    if (wuffs_base__status__is_ok(&status)) {
+      break;
+    } else if ((status.repr != wuffs_base__suspension__short_write) &&
+               (status.repr != wuffs_base__suspension__short_read)) {
+      RETURN_FAIL("%stransform_io: \"%s\"", prefix, status.repr);
+    }
+  }
+  CHECK_STRING(check_io_buffers_equal(prefix, &have, want));
+
+  uint64_t s[WUFFS_DEFLATE__STATS_KEY_END];
+  uint32_t k;
+  for (k = 0; k < WUFFS_DEFLATE__STATS_KEY_END; k++) {
+    s[k] = wuffs_deflate__decoder__stats(&dec, k);
+  }
+  uint64_t sum_lengths = 0;
+  uint64_t sum_length_counts = 0;
+  for (k = 0; k < 256; k++) {
+    uint64_t n = s[WUFFS_DEFLATE__STATS_KEY_MATCH_LENGTHS + k];
+    sum_lengths += n * (k + 3);
+    sum_length_counts += n;
+  }
+  uint64_t sum_distance_counts = 0;
+  for (k = 0; k < 14; k++) {
+    sum_distance_counts += s[WUFFS_DEFLATE__STATS_KEY_MATCH_DISTANCES + k];
+  }
+
+  uint64_t have_total = s[WUFFS_DEFLATE__STATS_KEY_NUM_STORED_BYTES] +
+                        s[WUFFS_DEFLATE__STATS_KEY_NUM_FAST_BYTES] +
+                        s[WUFFS_DEFLATE__STATS_KEY_NUM_TAIL_BYTES] +
+                        s[WUFFS_DEFLATE__STATS_KEY_NUM_SLOW_BYTES];
+  uint64_t want_total = want->meta.wi;
+  if (have_total != want_total) {
+    RETURN_FAIL("%sstored + fast + tail + slow bytes: have %" PRIu64
+                ", want %" PRIu64,
+                prefix, have_total, want_total);
+  }
+  uint64_t have_huffman = s[WUFFS_DEFLATE__STATS_KEY_NUM_LITERALS] +
+                          s[WUFFS_DEFLATE__STATS_KEY_NUM_MATCH_BYTES];
+  uint64_t want_huffman = s[WUFFS_DEFLATE__STATS_KEY_NUM_FAST_BYTES] +
+                          s[WUFFS_DEFLATE__STATS_KEY_NUM_TAIL_BYTES] +
+                          s[WUFFS_DEFLATE__STATS_KEY_NUM_SLOW_BYTES];
+  if (have_huffman != want_huffman) {
+    RETURN_FAIL("%sliterals + match bytes: have %" PRIu64 ", want %" PRIu64,
+                prefix, have_huffman, want_huffman);
+  }
+  // With short reads and writes, decode_huffman_fast cannot finish each
+  // buffer, and decode_huffman_tail should pick up most of what it leaves.
+  if ((have_huffman > 0) && (rlimit < 1000) &&
+      (s[WUFFS_DEFLATE__STATS_KEY_NUM_TAIL_BYTES] <=
+       s[WUFFS_DEFLATE__STATS_KEY_NUM_SLOW_BYTES])) {
+    RETURN_FAIL("%stail bytes: have %" PRIu64 ", want > %" PRIu64, prefix,
+                s[WUFFS_DEFLATE__STATS_KEY_NUM_TAIL_BYTES],
+                s[WUFFS_DEFLATE__STATS_KEY_NUM_SLOW_BYTES]);
+  }
+  if (sum_lengths != s[WUFFS_DEFLATE__STATS_KEY_NUM_MATCH_BYTES]) {
+    RETURN_FAIL("%ssum of match lengths: have %" PRIu64 ", want %" PRIu64,
+                prefix, sum_lengths,
+                s[WUFFS_DEFLATE__STATS_KEY_NUM_MATCH_BYTES]);
+  }
+  if ((sum_length_counts != s[WUFFS_DEFLATE__STATS_KEY_NUM_MATCHES]) ||
+      (sum_distance_counts != s[WUFFS_DEFLATE__STATS_KEY_NUM_MATCHES])) {
+    RETURN_FAIL("%shistogram counts: have %" PRIu64 " and %" PRIu64
+                ", want %" PRIu64,
+                prefix, sum_length_counts, sum_distance_counts,
+                s[WUFFS_DEFLATE__STATS_KEY_NUM_MATCHES]);
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_deflate_decode_stats() {
+  CHECK_FOCUS(__func__);
+
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = global_src_slice,
+  });
+  wuffs_base__io_buffer want = ((wuffs_base__io_buffer){
+      .data = global_want_slice,
+  });
+  const uint64_t limits[2] = {UINT64_MAX, 61};
+
+  // Dynamic and fixed Huffman blocks.
+  golden_test* gts[2] = {&deflate_midsummer_gt, &deflate_romeo_fixed_gt};
+  int i;
+  for (i = 0; i < 2; i++) {
+    int w;
+    for (w = 0; w < 2; w++) {
+      src.meta.wi = 0;
+      src.meta.ri = 0;
+      src.meta.closed = false;
+      want.meta.wi = 0;
+      want.meta.ri = 0;
+      want.meta.closed = false;
+      CHECK_STRING(read_file(&src, gts[i]->src_filename));
+      CHECK_STRING(read_file(&want, gts[i]->want_filename));
+      src.meta.ri = gts[i]->src_offset0;
+      if (gts[i]->src_offset1) {
+        src.meta.wi = gts[i]->src_offset1;
+      }
+      char prefix[64];
+      snprintf(prefix, 64, "i=%d, w=%d: ", i, w);
+      CHECK_STRING(check_wuffs_deflate_decode_stats(prefix, &src, &want,
+                                                    limits[w], limits[w]));
+    }
+  }
+
+  // Stored blocks.
+  want.meta.wi = 0;
+  want.meta.ri = 0;
+  want.meta.closed = false;
+  CHECK_STRING(read_file(&want, "test/data/romeo.txt"));
+  CHECK_STRING(make_stored_deflate(&src, &want, 100));
+  CHECK_STRING(check_wuffs_deflate_decode_stats("stored: ", &src, &want,
+                                                UINT64_MAX, UINT64_MAX));
+
+  // Check some exact values, for a single decoding of each block type.
+  wuffs_deflate__decoder dec;
+  CHECK_STATUS("initialize",
+               wuffs_deflate__decoder__initialize(
+                   &dec, sizeof dec, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  uint64_t have = wuffs_deflate__decoder__stats(
+      &dec, WUFFS_DEFLATE__STATS_KEY_NUM_STORED_BLOCKS);
+  if (have != 0) {
+    RETURN_FAIL("before: num_stored_blocks: have %" PRIu64 ", want 0", have);
+  }
+  wuffs_deflate__decoder__set_collect_stats(&dec, true);
+  src.meta.ri = 0;
+  wuffs_base__io_buffer dst = ((wuffs_base__io_buffer){
+      .data = global_have_slice,
+  });
+  CHECK_STATUS("transform_io", wuffs_deflate__decoder__transform_io(
+                                   &dec, &dst, &src, global_work_slice));
+  // make_stored_deflate wrote 10 non-empty blocks and 1 empty block.
+  have = wuffs_deflate__decoder__stats(
+      &dec, WUFFS_DEFLATE__STATS_KEY_NUM_STORED_BLOCKS);
+  if (have != 11) {
+    RETURN_FAIL("num_stored_blocks: have %" PRIu64 ", want 11", have);
+  }
+  have = wuffs_deflate__decoder__stats(
+      &dec, WUFFS_DEFLATE__STATS_KEY_NUM_STORED_BYTES);
+  if (have != 942) {
+    RETURN_FAIL("num_stored_bytes: have %" PRIu64 ", want 942", have);
+  }
+  have = wuffs_deflate__decoder__stats(&dec, WUFFS_DEFLATE__STATS_KEY_END);
+  if (have != 0) {
+    RETURN_FAIL("out of range key: have %" PRIu64 ", want 0", have);
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_deflate_decode_stored_blocks() {
+  CHECK_FOCUS(__func__);
+
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = global_src_slice,
+  });
+  wuffs_base__io_buffer have = ((wuffs_base__io_buffer){
+      .data = global_have_slice,
+  });
+  wuffs_base__io_buffer want = ((wuffs_base__io_buffer){
+      .data = global_want_slice,
+  });
+  CHECK_STRING(read_file(&want, "test/data/harvesters.jpeg"));
+
+  // The 0x9000 block size is more than the 32 KiB of history, so that
+  // add_history sometimes sees more than the history ringbuffer can hold.
+  const size_t block_sizes[3] = {1000, 0x9000, 0xFFFF};
+  const uint64_t limits[4] = {UINT64_MAX, 0x10001, 4096, 61};
+  int b;
+  for (b = 0; b < 3; b++) {
+    CHECK_STRING(make_stored_deflate(&src, &want, block_sizes[b]));
+    int w;
+    for (w = 0; w < 4; w++) {
+      int r;
+      for (r = 0; r < 4; r++) {
+        // Skip the slowest combinations.
+        if ((limits[w] < 4096) && (limits[r] < 4096)) {
+          continue;
+        }
+        have.meta.wi = 0;
+        src.meta.ri = 0;
+        char prefix[64];
+        snprintf(prefix, 64, "b=%d, w=%d, r=%d: ", b, w, r);
+        const char* status = wuffs_deflate_decode(
+            &have, &src, WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED,
+            limits[w], limits[r]);
+        if (status) {
+          RETURN_FAIL("%s%s", prefix, status);
+        }
+        CHECK_STRING(check_io_buffers_equal(prefix, &have, &want));
+      }
+    }
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_deflate_decode_whole_output_in_dst() {
+  CHECK_FOCUS(__func__);
+
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = global_src_slice,
+  });
+  wuffs_base__io_buffer have = ((wuffs_base__io_buffer){
+      .data = global_have_slice,
+  });
+  wuffs_base__io_buffer want = ((wuffs_base__io_buffer){
+      .data = global_want_slice,
+  });
+
+  golden_test* gt = &deflate_midsummer_gt;
+  CHECK_STRING(read_file(&src, gt->src_filename));
+  CHECK_STRING(read_file(&want, gt->want_filename));
+  src.meta.ri = gt->src_offset0;
+  src.meta.wi = gt->src_offset1;
+
+  wuffs_deflate__decoder dec;
+  CHECK_STATUS("initialize",
+               wuffs_deflate__decoder__initialize(
+                   &dec, sizeof dec, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  wuffs_deflate__decoder__set_whole_output_in_dst(&dec, true);
+
+  int num_suspensions = 0;
+  while (true) {
+    wuffs_base__io_buffer limited_src = make_limited_reader(src, 97);
+    wuffs_base__status status = wuffs_deflate__decoder__transform_io(
+        &dec, &have, &limited_src, global_work_slice);
+    src.meta.ri += limited_src.meta.ri;
+    if (status.repr != wuffs_base__suspension__short_read) {
+      CHECK_STATUS("transform_io", status);
+      break;
+    }
+    num_suspensions++;
+  }
+
+  if (num_suspensions == 0) {
+    RETURN_FAIL("num_suspensions: have 0, want > 0");
+  }
+  // No output was copied to the history ringbuffer.
+  if (dec.private_impl.f_history_index != 0) {
+    RETURN_FAIL("history_index: have %" PRIu32 ", want 0",
+                dec.private_impl.f_history_index);
+  }
+  return check_io_buffers_equal("", &have, &want);
+}
+
+const char*  //
+test_wuffs_deflate_decode_whole_output_in_dst_reset() {
+  CHECK_FOCUS(__func__);
+
+  // src0 is the raw DEFLATE encoding of "a". src1 starts with a length 3,
+  // distance 1 back-reference, so it needs one byte of history.
+  const char* src0 = "\x4B\x04\x00";
+  const char* src1 = "\x03\x02\x00";
+
+  int i;
+  for (i = 0; i < 4; i++) {
+    bool whole = i & 1;
+    bool add_history = i & 2;
+
+    wuffs_deflate__decoder dec;
+    CHECK_STATUS("initialize",
+                 wuffs_deflate__decoder__initialize(
+                     &dec, sizeof dec, WUFFS_VERSION,
+                     WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+    wuffs_deflate__decoder__set_whole_output_in_dst(&dec, whole);
+
+    wuffs_base__io_buffer have = ((wuffs_base__io_buffer){
+        .data = global_have_slice,
+    });
+    wuffs_base__io_buffer src = make_io_buffer_from_string(src0, 3);
+    CHECK_STATUS("transform_io #0", wuffs_deflate__decoder__transform_io(
+                                        &dec, &have, &src, global_work_slice));
+
+    // After a reset, the previous stream's "a", still in have, is not
+    // history for the new stream. Only add_history makes it so.
+    wuffs_deflate__decoder__reset(&dec);
+    if (add_history) {
+      CHECK_STATUS("add_history",
+                   wuffs_deflate__decoder__add_history(
+                       &dec, wuffs_base__make_slice_u8(global_have_array, 1),
+                       global_work_slice));
+    }
+
+    src = make_io_buffer_from_string(src1, 3);
+    wuffs_base__status status = wuffs_deflate__decoder__transform_io(
+        &dec, &have, &src, global_work_slice);
+    if (add_history) {
+      CHECK_STATUS("transform_io #1", status);
+      if (have.meta.wi != 4) {
+        RETURN_FAIL("i=%d: have.meta.wi: have %zu, want 4", i, have.meta.wi);
+      }
+    } else if (status.repr != wuffs_deflate__error__bad_distance) {
+      RETURN_FAIL("i=%d: transform_io #1: have \"%s\", want \"%s\"", i,
+                  status.repr, wuffs_deflate__error__bad_distance);
+    }
+  }
+  return NULL;
+}
+
 const char*  //
 do_test_wuffs_deflate_history(int i,
                               golden_test* gt,
@@ -429,7 +1069,7 @@ do_test_wuffs_deflate_history(int i,
 
     wuffs_base__io_buffer head = ((wuffs_base__io_buffer){
         .data = ((wuffs_base__slice_u8){
-            .ptr = dec->private_data.f_history + 0,
+            .ptr = global_work_array + 0,
             .len = max_length_minus_1,
         }),
     });
@@ -437,7 +1077,7 @@ do_test_wuffs_deflate_history(int i,
 
     wuffs_base__io_buffer tail = ((wuffs_base__io_buffer){
         .data = ((wuffs_base__slice_u8){
-            .ptr = dec->private_data.f_history + 0x8000,
+            .ptr = global_work_array + 0x8000,
             .len = max_length_minus_1,
         }),
     });
@@ -491,7 +1131,7 @@ test_wuffs_deflate_history_full() {
 
     wuffs_base__io_buffer history_have = ((wuffs_base__io_buffer){
         .data = ((wuffs_base__slice_u8){
-            .ptr = dec.private_data.f_history,
+            .ptr = global_work_array,
             .len = full_history_size,
         }),
     });
@@ -540,8 +1180,8 @@ test_wuffs_deflate_history_partial() {
     const uint32_t fragment_length = 4;
 
     wuffs_deflate__decoder dec;
-    memset(&(dec.private_data.f_history), 0,
-           sizeof(dec.private_data.f_history));
+    memset(global_work_array, 0,
+           WUFFS_DEFLATE__DECODER_WORKBUF_LEN_MAX_INCL_WORST_CASE);
     CHECK_STATUS("initialize",
                  wuffs_deflate__decoder__initialize(
                      &dec, sizeof dec, WUFFS_VERSION,
@@ -567,7 +1207,7 @@ test_wuffs_deflate_history_partial() {
     int j;
     for (j = -2; j < (int)(fragment_length) + 2; j++) {
       uint32_t index = (starting_history_index + j) & 0x7FFF;
-      uint8_t have = dec.private_data.f_history[index];
+      uint8_t have = global_work_array[index];
       uint8_t want = (0 <= j && j < fragment_length) ? fragment[j] : 0;
       if (have != want) {
         RETURN_FAIL("i=%d: starting_history_index=0x%04" PRIX32
@@ -708,6 +1348,238 @@ test_wuffs_deflate_table_redirect() {
   return NULL;
 }
 
+const char*  //
+wuffs_deflate_encode(wuffs_base__io_buffer* dst,
+                     wuffs_base__io_buffer* src,
+                     uint32_t wuffs_initialize_flags,
+                     uint32_t level,
+                     uint64_t wlimit,
+                     uint64_t rlimit) {
+  wuffs_deflate__encoder enc;
+  CHECK_STATUS("initialize",
+               wuffs_deflate__encoder__initialize(
+                   &enc, sizeof enc, WUFFS_VERSION, wuffs_initialize_flags));
+  wuffs_deflate__encoder__set_level(&enc, level);
+
+  while (true) {
+    wuffs_base__io_buffer limited_dst = make_limited_writer(*dst, wlimit);
+    wuffs_base__io_buffer limited_src = make_limited_reader(*src, rlimit);
+
+    wuffs_base__status status = wuffs_deflate__encoder__transform_io(
+        &enc, &limited_dst, &limited_src, global_work_slice);
+
+    dst->meta.wi += limited_dst.meta.wi;
+    src->meta.ri += limited_src.meta.ri;
+
+    if (((wlimit < UINT64_MAX) &&
+         (status.repr == wuffs_base__suspension__short_write)) ||
+        ((rlimit < UINT64_MAX) &&
+         (status.repr == wuffs_base__suspension__short_read))) {
+      continue;
+    }
+    return status.repr;
+  }
+}
+
+const char*  //
+wuffs_deflate_encode_level_1(wuffs_base__io_buffer* dst,
+                             wuffs_base__io_buffer* src,
+                             uint32_t wuffs_initialize_flags,
+                             uint64_t wlimit,
+                             uint64_t rlimit) {
+  return wuffs_deflate_encode(dst, src, wuffs_initialize_flags, 1, wlimit,
+                              rlimit);
+}
+
+const char*  //
+wuffs_deflate_encode_level_6(wuffs_base__io_buffer* dst,
+                             wuffs_base__io_buffer* src,
+                             uint32_t wuffs_initialize_flags,
+                             uint64_t wlimit,
+                             uint64_t rlimit) {
+  return wuffs_deflate_encode(dst, src, wuffs_initialize_flags, 6, wlimit,
+                              rlimit);
+}
+
+// do_test_wuffs_deflate_encode_round_trip encodes the src_filename file's
+// contents, checks the encoded length (if want_encoded_len is non-zero) and
+// then checks that decoding that encoding gives back the original contents.
+const char*  //
+do_test_wuffs_deflate_encode_round_trip(const char* prefix,
+                                        const char* src_filename,
+                                        uint32_t level,
+                                        uint64_t wlimit,
+                                        uint64_t rlimit,
+                                        size_t want_encoded_len) {
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = global_src_slice,
+  });
+  wuffs_base__io_buffer encoded = ((wuffs_base__io_buffer){
+      .data = global_want_slice,
+  });
+  wuffs_base__io_buffer have = ((wuffs_base__io_buffer){
+      .data = global_have_slice,
+  });
+
+  if (src_filename) {
+    CHECK_STRING(read_file(&src, src_filename));
+  } else {
+    src.meta.closed = true;
+  }
+  const char* status = wuffs_deflate_encode(
+      &encoded, &src, WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED,
+      level, wlimit, rlimit);
+  if (status) {
+    RETURN_FAIL("%sencode: %s", prefix, status);
+  }
+  if (src.meta.ri != src.meta.wi) {
+    RETURN_FAIL("%ssrc ri: have %zu, want %zu", prefix, src.meta.ri,
+                src.meta.wi);
+  }
+  if (want_encoded_len && (encoded.meta.wi != want_encoded_len)) {
+    RETURN_FAIL("%sencoded length: have %zu, want %zu", prefix,
+                encoded.meta.wi, want_encoded_len);
+  }
+
+  encoded.meta.closed = true;
+  status = wuffs_deflate_decode(
+      &have, &encoded, WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED,
+      UINT64_MAX, UINT64_MAX);
+  if (status) {
+    RETURN_FAIL("%sdecode: %s", prefix, status);
+  }
+  src.meta.ri = 0;
+  return check_io_buffers_equal(prefix, &have, &src);
+}
+
+const char*  //
+test_wuffs_deflate_encode_empty() {
+  CHECK_FOCUS(__func__);
+  // Level 0 emits an empty stored block. The other levels emit an empty fixed
+  // Huffman block: just the end-of-block code.
+  uint32_t level;
+  for (level = 0; level <= 9; level++) {
+    char prefix[64];
+    snprintf(prefix, 64, "level=%" PRIu32 ": ", level);
+    CHECK_STRING(do_test_wuffs_deflate_encode_round_trip(
+        prefix, NULL, level, UINT64_MAX, UINT64_MAX, (level == 0) ? 5 : 2));
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_deflate_encode_interface() {
+  CHECK_FOCUS(__func__);
+  wuffs_deflate__encoder enc;
+  CHECK_STATUS("initialize",
+               wuffs_deflate__encoder__initialize(
+                   &enc, sizeof enc, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  return do_test__wuffs_base__io_transformer(
+      wuffs_deflate__encoder__upcast_as__wuffs_base__io_transformer(&enc),
+      "test/data/romeo.txt", 0, SIZE_MAX, 529, 0x00);
+}
+
+const char*  //
+test_wuffs_deflate_encode_io_limits() {
+  CHECK_FOCUS(__func__);
+  const char* filenames[2] = {
+      "test/data/midsummer.txt",
+      "test/data/pi.txt",
+  };
+  const uint32_t levels[3] = {0, 1, 6};
+  const uint64_t limits[3] = {UINT64_MAX, 4096, 61};
+  int f;
+  for (f = 0; f < 2; f++) {
+    int l;
+    for (l = 0; l < 3; l++) {
+      int w;
+      for (w = 0; w < 3; w++) {
+        int r;
+        for (r = 0; r < 3; r++) {
+          char prefix[64];
+          snprintf(prefix, 64, "f=%d, l=%d, w=%d, r=%d: ", f, l, w, r);
+          CHECK_STRING(do_test_wuffs_deflate_encode_round_trip(
+              prefix, filenames[f], levels[l], limits[w], limits[r], 0));
+        }
+      }
+    }
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_deflate_encode_levels() {
+  CHECK_FOCUS(__func__);
+
+  // The want_encoded_lens are deterministic, so that changes to the
+  // encoder's compression ratio are noticed. For comparison, zlib's deflate
+  // (version 1.2.13, with the same level, windowBits = -15 and memLevel = 8)
+  // gives 11070, 5531, 5142, 100013, 49921, 48174, 3003432, 2573412 and
+  // 2631333 bytes.
+  struct {
+    const char* filename;
+    uint32_t level;
+    size_t want_encoded_len;
+  } test_cases[] = {
+      {
+          .filename = "test/data/midsummer.txt",
+          .level = 0,
+          .want_encoded_len = 11070,
+      },
+      {
+          .filename = "test/data/midsummer.txt",
+          .level = 1,
+          .want_encoded_len = 5520,
+      },
+      {
+          .filename = "test/data/midsummer.txt",
+          .level = 6,
+          .want_encoded_len = 5142,
+      },
+      {
+          .filename = "test/data/pi.txt",
+          .level = 0,
+          .want_encoded_len = 100013,
+      },
+      {
+          .filename = "test/data/pi.txt",
+          .level = 1,
+          .want_encoded_len = 49921,
+      },
+      {
+          .filename = "test/data/pi.txt",
+          .level = 6,
+          .want_encoded_len = 48167,
+      },
+      {
+          .filename = "test/data/harvesters.bmp",
+          .level = 0,
+          .want_encoded_len = 3003432,
+      },
+      {
+          .filename = "test/data/harvesters.bmp",
+          .level = 1,
+          .want_encoded_len = 2575172,
+      },
+      {
+          .filename = "test/data/harvesters.bmp",
+          .level = 6,
+          .want_encoded_len = 2631373,
+      },
+  };
+
+  int tc;
+  for (tc = 0; tc < WUFFS_TESTLIB_ARRAY_SIZE(test_cases); tc++) {
+    char prefix[64];
+    snprintf(prefix, 64, "tc=%d: ", tc);
+    CHECK_STRING(do_test_wuffs_deflate_encode_round_trip(
+        prefix, test_cases[tc].filename, test_cases[tc].level, UINT64_MAX,
+        UINT64_MAX, test_cases[tc].want_encoded_len));
+  }
+  return NULL;
+}
+
   // ---------------- Mimic Tests
 
 #ifdef WUFFS_MIMIC
@@ -804,6 +1676,102 @@ test_mimic_deflate_decode_romeo_fixed() {
 
 // ---------------- Deflate Benches
 
+const char*  //
+do_bench_wuffs_deflate_decode_rpc(uint32_t wuffs_initialize_flags,
+                                  bool reset,
+                                  uint64_t iters_unscaled) {
+  wuffs_base__io_buffer have = ((wuffs_base__io_buffer){
+      .data = global_have_slice,
+  });
+  wuffs_base__io_buffer src =
+      make_io_buffer_from_string(deflate_rpc_src_ptr, deflate_rpc_src_len);
+
+  wuffs_deflate__decoder dec;
+  CHECK_STATUS("initialize",
+               wuffs_deflate__decoder__initialize(
+                   &dec, sizeof dec, WUFFS_VERSION, wuffs_initialize_flags));
+
+  bench_start();
+  uint64_t n_bytes = 0;
+  uint64_t i;
+  uint64_t iters = iters_unscaled * flags.iterscale;
+  for (i = 0; i < iters; i++) {
+    have.meta.wi = 0;
+    src.meta.ri = 0;
+    if (reset) {
+      wuffs_deflate__decoder__reset(&dec);
+    } else {
+      CHECK_STATUS("initialize", wuffs_deflate__decoder__initialize(
+                                     &dec, sizeof dec, WUFFS_VERSION,
+                                     wuffs_initialize_flags));
+    }
+    CHECK_STATUS("transform_io", wuffs_deflate__decoder__transform_io(
+                                     &dec, &have, &src, global_work_slice));
+    n_bytes += have.meta.wi;
+  }
+  bench_finish(iters, n_bytes);
+  return NULL;
+}
+
+const char*  //
+do_bench_deflate_decode_stored(
+    const char* (*codec_func)(wuffs_base__io_buffer*,
+                              wuffs_base__io_buffer*,
+                              uint32_t,
+                              uint64_t,
+                              uint64_t),
+    uint64_t wlimit,
+    uint64_t rlimit,
+    uint64_t iters_unscaled) {
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = global_src_slice,
+  });
+  wuffs_base__io_buffer have = ((wuffs_base__io_buffer){
+      .data = global_have_slice,
+  });
+  wuffs_base__io_buffer want = ((wuffs_base__io_buffer){
+      .data = global_want_slice,
+  });
+  CHECK_STRING(read_file(&want, "test/data/harvesters.jpeg"));
+  CHECK_STRING(make_stored_deflate(&src, &want, 0xFFFF));
+
+  bench_start();
+  uint64_t n_bytes = 0;
+  uint64_t i;
+  uint64_t iters = iters_unscaled * flags.iterscale;
+  for (i = 0; i < iters; i++) {
+    have.meta.wi = 0;
+    src.meta.ri = 0;
+    CHECK_STRING(codec_func(
+        &have, &src, WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED,
+        wlimit, rlimit));
+    n_bytes += have.meta.wi;
+  }
+  bench_finish(iters, n_bytes);
+  return NULL;
+}
+
+const char*  //
+bench_wuffs_deflate_decode_100b_full_init() {
+  CHECK_FOCUS(__func__);
+  return do_bench_wuffs_deflate_decode_rpc(WUFFS_INITIALIZE__DEFAULT_OPTIONS,
+                                           false, 2000);
+}
+
+const char*  //
+bench_wuffs_deflate_decode_100b_part_init() {
+  CHECK_FOCUS(__func__);
+  return do_bench_wuffs_deflate_decode_rpc(
+      WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED, false, 2000);
+}
+
+const char*  //
+bench_wuffs_deflate_decode_100b_reset() {
+  CHECK_FOCUS(__func__);
+  return do_bench_wuffs_deflate_decode_rpc(WUFFS_INITIALIZE__DEFAULT_OPTIONS,
+                                           true, 2000);
+}
+
 const char*  //
 bench_wuffs_deflate_decode_1k_full_init() {
   CHECK_FOCUS(__func__);
@@ -821,6 +1789,15 @@ bench_wuffs_deflate_decode_1k_part_init() {
       &deflate_romeo_gt, UINT64_MAX, UINT64_MAX, 2000);
 }
 
+const char*  //
+bench_wuffs_deflate_decode_1k_fixed_huff() {
+  CHECK_FOCUS(__func__);
+  return do_bench_io_buffers(
+      wuffs_deflate_decode,
+      WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED, tcounter_dst,
+      &deflate_romeo_fixed_gt, UINT64_MAX, UINT64_MAX, 2000);
+}
+
 const char*  //
 bench_wuffs_deflate_decode_10k_full_init() {
   CHECK_FOCUS(__func__);
@@ -838,6 +1815,15 @@ bench_wuffs_deflate_decode_10k_part_init() {
       &deflate_midsummer_gt, UINT64_MAX, UINT64_MAX, 300);
 }
 
+const char*  //
+bench_wuffs_deflate_decode_25k_json() {
+  CHECK_FOCUS(__func__);
+  return do_bench_io_buffers(
+      wuffs_deflate_decode,
+      WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED, tcounter_dst,
+      &deflate_australian_abc_gt, UINT64_MAX, UINT64_MAX, 100);
+}
+
 const char*  //
 bench_wuffs_deflate_decode_100k_just_one_read() {
   CHECK_FOCUS(__func__);
@@ -856,10 +1842,96 @@ bench_wuffs_deflate_decode_100k_many_big_reads() {
       &deflate_pi_gt, UINT64_MAX, 4096, 30);
 }
 
+const char*  //
+bench_wuffs_deflate_decode_100k_1k_buffers() {
+  CHECK_FOCUS(__func__);
+  return do_bench_io_buffers(
+      wuffs_deflate_decode,
+      WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED, tcounter_dst,
+      &deflate_pi_gt, 1024, 1024, 30);
+}
+
+const char*  //
+bench_wuffs_deflate_decode_100k_4k_buffers() {
+  CHECK_FOCUS(__func__);
+  return do_bench_io_buffers(
+      wuffs_deflate_decode,
+      WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED, tcounter_dst,
+      &deflate_pi_gt, 4096, 4096, 30);
+}
+
+const char*  //
+bench_wuffs_deflate_decode_400k_stored() {
+  CHECK_FOCUS(__func__);
+  return do_bench_deflate_decode_stored(wuffs_deflate_decode, UINT64_MAX,
+                                        UINT64_MAX, 30);
+}
+
+const char*  //
+bench_wuffs_deflate_decode_400k_stored_many_big_writes() {
+  CHECK_FOCUS(__func__);
+  return do_bench_deflate_decode_stored(wuffs_deflate_decode, 4096, UINT64_MAX,
+                                        30);
+}
+
+const char*  //
+bench_wuffs_deflate_encode_10k_level_1() {
+  CHECK_FOCUS(__func__);
+  return do_bench_io_buffers(
+      wuffs_deflate_encode_level_1,
+      WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED, tcounter_src,
+      &deflate_encode_midsummer_gt, UINT64_MAX, UINT64_MAX, 30);
+}
+
+const char*  //
+bench_wuffs_deflate_encode_10k_level_6() {
+  CHECK_FOCUS(__func__);
+  return do_bench_io_buffers(
+      wuffs_deflate_encode_level_6,
+      WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED, tcounter_src,
+      &deflate_encode_midsummer_gt, UINT64_MAX, UINT64_MAX, 30);
+}
+
+const char*  //
+bench_wuffs_deflate_encode_100k_level_1() {
+  CHECK_FOCUS(__func__);
+  return do_bench_io_buffers(
+      wuffs_deflate_encode_level_1,
+      WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED, tcounter_src,
+      &deflate_encode_pi_gt, UINT64_MAX, UINT64_MAX, 3);
+}
+
+const char*  //
+bench_wuffs_deflate_encode_100k_level_6() {
+  CHECK_FOCUS(__func__);
+  return do_bench_io_buffers(
+      wuffs_deflate_encode_level_6,
+      WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED, tcounter_src,
+      &deflate_encode_pi_gt, UINT64_MAX, UINT64_MAX, 3);
+}
+
   // ---------------- Mimic Benches
 
 #ifdef WUFFS_MIMIC
 
+const char*  //
+mimic_deflate_encode_level_1(wuffs_base__io_buffer* dst,
+                             wuffs_base__io_buffer* src,
+                             uint32_t wuffs_initialize_flags,
+                             uint64_t wlimit,
+                             uint64_t rlimit) {
+  return mimic_deflate_encode(dst, src, 1, wlimit, rlimit);
+}
+
+const char*  //
+mimic_deflate_encode_level_6(wuffs_base__io_buffer* dst,
+                             wuffs_base__io_buffer* src,
+                             uint32_t wuffs_initialize_flags,
+                             uint64_t wlimit,
+                             uint64_t rlimit) {
+  return mimic_deflate_encode(dst, src, 6, wlimit, rlimit);
+}
+
 const char*  //
 bench_mimic_deflate_decode_1k() {
   CHECK_FOCUS(__func__);
@@ -867,6 +1939,14 @@ bench_mimic_deflate_decode_1k() {
                              &deflate_romeo_gt, UINT64_MAX, UINT64_MAX, 2000);
 }
 
+const char*  //
+bench_mimic_deflate_decode_1k_fixed_huff() {
+  CHECK_FOCUS(__func__);
+  return do_bench_io_buffers(mimic_deflate_decode, 0, tcounter_dst,
+                             &deflate_romeo_fixed_gt, UINT64_MAX, UINT64_MAX,
+                             2000);
+}
+
 const char*  //
 bench_mimic_deflate_decode_10k() {
   CHECK_FOCUS(__func__);
@@ -875,6 +1955,14 @@ bench_mimic_deflate_decode_10k() {
                              300);
 }
 
+const char*  //
+bench_mimic_deflate_decode_25k_json() {
+  CHECK_FOCUS(__func__);
+  return do_bench_io_buffers(mimic_deflate_decode, 0, tcounter_dst,
+                             &deflate_australian_abc_gt, UINT64_MAX,
+                             UINT64_MAX, 100);
+}
+
 const char*  //
 bench_mimic_deflate_decode_100k_just_one_read() {
   CHECK_FOCUS(__func__);
@@ -889,6 +1977,64 @@ bench_mimic_deflate_decode_100k_many_big_reads() {
                              &deflate_pi_gt, UINT64_MAX, 4096, 30);
 }
 
+const char*  //
+bench_mimic_deflate_decode_100k_1k_buffers() {
+  CHECK_FOCUS(__func__);
+  return do_bench_io_buffers(mimic_deflate_decode, 0, tcounter_dst,
+                             &deflate_pi_gt, 1024, 1024, 30);
+}
+
+const char*  //
+bench_mimic_deflate_decode_100k_4k_buffers() {
+  CHECK_FOCUS(__func__);
+  return do_bench_io_buffers(mimic_deflate_decode, 0, tcounter_dst,
+                             &deflate_pi_gt, 4096, 4096, 30);
+}
+
+const char*  //
+bench_mimic_deflate_decode_400k_stored() {
+  CHECK_FOCUS(__func__);
+  return do_bench_deflate_decode_stored(mimic_deflate_decode, UINT64_MAX,
+                                        UINT64_MAX, 30);
+}
+
+const char*  //
+bench_mimic_deflate_decode_400k_stored_many_big_writes() {
+  CHECK_FOCUS(__func__);
+  return do_bench_deflate_decode_stored(mimic_deflate_decode, 4096, UINT64_MAX,
+                                        30);
+}
+
+const char*  //
+bench_mimic_deflate_encode_10k_level_1() {
+  CHECK_FOCUS(__func__);
+  return do_bench_io_buffers(mimic_deflate_encode_level_1, 0, tcounter_src,
+                             &deflate_encode_midsummer_gt, UINT64_MAX,
+                             UINT64_MAX, 30);
+}
+
+const char*  //
+bench_mimic_deflate_encode_10k_level_6() {
+  CHECK_FOCUS(__func__);
+  return do_bench_io_buffers(mimic_deflate_encode_level_6, 0, tcounter_src,
+                             &deflate_encode_midsummer_gt, UINT64_MAX,
+                             UINT64_MAX, 30);
+}
+
+const char*  //
+bench_mimic_deflate_encode_100k_level_1() {
+  CHECK_FOCUS(__func__);
+  return do_bench_io_buffers(mimic_deflate_encode_level_1, 0, tcounter_src,
+                             &deflate_encode_pi_gt, UINT64_MAX, UINT64_MAX, 3);
+}
+
+const char*  //
+bench_mimic_deflate_encode_100k_level_6() {
+  CHECK_FOCUS(__func__);
+  return do_bench_io_buffers(mimic_deflate_encode_level_6, 0, tcounter_src,
+                             &deflate_encode_pi_gt, UINT64_MAX, UINT64_MAX, 3);
+}
+
 #endif  // WUFFS_MIMIC
 
 // ---------------- Manifest
@@ -896,20 +2042,33 @@ bench_mimic_deflate_decode_100k_many_big_reads() {
 proc tests[] = {
 
     test_wuffs_deflate_decode_256_bytes,
+    test_wuffs_deflate_decode_australian_abc,
+    test_wuffs_deflate_decode_bad_workbuf_length,
+    test_wuffs_deflate_decode_block_boundaries,
     test_wuffs_deflate_decode_deflate_backref_crosses_blocks,
     test_wuffs_deflate_decode_deflate_degenerate_huffman_unused,
     test_wuffs_deflate_decode_deflate_distance_32768,
     test_wuffs_deflate_decode_deflate_distance_code_31,
     test_wuffs_deflate_decode_deflate_huffman_primlen_9,
+    test_wuffs_deflate_decode_deflate_overlapping_copies,
     test_wuffs_deflate_decode_interface,
     test_wuffs_deflate_decode_midsummer,
     test_wuffs_deflate_decode_pi_just_one_read,
     test_wuffs_deflate_decode_pi_many_big_reads,
     test_wuffs_deflate_decode_pi_many_medium_reads,
     test_wuffs_deflate_decode_pi_many_small_writes_reads,
+    test_wuffs_deflate_decode_reset,
     test_wuffs_deflate_decode_romeo,
     test_wuffs_deflate_decode_romeo_fixed,
     test_wuffs_deflate_decode_split_src,
+    test_wuffs_deflate_decode_stats,
+    test_wuffs_deflate_decode_stored_blocks,
+    test_wuffs_deflate_decode_whole_output_in_dst,
+    test_wuffs_deflate_decode_whole_output_in_dst_reset,
+    test_wuffs_deflate_encode_empty,
+    test_wuffs_deflate_encode_interface,
+    test_wuffs_deflate_encode_io_limits,
+    test_wuffs_deflate_encode_levels,
     test_wuffs_deflate_history_full,
     test_wuffs_deflate_history_partial,
     test_wuffs_deflate_table_redirect,
@@ -935,19 +2094,42 @@ proc tests[] = {
 
 proc benches[] = {
 
+    bench_wuffs_deflate_decode_100b_full_init,
+    bench_wuffs_deflate_decode_100b_part_init,
+    bench_wuffs_deflate_decode_100b_reset,
     bench_wuffs_deflate_decode_1k_full_init,
     bench_wuffs_deflate_decode_1k_part_init,
+    bench_wuffs_deflate_decode_1k_fixed_huff,
     bench_wuffs_deflate_decode_10k_full_init,
     bench_wuffs_deflate_decode_10k_part_init,
+    bench_wuffs_deflate_decode_25k_json,
     bench_wuffs_deflate_decode_100k_just_one_read,
     bench_wuffs_deflate_decode_100k_many_big_reads,
+    bench_wuffs_deflate_decode_100k_1k_buffers,
+    bench_wuffs_deflate_decode_100k_4k_buffers,
+    bench_wuffs_deflate_decode_400k_stored,
+    bench_wuffs_deflate_decode_400k_stored_many_big_writes,
+    bench_wuffs_deflate_encode_10k_level_1,
+    bench_wuffs_deflate_encode_10k_level_6,
+    bench_wuffs_deflate_encode_100k_level_1,
+    bench_wuffs_deflate_encode_100k_level_6,
 
 #ifdef WUFFS_MIMIC
 
     bench_mimic_deflate_decode_1k,
+    bench_mimic_deflate_decode_1k_fixed_huff,
     bench_mimic_deflate_decode_10k,
+    bench_mimic_deflate_decode_25k_json,
     bench_mimic_deflate_decode_100k_just_one_read,
     bench_mimic_deflate_decode_100k_many_big_reads,
+    bench_mimic_deflate_decode_100k_1k_buffers,
+    bench_mimic_deflate_decode_100k_4k_buffers,
+    bench_mimic_deflate_decode_400k_stored,
+    bench_mimic_deflate_decode_400k_stored_many_big_writes,
+    bench_mimic_deflate_encode_10k_level_1,
+    bench_mimic_deflate_encode_10k_level_6,
+    bench_mimic_deflate_encode_100k_level_1,
+    bench_mimic_deflate_encode_100k_level_6,
 
 #endif  // WUFFS_MIMIC
 
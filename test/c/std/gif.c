@@ -1685,6 +1685,151 @@ test_wuffs_gif_frame_dirty_rect() {
   return NULL;
 }
 
+const char*  //
+do_test_wuffs_gif_frame_index(const char* filename,
+                              uint64_t want_num_frames,
+                              uint64_t wlimit,
+                              uint64_t rlimit) {
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = global_src_slice,
+  });
+  CHECK_STRING(read_file(&src, filename));
+  wuffs_base__io_buffer index = ((wuffs_base__io_buffer){
+      .data = global_have_slice,
+  });
+
+  wuffs_gif__decoder dec;
+  CHECK_STATUS("initialize",
+               wuffs_gif__decoder__initialize(
+                   &dec, sizeof dec, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  CHECK_STATUS("decode_image_config",
+               wuffs_gif__decoder__decode_image_config(&dec, NULL, &src));
+
+  while (true) {
+    wuffs_base__io_buffer limited_dst = make_limited_writer(index, wlimit);
+    wuffs_base__io_buffer limited_src = make_limited_reader(src, rlimit);
+    wuffs_base__status status = wuffs_gif__decoder__decode_frame_index(
+        &dec, &limited_dst, &limited_src);
+    index.meta.wi += limited_dst.meta.wi;
+    src.meta.ri += limited_src.meta.ri;
+
+    if (wuffs_base__status__is_ok(&status)) {
+      break;
+    } else if ((status.repr != wuffs_base__suspension__short_read) &&
+               (status.repr != wuffs_base__suspension__short_write)) {
+      RETURN_FAIL("decode_frame_index: \"%s\"", status.repr);
+    } else if ((limited_dst.meta.wi == 0) && (limited_src.meta.ri == 0)) {
+      RETURN_FAIL("decode_frame_index: no progress was made");
+    }
+  }
+
+  uint64_t have_num_frames =
+      index.meta.wi / WUFFS_GIF__FRAME_INDEX_ENTRY_LENGTH;
+  if ((have_num_frames != want_num_frames) ||
+      ((index.meta.wi % WUFFS_GIF__FRAME_INDEX_ENTRY_LENGTH) != 0)) {
+    RETURN_FAIL("index length: have %zu, want %" PRIu64, index.meta.wi,
+                want_num_frames * WUFFS_GIF__FRAME_INDEX_ENTRY_LENGTH);
+  }
+
+  // Compare each entry with what a second decoder's decode_frame_config calls
+  // give.
+  wuffs_gif__decoder dec2;
+  CHECK_STATUS("initialize",
+               wuffs_gif__decoder__initialize(
+                   &dec2, sizeof dec2, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  src.meta.ri = 0;
+  CHECK_STATUS("decode_image_config",
+               wuffs_gif__decoder__decode_image_config(&dec2, NULL, &src));
+  uint64_t i;
+  for (i = 0; i < want_num_frames; i++) {
+    wuffs_base__frame_config fc = ((wuffs_base__frame_config){});
+    CHECK_STATUS("decode_frame_config",
+                 wuffs_gif__decoder__decode_frame_config(&dec2, &fc, &src));
+
+    uint8_t* p = index.data.ptr + (i * WUFFS_GIF__FRAME_INDEX_ENTRY_LENGTH);
+    wuffs_base__rect_ie_u32 bounds = wuffs_base__frame_config__bounds(&fc);
+    uint8_t flags = 0;
+    if (src.data.ptr[src.meta.ri] & 0x80) {
+      flags |= WUFFS_GIF__FRAME_INDEX_FLAG_LOCAL_PALETTE;
+    }
+    if (wuffs_base__frame_config__opaque_within_bounds(&fc)) {
+      flags |= WUFFS_GIF__FRAME_INDEX_FLAG_OPAQUE_WITHIN_BOUNDS;
+    }
+
+    if (wuffs_base__load_u64le__no_bounds_check(p + 0) !=
+        wuffs_base__frame_config__io_position(&fc)) {
+      RETURN_FAIL("io_position #%" PRIu64 ": have %" PRIu64
+                  ", want %" PRIu64,
+                  i, wuffs_base__load_u64le__no_bounds_check(p + 0),
+                  wuffs_base__frame_config__io_position(&fc));
+    } else if ((wuffs_base__load_u16le__no_bounds_check(p + 8) !=
+                bounds.min_incl_x) ||
+               (wuffs_base__load_u16le__no_bounds_check(p + 10) !=
+                bounds.min_incl_y) ||
+               (wuffs_base__load_u16le__no_bounds_check(p + 12) !=
+                bounds.max_excl_x) ||
+               (wuffs_base__load_u16le__no_bounds_check(p + 14) !=
+                bounds.max_excl_y)) {
+      RETURN_FAIL("bounds #%" PRIu64 ": mismatch", i);
+    } else if (((uint64_t)wuffs_base__load_u16le__no_bounds_check(p + 16)) !=
+               (wuffs_base__frame_config__duration(&fc) /
+                (10 * WUFFS_BASE__FLICKS_PER_MILLISECOND))) {
+      RETURN_FAIL("duration #%" PRIu64 ": mismatch", i);
+    } else if (p[18] != wuffs_base__frame_config__disposal(&fc)) {
+      RETURN_FAIL("disposal #%" PRIu64 ": have %d, want %d", i, p[18],
+                  wuffs_base__frame_config__disposal(&fc));
+    } else if (p[19] != flags) {
+      RETURN_FAIL("flags #%" PRIu64 ": have 0x%02X, want 0x%02X", i, p[19],
+                  flags);
+    }
+  }
+
+  // Jump to each frame, last to first, via the index.
+  for (i = want_num_frames; i > 0;) {
+    i--;
+    uint8_t* p = index.data.ptr + (i * WUFFS_GIF__FRAME_INDEX_ENTRY_LENGTH);
+    uint64_t pos = wuffs_base__load_u64le__no_bounds_check(p);
+    src.meta.ri = pos;
+    CHECK_STATUS("restart_frame",
+                 wuffs_gif__decoder__restart_frame(&dec, i, pos));
+
+    wuffs_base__frame_config fc = ((wuffs_base__frame_config){});
+    CHECK_STATUS("decode_frame_config",
+                 wuffs_gif__decoder__decode_frame_config(&dec, &fc, &src));
+    if (wuffs_base__frame_config__index(&fc) != i) {
+      RETURN_FAIL("index: have %" PRIu64 ", want %" PRIu64,
+                  wuffs_base__frame_config__index(&fc), i);
+    }
+    if (wuffs_base__frame_config__io_position(&fc) != pos) {
+      RETURN_FAIL("io_position #%" PRIu64 ": have %" PRIu64 ", want %" PRIu64,
+                  i, wuffs_base__frame_config__io_position(&fc), pos);
+    }
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_gif_frame_index_animated_small() {
+  CHECK_FOCUS(__func__);
+  return do_test_wuffs_gif_frame_index("test/data/animated-red-blue.gif", 4,
+                                       UINT64_MAX, UINT64_MAX);
+}
+
+const char*  //
+test_wuffs_gif_frame_index_muybridge() {
+  CHECK_FOCUS(__func__);
+  return do_test_wuffs_gif_frame_index("test/data/muybridge.gif", 15,
+                                       UINT64_MAX, UINT64_MAX);
+}
+
+const char*  //
+test_wuffs_gif_frame_index_muybridge_many_small_reads_and_writes() {
+  CHECK_FOCUS(__func__);
+  return do_test_wuffs_gif_frame_index("test/data/muybridge.gif", 15, 25, 7);
+}
+
 const char* do_test_wuffs_gif_num_decoded(bool frame_config) {
   wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
       .data = global_src_slice,
@@ -1995,6 +2140,371 @@ test_wuffs_gif_sizeof() {
   return NULL;
 }
 
+// ---------------- GIF Encoder Tests
+
+const char*  //
+make_indexed_pixel_buffer(wuffs_base__pixel_buffer* pb,
+                          wuffs_base__slice_u8 pixbuf_memory,
+                          const char* palette_filename,
+                          const char* indexes_filename,
+                          uint32_t width,
+                          uint32_t height) {
+  wuffs_base__pixel_config pc = ((wuffs_base__pixel_config){});
+  wuffs_base__pixel_config__set(
+      &pc, WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_BINARY,
+      WUFFS_BASE__PIXEL_SUBSAMPLING__NONE, width, height);
+  CHECK_STATUS("set_from_slice",
+               wuffs_base__pixel_buffer__set_from_slice(pb, &pc, pixbuf_memory));
+
+  wuffs_base__io_buffer palette = ((wuffs_base__io_buffer){
+      .data = wuffs_base__pixel_buffer__palette(pb),
+  });
+  CHECK_STRING(read_file(&palette, palette_filename));
+  if (palette.meta.wi != 1024) {
+    RETURN_FAIL("palette length: have %zu, want 1024", palette.meta.wi);
+  }
+
+  // set_from_slice gives a stride equal to the width, so the indexes (one
+  // byte per pixel) are contiguous.
+  wuffs_base__table_u8 tab = wuffs_base__pixel_buffer__plane(pb, 0);
+  wuffs_base__io_buffer indexes = ((wuffs_base__io_buffer){
+      .data = wuffs_base__make_slice_u8(tab.ptr, tab.width * tab.height),
+  });
+  CHECK_STRING(read_file(&indexes, indexes_filename));
+  if (indexes.meta.wi != (tab.width * tab.height)) {
+    RETURN_FAIL("indexes length: have %zu, want %zu", indexes.meta.wi,
+                tab.width * tab.height);
+  }
+  return NULL;
+}
+
+const char*  //
+check_pixel_buffers_equal(wuffs_base__pixel_buffer* have,
+                          wuffs_base__pixel_buffer* want) {
+  // The encoder writes RGB color table entries, so compare the palettes'
+  // BGR bytes but not the alpha bytes.
+  wuffs_base__slice_u8 have_palette = wuffs_base__pixel_buffer__palette(have);
+  wuffs_base__slice_u8 want_palette = wuffs_base__pixel_buffer__palette(want);
+  if ((have_palette.len != 1024) || (want_palette.len != 1024)) {
+    RETURN_FAIL("palette length: have %zu and %zu, want 1024",
+                have_palette.len, want_palette.len);
+  }
+  size_t i;
+  for (i = 0; i < 1024; i++) {
+    if (((i & 3) != 3) && (have_palette.ptr[i] != want_palette.ptr[i])) {
+      RETURN_FAIL("palette byte #%zu: have 0x%02X, want 0x%02X", i,
+                  have_palette.ptr[i], want_palette.ptr[i]);
+    }
+  }
+
+  wuffs_base__table_u8 have_tab = wuffs_base__pixel_buffer__plane(have, 0);
+  wuffs_base__table_u8 want_tab = wuffs_base__pixel_buffer__plane(want, 0);
+  if ((have_tab.width != want_tab.width) ||
+      (have_tab.height != want_tab.height)) {
+    RETURN_FAIL("dimensions: have %zu×%zu, want %zu×%zu", have_tab.width,
+                have_tab.height, want_tab.width, want_tab.height);
+  }
+  size_t n = want_tab.width * want_tab.height;
+  wuffs_base__io_buffer have_indexes = ((wuffs_base__io_buffer){
+      .data = wuffs_base__make_slice_u8(have_tab.ptr, n),
+      .meta = wuffs_base__make_io_buffer_meta(n, 0, 0, true),
+  });
+  wuffs_base__io_buffer want_indexes = ((wuffs_base__io_buffer){
+      .data = wuffs_base__make_slice_u8(want_tab.ptr, n),
+      .meta = wuffs_base__make_io_buffer_meta(n, 0, 0, true),
+  });
+  return check_io_buffers_equal("indexes ", &have_indexes, &want_indexes);
+}
+
+const char*  //
+wuffs_gif_encode_frame(wuffs_gif__encoder* enc,
+                       wuffs_base__io_buffer* dst,
+                       wuffs_base__pixel_buffer* src,
+                       wuffs_base__flicks duration,
+                       uint64_t wlimit) {
+  while (true) {
+    wuffs_base__io_buffer limited_dst = make_limited_writer(*dst, wlimit);
+    wuffs_base__status status = wuffs_gif__encoder__encode_frame(
+        enc, &limited_dst, src, (uint64_t)duration);
+    dst->meta.wi += limited_dst.meta.wi;
+
+    if (wuffs_base__status__is_ok(&status)) {
+      return NULL;
+    } else if (status.repr != wuffs_base__suspension__short_write) {
+      RETURN_FAIL("encode_frame: have \"%s\", want \"%s\"", status.repr,
+                  wuffs_base__suspension__short_write);
+    } else if (limited_dst.meta.wi == 0) {
+      RETURN_FAIL("encode_frame: no progress was made");
+    }
+  }
+}
+
+const char*  //
+wuffs_gif_encode_trailer(wuffs_gif__encoder* enc,
+                         wuffs_base__io_buffer* dst,
+                         uint64_t wlimit) {
+  while (true) {
+    wuffs_base__io_buffer limited_dst = make_limited_writer(*dst, wlimit);
+    wuffs_base__status status =
+        wuffs_gif__encoder__encode_trailer(enc, &limited_dst);
+    dst->meta.wi += limited_dst.meta.wi;
+
+    if (wuffs_base__status__is_ok(&status)) {
+      return NULL;
+    } else if (status.repr != wuffs_base__suspension__short_write) {
+      RETURN_FAIL("encode_trailer: have \"%s\", want \"%s\"", status.repr,
+                  wuffs_base__suspension__short_write);
+    } else if (limited_dst.meta.wi == 0) {
+      RETURN_FAIL("encode_trailer: no progress was made");
+    }
+  }
+}
+
+const char*  //
+wuffs_gif_encode(wuffs_base__io_buffer* dst,
+                 uint32_t wuffs_initialize_flags,
+                 wuffs_base__pixel_buffer* src,
+                 uint64_t wlimit) {
+  wuffs_gif__encoder enc;
+  CHECK_STATUS("initialize",
+               wuffs_gif__encoder__initialize(&enc, sizeof enc, WUFFS_VERSION,
+                                              wuffs_initialize_flags));
+  CHECK_STRING(wuffs_gif_encode_frame(&enc, dst, src, 0, wlimit));
+  return wuffs_gif_encode_trailer(&enc, dst, wlimit);
+}
+
+const char*  //
+do_test_wuffs_gif_encode(const char* palette_filename,
+                         const char* indexes_filename,
+                         uint32_t width,
+                         uint32_t height,
+                         uint64_t wlimit,
+                         size_t want_encoded_len) {
+  wuffs_base__pixel_buffer want_pb = ((wuffs_base__pixel_buffer){});
+  CHECK_STRING(make_indexed_pixel_buffer(&want_pb, global_pixel_slice,
+                                         palette_filename, indexes_filename,
+                                         width, height));
+
+  wuffs_base__io_buffer encoded = ((wuffs_base__io_buffer){
+      .data = global_src_slice,
+  });
+  CHECK_STRING(wuffs_gif_encode(
+      &encoded, WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED,
+      &want_pb, wlimit));
+  if (encoded.meta.wi != want_encoded_len) {
+    RETURN_FAIL("encoded length: have %zu, want %zu", encoded.meta.wi,
+                want_encoded_len);
+  }
+  encoded.meta.closed = true;
+
+  wuffs_gif__decoder dec;
+  CHECK_STATUS("initialize",
+               wuffs_gif__decoder__initialize(
+                   &dec, sizeof dec, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+
+  wuffs_base__image_config ic = ((wuffs_base__image_config){});
+  CHECK_STATUS("decode_image_config",
+               wuffs_gif__decoder__decode_image_config(&dec, &ic, &encoded));
+  if (wuffs_gif__decoder__num_animation_loops(&dec) != 1) {
+    RETURN_FAIL("num_animation_loops: have %" PRIu32 ", want 1",
+                wuffs_gif__decoder__num_animation_loops(&dec));
+  }
+
+  wuffs_base__pixel_buffer have_pb = ((wuffs_base__pixel_buffer){});
+  CHECK_STATUS("set_from_slice", wuffs_base__pixel_buffer__set_from_slice(
+                                     &have_pb, &ic.pixcfg, global_have_slice));
+  CHECK_STATUS("decode_frame", wuffs_gif__decoder__decode_frame(
+                                   &dec, &have_pb, &encoded,
+                                   WUFFS_BASE__PIXEL_BLEND__SRC,
+                                   global_work_slice, NULL));
+  CHECK_STRING(check_pixel_buffers_equal(&have_pb, &want_pb));
+
+  wuffs_base__frame_config fc = ((wuffs_base__frame_config){});
+  wuffs_base__status status =
+      wuffs_gif__decoder__decode_frame_config(&dec, &fc, &encoded);
+  if (status.repr != wuffs_base__note__end_of_data) {
+    RETURN_FAIL("decode_frame_config: have \"%s\", want \"%s\"", status.repr,
+                wuffs_base__note__end_of_data);
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_gif_encode_animated() {
+  CHECK_FOCUS(__func__);
+
+  // Decode each frame of muybridge.gif, re-encode it and then decode the
+  // re-encoded frame. The original frames only cover the parts of the canvas
+  // that changed, but the encoder's frames cover the whole canvas, so compare
+  // the pixel buffers after each frame instead of the GIF files.
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = global_src_slice,
+  });
+  CHECK_STRING(read_file(&src, "test/data/muybridge.gif"));
+  wuffs_base__io_buffer encoded = ((wuffs_base__io_buffer){
+      .data = global_want_slice,
+  });
+
+  wuffs_gif__decoder src_dec;
+  CHECK_STATUS("initialize",
+               wuffs_gif__decoder__initialize(
+                   &src_dec, sizeof src_dec, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  wuffs_gif__encoder enc;
+  CHECK_STATUS("initialize",
+               wuffs_gif__encoder__initialize(
+                   &enc, sizeof enc, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  wuffs_gif__encoder__set_num_animation_loops(&enc, 3);
+  wuffs_gif__decoder dst_dec;
+  CHECK_STATUS("initialize",
+               wuffs_gif__decoder__initialize(
+                   &dst_dec, sizeof dst_dec, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+
+  wuffs_base__image_config ic = ((wuffs_base__image_config){});
+  CHECK_STATUS("decode_image_config",
+               wuffs_gif__decoder__decode_image_config(&src_dec, &ic, &src));
+  wuffs_base__pixel_buffer src_pb = ((wuffs_base__pixel_buffer){});
+  CHECK_STATUS("set_from_slice", wuffs_base__pixel_buffer__set_from_slice(
+                                     &src_pb, &ic.pixcfg, global_pixel_slice));
+  wuffs_base__pixel_buffer dst_pb = ((wuffs_base__pixel_buffer){});
+  CHECK_STATUS("set_from_slice", wuffs_base__pixel_buffer__set_from_slice(
+                                     &dst_pb, &ic.pixcfg, global_have_slice));
+
+  uint32_t num_frames = 0;
+  while (true) {
+    wuffs_base__frame_config src_fc = ((wuffs_base__frame_config){});
+    wuffs_base__status status =
+        wuffs_gif__decoder__decode_frame_config(&src_dec, &src_fc, &src);
+    if (status.repr == wuffs_base__note__end_of_data) {
+      break;
+    }
+    CHECK_STATUS("decode_frame_config #0", status);
+    CHECK_STATUS("decode_frame #0",
+                 wuffs_gif__decoder__decode_frame(
+                     &src_dec, &src_pb, &src, WUFFS_BASE__PIXEL_BLEND__SRC,
+                     global_work_slice, NULL));
+
+    CHECK_STRING(wuffs_gif_encode_frame(
+        &enc, &encoded, &src_pb, wuffs_base__frame_config__duration(&src_fc),
+        UINT64_MAX));
+
+    if (num_frames == 0) {
+      wuffs_base__image_config dst_ic = ((wuffs_base__image_config){});
+      CHECK_STATUS("decode_image_config", wuffs_gif__decoder__decode_image_config(
+                                              &dst_dec, &dst_ic, &encoded));
+    }
+    wuffs_base__frame_config dst_fc = ((wuffs_base__frame_config){});
+    CHECK_STATUS(
+        "decode_frame_config #1",
+        wuffs_gif__decoder__decode_frame_config(&dst_dec, &dst_fc, &encoded));
+    if (wuffs_base__frame_config__duration(&dst_fc) !=
+        wuffs_base__frame_config__duration(&src_fc)) {
+      RETURN_FAIL("duration: have %" PRIu64 ", want %" PRIu64,
+                  wuffs_base__frame_config__duration(&dst_fc),
+                  wuffs_base__frame_config__duration(&src_fc));
+    }
+    CHECK_STATUS("decode_frame #1",
+                 wuffs_gif__decoder__decode_frame(
+                     &dst_dec, &dst_pb, &encoded, WUFFS_BASE__PIXEL_BLEND__SRC,
+                     global_work_slice, NULL));
+    CHECK_STRING(check_pixel_buffers_equal(&dst_pb, &src_pb));
+    num_frames++;
+  }
+
+  if (num_frames != 15) {
+    RETURN_FAIL("num_frames: have %" PRIu32 ", want 15", num_frames);
+  }
+  CHECK_STRING(wuffs_gif_encode_trailer(&enc, &encoded, UINT64_MAX));
+  encoded.meta.closed = true;
+
+  wuffs_base__frame_config dst_fc = ((wuffs_base__frame_config){});
+  wuffs_base__status status =
+      wuffs_gif__decoder__decode_frame_config(&dst_dec, &dst_fc, &encoded);
+  if (status.repr != wuffs_base__note__end_of_data) {
+    RETURN_FAIL("decode_frame_config: have \"%s\", want \"%s\"", status.repr,
+                wuffs_base__note__end_of_data);
+  }
+  if (wuffs_gif__decoder__num_animation_loops(&dst_dec) != 3) {
+    RETURN_FAIL("num_animation_loops: have %" PRIu32 ", want 3",
+                wuffs_gif__decoder__num_animation_loops(&dst_dec));
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_gif_encode_bad_call_sequence() {
+  CHECK_FOCUS(__func__);
+  wuffs_gif__encoder enc;
+  CHECK_STATUS("initialize",
+               wuffs_gif__encoder__initialize(
+                   &enc, sizeof enc, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  wuffs_base__io_buffer have = ((wuffs_base__io_buffer){
+      .data = global_have_slice,
+  });
+  wuffs_base__status status = wuffs_gif__encoder__encode_trailer(&enc, &have);
+  if (status.repr != wuffs_base__error__bad_call_sequence) {
+    RETURN_FAIL("encode_trailer: have \"%s\", want \"%s\"", status.repr,
+                wuffs_base__error__bad_call_sequence);
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_gif_encode_unsupported_pixel_format() {
+  CHECK_FOCUS(__func__);
+  wuffs_gif__encoder enc;
+  CHECK_STATUS("initialize",
+               wuffs_gif__encoder__initialize(
+                   &enc, sizeof enc, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+
+  wuffs_base__pixel_config pc = ((wuffs_base__pixel_config){});
+  wuffs_base__pixel_config__set(&pc, WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL,
+                                WUFFS_BASE__PIXEL_SUBSAMPLING__NONE, 4, 4);
+  wuffs_base__pixel_buffer pb = ((wuffs_base__pixel_buffer){});
+  CHECK_STATUS("set_from_slice", wuffs_base__pixel_buffer__set_from_slice(
+                                     &pb, &pc, global_pixel_slice));
+
+  wuffs_base__io_buffer have = ((wuffs_base__io_buffer){
+      .data = global_have_slice,
+  });
+  wuffs_base__status status =
+      wuffs_gif__encoder__encode_frame(&enc, &have, &pb, 0);
+  if (status.repr != wuffs_gif__error__unsupported_pixel_format) {
+    RETURN_FAIL("encode_frame: have \"%s\", want \"%s\"", status.repr,
+                wuffs_gif__error__unsupported_pixel_format);
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_gif_encode_bricks_dither() {
+  CHECK_FOCUS(__func__);
+  return do_test_wuffs_gif_encode("test/data/bricks-dither.palette",
+                                  "test/data/bricks-dither.indexes", 160, 120,
+                                  UINT64_MAX, 15783);
+}
+
+const char*  //
+test_wuffs_gif_encode_bricks_nodither() {
+  CHECK_FOCUS(__func__);
+  return do_test_wuffs_gif_encode("test/data/bricks-nodither.palette",
+                                  "test/data/bricks-nodither.indexes", 160,
+                                  120, UINT64_MAX, 14248);
+}
+
+const char*  //
+test_wuffs_gif_encode_many_small_writes() {
+  CHECK_FOCUS(__func__);
+  return do_test_wuffs_gif_encode("test/data/bricks-nodither.palette",
+                                  "test/data/bricks-nodither.indexes", 160,
+                                  120, 7, 14248);
+}
+
   // ---------------- Mimic Tests
 
 #ifdef WUFFS_MIMIC
@@ -2266,6 +2776,51 @@ bench_wuffs_gif_decode_anim_screencap() {
       1);
 }
 
+const char*  //
+do_bench_gif_encode(const char* palette_filename,
+                    const char* indexes_filename,
+                    uint32_t width,
+                    uint32_t height,
+                    uint64_t iters_unscaled) {
+  wuffs_base__pixel_buffer pb = ((wuffs_base__pixel_buffer){});
+  CHECK_STRING(make_indexed_pixel_buffer(&pb, global_pixel_slice,
+                                         palette_filename, indexes_filename,
+                                         width, height));
+  wuffs_base__io_buffer have = ((wuffs_base__io_buffer){
+      .data = global_have_slice,
+  });
+
+  // Count the source pixel bytes, as for other encoders' benchmarks.
+  bench_start();
+  uint64_t n_bytes = 0;
+  uint64_t i;
+  uint64_t iters = iters_unscaled * flags.iterscale;
+  for (i = 0; i < iters; i++) {
+    have.meta.wi = 0;
+    CHECK_STRING(wuffs_gif_encode(
+        &have, WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED, &pb,
+        UINT64_MAX));
+    n_bytes += ((uint64_t)width) * ((uint64_t)height);
+  }
+  bench_finish(iters, n_bytes);
+  return NULL;
+}
+
+const char*  //
+bench_wuffs_gif_encode_20k_dither() {
+  CHECK_FOCUS(__func__);
+  return do_bench_gif_encode("test/data/bricks-dither.palette",
+                             "test/data/bricks-dither.indexes", 160, 120, 50);
+}
+
+const char*  //
+bench_wuffs_gif_encode_20k_nodither() {
+  CHECK_FOCUS(__func__);
+  return do_bench_gif_encode("test/data/bricks-nodither.palette",
+                             "test/data/bricks-nodither.indexes", 160, 120,
+                             50);
+}
+
   // ---------------- Mimic Benches
 
 #ifdef WUFFS_MIMIC
@@ -2399,7 +2954,16 @@ proc tests[] = {
     test_wuffs_gif_decode_pixfmt_rgb,
     test_wuffs_gif_decode_pixfmt_rgba_nonpremul,
     test_wuffs_gif_decode_zero_width_frame,
+    test_wuffs_gif_encode_animated,
+    test_wuffs_gif_encode_bad_call_sequence,
+    test_wuffs_gif_encode_bricks_dither,
+    test_wuffs_gif_encode_bricks_nodither,
+    test_wuffs_gif_encode_many_small_writes,
+    test_wuffs_gif_encode_unsupported_pixel_format,
     test_wuffs_gif_frame_dirty_rect,
+    test_wuffs_gif_frame_index_animated_small,
+    test_wuffs_gif_frame_index_muybridge,
+    test_wuffs_gif_frame_index_muybridge_many_small_reads_and_writes,
     test_wuffs_gif_num_decoded_frame_configs,
     test_wuffs_gif_num_decoded_frames,
     test_wuffs_gif_io_position_one_chunk,
@@ -2441,6 +3005,8 @@ proc benches[] = {
     bench_wuffs_gif_decode_1000k_full_init,
     bench_wuffs_gif_decode_1000k_part_init,
     bench_wuffs_gif_decode_anim_screencap,
+    bench_wuffs_gif_encode_20k_dither,
+    bench_wuffs_gif_encode_20k_nodither,
 
 #ifdef WUFFS_MIMIC
 
@@ -81,8 +81,199 @@ golden_test gzip_pi_gt = {
     .src_filename = "test/data/pi.txt.gz",
 };
 
+// The gzip_encode_etc_gt golden tests have no want_filename, as there is more
+// than one valid gzip encoding of any given src. They are used to benchmark
+// the encoders.
+
+golden_test gzip_encode_midsummer_gt = {
+    .src_filename = "test/data/midsummer.txt",
+};
+
+golden_test gzip_encode_pi_gt = {
+    .src_filename = "test/data/pi.txt",
+};
+
+// This is a short message, like those sent by an RPC (Remote Procedure Call)
+// system, gzip-encoded with a dynamic Huffman block.
+const char* gzip_rpc_src_ptr =
+    "\x1f\x8b\x08\x00\x00\x00\x00\x00\x00\x03\x1d\xca\x3b\x0e\x80\x20\x10\x04"
+    "\xd0\xde\x63\x4c\x4d\x0c\x18\x2d\xe4\x2a\xc6\x62\x23\xab\x90\xf0\x31\x8a"
+    "\x95\xf1\xee\xae\x4e\x37\xf3\xe6\x46\x70\xb0\x46\xf7\x9d\x42\xe2\xea\x8b"
+    "\x34\x5c\x27\x1f\xed\xc6\x15\x0a\x3b\x1d\x94\x4e\xd8\x1b\x99\x12\x8b\x51"
+    "\x0c\x0b\x0b\xac\x81\xa3\x13\x98\xc0\x89\x42\xfc\xae\xbe\x64\xc6\xfc\x28"
+    "\x54\xd9\xcd\x30\x76\xfa\x4f\xf3\x02\xb9\x10\xce\xb0\x64\x00\x00\x00";
+const size_t gzip_rpc_src_len = 107;
+const char* gzip_rpc_want_ptr =
+    "{\"id\":1042,\"method\":\"user.get\",\"params\":{\"name\":\"alice\","
+    "\"fields\":[\"email\",\"phone\"]},\"ts\":1592000000\n";
+const size_t gzip_rpc_want_len = 100;
+
 // ---------------- Gzip Tests
 
+const char*  //
+test_wuffs_gzip_decode_bgzf() {
+  CHECK_FOCUS(__func__);
+
+  wuffs_base__io_buffer have = ((wuffs_base__io_buffer){
+      .data = global_have_slice,
+  });
+  wuffs_base__io_buffer want = ((wuffs_base__io_buffer){
+      .data = global_want_slice,
+  });
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = global_src_slice,
+  });
+
+  // Re-wrap romeo.txt.gz's DEFLATE data (bytes 20 ..= 549) as a BGZF member,
+  // whose header's FEXTRA field holds a BSIZE subfield, and then append the
+  // 28 byte BGZF end-of-file marker: an empty BGZF member.
+  CHECK_STRING(read_file(&want, "test/data/romeo.txt"));
+  CHECK_STRING(read_file(&src, "test/data/romeo.txt.gz"));
+  if (src.meta.wi != 558) {
+    RETURN_FAIL("src.meta.wi: have %zu, want 558", src.meta.wi);
+  }
+  const uint8_t header[18] = {
+      0x1F, 0x8B, 0x08, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00,
+      0xFF, 0x06, 0x00, 0x42, 0x43, 0x02, 0x00, 0x2B, 0x02,
+  };
+  const uint8_t eof_marker[28] = {
+      0x1F, 0x8B, 0x08, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF,
+      0x06, 0x00, 0x42, 0x43, 0x02, 0x00, 0x1B, 0x00, 0x03, 0x00,
+      0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  };
+  memmove(src.data.ptr + 18, src.data.ptr + 20, 538);
+  memcpy(src.data.ptr, header, 18);
+  memcpy(src.data.ptr + 556, eof_marker, 28);
+  src.meta.wi = 584;
+
+  int i;
+  for (i = 0; i < 2; i++) {
+    wuffs_gzip__decoder dec;
+    CHECK_STATUS("initialize",
+                 wuffs_gzip__decoder__initialize(
+                     &dec, sizeof dec, WUFFS_VERSION,
+                     WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+    wuffs_gzip__decoder__set_decode_concatenated_members(&dec, i > 0);
+    have.meta.wi = 0;
+    src.meta.ri = 0;
+    CHECK_STATUS("transform_io",
+                 wuffs_gzip__decoder__transform_io(&dec, &have, &src,
+                                                   global_work_slice));
+
+    // The BGZF block size is BSIZE + 1.
+    uint32_t have_size = wuffs_gzip__decoder__bgzf_block_size(&dec);
+    uint32_t want_size = (i > 0) ? 28 : 556;
+    if (have_size != want_size) {
+      RETURN_FAIL("i=%d: bgzf_block_size: have %" PRIu32 ", want %" PRIu32, i,
+                  have_size, want_size);
+    } else if (src.meta.ri != want_size + (i > 0 ? 556 : 0)) {
+      RETURN_FAIL("i=%d: src.meta.ri: have %zu", i, src.meta.ri);
+    }
+    CHECK_STRING(check_io_buffers_equal("", &have, &want));
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_gzip_decode_concatenated_members() {
+  CHECK_FOCUS(__func__);
+
+  wuffs_base__io_buffer have = ((wuffs_base__io_buffer){
+      .data = global_have_slice,
+  });
+  wuffs_base__io_buffer want = ((wuffs_base__io_buffer){
+      .data = global_want_slice,
+  });
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = global_src_slice,
+  });
+
+  // Concatenate two gzip files, and their decodings.
+  CHECK_STRING(read_file(&src, gzip_midsummer_gt.src_filename));
+  CHECK_STRING(read_file(&want, gzip_midsummer_gt.want_filename));
+  const size_t src_len0 = src.meta.wi;
+  const size_t want_len0 = want.meta.wi;
+  src.meta.closed = false;
+  want.meta.closed = false;
+  CHECK_STRING(read_file(&src, gzip_pi_gt.src_filename));
+  CHECK_STRING(read_file(&want, gzip_pi_gt.want_filename));
+
+  int i;
+  for (i = 0; i < 2; i++) {
+    wuffs_gzip__decoder dec;
+    CHECK_STATUS("initialize",
+                 wuffs_gzip__decoder__initialize(
+                     &dec, sizeof dec, WUFFS_VERSION,
+                     WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+    wuffs_gzip__decoder__set_decode_concatenated_members(&dec, i > 0);
+    have.meta.wi = 0;
+    src.meta.ri = 0;
+
+    // Use a small rlimit, so that transform_io suspends around the boundary
+    // between the two members.
+    while (true) {
+      wuffs_base__io_buffer limited_src = make_limited_reader(src, 97);
+      wuffs_base__status status = wuffs_gzip__decoder__transform_io(
+          &dec, &have, &limited_src, global_work_slice);
+      src.meta.ri += limited_src.meta.ri;
+      if (status.repr != wuffs_base__suspension__short_read) {
+        CHECK_STATUS("transform_io", status);
+        break;
+      }
+    }
+
+    size_t want_src_ri = (i > 0) ? src.meta.wi : src_len0;
+    size_t want_have_wi = (i > 0) ? want.meta.wi : want_len0;
+    if (src.meta.ri != want_src_ri) {
+      RETURN_FAIL("i=%d: src.meta.ri: have %zu, want %zu", i, src.meta.ri,
+                  want_src_ri);
+    } else if (have.meta.wi != want_have_wi) {
+      RETURN_FAIL("i=%d: have.meta.wi: have %zu, want %zu", i, have.meta.wi,
+                  want_have_wi);
+    }
+    wuffs_base__io_buffer want_prefix = want;
+    want_prefix.meta.wi = want_have_wi;
+    CHECK_STRING(check_io_buffers_equal("", &have, &want_prefix));
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_gzip_decode_concatenated_members_back_reference() {
+  CHECK_FOCUS(__func__);
+
+  // Two members. The first decodes to "a". The second's DEFLATE data is a
+  // length 3, distance 1 back-reference, reaching into the first member's
+  // output. Its trailer holds the CRC-32 and length of "aaa".
+  const char* src_ptr =
+      "\x1F\x8B\x08\x00\x00\x00\x00\x00\x02\x03\x4B\x04\x00\x43"
+      "\xBE\xB7\xE8\x01\x00\x00\x00"
+      "\x1F\x8B\x08\x00\x00\x00\x00\x00\x00\xFF\x03\x02\x00\x2D"
+      "\x73\x07\xF0\x03\x00\x00\x00";
+  wuffs_base__io_buffer src = make_io_buffer_from_string(src_ptr, 42);
+  wuffs_base__io_buffer have = ((wuffs_base__io_buffer){
+      .data = global_have_slice,
+  });
+
+  // Even when dst holds the whole output, each member is its own DEFLATE
+  // stream, with no history.
+  wuffs_gzip__decoder dec;
+  CHECK_STATUS("initialize",
+               wuffs_gzip__decoder__initialize(
+                   &dec, sizeof dec, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  wuffs_gzip__decoder__set_whole_output_in_dst(&dec, true);
+  wuffs_gzip__decoder__set_decode_concatenated_members(&dec, true);
+
+  wuffs_base__status status = wuffs_gzip__decoder__transform_io(
+      &dec, &have, &src, global_work_slice);
+  if (status.repr != wuffs_deflate__error__bad_distance) {
+    RETURN_FAIL("transform_io: have \"%s\", want \"%s\"", status.repr,
+                wuffs_deflate__error__bad_distance);
+  }
+  return NULL;
+}
+
 const char*  //
 test_wuffs_gzip_decode_interface() {
   CHECK_FOCUS(__func__);
@@ -229,6 +420,199 @@ test_wuffs_gzip_decode_pi() {
                             UINT64_MAX);
 }
 
+const char*  //
+test_wuffs_gzip_decode_reset() {
+  CHECK_FOCUS(__func__);
+  wuffs_base__io_buffer want =
+      make_io_buffer_from_string(gzip_rpc_want_ptr, gzip_rpc_want_len);
+
+  wuffs_gzip__decoder dec;
+  CHECK_STATUS("initialize", wuffs_gzip__decoder__initialize(
+                                 &dec, sizeof dec, WUFFS_VERSION,
+                                 WUFFS_INITIALIZE__DEFAULT_OPTIONS));
+
+  // For i == 0, decode the message from a fresh decoder. For i == 1, reset a
+  // decoder that was suspended mid-stream. For i == 2, reset a decoder that
+  // was disabled by an error. For i == 3, check that reset kept the
+  // set_ignore_checksum setting.
+  int i;
+  for (i = 0; i < 4; i++) {
+    wuffs_base__io_buffer have = ((wuffs_base__io_buffer){
+        .data = global_have_slice,
+    });
+    wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+        .data = global_src_slice,
+    });
+    memcpy(src.data.ptr, gzip_rpc_src_ptr, gzip_rpc_src_len);
+    src.meta.wi = gzip_rpc_src_len;
+    src.meta.closed = true;
+
+    if (i == 1) {
+      src.meta.wi = 40;
+      src.meta.closed = false;
+      wuffs_base__status status = wuffs_gzip__decoder__transform_io(
+          &dec, &have, &src, global_work_slice);
+      if (status.repr != wuffs_base__suspension__short_read) {
+        RETURN_FAIL("i=%d: transform_io (partial): have \"%s\", want \"%s\"",
+                    i, status.repr, wuffs_base__suspension__short_read);
+      }
+      wuffs_gzip__decoder__reset(&dec);
+      have.meta.wi = 0;
+      src.meta.ri = 0;
+      src.meta.wi = gzip_rpc_src_len;
+      src.meta.closed = true;
+
+    } else if (i == 2) {
+      src.data.ptr[0] ^= 0x01;
+      int j;
+      for (j = 0; j < 2; j++) {
+        const char* want_status =
+            (j == 0) ? wuffs_gzip__error__bad_header
+                     : wuffs_base__error__disabled_by_previous_error;
+        wuffs_base__status status = wuffs_gzip__decoder__transform_io(
+            &dec, &have, &src, global_work_slice);
+        if (status.repr != want_status) {
+          RETURN_FAIL("i=%d, j=%d: transform_io: have \"%s\", want \"%s\"", i,
+                      j, status.repr, want_status);
+        }
+      }
+      wuffs_gzip__decoder__reset(&dec);
+      src.data.ptr[0] ^= 0x01;
+      src.meta.ri = 0;
+
+    } else if (i == 3) {
+      wuffs_gzip__decoder__set_ignore_checksum(&dec, true);
+      wuffs_gzip__decoder__reset(&dec);
+      src.data.ptr[gzip_rpc_src_len - 8] ^= 0xFF;
+    }
+
+    wuffs_base__status status =
+        wuffs_gzip__decoder__transform_io(&dec, &have, &src, global_work_slice);
+    if (!wuffs_base__status__is_ok(&status)) {
+      RETURN_FAIL("i=%d: transform_io: \"%s\"", i, status.repr);
+    }
+    char prefix[16];
+    snprintf(prefix, 16, "i=%d: ", i);
+    CHECK_STRING(check_io_buffers_equal(prefix, &have, &want));
+    wuffs_gzip__decoder__reset(&dec);
+  }
+  return NULL;
+}
+
+const char*  //
+wuffs_gzip_encode(wuffs_base__io_buffer* dst,
+                  wuffs_base__io_buffer* src,
+                  uint32_t wuffs_initialize_flags,
+                  uint64_t wlimit,
+                  uint64_t rlimit) {
+  wuffs_gzip__encoder enc;
+  CHECK_STATUS("initialize",
+               wuffs_gzip__encoder__initialize(&enc, sizeof enc, WUFFS_VERSION,
+                                               wuffs_initialize_flags));
+
+  while (true) {
+    wuffs_base__io_buffer limited_dst = make_limited_writer(*dst, wlimit);
+    wuffs_base__io_buffer limited_src = make_limited_reader(*src, rlimit);
+
+    wuffs_base__status status = wuffs_gzip__encoder__transform_io(
+        &enc, &limited_dst, &limited_src, global_work_slice);
+
+    dst->meta.wi += limited_dst.meta.wi;
+    src->meta.ri += limited_src.meta.ri;
+
+    if (((wlimit < UINT64_MAX) &&
+         (status.repr == wuffs_base__suspension__short_write)) ||
+        ((rlimit < UINT64_MAX) &&
+         (status.repr == wuffs_base__suspension__short_read))) {
+      continue;
+    }
+    return status.repr;
+  }
+}
+
+const char*  //
+test_wuffs_gzip_encode_interface() {
+  CHECK_FOCUS(__func__);
+  wuffs_gzip__encoder enc;
+  CHECK_STATUS("initialize",
+               wuffs_gzip__encoder__initialize(
+                   &enc, sizeof enc, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  return do_test__wuffs_base__io_transformer(
+      wuffs_gzip__encoder__upcast_as__wuffs_base__io_transformer(&enc),
+      "test/data/romeo.txt", 0, SIZE_MAX, 547, 0x00);
+}
+
+const char*  //
+test_wuffs_gzip_encode_round_trip() {
+  CHECK_FOCUS(__func__);
+
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = global_src_slice,
+  });
+  wuffs_base__io_buffer encoded = ((wuffs_base__io_buffer){
+      .data = global_want_slice,
+  });
+  wuffs_base__io_buffer have = ((wuffs_base__io_buffer){
+      .data = global_have_slice,
+  });
+
+  const char* filenames[2] = {
+      "test/data/midsummer.txt",
+      "test/data/pi.txt",
+  };
+  const uint64_t limits[2] = {UINT64_MAX, 61};
+  int f;
+  for (f = 0; f < 2; f++) {
+    src.meta.wi = 0;
+    src.meta.ri = 0;
+    src.meta.closed = false;
+    CHECK_STRING(read_file(&src, filenames[f]));
+    int w;
+    for (w = 0; w < 2; w++) {
+      int r;
+      for (r = 0; r < 2; r++) {
+        char prefix[64];
+        snprintf(prefix, 64, "f=%d, w=%d, r=%d: ", f, w, r);
+        src.meta.ri = 0;
+        encoded.meta.wi = 0;
+        encoded.meta.ri = 0;
+        encoded.meta.closed = false;
+        have.meta.wi = 0;
+
+        const char* status = wuffs_gzip_encode(
+            &encoded, &src,
+            WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED, limits[w],
+            limits[r]);
+        if (status) {
+          RETURN_FAIL("%sencode: %s", prefix, status);
+        } else if (encoded.meta.wi < 18) {
+          RETURN_FAIL("%sencoded length: have %zu", prefix, encoded.meta.wi);
+        }
+
+        // Check the header's magic bytes, CM, FLG, XFL and OS fields.
+        uint8_t* e = encoded.data.ptr;
+        if ((e[0] != 0x1F) || (e[1] != 0x8B) || (e[2] != 0x08) ||
+            (e[3] != 0x00) || (e[8] != 0x00) || (e[9] != 0xFF)) {
+          RETURN_FAIL("%sbad header", prefix);
+        }
+
+        encoded.meta.closed = true;
+        status = wuffs_gzip_decode(
+            &have, &encoded,
+            WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED, UINT64_MAX,
+            UINT64_MAX);
+        if (status) {
+          RETURN_FAIL("%sdecode: %s", prefix, status);
+        }
+        src.meta.ri = 0;
+        CHECK_STRING(check_io_buffers_equal(prefix, &have, &src));
+      }
+    }
+  }
+  return NULL;
+}
+
   // ---------------- Mimic Tests
 
 #ifdef WUFFS_MIMIC
@@ -251,6 +635,64 @@ test_mimic_gzip_decode_pi() {
 
 // ---------------- Gzip Benches
 
+const char*  //
+do_bench_wuffs_gzip_decode_rpc(uint32_t wuffs_initialize_flags,
+                               bool reset,
+                               uint64_t iters_unscaled) {
+  wuffs_base__io_buffer have = ((wuffs_base__io_buffer){
+      .data = global_have_slice,
+  });
+  wuffs_base__io_buffer src =
+      make_io_buffer_from_string(gzip_rpc_src_ptr, gzip_rpc_src_len);
+
+  wuffs_gzip__decoder dec;
+  CHECK_STATUS("initialize",
+               wuffs_gzip__decoder__initialize(&dec, sizeof dec, WUFFS_VERSION,
+                                               wuffs_initialize_flags));
+
+  bench_start();
+  uint64_t n_bytes = 0;
+  uint64_t i;
+  uint64_t iters = iters_unscaled * flags.iterscale;
+  for (i = 0; i < iters; i++) {
+    have.meta.wi = 0;
+    src.meta.ri = 0;
+    if (reset) {
+      wuffs_gzip__decoder__reset(&dec);
+    } else {
+      CHECK_STATUS("initialize", wuffs_gzip__decoder__initialize(
+                                     &dec, sizeof dec, WUFFS_VERSION,
+                                     wuffs_initialize_flags));
+    }
+    CHECK_STATUS("transform_io", wuffs_gzip__decoder__transform_io(
+                                     &dec, &have, &src, global_work_slice));
+    n_bytes += have.meta.wi;
+  }
+  bench_finish(iters, n_bytes);
+  return NULL;
+}
+
+const char*  //
+bench_wuffs_gzip_decode_100b_full_init() {
+  CHECK_FOCUS(__func__);
+  return do_bench_wuffs_gzip_decode_rpc(WUFFS_INITIALIZE__DEFAULT_OPTIONS,
+                                        false, 2000);
+}
+
+const char*  //
+bench_wuffs_gzip_decode_100b_part_init() {
+  CHECK_FOCUS(__func__);
+  return do_bench_wuffs_gzip_decode_rpc(
+      WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED, false, 2000);
+}
+
+const char*  //
+bench_wuffs_gzip_decode_100b_reset() {
+  CHECK_FOCUS(__func__);
+  return do_bench_wuffs_gzip_decode_rpc(WUFFS_INITIALIZE__DEFAULT_OPTIONS,
+                                        true, 2000);
+}
+
 const char*  //
 bench_wuffs_gzip_decode_10k() {
   CHECK_FOCUS(__func__);
@@ -267,10 +709,35 @@ bench_wuffs_gzip_decode_100k() {
       tcounter_dst, &gzip_pi_gt, UINT64_MAX, UINT64_MAX, 30);
 }
 
+const char*  //
+bench_wuffs_gzip_encode_10k() {
+  CHECK_FOCUS(__func__);
+  return do_bench_io_buffers(
+      wuffs_gzip_encode, WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED,
+      tcounter_src, &gzip_encode_midsummer_gt, UINT64_MAX, UINT64_MAX, 30);
+}
+
+const char*  //
+bench_wuffs_gzip_encode_100k() {
+  CHECK_FOCUS(__func__);
+  return do_bench_io_buffers(
+      wuffs_gzip_encode, WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED,
+      tcounter_src, &gzip_encode_pi_gt, UINT64_MAX, UINT64_MAX, 3);
+}
+
   // ---------------- Mimic Benches
 
 #ifdef WUFFS_MIMIC
 
+const char*  //
+mimic_gzip_encode_default_level(wuffs_base__io_buffer* dst,
+                                wuffs_base__io_buffer* src,
+                                uint32_t wuffs_initialize_flags,
+                                uint64_t wlimit,
+                                uint64_t rlimit) {
+  return mimic_gzip_encode(dst, src, 6, wlimit, rlimit);
+}
+
 const char*  //
 bench_mimic_gzip_decode_10k() {
   CHECK_FOCUS(__func__);
@@ -285,6 +752,21 @@ bench_mimic_gzip_decode_100k() {
                              UINT64_MAX, UINT64_MAX, 30);
 }
 
+const char*  //
+bench_mimic_gzip_encode_10k() {
+  CHECK_FOCUS(__func__);
+  return do_bench_io_buffers(mimic_gzip_encode_default_level, 0, tcounter_src,
+                             &gzip_encode_midsummer_gt, UINT64_MAX, UINT64_MAX,
+                             30);
+}
+
+const char*  //
+bench_mimic_gzip_encode_100k() {
+  CHECK_FOCUS(__func__);
+  return do_bench_io_buffers(mimic_gzip_encode_default_level, 0, tcounter_src,
+                             &gzip_encode_pi_gt, UINT64_MAX, UINT64_MAX, 3);
+}
+
 #endif  // WUFFS_MIMIC
 
 // ---------------- Manifest
@@ -298,9 +780,15 @@ proc tests[] = {
     test_wuffs_gzip_checksum_verify_bad0,
     test_wuffs_gzip_checksum_verify_bad7,
     test_wuffs_gzip_checksum_verify_good,
+    test_wuffs_gzip_decode_bgzf,
+    test_wuffs_gzip_decode_concatenated_members,
+    test_wuffs_gzip_decode_concatenated_members_back_reference,
     test_wuffs_gzip_decode_interface,
     test_wuffs_gzip_decode_midsummer,
     test_wuffs_gzip_decode_pi,
+    test_wuffs_gzip_decode_reset,
+    test_wuffs_gzip_encode_interface,
+    test_wuffs_gzip_encode_round_trip,
 
 #ifdef WUFFS_MIMIC
 
@@ -314,13 +802,20 @@ proc tests[] = {
 
 proc benches[] = {
 
+    bench_wuffs_gzip_decode_100b_full_init,
+    bench_wuffs_gzip_decode_100b_part_init,
+    bench_wuffs_gzip_decode_100b_reset,
     bench_wuffs_gzip_decode_10k,
     bench_wuffs_gzip_decode_100k,
+    bench_wuffs_gzip_encode_10k,
+    bench_wuffs_gzip_encode_100k,
 
 #ifdef WUFFS_MIMIC
 
     bench_mimic_gzip_decode_10k,
     bench_mimic_gzip_decode_100k,
+    bench_mimic_gzip_encode_10k,
+    bench_mimic_gzip_encode_100k,
 
 #endif  // WUFFS_MIMIC
 
@@ -382,6 +382,253 @@ test_wuffs_lzw_decode_width_1() {
   return do_test_wuffs_lzw_decode_width(1, src, want);
 }
 
+const char*  //
+wuffs_lzw_encode_width(wuffs_base__io_buffer* dst,
+                       wuffs_base__io_buffer* src,
+                       uint32_t wuffs_initialize_flags,
+                       uint32_t literal_width,
+                       uint64_t wlimit,
+                       uint64_t rlimit) {
+  wuffs_lzw__encoder enc;
+  CHECK_STATUS("initialize",
+               wuffs_lzw__encoder__initialize(
+                   &enc, sizeof enc, WUFFS_VERSION, wuffs_initialize_flags));
+  wuffs_lzw__encoder__set_literal_width(&enc, literal_width);
+
+  while (true) {
+    wuffs_base__io_buffer limited_dst = make_limited_writer(*dst, wlimit);
+    wuffs_base__io_buffer limited_src = make_limited_reader(*src, rlimit);
+
+    wuffs_base__status status = wuffs_lzw__encoder__transform_io(
+        &enc, &limited_dst, &limited_src, global_work_slice);
+
+    dst->meta.wi += limited_dst.meta.wi;
+    src->meta.ri += limited_src.meta.ri;
+
+    if (((wlimit < UINT64_MAX) &&
+         (status.repr == wuffs_base__suspension__short_write)) ||
+        ((rlimit < UINT64_MAX) &&
+         (status.repr == wuffs_base__suspension__short_read))) {
+      continue;
+    }
+    return status.repr;
+  }
+}
+
+const char*  //
+wuffs_lzw_encode(wuffs_base__io_buffer* dst,
+                 wuffs_base__io_buffer* src,
+                 uint32_t wuffs_initialize_flags,
+                 uint64_t wlimit,
+                 uint64_t rlimit) {
+  return wuffs_lzw_encode_width(dst, src, wuffs_initialize_flags, 8, wlimit,
+                                rlimit);
+}
+
+// do_test_wuffs_lzw_encode_round_trip encodes the src_filename file's
+// contents, with each byte masked to the literal width, checks the encoded
+// length (if want_encoded_len is non-zero) and then checks that decoding that
+// encoding gives back the (masked) original contents.
+const char*  //
+do_test_wuffs_lzw_encode_round_trip(const char* prefix,
+                                    const char* src_filename,
+                                    uint32_t literal_width,
+                                    uint64_t wlimit,
+                                    uint64_t rlimit,
+                                    size_t want_encoded_len) {
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = global_src_slice,
+  });
+  wuffs_base__io_buffer encoded = ((wuffs_base__io_buffer){
+      .data = global_want_slice,
+  });
+  wuffs_base__io_buffer have = ((wuffs_base__io_buffer){
+      .data = global_have_slice,
+  });
+
+  if (src_filename) {
+    CHECK_STRING(read_file(&src, src_filename));
+  } else {
+    src.meta.closed = true;
+  }
+  size_t i;
+  for (i = 0; i < src.meta.wi; i++) {
+    src.data.ptr[i] &= (uint8_t)((1 << literal_width) - 1);
+  }
+
+  const char* status = wuffs_lzw_encode_width(
+      &encoded, &src, WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED,
+      literal_width, wlimit, rlimit);
+  if (status) {
+    RETURN_FAIL("%sencode: %s", prefix, status);
+  }
+  if (src.meta.ri != src.meta.wi) {
+    RETURN_FAIL("%ssrc ri: have %zu, want %zu", prefix, src.meta.ri,
+                src.meta.wi);
+  }
+  if (want_encoded_len && (encoded.meta.wi != want_encoded_len)) {
+    RETURN_FAIL("%sencoded length: have %zu, want %zu", prefix,
+                encoded.meta.wi, want_encoded_len);
+  }
+
+  wuffs_lzw__decoder dec;
+  CHECK_STATUS("initialize",
+               wuffs_lzw__decoder__initialize(
+                   &dec, sizeof dec, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  wuffs_lzw__decoder__set_literal_width(&dec, literal_width);
+  encoded.meta.closed = true;
+  wuffs_base__status dec_status = wuffs_lzw__decoder__transform_io(
+      &dec, &have, &encoded, global_work_slice);
+  if (!wuffs_base__status__is_ok(&dec_status)) {
+    RETURN_FAIL("%sdecode: %s", prefix, dec_status.repr);
+  }
+  src.meta.ri = 0;
+  return check_io_buffers_equal(prefix, &have, &src);
+}
+
+const char*  //
+test_wuffs_lzw_encode_bad_input_byte() {
+  CHECK_FOCUS(__func__);
+
+  wuffs_base__io_buffer have = ((wuffs_base__io_buffer){
+      .data = global_have_slice,
+  });
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = global_src_slice,
+  });
+
+  // Set up src to be 4 bytes long: three 7-bit literals (0x41, 0x42, 0x43)
+  // then 0xFF, which is too large for a literal width of 7. Encoding should
+  // consume 3 bytes.
+  src.meta.wi = 4;
+  src.meta.closed = true;
+  src.data.ptr[0] = 0x41;
+  src.data.ptr[1] = 0x42;
+  src.data.ptr[2] = 0x43;
+  src.data.ptr[3] = 0xFF;
+
+  wuffs_lzw__encoder enc;
+  CHECK_STATUS("initialize",
+               wuffs_lzw__encoder__initialize(
+                   &enc, sizeof enc, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  wuffs_lzw__encoder__set_literal_width(&enc, 7);
+
+  wuffs_base__status status =
+      wuffs_lzw__encoder__transform_io(&enc, &have, &src, global_work_slice);
+  if (status.repr != wuffs_lzw__error__bad_input_byte) {
+    RETURN_FAIL("transform_io: have \"%s\", want \"%s\"", status.repr,
+                wuffs_lzw__error__bad_input_byte);
+  }
+  if (src.meta.ri != 3) {
+    RETURN_FAIL("src.meta.ri: have %d, want 3", (int)(src.meta.ri));
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_lzw_encode_empty() {
+  CHECK_FOCUS(__func__);
+  // The 9-bit Clear code and then the 9-bit End code, padded to 3 bytes.
+  return do_test_wuffs_lzw_encode_round_trip("", NULL, 8, UINT64_MAX,
+                                             UINT64_MAX, 3);
+}
+
+const char*  //
+test_wuffs_lzw_encode_interface() {
+  CHECK_FOCUS(__func__);
+  wuffs_lzw__encoder enc;
+  CHECK_STATUS("initialize",
+               wuffs_lzw__encoder__initialize(
+                   &enc, sizeof enc, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  return do_test__wuffs_base__io_transformer(
+      wuffs_lzw__encoder__upcast_as__wuffs_base__io_transformer(&enc),
+      "test/data/bricks-nodither.indexes", 0, SIZE_MAX, 13393, 0x04);
+}
+
+const char*  //
+test_wuffs_lzw_encode_io_limits() {
+  CHECK_FOCUS(__func__);
+  const char* filenames[2] = {
+      "test/data/bricks-gray.indexes",
+      "test/data/pi.txt",
+  };
+  const uint64_t limits[3] = {UINT64_MAX, 4096, 43};
+  int f;
+  for (f = 0; f < 2; f++) {
+    int w;
+    for (w = 0; w < 3; w++) {
+      int r;
+      for (r = 0; r < 3; r++) {
+        char prefix[64];
+        snprintf(prefix, 64, "f=%d, w=%d, r=%d: ", f, w, r);
+        CHECK_STRING(do_test_wuffs_lzw_encode_round_trip(
+            prefix, filenames[f], 8, limits[w], limits[r], 0));
+      }
+    }
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_lzw_encode_lengths() {
+  CHECK_FOCUS(__func__);
+
+  // The want_encoded_lens are deterministic, so that changes to the
+  // encoder's compression ratio are noticed. Go's compress/lzw package (with
+  // LSB order and a literal width of 8) gives identical output.
+  struct {
+    const char* filename;
+    size_t want_encoded_len;
+  } test_cases[] = {
+      {
+          .filename = "test/data/bricks-dither.indexes",
+          .want_encoded_len = 14922,
+      },
+      {
+          .filename = "test/data/bricks-gray.indexes",
+          .want_encoded_len = 14725,
+      },
+      {
+          .filename = "test/data/bricks-nodither.indexes",
+          .want_encoded_len = 13393,
+      },
+      {
+          .filename = "test/data/muybridge-frame-000.indexes",
+          .want_encoded_len = 560,
+      },
+      {
+          .filename = "test/data/pi.txt",
+          .want_encoded_len = 50550,
+      },
+  };
+
+  int tc;
+  for (tc = 0; tc < WUFFS_TESTLIB_ARRAY_SIZE(test_cases); tc++) {
+    char prefix[64];
+    snprintf(prefix, 64, "tc=%d: ", tc);
+    CHECK_STRING(do_test_wuffs_lzw_encode_round_trip(
+        prefix, test_cases[tc].filename, 8, UINT64_MAX, UINT64_MAX,
+        test_cases[tc].want_encoded_len));
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_lzw_encode_widths() {
+  CHECK_FOCUS(__func__);
+  uint32_t literal_width;
+  for (literal_width = 2; literal_width <= 8; literal_width++) {
+    char prefix[64];
+    snprintf(prefix, 64, "literal_width=%" PRIu32 ": ", literal_width);
+    CHECK_STRING(do_test_wuffs_lzw_encode_round_trip(
+        prefix, "test/data/pi.txt", literal_width, UINT64_MAX, UINT64_MAX, 0));
+  }
+  return NULL;
+}
+
 // ---------------- LZW Benches
 
 const char*  //
@@ -398,9 +645,9 @@ do_bench_wuffs_lzw_decode(const char* filename, uint64_t iters_unscaled) {
     RETURN_FAIL("src size: have %d, want > 0", (int)(src.meta.wi));
   }
   uint8_t literal_width = src.data.ptr[0];
-  if (literal_width != 0x08) {
-    RETURN_FAIL("LZW literal width: have %d, want %d", (int)(src.data.ptr[0]),
-                0x08);
+  if ((literal_width < 2) || (8 < literal_width)) {
+    RETURN_FAIL("LZW literal width: have %d, want in [2..8]",
+                (int)(src.data.ptr[0]));
   }
 
   bench_start();
@@ -415,6 +662,7 @@ do_bench_wuffs_lzw_decode(const char* filename, uint64_t iters_unscaled) {
                  wuffs_lzw__decoder__initialize(
                      &dec, sizeof dec, WUFFS_VERSION,
                      WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+    wuffs_lzw__decoder__set_literal_width(&dec, literal_width);
     CHECK_STATUS("transform_io", wuffs_lzw__decoder__transform_io(
                                      &dec, &have, &src, global_work_slice));
     n_bytes += have.meta.wi;
@@ -429,12 +677,94 @@ bench_wuffs_lzw_decode_20k() {
   return do_bench_wuffs_lzw_decode("test/data/bricks-gray.indexes.giflzw", 50);
 }
 
+const char*  //
+bench_wuffs_lzw_decode_20k_dither() {
+  CHECK_FOCUS(__func__);
+  return do_bench_wuffs_lzw_decode("test/data/bricks-dither.indexes.giflzw",
+                                   50);
+}
+
+const char*  //
+bench_wuffs_lzw_decode_20k_nodither() {
+  CHECK_FOCUS(__func__);
+  return do_bench_wuffs_lzw_decode("test/data/bricks-nodither.indexes.giflzw",
+                                   50);
+}
+
 const char*  //
 bench_wuffs_lzw_decode_100k() {
   CHECK_FOCUS(__func__);
   return do_bench_wuffs_lzw_decode("test/data/pi.txt.giflzw", 10);
 }
 
+// The bricks-* benchmarks above are photographic images. The two below are
+// flat-colored images, with many long runs of identical pixels.
+
+const char*  //
+bench_wuffs_lzw_decode_140k_artificial() {
+  CHECK_FOCUS(__func__);
+  return do_bench_wuffs_lzw_decode(
+      "test/data/hibiscus.primitive.indexes.giflzw", 10);
+}
+
+const char*  //
+bench_wuffs_lzw_decode_140k_screencap() {
+  CHECK_FOCUS(__func__);
+  return do_bench_wuffs_lzw_decode(
+      "test/data/gifplayer-muybridge.indexes.giflzw", 10);
+}
+
+// The lzw_encode_etc_gt golden tests have no want_filename. They are used to
+// benchmark the encoder.
+
+golden_test lzw_encode_20k_gt = {
+    .src_filename = "test/data/bricks-gray.indexes",
+};
+
+golden_test lzw_encode_20k_dither_gt = {
+    .src_filename = "test/data/bricks-dither.indexes",
+};
+
+golden_test lzw_encode_20k_nodither_gt = {
+    .src_filename = "test/data/bricks-nodither.indexes",
+};
+
+golden_test lzw_encode_100k_gt = {
+    .src_filename = "test/data/pi.txt",
+};
+
+const char*  //
+bench_wuffs_lzw_encode_20k() {
+  CHECK_FOCUS(__func__);
+  return do_bench_io_buffers(
+      wuffs_lzw_encode, WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED,
+      tcounter_src, &lzw_encode_20k_gt, UINT64_MAX, UINT64_MAX, 50);
+}
+
+const char*  //
+bench_wuffs_lzw_encode_20k_dither() {
+  CHECK_FOCUS(__func__);
+  return do_bench_io_buffers(
+      wuffs_lzw_encode, WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED,
+      tcounter_src, &lzw_encode_20k_dither_gt, UINT64_MAX, UINT64_MAX, 50);
+}
+
+const char*  //
+bench_wuffs_lzw_encode_20k_nodither() {
+  CHECK_FOCUS(__func__);
+  return do_bench_io_buffers(
+      wuffs_lzw_encode, WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED,
+      tcounter_src, &lzw_encode_20k_nodither_gt, UINT64_MAX, UINT64_MAX, 50);
+}
+
+const char*  //
+bench_wuffs_lzw_encode_100k() {
+  CHECK_FOCUS(__func__);
+  return do_bench_io_buffers(
+      wuffs_lzw_encode, WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED,
+      tcounter_src, &lzw_encode_100k_gt, UINT64_MAX, UINT64_MAX, 10);
+}
+
 // ---------------- Manifest
 
 proc tests[] = {
@@ -449,6 +779,12 @@ proc tests[] = {
     test_wuffs_lzw_decode_pi,
     test_wuffs_lzw_decode_width_0,
     test_wuffs_lzw_decode_width_1,
+    test_wuffs_lzw_encode_bad_input_byte,
+    test_wuffs_lzw_encode_empty,
+    test_wuffs_lzw_encode_interface,
+    test_wuffs_lzw_encode_io_limits,
+    test_wuffs_lzw_encode_lengths,
+    test_wuffs_lzw_encode_widths,
 
     NULL,
 };
@@ -456,7 +792,15 @@ proc tests[] = {
 proc benches[] = {
 
     bench_wuffs_lzw_decode_20k,
+    bench_wuffs_lzw_decode_20k_dither,
+    bench_wuffs_lzw_decode_20k_nodither,
     bench_wuffs_lzw_decode_100k,
+    bench_wuffs_lzw_decode_140k_artificial,
+    bench_wuffs_lzw_decode_140k_screencap,
+    bench_wuffs_lzw_encode_20k,
+    bench_wuffs_lzw_encode_20k_dither,
+    bench_wuffs_lzw_encode_20k_nodither,
+    bench_wuffs_lzw_encode_100k,
 
     NULL,
 };
@@ -92,6 +92,33 @@ const size_t zlib_sheep_dict_len = 8;
 const char* zlib_sheep_want_ptr = "Two sheep.\n";
 const size_t zlib_sheep_want_len = 11;
 
+// The zlib_encode_etc_gt golden tests have no want_filename, as there is more
+// than one valid zlib encoding of any given src. They are used to benchmark
+// the encoders.
+
+golden_test zlib_encode_midsummer_gt = {
+    .src_filename = "test/data/midsummer.txt",
+};
+
+golden_test zlib_encode_pi_gt = {
+    .src_filename = "test/data/pi.txt",
+};
+
+// This is a short message, like those sent by an RPC (Remote Procedure Call)
+// system, zlib-encoded with a dynamic Huffman block.
+const char* zlib_rpc_src_ptr =
+    "\x78\x9c\x1d\xca\x3b\x0e\x80\x20\x10\x04\xd0\xde\x63\x4c\x4d\x0c\x18\x2d"
+    "\xe4\x2a\xc6\x62\x23\xab\x90\xf0\x31\x8a\x95\xf1\xee\xae\x4e\x37\xf3\xe6"
+    "\x46\x70\xb0\x46\xf7\x9d\x42\xe2\xea\x8b\x34\x5c\x27\x1f\xed\xc6\x15\x0a"
+    "\x3b\x1d\x94\x4e\xd8\x1b\x99\x12\x8b\x51\x0c\x0b\x0b\xac\x81\xa3\x13\x98"
+    "\xc0\x89\x42\xfc\xae\xbe\x64\xc6\xfc\x28\x54\xd9\xcd\x30\x76\xfa\x4f\xf3"
+    "\x02\x1b\xaf\x1d\xec";
+const size_t zlib_rpc_src_len = 95;
+const char* zlib_rpc_want_ptr =
+    "{\"id\":1042,\"method\":\"user.get\",\"params\":{\"name\":\"alice\","
+    "\"fields\":[\"email\",\"phone\"]},\"ts\":1592000000\n";
+const size_t zlib_rpc_want_len = 100;
+
 // ---------------- Zlib Tests
 
 const char*  //
@@ -240,6 +267,85 @@ test_wuffs_zlib_decode_pi() {
                             UINT64_MAX);
 }
 
+const char*  //
+test_wuffs_zlib_decode_reset() {
+  CHECK_FOCUS(__func__);
+  wuffs_base__io_buffer want =
+      make_io_buffer_from_string(zlib_rpc_want_ptr, zlib_rpc_want_len);
+
+  wuffs_zlib__decoder dec;
+  CHECK_STATUS("initialize", wuffs_zlib__decoder__initialize(
+                                 &dec, sizeof dec, WUFFS_VERSION,
+                                 WUFFS_INITIALIZE__DEFAULT_OPTIONS));
+
+  // For i == 0, decode the message from a fresh decoder. For i == 1, reset a
+  // decoder that was suspended mid-stream. For i == 2, reset a decoder that
+  // was disabled by an error. For i == 3, check that reset kept the
+  // set_ignore_checksum setting.
+  int i;
+  for (i = 0; i < 4; i++) {
+    wuffs_base__io_buffer have = ((wuffs_base__io_buffer){
+        .data = global_have_slice,
+    });
+    wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+        .data = global_src_slice,
+    });
+    memcpy(src.data.ptr, zlib_rpc_src_ptr, zlib_rpc_src_len);
+    src.meta.wi = zlib_rpc_src_len;
+    src.meta.closed = true;
+
+    if (i == 1) {
+      src.meta.wi = 40;
+      src.meta.closed = false;
+      wuffs_base__status status = wuffs_zlib__decoder__transform_io(
+          &dec, &have, &src, global_work_slice);
+      if (status.repr != wuffs_base__suspension__short_read) {
+        RETURN_FAIL("i=%d: transform_io (partial): have \"%s\", want \"%s\"",
+                    i, status.repr, wuffs_base__suspension__short_read);
+      }
+      wuffs_zlib__decoder__reset(&dec);
+      have.meta.wi = 0;
+      src.meta.ri = 0;
+      src.meta.wi = zlib_rpc_src_len;
+      src.meta.closed = true;
+
+    } else if (i == 2) {
+      src.data.ptr[1] ^= 0x01;
+      int j;
+      for (j = 0; j < 2; j++) {
+        const char* want_status =
+            (j == 0) ? wuffs_zlib__error__bad_parity_check
+                     : wuffs_base__error__disabled_by_previous_error;
+        wuffs_base__status status = wuffs_zlib__decoder__transform_io(
+            &dec, &have, &src, global_work_slice);
+        if (status.repr != want_status) {
+          RETURN_FAIL("i=%d, j=%d: transform_io: have \"%s\", want \"%s\"", i,
+                      j, status.repr, want_status);
+        }
+      }
+      wuffs_zlib__decoder__reset(&dec);
+      src.data.ptr[1] ^= 0x01;
+      src.meta.ri = 0;
+
+    } else if (i == 3) {
+      wuffs_zlib__decoder__set_ignore_checksum(&dec, true);
+      wuffs_zlib__decoder__reset(&dec);
+      src.data.ptr[zlib_rpc_src_len - 1] ^= 0xFF;
+    }
+
+    wuffs_base__status status =
+        wuffs_zlib__decoder__transform_io(&dec, &have, &src, global_work_slice);
+    if (!wuffs_base__status__is_ok(&status)) {
+      RETURN_FAIL("i=%d: transform_io: \"%s\"", i, status.repr);
+    }
+    char prefix[16];
+    snprintf(prefix, 16, "i=%d: ", i);
+    CHECK_STRING(check_io_buffers_equal(prefix, &have, &want));
+    wuffs_zlib__decoder__reset(&dec);
+  }
+  return NULL;
+}
+
 const char*  //
 test_wuffs_zlib_decode_sheep() {
   CHECK_FOCUS(__func__);
@@ -272,11 +378,32 @@ test_wuffs_zlib_decode_sheep() {
     }
   }
 
-  wuffs_zlib__decoder__add_dictionary(
-      &dec, ((wuffs_base__slice_u8){
-                .ptr = ((uint8_t*)(zlib_sheep_dict_ptr)),
-                .len = zlib_sheep_dict_len,
-            }));
+  wuffs_base__slice_u8 dict = ((wuffs_base__slice_u8){
+      .ptr = ((uint8_t*)(zlib_sheep_dict_ptr)),
+      .len = zlib_sheep_dict_len,
+  });
+
+  // A too-short workbuf is rejected, without adding the dictionary.
+  {
+    wuffs_base__slice_u8 short_work_slice = global_work_slice;
+    short_work_slice.len =
+        WUFFS_ZLIB__DECODER_WORKBUF_LEN_MAX_INCL_WORST_CASE - 1;
+    wuffs_base__status status =
+        wuffs_zlib__decoder__add_dictionary(&dec, dict, short_work_slice);
+    if (status.repr != wuffs_base__error__bad_workbuf_length) {
+      RETURN_FAIL("add_dictionary (short workbuf): have \"%s\", want \"%s\"",
+                  status.repr, wuffs_base__error__bad_workbuf_length);
+    }
+    status =
+        wuffs_zlib__decoder__transform_io(&dec, &have, &src, global_work_slice);
+    if (status.repr != wuffs_zlib__note__dictionary_required) {
+      RETURN_FAIL("transform_io (short workbuf): have \"%s\", want \"%s\"",
+                  status.repr, wuffs_zlib__note__dictionary_required);
+    }
+  }
+
+  CHECK_STATUS("add_dictionary", wuffs_zlib__decoder__add_dictionary(
+                                     &dec, dict, global_work_slice));
 
   CHECK_STATUS(
       "transform_io (after dict)",
@@ -287,6 +414,119 @@ test_wuffs_zlib_decode_sheep() {
   return check_io_buffers_equal("", &have, &want);
 }
 
+const char*  //
+wuffs_zlib_encode(wuffs_base__io_buffer* dst,
+                  wuffs_base__io_buffer* src,
+                  uint32_t wuffs_initialize_flags,
+                  uint64_t wlimit,
+                  uint64_t rlimit) {
+  wuffs_zlib__encoder enc;
+  CHECK_STATUS("initialize",
+               wuffs_zlib__encoder__initialize(&enc, sizeof enc, WUFFS_VERSION,
+                                               wuffs_initialize_flags));
+
+  while (true) {
+    wuffs_base__io_buffer limited_dst = make_limited_writer(*dst, wlimit);
+    wuffs_base__io_buffer limited_src = make_limited_reader(*src, rlimit);
+
+    wuffs_base__status status = wuffs_zlib__encoder__transform_io(
+        &enc, &limited_dst, &limited_src, global_work_slice);
+
+    dst->meta.wi += limited_dst.meta.wi;
+    src->meta.ri += limited_src.meta.ri;
+
+    if (((wlimit < UINT64_MAX) &&
+         (status.repr == wuffs_base__suspension__short_write)) ||
+        ((rlimit < UINT64_MAX) &&
+         (status.repr == wuffs_base__suspension__short_read))) {
+      continue;
+    }
+    return status.repr;
+  }
+}
+
+const char*  //
+test_wuffs_zlib_encode_interface() {
+  CHECK_FOCUS(__func__);
+  wuffs_zlib__encoder enc;
+  CHECK_STATUS("initialize",
+               wuffs_zlib__encoder__initialize(
+                   &enc, sizeof enc, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  return do_test__wuffs_base__io_transformer(
+      wuffs_zlib__encoder__upcast_as__wuffs_base__io_transformer(&enc),
+      "test/data/romeo.txt", 0, SIZE_MAX, 535, 0xDE);
+}
+
+const char*  //
+test_wuffs_zlib_encode_round_trip() {
+  CHECK_FOCUS(__func__);
+
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = global_src_slice,
+  });
+  wuffs_base__io_buffer encoded = ((wuffs_base__io_buffer){
+      .data = global_want_slice,
+  });
+  wuffs_base__io_buffer have = ((wuffs_base__io_buffer){
+      .data = global_have_slice,
+  });
+
+  const char* filenames[2] = {
+      "test/data/midsummer.txt",
+      "test/data/pi.txt",
+  };
+  const uint64_t limits[2] = {UINT64_MAX, 61};
+  int f;
+  for (f = 0; f < 2; f++) {
+    src.meta.wi = 0;
+    src.meta.ri = 0;
+    src.meta.closed = false;
+    CHECK_STRING(read_file(&src, filenames[f]));
+    int w;
+    for (w = 0; w < 2; w++) {
+      int r;
+      for (r = 0; r < 2; r++) {
+        char prefix[64];
+        snprintf(prefix, 64, "f=%d, w=%d, r=%d: ", f, w, r);
+        src.meta.ri = 0;
+        encoded.meta.wi = 0;
+        encoded.meta.ri = 0;
+        encoded.meta.closed = false;
+        have.meta.wi = 0;
+
+        const char* status = wuffs_zlib_encode(
+            &encoded, &src,
+            WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED, limits[w],
+            limits[r]);
+        if (status) {
+          RETURN_FAIL("%sencode: %s", prefix, status);
+        } else if (encoded.meta.wi < 6) {
+          RETURN_FAIL("%sencoded length: have %zu", prefix, encoded.meta.wi);
+        }
+
+        // Check the CMF and FLG bytes, for the default compression level.
+        uint8_t* e = encoded.data.ptr;
+        if ((e[0] != 0x78) || (e[1] != 0x9C)) {
+          RETURN_FAIL("%sbad header", prefix);
+        }
+
+        encoded.meta.closed = true;
+        status = wuffs_zlib_decode(
+            &have, &encoded,
+            WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED, UINT64_MAX,
+            UINT64_MAX);
+        if (status) {
+          RETURN_FAIL("%sdecode: %s", prefix, status);
+        }
+        src.meta.ri = 0;
+        CHECK_STRING(check_io_buffers_equal(prefix, &have, &src));
+      }
+    }
+  }
+  return NULL;
+}
+
   // ---------------- Mimic Tests
 
 #ifdef WUFFS_MIMIC
@@ -330,6 +570,64 @@ test_mimic_zlib_decode_sheep() {
 
 // ---------------- Zlib Benches
 
+const char*  //
+do_bench_wuffs_zlib_decode_rpc(uint32_t wuffs_initialize_flags,
+                               bool reset,
+                               uint64_t iters_unscaled) {
+  wuffs_base__io_buffer have = ((wuffs_base__io_buffer){
+      .data = global_have_slice,
+  });
+  wuffs_base__io_buffer src =
+      make_io_buffer_from_string(zlib_rpc_src_ptr, zlib_rpc_src_len);
+
+  wuffs_zlib__decoder dec;
+  CHECK_STATUS("initialize",
+               wuffs_zlib__decoder__initialize(&dec, sizeof dec, WUFFS_VERSION,
+                                               wuffs_initialize_flags));
+
+  bench_start();
+  uint64_t n_bytes = 0;
+  uint64_t i;
+  uint64_t iters = iters_unscaled * flags.iterscale;
+  for (i = 0; i < iters; i++) {
+    have.meta.wi = 0;
+    src.meta.ri = 0;
+    if (reset) {
+      wuffs_zlib__decoder__reset(&dec);
+    } else {
+      CHECK_STATUS("initialize", wuffs_zlib__decoder__initialize(
+                                     &dec, sizeof dec, WUFFS_VERSION,
+                                     wuffs_initialize_flags));
+    }
+    CHECK_STATUS("transform_io", wuffs_zlib__decoder__transform_io(
+                                     &dec, &have, &src, global_work_slice));
+    n_bytes += have.meta.wi;
+  }
+  bench_finish(iters, n_bytes);
+  return NULL;
+}
+
+const char*  //
+bench_wuffs_zlib_decode_100b_full_init() {
+  CHECK_FOCUS(__func__);
+  return do_bench_wuffs_zlib_decode_rpc(WUFFS_INITIALIZE__DEFAULT_OPTIONS,
+                                        false, 2000);
+}
+
+const char*  //
+bench_wuffs_zlib_decode_100b_part_init() {
+  CHECK_FOCUS(__func__);
+  return do_bench_wuffs_zlib_decode_rpc(
+      WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED, false, 2000);
+}
+
+const char*  //
+bench_wuffs_zlib_decode_100b_reset() {
+  CHECK_FOCUS(__func__);
+  return do_bench_wuffs_zlib_decode_rpc(WUFFS_INITIALIZE__DEFAULT_OPTIONS,
+                                        true, 2000);
+}
+
 const char*  //
 bench_wuffs_zlib_decode_10k() {
   CHECK_FOCUS(__func__);
@@ -346,10 +644,35 @@ bench_wuffs_zlib_decode_100k() {
       tcounter_dst, &zlib_pi_gt, UINT64_MAX, UINT64_MAX, 30);
 }
 
+const char*  //
+bench_wuffs_zlib_encode_10k() {
+  CHECK_FOCUS(__func__);
+  return do_bench_io_buffers(
+      wuffs_zlib_encode, WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED,
+      tcounter_src, &zlib_encode_midsummer_gt, UINT64_MAX, UINT64_MAX, 30);
+}
+
+const char*  //
+bench_wuffs_zlib_encode_100k() {
+  CHECK_FOCUS(__func__);
+  return do_bench_io_buffers(
+      wuffs_zlib_encode, WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED,
+      tcounter_src, &zlib_encode_pi_gt, UINT64_MAX, UINT64_MAX, 3);
+}
+
   // ---------------- Mimic Benches
 
 #ifdef WUFFS_MIMIC
 
+const char*  //
+mimic_zlib_encode_default_level(wuffs_base__io_buffer* dst,
+                                wuffs_base__io_buffer* src,
+                                uint32_t wuffs_initialize_flags,
+                                uint64_t wlimit,
+                                uint64_t rlimit) {
+  return mimic_zlib_encode(dst, src, 6, wlimit, rlimit);
+}
+
 const char*  //
 bench_mimic_zlib_decode_10k() {
   CHECK_FOCUS(__func__);
@@ -364,6 +687,21 @@ bench_mimic_zlib_decode_100k() {
                              UINT64_MAX, UINT64_MAX, 30);
 }
 
+const char*  //
+bench_mimic_zlib_encode_10k() {
+  CHECK_FOCUS(__func__);
+  return do_bench_io_buffers(mimic_zlib_encode_default_level, 0, tcounter_src,
+                             &zlib_encode_midsummer_gt, UINT64_MAX, UINT64_MAX,
+                             30);
+}
+
+const char*  //
+bench_mimic_zlib_encode_100k() {
+  CHECK_FOCUS(__func__);
+  return do_bench_io_buffers(mimic_zlib_encode_default_level, 0, tcounter_src,
+                             &zlib_encode_pi_gt, UINT64_MAX, UINT64_MAX, 3);
+}
+
 #endif  // WUFFS_MIMIC
 
 // ---------------- Manifest
@@ -377,7 +715,10 @@ proc tests[] = {
     test_wuffs_zlib_decode_interface,
     test_wuffs_zlib_decode_midsummer,
     test_wuffs_zlib_decode_pi,
+    test_wuffs_zlib_decode_reset,
     test_wuffs_zlib_decode_sheep,
+    test_wuffs_zlib_encode_interface,
+    test_wuffs_zlib_encode_round_trip,
 
 #ifdef WUFFS_MIMIC
 
@@ -392,13 +733,20 @@ proc tests[] = {
 
 proc benches[] = {
 
+    bench_wuffs_zlib_decode_100b_full_init,
+    bench_wuffs_zlib_decode_100b_part_init,
+    bench_wuffs_zlib_decode_100b_reset,
     bench_wuffs_zlib_decode_10k,
     bench_wuffs_zlib_decode_100k,
+    bench_wuffs_zlib_encode_10k,
+    bench_wuffs_zlib_encode_100k,
 
 #ifdef WUFFS_MIMIC
 
     bench_mimic_zlib_decode_10k,
     bench_mimic_zlib_decode_100k,
+    bench_mimic_zlib_encode_10k,
+    bench_mimic_zlib_encode_100k,
 
 #endif  // WUFFS_MIMIC
 